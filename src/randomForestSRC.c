@@ -114,7 +114,9 @@ char  *sexpString[RF_SEXP_CNT] = {
   "uspvST",        
   "mtryID",        
   "mtryST",        
-  "mwcpCount"      
+  "mwcpCount",     
+  "proxIndex",     
+  "proxColumn"     
 };
 SEXP sexpVector[RF_SEXP_CNT];
 uint     *RF_treeID_;
@@ -247,6 +249,10 @@ uint      RF_sortedTimeInterestSize;
 double   *RF_masterTime;
 uint      RF_masterTimeSize;
 uint     *RF_masterTimeIndexIn;
+uint      RF_replicaCount;
+double ***RF_observationReplica;
+double ***RF_responseReplica;
+uint    **RF_masterTimeIndexReplica;
 uint      RF_rFactorCount;
 uint     *RF_rFactorMap;
 uint     *RF_rFactorIndex;
@@ -260,6 +266,7 @@ uint     *RF_rNonFactorMap;
 uint     *RF_rNonFactorIndex;
 uint      RF_xFactorCount;
 uint     *RF_xFactorMap;
+char     *RF_xFactorSplitFlag;
 uint     *RF_xFactorIndex;
 uint     *RF_xFactorSize;
 uint      RF_mxFactorSize;
@@ -298,11 +305,23 @@ double **RF_sImputePredictorPtr;
 double **RF_sOOBImputeResponsePtr;
 double **RF_sOOBImputePredictorPtr;
 uint  **RF_tTermMembershipIndexPtr;
+uint   *RF_proximityMembershipIndex;
 uint  **RF_bootstrapMembershipPtr;
 uint  **RF_pNodeMembershipIndexPtr;
 double **RF_proximityPtr;
-double **RF_proximityDenPtr;
-double  *RF_proximityDen;
+uint   **RF_proximityMaskPtr;
+uint    *RF_proximityMask;
+uint     RF_proximityMaskSize;
+char    *RF_proximityTree;
+char   **RF_proximityFlag;
+uint    *RF_proximityLeafCount;
+uint   **RF_proximityLeafIndex;
+uint   **RF_proximityLeafMembr;
+uint     RF_proximityTopK;
+uint     RF_proximitySexpIndex;
+uint    *RF_proximityRowSize;
+uint   **RF_proximityRowColumn;
+double **RF_proximityRowValue;
 uint    RF_rejectedTreeCount;
 uint    RF_validTreeCount;
 uint    RF_stumpedTreeCount;
@@ -360,6 +379,39 @@ double  **RF_oobEnsembleRGRnum;
 double  **RF_fullEnsembleRGRnum;
 uint     *RF_oobEnsembleDen;
 uint     *RF_fullEnsembleDen;
+char      RF_ensemblePartialFlag;
+uint      RF_ensemblePartialSize;
+uint    **RF_oobEnsembleDenPart;
+uint    **RF_fullEnsembleDenPart;
+double ****RF_oobEnsembleSRGpart;
+double ****RF_fullEnsembleSRGpart;
+double  ***RF_oobEnsembleMRTpart;
+double  ***RF_fullEnsembleMRTpart;
+double  ***RF_oobEnsembleSRVpart;
+double  ***RF_fullEnsembleSRVpart;
+double ****RF_oobEnsembleCIFpart;
+double ****RF_fullEnsembleCIFpart;
+double ****RF_oobEnsembleCLSpart;
+double ****RF_fullEnsembleCLSpart;
+double  ***RF_oobEnsembleRGRpart;
+double  ***RF_fullEnsembleRGRpart;
+char       RF_vimpPartialFlag;
+uint       RF_vimpPartialSize;
+uint       RF_vimpPartialSlotSize;
+char       RF_deterministicFlag;
+char      *RF_treeEnsembleFlag;
+uint       RF_perfSnapshotSize;
+uint     **RF_perfSnapshotDen;
+double  ***RF_perfSnapshotMRT;
+double ****RF_perfSnapshotCLS;
+double  ***RF_perfSnapshotRGR;
+uint    ***RF_vimpEnsembleDenPart;
+double  ****RF_vimpEnsembleMRTpart;
+double *****RF_vimpEnsembleCLSpart;
+double  ****RF_vimpEnsembleRGRpart;
+char        RF_treeRecordFlag;
+TreeRecord **RF_treeRecord;
+FlatForest  *RF_flatForest;
 uint     **RF_vimpEnsembleDen;
 double ***RF_splitDepthPtr;
 uint    *RF_serialTreeIndex;
@@ -412,16 +464,26 @@ double  **RF_ftime;
 double  **RF_fstatus;
 double ***RF_fresponse;
 double ***RF_observation;
+uint    **RF_presortIndexIn;
+uint     *RF_histBinSize;
+uint      RF_histBinMax;
+uint    **RF_histBinCode;
+double  **RF_histBinUpper;
+uint   ***RF_presortIndex;
+char    **RF_splitMembershipFlag;
+uint    **RF_splitPartitionIndex;
 double ***RF_fobservation;
 uint    **RF_masterTimeIndex;
+uint    **RF_splitEventTimeCount;
+uint    **RF_splitEventTimeIndex;
 Factor ***RF_factorList;
-float (*ran1A) (uint);
+double (*ran1A) (uint);
 void  (*randomSetChain) (uint, int);
 int   (*randomGetChain) (uint);
-float (*ran1B) (uint);
+double (*ran1B) (uint);
 void  (*randomSetUChain) (uint, int);
 int   (*randomGetUChain) (uint);
-float (*ran1C) (uint);
+double (*ran1C) (uint);
 void  (*randomSetUChainCov) (uint, int);
 int   (*randomGetUChainCov) (uint);
 char (*customGenericSplit) (uint,
@@ -439,6 +501,21 @@ char (*customGenericSplit) (uint,
                             char);
 customFunction customFunctionArray[4][16];
 uint   RF_userTraceFlag;
+Arena *RF_arenaCurrent;
+#ifdef _OPENMP
+#pragma omp threadprivate(RF_arenaCurrent)
+#endif
+double RF_arenaPeak;
+double RF_arenaTotal;
+double *RF_threadBusyTime;
+uint    RF_threadBusySize;
+#ifdef _OPENMP
+omp_sched_t RF_threadScheduleKind;
+int         RF_threadScheduleChunk;
+#endif
+#ifndef _WIN32
+volatile sig_atomic_t RF_scoreSignal;
+#endif
 time_t RF_userTimeStart;
 time_t RF_userTimeSplit;  
 #define IA      16807
@@ -446,103 +523,126 @@ time_t RF_userTimeSplit;
 #define AM      (1.0/IM)
 #define IQ      127773
 #define IR      2836
-#define NTAB    32
+#define NTAB    RANDOM_NTAB
 #define NDIV    (1+(IM-1)/NTAB)
 #define EPS     1.2e-7
 #define RNMX    (1.0-EPS)
 #define LCG_IM  714025
 #define LCG_IA  1366
 #define LCG_IC  150889
-int  *ran1A_iy;
-int **ran1A_iv;
-int  *ran1B_iy;
-int **ran1B_iv;
-int  *ran1C_iy;
-int **ran1C_iv;
-int      *seed1AValue;
-int      *seed1BValue;
-int      *seed1CValue;
+RandomSlot *ran1A_slot;
+RandomSlot *ran1B_slot;
+RandomSlot *ran1C_slot;
+void       *ran1A_block;
+void       *ran1B_block;
+void       *ran1C_block;
 void randomStack(uint bSize, uint pSize) {
+  ran1A_slot = stackRandomSlot(bSize, & ran1A_block);
+  ran1B_slot = stackRandomSlot(bSize, & ran1B_block);
+  ran1C_slot = stackRandomSlot(bSize, & ran1C_block);
+}
+void randomUnstack(uint bSize, uint pSize) {
+  unstackRandomSlot(bSize, ran1A_block);
+  unstackRandomSlot(bSize, ran1B_block);
+  unstackRandomSlot(bSize, ran1C_block);
+}
+RandomSlot *stackRandomSlot(uint bSize, void **slotBlock) {
+  RandomSlot *slot;
   uint b;
-  ran1A_iy = ivector(1, bSize);
-  ran1A_iv = imatrix(1, bSize, 1, NTAB);
-  ran1B_iy = ivector(1, bSize);
-  ran1B_iv = imatrix(1, bSize, 1, NTAB);
-  ran1C_iy = ivector(1, bSize);
-  ran1C_iv = imatrix(1, bSize, 1, NTAB);
+  *slotBlock = gblock((size_t) ((bSize + 1) * sizeof(RandomSlot) + CACHE_LINE_SIZE));
+  slot = (RandomSlot *) (((size_t) (*slotBlock) + CACHE_LINE_SIZE - 1) & ~((size_t) CACHE_LINE_SIZE - 1));
   for (b = 1; b <= bSize; b++) {
-    ran1A_iy[b] = 0;
-    ran1B_iy[b] = 0;
-    ran1C_iy[b] = 0;
+    slot[b].stream.iy = 0;
+    randomSetStream(& slot[b].stream, 0);
   }
-  seed1AValue = ivector(1, bSize);
-  seed1BValue = ivector(1, bSize);
-  seed1CValue = ivector(1, bSize);
+  return slot;
 }
-void randomUnstack(uint bSize, uint pSize) {
-  free_ivector(ran1A_iy, 1, bSize);
-  free_imatrix(ran1A_iv, 1, bSize, 1, NTAB);
-  free_ivector(ran1B_iy, 1, bSize);
-  free_imatrix(ran1B_iv, 1, bSize, 1, NTAB);
-  free_ivector(ran1C_iy, 1, bSize);
-  free_imatrix(ran1C_iv, 1, bSize, 1, NTAB);
-  free_ivector(seed1AValue, 1, bSize);
-  free_ivector(seed1BValue, 1, bSize);
-  free_ivector(seed1CValue, 1, bSize);
+void unstackRandomSlot(uint bSize, void *slotBlock) {
+  free_gblock(slotBlock, (size_t) ((bSize + 1) * sizeof(RandomSlot) + CACHE_LINE_SIZE));
+}
+void randomSetStream(RandomStream *stream, int value) {
+  stream -> seed = value;
+  stream -> counter[0] = 0;
+  stream -> counter[1] = 0;
+  stream -> blockIndex = 4;
 }
 void randomSetChainParallel(uint b, int value) {
-  seed1AValue[b] = value;
+  randomSetStream(& ran1A_slot[b].stream, value);
 }
 void randomSetUChainParallel(uint b, int value) {
-  seed1BValue[b] = value;
+  randomSetStream(& ran1B_slot[b].stream, value);
 }
 void randomSetUChainParallelCov(uint b, int value) {
-  seed1CValue[b] = value;
+  randomSetStream(& ran1C_slot[b].stream, value);
 }
 void randomSetChainSerial(uint b, int value) {
-  seed1AValue[1] = value;
+  randomSetStream(& ran1A_slot[1].stream, value);
 }
 void randomSetUChainSerial(uint b, int value) {
-  seed1BValue[1] = value;
+  randomSetStream(& ran1B_slot[1].stream, value);
 }
 void randomSetUChainSerialCov(uint b, int value) {
-  seed1CValue[1] = value;
+  randomSetStream(& ran1C_slot[1].stream, value);
 }
 int randomGetChainParallel(uint b) {
-  return seed1AValue[b];
+  return ran1A_slot[b].stream.seed;
 }
 int randomGetUChainParallel(uint b) {
-  return seed1BValue[b];
+  return ran1B_slot[b].stream.seed;
 }
 int randomGetUChainParallelCov(uint b) {
-  return seed1CValue[b];
+  return ran1C_slot[b].stream.seed;
 }
 int randomGetChainSerial(uint b) {
-  return seed1AValue[1];
+  return ran1A_slot[1].stream.seed;
 }
 int randomGetUChainSerial(uint b) {
-  return seed1BValue[1];
+  return ran1B_slot[1].stream.seed;
 }
 int randomGetUChainSerialCov(uint b) {
-  return seed1CValue[1];
+  return ran1C_slot[1].stream.seed;
+}
+double randomChainParallel(uint b) {
+  RandomStream *stream = & ran1A_slot[b].stream;
+  return  ran1_generic(& stream -> iy, stream -> iv, & stream -> seed);
+}
+double randomUChainParallel(uint b) {
+  RandomStream *stream = & ran1B_slot[b].stream;
+  return  ran1_generic(& stream -> iy, stream -> iv, & stream -> seed);
+}
+double randomUChainParallelCov(uint b) {
+  RandomStream *stream = & ran1C_slot[b].stream;
+  return  ran1_generic(& stream -> iy, stream -> iv, & stream -> seed);
+}
+double randomChainSerial(uint b) {
+  RandomStream *stream = & ran1A_slot[1].stream;
+  return  ran1_generic(& stream -> iy, stream -> iv, & stream -> seed);
+}
+double randomUChainSerial(uint b) {
+  RandomStream *stream = & ran1B_slot[1].stream;
+  return  ran1_generic(& stream -> iy, stream -> iv, & stream -> seed);
+}
+double randomUChainSerialCov(uint b) {
+  RandomStream *stream = & ran1C_slot[1].stream;
+  return  ran1_generic(& stream -> iy, stream -> iv, & stream -> seed);
 }
-float randomChainParallel(uint b) {
-  return  ran1_generic(& ran1A_iy[b], ran1A_iv[b], & seed1AValue[b]);
+double randomChainParallelCounter(uint b) {
+  return  ranCounter_generic(& ran1A_slot[b].stream, 1, b);
 }
-float randomUChainParallel(uint b) {
-  return  ran1_generic(& ran1B_iy[b], ran1B_iv[b], & seed1BValue[b]);
+double randomUChainParallelCounter(uint b) {
+  return  ranCounter_generic(& ran1B_slot[b].stream, 2, b);
 }
-float randomUChainParallelCov(uint b) {
-  return  ran1_generic(& ran1C_iy[b], ran1C_iv[b], & seed1CValue[b]);
+double randomUChainParallelCovCounter(uint b) {
+  return  ranCounter_generic(& ran1C_slot[b].stream, 3, b);
 }
-float randomChainSerial(uint b) {
-  return  ran1_generic(& ran1A_iy[1], ran1A_iv[1], & seed1AValue[1]);
+double randomChainSerialCounter(uint b) {
+  return  ranCounter_generic(& ran1A_slot[1].stream, 1, 1);
 }
-float randomUChainSerial(uint b) {
-  return  ran1_generic(& ran1B_iy[1], ran1B_iv[1], & seed1BValue[1]);
+double randomUChainSerialCounter(uint b) {
+  return  ranCounter_generic(& ran1B_slot[1].stream, 2, 1);
 }
-float randomUChainSerialCov(uint b) {
-  return  ran1_generic(& ran1C_iy[1], ran1C_iv[1], & seed1CValue[1]);
+double randomUChainSerialCovCounter(uint b) {
+  return  ranCounter_generic(& ran1C_slot[1].stream, 3, 1);
 }
 float ran1_generic(int *iy, int *iv, int *idum) {
   int j, k;
@@ -575,6 +675,53 @@ float ran1_generic(int *iy, int *iv, int *idum) {
     return temp;
   }
 }
+double ranCounter_generic(RandomStream *stream, uint streamID, uint b) {
+  unsigned int counter[4];
+  unsigned int key[2];
+  unsigned int *word;
+  if (stream -> blockIndex >= 4) {
+    counter[0] = stream -> counter[0];
+    counter[1] = stream -> counter[1];
+    counter[2] = streamID;
+    counter[3] = 0;
+    key[0] = (unsigned int) (stream -> seed);
+    key[1] = b;
+    philox4x32(counter, key, stream -> block);
+    if (++(stream -> counter[0]) == 0) {
+      stream -> counter[1] ++;
+    }
+    stream -> blockIndex = 0;
+  }
+  word = stream -> block + stream -> blockIndex;
+  stream -> blockIndex += 2;
+  return ((word[0] >> 5) * 67108864.0 + (word[1] >> 6) + 0.5) / 9007199254740992.0;
+}
+void philox4x32(unsigned int *counter, unsigned int *key, unsigned int *result) {
+  unsigned long long product0, product1;
+  unsigned int c0, c1, c2, c3;
+  unsigned int k0, k1;
+  uint round;
+  c0 = counter[0];
+  c1 = counter[1];
+  c2 = counter[2];
+  c3 = counter[3];
+  k0 = key[0];
+  k1 = key[1];
+  for (round = 1; round <= 10; round++) {
+    product0 = (unsigned long long) 0xD2511F53U * c0;
+    product1 = (unsigned long long) 0xCD9E8D57U * c2;
+    c0 = ((unsigned int) (product1 >> 32)) ^ c1 ^ k0;
+    c2 = ((unsigned int) (product0 >> 32)) ^ c3 ^ k1;
+    c1 = (unsigned int) product1;
+    c3 = (unsigned int) product0;
+    k0 += 0x9E3779B9U;
+    k1 += 0xBB67AE85U;
+  }
+  result[0] = c0;
+  result[1] = c1;
+  result[2] = c2;
+  result[3] = c3;
+}
 void lcgenerator(unsigned int *seed, unsigned char reset) {
   if (reset) {
     if (*seed >= LCG_IM) (*seed) %= LCG_IM;
@@ -878,12 +1025,90 @@ void nrerror(char error_text[]) {
   error("\nRF-SRC:  The application will now exit.\n");
 }
 void *gblock(size_t size) {
-  void *v = (void *) malloc(size);
-  if (!v) nrerror("\n  Allocation Failure in gblock().");
-  return v;
+  ArenaBlock *block;
+  if (RF_arenaCurrent != NULL) {
+    return arenaBlock(RF_arenaCurrent, size);
+  }
+  block = (ArenaBlock *) malloc(sizeof(ArenaBlock) + size);
+  if (!block) nrerror("\n  Allocation Failure in gblock().");
+  block -> chunk = NULL;
+  return (void *) (block + 1);
 }
 void free_gblock(void *v, size_t size) {
-  free((FREE_ARG) (v));
+  ArenaBlock *block = ((ArenaBlock *) v) - 1;
+  if (block -> chunk == NULL) {
+    free((FREE_ARG) (block));
+  }
+  else {
+    free_arenaBlock(block);
+  }
+}
+Arena *makeArena() {
+  Arena *arena = (Arena *) malloc(sizeof(Arena));
+  if (!arena) nrerror("\n  Allocation Failure in makeArena().");
+  arena -> chunk = NULL;
+  arena -> live  = 0;
+  arena -> peak  = 0;
+  arena -> total = 0;
+  return arena;
+}
+void freeArena(Arena *arena) {
+  ArenaChunk *chunk;
+  if (arena -> live > 0) {
+    RFprintf("\nRF-SRC:  *** ERROR *** ");
+    RFprintf("\nRF-SRC:  Tree arena released with %10.0f bytes still live.", (double) arena -> live);
+    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+    error("\nRF-SRC:  The application will now exit.\n");
+  }
+  while (arena -> chunk != NULL) {
+    chunk = arena -> chunk;
+    arena -> chunk = chunk -> prev;
+    free((FREE_ARG) (chunk));
+  }
+  free((FREE_ARG) (arena));
+}
+void *arenaBlock(Arena *arena, size_t size) {
+  ArenaChunk *chunk;
+  ArenaBlock *block;
+  size_t      chunkSize;
+  size = sizeof(ArenaBlock) + ((size + sizeof(ArenaBlock) - 1) & ~(sizeof(ArenaBlock) - 1));
+  chunk = arena -> chunk;
+  if ((chunk == NULL) || ((chunk -> used + size) > chunk -> size)) {
+    chunkSize = (chunk == NULL) ? ARENA_CHUNK_SIZE : (chunk -> size << 1);
+    if (chunkSize < size) {
+      chunkSize = size;
+    }
+    chunk = (ArenaChunk *) malloc(sizeof(ArenaChunk) + chunkSize);
+    if (!chunk) nrerror("\n  Allocation Failure in arenaBlock().");
+    chunk -> arena = arena;
+    chunk -> prev  = arena -> chunk;
+    chunk -> top   = NULL;
+    chunk -> size  = chunkSize;
+    chunk -> used  = 0;
+    arena -> chunk = chunk;
+  }
+  block = (ArenaBlock *) ((char *) (chunk + 1) + chunk -> used);
+  block -> chunk = chunk;
+  block -> prev  = chunk -> top;
+  block -> size  = size;
+  block -> freed = FALSE;
+  chunk -> top   = block;
+  chunk -> used += size;
+  arena -> live  += size;
+  arena -> total += size;
+  if (arena -> live > arena -> peak) {
+    arena -> peak = arena -> live;
+  }
+  return (void *) (block + 1);
+}
+void free_arenaBlock(ArenaBlock *block) {
+  ArenaChunk *chunk = block -> chunk;
+  block -> freed = TRUE;
+  (chunk -> arena) -> live -= block -> size;
+  while ((chunk -> top != NULL) && (chunk -> top -> freed)) {
+    chunk -> used = (char *) (chunk -> top) - (char *) (chunk + 1);
+    chunk -> top  = chunk -> top -> prev;
+  }
 }
 void *gvector(unsigned int nl, unsigned int nh, size_t size) {
   if (nh < nl) nrerror("\n  Illegal indices in gvector().");
@@ -1036,6 +1261,18 @@ void *new_vvector(unsigned int nl, unsigned int nh, enum alloc_type type) {
   case NRUTIL_FPTR:
     v = ((Factor **) gvector(nl, nh, sizeof(Factor*)) -nl+NR_END);
     break;
+  case NRUTIL_SPTR:
+    v = ((SplitCandidate **) gvector(nl, nh, sizeof(SplitCandidate*)) -nl+NR_END);
+    break;
+  case NRUTIL_RPTR:
+    v = ((TreeRecord **) gvector(nl, nh, sizeof(TreeRecord*)) -nl+NR_END);
+    break;
+  case NRUTIL_SFPTR:
+    v = ((ScoreForest **) gvector(nl, nh, sizeof(ScoreForest*)) -nl+NR_END);
+    break;
+  case NRUTIL_SWPTR:
+    v = ((ScoreWorker **) gvector(nl, nh, sizeof(ScoreWorker*)) -nl+NR_END);
+    break;
   case NRUTIL_FPTR2:
     v = ((Factor ***) gvector(nl, nh, sizeof(Factor**)) -nl+NR_END);
     break;
@@ -1096,6 +1333,18 @@ void free_new_vvector(void *v, unsigned int nl, unsigned int nh, enum alloc_type
   case NRUTIL_FPTR:
     free_gvector((Factor*) v+nl-NR_END, nl, nh, sizeof(Factor*));
     break;
+  case NRUTIL_SPTR:
+    free_gvector((SplitCandidate**) v+nl-NR_END, nl, nh, sizeof(SplitCandidate*));
+    break;
+  case NRUTIL_RPTR:
+    free_gvector((TreeRecord**) v+nl-NR_END, nl, nh, sizeof(TreeRecord*));
+    break;
+  case NRUTIL_SFPTR:
+    free_gvector((ScoreForest**) v+nl-NR_END, nl, nh, sizeof(ScoreForest*));
+    break;
+  case NRUTIL_SWPTR:
+    free_gvector((ScoreWorker**) v+nl-NR_END, nl, nh, sizeof(ScoreWorker*));
+    break;
   case NRUTIL_FPTR2:
     free_gvector((Factor**) v+nl-NR_END, nl, nh, sizeof(Factor**));
     break;
@@ -1204,6 +1453,7 @@ Node *makeNode(unsigned int xSize,
   }
   parent -> nodeID               = 0;
   parent -> depth                = 0;
+  parent -> presortOffset        = 0;
   parent -> splitDepth           = NULL;
   parent -> pseudoTerminal       = FALSE;
   parent -> mpIndexSize          = 0;
@@ -2366,7 +2616,7 @@ void updateCDF(uint    treeID,
     break;
   }
 }
-uint sampleFromCDF (float (*genericGenerator) (uint),
+uint sampleFromCDF (double (*genericGenerator) (uint),
                     uint    treeID,
                     uint    weightType,
                     uint   *sampleIndex,
@@ -2507,7 +2757,9 @@ SEXP rfsrcGrow(SEXP traceFlag,
                SEXP timeInterest,
                SEXP missTree,
                SEXP nImpute,
+               SEXP proximityTopK,
                SEXP numThreads) {
+  RF_arenaCurrent = NULL;
   int seedValue           = INTEGER(seedPtr)[0];
   RF_opt                  = INTEGER(opt)[0];
   RF_optHigh              = INTEGER(optHigh)[0];
@@ -2534,7 +2786,14 @@ SEXP rfsrcGrow(SEXP traceFlag,
   RF_timeInterestSize     = INTEGER(timeInterestSize)[0];
   RF_timeInterest         = REAL(timeInterest);  RF_timeInterest--;
   RF_nImpute              = INTEGER(nImpute)[0];
+  RF_proximityTopK        = INTEGER(proximityTopK)[0];
   RF_numThreads           = INTEGER(numThreads)[0];
+  if ((RF_optHigh & OPT_SPLT_HIST) && (RF_optHigh & OPT_SPLT_PARL)) {
+    RFprintf("\nRF-SRC:  *** ERROR *** ");
+    RFprintf("\nRF-SRC:  Parameter verification failed.");
+    RFprintf("\nRF-SRC:  Histogram split search and parallel split search cannot be requested together.");
+    error("\nRF-SRC:  The application will now exit.\n");
+  }
   if (RF_opt & OPT_IMPU_ONLY) {
     RF_opt                  = RF_opt & (OPT_IMPU_ONLY | OPT_BOOT_NODE |OPT_BOOT_NONE);
     RF_optHigh              = RF_optHigh & (OPT_MISS_SKIP | OPT_BOOT_SWOR);
@@ -2568,6 +2827,12 @@ SEXP rfsrcGrow(SEXP traceFlag,
   }
   else {
   }
+  if (RF_opt & OPT_BOOT_NODE) {
+    RF_optHigh = RF_optHigh & (~OPT_SORT_ONCE);
+  }
+  if ((RF_splitRule < REGR_WT_NRM) || (RF_splitRule > CLAS_WT_HVY)) {
+    RF_optHigh = RF_optHigh & (~OPT_SPLT_HIST);
+  }
   if (RF_opt & OPT_PROX) {
   }
   if (RF_splitRule == USPV_SPLIT) {
@@ -2728,8 +2993,10 @@ SEXP rfsrcPredict(SEXP traceFlag,
                   SEXP seed,
                   SEXP intrPredictorSize,
                   SEXP intrPredictor,
+                  SEXP proximityTopK,
                   SEXP numThreads) {
   char mode;
+  RF_arenaCurrent = NULL;
   int seedValue           = INTEGER(seedPtr)[0];
   RF_opt                  = INTEGER(opt)[0];
   RF_optHigh              = INTEGER(optHigh)[0];
@@ -2766,6 +3033,7 @@ SEXP rfsrcPredict(SEXP traceFlag,
   RF_seed_                = INTEGER(seed); RF_seed_ --;
   RF_intrPredictorSize    = INTEGER(intrPredictorSize)[0];
   RF_intrPredictor        = (uint*) INTEGER(intrPredictor);  RF_intrPredictor --;
+  RF_proximityTopK        = INTEGER(proximityTopK)[0];
   RF_numThreads           = INTEGER(numThreads)[0];
   RF_TN_SURV_ = REAL(tnSURV);
   RF_TN_MORT_ = REAL(tnMORT);
@@ -2920,6 +3188,402 @@ SEXP rfsrcPredict(SEXP traceFlag,
   }
   return rfsrc(mode, seedValue, INTEGER(traceFlag)[0]);
 }
+SEXP rfsrcScoreLoad(SEXP forestSize,
+                    SEXP rSize,
+                    SEXP rType,
+                    SEXP rLevels,
+                    SEXP xSize,
+                    SEXP xType,
+                    SEXP xLevels,
+                    SEXP timeInterestSize,
+                    SEXP eventTypeSize,
+                    SEXP crFlag,
+                    SEXP treeID,
+                    SEXP nodeID,
+                    SEXP parmID,
+                    SEXP contPT,
+                    SEXP mwcpSZ,
+                    SEXP mwcpPT,
+                    SEXP tnSURV,
+                    SEXP tnMORT,
+                    SEXP tnNLSN,
+                    SEXP tnCSHZ,
+                    SEXP tnCIFN,
+                    SEXP tnREGR,
+                    SEXP tnCLAS,
+                    SEXP tnMCNT,
+                    SEXP totalNodeCount,
+                    SEXP numThreads) {
+  ScoreForest *forest;
+  SEXP    handle;
+  uint   *treeID_;
+  uint   *nodeID_;
+  uint   *parmID_;
+  double *contPT_;
+  uint   *mwcpSZ_;
+  uint   *nodeCount;
+  uint   *treeOffset;
+  uint   *mwcpOffset;
+  uint   *classSize;
+  char   *typeString;
+  uint    forestSize_, rSize_, xSize_, timeInterestSize_, eventTypeSize_, totalNodeCount_;
+  uint    regrCount, classCount, levelSize, outcomeSize, mwcpSize;
+  char    crFlag_;
+  char    result;
+  uint    b, i;
+  RF_arenaCurrent   = NULL;
+  forestSize_       = INTEGER(forestSize)[0];
+  rSize_            = INTEGER(rSize)[0];
+  xSize_            = INTEGER(xSize)[0];
+  timeInterestSize_ = INTEGER(timeInterestSize)[0];
+  eventTypeSize_    = INTEGER(eventTypeSize)[0];
+  crFlag_           = (INTEGER(crFlag)[0] != 0) ? TRUE : FALSE;
+  totalNodeCount_   = INTEGER(totalNodeCount)[0];
+  treeID_ = (uint*) INTEGER(treeID);  treeID_ --;
+  nodeID_ = (uint*) INTEGER(nodeID);  nodeID_ --;
+  parmID_ = (uint*) INTEGER(parmID);  parmID_ --;
+  contPT_ = REAL(contPT);  contPT_ --;
+  mwcpSZ_ = (uint*) INTEGER(mwcpSZ);  mwcpSZ_ --;
+  if ((forestSize_ < 1) || (xSize_ < 1) || (totalNodeCount_ < 1)) {
+    RFprintf("\nRF-SRC:  *** ERROR *** ");
+    RFprintf("\nRF-SRC:  Parameter verification failed.");
+    RFprintf("\nRF-SRC:  Scoring requires a forest with at least one tree and one x-variable.");
+    RFprintf("\nRF-SRC:  The application will now exit.\n");
+    return R_NilValue;
+  }
+  regrCount = classCount = levelSize = 0;
+  classSize = uivector(1, (rSize_ > 0) ? rSize_ : 1);
+  if (eventTypeSize_ == 0) {
+    for (i = 1; i <= rSize_; i++) {
+      typeString = (char*) CHAR(STRING_ELT(AS_CHARACTER(rType), i-1));
+      if ((strcmp(typeString, "C") == 0) || (strcmp(typeString, "I") == 0)) {
+        classSize[++ classCount] = INTEGER(rLevels)[i-1];
+        levelSize += classSize[classCount];
+      }
+      else {
+        regrCount ++;
+      }
+    }
+    outcomeSize = regrCount + levelSize;
+  }
+  else if (!crFlag_) {
+    outcomeSize = 1 + (2 * timeInterestSize_);
+  }
+  else {
+    outcomeSize = eventTypeSize_ + (2 * eventTypeSize_ * timeInterestSize_);
+  }
+  if (outcomeSize == 0) {
+    free_uivector(classSize, 1, (rSize_ > 0) ? rSize_ : 1);
+    RFprintf("\nRF-SRC:  *** ERROR *** ");
+    RFprintf("\nRF-SRC:  Parameter verification failed.");
+    RFprintf("\nRF-SRC:  Scoring requires a forest with at least one outcome.");
+    RFprintf("\nRF-SRC:  The application will now exit.\n");
+    return R_NilValue;
+  }
+  nodeCount  = uivector(1, forestSize_);
+  treeOffset = uivector(1, forestSize_);
+  mwcpOffset = uivector(1, forestSize_);
+  for (b = 1; b <= forestSize_; b++) {
+    nodeCount[b] = treeOffset[b] = mwcpOffset[b] = 0;
+  }
+  mwcpSize = 0;
+  result = TRUE;
+  for (i = 1; i <= totalNodeCount_; i++) {
+    if ((treeID_[i] > 0) && (treeID_[i] <= forestSize_)) {
+      if (nodeCount[treeID_[i]] == 0) {
+        treeOffset[treeID_[i]] = i;
+        mwcpOffset[treeID_[i]] = mwcpSize;
+      }
+      nodeCount[treeID_[i]] ++;
+      mwcpSize += mwcpSZ_[i];
+    }
+    else {
+      RFprintf("\nRF-SRC:  *** ERROR *** ");
+      RFprintf("\nRF-SRC:  Invalid forest input record at line:  %10d", i);
+      RFprintf("\nRF-SRC:  The application will now exit.\n");
+      result = FALSE;
+      i = totalNodeCount_;
+    }
+  }
+  forest = NULL;
+  if (result) {
+    forest = makeScoreForest(forestSize_, xSize_, outcomeSize, totalNodeCount_, mwcpSize);
+    for (i = 1; i <= mwcpSize; i++) {
+      forest -> mwcpPT[i] = (uint) INTEGER(mwcpPT)[i-1];
+    }
+    for (i = 1; i <= xSize_; i++) {
+      typeString = (char*) CHAR(STRING_ELT(AS_CHARACTER(xType), i-1));
+      if ((strcmp(typeString, "C") == 0) || (strcmp(typeString, "I") == 0)) {
+        forest -> xLevels[i] = INTEGER(xLevels)[i-1];
+      }
+      else {
+        forest -> xLevels[i] = 0;
+      }
+    }
+    for (b = 1; b <= forestSize_; b++) {
+      forest -> leafCount[b] = (nodeCount[b] + 1) >> 1;
+      forest -> leafOffset[b] = forest -> leafSize;
+      forest -> leafSize += forest -> leafCount[b];
+      if (forest -> leafCount[b] > 0) {
+        forest -> treeCount ++;
+      }
+      flattenTree(forest -> flatForest,
+                  b,
+                  treeOffset[b],
+                  nodeCount[b],
+                  mwcpOffset[b],
+                  parmID_,
+                  contPT_,
+                  nodeID_,
+                  mwcpSZ_);
+    }
+    result = restoreScoreLeafValues(forest,
+                                    timeInterestSize_,
+                                    eventTypeSize_,
+                                    crFlag_,
+                                    regrCount,
+                                    classCount,
+                                    classSize,
+                                    REAL(tnSURV) - 1,
+                                    REAL(tnMORT) - 1,
+                                    REAL(tnNLSN) - 1,
+                                    REAL(tnCSHZ) - 1,
+                                    REAL(tnCIFN) - 1,
+                                    REAL(tnREGR) - 1,
+                                    ((uint*) INTEGER(tnCLAS)) - 1,
+                                    ((uint*) INTEGER(tnMCNT)) - 1);
+    forest -> numThreads = INTEGER(numThreads)[0];
+#ifdef _OPENMP
+    if (forest -> numThreads < 0) {
+      forest -> numThreads = omp_get_max_threads();
+    }
+    else {
+      forest -> numThreads = (forest -> numThreads < omp_get_max_threads()) ? (forest -> numThreads) : (omp_get_max_threads());
+    }
+#endif
+  }
+  free_uivector(nodeCount, 1, forestSize_);
+  free_uivector(treeOffset, 1, forestSize_);
+  free_uivector(mwcpOffset, 1, forestSize_);
+  free_uivector(classSize, 1, (rSize_ > 0) ? rSize_ : 1);
+  if (!result) {
+    if (forest != NULL) {
+      freeScoreForest(forest);
+    }
+    return R_NilValue;
+  }
+  PROTECT(handle = R_MakeExternalPtr(forest, R_NilValue, R_NilValue));
+  R_RegisterCFinalizerEx(handle, finalizeScoreForest, TRUE);
+  UNPROTECT(1);
+  return handle;
+}
+SEXP rfsrcScore(SEXP handle,
+                SEXP xData,
+                SEXP rowSize,
+                SEXP ensemble) {
+  ScoreForest *forest;
+  uint rowSize_;
+  RF_arenaCurrent = NULL;
+  forest = (ScoreForest*) R_ExternalPtrAddr(handle);
+  if (forest == NULL) {
+    RFprintf("\nRF-SRC:  *** ERROR *** ");
+    RFprintf("\nRF-SRC:  Scoring handle is no longer valid.");
+    RFprintf("\nRF-SRC:  The application will now exit.\n");
+    return R_NilValue;
+  }
+  if ((TYPEOF(rowSize) != INTSXP) || (XLENGTH(rowSize) != 1) || (INTEGER(rowSize)[0] < 0)) {
+    RFprintf("\nRF-SRC:  *** ERROR *** ");
+    RFprintf("\nRF-SRC:  Parameter verification failed.");
+    RFprintf("\nRF-SRC:  The row count must be a single non-negative integer.");
+    RFprintf("\nRF-SRC:  The application will now exit.\n");
+    return R_NilValue;
+  }
+  rowSize_ = INTEGER(rowSize)[0];
+  if ((TYPEOF(xData) != REALSXP) || (XLENGTH(xData) != (R_xlen_t) rowSize_ * forest -> xSize) ||
+      (TYPEOF(ensemble) != REALSXP) || (XLENGTH(ensemble) != (R_xlen_t) rowSize_ * forest -> outcomeSize)) {
+    RFprintf("\nRF-SRC:  *** ERROR *** ");
+    RFprintf("\nRF-SRC:  Parameter verification failed.");
+    RFprintf("\nRF-SRC:  Scoring %10d rows requires a double x-matrix with %10d columns and a double ensemble with %10d columns.", rowSize_, forest -> xSize, forest -> outcomeSize);
+    RFprintf("\nRF-SRC:  The application will now exit.\n");
+    return R_NilValue;
+  }
+  if (MAYBE_SHARED(ensemble)) {
+    PROTECT(ensemble = duplicate(ensemble));
+  }
+  else {
+    PROTECT(ensemble);
+  }
+  scoreForestRows(forest, REAL(xData), rowSize_, REAL(ensemble));
+  UNPROTECT(1);
+  return ensemble;
+}
+void finalizeScoreForest(SEXP handle) {
+  ScoreForest *forest;
+  forest = (ScoreForest*) R_ExternalPtrAddr(handle);
+  if (forest != NULL) {
+    freeScoreForest(forest);
+    R_ClearExternalPtr(handle);
+  }
+}
+SEXP rfsrcScoreServe(SEXP handleList,
+                     SEXP socketPath,
+                     SEXP maxRows,
+                     SEXP numWorkers) {
+#ifndef _WIN32
+  ScoreForest **forest;
+  ScoreWorker **worker;
+  struct sockaddr_un address;
+  struct stat pathStat;
+  struct pollfd request;
+  struct sigaction signalAction, signalActionOld;
+  char   stopFlag, bindFlag;
+  const char *path;
+  SEXP   result, resultNames, requestCount, rowCount, latency;
+  uint   forestCount, workerCount, maxRows_, xSize, outcomeSize;
+  int    listenFD, clientFD;
+  mode_t maskOld;
+  uint   i, k, w;
+  forestCount = length(handleList);
+  maxRows_    = INTEGER(maxRows)[0];
+  path        = CHAR(STRING_ELT(AS_CHARACTER(socketPath), 0));
+  if ((forestCount < 1) || (maxRows_ < 1) || (strlen(path) >= sizeof(address.sun_path))) {
+    RFprintf("\nRF-SRC:  *** ERROR *** ");
+    RFprintf("\nRF-SRC:  Parameter verification failed.");
+    RFprintf("\nRF-SRC:  Serving requires at least one forest, a positive row limit, and a valid socket path.");
+    RFprintf("\nRF-SRC:  The application will now exit.\n");
+    return R_NilValue;
+  }
+  forest = (ScoreForest **) new_vvector(1, forestCount, NRUTIL_SFPTR);
+  xSize = outcomeSize = 0;
+  for (i = 1; i <= forestCount; i++) {
+    forest[i] = (ScoreForest*) R_ExternalPtrAddr(VECTOR_ELT(handleList, i-1));
+    if (forest[i] == NULL) {
+      free_new_vvector(forest, 1, forestCount, NRUTIL_SFPTR);
+      RFprintf("\nRF-SRC:  *** ERROR *** ");
+      RFprintf("\nRF-SRC:  Scoring handle is no longer valid:  %10d", i);
+      RFprintf("\nRF-SRC:  The application will now exit.\n");
+      return R_NilValue;
+    }
+    if (forest[i] -> xSize > xSize) {
+      xSize = forest[i] -> xSize;
+    }
+    if (forest[i] -> outcomeSize > outcomeSize) {
+      outcomeSize = forest[i] -> outcomeSize;
+    }
+  }
+  if (lstat(path, &pathStat) == 0) {
+    if (S_ISSOCK(pathStat.st_mode)) {
+      unlink(path);
+    }
+    else {
+      free_new_vvector(forest, 1, forestCount, NRUTIL_SFPTR);
+      RFprintf("\nRF-SRC:  *** ERROR *** ");
+      RFprintf("\nRF-SRC:  Socket path exists and is not a socket:  %s", path);
+      RFprintf("\nRF-SRC:  The application will now exit.\n");
+      return R_NilValue;
+    }
+  }
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  strcpy(address.sun_path, path);
+  listenFD = socket(AF_UNIX, SOCK_STREAM, 0);
+  maskOld = umask(0177);
+  bindFlag = (listenFD >= 0) && (bind(listenFD, (struct sockaddr*) &address, sizeof(address)) == 0);
+  umask(maskOld);
+  if ((!bindFlag) ||
+      (listen(listenFD, SOMAXCONN) != 0) ||
+      (fcntl(listenFD, F_SETFL, fcntl(listenFD, F_GETFL, 0) | O_NONBLOCK) != 0)) {
+    if (listenFD >= 0) {
+      close(listenFD);
+    }
+    free_new_vvector(forest, 1, forestCount, NRUTIL_SFPTR);
+    RFprintf("\nRF-SRC:  *** ERROR *** ");
+    RFprintf("\nRF-SRC:  Unable to listen on socket:  %s", path);
+    RFprintf("\nRF-SRC:  The application will now exit.\n");
+    return R_NilValue;
+  }
+  workerCount = 1;
+#ifdef _OPENMP
+  if (INTEGER(numWorkers)[0] < 0) {
+    workerCount = omp_get_max_threads();
+  }
+  else if (INTEGER(numWorkers)[0] > 0) {
+    workerCount = INTEGER(numWorkers)[0];
+  }
+#endif
+  worker = (ScoreWorker **) new_vvector(1, workerCount, NRUTIL_SWPTR);
+  for (w = 1; w <= workerCount; w++) {
+    worker[w] = makeScoreWorker(maxRows_, xSize, outcomeSize);
+  }
+  stopFlag = FALSE;
+  RF_scoreSignal = FALSE;
+  memset(&signalAction, 0, sizeof(signalAction));
+  signalAction.sa_handler = catchScoreSignal;
+  sigemptyset(&signalAction.sa_mask);
+  sigaction(SIGTERM, &signalAction, &signalActionOld);
+#ifdef _OPENMP
+#pragma omp parallel num_threads(workerCount) private(w, request, clientFD)
+#endif
+  {
+#ifdef _OPENMP
+    w = omp_get_thread_num() + 1;
+#else
+    w = 1;
+#endif
+    RF_arenaCurrent = NULL;
+    while (!getScoreStopFlag(&stopFlag)) {
+      request.fd = listenFD;
+      request.events = POLLIN;
+      request.revents = 0;
+      if (poll(&request, 1, SCORE_POLL_MSEC) > 0) {
+        clientFD = accept(listenFD, NULL, NULL);
+        if (clientFD >= 0) {
+          serveScoreConnection(clientFD, forest, forestCount, worker, workerCount, w, &stopFlag);
+          close(clientFD);
+        }
+      }
+      else {
+        checkScoreInterrupt(&stopFlag);
+      }
+    }
+  }
+  close(listenFD);
+  unlink(path);
+  sigaction(SIGTERM, &signalActionOld, NULL);
+  if (RF_scoreSignal) {
+    raise(SIGTERM);
+  }
+  PROTECT(result = allocVector(VECSXP, 3));
+  PROTECT(resultNames = allocVector(STRSXP, 3));
+  PROTECT(requestCount = NEW_INTEGER(workerCount));
+  PROTECT(rowCount = NEW_NUMERIC(workerCount));
+  PROTECT(latency = NEW_INTEGER(workerCount * SCORE_HIST_SIZE));
+  for (w = 1; w <= workerCount; w++) {
+    INTEGER(requestCount)[w-1] = worker[w] -> requestCount;
+    REAL(rowCount)[w-1] = worker[w] -> rowCount;
+    for (k = 1; k <= SCORE_HIST_SIZE; k++) {
+      INTEGER(latency)[(k-1) * workerCount + (w-1)] = worker[w] -> latency[k];
+    }
+    freeScoreWorker(worker[w]);
+  }
+  free_new_vvector(worker, 1, workerCount, NRUTIL_SWPTR);
+  free_new_vvector(forest, 1, forestCount, NRUTIL_SFPTR);
+  SET_VECTOR_ELT(result, 0, requestCount);
+  SET_VECTOR_ELT(result, 1, rowCount);
+  SET_VECTOR_ELT(result, 2, latency);
+  SET_STRING_ELT(resultNames, 0, mkChar("requests"));
+  SET_STRING_ELT(resultNames, 1, mkChar("rows"));
+  SET_STRING_ELT(resultNames, 2, mkChar("latency"));
+  setAttrib(result, R_NamesSymbol, resultNames);
+  UNPROTECT(5);
+  return result;
+#else
+  RFprintf("\nRF-SRC:  *** ERROR *** ");
+  RFprintf("\nRF-SRC:  Serving over a local socket is not available on this platform.");
+  RFprintf("\nRF-SRC:  The application will now exit.\n");
+  return R_NilValue;
+#endif
+}
 SEXP rfsrcPartial(SEXP traceFlag,
                   SEXP seedPtr,
                   SEXP opt,
@@ -2956,6 +3620,7 @@ SEXP rfsrcPartial(SEXP traceFlag,
                   SEXP partialValues,
                   SEXP numThreads) {
   char mode;
+  RF_arenaCurrent = NULL;
   int seedValue           = INTEGER(seedPtr)[0];
   RF_opt                  = INTEGER(opt)[0];
   RF_optHigh              = INTEGER(optHigh)[0];
@@ -3328,6 +3993,7 @@ void initializeTimeArrays(char mode) {
   }
 }
 void stackFactorArrays() {
+  uint i;
   stackFactorGeneric(RF_rSize,
                      RF_rType,
                      &RF_rFactorMap,
@@ -3346,6 +4012,10 @@ void stackFactorArrays() {
                      &RF_xNonFactorMap,
                      &RF_xNonFactorCount,
                      &RF_xNonFactorIndex);
+  RF_xFactorSplitFlag = cvector(1, RF_xSize);
+  for (i = 1; i <= RF_xSize; i++) {
+    RF_xFactorSplitFlag[i] = (strcmp(RF_xType[i], "C") == 0) ? TRUE : FALSE;
+  }
 }
 void stackFactorGeneric(uint    size,
                         char  **type,
@@ -3419,6 +4089,7 @@ void unstackFactorArrays() {
     free_uivector(RF_xFactorSize, 1, RF_xFactorCount);
   }
   free_uivector(RF_xNonFactorMap, 1, RF_xSize);
+  free_cvector(RF_xFactorSplitFlag, 1, RF_xSize);
   if (RF_xNonFactorCount > 0) {
     free_uivector(RF_xNonFactorIndex, 1, RF_xNonFactorCount);
   }
@@ -3538,9 +4209,13 @@ char stackMissingArrays(char mode) {
     if (RF_timeIndex > 0) {
       RF_time = (double **) new_vvector(1, RF_forestSize, NRUTIL_DPTR);
       RF_masterTimeIndex = (uint **) new_vvector(1, RF_forestSize, NRUTIL_UPTR);
+      RF_splitEventTimeCount = (uint **) new_vvector(1, RF_forestSize, NRUTIL_UPTR);
+      RF_splitEventTimeIndex = (uint **) new_vvector(1, RF_forestSize, NRUTIL_UPTR);
       for (i = 1 ; i <= RF_forestSize; i++) {
         RF_time[i] = RF_responseIn[RF_timeIndex];
         RF_masterTimeIndex[i] = RF_masterTimeIndexIn;
+        RF_splitEventTimeCount[i] = NULL;
+        RF_splitEventTimeIndex[i] = NULL;
       }
       updateTimeIndexArray(0,
                            NULL,
@@ -3731,6 +4406,8 @@ void unstackMissingArrays(char mode) {
     if (RF_timeIndex > 0) {
       free_new_vvector(RF_time, 1, RF_forestSize, NRUTIL_DPTR);
       free_new_vvector(RF_masterTimeIndex, 1, RF_forestSize, NRUTIL_UPTR);
+      free_new_vvector(RF_splitEventTimeCount, 1, RF_forestSize, NRUTIL_UPTR);
+      free_new_vvector(RF_splitEventTimeIndex, 1, RF_forestSize, NRUTIL_UPTR);
     }
     if (RF_statusIndex > 0) {
       free_new_vvector(RF_status, 1, RF_forestSize, NRUTIL_DPTR);
@@ -4747,6 +5424,8 @@ void stackPreDefinedCommonArrays() {
   RF_oobMembershipFlag = (char **) new_vvector(1, RF_forestSize, NRUTIL_CPTR);
   RF_ibgMembershipIndex = (uint **) new_vvector(1, RF_forestSize, NRUTIL_UPTR);
   RF_oobMembershipIndex = (uint **) new_vvector(1, RF_forestSize, NRUTIL_UPTR);
+  RF_splitMembershipFlag = (char **) new_vvector(1, RF_forestSize, NRUTIL_CPTR);
+  RF_splitPartitionIndex = (uint **) new_vvector(1, RF_forestSize, NRUTIL_UPTR);
   RF_identityMembershipIndex = uivector(1, RF_observationSize);
   for (i = 1; i <= RF_observationSize; i++) {
     RF_identityMembershipIndex[i] = i;
@@ -4794,6 +5473,8 @@ void unstackPreDefinedCommonArrays() {
   free_new_vvector(RF_oobMembershipFlag, 1, RF_forestSize, NRUTIL_CPTR);
   free_new_vvector(RF_ibgMembershipIndex, 1, RF_forestSize, NRUTIL_UPTR);
   free_new_vvector(RF_oobMembershipIndex, 1, RF_forestSize, NRUTIL_UPTR);
+  free_new_vvector(RF_splitMembershipFlag, 1, RF_forestSize, NRUTIL_CPTR);
+  free_new_vvector(RF_splitPartitionIndex, 1, RF_forestSize, NRUTIL_UPTR);
   free_uivector(RF_identityMembershipIndex, 1, RF_observationSize);
   free_uivector(RF_oobSize, 1, RF_forestSize);
   free_uivector(RF_ibgSize, 1, RF_forestSize);
@@ -4852,6 +5533,204 @@ void unstackPreDefinedGrowthArrays() {
   }
   unstackWeights(RF_xWeightType, RF_xSize, RF_xWeightSorted); 
 }
+void stackPresortArrays() {
+  uint i, p;
+  RF_presortIndexIn = uimatrix(1, RF_xSize, 1, RF_observationSize);
+  for (p = 1; p <= RF_xSize; p++) {
+    indexx(RF_observationSize, RF_observationIn[p], RF_presortIndexIn[p]);
+  }
+  RF_presortIndex = (uint ***) new_vvector(1, RF_forestSize, NRUTIL_UPTR2);
+  for (i = 1; i <= RF_forestSize; i++) {
+    RF_presortIndex[i] = NULL;
+  }
+}
+void unstackPresortArrays() {
+  free_uimatrix(RF_presortIndexIn, 1, RF_xSize, 1, RF_observationSize);
+  free_new_vvector(RF_presortIndex, 1, RF_forestSize, NRUTIL_UPTR2);
+}
+void stackHistogramArrays() {
+  uint *indx;
+  uint binLimit;
+  uint i, p, b, d;
+  binLimit = upower(2, (RF_optHigh & OPT_SPLT_HIST) >> 16);
+  RF_histBinSize  = uivector(1, RF_xSize);
+  RF_histBinCode  = (uint **)   new_vvector(1, RF_xSize, NRUTIL_UPTR);
+  RF_histBinUpper = (double **) new_vvector(1, RF_xSize, NRUTIL_DPTR);
+  RF_histBinMax = 0;
+  indx = uivector(1, RF_observationSize);
+  for (p = 1; p <= RF_xSize; p++) {
+    RF_histBinSize[p]  = 0;
+    RF_histBinCode[p]  = NULL;
+    RF_histBinUpper[p] = NULL;
+    if (strcmp(RF_xType[p], "C") != 0) {
+      indexx(RF_observationSize, RF_observationIn[p], indx);
+      d = 1;
+      for (i = 2; i <= RF_observationSize; i++) {
+        if (RF_observationIn[p][indx[i]] > RF_observationIn[p][indx[i-1]]) {
+          d ++;
+        }
+      }
+      RF_histBinSize[p]  = (d < binLimit) ? d : binLimit;
+      RF_histBinCode[p]  = uivector(1, RF_observationSize);
+      RF_histBinUpper[p] = dvector(1, RF_histBinSize[p]);
+      b = 1;
+      for (i = 1; i <= RF_observationSize; i++) {
+        if (i > 1) {
+          if (RF_observationIn[p][indx[i]] > RF_observationIn[p][indx[i-1]]) {
+            if (d <= binLimit) {
+              b ++;
+            }
+            else if ((b < binLimit) && ((double) (i - 1) * binLimit >= (double) b * RF_observationSize)) {
+              b ++;
+            }
+          }
+        }
+        RF_histBinCode[p][indx[i]] = b;
+        RF_histBinUpper[p][b] = RF_observationIn[p][indx[i]];
+      }
+      RF_histBinSize[p] = b;
+      if (RF_histBinMax < b) {
+        RF_histBinMax = b;
+      }
+    }
+  }
+  free_uivector(indx, 1, RF_observationSize);
+}
+void unstackHistogramArrays() {
+  uint p;
+  for (p = 1; p <= RF_xSize; p++) {
+    if (RF_histBinCode[p] != NULL) {
+      free_uivector(RF_histBinCode[p], 1, RF_observationSize);
+      free_dvector(RF_histBinUpper[p], 1, RF_histBinSize[p]);
+    }
+  }
+  free_uivector(RF_histBinSize, 1, RF_xSize);
+  free_new_vvector(RF_histBinCode, 1, RF_xSize, NRUTIL_UPTR);
+  free_new_vvector(RF_histBinUpper, 1, RF_xSize, NRUTIL_DPTR);
+}
+void stackPresortIndex(uint treeID, uint *membrIndx, uint membrSize) {
+  uint *membrStart;
+  uint *membrIter;
+  uint *membrPosition;
+  uint i, j, k, p;
+  uint obs;
+  membrStart    = uivector(1, RF_observationSize + 1);
+  membrIter     = uivector(1, RF_observationSize);
+  membrPosition = uivector(1, membrSize);
+  for (i = 1; i <= RF_observationSize; i++) {
+    membrIter[i] = 0;
+  }
+  for (i = 1; i <= membrSize; i++) {
+    membrIter[membrIndx[i]] ++;
+  }
+  membrStart[1] = 1;
+  for (i = 1; i <= RF_observationSize; i++) {
+    membrStart[i + 1] = membrStart[i] + membrIter[i];
+    membrIter[i] = membrStart[i];
+  }
+  for (i = 1; i <= membrSize; i++) {
+    membrPosition[membrIter[membrIndx[i]] ++] = i;
+  }
+  RF_presortIndex[treeID] = uimatrix(1, RF_xSize, 1, membrSize);
+  for (p = 1; p <= RF_xSize; p++) {
+    k = 0;
+    for (i = 1; i <= RF_observationSize; i++) {
+      obs = RF_presortIndexIn[p][i];
+      for (j = membrStart[obs]; j < membrStart[obs + 1]; j++) {
+        RF_presortIndex[treeID][p][++k] = membrPosition[j];
+      }
+    }
+  }
+  free_uivector(membrStart, 1, RF_observationSize + 1);
+  free_uivector(membrIter, 1, RF_observationSize);
+  free_uivector(membrPosition, 1, membrSize);
+}
+void unstackPresortIndex(uint treeID, uint membrSize) {
+  if (RF_presortIndex[treeID] != NULL) {
+    free_uimatrix(RF_presortIndex[treeID], 1, RF_xSize, 1, membrSize);
+    RF_presortIndex[treeID] = NULL;
+  }
+}
+void partitionPresortIndex(uint  treeID,
+                           Node *parent,
+                           uint *repMembrIndx,
+                           uint  repMembrSize,
+                           char *membershipIndicator) {
+  uint *daughterPosition;
+  uint *rghtIndex;
+  uint *index;
+  uint leftRepSize, rghtRepSize;
+  uint leftSize, rghtSize;
+  uint i, k, p;
+  daughterPosition = uivector(1, repMembrSize);
+  rghtIndex        = uivector(1, repMembrSize);
+  leftRepSize = rghtRepSize = 0;
+  for (i = 1; i <= repMembrSize; i++) {
+    if (membershipIndicator[repMembrIndx[i]] == LEFT) {
+      daughterPosition[i] = ++leftRepSize;
+    }
+    else {
+      daughterPosition[i] = ++rghtRepSize;
+    }
+  }
+  for (p = 1; p <= RF_xSize; p++) {
+    if ((parent -> left) -> permissibleSplit[p]) {
+      index = RF_presortIndex[treeID][p] + (parent -> presortOffset);
+      leftSize = rghtSize = 0;
+      for (i = 1; i <= repMembrSize; i++) {
+        k = index[i];
+        if (membershipIndicator[repMembrIndx[k]] == LEFT) {
+          index[++leftSize] = daughterPosition[k];
+        }
+        else {
+          rghtIndex[++rghtSize] = daughterPosition[k];
+        }
+      }
+      for (i = 1; i <= rghtSize; i++) {
+        index[leftSize + i] = rghtIndex[i];
+      }
+    }
+  }
+  (parent -> left)  -> presortOffset = parent -> presortOffset;
+  (parent -> right) -> presortOffset = (parent -> presortOffset) + leftRepSize;
+  free_uivector(daughterPosition, 1, repMembrSize);
+  free_uivector(rghtIndex, 1, repMembrSize);
+}
+void stackSplitPartition(uint treeID) {
+  RF_splitMembershipFlag[treeID] = cvector(1, RF_observationSize);
+  RF_splitPartitionIndex[treeID] = uivector(1, getSplitPartitionSize());
+}
+void unstackSplitPartition(uint treeID) {
+  free_cvector(RF_splitMembershipFlag[treeID], 1, RF_observationSize);
+  free_uivector(RF_splitPartitionIndex[treeID], 1, getSplitPartitionSize());
+  RF_splitMembershipFlag[treeID] = NULL;
+  RF_splitPartitionIndex[treeID] = NULL;
+}
+uint getSplitPartitionSize() {
+  return (RF_bootstrapSize > RF_observationSize) ? RF_bootstrapSize : RF_observationSize;
+}
+uint partitionMembership(uint  treeID,
+                         uint *membrIndx,
+                         uint  membrSize,
+                         char *membershipIndicator) {
+  uint *rghtIndex;
+  uint  leftSize, rghtSize;
+  uint  i;
+  rghtIndex = RF_splitPartitionIndex[treeID];
+  leftSize = rghtSize = 0;
+  for (i = 1; i <= membrSize; i++) {
+    if (membershipIndicator[membrIndx[i]] == LEFT) {
+      membrIndx[++leftSize] = membrIndx[i];
+    }
+    else {
+      rghtIndex[++rghtSize] = membrIndx[i];
+    }
+  }
+  for (i = 1; i <= rghtSize; i++) {
+    membrIndx[leftSize + i] = rghtIndex[i];
+  }
+  return leftSize;
+}
 void stackPreDefinedRestoreArrays() {
   uint i;
   RF_nodeCount = uivector(1, RF_forestSize);
@@ -5189,6 +6068,9 @@ uint stackDefinedOutputObjects(char      mode,
     if (RF_opt & OPT_PROX) {
       proximitySize = ((obsSize + 1)  * obsSize) >> 1;
       (*stackCount) += 1;
+      if (RF_optHigh & OPT_PROX_SPRS) {
+        (*stackCount) += 2;
+      }
     }
     if (RF_opt & OPT_NODE_STAT) {
       (*stackCount) += 1;
@@ -5311,6 +6193,9 @@ uint stackDefinedOutputObjects(char      mode,
     if (RF_opt & OPT_PROX) {
       proximitySize = ((obsSize + 1)  * obsSize) >> 1;
       (*stackCount) += 1;
+      if (RF_optHigh & OPT_PROX_SPRS) {
+        (*stackCount) += 2;
+      }
     }
     if (RF_opt & OPT_SEED) {
       if (RF_opt & OPT_TREE) {
@@ -5836,24 +6721,41 @@ uint stackDefinedOutputObjects(char      mode,
     }
   }  
   if (RF_opt & OPT_PROX) {
-    PROTECT(sexpVector[RF_PROX_ID] = NEW_NUMERIC(proximitySize));
-    SET_VECTOR_ELT(sexpVector[RF_OUTP_ID], sexpIndex, sexpVector[RF_PROX_ID]);
-    SET_STRING_ELT(sexpVector[RF_STRG_ID], sexpIndex, mkChar(sexpString[RF_PROX_ID]));
-    *pRF_proximity = NUMERIC_POINTER(sexpVector[RF_PROX_ID]);
-    sexpIndex ++;
-    RF_proximityDen = dvector(1, proximitySize);
-    (*pRF_proximity) --;
-    for (i = 1; i <= proximitySize; i++) {
-      (*pRF_proximity)[i] = 0;
-      RF_proximityDen[i]  = 0;
+    if (RF_optHigh & OPT_PROX_SPRS) {
+      RF_proximitySexpIndex = sexpIndex;
+      SET_STRING_ELT(sexpVector[RF_STRG_ID], sexpIndex, mkChar(sexpString[RF_PROX_ID]));
+      SET_STRING_ELT(sexpVector[RF_STRG_ID], sexpIndex + 1, mkChar(sexpString[RF_PROX_IDX]));
+      SET_STRING_ELT(sexpVector[RF_STRG_ID], sexpIndex + 2, mkChar(sexpString[RF_PROX_COL]));
+      sexpIndex += 3;
+      *pRF_proximity = NULL;
     }
-    RF_proximityPtr = (double **) new_vvector(1, obsSize, NRUTIL_DPTR);
-    RF_proximityDenPtr = (double **) new_vvector(1, obsSize, NRUTIL_DPTR);
-    RF_proximityPtr[1] = *pRF_proximity;
-    RF_proximityDenPtr[1] = RF_proximityDen;    
-    for (i = 2; i <= obsSize; i++) {
-      RF_proximityPtr[i] = RF_proximityPtr[i-1] + i - 1;
-      RF_proximityDenPtr[i] = RF_proximityDenPtr[i-1] + i - 1;
+    else {
+      PROTECT(sexpVector[RF_PROX_ID] = NEW_NUMERIC(proximitySize));
+      SET_VECTOR_ELT(sexpVector[RF_OUTP_ID], sexpIndex, sexpVector[RF_PROX_ID]);
+      SET_STRING_ELT(sexpVector[RF_STRG_ID], sexpIndex, mkChar(sexpString[RF_PROX_ID]));
+      *pRF_proximity = NUMERIC_POINTER(sexpVector[RF_PROX_ID]);
+      sexpIndex ++;
+      (*pRF_proximity) --;
+      for (i = 1; i <= proximitySize; i++) {
+        (*pRF_proximity)[i] = 0;
+      }
+      RF_proximityPtr = (double **) new_vvector(1, obsSize, NRUTIL_DPTR);
+      RF_proximityPtr[1] = *pRF_proximity;
+      for (i = 2; i <= obsSize; i++) {
+        RF_proximityPtr[i] = RF_proximityPtr[i-1] + i - 1;
+      }
+    }
+    RF_proximityTree = cvector(1, RF_forestSize);
+    for (i = 1; i <= RF_forestSize; i++) {
+      RF_proximityTree[i] = FALSE;
+    }
+    if (!((RF_opt & OPT_PROX_IBG) && (RF_opt & OPT_PROX_OOB))) {
+      RF_proximityFlag = cmatrix(1, RF_forestSize, 1, obsSize);
+      for (i = 1; i <= RF_forestSize; i++) {
+        for (j = 1; j <= obsSize; j++) {
+          RF_proximityFlag[i][j] = FALSE;
+        }
+      }
     }
   }
   if (RF_opt & OPT_LEAF) {
@@ -5996,13 +6898,24 @@ uint stackDefinedOutputObjects(char      mode,
     }
     (*pRF_bootstrapMembership) --;
   }
+  else if (RF_opt & OPT_PROX) {
+    RF_proximityMembershipIndex = uivector(1, RF_forestSize * obsSize);
+    RF_tTermMembershipIndexPtr = (uint **) new_vvector(1, RF_forestSize, NRUTIL_UPTR);
+    for (i = 1; i <= RF_forestSize; i++) {
+      (RF_tTermMembershipIndexPtr)[i] = RF_proximityMembershipIndex + ((i-1) * obsSize);
+    }
+    for (i = 1; i <= RF_forestSize; i++) {
+      for (j = 1; j <= obsSize; j++) {
+        (RF_tTermMembershipIndexPtr)[i][j] = 0;
+      }
+    }
+  }
   return (sexpIndex);
 }
 void unstackDefinedOutputObjects(char      mode,
                                  Node    **root) {
   uint obsSize;
   uint xVimpSize;
-  uint proximitySize;
   char oobFlag, fullFlag;
   uint rspSize;
   uint dpthDimOne;
@@ -6023,7 +6936,6 @@ void unstackDefinedOutputObjects(char      mode,
   uint i, j, k;
   obsSize        = 0;  
   xVimpSize      = 0;  
-  proximitySize  = 0;  
   rspSize        = 0;  
   dpthDimOne     = 0;  
   if (RF_opt & (OPT_SPLDPTH_F | OPT_SPLDPTH_T)) {
@@ -6038,16 +6950,10 @@ void unstackDefinedOutputObjects(char      mode,
   case RF_PRED:
     obsSize = RF_fobservationSize;
     rspSize = RF_frSize;
-    if (RF_opt & OPT_PROX) {
-      proximitySize = ((obsSize + 1)  * obsSize) >> 1;
-    }
     break;
   default:
     obsSize = RF_observationSize;
     rspSize = RF_rSize;
-    if (RF_opt & OPT_PROX) {
-      proximitySize = ((obsSize + 1)  * obsSize) >> 1;
-    }
     break;
   }
   oobFlag = fullFlag = FALSE;
@@ -6292,9 +7198,13 @@ void unstackDefinedOutputObjects(char      mode,
     }
   }  
   if (RF_opt & OPT_PROX) {
-    free_dvector(RF_proximityDen, 1, proximitySize);
-    free_new_vvector(RF_proximityPtr, 1, obsSize, NRUTIL_DPTR);
-    free_new_vvector(RF_proximityDenPtr, 1, obsSize, NRUTIL_DPTR);
+    if (!(RF_optHigh & OPT_PROX_SPRS)) {
+      free_new_vvector(RF_proximityPtr, 1, obsSize, NRUTIL_DPTR);
+    }
+    free_cvector(RF_proximityTree, 1, RF_forestSize);
+    if (!((RF_opt & OPT_PROX_IBG) && (RF_opt & OPT_PROX_OOB))) {
+      free_cmatrix(RF_proximityFlag, 1, RF_forestSize, 1, obsSize);
+    }
   }
   if (RF_opt & OPT_MISS) {
     if (rspSize > 0) {
@@ -6323,6 +7233,10 @@ void unstackDefinedOutputObjects(char      mode,
       free_new_vvector(RF_pNodeMembershipIndexPtr, 1, RF_forestSize, NRUTIL_UPTR);
     }
   }
+  else if (RF_opt & OPT_PROX) {
+    free_new_vvector(RF_tTermMembershipIndexPtr, 1, RF_forestSize, NRUTIL_UPTR);
+    free_uivector(RF_proximityMembershipIndex, 1, RF_forestSize * obsSize);
+  }
   switch (mode) {
   case RF_PRED:
     if (RF_rSize == 0) {
@@ -7489,8 +8403,6 @@ char classificationXwghtSplit (uint    treeID,
   uint nonMissMembrSize, nonMissMembrSizeStatic;
   uint *nonMissMembrIndx, *nonMissMembrIndxStatic;
   uint   *indxx;
-  uint priorMembrIter, currentMembrIter;
-  uint leftSize, rghtSize;
   char *localSplitIndicator;
   uint splitLength;
   void *splitVectorPtr;
@@ -7498,8 +8410,7 @@ char classificationXwghtSplit (uint    treeID,
   uint mwcpSizeAbsolute;
   char deterministicSplitFlag;
   char preliminaryResult, result;
-  double delta, deltaMax;
-  uint j, k, p;
+  double deltaMax;
   localSplitIndicator    = NULL;  
   mwcpSizeAbsolute       = 0;     
   *splitParameterMax     = 0;
@@ -7535,171 +8446,184 @@ char classificationXwghtSplit (uint    treeID,
     uint *parentClassProp = uivector(1, responseClassCount);
     uint *leftClassProp   = uivector(1, responseClassCount);
     uint *rghtClassProp   = uivector(1, responseClassCount);
-    double sumLeft, sumRght, sumLeftSqr, sumRghtSqr;
-    delta = 0;  
+    uint  *histCount = NULL;
+    uint **histClass = NULL;
+    if ((RF_optHigh & OPT_SPLT_HIST) && (RF_histBinMax > 0)) {
+      histCount = uivector(1, RF_histBinMax);
+      histClass = uimatrix(1, RF_histBinMax, 1, responseClassCount);
+    }
+    uint candidateSize = getSplitCandidateSize();
     uint actualCovariateCount = 0;
     uint candidateCovariateCount = 0;
-    while (selectRandomCovariates(treeID,
-                                  parent,
-                                  repMembrIndx,
-                                  repMembrSize,
-                                  randomCovariateIndex,
-                                  & uniformCovariateSize,
-                                  & uniformCovariateIndex,
-                                  cdf,
-                                  & cdfSize,
-                                  cdfSort,
-                                  density,
-                                  & densitySize,
-                                  densitySwap,
-                                  & covariate,
-                                  & actualCovariateCount,
-                                  & candidateCovariateCount,
-                                  splitVector,
-                                  & splitVectorSize,
-                                  & indxx,
-                                  nonMissMembrSizeStatic,
-                                  nonMissMembrIndxStatic,
-                                  & nonMissMembrSize,
-                                  & nonMissMembrIndx,
-                                  multImpFlag)) {
-      for (j = 1; j <= repMembrSize; j++) {
-        localSplitIndicator[j] = NEITHER;
-      }
-      for (p=1; p <= responseClassCount; p++) {
-        parentClassProp[p] = 0;
-      }
-      for (j = 1; j <= nonMissMembrSize; j++) {
-        parentClassProp[RF_classLevelIndex[1][ (uint) RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[j]]] ]]] ++;
-      }
-      leftSize = 0;
-      priorMembrIter = 0;
-      splitLength = stackAndConstructSplitVector(treeID,
-                                                 repMembrSize,
-                                                 covariate,
-                                                 splitVector,
-                                                 splitVectorSize,
-                                                 & factorFlag,
-                                                 & deterministicSplitFlag,
-                                                 & mwcpSizeAbsolute,
-                                                 & splitVectorPtr);
-      if (factorFlag == FALSE) {
-        for (j = 1; j <= nonMissMembrSize; j++) {
-          localSplitIndicator[ nonMissMembrIndx[indxx[j]] ] = RIGHT;
-        }
-        for (p = 1; p <= responseClassCount; p++) {
-          rghtClassProp[p] = parentClassProp[p];
-          leftClassProp[p] = 0;
-        }
-      }
-      for (j = 1; j < splitLength; j++) {
-        if (factorFlag == TRUE) {
-          priorMembrIter = 0;
-          leftSize = 0;
+    if (candidateSize > 0) {
+      SplitCandidate **candidate = stackSplitCandidates(candidateSize, repMembrSize, responseClassCount);
+      uint candidateCount, c;
+      do {
+        candidateCount = selectSplitCandidates(treeID,
+                                               parent,
+                                               repMembrIndx,
+                                               repMembrSize,
+                                               randomCovariateIndex,
+                                               & uniformCovariateSize,
+                                               & uniformCovariateIndex,
+                                               cdf,
+                                               & cdfSize,
+                                               cdfSort,
+                                               density,
+                                               & densitySize,
+                                               densitySwap,
+                                               & actualCovariateCount,
+                                               & candidateCovariateCount,
+                                               nonMissMembrSizeStatic,
+                                               nonMissMembrIndxStatic,
+                                               multImpFlag,
+                                               candidate,
+                                               candidateSize);
+        for (c = 1; c <= candidateCount; c++) {
+#ifdef _OPENMP
+#pragma omp task firstprivate(c) if (candidateCount > 1)
+#endif
+          classificationCandidateSplit(treeID,
+                                       parent,
+                                       repMembrIndx,
+                                       repMembrSize,
+                                       candidate[c] -> nonMissMembrIndx,
+                                       candidate[c] -> nonMissMembrSize,
+                                       candidate[c] -> indxx,
+                                       candidate[c] -> covariate,
+                                       candidate[c] -> candidateCovariateCount,
+                                       candidate[c] -> splitLength,
+                                       candidate[c] -> splitVectorPtr,
+                                       candidate[c] -> factorFlag,
+                                       candidate[c] -> mwcpSizeAbsolute,
+                                       candidate[c] -> localSplitIndicator,
+                                       candidate[c] -> parentClassProp,
+                                       candidate[c] -> leftClassProp,
+                                       candidate[c] -> rghtClassProp,
+                                       & candidate[c] -> deltaMax,
+                                       & candidate[c] -> splitParameterMax,
+                                       & candidate[c] -> splitValueMaxCont,
+                                       & candidate[c] -> splitValueMaxFactSize,
+                                       & candidate[c] -> splitValueMaxFactPtr,
+                                       NULL);
         }
-        virtuallySplitNode(treeID,
-                              factorFlag,
-                              mwcpSizeAbsolute,
-                              covariate,
-                              repMembrIndx,
-                              repMembrSize,
-                              nonMissMembrIndx,
-                              nonMissMembrSize,
-                              indxx,
-                              splitVectorPtr,
-                              j,
-                              localSplitIndicator,
-                              & leftSize,
-                              priorMembrIter,
-                              & currentMembrIter);
-        rghtSize = nonMissMembrSize - leftSize;
-        if (factorFlag == TRUE) {
-          for (p=1; p <= responseClassCount; p++) {
-            leftClassProp[p] = 0;
-          }
-          for (k = 1; k <= nonMissMembrSize; k++) {
-            if (localSplitIndicator[ nonMissMembrIndx[indxx[k]] ] == LEFT)  {
-              leftClassProp[RF_classLevelIndex[1][ (uint) RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]]] ++;
-            }
-          }
-          for (p=1; p <= responseClassCount; p++) {
-            rghtClassProp[p] = parentClassProp[p] - leftClassProp[p];
-          }
+#ifdef _OPENMP
+#pragma omp taskwait
+#endif
+        unselectSplitCandidates(treeID,
+                                parent,
+                                repMembrIndx,
+                                repMembrSize,
+                                nonMissMembrSizeStatic,
+                                multImpFlag,
+                                candidate,
+                                candidateCount,
+                                & deltaMax,
+                                splitParameterMax,
+                                splitValueMaxCont,
+                                splitValueMaxFactSize,
+                                splitValueMaxFactPtr,
+                                splitIndicator);
+      } while (candidateCount == candidateSize);
+      unstackSplitCandidates(candidate, candidateSize, repMembrSize);
+    }
+    else {
+      while (selectRandomCovariates(treeID,
+                                    parent,
+                                    repMembrIndx,
+                                    repMembrSize,
+                                    randomCovariateIndex,
+                                    & uniformCovariateSize,
+                                    & uniformCovariateIndex,
+                                    cdf,
+                                    & cdfSize,
+                                    cdfSort,
+                                    density,
+                                    & densitySize,
+                                    densitySwap,
+                                    & covariate,
+                                    & actualCovariateCount,
+                                    & candidateCovariateCount,
+                                    splitVector,
+                                    & splitVectorSize,
+                                    & indxx,
+                                    nonMissMembrSizeStatic,
+                                    nonMissMembrIndxStatic,
+                                    & nonMissMembrSize,
+                                    & nonMissMembrIndx,
+                                    multImpFlag)) {
+        if ((RF_optHigh & OPT_SPLT_HIST) && (RF_histBinSize[covariate] > 0)) {
+          classificationHistogramSplit(treeID,
+                                       parent,
+                                       repMembrIndx,
+                                       repMembrSize,
+                                       nonMissMembrIndx,
+                                       nonMissMembrSize,
+                                       covariate,
+                                       candidateCovariateCount,
+                                       histCount,
+                                       histClass,
+                                       parentClassProp,
+                                       leftClassProp,
+                                       rghtClassProp,
+                                       localSplitIndicator,
+                                       & deltaMax,
+                                       splitParameterMax,
+                                       splitValueMaxCont,
+                                       splitValueMaxFactSize,
+                                       splitValueMaxFactPtr,
+                                       splitIndicator);
         }
         else {
-          for (k = priorMembrIter + 1; k < currentMembrIter; k++) {
-            leftClassProp[RF_classLevelIndex[1][(uint) RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]]] ++;
-            rghtClassProp[RF_classLevelIndex[1][(uint) RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]]] --;
-          }
-        }
-        sumLeft = sumRght = 0.0;
-        switch(RF_splitRule) {
-        case CLAS_WT_NRM:
-          for (p=1; p <= responseClassCount; p++) {
-            sumLeft += (double) upower(leftClassProp[p], 2);
-            sumRght += (double) upower(rghtClassProp[p], 2);
-          }
-          sumLeftSqr = sumLeft / leftSize;
-          sumRghtSqr  = sumRght / rghtSize;
-          delta = (sumLeftSqr + sumRghtSqr) / nonMissMembrSize;
-          break;
-        case CLAS_WT_OFF:
-          for (p=1; p <= responseClassCount; p++) {
-            sumLeft += pow((double) leftClassProp[p] / (double) leftSize, 2.0);
-            sumRght += pow((double) (rghtClassProp[p]) / (double) rghtSize, 2.0);
-          }
-          delta = sumLeft + sumRght;
-          break;
-        case CLAS_WT_HVY:
-          for (p=1; p <= responseClassCount; p++) {
-            sumLeft += (double) upower(leftClassProp[p], 2);
-            sumRght += (double) upower(rghtClassProp[p], 2);
-          }
-          delta =
-            (sumLeft / (double) (upower(nonMissMembrSize, 2))) +
-            (sumRght / (double) (upower(nonMissMembrSize, 2))) -
-            pow((double) leftSize / nonMissMembrSize, 2.0) -
-            pow((double) rghtSize / nonMissMembrSize, 2.0) + 2.0;
-          break;
-        default:
-          break;
-        }
-        updateMaximumSplit(treeID,
-                           parent,
-                           delta,
-                           candidateCovariateCount,
-                           covariate,
-                           j,
-                           factorFlag,
-                           mwcpSizeAbsolute,
-                           repMembrSize,
-                           localSplitIndicator,
-                           & deltaMax,
-                           splitParameterMax,
-                           splitValueMaxCont,
-                           splitValueMaxFactSize,
-                           splitValueMaxFactPtr,
-                           splitVectorPtr,
-                           splitIndicator);
-        if (factorFlag == FALSE) {
-          priorMembrIter = currentMembrIter - 1;
+          splitLength = stackAndConstructSplitVector(treeID,
+                                                     repMembrSize,
+                                                     covariate,
+                                                     splitVector,
+                                                     splitVectorSize,
+                                                     & factorFlag,
+                                                     & deterministicSplitFlag,
+                                                     & mwcpSizeAbsolute,
+                                                     & splitVectorPtr);
+          classificationCandidateSplit(treeID,
+                                       parent,
+                                       repMembrIndx,
+                                       repMembrSize,
+                                       nonMissMembrIndx,
+                                       nonMissMembrSize,
+                                       indxx,
+                                       covariate,
+                                       candidateCovariateCount,
+                                       splitLength,
+                                       splitVectorPtr,
+                                       factorFlag,
+                                       mwcpSizeAbsolute,
+                                       localSplitIndicator,
+                                       parentClassProp,
+                                       leftClassProp,
+                                       rghtClassProp,
+                                       & deltaMax,
+                                       splitParameterMax,
+                                       splitValueMaxCont,
+                                       splitValueMaxFactSize,
+                                       splitValueMaxFactPtr,
+                                       splitIndicator);
+          unstackSplitVector(treeID,
+                             splitVectorSize,
+                             splitLength,
+                             factorFlag,
+                             deterministicSplitFlag,
+                             mwcpSizeAbsolute,
+                             splitVectorPtr);
         }
+        unselectRandomCovariates(treeID,
+                                 parent,
+                                 repMembrSize,
+                                 indxx,
+                                 nonMissMembrSizeStatic,
+                                 nonMissMembrIndx,
+                                 multImpFlag);
       }  
-      unstackSplitVector(treeID,
-                         splitVectorSize,
-                         splitLength,
-                         factorFlag,
-                         deterministicSplitFlag,
-                         mwcpSizeAbsolute,
-                         splitVectorPtr);
-      unselectRandomCovariates(treeID,
-                               parent,
-                               repMembrSize,
-                               indxx,
-                               nonMissMembrSizeStatic,
-                               nonMissMembrIndx,
-                               multImpFlag);
-    }  
+    }
     unstackRandomCovariates(treeID,
                             parent,
                             randomCovariateIndex,
@@ -7714,6 +8638,10 @@ char classificationXwghtSplit (uint    treeID,
     free_uivector (parentClassProp, 1, responseClassCount);
     free_uivector (leftClassProp,   1, responseClassCount);
     free_uivector (rghtClassProp,   1, responseClassCount);
+    if ((RF_optHigh & OPT_SPLT_HIST) && (RF_histBinMax > 0)) {
+      free_uivector(histCount, 1, RF_histBinMax);
+      free_uimatrix(histClass, 1, RF_histBinMax, 1, responseClassCount);
+    }
     unstackSplitIndicator(repMembrSize, localSplitIndicator);
   }  
   unstackPreSplit(preliminaryResult,
@@ -7730,774 +8658,405 @@ char classificationXwghtSplit (uint    treeID,
                                  deltaMax);
   return result;
 }
-char regressionXwghtSplit (uint    treeID,
-                           Node   *parent,
-                           uint   *repMembrIndx,
-                           uint    repMembrSize,
-                           uint   *allMembrIndx,
-                           uint    allMembrSize,
-                           uint   *splitParameterMax,
-                           double *splitValueMaxCont,
-                           uint   *splitValueMaxFactSize,
-                           uint  **splitValueMaxFactPtr,
-                           double *splitStatistic,
-                           char  **splitIndicator,
-                           char    multImpFlag) {
-  uint   *randomCovariateIndex;
-  uint    uniformCovariateIndex;
-  uint    uniformCovariateSize;
-  double *cdf;
-  uint    cdfSize;
-  uint   *cdfSort;
-  uint   *density;
-  uint    densitySize;
-  uint  **densitySwap;
-  uint     covariate;
-  double  *splitVector;
-  uint     splitVectorSize;
-  uint nonMissMembrSize, nonMissMembrSizeStatic;
-  uint *nonMissMembrIndx, *nonMissMembrIndxStatic;
-  uint   *indxx;
+void classificationCandidateSplit(uint    treeID,
+                                  Node   *parent,
+                                  uint   *repMembrIndx,
+                                  uint    repMembrSize,
+                                  uint   *nonMissMembrIndx,
+                                  uint    nonMissMembrSize,
+                                  uint   *indxx,
+                                  uint    covariate,
+                                  uint    candidateCovariateCount,
+                                  uint    splitLength,
+                                  void   *splitVectorPtr,
+                                  char    factorFlag,
+                                  uint    mwcpSizeAbsolute,
+                                  char   *localSplitIndicator,
+                                  uint   *parentClassProp,
+                                  uint   *leftClassProp,
+                                  uint   *rghtClassProp,
+                                  double *deltaMax,
+                                  uint   *splitParameterMax,
+                                  double *splitValueMaxCont,
+                                  uint   *splitValueMaxFactSize,
+                                  uint  **splitValueMaxFactPtr,
+                                  char  **splitIndicator) {
   uint priorMembrIter, currentMembrIter;
   uint leftSize, rghtSize;
-  char *localSplitIndicator;
-  uint splitLength;
-  void *splitVectorPtr;
-  char factorFlag;
-  uint mwcpSizeAbsolute;
-  char deterministicSplitFlag;
-  char preliminaryResult, result;
-  double delta, deltaMax;
-  uint j, k;
-  localSplitIndicator    = NULL;  
-  mwcpSizeAbsolute       = 0;     
-  *splitParameterMax     = 0;
-  *splitValueMaxFactSize = 0;
-  *splitValueMaxFactPtr  = NULL;
-  *splitValueMaxCont     = NA_REAL;
-  deltaMax               = NA_REAL;
-  preliminaryResult = getPreSplitResult(treeID,
-                                        parent,
-                                        repMembrSize,
-                                        repMembrIndx,
-                                        & nonMissMembrSizeStatic,
-                                        & nonMissMembrIndxStatic,
-                                        & splitVector,
-                                        & parent -> mean,
-                                        multImpFlag,
-                                        FALSE);
-  if (preliminaryResult) {
-    stackSplitIndicator(repMembrSize, & localSplitIndicator);
-    stackRandomCovariates(treeID,
-                          parent,
+  double sumLeft, sumRght, sumLeftSqr, sumRghtSqr;
+  double delta;
+  uint j, k, p;
+  uint responseClassCount = RF_classLevelSize[1];
+  delta = 0;  
+  for (j = 1; j <= repMembrSize; j++) {
+    localSplitIndicator[j] = NEITHER;
+  }
+  for (p=1; p <= responseClassCount; p++) {
+    parentClassProp[p] = 0;
+  }
+  for (j = 1; j <= nonMissMembrSize; j++) {
+    parentClassProp[RF_classLevelIndex[1][ (uint) RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[j]]] ]]] ++;
+  }
+  leftSize = 0;
+  priorMembrIter = 0;
+  if (factorFlag == FALSE) {
+    for (j = 1; j <= nonMissMembrSize; j++) {
+      localSplitIndicator[ nonMissMembrIndx[indxx[j]] ] = RIGHT;
+    }
+    for (p = 1; p <= responseClassCount; p++) {
+      rghtClassProp[p] = parentClassProp[p];
+      leftClassProp[p] = 0;
+    }
+  }
+  for (j = 1; j < splitLength; j++) {
+    if (factorFlag == TRUE) {
+      priorMembrIter = 0;
+      leftSize = 0;
+    }
+    virtuallySplitNode(treeID,
+                          factorFlag,
+                          mwcpSizeAbsolute,
+                          covariate,
+                          repMembrIndx,
                           repMembrSize,
-                          multImpFlag,
-                          & randomCovariateIndex,
-                          & uniformCovariateSize,
-                          & cdf,
-                          & cdfSize,
-                          & cdfSort,
-                          & density,
-                          & densitySize,
-                          & densitySwap);
-    double sumLeft, sumRght, sumRghtSave, sumLeftSqr, sumRghtSqr, sumRghtSqrSave;
-    double leftTemp, rghtTemp, leftTempSqr, rghtTempSqr;
-    sumLeft = sumRght = sumLeftSqr = sumRghtSqr = 0;  
-    leftTempSqr = rghtTempSqr = 0;  
-    delta = 0;  
-    uint actualCovariateCount = 0;
-    uint candidateCovariateCount = 0;
-    while (selectRandomCovariates(treeID,
-                                  parent,
-                                  repMembrIndx,
-                                  repMembrSize,
-                                  randomCovariateIndex,
-                                  & uniformCovariateSize,
-                                  & uniformCovariateIndex,
-                                  cdf,
-                                  & cdfSize,
-                                  cdfSort,
-                                  density,
-                                  & densitySize,
-                                  densitySwap,
-                                  & covariate,
-                                  & actualCovariateCount,
-                                  & candidateCovariateCount,
-                                  splitVector,
-                                  & splitVectorSize,
-                                  & indxx,
-                                  nonMissMembrSizeStatic,
-                                  nonMissMembrIndxStatic,
-                                  & nonMissMembrSize,
-                                  & nonMissMembrIndx,
-                                  multImpFlag)) {
-      for (j = 1; j <= repMembrSize; j++) {
-        localSplitIndicator[j] = NEITHER;
+                          nonMissMembrIndx,
+                          nonMissMembrSize,
+                          indxx,
+                          splitVectorPtr,
+                          j,
+                          localSplitIndicator,
+                          & leftSize,
+                          priorMembrIter,
+                          & currentMembrIter);
+    rghtSize = nonMissMembrSize - leftSize;
+    if (factorFlag == TRUE) {
+      for (p=1; p <= responseClassCount; p++) {
+        leftClassProp[p] = 0;
       }
-      sumRghtSave = sumRghtSqrSave = 0.0;
-      switch(RF_splitRule) {
-      case REGR_WT_NRM:
-        sumRghtSave = 0.0;
-        for (j = 1; j <= nonMissMembrSize; j++) {
-          sumRghtSave += RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[j]]] ];
-        }
-        break;
-      default:
-        sumRghtSave = sumRghtSqrSave = 0.0;
-        for (j = 1; j <= nonMissMembrSize; j++) {
-          sumRghtSave += RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[j]]] ];
-          sumRghtSqrSave += pow(RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[j]]] ], 2.0);
+      for (k = 1; k <= nonMissMembrSize; k++) {
+        if (localSplitIndicator[ nonMissMembrIndx[indxx[k]] ] == LEFT)  {
+          leftClassProp[RF_classLevelIndex[1][ (uint) RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]]] ++;
         }
-        break;
       }
-      leftSize = 0;
-      priorMembrIter = 0;
-      splitLength = stackAndConstructSplitVector(treeID,
-                                                 repMembrSize,
-                                                 covariate,
-                                                 splitVector,
-                                                 splitVectorSize,
-                                                 & factorFlag,
-                                                 & deterministicSplitFlag,
-                                                 & mwcpSizeAbsolute,
-                                                 & splitVectorPtr);
-      if (factorFlag == FALSE) {
-        for (j = 1; j <= nonMissMembrSize; j++) {
-          localSplitIndicator[ nonMissMembrIndx[indxx[j]] ] = RIGHT;
-        }
-        sumRght      = sumRghtSave;
-        sumRghtSqr   = sumRghtSqrSave;
-        sumLeft      = 0.0;
-        sumLeftSqr   = 0.0;
+      for (p=1; p <= responseClassCount; p++) {
+        rghtClassProp[p] = parentClassProp[p] - leftClassProp[p];
       }
-      for (j = 1; j < splitLength; j++) {
-        if (factorFlag == TRUE) {
-          priorMembrIter = 0;
-          leftSize = 0;
-        }
-        virtuallySplitNode(treeID,
-                              factorFlag,
-                              mwcpSizeAbsolute,
-                              covariate,
-                              repMembrIndx,
-                              repMembrSize,
-                              nonMissMembrIndx,
-                              nonMissMembrSize,
-                              indxx,
-                              splitVectorPtr,
-                              j,
-                              localSplitIndicator,
-                              & leftSize,
-                              priorMembrIter,
-                              & currentMembrIter);
-        rghtSize = nonMissMembrSize - leftSize;
-          if (factorFlag == TRUE) {
-            switch(RF_splitRule) {
-            case REGR_WT_NRM:
-              sumLeft = sumRght = 0.0;
-              for (k = 1; k <= nonMissMembrSize; k++) {
-                if (localSplitIndicator[ nonMissMembrIndx[indxx[k]] ] == LEFT) {
-                  sumLeft += RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ];
-                }
-                else {
-                  sumRght += RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ];
-                }
-              } 
-              break;
-            default:
-              sumLeft = sumRght = 0.0;
-              sumLeftSqr = sumRghtSqr = 0.0;
-              for (k = 1; k <= nonMissMembrSize; k++) {
-                if (localSplitIndicator[ nonMissMembrIndx[indxx[k]] ] == LEFT) {
-                  sumLeft    += RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ];
-                  sumLeftSqr += pow(RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ], 2.0);
-                }
-                else {
-                  sumRght    += RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ];
-                  sumRghtSqr += pow(RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ], 2.0);
-                }
-              } 
-              break;
-            }
-          }
-          else {
-            switch(RF_splitRule) {
-            case REGR_WT_NRM:
-              for (k = priorMembrIter + 1; k < currentMembrIter; k++) {
-                sumLeft += RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ];
-                sumRght -= RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ];
-              }
-              break;
-            default:
-              for (k = priorMembrIter + 1; k < currentMembrIter; k++) {
-                sumLeft    += RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ];
-                sumLeftSqr += pow(RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ], 2.0);
-                sumRght    -= RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ];
-                sumRghtSqr -= pow(RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ], 2.0);
-              }
-              break;
-            }
-          }
-          switch(RF_splitRule) {
-          case REGR_WT_NRM:
-            sumLeftSqr = pow(sumLeft, 2.0) / leftSize;
-            sumRghtSqr = pow(sumRght, 2.0) / rghtSize;
-            delta = sumLeftSqr + sumRghtSqr;
-            break;
-          case REGR_WT_OFF:
-            leftTemp = pow(sumLeft, 2.0) / pow(leftSize, 2.0);
-            rghtTemp = pow(sumRght, 2.0) / pow(rghtSize, 2.0);
-            leftTempSqr = sumLeftSqr / leftSize;
-            rghtTempSqr = sumRghtSqr / rghtSize;
-            delta = leftTemp + rghtTemp - leftTempSqr - rghtTempSqr;
-            break;
-          case REGR_WT_HVY:
-            leftTemp = pow(sumLeft, 2.0) / pow (nonMissMembrSize, 2.0);
-            rghtTemp = pow(sumRght, 2.0) / pow (nonMissMembrSize, 2.0);
-            leftTempSqr = sumLeftSqr * leftSize / pow (nonMissMembrSize, 2.0);
-            rghtTempSqr = sumRghtSqr * rghtSize / pow (nonMissMembrSize, 2.0);
-            delta = leftTemp + rghtTemp - leftTempSqr - rghtTempSqr;
-            break;
-          default:
-            break;
-          }
-          updateMaximumSplit(treeID,
-                             parent,
-                             delta,
-                             candidateCovariateCount,
-                             covariate,
-                             j,
-                             factorFlag,
-                             mwcpSizeAbsolute,
-                             repMembrSize,
-                             localSplitIndicator,
-                             & deltaMax,
-                             splitParameterMax,
-                             splitValueMaxCont,
-                             splitValueMaxFactSize,
-                             splitValueMaxFactPtr,
-                             splitVectorPtr,
-                             splitIndicator);
-        if (factorFlag == FALSE) {
-          priorMembrIter = currentMembrIter - 1;
-        }
-      }  
-      unstackSplitVector(treeID,
-                         splitVectorSize,
-                         splitLength,
-                         factorFlag,
-                         deterministicSplitFlag,
-                         mwcpSizeAbsolute,
-                         splitVectorPtr);
-      unselectRandomCovariates(treeID,
-                               parent,
-                               repMembrSize,
-                               indxx,
-                               nonMissMembrSizeStatic,
-                               nonMissMembrIndx,
-                               multImpFlag);
-    }  
-    unstackRandomCovariates(treeID,
-                            parent, 
-                            randomCovariateIndex,
-                            uniformCovariateSize,
-                            cdf,
-                            cdfSize,
-                            cdfSort,
-                            density,
-                            densitySize,
-                            densitySwap,
-                            repMembrSize);
-    unstackSplitIndicator(repMembrSize, localSplitIndicator);
-  }  
-  unstackPreSplit(preliminaryResult,
-                  multImpFlag,
-                  FALSE,  
-                  repMembrSize,
-                  splitVector,
-                  nonMissMembrIndxStatic);
-  result = summarizeSplitResult(*splitParameterMax,
-                                *splitValueMaxCont,
-                                *splitValueMaxFactSize,
-                                *splitValueMaxFactPtr,
-                                 splitStatistic,
-                                 deltaMax);
-  return result;
-}
-char logRankNCR (uint    treeID,
-                 Node   *parent,
-                 uint   *repMembrIndx,
-                 uint    repMembrSize,
-                 uint   *allMembrIndx,
-                 uint    allMembrSize,
-                 uint   *splitParameterMax,
-                 double *splitValueMaxCont,
-                 uint   *splitValueMaxFactSize,
-                 uint  **splitValueMaxFactPtr,
-                 double *splitStatistic,
-                 char  **splitIndicator,
-                 char    multImpFlag) {
-  uint   *randomCovariateIndex;
-  uint    uniformCovariateIndex;
-  uint    uniformCovariateSize;
-  double *cdf;
-  uint    cdfSize;
-  uint   *cdfSort;
-  uint   *density;
-  uint    densitySize;
-  uint  **densitySwap;
-  uint     covariate;
-  double  *splitVector;
-  uint     splitVectorSize;
-  uint nonMissMembrSize, nonMissMembrSizeStatic;
-  uint *nonMissMembrIndx, *nonMissMembrIndxStatic;
-  uint   *indxx;
-  uint priorMembrIter, currentMembrIter;
-  uint leftSize;
-  char *localSplitIndicator;
-  uint splitLength;
-  void *splitVectorPtr;
-  char factorFlag;
-  uint mwcpSizeAbsolute;
-  char deterministicSplitFlag;
-  char preliminaryResult, result;
-  double delta, deltaMax;
-  uint j, k, m;
-  localSplitIndicator    = NULL;  
-  mwcpSizeAbsolute       = 0;     
-  *splitParameterMax     = 0;
-  *splitValueMaxFactSize = 0;
-  *splitValueMaxFactPtr  = NULL;
-  *splitValueMaxCont     = NA_REAL;
-  deltaMax               = NA_REAL;
-  preliminaryResult = getPreSplitResult(treeID,
-                                        parent,
-                                        repMembrSize,
-                                        repMembrIndx,
-                                        & nonMissMembrSizeStatic,
-                                        & nonMissMembrIndxStatic,
-                                        & splitVector,
-                                        & parent -> mean,
-                                        multImpFlag,
-                                        FALSE);
-  if (preliminaryResult) {
-    stackSplitIndicator(repMembrSize, & localSplitIndicator);
-    stackRandomCovariates(treeID,
-                          parent,
-                          repMembrSize,
-                          multImpFlag,
-                          & randomCovariateIndex,
-                          & uniformCovariateSize,
-                          & cdf,
-                          & cdfSize,
-                          & cdfSort,
-                          & density,
-                          & densitySize,
-                          & densitySwap);
-    uint *localEventTimeCount, *localEventTimeIndex;
-    uint  localEventTimeSize;
-    uint *nodeParentEvent,  *nodeLeftEvent,  *nodeRightEvent;
-    uint *nodeParentAtRisk, *nodeLeftAtRisk, *nodeRightAtRisk;
-    uint   *survivalTimeIndexRank;
-    double *survivalRank;
-    double  meanSurvRank, varSurvRank;
-    double deltaNum, deltaNumAdj, deltaDen;
-    uint   tIndx;
-    meanSurvRank = varSurvRank = 0;  
-    survivalTimeIndexRank = NULL;  
-    survivalRank = NULL;  
-    localEventTimeSize = 0;  
-    delta = deltaNum = 0;  
+    }
+    else {
+      for (k = priorMembrIter + 1; k < currentMembrIter; k++) {
+        leftClassProp[RF_classLevelIndex[1][(uint) RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]]] ++;
+        rghtClassProp[RF_classLevelIndex[1][(uint) RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]]] --;
+      }
+    }
+    sumLeft = sumRght = 0.0;
     switch(RF_splitRule) {
-    case SURV_LGRNK:
-      if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
-        stackAndGetSplitSurv(treeID,
-                             repMembrIndx,
-                             repMembrSize,
-                             nonMissMembrIndxStatic,
-                             nonMissMembrSizeStatic,
-                             & localEventTimeCount,
-                             & localEventTimeIndex,
-                             & localEventTimeSize,
-                             & nodeParentEvent,
-                             & nodeParentAtRisk,
-                             & nodeLeftEvent,
-                             & nodeLeftAtRisk,
-                             & nodeRightEvent,
-                             & nodeRightAtRisk);
+    case CLAS_WT_NRM:
+      for (p=1; p <= responseClassCount; p++) {
+        sumLeft += (double) upower(leftClassProp[p], 2);
+        sumRght += (double) upower(rghtClassProp[p], 2);
       }
+      sumLeftSqr = sumLeft / leftSize;
+      sumRghtSqr  = sumRght / rghtSize;
+      delta = (sumLeftSqr + sumRghtSqr) / nonMissMembrSize;
       break;
-    case SURV_LRSCR:
-      survivalTimeIndexRank = uivector(1, repMembrSize);
-      survivalRank = dvector(1, repMembrSize);
-      localEventTimeSize = 1;
+    case CLAS_WT_OFF:
+      for (p=1; p <= responseClassCount; p++) {
+        sumLeft += pow((double) leftClassProp[p] / (double) leftSize, 2.0);
+        sumRght += pow((double) (rghtClassProp[p]) / (double) rghtSize, 2.0);
+      }
+      delta = sumLeft + sumRght;
+      break;
+    case CLAS_WT_HVY:
+      for (p=1; p <= responseClassCount; p++) {
+        sumLeft += (double) upower(leftClassProp[p], 2);
+        sumRght += (double) upower(rghtClassProp[p], 2);
+      }
+      delta =
+        (sumLeft / (double) (upower(nonMissMembrSize, 2))) +
+        (sumRght / (double) (upower(nonMissMembrSize, 2))) -
+        pow((double) leftSize / nonMissMembrSize, 2.0) -
+        pow((double) rghtSize / nonMissMembrSize, 2.0) + 2.0;
       break;
     default:
       break;
     }
-    uint actualCovariateCount = 0;
-    uint candidateCovariateCount = 0;
-    while (selectRandomCovariates(treeID,
-                                  parent,
-                                  repMembrIndx,
-                                  repMembrSize,
-                                  randomCovariateIndex,
-                                  & uniformCovariateSize,
-                                  & uniformCovariateIndex,
-                                  cdf,
-                                  & cdfSize,
-                                  cdfSort,
-                                  density,
-                                  & densitySize,
-                                  densitySwap,
-                                  & covariate,
-                                  & actualCovariateCount,
-                                  & candidateCovariateCount,
-                                  splitVector,
-                                  & splitVectorSize,
-                                  & indxx,
-                                  nonMissMembrSizeStatic,
-                                  nonMissMembrIndxStatic,
-                                  & nonMissMembrSize,
-                                  & nonMissMembrIndx,
-                                  multImpFlag)) {
-      splitLength = stackAndConstructSplitVector(treeID,
-                                                 repMembrSize,
-                                                 covariate,
-                                                 splitVector,
-                                                 splitVectorSize,
-                                                 & factorFlag,
-                                                 & deterministicSplitFlag,
-                                                 & mwcpSizeAbsolute,
-                                                 & splitVectorPtr);
-      switch(RF_splitRule) {
-      case SURV_LGRNK:
-        if (!((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP)))) {
-          stackAndGetSplitSurv(treeID,
-                               repMembrIndx,
-                               repMembrSize,
-                               nonMissMembrIndx,
-                               nonMissMembrSize,
-                               & localEventTimeCount,
-                               & localEventTimeIndex,
-                               & localEventTimeSize,
-                               & nodeParentEvent,
-                               & nodeParentAtRisk,
-                               & nodeLeftEvent,
-                               & nodeLeftAtRisk,
-                               & nodeRightEvent,
-                               & nodeRightAtRisk);
-        }
-        break;
-      case SURV_LRSCR:
-        localEventTimeSize = 1;
-        break;
-      default:
-        break;
-      }
-      if (localEventTimeSize > 0) {
-        for (j = 1; j <= repMembrSize; j++) {
-          localSplitIndicator[j] = NEITHER;
+    updateMaximumSplit(treeID,
+                       parent,
+                       delta,
+                       candidateCovariateCount,
+                       covariate,
+                       j,
+                       factorFlag,
+                       mwcpSizeAbsolute,
+                       repMembrSize,
+                       localSplitIndicator,
+                       deltaMax,
+                       splitParameterMax,
+                       splitValueMaxCont,
+                       splitValueMaxFactSize,
+                       splitValueMaxFactPtr,
+                       splitVectorPtr,
+                       splitIndicator);
+    if (factorFlag == FALSE) {
+      priorMembrIter = currentMembrIter - 1;
+    }
+  }  
+}
+void regressionHistogramSplit(uint    treeID,
+                              Node   *parent,
+                              uint   *repMembrIndx,
+                              uint    repMembrSize,
+                              uint   *nonMissMembrIndx,
+                              uint    nonMissMembrSize,
+                              uint    covariate,
+                              uint    candidateCovariateCount,
+                              uint   *histCount,
+                              double *histSum,
+                              double *histSumSqr,
+                              char   *localSplitIndicator,
+                              double *deltaMax,
+                              uint   *splitParameterMax,
+                              double *splitValueMaxCont,
+                              uint   *splitValueMaxFactSize,
+                              uint  **splitValueMaxFactPtr,
+                              char  **splitIndicator) {
+  uint binSize, binBest;
+  uint leftSize, rghtSize;
+  double sumLeft, sumRght, sumLeftSqr, sumRghtSqr;
+  double response;
+  double delta, deltaBest;
+  uint b, j;
+  binSize = RF_histBinSize[covariate];
+  for (b = 1; b <= binSize; b++) {
+    histCount[b] = 0;
+    histSum[b] = histSumSqr[b] = 0.0;
+  }
+  sumRght = sumRghtSqr = 0.0;
+  for (j = 1; j <= nonMissMembrSize; j++) {
+    b = RF_histBinCode[covariate][repMembrIndx[nonMissMembrIndx[j]]];
+    response = RF_response[treeID][1][repMembrIndx[nonMissMembrIndx[j]]];
+    histCount[b] ++;
+    histSum[b] += response;
+    histSumSqr[b] += pow(response, 2.0);
+    sumRght += response;
+    sumRghtSqr += pow(response, 2.0);
+  }
+  sumLeft = sumLeftSqr = 0.0;
+  leftSize = 0;
+  binBest = 0;
+  deltaBest = NA_REAL;
+  delta = 0.0;
+  for (b = 1; b < binSize; b++) {
+    if (histCount[b] > 0) {
+      leftSize += histCount[b];
+      sumLeft += histSum[b];
+      sumRght -= histSum[b];
+      sumLeftSqr += histSumSqr[b];
+      sumRghtSqr -= histSumSqr[b];
+      rghtSize = nonMissMembrSize - leftSize;
+      if (rghtSize > 0) {
+        switch(RF_splitRule) {
+        case REGR_WT_NRM:
+          delta = (pow(sumLeft, 2.0) / leftSize) + (pow(sumRght, 2.0) / rghtSize);
+          break;
+        case REGR_WT_OFF:
+          delta =
+            (pow(sumLeft, 2.0) / pow(leftSize, 2.0)) +
+            (pow(sumRght, 2.0) / pow(rghtSize, 2.0)) -
+            (sumLeftSqr / leftSize) -
+            (sumRghtSqr / rghtSize);
+          break;
+        case REGR_WT_HVY:
+          delta =
+            (pow(sumLeft, 2.0) / pow (nonMissMembrSize, 2.0)) +
+            (pow(sumRght, 2.0) / pow (nonMissMembrSize, 2.0)) -
+            (sumLeftSqr * leftSize / pow (nonMissMembrSize, 2.0)) -
+            (sumRghtSqr * rghtSize / pow (nonMissMembrSize, 2.0));
+          break;
+        default:
+          break;
         }
-        leftSize = 0;
-        priorMembrIter = 0;
-        if (factorFlag == FALSE) {
-          for (j = 1; j <= nonMissMembrSize; j++) {
-            localSplitIndicator[ nonMissMembrIndx[indxx[j]] ] = RIGHT;
-          }
-          switch(RF_splitRule) {
-          case SURV_LGRNK:
-            for (m = 1; m <= localEventTimeSize; m++) {
-              nodeLeftEvent[m] = nodeLeftAtRisk[m] = 0;
-            }
-            break;
-          case SURV_LRSCR:
-            deltaNum =  0.0;
-            break;
-          default:
-            break;
-          }
+        if (ISNA(deltaBest) || ((delta - deltaBest) > EPSILON)) {
+          deltaBest = delta;
+          binBest = b;
         }
+      }
+    }
+  }
+  if (binBest > 0) {
+    for (j = 1; j <= repMembrSize; j++) {
+      localSplitIndicator[j] = NEITHER;
+    }
+    for (j = 1; j <= nonMissMembrSize; j++) {
+      if (RF_histBinCode[covariate][repMembrIndx[nonMissMembrIndx[j]]] <= binBest) {
+        localSplitIndicator[nonMissMembrIndx[j]] = LEFT;
+      }
+      else {
+        localSplitIndicator[nonMissMembrIndx[j]] = RIGHT;
+      }
+    }
+    updateMaximumSplit(treeID,
+                       parent,
+                       deltaBest,
+                       candidateCovariateCount,
+                       covariate,
+                       binBest,
+                       FALSE,
+                       0,
+                       repMembrSize,
+                       localSplitIndicator,
+                       deltaMax,
+                       splitParameterMax,
+                       splitValueMaxCont,
+                       splitValueMaxFactSize,
+                       splitValueMaxFactPtr,
+                       RF_histBinUpper[covariate],
+                       splitIndicator);
+  }
+}
+void classificationHistogramSplit(uint    treeID,
+                                  Node   *parent,
+                                  uint   *repMembrIndx,
+                                  uint    repMembrSize,
+                                  uint   *nonMissMembrIndx,
+                                  uint    nonMissMembrSize,
+                                  uint    covariate,
+                                  uint    candidateCovariateCount,
+                                  uint   *histCount,
+                                  uint  **histClass,
+                                  uint   *parentClassProp,
+                                  uint   *leftClassProp,
+                                  uint   *rghtClassProp,
+                                  char   *localSplitIndicator,
+                                  double *deltaMax,
+                                  uint   *splitParameterMax,
+                                  double *splitValueMaxCont,
+                                  uint   *splitValueMaxFactSize,
+                                  uint  **splitValueMaxFactPtr,
+                                  char  **splitIndicator) {
+  uint responseClassCount;
+  uint binSize, binBest;
+  uint leftSize, rghtSize;
+  uint classIndex;
+  double sumLeft, sumRght;
+  double delta, deltaBest;
+  uint b, j, p;
+  responseClassCount = RF_classLevelSize[1];
+  binSize = RF_histBinSize[covariate];
+  for (b = 1; b <= binSize; b++) {
+    histCount[b] = 0;
+    for (p = 1; p <= responseClassCount; p++) {
+      histClass[b][p] = 0;
+    }
+  }
+  for (p = 1; p <= responseClassCount; p++) {
+    parentClassProp[p] = 0;
+  }
+  for (j = 1; j <= nonMissMembrSize; j++) {
+    b = RF_histBinCode[covariate][repMembrIndx[nonMissMembrIndx[j]]];
+    classIndex = RF_classLevelIndex[1][(uint) RF_response[treeID][1][repMembrIndx[nonMissMembrIndx[j]]]];
+    histCount[b] ++;
+    histClass[b][classIndex] ++;
+    parentClassProp[classIndex] ++;
+  }
+  for (p = 1; p <= responseClassCount; p++) {
+    leftClassProp[p] = 0;
+    rghtClassProp[p] = parentClassProp[p];
+  }
+  leftSize = 0;
+  binBest = 0;
+  deltaBest = NA_REAL;
+  delta = 0.0;
+  for (b = 1; b < binSize; b++) {
+    if (histCount[b] > 0) {
+      leftSize += histCount[b];
+      for (p = 1; p <= responseClassCount; p++) {
+        leftClassProp[p] += histClass[b][p];
+        rghtClassProp[p] -= histClass[b][p];
+      }
+      rghtSize = nonMissMembrSize - leftSize;
+      if (rghtSize > 0) {
+        sumLeft = sumRght = 0.0;
         switch(RF_splitRule) {
-        case SURV_LGRNK:
+        case CLAS_WT_NRM:
+          for (p = 1; p <= responseClassCount; p++) {
+            sumLeft += (double) upower(leftClassProp[p], 2);
+            sumRght += (double) upower(rghtClassProp[p], 2);
+          }
+          delta = ((sumLeft / leftSize) + (sumRght / rghtSize)) / nonMissMembrSize;
           break;
-        case SURV_LRSCR:
-          for (k = 1; k <= nonMissMembrSize; k++) {
-            survivalTimeIndexRank[k] = 0;
-            for (j = 1; j <= nonMissMembrSize; j++) {
-              if ( RF_masterTimeIndex[treeID][ repMembrIndx[nonMissMembrIndx[j]] ]  <= RF_masterTimeIndex[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] ) {
-                survivalTimeIndexRank[k] ++;
-              }
-            }
+        case CLAS_WT_OFF:
+          for (p = 1; p <= responseClassCount; p++) {
+            sumLeft += pow((double) leftClassProp[p] / (double) leftSize, 2.0);
+            sumRght += pow((double) rghtClassProp[p] / (double) rghtSize, 2.0);
           }
-          meanSurvRank = varSurvRank = 0;
-          for (k = 1; k <= nonMissMembrSize; k++) {
-            survivalRank[k] = 0;
-            for (j = 1; j <= survivalTimeIndexRank[k]; j++) {
-              survivalRank[k] = survivalRank[k] + (RF_status[treeID][ repMembrIndx[nonMissMembrIndx[indxx[j]]] ] / (nonMissMembrSize - survivalTimeIndexRank[j] + 1) );
-            }
-            survivalRank[k] = RF_status[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] - survivalRank[k];
-            meanSurvRank = meanSurvRank + survivalRank[k];
-            varSurvRank = varSurvRank +  pow(survivalRank[k], 2.0);
+          delta = sumLeft + sumRght;
+          break;
+        case CLAS_WT_HVY:
+          for (p = 1; p <= responseClassCount; p++) {
+            sumLeft += (double) upower(leftClassProp[p], 2);
+            sumRght += (double) upower(rghtClassProp[p], 2);
           }
-          varSurvRank = ( varSurvRank - (pow(meanSurvRank, 2.0) / nonMissMembrSize) ) / (nonMissMembrSize - 1);
-          meanSurvRank = meanSurvRank / nonMissMembrSize;
+          delta =
+            (sumLeft / (double) (upower(nonMissMembrSize, 2))) +
+            (sumRght / (double) (upower(nonMissMembrSize, 2))) -
+            pow((double) leftSize / nonMissMembrSize, 2.0) -
+            pow((double) rghtSize / nonMissMembrSize, 2.0) + 2.0;
           break;
         default:
           break;
         }
-        for (j = 1; j < splitLength; j++) {
-          if (factorFlag == TRUE) {
-            priorMembrIter = 0;
-            leftSize = 0;
-          }
-          virtuallySplitNode(treeID,
-                             factorFlag,
-                             mwcpSizeAbsolute,
-                             covariate,
-                             repMembrIndx,
-                             repMembrSize,
-                             nonMissMembrIndx,
-                             nonMissMembrSize,
-                             indxx,
-                             splitVectorPtr,
-                             j,
-                             localSplitIndicator,
-                             & leftSize,
-                             priorMembrIter,
-                             & currentMembrIter);
-          if (factorFlag == TRUE) {
-            switch(RF_splitRule) {
-            case SURV_LGRNK:
-              for (m = 1; m <= localEventTimeSize; m++) {
-                nodeLeftEvent[m] = nodeLeftAtRisk[m] = 0;
-              }
-              for (k = 1; k <= nonMissMembrSize; k++) {
-                if (localSplitIndicator[  nonMissMembrIndx[indxx[k]]  ] == LEFT) {
-                  tIndx = 0;  
-                  for (m = 1; m <= localEventTimeSize; m++) {
-                    if (localEventTimeIndex[m] <= RF_masterTimeIndex[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]) {
-                      tIndx = m;
-                      nodeLeftAtRisk[tIndx] ++;
-                    }
-                    else {
-                      m = localEventTimeSize;
-                    }
-                  }
-                  if (RF_status[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] > 0) {
-                    nodeLeftEvent[tIndx] ++;
-                  }
-                }
-                else {
-                }
-              } 
-              break;
-            case SURV_LRSCR:
-              deltaNum = 0.0;
-              for (k = 1; k <= nonMissMembrSize; k++) {
-                if (localSplitIndicator[ nonMissMembrIndx[k] ] == LEFT) {
-                  deltaNum = deltaNum + survivalRank[k];
-                }
-              }
-              break;
-            default:
-              break;
-            }
-          }
-          else {
-            switch(RF_splitRule) {
-            case SURV_LGRNK:
-              for (k = priorMembrIter + 1; k < currentMembrIter; k++) {
-                tIndx = 0;  
-                for (m = 1; m <= localEventTimeSize; m++) {
-                  if (localEventTimeIndex[m] <= RF_masterTimeIndex[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]) {
-                    tIndx = m;
-                    nodeLeftAtRisk[tIndx] ++;
-                  }
-                  else {
-                    m = localEventTimeSize;
-                  }
-                }
-                if (RF_status[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] > 0) {
-                  nodeLeftEvent[tIndx] ++;
-                }
-              }
-              break;
-            case SURV_LRSCR:
-              for (k = priorMembrIter + 1; k < currentMembrIter; k++) {
-                deltaNum = deltaNum + survivalRank[ indxx[k] ];
-              }
-              break;
-            default:
-              break;
-            }
-          }
-          switch(RF_splitRule) {
-          case SURV_LGRNK:
-            delta = deltaNum = deltaDen =  0.0;
-            for (k=1; k <= localEventTimeSize; k++) {
-              deltaNum = deltaNum + ((double) nodeLeftEvent[k] - ((double) ( nodeLeftAtRisk[k] * nodeParentEvent[k]) / nodeParentAtRisk[k]));
-              if (nodeParentAtRisk[k] >= 2) {
-                deltaDen = deltaDen + (
-                                       ((double) nodeLeftAtRisk[k] / nodeParentAtRisk[k]) *
-                                       (1.0 - ((double) nodeLeftAtRisk[k] / nodeParentAtRisk[k])) *
-                                       ((double) (nodeParentAtRisk[k] - nodeParentEvent[k]) / (nodeParentAtRisk[k] - 1)) * nodeParentEvent[k]
-                                       );
-              }
-            }
-            deltaNum = fabs(deltaNum);
-            deltaDen = sqrt(deltaDen);
-            if (deltaDen <= EPSILON) {
-              if (deltaNum <= EPSILON) {
-                delta = 0.0;
-              }
-              else {
-                delta = deltaNum / deltaDen;
-              }
-            }
-            else {
-              delta = deltaNum / deltaDen;
-            }
-            break;
-          case SURV_LRSCR:
-            deltaNumAdj  = deltaNum - (leftSize * meanSurvRank);
-            deltaDen     = leftSize * (1.0 - (leftSize / nonMissMembrSize)) * varSurvRank;
-            deltaNumAdj = fabs(deltaNumAdj);
-            deltaDen = sqrt(deltaDen);
-            if (deltaDen <= EPSILON) {
-              if (deltaNumAdj <= EPSILON) {
-                delta = 0.0;
-              }
-              else {
-                delta = deltaNumAdj / deltaDen;
-              }
-            }
-            else {
-              delta = deltaNumAdj / deltaDen;
-            }
-            break;
-          default:
-            break;
-          }
-          updateMaximumSplit(treeID,
-                             parent,
-                             delta,
-                             candidateCovariateCount,
-                             covariate,
-                             j,
-                             factorFlag,
-                             mwcpSizeAbsolute,
-                             repMembrSize,
-                             localSplitIndicator,
-                             & deltaMax,
-                             splitParameterMax,
-                             splitValueMaxCont,
-                             splitValueMaxFactSize,
-                             splitValueMaxFactPtr,
-                             splitVectorPtr,
-                             splitIndicator);
-          if (factorFlag == FALSE) {
-            priorMembrIter = currentMembrIter - 1;
-          }
-        }  
-      }  
-      else {
-      }
-      unstackSplitVector(treeID,
-                         splitVectorSize,
-                         splitLength,
-                         factorFlag,
-                         deterministicSplitFlag,
-                         mwcpSizeAbsolute,
-                         splitVectorPtr);
-      unselectRandomCovariates(treeID,
-                               parent,
-                               repMembrSize,
-                               indxx,
-                               nonMissMembrSizeStatic,
-                               nonMissMembrIndx,
-                               multImpFlag);
-      switch(RF_splitRule) {
-      case SURV_LGRNK:
-        if (!((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP)))) {
-          unstackSplitSurv(localEventTimeCount,
-                           localEventTimeIndex,
-                           localEventTimeSize,
-                           nodeParentEvent,
-                           nodeParentAtRisk,
-                           nodeLeftEvent,
-                           nodeLeftAtRisk,
-                           nodeRightEvent,
-                           nodeRightAtRisk);
+        if (ISNA(deltaBest) || ((delta - deltaBest) > EPSILON)) {
+          deltaBest = delta;
+          binBest = b;
         }
-        break;
-      case SURV_LRSCR:
-        break;
-      default:
-        break;
       }
-    }  
-    switch(RF_splitRule) {
-    case SURV_LGRNK:
-      if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
-        unstackSplitSurv(localEventTimeCount,
-                         localEventTimeIndex,
-                         localEventTimeSize,
-                         nodeParentEvent,
-                         nodeParentAtRisk,
-                         nodeLeftEvent,
-                         nodeLeftAtRisk,
-                         nodeRightEvent,
-                         nodeRightAtRisk);
+    }
+  }
+  if (binBest > 0) {
+    for (j = 1; j <= repMembrSize; j++) {
+      localSplitIndicator[j] = NEITHER;
+    }
+    for (j = 1; j <= nonMissMembrSize; j++) {
+      if (RF_histBinCode[covariate][repMembrIndx[nonMissMembrIndx[j]]] <= binBest) {
+        localSplitIndicator[nonMissMembrIndx[j]] = LEFT;
+      }
+      else {
+        localSplitIndicator[nonMissMembrIndx[j]] = RIGHT;
       }
-    break;
-    case SURV_LRSCR:
-      free_uivector(survivalTimeIndexRank, 1, repMembrSize);
-      free_dvector(survivalRank, 1, repMembrSize);
-      break;
-    default:
-      break;
     }
-    unstackRandomCovariates(treeID,
-                            parent,
-                            randomCovariateIndex,
-                            uniformCovariateSize,
-                            cdf,
-                            cdfSize,
-                            cdfSort,
-                            density,
-                            densitySize,
-                            densitySwap,
-                            repMembrSize);
-    unstackSplitIndicator(repMembrSize, localSplitIndicator);
-  }  
-  unstackPreSplit(preliminaryResult,
-                  multImpFlag,
-                  FALSE, 
-                  repMembrSize,
-                  splitVector,
-                  nonMissMembrIndxStatic);
-  result = summarizeSplitResult(*splitParameterMax,
-                                *splitValueMaxCont,
-                                *splitValueMaxFactSize,
-                                *splitValueMaxFactPtr,
-                                 splitStatistic,
-                                 deltaMax);
-  return result;
+    updateMaximumSplit(treeID,
+                       parent,
+                       deltaBest,
+                       candidateCovariateCount,
+                       covariate,
+                       binBest,
+                       FALSE,
+                       0,
+                       repMembrSize,
+                       localSplitIndicator,
+                       deltaMax,
+                       splitParameterMax,
+                       splitValueMaxCont,
+                       splitValueMaxFactSize,
+                       splitValueMaxFactPtr,
+                       RF_histBinUpper[covariate],
+                       splitIndicator);
+  }
 }
-char logRankCR (uint    treeID,
-                Node   *parent,
-                uint   *repMembrIndx,
-                uint    repMembrSize,
-                uint   *allMembrIndx,
-                uint    allMembrSize,
-                uint   *splitParameterMax,
-                double *splitValueMaxCont,
-                uint   *splitValueMaxFactSize,
-                uint  **splitValueMaxFactPtr,
-                double *splitStatistic,
-                char  **splitIndicator,
-                char    multImpFlag) {
+char regressionXwghtSplit (uint    treeID,
+                           Node   *parent,
+                           uint   *repMembrIndx,
+                           uint    repMembrSize,
+                           uint   *allMembrIndx,
+                           uint    allMembrSize,
+                           uint   *splitParameterMax,
+                           double *splitValueMaxCont,
+                           uint   *splitValueMaxFactSize,
+                           uint  **splitValueMaxFactPtr,
+                           double *splitStatistic,
+                           char  **splitIndicator,
+                           char    multImpFlag) {
   uint   *randomCovariateIndex;
   uint    uniformCovariateIndex;
   uint    uniformCovariateSize;
@@ -8513,8 +9072,6 @@ char logRankCR (uint    treeID,
   uint nonMissMembrSize, nonMissMembrSizeStatic;
   uint *nonMissMembrIndx, *nonMissMembrIndxStatic;
   uint   *indxx;
-  uint priorMembrIter, currentMembrIter;
-  uint leftSize;
   char *localSplitIndicator;
   uint splitLength;
   void *splitVectorPtr;
@@ -8522,8 +9079,7 @@ char logRankCR (uint    treeID,
   uint mwcpSizeAbsolute;
   char deterministicSplitFlag;
   char preliminaryResult, result;
-  double delta, deltaMax;
-  uint j, k, m;
+  double deltaMax;
   localSplitIndicator    = NULL;  
   mwcpSizeAbsolute       = 0;     
   *splitParameterMax     = 0;
@@ -8555,217 +9111,978 @@ char logRankCR (uint    treeID,
                           & density,
                           & densitySize,
                           & densitySwap);
-    uint *localEventTimeCount, *localEventTimeIndex;
-    uint  localEventTimeSize;
-    uint *nodeParentEvent,  *nodeLeftEvent,  *nodeRightEvent;
-    uint *nodeParentAtRisk, *nodeLeftAtRisk, *nodeRightAtRisk;
-    uint **nodeParentEventCR, **nodeLeftEventCR;
-    uint **nodeParentInclusiveAtRisk, **nodeLeftInclusiveAtRisk;
-    nodeParentInclusiveAtRisk = nodeLeftInclusiveAtRisk = NULL;  
-    nodeParentEventCR = nodeLeftEventCR = NULL;  
-    double deltaNum, deltaSubNum, deltaDen, deltaSubDen;
-    uint   tIndx;
-    uint   q, s, r;
-    if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
-      stackAndGetSplitSurv(treeID,
-                           repMembrIndx,
-                           repMembrSize,
-                           nonMissMembrIndxStatic,
-                           nonMissMembrSizeStatic,
-                           & localEventTimeCount,
-                           & localEventTimeIndex,
-                           & localEventTimeSize,
-                           & nodeParentEvent,
-                           & nodeParentAtRisk,
-                           & nodeLeftEvent,
-                           & nodeLeftAtRisk,
-                           & nodeRightEvent,
-                           & nodeRightAtRisk);
-      nodeParentEventCR = uimatrix(1, RF_eventTypeSize, 1, localEventTimeSize);
-      nodeLeftEventCR = uimatrix(1, RF_eventTypeSize, 1, localEventTimeSize);
-      switch(RF_splitRule) {
-      case SURV_CR_LAU:
-        nodeParentInclusiveAtRisk = uimatrix(1, RF_eventTypeSize, 1, localEventTimeSize);
-        nodeLeftInclusiveAtRisk = uimatrix(1, RF_eventTypeSize, 1, localEventTimeSize);
-        break;
-      case SURV_CR_LOG:
-        break;
-      default:
-        break;
-      }
-    }
+    uint   *histCount  = NULL;
+    double *histSum    = NULL;
+    double *histSumSqr = NULL;
+    if ((RF_optHigh & OPT_SPLT_HIST) && (RF_histBinMax > 0)) {
+      histCount  = uivector(1, RF_histBinMax);
+      histSum    = dvector(1, RF_histBinMax);
+      histSumSqr = dvector(1, RF_histBinMax);
+    }
+    uint candidateSize = getSplitCandidateSize();
     uint actualCovariateCount = 0;
     uint candidateCovariateCount = 0;
-    while (selectRandomCovariates(treeID,
-                                  parent,
-                                  repMembrIndx,
-                                  repMembrSize,
-                                  randomCovariateIndex,
-                                  & uniformCovariateSize,
-                                  & uniformCovariateIndex,
-                                  cdf,
-                                  & cdfSize,
-                                  cdfSort,
-                                  density,
-                                  & densitySize,
-                                  densitySwap,
-                                  & covariate,
-                                  & actualCovariateCount,
-                                  & candidateCovariateCount,
-                                  splitVector,
-                                  & splitVectorSize,
-                                  & indxx,
-                                  nonMissMembrSizeStatic,
-                                  nonMissMembrIndxStatic,
-                                  & nonMissMembrSize,
-                                  & nonMissMembrIndx,
-                                  multImpFlag)) {
-      splitLength = stackAndConstructSplitVector(treeID,
-                                                 repMembrSize,
-                                                 covariate,
-                                                 splitVector,
-                                                 splitVectorSize,
-                                                 & factorFlag,
-                                                 & deterministicSplitFlag,
-                                                 & mwcpSizeAbsolute,
-                                                 & splitVectorPtr);
-      if (!((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP)))) {
-        stackAndGetSplitSurv(treeID,
-                             repMembrIndx,
-                             repMembrSize,
-                             nonMissMembrIndx,
-                             nonMissMembrSize,
-                             & localEventTimeCount,
-                             & localEventTimeIndex,
-                             & localEventTimeSize,
-                             & nodeParentEvent,
-                             & nodeParentAtRisk,
-                             & nodeLeftEvent,
-                             & nodeLeftAtRisk,
-                             & nodeRightEvent,
-                             & nodeRightAtRisk);
-        if (localEventTimeSize > 0) {
-          nodeParentEventCR = uimatrix(1, RF_eventTypeSize, 1, localEventTimeSize);
-          nodeLeftEventCR = uimatrix(1, RF_eventTypeSize, 1, localEventTimeSize);
+    if (candidateSize > 0) {
+      SplitCandidate **candidate = stackSplitCandidates(candidateSize, repMembrSize, 0);
+      uint candidateCount, c;
+      do {
+        candidateCount = selectSplitCandidates(treeID,
+                                               parent,
+                                               repMembrIndx,
+                                               repMembrSize,
+                                               randomCovariateIndex,
+                                               & uniformCovariateSize,
+                                               & uniformCovariateIndex,
+                                               cdf,
+                                               & cdfSize,
+                                               cdfSort,
+                                               density,
+                                               & densitySize,
+                                               densitySwap,
+                                               & actualCovariateCount,
+                                               & candidateCovariateCount,
+                                               nonMissMembrSizeStatic,
+                                               nonMissMembrIndxStatic,
+                                               multImpFlag,
+                                               candidate,
+                                               candidateSize);
+        for (c = 1; c <= candidateCount; c++) {
+#ifdef _OPENMP
+#pragma omp task firstprivate(c) if (candidateCount > 1)
+#endif
+          regressionCandidateSplit(treeID,
+                                   parent,
+                                   repMembrIndx,
+                                   repMembrSize,
+                                   candidate[c] -> nonMissMembrIndx,
+                                   candidate[c] -> nonMissMembrSize,
+                                   candidate[c] -> indxx,
+                                   candidate[c] -> covariate,
+                                   candidate[c] -> candidateCovariateCount,
+                                   candidate[c] -> splitLength,
+                                   candidate[c] -> splitVectorPtr,
+                                   candidate[c] -> factorFlag,
+                                   candidate[c] -> mwcpSizeAbsolute,
+                                   candidate[c] -> localSplitIndicator,
+                                   & candidate[c] -> deltaMax,
+                                   & candidate[c] -> splitParameterMax,
+                                   & candidate[c] -> splitValueMaxCont,
+                                   & candidate[c] -> splitValueMaxFactSize,
+                                   & candidate[c] -> splitValueMaxFactPtr,
+                                   NULL);
         }
-        switch(RF_splitRule) {
-        case SURV_CR_LAU:
-          if (localEventTimeSize > 0) {
-            nodeParentInclusiveAtRisk = uimatrix(1, RF_eventTypeSize, 1, localEventTimeSize);
-            nodeLeftInclusiveAtRisk = uimatrix(1, RF_eventTypeSize, 1, localEventTimeSize);
-          }
-          break;
-        case SURV_CR_LOG:
-          break;
-        default:
-          break;
+#ifdef _OPENMP
+#pragma omp taskwait
+#endif
+        unselectSplitCandidates(treeID,
+                                parent,
+                                repMembrIndx,
+                                repMembrSize,
+                                nonMissMembrSizeStatic,
+                                multImpFlag,
+                                candidate,
+                                candidateCount,
+                                & deltaMax,
+                                splitParameterMax,
+                                splitValueMaxCont,
+                                splitValueMaxFactSize,
+                                splitValueMaxFactPtr,
+                                splitIndicator);
+      } while (candidateCount == candidateSize);
+      unstackSplitCandidates(candidate, candidateSize, repMembrSize);
+    }
+    else {
+      while (selectRandomCovariates(treeID,
+                                    parent,
+                                    repMembrIndx,
+                                    repMembrSize,
+                                    randomCovariateIndex,
+                                    & uniformCovariateSize,
+                                    & uniformCovariateIndex,
+                                    cdf,
+                                    & cdfSize,
+                                    cdfSort,
+                                    density,
+                                    & densitySize,
+                                    densitySwap,
+                                    & covariate,
+                                    & actualCovariateCount,
+                                    & candidateCovariateCount,
+                                    splitVector,
+                                    & splitVectorSize,
+                                    & indxx,
+                                    nonMissMembrSizeStatic,
+                                    nonMissMembrIndxStatic,
+                                    & nonMissMembrSize,
+                                    & nonMissMembrIndx,
+                                    multImpFlag)) {
+        if ((RF_optHigh & OPT_SPLT_HIST) && (RF_histBinSize[covariate] > 0)) {
+          regressionHistogramSplit(treeID,
+                                   parent,
+                                   repMembrIndx,
+                                   repMembrSize,
+                                   nonMissMembrIndx,
+                                   nonMissMembrSize,
+                                   covariate,
+                                   candidateCovariateCount,
+                                   histCount,
+                                   histSum,
+                                   histSumSqr,
+                                   localSplitIndicator,
+                                   & deltaMax,
+                                   splitParameterMax,
+                                   splitValueMaxCont,
+                                   splitValueMaxFactSize,
+                                   splitValueMaxFactPtr,
+                                   splitIndicator);
         }
-      }
-      if (localEventTimeSize > 0) {
-        for (j = 1; j <= repMembrSize; j++) {
-          localSplitIndicator[j] = NEITHER;
-        }
-        leftSize = 0;
-        priorMembrIter = 0;
-        for (m=1; m <= localEventTimeSize; m++) {
-          for (q = 1; q <= RF_eventTypeSize; q++) {
-            nodeParentEventCR[q][m] = 0;
-          }
-        }
-        for (k = 1; k <= nonMissMembrSize; k++) {
-          if (RF_status[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] > 0) {
-            tIndx = 0;  
-            for (m = 1; m <= localEventTimeSize; m++) {
-              if (localEventTimeIndex[m] <= RF_masterTimeIndex[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]) {
-                tIndx = m;
-              }
-              else {
-                m = localEventTimeSize;
-              }
-            }
-            nodeParentEventCR[RF_eventTypeIndex[(uint) RF_status[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]]][tIndx] ++;
-          }
+        else {
+          splitLength = stackAndConstructSplitVector(treeID,
+                                                     repMembrSize,
+                                                     covariate,
+                                                     splitVector,
+                                                     splitVectorSize,
+                                                     & factorFlag,
+                                                     & deterministicSplitFlag,
+                                                     & mwcpSizeAbsolute,
+                                                     & splitVectorPtr);
+          regressionCandidateSplit(treeID,
+                                   parent,
+                                   repMembrIndx,
+                                   repMembrSize,
+                                   nonMissMembrIndx,
+                                   nonMissMembrSize,
+                                   indxx,
+                                   covariate,
+                                   candidateCovariateCount,
+                                   splitLength,
+                                   splitVectorPtr,
+                                   factorFlag,
+                                   mwcpSizeAbsolute,
+                                   localSplitIndicator,
+                                   & deltaMax,
+                                   splitParameterMax,
+                                   splitValueMaxCont,
+                                   splitValueMaxFactSize,
+                                   splitValueMaxFactPtr,
+                                   splitIndicator);
+          unstackSplitVector(treeID,
+                             splitVectorSize,
+                             splitLength,
+                             factorFlag,
+                             deterministicSplitFlag,
+                             mwcpSizeAbsolute,
+                             splitVectorPtr);
         }
+        unselectRandomCovariates(treeID,
+                                 parent,
+                                 repMembrSize,
+                                 indxx,
+                                 nonMissMembrSizeStatic,
+                                 nonMissMembrIndx,
+                                 multImpFlag);
+      }  
+    }
+    unstackRandomCovariates(treeID,
+                            parent, 
+                            randomCovariateIndex,
+                            uniformCovariateSize,
+                            cdf,
+                            cdfSize,
+                            cdfSort,
+                            density,
+                            densitySize,
+                            densitySwap,
+                            repMembrSize);
+    if ((RF_optHigh & OPT_SPLT_HIST) && (RF_histBinMax > 0)) {
+      free_uivector(histCount, 1, RF_histBinMax);
+      free_dvector(histSum, 1, RF_histBinMax);
+      free_dvector(histSumSqr, 1, RF_histBinMax);
+    }
+    unstackSplitIndicator(repMembrSize, localSplitIndicator);
+  }  
+  unstackPreSplit(preliminaryResult,
+                  multImpFlag,
+                  FALSE,  
+                  repMembrSize,
+                  splitVector,
+                  nonMissMembrIndxStatic);
+  result = summarizeSplitResult(*splitParameterMax,
+                                *splitValueMaxCont,
+                                *splitValueMaxFactSize,
+                                *splitValueMaxFactPtr,
+                                 splitStatistic,
+                                 deltaMax);
+  return result;
+}
+void regressionCandidateSplit(uint    treeID,
+                              Node   *parent,
+                              uint   *repMembrIndx,
+                              uint    repMembrSize,
+                              uint   *nonMissMembrIndx,
+                              uint    nonMissMembrSize,
+                              uint   *indxx,
+                              uint    covariate,
+                              uint    candidateCovariateCount,
+                              uint    splitLength,
+                              void   *splitVectorPtr,
+                              char    factorFlag,
+                              uint    mwcpSizeAbsolute,
+                              char   *localSplitIndicator,
+                              double *deltaMax,
+                              uint   *splitParameterMax,
+                              double *splitValueMaxCont,
+                              uint   *splitValueMaxFactSize,
+                              uint  **splitValueMaxFactPtr,
+                              char  **splitIndicator) {
+  uint priorMembrIter, currentMembrIter;
+  uint leftSize, rghtSize;
+  double sumLeft, sumRght, sumRghtSave, sumLeftSqr, sumRghtSqr, sumRghtSqrSave;
+  double leftTemp, rghtTemp, leftTempSqr, rghtTempSqr;
+  double delta;
+  uint j, k;
+  sumLeft = sumRght = sumLeftSqr = sumRghtSqr = 0;  
+  leftTempSqr = rghtTempSqr = 0;  
+  delta = 0;  
+  for (j = 1; j <= repMembrSize; j++) {
+    localSplitIndicator[j] = NEITHER;
+  }
+  sumRghtSave = sumRghtSqrSave = 0.0;
+  switch(RF_splitRule) {
+  case REGR_WT_NRM:
+    sumRghtSave = 0.0;
+    for (j = 1; j <= nonMissMembrSize; j++) {
+      sumRghtSave += RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[j]]] ];
+    }
+    break;
+  default:
+    sumRghtSave = sumRghtSqrSave = 0.0;
+    for (j = 1; j <= nonMissMembrSize; j++) {
+      sumRghtSave += RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[j]]] ];
+      sumRghtSqrSave += pow(RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[j]]] ], 2.0);
+    }
+    break;
+  }
+  leftSize = 0;
+  priorMembrIter = 0;
+  if (factorFlag == FALSE) {
+    for (j = 1; j <= nonMissMembrSize; j++) {
+      localSplitIndicator[ nonMissMembrIndx[indxx[j]] ] = RIGHT;
+    }
+    sumRght      = sumRghtSave;
+    sumRghtSqr   = sumRghtSqrSave;
+    sumLeft      = 0.0;
+    sumLeftSqr   = 0.0;
+  }
+  for (j = 1; j < splitLength; j++) {
+    if (factorFlag == TRUE) {
+      priorMembrIter = 0;
+      leftSize = 0;
+    }
+    virtuallySplitNode(treeID,
+                          factorFlag,
+                          mwcpSizeAbsolute,
+                          covariate,
+                          repMembrIndx,
+                          repMembrSize,
+                          nonMissMembrIndx,
+                          nonMissMembrSize,
+                          indxx,
+                          splitVectorPtr,
+                          j,
+                          localSplitIndicator,
+                          & leftSize,
+                          priorMembrIter,
+                          & currentMembrIter);
+    rghtSize = nonMissMembrSize - leftSize;
+      if (factorFlag == TRUE) {
         switch(RF_splitRule) {
-        case SURV_CR_LAU:
-          for (m = 1; m <= localEventTimeSize; m++) {
-            for (q = 1; q <= RF_eventTypeSize; q++) {
-              if (RF_crWeight[q] > 0) {
-                nodeParentInclusiveAtRisk[q][m] = nodeParentAtRisk[m];
-                for (s = 1; s < m; s++) {
-                  for (r = 1; r <= RF_eventTypeSize; r++) {
-                    if (q != r) {
-                      nodeParentInclusiveAtRisk[q][m]  += nodeParentEventCR[r][s];
-                    }
-                  }
-                }
-              }
+        case REGR_WT_NRM:
+          sumLeft = sumRght = 0.0;
+          for (k = 1; k <= nonMissMembrSize; k++) {
+            if (localSplitIndicator[ nonMissMembrIndx[indxx[k]] ] == LEFT) {
+              sumLeft += RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ];
             }
-          }
-          break;
-        case SURV_CR_LOG:
+            else {
+              sumRght += RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ];
+            }
+          } 
           break;
         default:
+          sumLeft = sumRght = 0.0;
+          sumLeftSqr = sumRghtSqr = 0.0;
+          for (k = 1; k <= nonMissMembrSize; k++) {
+            if (localSplitIndicator[ nonMissMembrIndx[indxx[k]] ] == LEFT) {
+              sumLeft    += RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ];
+              sumLeftSqr += pow(RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ], 2.0);
+            }
+            else {
+              sumRght    += RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ];
+              sumRghtSqr += pow(RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ], 2.0);
+            }
+          } 
           break;
         }
-        if (factorFlag == FALSE) {
-          for (j = 1; j <= nonMissMembrSize; j++) {
-            localSplitIndicator[ nonMissMembrIndx[indxx[j]] ] = RIGHT;
+      }
+      else {
+        switch(RF_splitRule) {
+        case REGR_WT_NRM:
+          for (k = priorMembrIter + 1; k < currentMembrIter; k++) {
+            sumLeft += RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ];
+            sumRght -= RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ];
           }
-          for (m = 1; m <= localEventTimeSize; m++) {
-            nodeLeftAtRisk[m] = 0;
-            for (q = 1; q <= RF_eventTypeSize; q++) {
-              nodeLeftEventCR[q][m] = 0;
-            }
+          break;
+        default:
+          for (k = priorMembrIter + 1; k < currentMembrIter; k++) {
+            sumLeft    += RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ];
+            sumLeftSqr += pow(RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ], 2.0);
+            sumRght    -= RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ];
+            sumRghtSqr -= pow(RF_response[treeID][1][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ], 2.0);
           }
+          break;
         }
-        for (j = 1; j < splitLength; j++) {
-          if (factorFlag == TRUE) {
-            priorMembrIter = 0;
-            leftSize = 0;
-          }
-          virtuallySplitNode(treeID,
-                             factorFlag,
-                             mwcpSizeAbsolute,
-                             covariate,
+      }
+      switch(RF_splitRule) {
+      case REGR_WT_NRM:
+        sumLeftSqr = pow(sumLeft, 2.0) / leftSize;
+        sumRghtSqr = pow(sumRght, 2.0) / rghtSize;
+        delta = sumLeftSqr + sumRghtSqr;
+        break;
+      case REGR_WT_OFF:
+        leftTemp = pow(sumLeft, 2.0) / pow(leftSize, 2.0);
+        rghtTemp = pow(sumRght, 2.0) / pow(rghtSize, 2.0);
+        leftTempSqr = sumLeftSqr / leftSize;
+        rghtTempSqr = sumRghtSqr / rghtSize;
+        delta = leftTemp + rghtTemp - leftTempSqr - rghtTempSqr;
+        break;
+      case REGR_WT_HVY:
+        leftTemp = pow(sumLeft, 2.0) / pow (nonMissMembrSize, 2.0);
+        rghtTemp = pow(sumRght, 2.0) / pow (nonMissMembrSize, 2.0);
+        leftTempSqr = sumLeftSqr * leftSize / pow (nonMissMembrSize, 2.0);
+        rghtTempSqr = sumRghtSqr * rghtSize / pow (nonMissMembrSize, 2.0);
+        delta = leftTemp + rghtTemp - leftTempSqr - rghtTempSqr;
+        break;
+      default:
+        break;
+      }
+      updateMaximumSplit(treeID,
+                         parent,
+                         delta,
+                         candidateCovariateCount,
+                         covariate,
+                         j,
+                         factorFlag,
+                         mwcpSizeAbsolute,
+                         repMembrSize,
+                         localSplitIndicator,
+                         deltaMax,
+                         splitParameterMax,
+                         splitValueMaxCont,
+                         splitValueMaxFactSize,
+                         splitValueMaxFactPtr,
+                         splitVectorPtr,
+                         splitIndicator);
+    if (factorFlag == FALSE) {
+      priorMembrIter = currentMembrIter - 1;
+    }
+  }  
+}
+char logRankNCR (uint    treeID,
+                 Node   *parent,
+                 uint   *repMembrIndx,
+                 uint    repMembrSize,
+                 uint   *allMembrIndx,
+                 uint    allMembrSize,
+                 uint   *splitParameterMax,
+                 double *splitValueMaxCont,
+                 uint   *splitValueMaxFactSize,
+                 uint  **splitValueMaxFactPtr,
+                 double *splitStatistic,
+                 char  **splitIndicator,
+                 char    multImpFlag) {
+  uint   *randomCovariateIndex;
+  uint    uniformCovariateIndex;
+  uint    uniformCovariateSize;
+  double *cdf;
+  uint    cdfSize;
+  uint   *cdfSort;
+  uint   *density;
+  uint    densitySize;
+  uint  **densitySwap;
+  uint     covariate;
+  double  *splitVector;
+  uint     splitVectorSize;
+  uint nonMissMembrSize, nonMissMembrSizeStatic;
+  uint *nonMissMembrIndx, *nonMissMembrIndxStatic;
+  uint   *indxx;
+  char *localSplitIndicator;
+  uint splitLength;
+  void *splitVectorPtr;
+  char factorFlag;
+  uint mwcpSizeAbsolute;
+  char deterministicSplitFlag;
+  char preliminaryResult, result;
+  double deltaMax;
+  localSplitIndicator    = NULL;  
+  mwcpSizeAbsolute       = 0;     
+  *splitParameterMax     = 0;
+  *splitValueMaxFactSize = 0;
+  *splitValueMaxFactPtr  = NULL;
+  *splitValueMaxCont     = NA_REAL;
+  deltaMax               = NA_REAL;
+  preliminaryResult = getPreSplitResult(treeID,
+                                        parent,
+                                        repMembrSize,
+                                        repMembrIndx,
+                                        & nonMissMembrSizeStatic,
+                                        & nonMissMembrIndxStatic,
+                                        & splitVector,
+                                        & parent -> mean,
+                                        multImpFlag,
+                                        FALSE);
+  if (preliminaryResult) {
+    stackSplitIndicator(repMembrSize, & localSplitIndicator);
+    stackRandomCovariates(treeID,
+                          parent,
+                          repMembrSize,
+                          multImpFlag,
+                          & randomCovariateIndex,
+                          & uniformCovariateSize,
+                          & cdf,
+                          & cdfSize,
+                          & cdfSort,
+                          & density,
+                          & densitySize,
+                          & densitySwap);
+    uint *localEventTimeCount, *localEventTimeIndex;
+    uint  localEventTimeSize;
+    uint *nodeParentEvent,  *nodeLeftEvent,  *nodeRightEvent;
+    uint *nodeParentAtRisk, *nodeLeftAtRisk, *nodeRightAtRisk;
+    uint   *survivalTimeRank;
+    double *survivalRank;
+    double  meanSurvRank, varSurvRank;
+    uint   *membrTimeIndex;
+    double *eventRatioSum, *riskRatioSum, *riskRatioSqrSum;
+    double *fenwickCount, *fenwickSum;
+    membrTimeIndex = NULL;
+    eventRatioSum = riskRatioSum = riskRatioSqrSum = fenwickCount = fenwickSum = NULL;
+    survivalTimeRank = NULL;  
+    survivalRank = NULL;  
+    meanSurvRank = varSurvRank = 0;  
+    localEventTimeSize = 0;  
+    switch(RF_splitRule) {
+    case SURV_LGRNK:
+      if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
+        stackAndGetSplitSurv(treeID,
                              repMembrIndx,
                              repMembrSize,
-                             nonMissMembrIndx,
-                             nonMissMembrSize,
-                             indxx,
-                             splitVectorPtr,
-                             j,
-                             localSplitIndicator,
-                             & leftSize,
-                             priorMembrIter,
-                             & currentMembrIter);
-          if (factorFlag == TRUE) {
-            for (m = 1; m <= localEventTimeSize; m++) {
-              nodeLeftAtRisk[m] = 0;
-              for (q = 1; q <= RF_eventTypeSize; q++) {
-                nodeLeftEventCR[q][m] = 0;
-              }
-            }
-            for (k = 1; k <= nonMissMembrSize; k++) {
-              if (localSplitIndicator[  nonMissMembrIndx[indxx[k]]  ] == LEFT) {
-                tIndx = 0;  
-                for (m = 1; m <= localEventTimeSize; m++) {
-                  if (localEventTimeIndex[m] <= RF_masterTimeIndex[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]) {
-                    tIndx = m;
-                    nodeLeftAtRisk[tIndx] ++;
-                  }
-                  else {
-                    m = localEventTimeSize;
-                  }
-                }
-                if (RF_status[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] > 0) {
-                  nodeLeftEventCR[RF_eventTypeIndex[(uint) RF_status[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]]][tIndx] ++;
-                }
-              }
+                             nonMissMembrIndxStatic,
+                             nonMissMembrSizeStatic,
+                             & localEventTimeCount,
+                             & localEventTimeIndex,
+                             & localEventTimeSize,
+                             & nodeParentEvent,
+                             & nodeParentAtRisk,
+                             & nodeLeftEvent,
+                             & nodeLeftAtRisk,
+                             & nodeRightEvent,
+                             & nodeRightAtRisk);
+        stackLogRankIncrement(repMembrSize,
+                              localEventTimeSize,
+                              & membrTimeIndex,
+                              & eventRatioSum,
+                              & riskRatioSum,
+                              & riskRatioSqrSum,
+                              & fenwickCount,
+                              & fenwickSum);
+        if (localEventTimeSize > 0) {
+          getLogRankIncrement(treeID,
+                              repMembrIndx,
+                              nonMissMembrIndxStatic,
+                              nonMissMembrSizeStatic,
+                              localEventTimeIndex,
+                              localEventTimeSize,
+                              nodeParentEvent,
+                              nodeParentAtRisk,
+                              membrTimeIndex,
+                              eventRatioSum,
+                              riskRatioSum,
+                              riskRatioSqrSum);
+        }
+      }
+      break;
+    case SURV_LRSCR:
+      if (RF_optHigh & OPT_LRSCR_STD) {
+        survivalRank = dvector(1, repMembrSize);
+        if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
+          getLogRankScore(treeID,
+                          repMembrIndx,
+                          nonMissMembrIndxStatic,
+                          nonMissMembrSizeStatic,
+                          survivalRank,
+                          & meanSurvRank,
+                          & varSurvRank);
+        }
+      }
+      else {
+        survivalTimeRank = uivector(1, repMembrSize);
+        if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
+          getLogRankTimeRank(treeID,
+                             repMembrIndx,
+                             nonMissMembrIndxStatic,
+                             nonMissMembrSizeStatic,
+                             survivalTimeRank);
+        }
+      }
+      localEventTimeSize = 1;
+      break;
+    default:
+      break;
+    }
+    uint candidateSize = ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) ? getSplitCandidateSize() : 0;
+    uint actualCovariateCount = 0;
+    uint candidateCovariateCount = 0;
+    if (candidateSize > 0) {
+      SplitCandidate **candidate = stackSplitCandidates(candidateSize, repMembrSize, 0);
+      uint candidateCount, c;
+      do {
+        candidateCount = selectSplitCandidates(treeID,
+                                               parent,
+                                               repMembrIndx,
+                                               repMembrSize,
+                                               randomCovariateIndex,
+                                               & uniformCovariateSize,
+                                               & uniformCovariateIndex,
+                                               cdf,
+                                               & cdfSize,
+                                               cdfSort,
+                                               density,
+                                               & densitySize,
+                                               densitySwap,
+                                               & actualCovariateCount,
+                                               & candidateCovariateCount,
+                                               nonMissMembrSizeStatic,
+                                               nonMissMembrIndxStatic,
+                                               multImpFlag,
+                                               candidate,
+                                               candidateSize);
+        for (c = 1; c <= candidateCount; c++) {
+#ifdef _OPENMP
+#pragma omp task firstprivate(c) if (candidateCount > 1)
+#endif
+          logRankNCRCandidateSplit(treeID,
+                                   parent,
+                                   repMembrIndx,
+                                   repMembrSize,
+                                   localEventTimeSize,
+                                   localEventTimeIndex,
+                                   nodeParentEvent,
+                                   nodeParentAtRisk,
+                                   membrTimeIndex,
+                                   eventRatioSum,
+                                   riskRatioSum,
+                                   riskRatioSqrSum,
+                                   survivalTimeRank,
+                                   survivalRank,
+                                   meanSurvRank,
+                                   varSurvRank,
+                                   candidate[c] -> nonMissMembrIndx,
+                                   candidate[c] -> nonMissMembrSize,
+                                   candidate[c] -> indxx,
+                                   candidate[c] -> covariate,
+                                   candidate[c] -> candidateCovariateCount,
+                                   candidate[c] -> splitLength,
+                                   candidate[c] -> splitVectorPtr,
+                                   candidate[c] -> factorFlag,
+                                   candidate[c] -> mwcpSizeAbsolute,
+                                   candidate[c] -> localSplitIndicator,
+                                   & candidate[c] -> deltaMax,
+                                   & candidate[c] -> splitParameterMax,
+                                   & candidate[c] -> splitValueMaxCont,
+                                   & candidate[c] -> splitValueMaxFactSize,
+                                   & candidate[c] -> splitValueMaxFactPtr,
+                                   NULL);
+        }
+#ifdef _OPENMP
+#pragma omp taskwait
+#endif
+        unselectSplitCandidates(treeID,
+                                parent,
+                                repMembrIndx,
+                                repMembrSize,
+                                nonMissMembrSizeStatic,
+                                multImpFlag,
+                                candidate,
+                                candidateCount,
+                                & deltaMax,
+                                splitParameterMax,
+                                splitValueMaxCont,
+                                splitValueMaxFactSize,
+                                splitValueMaxFactPtr,
+                                splitIndicator);
+      } while (candidateCount == candidateSize);
+      unstackSplitCandidates(candidate, candidateSize, repMembrSize);
+    }
+    else {
+      while (selectRandomCovariates(treeID,
+                                    parent,
+                                    repMembrIndx,
+                                    repMembrSize,
+                                    randomCovariateIndex,
+                                    & uniformCovariateSize,
+                                    & uniformCovariateIndex,
+                                    cdf,
+                                    & cdfSize,
+                                    cdfSort,
+                                    density,
+                                    & densitySize,
+                                    densitySwap,
+                                    & covariate,
+                                    & actualCovariateCount,
+                                    & candidateCovariateCount,
+                                    splitVector,
+                                    & splitVectorSize,
+                                    & indxx,
+                                    nonMissMembrSizeStatic,
+                                    nonMissMembrIndxStatic,
+                                    & nonMissMembrSize,
+                                    & nonMissMembrIndx,
+                                    multImpFlag)) {
+        splitLength = stackAndConstructSplitVector(treeID,
+                                                   repMembrSize,
+                                                   covariate,
+                                                   splitVector,
+                                                   splitVectorSize,
+                                                   & factorFlag,
+                                                   & deterministicSplitFlag,
+                                                   & mwcpSizeAbsolute,
+                                                   & splitVectorPtr);
+        switch(RF_splitRule) {
+        case SURV_LGRNK:
+          if (!((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP)))) {
+            stackAndGetSplitSurv(treeID,
+                                 repMembrIndx,
+                                 repMembrSize,
+                                 nonMissMembrIndx,
+                                 nonMissMembrSize,
+                                 & localEventTimeCount,
+                                 & localEventTimeIndex,
+                                 & localEventTimeSize,
+                                 & nodeParentEvent,
+                                 & nodeParentAtRisk,
+                                 & nodeLeftEvent,
+                                 & nodeLeftAtRisk,
+                                 & nodeRightEvent,
+                                 & nodeRightAtRisk);
+            stackLogRankIncrement(repMembrSize,
+                                  localEventTimeSize,
+                                  & membrTimeIndex,
+                                  & eventRatioSum,
+                                  & riskRatioSum,
+                                  & riskRatioSqrSum,
+                                  & fenwickCount,
+                                  & fenwickSum);
+            if (localEventTimeSize > 0) {
+              getLogRankIncrement(treeID,
+                                  repMembrIndx,
+                                  nonMissMembrIndx,
+                                  nonMissMembrSize,
+                                  localEventTimeIndex,
+                                  localEventTimeSize,
+                                  nodeParentEvent,
+                                  nodeParentAtRisk,
+                                  membrTimeIndex,
+                                  eventRatioSum,
+                                  riskRatioSum,
+                                  riskRatioSqrSum);
             }
           }
-          else {
-            for (k = priorMembrIter + 1; k < currentMembrIter; k++) {
+          break;
+        case SURV_LRSCR:
+          if (!((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP)))) {
+            if (RF_optHigh & OPT_LRSCR_STD) {
+              getLogRankScore(treeID,
+                              repMembrIndx,
+                              nonMissMembrIndx,
+                              nonMissMembrSize,
+                              survivalRank,
+                              & meanSurvRank,
+                              & varSurvRank);
+            }
+            else {
+              getLogRankTimeRank(treeID,
+                                 repMembrIndx,
+                                 nonMissMembrIndx,
+                                 nonMissMembrSize,
+                                 survivalTimeRank);
+            }
+          }
+          localEventTimeSize = 1;
+          break;
+        default:
+          break;
+        }
+        logRankNCRCandidateSplit(treeID,
+                                 parent,
+                                 repMembrIndx,
+                                 repMembrSize,
+                                 localEventTimeSize,
+                                 localEventTimeIndex,
+                                 nodeParentEvent,
+                                 nodeParentAtRisk,
+                                 membrTimeIndex,
+                                 eventRatioSum,
+                                 riskRatioSum,
+                                 riskRatioSqrSum,
+                                 survivalTimeRank,
+                                 survivalRank,
+                                 meanSurvRank,
+                                 varSurvRank,
+                                 nonMissMembrIndx,
+                                 nonMissMembrSize,
+                                 indxx,
+                                 covariate,
+                                 candidateCovariateCount,
+                                 splitLength,
+                                 splitVectorPtr,
+                                 factorFlag,
+                                 mwcpSizeAbsolute,
+                                 localSplitIndicator,
+                                 & deltaMax,
+                                 splitParameterMax,
+                                 splitValueMaxCont,
+                                 splitValueMaxFactSize,
+                                 splitValueMaxFactPtr,
+                                 splitIndicator);
+        unstackSplitVector(treeID,
+                           splitVectorSize,
+                           splitLength,
+                           factorFlag,
+                           deterministicSplitFlag,
+                           mwcpSizeAbsolute,
+                           splitVectorPtr);
+        unselectRandomCovariates(treeID,
+                                 parent,
+                                 repMembrSize,
+                                 indxx,
+                                 nonMissMembrSizeStatic,
+                                 nonMissMembrIndx,
+                                 multImpFlag);
+        switch(RF_splitRule) {
+        case SURV_LGRNK:
+          if (!((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP)))) {
+            unstackLogRankIncrement(repMembrSize,
+                                    localEventTimeSize,
+                                    membrTimeIndex,
+                                    eventRatioSum,
+                                    riskRatioSum,
+                                    riskRatioSqrSum,
+                                    fenwickCount,
+                                    fenwickSum);
+            unstackSplitSurv(localEventTimeCount,
+                             localEventTimeIndex,
+                             localEventTimeSize,
+                             nodeParentEvent,
+                             nodeParentAtRisk,
+                             nodeLeftEvent,
+                             nodeLeftAtRisk,
+                             nodeRightEvent,
+                             nodeRightAtRisk);
+          }
+          break;
+        case SURV_LRSCR:
+          break;
+        default:
+          break;
+        }
+      }  
+    }
+    switch(RF_splitRule) {
+    case SURV_LGRNK:
+      if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
+        unstackLogRankIncrement(repMembrSize,
+                                localEventTimeSize,
+                                membrTimeIndex,
+                                eventRatioSum,
+                                riskRatioSum,
+                                riskRatioSqrSum,
+                                fenwickCount,
+                                fenwickSum);
+        unstackSplitSurv(localEventTimeCount,
+                         localEventTimeIndex,
+                         localEventTimeSize,
+                         nodeParentEvent,
+                         nodeParentAtRisk,
+                         nodeLeftEvent,
+                         nodeLeftAtRisk,
+                         nodeRightEvent,
+                         nodeRightAtRisk);
+      }
+    break;
+    case SURV_LRSCR:
+      if (RF_optHigh & OPT_LRSCR_STD) {
+        free_dvector(survivalRank, 1, repMembrSize);
+      }
+      else {
+        free_uivector(survivalTimeRank, 1, repMembrSize);
+      }
+      break;
+    default:
+      break;
+    }
+    unstackRandomCovariates(treeID,
+                            parent,
+                            randomCovariateIndex,
+                            uniformCovariateSize,
+                            cdf,
+                            cdfSize,
+                            cdfSort,
+                            density,
+                            densitySize,
+                            densitySwap,
+                            repMembrSize);
+    unstackSplitIndicator(repMembrSize, localSplitIndicator);
+  }  
+  unstackPreSplit(preliminaryResult,
+                  multImpFlag,
+                  FALSE, 
+                  repMembrSize,
+                  splitVector,
+                  nonMissMembrIndxStatic);
+  result = summarizeSplitResult(*splitParameterMax,
+                                *splitValueMaxCont,
+                                *splitValueMaxFactSize,
+                                *splitValueMaxFactPtr,
+                                 splitStatistic,
+                                 deltaMax);
+  return result;
+}
+void logRankNCRCandidateSplit(uint    treeID,
+                              Node   *parent,
+                              uint   *repMembrIndx,
+                              uint    repMembrSize,
+                              uint    localEventTimeSize,
+                              uint   *localEventTimeIndex,
+                              uint   *nodeParentEvent,
+                              uint   *nodeParentAtRisk,
+                              uint   *membrTimeIndex,
+                              double *eventRatioSum,
+                              double *riskRatioSum,
+                              double *riskRatioSqrSum,
+                              uint   *survivalTimeRank,
+                              double *nodeSurvivalRank,
+                              double  nodeMeanSurvRank,
+                              double  nodeVarSurvRank,
+                              uint   *nonMissMembrIndx,
+                              uint    nonMissMembrSize,
+                              uint   *indxx,
+                              uint    covariate,
+                              uint    candidateCovariateCount,
+                              uint    splitLength,
+                              void   *splitVectorPtr,
+                              char    factorFlag,
+                              uint    mwcpSizeAbsolute,
+                              char   *localSplitIndicator,
+                              double *deltaMax,
+                              uint   *splitParameterMax,
+                              double *splitValueMaxCont,
+                              uint   *splitValueMaxFactSize,
+                              uint  **splitValueMaxFactPtr,
+                              char  **splitIndicator) {
+  uint *nodeLeftEvent, *nodeLeftAtRisk;
+  double *fenwickCount, *fenwickSum;
+  double *survivalRank;
+  double  meanSurvRank, varSurvRank;
+  double  leftEvent, leftLinear, leftQuad, leftMoved, leftLater;
+  double deltaNum, deltaNumAdj, deltaDen;
+  double delta;
+  uint   tIndx;
+  uint priorMembrIter, currentMembrIter;
+  uint leftSize;
+  uint j, k, m;
+  nodeLeftEvent = nodeLeftAtRisk = NULL;
+  fenwickCount = fenwickSum = NULL;
+  survivalRank = NULL;
+  meanSurvRank = varSurvRank = 0.0;
+  leftEvent = leftLinear = leftQuad = leftMoved = 0.0;
+  delta = deltaNum = 0;
+  if ((RF_splitRule == SURV_LGRNK) && (localEventTimeSize > 0)) {
+    nodeLeftEvent  = uivector(1, localEventTimeSize);
+    nodeLeftAtRisk = uivector(1, localEventTimeSize);
+    fenwickCount   = dvector(1, localEventTimeSize);
+    fenwickSum     = dvector(1, localEventTimeSize);
+  }
+  if ((RF_splitRule == SURV_LRSCR) && (localEventTimeSize > 0)) {
+    if (RF_optHigh & OPT_LRSCR_STD) {
+      survivalRank = nodeSurvivalRank;
+      meanSurvRank = nodeMeanSurvRank;
+      varSurvRank  = nodeVarSurvRank;
+    }
+    else {
+      survivalRank = dvector(1, repMembrSize);
+      getLogRankCovariateScore(treeID,
+                               repMembrIndx,
+                               nonMissMembrIndx,
+                               nonMissMembrSize,
+                               indxx,
+                               survivalTimeRank,
+                               survivalRank,
+                               & meanSurvRank,
+                               & varSurvRank);
+    }
+  }
+  if (localEventTimeSize > 0) {
+    for (j = 1; j <= repMembrSize; j++) {
+      localSplitIndicator[j] = NEITHER;
+    }
+    leftSize = 0;
+    priorMembrIter = 0;
+    if (factorFlag == FALSE) {
+      for (j = 1; j <= nonMissMembrSize; j++) {
+        localSplitIndicator[ nonMissMembrIndx[indxx[j]] ] = RIGHT;
+      }
+      switch(RF_splitRule) {
+      case SURV_LGRNK:
+        for (m = 1; m <= localEventTimeSize; m++) {
+          fenwickCount[m] = fenwickSum[m] = 0.0;
+        }
+        leftEvent = leftLinear = leftQuad = leftMoved = 0.0;
+        break;
+      case SURV_LRSCR:
+        deltaNum =  0.0;
+        break;
+      default:
+        break;
+      }
+    }
+    for (j = 1; j < splitLength; j++) {
+      if (factorFlag == TRUE) {
+        priorMembrIter = 0;
+        leftSize = 0;
+      }
+      virtuallySplitNode(treeID,
+                         factorFlag,
+                         mwcpSizeAbsolute,
+                         covariate,
+                         repMembrIndx,
+                         repMembrSize,
+                         nonMissMembrIndx,
+                         nonMissMembrSize,
+                         indxx,
+                         splitVectorPtr,
+                         j,
+                         localSplitIndicator,
+                         & leftSize,
+                         priorMembrIter,
+                         & currentMembrIter);
+      if (factorFlag == TRUE) {
+        switch(RF_splitRule) {
+        case SURV_LGRNK:
+          for (m = 1; m <= localEventTimeSize; m++) {
+            nodeLeftEvent[m] = nodeLeftAtRisk[m] = 0;
+          }
+          for (k = 1; k <= nonMissMembrSize; k++) {
+            if (localSplitIndicator[  nonMissMembrIndx[indxx[k]]  ] == LEFT) {
               tIndx = 0;  
               for (m = 1; m <= localEventTimeSize; m++) {
                 if (localEventTimeIndex[m] <= RF_masterTimeIndex[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]) {
@@ -8777,254 +10094,156 @@ char logRankCR (uint    treeID,
                 }
               }
               if (RF_status[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] > 0) {
-                nodeLeftEventCR[RF_eventTypeIndex[(uint) RF_status[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]]][tIndx] ++;
+                nodeLeftEvent[tIndx] ++;
               }
             }
+            else {
+            }
+          } 
+          break;
+        case SURV_LRSCR:
+          deltaNum = 0.0;
+          for (k = 1; k <= nonMissMembrSize; k++) {
+            if (localSplitIndicator[ nonMissMembrIndx[k] ] == LEFT) {
+              deltaNum = deltaNum + survivalRank[ nonMissMembrIndx[k] ];
+            }
           }
-          switch(RF_splitRule) {
-          case SURV_CR_LAU:
-            for (m=1; m <= localEventTimeSize; m++) {
-              for (q = 1; q <= RF_eventTypeSize; q++) {
-                if (RF_crWeight[q] > 0) {
-                  nodeLeftInclusiveAtRisk[q][m]   = nodeLeftAtRisk[m];
-                  for (s = 1; s < m; s++) {
-                    for (r = 1; r <= RF_eventTypeSize; r++) {
-                      if (q != r) {
-                        nodeLeftInclusiveAtRisk[q][m]    += nodeLeftEventCR[r][s];
-                      }
-                    }
-                  }
-                }
-              }
-            }
-            break;
-          case SURV_CR_LOG:
-            break;
-          default:
-            break;
-          }
-          delta = deltaNum = deltaDen =  0.0;
-          switch(RF_splitRule) {
-          case SURV_CR_LAU:
-            for (q = 1; q <= RF_eventTypeSize; q++) {
-              if (RF_crWeight[q] > 0) {
-                deltaSubNum = 0;
-                for (m = 1; m <= localEventTimeSize; m++) {
-                  deltaSubNum = deltaSubNum + (nodeLeftEventCR[q][m] - (nodeParentEventCR[q][m] * ((double) nodeLeftInclusiveAtRisk[q][m] / nodeParentInclusiveAtRisk[q][m])));
-                }
-                deltaNum = deltaNum + (RF_crWeight[q] * deltaSubNum);
-                deltaSubDen = 0;
-                for (m = 1; m <= localEventTimeSize; m++) {
-                  if (nodeParentAtRisk[m] >= 2) {
-                    deltaSubDen = deltaSubDen  + (
-                                                  (nodeParentEventCR[q][m] * ((double) nodeLeftInclusiveAtRisk[q][m] / nodeParentInclusiveAtRisk[q][m])) *
-                                                  (1.0 - ((double) nodeLeftInclusiveAtRisk[q][m] / nodeParentInclusiveAtRisk[q][m])) *
-                                                  ((double) (nodeParentInclusiveAtRisk[q][m] - nodeParentEventCR[q][m]) / (nodeParentInclusiveAtRisk[q][m] - 1))
-                                                  );
-                  }
-                }
-                deltaDen = deltaDen + (RF_crWeight[q] * RF_crWeight[q] * deltaSubDen);
-              }
-            }
-            break;
-          case SURV_CR_LOG:
-            for (q = 1; q <= RF_eventTypeSize; q++) {
-              if (RF_crWeight[q] > 0) {
-                deltaSubNum = 0;
-                for (m=1; m <= localEventTimeSize; m++) {
-                  deltaSubNum = deltaSubNum + (nodeLeftEventCR[q][m] - (nodeParentEventCR[q][m] * ((double) nodeLeftAtRisk[m] / nodeParentAtRisk[m])));
-                }
-                deltaNum = deltaNum + (RF_crWeight[q] * deltaSubNum);
-                deltaSubDen = 0;
-                for (m = 1; m <= localEventTimeSize; m++) {
-                  if (nodeParentAtRisk[m] >= 2) {
-                    deltaSubDen = deltaSubDen  + (
-                                                  (nodeParentEventCR[q][m] * ((double) nodeLeftAtRisk[m] / nodeParentAtRisk[m])) *
-                                                  (1.0 - ((double) nodeLeftAtRisk[m] / nodeParentAtRisk[m])) *
-                                                  ((double) (nodeParentAtRisk[m] - nodeParentEventCR[q][m]) / (nodeParentAtRisk[m] - 1))
-                                                  );
-                  }
-                }
-                deltaDen = deltaDen + (RF_crWeight[q] * RF_crWeight[q] * deltaSubDen);
-              }
-            }
-            break;
-          default:
-            break;
-          }
-          deltaNum = fabs(deltaNum);
-          deltaDen = sqrt(deltaDen);
-          if (deltaDen <= EPSILON) {
-            if (deltaNum <= EPSILON) {
-              delta = 0.0;
-            }
-            else {
-              delta = deltaNum / deltaDen;
-            }
-          }
-          else {
-            delta = deltaNum / deltaDen;
-          }
-          updateMaximumSplit(treeID,
-                             parent,
-                             delta,
-                             candidateCovariateCount,
-                             covariate,
-                             j,
-                             factorFlag,
-                             mwcpSizeAbsolute,
-                             repMembrSize,
-                             localSplitIndicator,
-                             & deltaMax,
-                             splitParameterMax,
-                             splitValueMaxCont,
-                             splitValueMaxFactSize,
-                             splitValueMaxFactPtr,
-                             splitVectorPtr,
-                             splitIndicator);
-          if (factorFlag == FALSE) {
-            priorMembrIter = currentMembrIter - 1;
-          }
-        }  
-      }  
-      else {
-      }
-      unstackSplitVector(treeID,
-                         splitVectorSize,
-                         splitLength,
-                         factorFlag,
-                         deterministicSplitFlag,
-                         mwcpSizeAbsolute,
-                         splitVectorPtr);
-      unselectRandomCovariates(treeID,
-                               parent,
-                               repMembrSize,
-                               indxx,
-                               nonMissMembrSizeStatic,
-                               nonMissMembrIndx,
-                               multImpFlag);
-      if (!((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP)))) {
-        unstackSplitSurv(localEventTimeCount,
-                         localEventTimeIndex,
-                         localEventTimeSize,
-                         nodeParentEvent,
-                         nodeParentAtRisk,
-                         nodeLeftEvent,
-                         nodeLeftAtRisk,
-                         nodeRightEvent,
-                         nodeRightAtRisk);
-        if (localEventTimeSize > 0) {
-          free_uimatrix(nodeParentEventCR, 1, RF_eventTypeSize, 1, localEventTimeSize);
-          free_uimatrix(nodeLeftEventCR, 1, RF_eventTypeSize, 1, localEventTimeSize);
+          break;
+        default:
+          break;
         }
+      }
+      else {
         switch(RF_splitRule) {
-        case SURV_CR_LAU:
-          if (localEventTimeSize > 0) {
-            free_uimatrix(nodeParentInclusiveAtRisk, 1, RF_eventTypeSize, 1, localEventTimeSize);
-            free_uimatrix(nodeLeftInclusiveAtRisk, 1, RF_eventTypeSize, 1, localEventTimeSize);
+        case SURV_LGRNK:
+          for (k = priorMembrIter + 1; k < currentMembrIter; k++) {
+            tIndx = membrTimeIndex[ nonMissMembrIndx[indxx[k]] ];
+            if (tIndx > 0) {
+              leftLater = leftMoved - sumFenwick(fenwickCount, tIndx - 1);
+              leftQuad = leftQuad + riskRatioSqrSum[tIndx] + 2.0 * ((riskRatioSqrSum[tIndx] * leftLater) + sumFenwick(fenwickSum, tIndx - 1));
+              leftLinear = leftLinear + riskRatioSum[tIndx];
+              leftEvent = leftEvent - eventRatioSum[tIndx];
+              updateFenwick(fenwickCount, localEventTimeSize, tIndx, 1.0);
+              updateFenwick(fenwickSum, localEventTimeSize, tIndx, riskRatioSqrSum[tIndx]);
+              leftMoved = leftMoved + 1.0;
+            }
+            if (RF_status[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] > 0) {
+              leftEvent = leftEvent + 1.0;
+            }
           }
           break;
-        case SURV_CR_LOG:
+        case SURV_LRSCR:
+          for (k = priorMembrIter + 1; k < currentMembrIter; k++) {
+            deltaNum = deltaNum + survivalRank[ nonMissMembrIndx[indxx[k]] ];
+          }
           break;
         default:
           break;
         }
       }
-    }  
-    if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
-        unstackSplitSurv(localEventTimeCount,
-                         localEventTimeIndex,
-                         localEventTimeSize,
-                         nodeParentEvent,
-                         nodeParentAtRisk,
-                         nodeLeftEvent,
-                         nodeLeftAtRisk,
-                         nodeRightEvent,
-                         nodeRightAtRisk);
-      free_uimatrix(nodeParentEventCR, 1, RF_eventTypeSize, 1, localEventTimeSize);
-      free_uimatrix(nodeLeftEventCR, 1, RF_eventTypeSize, 1, localEventTimeSize);
       switch(RF_splitRule) {
-      case SURV_CR_LAU:
-        free_uimatrix(nodeParentInclusiveAtRisk, 1, RF_eventTypeSize, 1, localEventTimeSize);
-        free_uimatrix(nodeLeftInclusiveAtRisk, 1, RF_eventTypeSize, 1, localEventTimeSize);
+      case SURV_LGRNK:
+        delta = deltaNum = deltaDen =  0.0;
+        if (factorFlag == FALSE) {
+          deltaNum = leftEvent;
+          deltaDen = leftLinear - leftQuad;
+          if (deltaDen < 0.0) {
+            deltaDen = 0.0;
+          }
+        }
+        else {
+          for (k=1; k <= localEventTimeSize; k++) {
+            deltaNum = deltaNum + ((double) nodeLeftEvent[k] - ((double) ( nodeLeftAtRisk[k] * nodeParentEvent[k]) / nodeParentAtRisk[k]));
+            if (nodeParentAtRisk[k] >= 2) {
+              deltaDen = deltaDen + (
+                                     ((double) nodeLeftAtRisk[k] / nodeParentAtRisk[k]) *
+                                     (1.0 - ((double) nodeLeftAtRisk[k] / nodeParentAtRisk[k])) *
+                                     ((double) (nodeParentAtRisk[k] - nodeParentEvent[k]) / (nodeParentAtRisk[k] - 1)) * nodeParentEvent[k]
+                                     );
+            }
+          }
+        }
+        deltaNum = fabs(deltaNum);
+        deltaDen = sqrt(deltaDen);
+        if (deltaDen <= EPSILON) {
+          if (deltaNum <= EPSILON) {
+            delta = 0.0;
+          }
+          else {
+            delta = deltaNum / deltaDen;
+          }
+        }
+        else {
+          delta = deltaNum / deltaDen;
+        }
         break;
-      case SURV_CR_LOG:
+      case SURV_LRSCR:
+        deltaNumAdj  = deltaNum - (leftSize * meanSurvRank);
+        deltaDen     = leftSize * (1.0 - (leftSize / nonMissMembrSize)) * varSurvRank;
+        deltaNumAdj = fabs(deltaNumAdj);
+        deltaDen = sqrt(deltaDen);
+        if (deltaDen <= EPSILON) {
+          if (deltaNumAdj <= EPSILON) {
+            delta = 0.0;
+          }
+          else {
+            delta = deltaNumAdj / deltaDen;
+          }
+        }
+        else {
+          delta = deltaNumAdj / deltaDen;
+        }
         break;
       default:
         break;
       }
-    }
-    unstackSplitIndicator(repMembrSize, localSplitIndicator);
-    unstackRandomCovariates(treeID,
-                            parent,
-                            randomCovariateIndex,
-                            uniformCovariateSize,
-                            cdf,
-                            cdfSize,
-                            cdfSort,
-                            density,
-                            densitySize,
-                            densitySwap,
-                            repMembrSize);
+      updateMaximumSplit(treeID,
+                         parent,
+                         delta,
+                         candidateCovariateCount,
+                         covariate,
+                         j,
+                         factorFlag,
+                         mwcpSizeAbsolute,
+                         repMembrSize,
+                         localSplitIndicator,
+                         deltaMax,
+                         splitParameterMax,
+                         splitValueMaxCont,
+                         splitValueMaxFactSize,
+                         splitValueMaxFactPtr,
+                         splitVectorPtr,
+                         splitIndicator);
+      if (factorFlag == FALSE) {
+        priorMembrIter = currentMembrIter - 1;
+      }
+    }  
   }  
-  unstackPreSplit(preliminaryResult,
-                  multImpFlag,
-                  FALSE,  
-                  repMembrSize,
-                  splitVector,
-                  nonMissMembrIndxStatic);
-  result = summarizeSplitResult(*splitParameterMax,
-                                *splitValueMaxCont,
-                                *splitValueMaxFactSize,
-                                *splitValueMaxFactPtr,
-                                splitStatistic,
-                                deltaMax);
-  return result;
-}
-void getMemberCountOnly(uint treeID) {
-  Terminal *parent;
-  uint leaf, i;
-  uint *membershipIndex;
-  uint  membershipSize;
-  if ((RF_opt & OPT_BOOT_NODE) | (RF_opt & OPT_BOOT_NONE)) {
-    membershipIndex = RF_identityMembershipIndex;
-    membershipSize  = RF_observationSize;
-  }
   else {
-    membershipIndex = RF_bootMembershipIndex[treeID];
-    membershipSize = RF_bootstrapSize;
   }
-  for (leaf = 1; leaf <= RF_tLeafCount[treeID]; leaf++) {
-    parent = RF_tTermList[treeID][leaf];
-    parent -> membrCount = 0;
-    for (i = 1; i <= membershipSize; i++) {
-      if (RF_tTermMembership[treeID][membershipIndex[i]] == parent) {
-        parent -> membrCount ++;
-      }
-    }
-    if (parent -> membrCount == 0) {
-      if (!(RF_opt & OPT_OUTC_TYPE)) {
-        Rprintf("\nRF-SRC:  *** ERROR *** ");
-        Rprintf("\nRF-SRC:  Zero node count encountered in getMemberCountOnly() in (tree, leaf) = (%10d, %10d)  \n", treeID, parent -> nodeID);
-        Rprintf("\nRF-SRC:  Please Contact Technical Support.");
-        error("\nRF-SRC:  The application will now exit.\n");
-      }
-    }
-  }  
+  if ((RF_splitRule == SURV_LGRNK) && (localEventTimeSize > 0)) {
+    free_uivector(nodeLeftEvent, 1, localEventTimeSize);
+    free_uivector(nodeLeftAtRisk, 1, localEventTimeSize);
+    free_dvector(fenwickCount, 1, localEventTimeSize);
+    free_dvector(fenwickSum, 1, localEventTimeSize);
+  }
+  if ((RF_splitRule == SURV_LRSCR) && (localEventTimeSize > 0) && (!(RF_optHigh & OPT_LRSCR_STD))) {
+    free_dvector(survivalRank, 1, repMembrSize);
+  }
 }
-char unsupervisedSplit (uint    treeID,
-                        Node   *parent,
-                        uint   *repMembrIndx,
-                        uint    repMembrSize,
-                        uint   *allMembrIndx,
-                        uint    allMembrSize,
-                        uint   *splitParameterMax,
-                        double *splitValueMaxCont,
-                        uint   *splitValueMaxFactSize,
-                        uint  **splitValueMaxFactPtr,
-                        double *splitStatistic,
-                        char  **splitIndicator,
-                        char    multImpFlag) {
+char logRankCR (uint    treeID,
+                Node   *parent,
+                uint   *repMembrIndx,
+                uint    repMembrSize,
+                uint   *allMembrIndx,
+                uint    allMembrSize,
+                uint   *splitParameterMax,
+                double *splitValueMaxCont,
+                uint   *splitValueMaxFactSize,
+                uint  **splitValueMaxFactPtr,
+                double *splitStatistic,
+                char  **splitIndicator,
+                char    multImpFlag) {
   uint   *randomCovariateIndex;
   uint    uniformCovariateIndex;
   uint    uniformCovariateSize;
@@ -9050,8 +10269,7 @@ char unsupervisedSplit (uint    treeID,
   char deterministicSplitFlag;
   char preliminaryResult, result;
   double delta, deltaMax;
-  uint   deltaNorm;
-  uint i, j, k, p, r;
+  uint j, k, m;
   localSplitIndicator    = NULL;  
   mwcpSizeAbsolute       = 0;     
   *splitParameterMax     = 0;
@@ -9068,11 +10286,8 @@ char unsupervisedSplit (uint    treeID,
                                         & splitVector,
                                         & parent -> mean,
                                         multImpFlag,
-                                        TRUE);
+                                        FALSE);
   if (preliminaryResult) {
-    char   *impurity   = cvector(1, RF_randomResponseCount);
-    double *mean       = dvector(1, RF_randomResponseCount);
-    double *variance   = dvector(1, RF_randomResponseCount);
     stackSplitIndicator(repMembrSize, & localSplitIndicator);
     stackRandomCovariates(treeID,
                           parent,
@@ -9086,24 +10301,45 @@ char unsupervisedSplit (uint    treeID,
                           & density,
                           & densitySize,
                           & densitySwap);
-    uint  **parentClassProp = (uint **) new_vvector(1, RF_randomResponseCount, NRUTIL_UPTR);
-    uint  **leftClassProp   = (uint **) new_vvector(1, RF_randomResponseCount, NRUTIL_UPTR);
-    uint  **rghtClassProp   = (uint **) new_vvector(1, RF_randomResponseCount, NRUTIL_UPTR);
-    double *sumLeft      = dvector(1, RF_randomResponseCount);
-    double *sumRght      = dvector(1, RF_randomResponseCount);
-    double *sumRghtSave  = dvector(1, RF_randomResponseCount);
-    uint *pseudoResponseClassSize = uivector(1, RF_randomResponseCount);
-    uint *pseudoResponse = uivector(1, RF_randomResponseCount);
-    char **secondNonMissMembrFlag = (char **) new_vvector(1, RF_randomResponseCount, NRUTIL_CPTR);
-    uint  *secondNonMissMembrSize =              uivector(1, RF_randomResponseCount);
-    uint  *secondNonMissMembrLeftSize =          uivector(1, RF_randomResponseCount);
-    uint  *secondNonMissMembrRghtSize =          uivector(1, RF_randomResponseCount);
-    char  *tempNonMissMembrFlag = 0;
-    uint  *tempNonMissMembrIndx;
-    char   mResponseFlag;
-    uint   localIndex, localSize;
-    char    nonMissImpuritySummary;
-    double sumLeftSqr, sumRghtSqr;
+    uint *localEventTimeCount, *localEventTimeIndex;
+    uint  localEventTimeSize;
+    uint *nodeParentEvent,  *nodeLeftEvent,  *nodeRightEvent;
+    uint *nodeParentAtRisk, *nodeLeftAtRisk, *nodeRightAtRisk;
+    uint **nodeParentEventCR, **nodeLeftEventCR;
+    uint **nodeParentInclusiveAtRisk, **nodeLeftInclusiveAtRisk;
+    nodeParentInclusiveAtRisk = nodeLeftInclusiveAtRisk = NULL;  
+    nodeParentEventCR = nodeLeftEventCR = NULL;  
+    double deltaNum, deltaSubNum, deltaDen, deltaSubDen;
+    uint   tIndx;
+    uint   q, s, r;
+    if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
+      stackAndGetSplitSurv(treeID,
+                           repMembrIndx,
+                           repMembrSize,
+                           nonMissMembrIndxStatic,
+                           nonMissMembrSizeStatic,
+                           & localEventTimeCount,
+                           & localEventTimeIndex,
+                           & localEventTimeSize,
+                           & nodeParentEvent,
+                           & nodeParentAtRisk,
+                           & nodeLeftEvent,
+                           & nodeLeftAtRisk,
+                           & nodeRightEvent,
+                           & nodeRightAtRisk);
+      nodeParentEventCR = uimatrix(1, RF_eventTypeSize, 1, localEventTimeSize);
+      nodeLeftEventCR = uimatrix(1, RF_eventTypeSize, 1, localEventTimeSize);
+      switch(RF_splitRule) {
+      case SURV_CR_LAU:
+        nodeParentInclusiveAtRisk = uimatrix(1, RF_eventTypeSize, 1, localEventTimeSize);
+        nodeLeftInclusiveAtRisk = uimatrix(1, RF_eventTypeSize, 1, localEventTimeSize);
+        break;
+      case SURV_CR_LOG:
+        break;
+      default:
+        break;
+      }
+    }
     uint actualCovariateCount = 0;
     uint candidateCovariateCount = 0;
     while (selectRandomCovariates(treeID,
@@ -9130,144 +10366,102 @@ char unsupervisedSplit (uint    treeID,
                                   & nonMissMembrSize,
                                   & nonMissMembrIndx,
                                   multImpFlag)) {
-      uint *pseudoResponseIndex = uivector(1, RF_xSize);
-      for (i = 1; i <= RF_xSize; i++) {
-        pseudoResponseIndex[i] = i;
-      }
-      pseudoResponseIndex[covariate] = pseudoResponseIndex[RF_xSize];
-      localSize = RF_xSize - 1;
-      for (r = 1; r <= RF_randomResponseCount; r++) {
-        pseudoResponse[r] = sampleUniformlyFromVector(treeID, pseudoResponseIndex, RF_xSize, & localIndex);
-        pseudoResponseIndex[localIndex] = pseudoResponseIndex[localSize];
-        localSize --;
-      }
-      free_uivector(pseudoResponseIndex, 1, RF_xSize);
-      if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
-        tempNonMissMembrFlag = cvector(1, nonMissMembrSize);
-        tempNonMissMembrIndx = uivector(1, nonMissMembrSize);
-        for (k = 1; k <= nonMissMembrSize; k++) {
-          tempNonMissMembrFlag[k] = TRUE;
-          tempNonMissMembrIndx[k] = k;
-        }
-        for (r = 1; r <= RF_randomResponseCount; r++) {
-          secondNonMissMembrFlag[r] = tempNonMissMembrFlag;
-          secondNonMissMembrSize[r] = nonMissMembrSize;
+      splitLength = stackAndConstructSplitVector(treeID,
+                                                 repMembrSize,
+                                                 covariate,
+                                                 splitVector,
+                                                 splitVectorSize,
+                                                 & factorFlag,
+                                                 & deterministicSplitFlag,
+                                                 & mwcpSizeAbsolute,
+                                                 & splitVectorPtr);
+      if (!((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP)))) {
+        stackAndGetSplitSurv(treeID,
+                             repMembrIndx,
+                             repMembrSize,
+                             nonMissMembrIndx,
+                             nonMissMembrSize,
+                             & localEventTimeCount,
+                             & localEventTimeIndex,
+                             & localEventTimeSize,
+                             & nodeParentEvent,
+                             & nodeParentAtRisk,
+                             & nodeLeftEvent,
+                             & nodeLeftAtRisk,
+                             & nodeRightEvent,
+                             & nodeRightAtRisk);
+        if (localEventTimeSize > 0) {
+          nodeParentEventCR = uimatrix(1, RF_eventTypeSize, 1, localEventTimeSize);
+          nodeLeftEventCR = uimatrix(1, RF_eventTypeSize, 1, localEventTimeSize);
         }
-        nonMissImpuritySummary = FALSE;
-        for (r = 1; r <= RF_randomResponseCount; r++)  {
-          impurity[r] = getVariance(repMembrSize,
-                                    repMembrIndx,
-                                    secondNonMissMembrSize[r],
-                                    tempNonMissMembrIndx,
-                                    RF_observation[treeID][pseudoResponse[r]],
-                                    &mean[r],
-                                    &variance[r]);
-          nonMissImpuritySummary = nonMissImpuritySummary | impurity[r];
-          secondNonMissMembrLeftSize[r] = secondNonMissMembrRghtSize[r] = 0;
+        switch(RF_splitRule) {
+        case SURV_CR_LAU:
+          if (localEventTimeSize > 0) {
+            nodeParentInclusiveAtRisk = uimatrix(1, RF_eventTypeSize, 1, localEventTimeSize);
+            nodeLeftInclusiveAtRisk = uimatrix(1, RF_eventTypeSize, 1, localEventTimeSize);
+          }
+          break;
+        case SURV_CR_LOG:
+          break;
+        default:
+          break;
         }
-        free_uivector(tempNonMissMembrIndx, 1, nonMissMembrSize);
       }
-      else {
-        tempNonMissMembrIndx = uivector(1, nonMissMembrSize);
-        nonMissImpuritySummary = FALSE;
-        for (r = 1; r <= RF_randomResponseCount; r++)  {
-          secondNonMissMembrFlag[r] = cvector(1, nonMissMembrSize);
-          j = 0;
-          for (k = 1; k <= nonMissMembrSize; k++) {
-            mResponseFlag = FALSE;
-            if (RF_mRecordMap[ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] > 0) {
-              if (RF_mpSign[pseudoResponse[r]][RF_mRecordMap[ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]] == 1) {
-                mResponseFlag = TRUE;
-              }
-            }
-            if (!mResponseFlag) {
-              j ++;
-              tempNonMissMembrIndx[j] = nonMissMembrIndx[indxx[k]];
-              secondNonMissMembrFlag[r][k] = TRUE;
-            }
-            else {
-              secondNonMissMembrFlag[r][k] = FALSE;
-            }
-          }  
-          secondNonMissMembrSize[r] = j;
-          impurity[r] = getVariance(repMembrSize,
-                                    repMembrIndx,
-                                    secondNonMissMembrSize[r],
-                                    tempNonMissMembrIndx,
-                                    RF_observation[treeID][pseudoResponse[r]],
-                                    &mean[r],
-                                    &variance[r]);
-          nonMissImpuritySummary = nonMissImpuritySummary | impurity[r];
-          secondNonMissMembrLeftSize[r] = secondNonMissMembrRghtSize[r] = 0;
-        }  
-        free_uivector(tempNonMissMembrIndx, 1, nonMissMembrSize);
-      }  
-      if (nonMissImpuritySummary) {
+      if (localEventTimeSize > 0) {
         for (j = 1; j <= repMembrSize; j++) {
           localSplitIndicator[j] = NEITHER;
         }
-        for (r = 1; r <= RF_randomResponseCount; r++) {
-          pseudoResponseClassSize[r] = 0;
-          parentClassProp[r] = leftClassProp[r] = rghtClassProp[r] = NULL;
-          sumLeft[r] = sumRght[r] = sumRghtSave[r] = 0.0;
+        leftSize = 0;
+        priorMembrIter = 0;
+        for (m=1; m <= localEventTimeSize; m++) {
+          for (q = 1; q <= RF_eventTypeSize; q++) {
+            nodeParentEventCR[q][m] = 0;
+          }
         }
-        for (r = 1; r <= RF_randomResponseCount; r++) {
-          if (impurity[r]) {
-            if ((strcmp(RF_xType[pseudoResponse[r]], "C") == 0) ||
-                (strcmp(RF_xType[pseudoResponse[r]], "I") == 0)) {
-              pseudoResponseClassSize[r] = RF_xFactorSize[RF_xFactorMap[pseudoResponse[r]]];
-              parentClassProp[r] = uivector(1, pseudoResponseClassSize[r]);
-              leftClassProp[r]   = uivector(1, pseudoResponseClassSize[r]);
-              rghtClassProp[r]   = uivector(1, pseudoResponseClassSize[r]);
-              for (p = 1; p <= pseudoResponseClassSize[r]; p++) {
-                parentClassProp[r][p] = 0;
+        for (k = 1; k <= nonMissMembrSize; k++) {
+          if (RF_status[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] > 0) {
+            tIndx = 0;  
+            for (m = 1; m <= localEventTimeSize; m++) {
+              if (localEventTimeIndex[m] <= RF_masterTimeIndex[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]) {
+                tIndx = m;
               }
-              for (j = 1; j <= nonMissMembrSize; j++) {
-                if (secondNonMissMembrFlag[r][j] == TRUE) {
-                  parentClassProp[r][ (uint) RF_observation[treeID][pseudoResponse[r]][ repMembrIndx[nonMissMembrIndx[indxx[j]]] ]] ++;
-                }
+              else {
+                m = localEventTimeSize;
               }
             }
-            else {
-              sumRghtSave[r] = 0.0;
-              for (j = 1; j <= nonMissMembrSize; j++) {
-                if (secondNonMissMembrFlag[r][j] == TRUE) {
-                  sumRghtSave[r] += RF_observation[treeID][pseudoResponse[r]][ repMembrIndx[nonMissMembrIndx[indxx[j]]] ] - mean[r];
+            nodeParentEventCR[RF_eventTypeIndex[(uint) RF_status[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]]][tIndx] ++;
+          }
+        }
+        switch(RF_splitRule) {
+        case SURV_CR_LAU:
+          for (m = 1; m <= localEventTimeSize; m++) {
+            for (q = 1; q <= RF_eventTypeSize; q++) {
+              if (RF_crWeight[q] > 0) {
+                nodeParentInclusiveAtRisk[q][m] = nodeParentAtRisk[m];
+                for (s = 1; s < m; s++) {
+                  for (r = 1; r <= RF_eventTypeSize; r++) {
+                    if (q != r) {
+                      nodeParentInclusiveAtRisk[q][m]  += nodeParentEventCR[r][s];
+                    }
+                  }
                 }
               }
             }
-          }  
-        }  
-        leftSize = 0;
-        priorMembrIter = 0;
-        splitLength = stackAndConstructSplitVector(treeID,
-                                                   repMembrSize,
-                                                   covariate,
-                                                   splitVector,
-                                                   splitVectorSize,
-                                                   & factorFlag,
-                                                   & deterministicSplitFlag,
-                                                   & mwcpSizeAbsolute,
-                                                   & splitVectorPtr);
+          }
+          break;
+        case SURV_CR_LOG:
+          break;
+        default:
+          break;
+        }
         if (factorFlag == FALSE) {
           for (j = 1; j <= nonMissMembrSize; j++) {
             localSplitIndicator[ nonMissMembrIndx[indxx[j]] ] = RIGHT;
           }
-          for (r = 1; r <= RF_randomResponseCount; r++) {
-            if (impurity[r]) {
-              if ((strcmp(RF_xType[pseudoResponse[r]], "C") == 0) ||
-                  (strcmp(RF_xType[pseudoResponse[r]], "I") == 0)) {
-                for (p = 1; p <= pseudoResponseClassSize[r]; p++) {
-                  rghtClassProp[r][p] = parentClassProp[r][p];
-                  leftClassProp[r][p] = 0;
-                }
-              }
-              else {
-                sumRght[r] = sumRghtSave[r];
-                sumLeft[r] = 0.0;
-              }
-              secondNonMissMembrLeftSize[r] = 0;
-              secondNonMissMembrRghtSize[r] = secondNonMissMembrSize[r];
+          for (m = 1; m <= localEventTimeSize; m++) {
+            nodeLeftAtRisk[m] = 0;
+            for (q = 1; q <= RF_eventTypeSize; q++) {
+              nodeLeftEventCR[q][m] = 0;
             }
           }
         }
@@ -9275,111 +10469,147 @@ char unsupervisedSplit (uint    treeID,
           if (factorFlag == TRUE) {
             priorMembrIter = 0;
             leftSize = 0;
-            for (r = 1; r <= RF_rSize; r++) {
-              secondNonMissMembrLeftSize[r] = 0;
-              secondNonMissMembrRghtSize[r] = 0;
-            }
           }
           virtuallySplitNode(treeID,
-                                factorFlag,
-                                mwcpSizeAbsolute,
-                                covariate,
-                                repMembrIndx,
-                                repMembrSize,
-                                nonMissMembrIndx,
-                                nonMissMembrSize,
-                                indxx,
-                                splitVectorPtr,
-                                j,
-                                localSplitIndicator,
-                                & leftSize,
-                                priorMembrIter,
-                                & currentMembrIter);
-          delta = 0.0;
-          deltaNorm = 0;
-          for (r = 1; r <= RF_randomResponseCount; r++) {
-            if (RF_opt & OPT_USPV_STAT) {
-              parent -> urStat[r] = pseudoResponse[r];
+                             factorFlag,
+                             mwcpSizeAbsolute,
+                             covariate,
+                             repMembrIndx,
+                             repMembrSize,
+                             nonMissMembrIndx,
+                             nonMissMembrSize,
+                             indxx,
+                             splitVectorPtr,
+                             j,
+                             localSplitIndicator,
+                             & leftSize,
+                             priorMembrIter,
+                             & currentMembrIter);
+          if (factorFlag == TRUE) {
+            for (m = 1; m <= localEventTimeSize; m++) {
+              nodeLeftAtRisk[m] = 0;
+              for (q = 1; q <= RF_eventTypeSize; q++) {
+                nodeLeftEventCR[q][m] = 0;
+              }
             }
-            if (impurity[r]) {
-              if (factorFlag == TRUE) {
-                if ((strcmp(RF_xType[pseudoResponse[r]], "C") == 0) ||
-                    (strcmp(RF_xType[pseudoResponse[r]], "I") == 0)) {
-                  for (p = 1; p <= pseudoResponseClassSize[r]; p++) {
-                    leftClassProp[r][p] = 0;
-                  }
-                  for (k = 1; k <= nonMissMembrSize; k++) {
-                    if (secondNonMissMembrFlag[r][k] == TRUE) {
-                      if (localSplitIndicator[ nonMissMembrIndx[indxx[k]] ] == LEFT) {
-                        leftClassProp[r][ (uint) RF_observation[treeID][pseudoResponse[r]][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]]  ++;
-                        secondNonMissMembrLeftSize[r] ++;
-                      }
-                      else {
-                      }
-                    }
+            for (k = 1; k <= nonMissMembrSize; k++) {
+              if (localSplitIndicator[  nonMissMembrIndx[indxx[k]]  ] == LEFT) {
+                tIndx = 0;  
+                for (m = 1; m <= localEventTimeSize; m++) {
+                  if (localEventTimeIndex[m] <= RF_masterTimeIndex[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]) {
+                    tIndx = m;
+                    nodeLeftAtRisk[tIndx] ++;
                   }
-                  for (p = 1; p <= pseudoResponseClassSize[r]; p++) {
-                    rghtClassProp[r][p] = parentClassProp[r][p] - leftClassProp[r][p];
+                  else {
+                    m = localEventTimeSize;
                   }
                 }
+                if (RF_status[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] > 0) {
+                  nodeLeftEventCR[RF_eventTypeIndex[(uint) RF_status[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]]][tIndx] ++;
+                }
+              }
+            }
+          }
+          else {
+            for (k = priorMembrIter + 1; k < currentMembrIter; k++) {
+              tIndx = 0;  
+              for (m = 1; m <= localEventTimeSize; m++) {
+                if (localEventTimeIndex[m] <= RF_masterTimeIndex[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]) {
+                  tIndx = m;
+                  nodeLeftAtRisk[tIndx] ++;
+                }
                 else {
-                  sumLeft[r] = sumRght[r] = 0.0;
-                  for (k = 1; k <= nonMissMembrSize; k++) {
-                    if (secondNonMissMembrFlag[r][k] == TRUE) {
-                      if (localSplitIndicator[ nonMissMembrIndx[indxx[k]] ] == LEFT) {
-                        sumLeft[r] += RF_observation[treeID][pseudoResponse[r]][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] - mean[r];
-                        secondNonMissMembrLeftSize[r] ++;
-                      }
-                      else {
-                        sumRght[r] += RF_observation[treeID][pseudoResponse[r]][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] - mean[r];
+                  m = localEventTimeSize;
+                }
+              }
+              if (RF_status[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] > 0) {
+                nodeLeftEventCR[RF_eventTypeIndex[(uint) RF_status[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]]][tIndx] ++;
+              }
+            }
+          }
+          switch(RF_splitRule) {
+          case SURV_CR_LAU:
+            for (m=1; m <= localEventTimeSize; m++) {
+              for (q = 1; q <= RF_eventTypeSize; q++) {
+                if (RF_crWeight[q] > 0) {
+                  nodeLeftInclusiveAtRisk[q][m]   = nodeLeftAtRisk[m];
+                  for (s = 1; s < m; s++) {
+                    for (r = 1; r <= RF_eventTypeSize; r++) {
+                      if (q != r) {
+                        nodeLeftInclusiveAtRisk[q][m]    += nodeLeftEventCR[r][s];
                       }
                     }
                   }
                 }
-                secondNonMissMembrRghtSize[r] = secondNonMissMembrSize[r] - secondNonMissMembrLeftSize[r];
               }
-              else {
-                for (k = priorMembrIter + 1; k < currentMembrIter; k++) {
-                  if (secondNonMissMembrFlag[r][k] == TRUE) {
-                    if ((strcmp(RF_xType[pseudoResponse[r]], "C") == 0) ||
-                        (strcmp(RF_xType[pseudoResponse[r]], "I") == 0)) {
-                      leftClassProp[r][(uint) RF_observation[treeID][pseudoResponse[r]][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]] ++;
-                      rghtClassProp[r][(uint) RF_observation[treeID][pseudoResponse[r]][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]] --;
-                    }
-                    else {
-                      sumLeft[r] += RF_observation[treeID][pseudoResponse[r]][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] - mean[r];
-                      sumRght[r] -= RF_observation[treeID][pseudoResponse[r]][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] - mean[r];
-                    }
-                    secondNonMissMembrLeftSize[r] ++;
-                    secondNonMissMembrRghtSize[r] --;
-                  }
+            }
+            break;
+          case SURV_CR_LOG:
+            break;
+          default:
+            break;
+          }
+          delta = deltaNum = deltaDen =  0.0;
+          switch(RF_splitRule) {
+          case SURV_CR_LAU:
+            for (q = 1; q <= RF_eventTypeSize; q++) {
+              if (RF_crWeight[q] > 0) {
+                deltaSubNum = 0;
+                for (m = 1; m <= localEventTimeSize; m++) {
+                  deltaSubNum = deltaSubNum + (nodeLeftEventCR[q][m] - (nodeParentEventCR[q][m] * ((double) nodeLeftInclusiveAtRisk[q][m] / nodeParentInclusiveAtRisk[q][m])));
                 }
-              }  
-              if ((secondNonMissMembrLeftSize[r] > 0) && (secondNonMissMembrRghtSize[r] > 0)) {
-                deltaNorm ++;
-                if ((strcmp(RF_xType[pseudoResponse[r]], "C") == 0) ||
-                    (strcmp(RF_xType[pseudoResponse[r]], "I") == 0)) {
-                  sumLeft[1] = sumRght[1] = 0;
-                  for (p = 1; p <= pseudoResponseClassSize[r]; p++) {
-                    sumLeft[1] += (double) upower(leftClassProp[r][p], 2);
-                    sumRght[1] += (double) upower(rghtClassProp[r][p], 2);
+                deltaNum = deltaNum + (RF_crWeight[q] * deltaSubNum);
+                deltaSubDen = 0;
+                for (m = 1; m <= localEventTimeSize; m++) {
+                  if (nodeParentAtRisk[m] >= 2) {
+                    deltaSubDen = deltaSubDen  + (
+                                                  (nodeParentEventCR[q][m] * ((double) nodeLeftInclusiveAtRisk[q][m] / nodeParentInclusiveAtRisk[q][m])) *
+                                                  (1.0 - ((double) nodeLeftInclusiveAtRisk[q][m] / nodeParentInclusiveAtRisk[q][m])) *
+                                                  ((double) (nodeParentInclusiveAtRisk[q][m] - nodeParentEventCR[q][m]) / (nodeParentInclusiveAtRisk[q][m] - 1))
+                                                  );
                   }
-                  sumLeftSqr = sumLeft[1] / secondNonMissMembrLeftSize[r];
-                  sumRghtSqr  = sumRght[1] / secondNonMissMembrRghtSize[r];
                 }
-                else {
-                  sumLeftSqr = pow (sumLeft[r], 2.0) / (secondNonMissMembrLeftSize[r] * variance[r]);
-                  sumRghtSqr = pow (sumRght[r], 2.0) / (secondNonMissMembrRghtSize[r] * variance[r]);
+                deltaDen = deltaDen + (RF_crWeight[q] * RF_crWeight[q] * deltaSubDen);
+              }
+            }
+            break;
+          case SURV_CR_LOG:
+            for (q = 1; q <= RF_eventTypeSize; q++) {
+              if (RF_crWeight[q] > 0) {
+                deltaSubNum = 0;
+                for (m=1; m <= localEventTimeSize; m++) {
+                  deltaSubNum = deltaSubNum + (nodeLeftEventCR[q][m] - (nodeParentEventCR[q][m] * ((double) nodeLeftAtRisk[m] / nodeParentAtRisk[m])));
                 }
-                delta += sumLeftSqr + sumRghtSqr;
+                deltaNum = deltaNum + (RF_crWeight[q] * deltaSubNum);
+                deltaSubDen = 0;
+                for (m = 1; m <= localEventTimeSize; m++) {
+                  if (nodeParentAtRisk[m] >= 2) {
+                    deltaSubDen = deltaSubDen  + (
+                                                  (nodeParentEventCR[q][m] * ((double) nodeLeftAtRisk[m] / nodeParentAtRisk[m])) *
+                                                  (1.0 - ((double) nodeLeftAtRisk[m] / nodeParentAtRisk[m])) *
+                                                  ((double) (nodeParentAtRisk[m] - nodeParentEventCR[q][m]) / (nodeParentAtRisk[m] - 1))
+                                                  );
+                  }
+                }
+                deltaDen = deltaDen + (RF_crWeight[q] * RF_crWeight[q] * deltaSubDen);
               }
-            }  
-          }  
-          if (deltaNorm > 0) {
-            delta = delta / (double) deltaNorm;
+            }
+            break;
+          default:
+            break;
+          }
+          deltaNum = fabs(deltaNum);
+          deltaDen = sqrt(deltaDen);
+          if (deltaDen <= EPSILON) {
+            if (deltaNum <= EPSILON) {
+              delta = 0.0;
+            }
+            else {
+              delta = deltaNum / deltaDen;
+            }
           }
           else {
-            delta = NA_REAL;
+            delta = deltaNum / deltaDen;
           }
           updateMaximumSplit(treeID,
                              parent,
@@ -9402,26 +10632,16 @@ char unsupervisedSplit (uint    treeID,
             priorMembrIter = currentMembrIter - 1;
           }
         }  
-        unstackSplitVector(treeID,
-                           splitVectorSize,
-                           splitLength,
-                           factorFlag,
-                           deterministicSplitFlag,
-                           mwcpSizeAbsolute,
-                           splitVectorPtr);
-        for (r = 1; r <= RF_randomResponseCount; r++) {
-          if (impurity[r]) {
-            if ((strcmp(RF_xType[pseudoResponse[r]], "C") == 0) ||
-                (strcmp(RF_xType[pseudoResponse[r]], "I") == 0)) {
-              free_uivector (parentClassProp[r], 1, pseudoResponseClassSize[r]);
-              free_uivector (leftClassProp[r],   1, pseudoResponseClassSize[r]);
-              free_uivector (rghtClassProp[r],   1, pseudoResponseClassSize[r]);
-            }
-            else {
-            }
-          }
-        }
       }  
+      else {
+      }
+      unstackSplitVector(treeID,
+                         splitVectorSize,
+                         splitLength,
+                         factorFlag,
+                         deterministicSplitFlag,
+                         mwcpSizeAbsolute,
+                         splitVectorPtr);
       unselectRandomCovariates(treeID,
                                parent,
                                repMembrSize,
@@ -9429,27 +10649,58 @@ char unsupervisedSplit (uint    treeID,
                                nonMissMembrSizeStatic,
                                nonMissMembrIndx,
                                multImpFlag);
-      if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
-        free_cvector(tempNonMissMembrFlag, 1, nonMissMembrSize);
-      }
-      else {
-        for (r = 1; r <= RF_randomResponseCount; r++)  {
-          free_cvector(secondNonMissMembrFlag[r], 1, nonMissMembrSize);
+      if (!((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP)))) {
+        unstackSplitSurv(localEventTimeCount,
+                         localEventTimeIndex,
+                         localEventTimeSize,
+                         nodeParentEvent,
+                         nodeParentAtRisk,
+                         nodeLeftEvent,
+                         nodeLeftAtRisk,
+                         nodeRightEvent,
+                         nodeRightAtRisk);
+        if (localEventTimeSize > 0) {
+          free_uimatrix(nodeParentEventCR, 1, RF_eventTypeSize, 1, localEventTimeSize);
+          free_uimatrix(nodeLeftEventCR, 1, RF_eventTypeSize, 1, localEventTimeSize);
+        }
+        switch(RF_splitRule) {
+        case SURV_CR_LAU:
+          if (localEventTimeSize > 0) {
+            free_uimatrix(nodeParentInclusiveAtRisk, 1, RF_eventTypeSize, 1, localEventTimeSize);
+            free_uimatrix(nodeLeftInclusiveAtRisk, 1, RF_eventTypeSize, 1, localEventTimeSize);
+          }
+          break;
+        case SURV_CR_LOG:
+          break;
+        default:
+          break;
         }
       }
     }  
-    free_new_vvector(parentClassProp, 1, RF_randomResponseCount, NRUTIL_UPTR);
-    free_new_vvector(leftClassProp,   1, RF_randomResponseCount, NRUTIL_UPTR);
-    free_new_vvector(rghtClassProp,   1, RF_randomResponseCount, NRUTIL_UPTR);
-    free_dvector(sumLeft,     1, RF_randomResponseCount);
-    free_dvector(sumRght,     1, RF_randomResponseCount);
-    free_dvector(sumRghtSave, 1, RF_randomResponseCount);
-    free_uivector(pseudoResponseClassSize, 1, RF_randomResponseCount);
-    free_uivector(pseudoResponse, 1, RF_randomResponseCount);
-    free_new_vvector(secondNonMissMembrFlag,  1, RF_randomResponseCount, NRUTIL_CPTR);
-    free_uivector(secondNonMissMembrSize,     1, RF_randomResponseCount);
-    free_uivector(secondNonMissMembrLeftSize, 1, RF_randomResponseCount);
-    free_uivector(secondNonMissMembrRghtSize, 1, RF_randomResponseCount);
+    if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
+        unstackSplitSurv(localEventTimeCount,
+                         localEventTimeIndex,
+                         localEventTimeSize,
+                         nodeParentEvent,
+                         nodeParentAtRisk,
+                         nodeLeftEvent,
+                         nodeLeftAtRisk,
+                         nodeRightEvent,
+                         nodeRightAtRisk);
+      free_uimatrix(nodeParentEventCR, 1, RF_eventTypeSize, 1, localEventTimeSize);
+      free_uimatrix(nodeLeftEventCR, 1, RF_eventTypeSize, 1, localEventTimeSize);
+      switch(RF_splitRule) {
+      case SURV_CR_LAU:
+        free_uimatrix(nodeParentInclusiveAtRisk, 1, RF_eventTypeSize, 1, localEventTimeSize);
+        free_uimatrix(nodeLeftInclusiveAtRisk, 1, RF_eventTypeSize, 1, localEventTimeSize);
+        break;
+      case SURV_CR_LOG:
+        break;
+      default:
+        break;
+      }
+    }
+    unstackSplitIndicator(repMembrSize, localSplitIndicator);
     unstackRandomCovariates(treeID,
                             parent,
                             randomCovariateIndex,
@@ -9461,14 +10712,10 @@ char unsupervisedSplit (uint    treeID,
                             densitySize,
                             densitySwap,
                             repMembrSize);
-    unstackSplitIndicator(repMembrSize, localSplitIndicator);
-    free_cvector(impurity,   1, RF_randomResponseCount);
-    free_dvector(mean,     1, RF_randomResponseCount);
-    free_dvector(variance, 1, RF_randomResponseCount);
   }  
   unstackPreSplit(preliminaryResult,
                   multImpFlag,
-                  TRUE,  
+                  FALSE,  
                   repMembrSize,
                   splitVector,
                   nonMissMembrIndxStatic);
@@ -9476,11 +10723,42 @@ char unsupervisedSplit (uint    treeID,
                                 *splitValueMaxCont,
                                 *splitValueMaxFactSize,
                                 *splitValueMaxFactPtr,
-                                 splitStatistic,
-                                 deltaMax);
+                                splitStatistic,
+                                deltaMax);
   return result;
 }
-char multivariateSplit (uint    treeID,
+void getMemberCountOnly(uint treeID) {
+  Terminal *parent;
+  uint leaf, i;
+  uint *membershipIndex;
+  uint  membershipSize;
+  if ((RF_opt & OPT_BOOT_NODE) | (RF_opt & OPT_BOOT_NONE)) {
+    membershipIndex = RF_identityMembershipIndex;
+    membershipSize  = RF_observationSize;
+  }
+  else {
+    membershipIndex = RF_bootMembershipIndex[treeID];
+    membershipSize = RF_bootstrapSize;
+  }
+  for (leaf = 1; leaf <= RF_tLeafCount[treeID]; leaf++) {
+    parent = RF_tTermList[treeID][leaf];
+    parent -> membrCount = 0;
+    for (i = 1; i <= membershipSize; i++) {
+      if (RF_tTermMembership[treeID][membershipIndex[i]] == parent) {
+        parent -> membrCount ++;
+      }
+    }
+    if (parent -> membrCount == 0) {
+      if (!(RF_opt & OPT_OUTC_TYPE)) {
+        Rprintf("\nRF-SRC:  *** ERROR *** ");
+        Rprintf("\nRF-SRC:  Zero node count encountered in getMemberCountOnly() in (tree, leaf) = (%10d, %10d)  \n", treeID, parent -> nodeID);
+        Rprintf("\nRF-SRC:  Please Contact Technical Support.");
+        error("\nRF-SRC:  The application will now exit.\n");
+      }
+    }
+  }  
+}
+char unsupervisedSplit (uint    treeID,
                         Node   *parent,
                         uint   *repMembrIndx,
                         uint    repMembrSize,
@@ -9519,7 +10797,7 @@ char multivariateSplit (uint    treeID,
   char preliminaryResult, result;
   double delta, deltaMax;
   uint   deltaNorm;
-  uint j, k, p, r;
+  uint i, j, k, p, r;
   localSplitIndicator    = NULL;  
   mwcpSizeAbsolute       = 0;     
   *splitParameterMax     = 0;
@@ -9538,386 +10816,401 @@ char multivariateSplit (uint    treeID,
                                         multImpFlag,
                                         TRUE);
   if (preliminaryResult) {
-    char   *impurity   = cvector(1, RF_rSize);
-    double *mean       = dvector(1, RF_rSize);
-    double *variance   = dvector(1, RF_rSize);
-    char impuritySummary;
-    if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
-      impuritySummary = FALSE;
-      for (r = 1; r <= RF_rSize; r++)  {
-        impurity[r] = getVariance(repMembrSize,
+    char   *impurity   = cvector(1, RF_randomResponseCount);
+    double *mean       = dvector(1, RF_randomResponseCount);
+    double *variance   = dvector(1, RF_randomResponseCount);
+    stackSplitIndicator(repMembrSize, & localSplitIndicator);
+    stackRandomCovariates(treeID,
+                          parent,
+                          repMembrSize,
+                          multImpFlag,
+                          & randomCovariateIndex,
+                          & uniformCovariateSize,
+                          & cdf,
+                          & cdfSize,
+                          & cdfSort,
+                          & density,
+                          & densitySize,
+                          & densitySwap);
+    uint  **parentClassProp = (uint **) new_vvector(1, RF_randomResponseCount, NRUTIL_UPTR);
+    uint  **leftClassProp   = (uint **) new_vvector(1, RF_randomResponseCount, NRUTIL_UPTR);
+    uint  **rghtClassProp   = (uint **) new_vvector(1, RF_randomResponseCount, NRUTIL_UPTR);
+    double *sumLeft      = dvector(1, RF_randomResponseCount);
+    double *sumRght      = dvector(1, RF_randomResponseCount);
+    double *sumRghtSave  = dvector(1, RF_randomResponseCount);
+    uint *pseudoResponseClassSize = uivector(1, RF_randomResponseCount);
+    uint *pseudoResponse = uivector(1, RF_randomResponseCount);
+    char **secondNonMissMembrFlag = (char **) new_vvector(1, RF_randomResponseCount, NRUTIL_CPTR);
+    uint  *secondNonMissMembrSize =              uivector(1, RF_randomResponseCount);
+    uint  *secondNonMissMembrLeftSize =          uivector(1, RF_randomResponseCount);
+    uint  *secondNonMissMembrRghtSize =          uivector(1, RF_randomResponseCount);
+    char  *tempNonMissMembrFlag = 0;
+    uint  *tempNonMissMembrIndx;
+    char   mResponseFlag;
+    uint   localIndex, localSize;
+    char    nonMissImpuritySummary;
+    double sumLeftSqr, sumRghtSqr;
+    uint actualCovariateCount = 0;
+    uint candidateCovariateCount = 0;
+    while (selectRandomCovariates(treeID,
+                                  parent,
                                   repMembrIndx,
-                                  0,
-                                  NULL,
-                                  RF_response[treeID][r],
-                                  &mean[r],
-                                  &variance[r]);
-        impuritySummary = impuritySummary | impurity[r];
+                                  repMembrSize,
+                                  randomCovariateIndex,
+                                  & uniformCovariateSize,
+                                  & uniformCovariateIndex,
+                                  cdf,
+                                  & cdfSize,
+                                  cdfSort,
+                                  density,
+                                  & densitySize,
+                                  densitySwap,
+                                  & covariate,
+                                  & actualCovariateCount,
+                                  & candidateCovariateCount,
+                                  splitVector,
+                                  & splitVectorSize,
+                                  & indxx,
+                                  nonMissMembrSizeStatic,
+                                  nonMissMembrIndxStatic,
+                                  & nonMissMembrSize,
+                                  & nonMissMembrIndx,
+                                  multImpFlag)) {
+      uint *pseudoResponseIndex = uivector(1, RF_xSize);
+      for (i = 1; i <= RF_xSize; i++) {
+        pseudoResponseIndex[i] = i;
       }
-    }
-    else {
-      impuritySummary = TRUE;
-    }
-    if (impuritySummary) {
-      stackSplitIndicator(repMembrSize, & localSplitIndicator);
-      stackRandomCovariates(treeID,
-                            parent,
-                            repMembrSize,
-                            multImpFlag,
-                            & randomCovariateIndex,
-                            & uniformCovariateSize,
-                            & cdf,
-                            & cdfSize,
-                            & cdfSort,
-                            & density,
-                            & densitySize,
-                            & densitySwap);
-      uint **parentClassProp = (uint **) new_vvector(1, RF_rSize, NRUTIL_UPTR);
-      uint **leftClassProp   = (uint **) new_vvector(1, RF_rSize, NRUTIL_UPTR);
-      uint **rghtClassProp   = (uint **) new_vvector(1, RF_rSize, NRUTIL_UPTR);
-      double *sumLeft         = dvector(1, RF_rSize);
-      double *sumRght         = dvector(1, RF_rSize);
-      double *sumRghtSave     = dvector(1, RF_rSize);
-      char **secondNonMissMembrFlag = (char **) new_vvector(1, RF_rSize, NRUTIL_CPTR);
-      uint  *secondNonMissMembrSize =           uivector(1, RF_rSize);
-      uint  *secondNonMissMembrLeftSize =       uivector(1, RF_rSize);
-      uint  *secondNonMissMembrRghtSize =       uivector(1, RF_rSize);
-      for (r = 1; r <= RF_rSize; r++) {
-        parentClassProp[r] = leftClassProp[r] = rghtClassProp[r] = NULL;
-        if ((strcmp(RF_rType[r], "C") == 0) ||
-            (strcmp(RF_rType[r], "I") == 0)) {
-          parentClassProp[r] = uivector(1, RF_classLevelSize[RF_rFactorMap[r]]);
-          leftClassProp[r]   = uivector(1, RF_classLevelSize[RF_rFactorMap[r]]);
-          rghtClassProp[r]   = uivector(1, RF_classLevelSize[RF_rFactorMap[r]]);
+      pseudoResponseIndex[covariate] = pseudoResponseIndex[RF_xSize];
+      localSize = RF_xSize - 1;
+      for (r = 1; r <= RF_randomResponseCount; r++) {
+        pseudoResponse[r] = sampleUniformlyFromVector(treeID, pseudoResponseIndex, RF_xSize, & localIndex);
+        pseudoResponseIndex[localIndex] = pseudoResponseIndex[localSize];
+        localSize --;
+      }
+      free_uivector(pseudoResponseIndex, 1, RF_xSize);
+      if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
+        tempNonMissMembrFlag = cvector(1, nonMissMembrSize);
+        tempNonMissMembrIndx = uivector(1, nonMissMembrSize);
+        for (k = 1; k <= nonMissMembrSize; k++) {
+          tempNonMissMembrFlag[k] = TRUE;
+          tempNonMissMembrIndx[k] = k;
         }
-        else {
+        for (r = 1; r <= RF_randomResponseCount; r++) {
+          secondNonMissMembrFlag[r] = tempNonMissMembrFlag;
+          secondNonMissMembrSize[r] = nonMissMembrSize;
         }
-      }  
-      char  *tempNonMissMembrFlag = 0;
-      uint  *tempNonMissMembrIndx;
-      char   mResponseFlag;
-      char   nonMissImpuritySummary;
-      double partialLeft, partialRght;
-      uint actualCovariateCount = 0;
-      uint candidateCovariateCount = 0;
-      while (selectRandomCovariates(treeID,
-                                    parent,
+        nonMissImpuritySummary = FALSE;
+        for (r = 1; r <= RF_randomResponseCount; r++)  {
+          impurity[r] = getVariance(repMembrSize,
                                     repMembrIndx,
-                                    repMembrSize,
-                                    randomCovariateIndex,
-                                    & uniformCovariateSize,
-                                    & uniformCovariateIndex,
-                                    cdf,
-                                    & cdfSize,
-                                    cdfSort,
-                                    density,
-                                    & densitySize,
-                                    densitySwap,
-                                    & covariate,
-                                    & actualCovariateCount,
-                                    & candidateCovariateCount,
-                                    splitVector,
-                                    & splitVectorSize,
-                                    & indxx,
-                                    nonMissMembrSizeStatic,
-                                    nonMissMembrIndxStatic,
-                                    & nonMissMembrSize,
-                                    & nonMissMembrIndx,
-                                    multImpFlag)) {
-        if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
-          tempNonMissMembrFlag = cvector(1, nonMissMembrSize);
+                                    secondNonMissMembrSize[r],
+                                    tempNonMissMembrIndx,
+                                    RF_observation[treeID][pseudoResponse[r]],
+                                    &mean[r],
+                                    &variance[r]);
+          nonMissImpuritySummary = nonMissImpuritySummary | impurity[r];
+          secondNonMissMembrLeftSize[r] = secondNonMissMembrRghtSize[r] = 0;
+        }
+        free_uivector(tempNonMissMembrIndx, 1, nonMissMembrSize);
+      }
+      else {
+        tempNonMissMembrIndx = uivector(1, nonMissMembrSize);
+        nonMissImpuritySummary = FALSE;
+        for (r = 1; r <= RF_randomResponseCount; r++)  {
+          secondNonMissMembrFlag[r] = cvector(1, nonMissMembrSize);
+          j = 0;
           for (k = 1; k <= nonMissMembrSize; k++) {
-            tempNonMissMembrFlag[k] = TRUE;
-          }
-          for (r = 1; r <= RF_rSize; r++) {
-              secondNonMissMembrFlag[r] = tempNonMissMembrFlag;
-              secondNonMissMembrSize[r] = nonMissMembrSize;
-          }
-          nonMissImpuritySummary = TRUE;
+            mResponseFlag = FALSE;
+            if (RF_mRecordMap[ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] > 0) {
+              if (RF_mpSign[pseudoResponse[r]][RF_mRecordMap[ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]] == 1) {
+                mResponseFlag = TRUE;
+              }
+            }
+            if (!mResponseFlag) {
+              j ++;
+              tempNonMissMembrIndx[j] = nonMissMembrIndx[indxx[k]];
+              secondNonMissMembrFlag[r][k] = TRUE;
+            }
+            else {
+              secondNonMissMembrFlag[r][k] = FALSE;
+            }
+          }  
+          secondNonMissMembrSize[r] = j;
+          impurity[r] = getVariance(repMembrSize,
+                                    repMembrIndx,
+                                    secondNonMissMembrSize[r],
+                                    tempNonMissMembrIndx,
+                                    RF_observation[treeID][pseudoResponse[r]],
+                                    &mean[r],
+                                    &variance[r]);
+          nonMissImpuritySummary = nonMissImpuritySummary | impurity[r];
+          secondNonMissMembrLeftSize[r] = secondNonMissMembrRghtSize[r] = 0;
+        }  
+        free_uivector(tempNonMissMembrIndx, 1, nonMissMembrSize);
+      }  
+      if (nonMissImpuritySummary) {
+        for (j = 1; j <= repMembrSize; j++) {
+          localSplitIndicator[j] = NEITHER;
         }
-        else {
-          tempNonMissMembrIndx = uivector(1, nonMissMembrSize);
-          nonMissImpuritySummary = FALSE;
-          for (r = 1; r <= RF_rSize; r++)  {
-            secondNonMissMembrFlag[r] = cvector(1, nonMissMembrSize);
-            j = 0;
-            for (k = 1; k <= nonMissMembrSize; k++) {
-              mResponseFlag = FALSE;
-              if (RF_mRecordMap[ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] > 0) {
-                if (RF_mpSign[r][RF_mRecordMap[ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]] == 1) {
-                  mResponseFlag = TRUE;
-                }
+        for (r = 1; r <= RF_randomResponseCount; r++) {
+          pseudoResponseClassSize[r] = 0;
+          parentClassProp[r] = leftClassProp[r] = rghtClassProp[r] = NULL;
+          sumLeft[r] = sumRght[r] = sumRghtSave[r] = 0.0;
+        }
+        for (r = 1; r <= RF_randomResponseCount; r++) {
+          if (impurity[r]) {
+            if ((strcmp(RF_xType[pseudoResponse[r]], "C") == 0) ||
+                (strcmp(RF_xType[pseudoResponse[r]], "I") == 0)) {
+              pseudoResponseClassSize[r] = RF_xFactorSize[RF_xFactorMap[pseudoResponse[r]]];
+              parentClassProp[r] = uivector(1, pseudoResponseClassSize[r]);
+              leftClassProp[r]   = uivector(1, pseudoResponseClassSize[r]);
+              rghtClassProp[r]   = uivector(1, pseudoResponseClassSize[r]);
+              for (p = 1; p <= pseudoResponseClassSize[r]; p++) {
+                parentClassProp[r][p] = 0;
               }
-              if (!mResponseFlag) {
-                j ++;
-                tempNonMissMembrIndx[j] = nonMissMembrIndx[indxx[k]];
-                secondNonMissMembrFlag[r][k] = TRUE;
+              for (j = 1; j <= nonMissMembrSize; j++) {
+                if (secondNonMissMembrFlag[r][j] == TRUE) {
+                  parentClassProp[r][ (uint) RF_observation[treeID][pseudoResponse[r]][ repMembrIndx[nonMissMembrIndx[indxx[j]]] ]] ++;
+                }
               }
-              else {
-                secondNonMissMembrFlag[r][k] = FALSE;
+            }
+            else {
+              sumRghtSave[r] = 0.0;
+              for (j = 1; j <= nonMissMembrSize; j++) {
+                if (secondNonMissMembrFlag[r][j] == TRUE) {
+                  sumRghtSave[r] += RF_observation[treeID][pseudoResponse[r]][ repMembrIndx[nonMissMembrIndx[indxx[j]]] ] - mean[r];
+                }
               }
-            }  
-            secondNonMissMembrSize[r] = j;
-            impurity[r] = getVariance(repMembrSize,
-                                      repMembrIndx,
-                                      secondNonMissMembrSize[r],
-                                      tempNonMissMembrIndx,
-                                      RF_response[treeID][r],
-                                      &mean[r],
-                                      &variance[r]);
-            nonMissImpuritySummary = nonMissImpuritySummary | impurity[r];
-            secondNonMissMembrLeftSize[r] = secondNonMissMembrRghtSize[r] = 0;
+            }
           }  
-          free_uivector(tempNonMissMembrIndx, 1, nonMissMembrSize);
         }  
-        if (nonMissImpuritySummary) {
-          for (j = 1; j <= repMembrSize; j++) {
-            localSplitIndicator[j] = NEITHER;
+        leftSize = 0;
+        priorMembrIter = 0;
+        splitLength = stackAndConstructSplitVector(treeID,
+                                                   repMembrSize,
+                                                   covariate,
+                                                   splitVector,
+                                                   splitVectorSize,
+                                                   & factorFlag,
+                                                   & deterministicSplitFlag,
+                                                   & mwcpSizeAbsolute,
+                                                   & splitVectorPtr);
+        if (factorFlag == FALSE) {
+          for (j = 1; j <= nonMissMembrSize; j++) {
+            localSplitIndicator[ nonMissMembrIndx[indxx[j]] ] = RIGHT;
           }
-          for (r = 1; r <= RF_rSize; r++) {
+          for (r = 1; r <= RF_randomResponseCount; r++) {
             if (impurity[r]) {
-              if ((strcmp(RF_rType[r], "C") == 0) ||
-                  (strcmp(RF_rType[r], "I") == 0)) {
-                for (p=1; p <= RF_classLevelSize[RF_rFactorMap[r]]; p++) {
-                  parentClassProp[r][p] = 0;
-                }
-                for (j = 1; j <= nonMissMembrSize; j++) {
-                  if (secondNonMissMembrFlag[r][j] == TRUE) {
-                    parentClassProp[r][RF_classLevelIndex[RF_rFactorMap[r]][(uint) RF_response[treeID][r][ repMembrIndx[nonMissMembrIndx[indxx[j]]] ]]] ++;
-                  }
+              if ((strcmp(RF_xType[pseudoResponse[r]], "C") == 0) ||
+                  (strcmp(RF_xType[pseudoResponse[r]], "I") == 0)) {
+                for (p = 1; p <= pseudoResponseClassSize[r]; p++) {
+                  rghtClassProp[r][p] = parentClassProp[r][p];
+                  leftClassProp[r][p] = 0;
                 }
               }
               else {
-                sumRghtSave[r] = 0.0;
-                for (j = 1; j <= nonMissMembrSize; j++) {
-                  if (secondNonMissMembrFlag[r][j] == TRUE) {
-                    sumRghtSave[r] += RF_response[treeID][r][ repMembrIndx[nonMissMembrIndx[indxx[j]]] ] - mean[r];
-                  }
-                }
+                sumRght[r] = sumRghtSave[r];
+                sumLeft[r] = 0.0;
               }
-            }  
-          }  
-          leftSize = 0;
-          priorMembrIter = 0;
-          splitLength = stackAndConstructSplitVector(treeID,
-                                                     repMembrSize,
-                                                     covariate,
-                                                     splitVector,
-                                                     splitVectorSize,
-                                                     & factorFlag,
-                                                     & deterministicSplitFlag,
-                                                     & mwcpSizeAbsolute,
-                                                     & splitVectorPtr);
-          if (factorFlag == FALSE) {
-            for (j = 1; j <= nonMissMembrSize; j++) {
-              localSplitIndicator[ nonMissMembrIndx[indxx[j]] ] = RIGHT;
+              secondNonMissMembrLeftSize[r] = 0;
+              secondNonMissMembrRghtSize[r] = secondNonMissMembrSize[r];
             }
+          }
+        }
+        for (j = 1; j < splitLength; j++) {
+          if (factorFlag == TRUE) {
+            priorMembrIter = 0;
+            leftSize = 0;
             for (r = 1; r <= RF_rSize; r++) {
-              if (impurity[r]) {
-                if ((strcmp(RF_rType[r], "C") == 0) ||
-                    (strcmp(RF_rType[r], "I") == 0)) {
-                  for (p=1; p <= RF_classLevelSize[RF_rFactorMap[r]]; p++) {
-                    rghtClassProp[r][p] = parentClassProp[r][p];
+              secondNonMissMembrLeftSize[r] = 0;
+              secondNonMissMembrRghtSize[r] = 0;
+            }
+          }
+          virtuallySplitNode(treeID,
+                                factorFlag,
+                                mwcpSizeAbsolute,
+                                covariate,
+                                repMembrIndx,
+                                repMembrSize,
+                                nonMissMembrIndx,
+                                nonMissMembrSize,
+                                indxx,
+                                splitVectorPtr,
+                                j,
+                                localSplitIndicator,
+                                & leftSize,
+                                priorMembrIter,
+                                & currentMembrIter);
+          delta = 0.0;
+          deltaNorm = 0;
+          for (r = 1; r <= RF_randomResponseCount; r++) {
+            if (RF_opt & OPT_USPV_STAT) {
+              parent -> urStat[r] = pseudoResponse[r];
+            }
+            if (impurity[r]) {
+              if (factorFlag == TRUE) {
+                if ((strcmp(RF_xType[pseudoResponse[r]], "C") == 0) ||
+                    (strcmp(RF_xType[pseudoResponse[r]], "I") == 0)) {
+                  for (p = 1; p <= pseudoResponseClassSize[r]; p++) {
                     leftClassProp[r][p] = 0;
                   }
+                  for (k = 1; k <= nonMissMembrSize; k++) {
+                    if (secondNonMissMembrFlag[r][k] == TRUE) {
+                      if (localSplitIndicator[ nonMissMembrIndx[indxx[k]] ] == LEFT) {
+                        leftClassProp[r][ (uint) RF_observation[treeID][pseudoResponse[r]][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]]  ++;
+                        secondNonMissMembrLeftSize[r] ++;
+                      }
+                      else {
+                      }
+                    }
+                  }
+                  for (p = 1; p <= pseudoResponseClassSize[r]; p++) {
+                    rghtClassProp[r][p] = parentClassProp[r][p] - leftClassProp[r][p];
+                  }
                 }
                 else {
-                  sumRght[r] = sumRghtSave[r];
-                  sumLeft[r] = 0.0;
-                }
-                secondNonMissMembrLeftSize[r] = 0;
-                secondNonMissMembrRghtSize[r] = secondNonMissMembrSize[r];
-              }
-            }
-          }
-          for (j = 1; j < splitLength; j++) {
-            if (factorFlag == TRUE) {
-              priorMembrIter = 0;
-              leftSize = 0;
-              for (r = 1; r <= RF_rSize; r++) {
-                secondNonMissMembrLeftSize[r] = 0;
-                secondNonMissMembrRghtSize[r] = 0;
-              }
-            }
-            virtuallySplitNode(treeID,
-                               factorFlag,
-                               mwcpSizeAbsolute,
-                               covariate,
-                               repMembrIndx,
-                               repMembrSize,
-                               nonMissMembrIndx,
-                               nonMissMembrSize,
-                               indxx,
-                               splitVectorPtr,
-                               j,
-                               localSplitIndicator,
-                               & leftSize,
-                               priorMembrIter,
-                               & currentMembrIter);
-            delta     = 0.0;
-            deltaNorm = 0;
-            for (r = 1; r <= RF_rSize; r++) {
-              if (impurity[r]) {
-                if (factorFlag == TRUE) {
-                  if ((strcmp(RF_rType[r], "C") == 0) ||
-                      (strcmp(RF_rType[r], "I") == 0)) {
-                    for (p=1; p <= RF_classLevelSize[RF_rFactorMap[r]]; p++) {
-                      leftClassProp[r][p] = 0;
-                    }
-                    for (k = 1; k <= nonMissMembrSize; k++) {
-                      if (secondNonMissMembrFlag[r][k] == TRUE) {
-                        if (localSplitIndicator[ nonMissMembrIndx[indxx[k]] ] == LEFT) {
-                          leftClassProp[r][RF_classLevelIndex[RF_rFactorMap[r]][(uint) RF_response[treeID][r][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]]] ++;
-                          secondNonMissMembrLeftSize[r] ++;
-                        }
-                        else {
-                        }
-                      }
-                    }
-                    for (p=1; p <= RF_classLevelSize[RF_rFactorMap[r]]; p++) {
-                      rghtClassProp[r][p] = parentClassProp[r][p] - leftClassProp[r][p];
-                    }
-                  }
-                  else {
-                    sumLeft[r] = sumRght[r] = 0.0;
-                    for (k = 1; k <= nonMissMembrSize; k++) {
-                      if (secondNonMissMembrFlag[r][k] == TRUE) {
-                        if (localSplitIndicator[ nonMissMembrIndx[indxx[k]] ] == LEFT) {
-                          sumLeft[r] += RF_response[treeID][r][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] - mean[r];
-                          secondNonMissMembrLeftSize[r] ++;
-                        }
-                        else {
-                          sumRght[r] += RF_response[treeID][r][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] - mean[r];
-                        }
-                      }
-                    }
-                  }
-                  secondNonMissMembrRghtSize[r] = secondNonMissMembrSize[r] - secondNonMissMembrLeftSize[r];
-                }
-                else {
-                  for (k = priorMembrIter + 1; k < currentMembrIter; k++) {
+                  sumLeft[r] = sumRght[r] = 0.0;
+                  for (k = 1; k <= nonMissMembrSize; k++) {
                     if (secondNonMissMembrFlag[r][k] == TRUE) {
-                      if ((strcmp(RF_rType[r], "C") == 0) ||
-                          (strcmp(RF_rType[r], "I") == 0)) {
-                        leftClassProp[r][RF_classLevelIndex[RF_rFactorMap[r]][(uint) RF_response[treeID][r][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]]] ++;
-                        rghtClassProp[r][RF_classLevelIndex[RF_rFactorMap[r]][(uint) RF_response[treeID][r][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]]] --;
+                      if (localSplitIndicator[ nonMissMembrIndx[indxx[k]] ] == LEFT) {
+                        sumLeft[r] += RF_observation[treeID][pseudoResponse[r]][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] - mean[r];
+                        secondNonMissMembrLeftSize[r] ++;
                       }
                       else {
-                        sumLeft[r] += RF_response[treeID][r][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] - mean[r];
-                        sumRght[r] -= RF_response[treeID][r][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] - mean[r];
+                        sumRght[r] += RF_observation[treeID][pseudoResponse[r]][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] - mean[r];
                       }
-                      secondNonMissMembrLeftSize[r] ++;
-                      secondNonMissMembrRghtSize[r] --;
                     }
                   }
-                }  
-                if ((secondNonMissMembrLeftSize[r] > 0) && (secondNonMissMembrRghtSize[r] > 0)) {
-                  deltaNorm ++;
-                  if ((strcmp(RF_rType[r], "C") == 0) ||
-                      (strcmp(RF_rType[r], "I") == 0)) {
-                    partialLeft = partialRght = 0;
-                    for (p = 1; p <= RF_classLevelSize[RF_rFactorMap[r]]; p++) {
-                      partialLeft += (double) upower(leftClassProp[r][p], 2);
-                      partialRght += (double) upower(rghtClassProp[r][p], 2);
+                }
+                secondNonMissMembrRghtSize[r] = secondNonMissMembrSize[r] - secondNonMissMembrLeftSize[r];
+              }
+              else {
+                for (k = priorMembrIter + 1; k < currentMembrIter; k++) {
+                  if (secondNonMissMembrFlag[r][k] == TRUE) {
+                    if ((strcmp(RF_xType[pseudoResponse[r]], "C") == 0) ||
+                        (strcmp(RF_xType[pseudoResponse[r]], "I") == 0)) {
+                      leftClassProp[r][(uint) RF_observation[treeID][pseudoResponse[r]][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]] ++;
+                      rghtClassProp[r][(uint) RF_observation[treeID][pseudoResponse[r]][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]] --;
                     }
-                    partialLeft = partialLeft / secondNonMissMembrLeftSize[r];
-                    partialRght = partialRght / secondNonMissMembrRghtSize[r];
-                  }
-                  else {
-                    partialLeft = pow (sumLeft[r], 2.0) / (secondNonMissMembrLeftSize[r] * variance[r]);
-                    partialRght = pow (sumRght[r], 2.0) / (secondNonMissMembrRghtSize[r] * variance[r]);
+                    else {
+                      sumLeft[r] += RF_observation[treeID][pseudoResponse[r]][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] - mean[r];
+                      sumRght[r] -= RF_observation[treeID][pseudoResponse[r]][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] - mean[r];
+                    }
+                    secondNonMissMembrLeftSize[r] ++;
+                    secondNonMissMembrRghtSize[r] --;
                   }
-                  delta += partialLeft + partialRght;
                 }
               }  
+              if ((secondNonMissMembrLeftSize[r] > 0) && (secondNonMissMembrRghtSize[r] > 0)) {
+                deltaNorm ++;
+                if ((strcmp(RF_xType[pseudoResponse[r]], "C") == 0) ||
+                    (strcmp(RF_xType[pseudoResponse[r]], "I") == 0)) {
+                  sumLeft[1] = sumRght[1] = 0;
+                  for (p = 1; p <= pseudoResponseClassSize[r]; p++) {
+                    sumLeft[1] += (double) upower(leftClassProp[r][p], 2);
+                    sumRght[1] += (double) upower(rghtClassProp[r][p], 2);
+                  }
+                  sumLeftSqr = sumLeft[1] / secondNonMissMembrLeftSize[r];
+                  sumRghtSqr  = sumRght[1] / secondNonMissMembrRghtSize[r];
+                }
+                else {
+                  sumLeftSqr = pow (sumLeft[r], 2.0) / (secondNonMissMembrLeftSize[r] * variance[r]);
+                  sumRghtSqr = pow (sumRght[r], 2.0) / (secondNonMissMembrRghtSize[r] * variance[r]);
+                }
+                delta += sumLeftSqr + sumRghtSqr;
+              }
             }  
-            if (deltaNorm > 0) {
-              delta = delta / (double) deltaNorm;
-            }
-            else {
-              delta = NA_REAL;
-            }
-            updateMaximumSplit(treeID,
-                               parent,
-                               delta,
-                               candidateCovariateCount,
-                               covariate,
-                               j,
-                               factorFlag,
-                               mwcpSizeAbsolute,
-                               repMembrSize,
-                               localSplitIndicator,
-                               & deltaMax,
-                               splitParameterMax,
-                               splitValueMaxCont,
-                               splitValueMaxFactSize,
-                               splitValueMaxFactPtr,
-                               splitVectorPtr,
-                               splitIndicator);
-            if (factorFlag == FALSE) {
-              priorMembrIter = currentMembrIter - 1;
-            }
           }  
-          unstackSplitVector(treeID,
-                             splitVectorSize,
-                             splitLength,
+          if (deltaNorm > 0) {
+            delta = delta / (double) deltaNorm;
+          }
+          else {
+            delta = NA_REAL;
+          }
+          updateMaximumSplit(treeID,
+                             parent,
+                             delta,
+                             candidateCovariateCount,
+                             covariate,
+                             j,
                              factorFlag,
-                             deterministicSplitFlag,
                              mwcpSizeAbsolute,
-                             splitVectorPtr);
+                             repMembrSize,
+                             localSplitIndicator,
+                             & deltaMax,
+                             splitParameterMax,
+                             splitValueMaxCont,
+                             splitValueMaxFactSize,
+                             splitValueMaxFactPtr,
+                             splitVectorPtr,
+                             splitIndicator);
+          if (factorFlag == FALSE) {
+            priorMembrIter = currentMembrIter - 1;
+          }
         }  
-        unselectRandomCovariates(treeID,
-                                 parent,
-                                 repMembrSize,
-                                 indxx,
-                                 nonMissMembrSizeStatic,
-                                 nonMissMembrIndx,
-                                 multImpFlag);
-        if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
-          free_cvector(tempNonMissMembrFlag, 1, nonMissMembrSize);
-        }
-        else {
-          for (r = 1; r <= RF_rSize; r++)  {
-            free_cvector(secondNonMissMembrFlag[r], 1, nonMissMembrSize);
+        unstackSplitVector(treeID,
+                           splitVectorSize,
+                           splitLength,
+                           factorFlag,
+                           deterministicSplitFlag,
+                           mwcpSizeAbsolute,
+                           splitVectorPtr);
+        for (r = 1; r <= RF_randomResponseCount; r++) {
+          if (impurity[r]) {
+            if ((strcmp(RF_xType[pseudoResponse[r]], "C") == 0) ||
+                (strcmp(RF_xType[pseudoResponse[r]], "I") == 0)) {
+              free_uivector (parentClassProp[r], 1, pseudoResponseClassSize[r]);
+              free_uivector (leftClassProp[r],   1, pseudoResponseClassSize[r]);
+              free_uivector (rghtClassProp[r],   1, pseudoResponseClassSize[r]);
+            }
+            else {
+            }
           }
         }
       }  
-      for (r = 1; r <= RF_rSize; r++) {
-        if ((strcmp(RF_rType[r], "C") == 0) ||
-            (strcmp(RF_rType[r], "I") == 0)) {
-          free_uivector (parentClassProp[r], 1, RF_classLevelSize[RF_rFactorMap[r]]);
-          free_uivector (leftClassProp[r], 1, RF_classLevelSize[RF_rFactorMap[r]]);
-          free_uivector (rghtClassProp[r], 1, RF_classLevelSize[RF_rFactorMap[r]]);
-        }
-        else {
+      unselectRandomCovariates(treeID,
+                               parent,
+                               repMembrSize,
+                               indxx,
+                               nonMissMembrSizeStatic,
+                               nonMissMembrIndx,
+                               multImpFlag);
+      if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
+        free_cvector(tempNonMissMembrFlag, 1, nonMissMembrSize);
+      }
+      else {
+        for (r = 1; r <= RF_randomResponseCount; r++)  {
+          free_cvector(secondNonMissMembrFlag[r], 1, nonMissMembrSize);
         }
       }
-      free_new_vvector(parentClassProp, 1, RF_rSize, NRUTIL_UPTR);
-      free_new_vvector(leftClassProp,   1, RF_rSize, NRUTIL_UPTR);
-      free_new_vvector(rghtClassProp,   1, RF_rSize, NRUTIL_UPTR);
-      free_dvector(sumLeft,     1, RF_rSize);
-      free_dvector(sumRght,     1, RF_rSize);
-      free_dvector(sumRghtSave, 1, RF_rSize);
-      free_new_vvector(secondNonMissMembrFlag,  1, RF_rSize, NRUTIL_CPTR);
-      free_uivector(secondNonMissMembrSize,     1, RF_rSize);
-      free_uivector(secondNonMissMembrLeftSize, 1, RF_rSize);
-      free_uivector(secondNonMissMembrRghtSize, 1, RF_rSize);
-      unstackRandomCovariates(treeID,
-                              parent,
-                              randomCovariateIndex,
-                              uniformCovariateSize,
-                              cdf,
-                              cdfSize,
-                              cdfSort,
-                              density,
-                              densitySize,
-                              densitySwap,
-                              repMembrSize);
-      unstackSplitIndicator(repMembrSize, localSplitIndicator);
     }  
-    free_cvector(impurity,   1, RF_rSize);
-    free_dvector(mean,       1, RF_rSize);
-    free_dvector(variance,   1, RF_rSize);
+    free_new_vvector(parentClassProp, 1, RF_randomResponseCount, NRUTIL_UPTR);
+    free_new_vvector(leftClassProp,   1, RF_randomResponseCount, NRUTIL_UPTR);
+    free_new_vvector(rghtClassProp,   1, RF_randomResponseCount, NRUTIL_UPTR);
+    free_dvector(sumLeft,     1, RF_randomResponseCount);
+    free_dvector(sumRght,     1, RF_randomResponseCount);
+    free_dvector(sumRghtSave, 1, RF_randomResponseCount);
+    free_uivector(pseudoResponseClassSize, 1, RF_randomResponseCount);
+    free_uivector(pseudoResponse, 1, RF_randomResponseCount);
+    free_new_vvector(secondNonMissMembrFlag,  1, RF_randomResponseCount, NRUTIL_CPTR);
+    free_uivector(secondNonMissMembrSize,     1, RF_randomResponseCount);
+    free_uivector(secondNonMissMembrLeftSize, 1, RF_randomResponseCount);
+    free_uivector(secondNonMissMembrRghtSize, 1, RF_randomResponseCount);
+    unstackRandomCovariates(treeID,
+                            parent,
+                            randomCovariateIndex,
+                            uniformCovariateSize,
+                            cdf,
+                            cdfSize,
+                            cdfSort,
+                            density,
+                            densitySize,
+                            densitySwap,
+                            repMembrSize);
+    unstackSplitIndicator(repMembrSize, localSplitIndicator);
+    free_cvector(impurity,   1, RF_randomResponseCount);
+    free_dvector(mean,     1, RF_randomResponseCount);
+    free_dvector(variance, 1, RF_randomResponseCount);
   }  
   unstackPreSplit(preliminaryResult,
                   multImpFlag,
@@ -9933,19 +11226,19 @@ char multivariateSplit (uint    treeID,
                                  deltaMax);
   return result;
 }
-char customMultivariateSplit (uint    treeID,
-                              Node   *parent,
-                              uint   *repMembrIndx,
-                              uint    repMembrSize,
-                              uint   *allMembrIndx,
-                              uint    allMembrSize,
-                              uint   *splitParameterMax,
-                              double *splitValueMaxCont,
-                              uint   *splitValueMaxFactSize,
-                              uint  **splitValueMaxFactPtr,
-                              double *splitStatistic,
-                              char  **splitIndicator,
-                              char    multImpFlag) {
+char multivariateSplit (uint    treeID,
+                        Node   *parent,
+                        uint   *repMembrIndx,
+                        uint    repMembrSize,
+                        uint   *allMembrIndx,
+                        uint    allMembrSize,
+                        uint   *splitParameterMax,
+                        double *splitValueMaxCont,
+                        uint   *splitValueMaxFactSize,
+                        uint  **splitValueMaxFactPtr,
+                        double *splitStatistic,
+                        char  **splitIndicator,
+                        char    multImpFlag) {
   uint   *randomCovariateIndex;
   uint    uniformCovariateIndex;
   uint    uniformCovariateSize;
@@ -9970,9 +11263,9 @@ char customMultivariateSplit (uint    treeID,
   uint mwcpSizeAbsolute;
   char deterministicSplitFlag;
   char preliminaryResult, result;
-  double delta, deltaPartial, deltaMax;
+  double delta, deltaMax;
   uint   deltaNorm;
-  uint j, k, m, r;
+  uint j, k, p, r;
   localSplitIndicator    = NULL;  
   mwcpSizeAbsolute       = 0;     
   *splitParameterMax     = 0;
@@ -10025,14 +11318,32 @@ char customMultivariateSplit (uint    treeID,
                             & density,
                             & densitySize,
                             & densitySwap);
+      uint **parentClassProp = (uint **) new_vvector(1, RF_rSize, NRUTIL_UPTR);
+      uint **leftClassProp   = (uint **) new_vvector(1, RF_rSize, NRUTIL_UPTR);
+      uint **rghtClassProp   = (uint **) new_vvector(1, RF_rSize, NRUTIL_UPTR);
+      double *sumLeft         = dvector(1, RF_rSize);
+      double *sumRght         = dvector(1, RF_rSize);
+      double *sumRghtSave     = dvector(1, RF_rSize);
       char **secondNonMissMembrFlag = (char **) new_vvector(1, RF_rSize, NRUTIL_CPTR);
       uint  *secondNonMissMembrSize =           uivector(1, RF_rSize);
       uint  *secondNonMissMembrLeftSize =       uivector(1, RF_rSize);
       uint  *secondNonMissMembrRghtSize =       uivector(1, RF_rSize);
+      for (r = 1; r <= RF_rSize; r++) {
+        parentClassProp[r] = leftClassProp[r] = rghtClassProp[r] = NULL;
+        if ((strcmp(RF_rType[r], "C") == 0) ||
+            (strcmp(RF_rType[r], "I") == 0)) {
+          parentClassProp[r] = uivector(1, RF_classLevelSize[RF_rFactorMap[r]]);
+          leftClassProp[r]   = uivector(1, RF_classLevelSize[RF_rFactorMap[r]]);
+          rghtClassProp[r]   = uivector(1, RF_classLevelSize[RF_rFactorMap[r]]);
+        }
+        else {
+        }
+      }  
       char  *tempNonMissMembrFlag = 0;
       uint  *tempNonMissMembrIndx;
       char   mResponseFlag;
       char   nonMissImpuritySummary;
+      double partialLeft, partialRght;
       uint actualCovariateCount = 0;
       uint candidateCovariateCount = 0;
       while (selectRandomCovariates(treeID,
@@ -10109,6 +11420,29 @@ char customMultivariateSplit (uint    treeID,
           for (j = 1; j <= repMembrSize; j++) {
             localSplitIndicator[j] = NEITHER;
           }
+          for (r = 1; r <= RF_rSize; r++) {
+            if (impurity[r]) {
+              if ((strcmp(RF_rType[r], "C") == 0) ||
+                  (strcmp(RF_rType[r], "I") == 0)) {
+                for (p=1; p <= RF_classLevelSize[RF_rFactorMap[r]]; p++) {
+                  parentClassProp[r][p] = 0;
+                }
+                for (j = 1; j <= nonMissMembrSize; j++) {
+                  if (secondNonMissMembrFlag[r][j] == TRUE) {
+                    parentClassProp[r][RF_classLevelIndex[RF_rFactorMap[r]][(uint) RF_response[treeID][r][ repMembrIndx[nonMissMembrIndx[indxx[j]]] ]]] ++;
+                  }
+                }
+              }
+              else {
+                sumRghtSave[r] = 0.0;
+                for (j = 1; j <= nonMissMembrSize; j++) {
+                  if (secondNonMissMembrFlag[r][j] == TRUE) {
+                    sumRghtSave[r] += RF_response[treeID][r][ repMembrIndx[nonMissMembrIndx[indxx[j]]] ] - mean[r];
+                  }
+                }
+              }
+            }  
+          }  
           leftSize = 0;
           priorMembrIter = 0;
           splitLength = stackAndConstructSplitVector(treeID,
@@ -10126,13 +11460,22 @@ char customMultivariateSplit (uint    treeID,
             }
             for (r = 1; r <= RF_rSize; r++) {
               if (impurity[r]) {
+                if ((strcmp(RF_rType[r], "C") == 0) ||
+                    (strcmp(RF_rType[r], "I") == 0)) {
+                  for (p=1; p <= RF_classLevelSize[RF_rFactorMap[r]]; p++) {
+                    rghtClassProp[r][p] = parentClassProp[r][p];
+                    leftClassProp[r][p] = 0;
+                  }
+                }
+                else {
+                  sumRght[r] = sumRghtSave[r];
+                  sumLeft[r] = 0.0;
+                }
                 secondNonMissMembrLeftSize[r] = 0;
                 secondNonMissMembrRghtSize[r] = secondNonMissMembrSize[r];
               }
             }
           }
-          double *userResponse = dvector(1, nonMissMembrSize);
-          char   *userSplitIndicator = cvector(1, nonMissMembrSize);
           for (j = 1; j < splitLength; j++) {
             if (factorFlag == TRUE) {
               priorMembrIter = 0;
@@ -10157,18 +11500,41 @@ char customMultivariateSplit (uint    treeID,
                                & leftSize,
                                priorMembrIter,
                                & currentMembrIter);
-            delta        = 0.0;
-            deltaPartial = 0.0;
-            deltaNorm    = 0;
+            delta     = 0.0;
+            deltaNorm = 0;
             for (r = 1; r <= RF_rSize; r++) {
               if (impurity[r]) {
                 if (factorFlag == TRUE) {
-                  for (k = 1; k <= nonMissMembrSize; k++) {
-                    if (secondNonMissMembrFlag[r][k] == TRUE) {
-                      if (localSplitIndicator[ nonMissMembrIndx[indxx[k]] ] == LEFT) {
-                        secondNonMissMembrLeftSize[r] ++;
+                  if ((strcmp(RF_rType[r], "C") == 0) ||
+                      (strcmp(RF_rType[r], "I") == 0)) {
+                    for (p=1; p <= RF_classLevelSize[RF_rFactorMap[r]]; p++) {
+                      leftClassProp[r][p] = 0;
+                    }
+                    for (k = 1; k <= nonMissMembrSize; k++) {
+                      if (secondNonMissMembrFlag[r][k] == TRUE) {
+                        if (localSplitIndicator[ nonMissMembrIndx[indxx[k]] ] == LEFT) {
+                          leftClassProp[r][RF_classLevelIndex[RF_rFactorMap[r]][(uint) RF_response[treeID][r][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]]] ++;
+                          secondNonMissMembrLeftSize[r] ++;
+                        }
+                        else {
+                        }
                       }
-                      else {
+                    }
+                    for (p=1; p <= RF_classLevelSize[RF_rFactorMap[r]]; p++) {
+                      rghtClassProp[r][p] = parentClassProp[r][p] - leftClassProp[r][p];
+                    }
+                  }
+                  else {
+                    sumLeft[r] = sumRght[r] = 0.0;
+                    for (k = 1; k <= nonMissMembrSize; k++) {
+                      if (secondNonMissMembrFlag[r][k] == TRUE) {
+                        if (localSplitIndicator[ nonMissMembrIndx[indxx[k]] ] == LEFT) {
+                          sumLeft[r] += RF_response[treeID][r][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] - mean[r];
+                          secondNonMissMembrLeftSize[r] ++;
+                        }
+                        else {
+                          sumRght[r] += RF_response[treeID][r][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] - mean[r];
+                        }
                       }
                     }
                   }
@@ -10177,48 +11543,37 @@ char customMultivariateSplit (uint    treeID,
                 else {
                   for (k = priorMembrIter + 1; k < currentMembrIter; k++) {
                     if (secondNonMissMembrFlag[r][k] == TRUE) {
+                      if ((strcmp(RF_rType[r], "C") == 0) ||
+                          (strcmp(RF_rType[r], "I") == 0)) {
+                        leftClassProp[r][RF_classLevelIndex[RF_rFactorMap[r]][(uint) RF_response[treeID][r][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]]] ++;
+                        rghtClassProp[r][RF_classLevelIndex[RF_rFactorMap[r]][(uint) RF_response[treeID][r][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]]] --;
+                      }
+                      else {
+                        sumLeft[r] += RF_response[treeID][r][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] - mean[r];
+                        sumRght[r] -= RF_response[treeID][r][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] - mean[r];
+                      }
                       secondNonMissMembrLeftSize[r] ++;
                       secondNonMissMembrRghtSize[r] --;
                     }
                   }
                 }  
                 if ((secondNonMissMembrLeftSize[r] > 0) && (secondNonMissMembrRghtSize[r] > 0)) {
-                  m = 0;
-                  for (k = 1; k <= nonMissMembrSize; k++) {
-                    if (secondNonMissMembrFlag[r][k] == TRUE) {
-                      userResponse[++m] = RF_response[treeID][r][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ];
-                      userSplitIndicator[m] = localSplitIndicator[ nonMissMembrIndx[indxx[k]] ];
-                    }
-                  }
                   deltaNorm ++;
                   if ((strcmp(RF_rType[r], "C") == 0) ||
                       (strcmp(RF_rType[r], "I") == 0)) {
-                    deltaPartial = customFunctionArray[CLAS_FAM][RF_splitCustomIdx](m,
-                                                                                    userSplitIndicator,
-                                                                                    NULL,
-                                                                                    NULL,
-                                                                                    0,
-                                                                                    0,
-                                                                                    NULL,
-                                                                                    userResponse,
-                                                                                    mean[r],
-                                                                                    variance[r],
-                                                                                    RF_rFactorSize[RF_rFactorMap[r]]);
+                    partialLeft = partialRght = 0;
+                    for (p = 1; p <= RF_classLevelSize[RF_rFactorMap[r]]; p++) {
+                      partialLeft += (double) upower(leftClassProp[r][p], 2);
+                      partialRght += (double) upower(rghtClassProp[r][p], 2);
+                    }
+                    partialLeft = partialLeft / secondNonMissMembrLeftSize[r];
+                    partialRght = partialRght / secondNonMissMembrRghtSize[r];
                   }
                   else {
-                    deltaPartial = (customFunctionArray[REGR_FAM][RF_splitCustomIdx])(m,
-                                                                                      userSplitIndicator,
-                                                                                      NULL,
-                                                                                      NULL,
-                                                                                      0,
-                                                                                      0,
-                                                                                      NULL,
-                                                                                      userResponse,
-                                                                                      mean[r],
-                                                                                      variance[r],
-                                                                                      0);
+                    partialLeft = pow (sumLeft[r], 2.0) / (secondNonMissMembrLeftSize[r] * variance[r]);
+                    partialRght = pow (sumRght[r], 2.0) / (secondNonMissMembrRghtSize[r] * variance[r]);
                   }
-                  delta += deltaPartial;
+                  delta += partialLeft + partialRght;
                 }
               }  
             }  
@@ -10249,8 +11604,6 @@ char customMultivariateSplit (uint    treeID,
               priorMembrIter = currentMembrIter - 1;
             }
           }  
-          free_dvector (userResponse, 1, nonMissMembrSize);
-          free_cvector (userSplitIndicator, 1, nonMissMembrSize);
           unstackSplitVector(treeID,
                              splitVectorSize,
                              splitLength,
@@ -10275,6 +11628,22 @@ char customMultivariateSplit (uint    treeID,
           }
         }
       }  
+      for (r = 1; r <= RF_rSize; r++) {
+        if ((strcmp(RF_rType[r], "C") == 0) ||
+            (strcmp(RF_rType[r], "I") == 0)) {
+          free_uivector (parentClassProp[r], 1, RF_classLevelSize[RF_rFactorMap[r]]);
+          free_uivector (leftClassProp[r], 1, RF_classLevelSize[RF_rFactorMap[r]]);
+          free_uivector (rghtClassProp[r], 1, RF_classLevelSize[RF_rFactorMap[r]]);
+        }
+        else {
+        }
+      }
+      free_new_vvector(parentClassProp, 1, RF_rSize, NRUTIL_UPTR);
+      free_new_vvector(leftClassProp,   1, RF_rSize, NRUTIL_UPTR);
+      free_new_vvector(rghtClassProp,   1, RF_rSize, NRUTIL_UPTR);
+      free_dvector(sumLeft,     1, RF_rSize);
+      free_dvector(sumRght,     1, RF_rSize);
+      free_dvector(sumRghtSave, 1, RF_rSize);
       free_new_vvector(secondNonMissMembrFlag,  1, RF_rSize, NRUTIL_CPTR);
       free_uivector(secondNonMissMembrSize,     1, RF_rSize);
       free_uivector(secondNonMissMembrLeftSize, 1, RF_rSize);
@@ -10310,19 +11679,19 @@ char customMultivariateSplit (uint    treeID,
                                  deltaMax);
   return result;
 }
-char customSurvivalSplit (uint    treeID,
-                          Node   *parent,
-                          uint   *repMembrIndx,
-                          uint    repMembrSize,
-                          uint   *allMembrIndx,
-                          uint    allMembrSize,
-                          uint   *splitParameterMax,
-                          double *splitValueMaxCont,
-                          uint   *splitValueMaxFactSize,
-                          uint  **splitValueMaxFactPtr,
-                          double *splitStatistic,
-                          char  **splitIndicator,
-                          char    multImpFlag) {
+char customMultivariateSplit (uint    treeID,
+                              Node   *parent,
+                              uint   *repMembrIndx,
+                              uint    repMembrSize,
+                              uint   *allMembrIndx,
+                              uint    allMembrSize,
+                              uint   *splitParameterMax,
+                              double *splitValueMaxCont,
+                              uint   *splitValueMaxFactSize,
+                              uint  **splitValueMaxFactPtr,
+                              double *splitStatistic,
+                              char  **splitIndicator,
+                              char    multImpFlag) {
   uint   *randomCovariateIndex;
   uint    uniformCovariateIndex;
   uint    uniformCovariateSize;
@@ -10347,8 +11716,9 @@ char customSurvivalSplit (uint    treeID,
   uint mwcpSizeAbsolute;
   char deterministicSplitFlag;
   char preliminaryResult, result;
-  double delta, deltaMax;
-  uint j, k, m;
+  double delta, deltaPartial, deltaMax;
+  uint   deltaNorm;
+  uint j, k, m, r;
   localSplitIndicator    = NULL;  
   mwcpSizeAbsolute       = 0;     
   *splitParameterMax     = 0;
@@ -10365,6245 +11735,9774 @@ char customSurvivalSplit (uint    treeID,
                                         & splitVector,
                                         & parent -> mean,
                                         multImpFlag,
-                                        FALSE);
+                                        TRUE);
   if (preliminaryResult) {
-    stackSplitIndicator(repMembrSize, & localSplitIndicator);
-    stackRandomCovariates(treeID,
-                          parent,
-                          repMembrSize,
-                          multImpFlag,
-                          & randomCovariateIndex,
-                          & uniformCovariateSize,
-                          & cdf,
-                          & cdfSize,
-                          & cdfSort,
-                          & density,
-                          & densitySize,
-                          & densitySwap);
-    uint *localEventTimeCount, *localEventTimeIndex;
-    uint  localEventTimeSize;
-    uint *nodeParentEvent,  *nodeLeftEvent,  *nodeRightEvent;
-    uint *nodeParentAtRisk, *nodeLeftAtRisk, *nodeRightAtRisk;
-    localEventTimeSize = 0;  
-    delta = 0;  
+    char   *impurity   = cvector(1, RF_rSize);
+    double *mean       = dvector(1, RF_rSize);
+    double *variance   = dvector(1, RF_rSize);
+    char impuritySummary;
     if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
-      stackAndGetSplitSurv(treeID,
-                           repMembrIndx,
-                           repMembrSize,
-                           nonMissMembrIndxStatic,
-                           nonMissMembrSizeStatic,
-                           & localEventTimeCount,
-                           & localEventTimeIndex,
-                           & localEventTimeSize,
-                           & nodeParentEvent,
-                           & nodeParentAtRisk,
-                           & nodeLeftEvent,
-                           & nodeLeftAtRisk,
-                           & nodeRightEvent,
-                           & nodeRightAtRisk);
-    }
-    uint actualCovariateCount = 0;
-    uint candidateCovariateCount = 0;
-    while (selectRandomCovariates(treeID,
-                                  parent,
+      impuritySummary = FALSE;
+      for (r = 1; r <= RF_rSize; r++)  {
+        impurity[r] = getVariance(repMembrSize,
                                   repMembrIndx,
-                                  repMembrSize,
-                                  randomCovariateIndex,
-                                  & uniformCovariateSize,
-                                  & uniformCovariateIndex,
-                                  cdf,
-                                  & cdfSize,
-                                  cdfSort,
-                                  density,
-                                  & densitySize,
-                                  densitySwap,
-                                  & covariate,
-                                  & actualCovariateCount,
-                                  & candidateCovariateCount,
-                                  splitVector,
-                                  & splitVectorSize,
-                                  & indxx,
-                                  nonMissMembrSizeStatic,
-                                  nonMissMembrIndxStatic,
-                                  & nonMissMembrSize,
-                                  & nonMissMembrIndx,
-                                  multImpFlag)) {
-      splitLength = stackAndConstructSplitVector(treeID,
-                                                 repMembrSize,
-                                                 covariate,
-                                                 splitVector,
-                                                 splitVectorSize,
-                                                 & factorFlag,
-                                                 & deterministicSplitFlag,
-                                                 & mwcpSizeAbsolute,
-                                                 & splitVectorPtr);
-      if (!((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP)))) {
-        stackAndGetSplitSurv(treeID,
-                             repMembrIndx,
-                             repMembrSize,
-                             nonMissMembrIndx,
-                             nonMissMembrSize,
-                             & localEventTimeCount,
-                             & localEventTimeIndex,
-                             & localEventTimeSize,
-                             & nodeParentEvent,
-                             & nodeParentAtRisk,
-                             & nodeLeftEvent,
-                             & nodeLeftAtRisk,
-                             & nodeRightEvent,
-                             & nodeRightAtRisk);
+                                  0,
+                                  NULL,
+                                  RF_response[treeID][r],
+                                  &mean[r],
+                                  &variance[r]);
+        impuritySummary = impuritySummary | impurity[r];
       }
-      if (localEventTimeSize > 0) {
-        for (j = 1; j <= repMembrSize; j++) {
-          localSplitIndicator[j] = NEITHER;
-        }
-        leftSize = 0;
-        priorMembrIter = 0;
-        if (factorFlag == FALSE) {
-          for (j = 1; j <= nonMissMembrSize; j++) {
-            localSplitIndicator[ nonMissMembrIndx[indxx[j]] ] = RIGHT;
-          }
-        }
-        double *userTime  = dvector(1, nonMissMembrSize);
-        double *userEvent = dvector(1, nonMissMembrSize);
-        double *userEventTime = dvector(1, localEventTimeSize);
-        char   *userSplitIndicator = cvector(1, nonMissMembrSize);
-        uint   *userSort  = uivector(1, nonMissMembrSize);
-        double *tempTime  = dvector(1, nonMissMembrSize);
-        for (k = 1; k <= nonMissMembrSize; k++) {
-          tempTime[k]  = RF_time[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ];
-        }
-        indexx(nonMissMembrSize, tempTime, userSort);
-        for (k = 1; k <= nonMissMembrSize; k++) {
-          userTime[k]  = RF_time[treeID][ repMembrIndx[nonMissMembrIndx[indxx[userSort[k]]]] ];
-          userEvent[k] = RF_status[treeID][ repMembrIndx[nonMissMembrIndx[indxx[userSort[k]]]] ];
-        }
-        for (m = 1; m <= localEventTimeSize; m++) {
-          userEventTime[m] = RF_masterTime[localEventTimeIndex[m]];
-        }
-        for (j = 1; j < splitLength; j++) {
-          if (factorFlag == TRUE) {
-            priorMembrIter = 0;
-            leftSize = 0;
-          }
-          virtuallySplitNode(treeID,
-                             factorFlag,
-                             mwcpSizeAbsolute,
-                             covariate,
-                             repMembrIndx,
-                             repMembrSize,
-                             nonMissMembrIndx,
-                             nonMissMembrSize,
-                             indxx,
-                             splitVectorPtr,
-                             j,
-                             localSplitIndicator,
-                             & leftSize,
-                             priorMembrIter,
-                             & currentMembrIter);
+    }
+    else {
+      impuritySummary = TRUE;
+    }
+    if (impuritySummary) {
+      stackSplitIndicator(repMembrSize, & localSplitIndicator);
+      stackRandomCovariates(treeID,
+                            parent,
+                            repMembrSize,
+                            multImpFlag,
+                            & randomCovariateIndex,
+                            & uniformCovariateSize,
+                            & cdf,
+                            & cdfSize,
+                            & cdfSort,
+                            & density,
+                            & densitySize,
+                            & densitySwap);
+      char **secondNonMissMembrFlag = (char **) new_vvector(1, RF_rSize, NRUTIL_CPTR);
+      uint  *secondNonMissMembrSize =           uivector(1, RF_rSize);
+      uint  *secondNonMissMembrLeftSize =       uivector(1, RF_rSize);
+      uint  *secondNonMissMembrRghtSize =       uivector(1, RF_rSize);
+      char  *tempNonMissMembrFlag = 0;
+      uint  *tempNonMissMembrIndx;
+      char   mResponseFlag;
+      char   nonMissImpuritySummary;
+      uint actualCovariateCount = 0;
+      uint candidateCovariateCount = 0;
+      while (selectRandomCovariates(treeID,
+                                    parent,
+                                    repMembrIndx,
+                                    repMembrSize,
+                                    randomCovariateIndex,
+                                    & uniformCovariateSize,
+                                    & uniformCovariateIndex,
+                                    cdf,
+                                    & cdfSize,
+                                    cdfSort,
+                                    density,
+                                    & densitySize,
+                                    densitySwap,
+                                    & covariate,
+                                    & actualCovariateCount,
+                                    & candidateCovariateCount,
+                                    splitVector,
+                                    & splitVectorSize,
+                                    & indxx,
+                                    nonMissMembrSizeStatic,
+                                    nonMissMembrIndxStatic,
+                                    & nonMissMembrSize,
+                                    & nonMissMembrIndx,
+                                    multImpFlag)) {
+        if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
+          tempNonMissMembrFlag = cvector(1, nonMissMembrSize);
           for (k = 1; k <= nonMissMembrSize; k++) {
-            userSplitIndicator[k] = localSplitIndicator[ nonMissMembrIndx[indxx[userSort[k]]] ];
+            tempNonMissMembrFlag[k] = TRUE;
           }
-          delta = customFunctionArray[SURV_FAM][RF_splitCustomIdx](nonMissMembrSize,
-                                                                   userSplitIndicator,
-                                                                   userTime,
-                                                                   userEvent,
-                                                                   0,
-                                                                   localEventTimeSize,
-                                                                   userEventTime,
-                                                                   NULL,
-                                                                   0,
-                                                                   0,
-                                                                   0);
-          updateMaximumSplit(treeID,
-                             parent,
-                             delta,
-                             candidateCovariateCount,
-                             covariate,
-                             j,
-                             factorFlag,
-                             mwcpSizeAbsolute,
-                             repMembrSize,
-                             localSplitIndicator,
-                             & deltaMax,
-                             splitParameterMax,
-                             splitValueMaxCont,
-                             splitValueMaxFactSize,
-                             splitValueMaxFactPtr,
-                             splitVectorPtr,
-                             splitIndicator);
-          if (factorFlag == FALSE) {
-            priorMembrIter = currentMembrIter - 1;
+          for (r = 1; r <= RF_rSize; r++) {
+              secondNonMissMembrFlag[r] = tempNonMissMembrFlag;
+              secondNonMissMembrSize[r] = nonMissMembrSize;
           }
-        }  
-        free_uivector(userSort, 1, nonMissMembrSize);
-        free_dvector(tempTime, 1, nonMissMembrSize);
-        free_dvector (userTime, 1, nonMissMembrSize);
-        free_dvector (userEvent, 1, nonMissMembrSize);
-        free_dvector (userEventTime, 1, localEventTimeSize);
-        free_cvector (userSplitIndicator, 1, nonMissMembrSize);
-      }  
-      else {
-      }
-      unstackSplitVector(treeID,
-                         splitVectorSize,
-                         splitLength,
-                         factorFlag,
-                         deterministicSplitFlag,
-                         mwcpSizeAbsolute,
-                         splitVectorPtr);
-      unselectRandomCovariates(treeID,
-                               parent,
+          nonMissImpuritySummary = TRUE;
+        }
+        else {
+          tempNonMissMembrIndx = uivector(1, nonMissMembrSize);
+          nonMissImpuritySummary = FALSE;
+          for (r = 1; r <= RF_rSize; r++)  {
+            secondNonMissMembrFlag[r] = cvector(1, nonMissMembrSize);
+            j = 0;
+            for (k = 1; k <= nonMissMembrSize; k++) {
+              mResponseFlag = FALSE;
+              if (RF_mRecordMap[ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] > 0) {
+                if (RF_mpSign[r][RF_mRecordMap[ repMembrIndx[nonMissMembrIndx[indxx[k]]] ]] == 1) {
+                  mResponseFlag = TRUE;
+                }
+              }
+              if (!mResponseFlag) {
+                j ++;
+                tempNonMissMembrIndx[j] = nonMissMembrIndx[indxx[k]];
+                secondNonMissMembrFlag[r][k] = TRUE;
+              }
+              else {
+                secondNonMissMembrFlag[r][k] = FALSE;
+              }
+            }  
+            secondNonMissMembrSize[r] = j;
+            impurity[r] = getVariance(repMembrSize,
+                                      repMembrIndx,
+                                      secondNonMissMembrSize[r],
+                                      tempNonMissMembrIndx,
+                                      RF_response[treeID][r],
+                                      &mean[r],
+                                      &variance[r]);
+            nonMissImpuritySummary = nonMissImpuritySummary | impurity[r];
+            secondNonMissMembrLeftSize[r] = secondNonMissMembrRghtSize[r] = 0;
+          }  
+          free_uivector(tempNonMissMembrIndx, 1, nonMissMembrSize);
+        }  
+        if (nonMissImpuritySummary) {
+          for (j = 1; j <= repMembrSize; j++) {
+            localSplitIndicator[j] = NEITHER;
+          }
+          leftSize = 0;
+          priorMembrIter = 0;
+          splitLength = stackAndConstructSplitVector(treeID,
+                                                     repMembrSize,
+                                                     covariate,
+                                                     splitVector,
+                                                     splitVectorSize,
+                                                     & factorFlag,
+                                                     & deterministicSplitFlag,
+                                                     & mwcpSizeAbsolute,
+                                                     & splitVectorPtr);
+          if (factorFlag == FALSE) {
+            for (j = 1; j <= nonMissMembrSize; j++) {
+              localSplitIndicator[ nonMissMembrIndx[indxx[j]] ] = RIGHT;
+            }
+            for (r = 1; r <= RF_rSize; r++) {
+              if (impurity[r]) {
+                secondNonMissMembrLeftSize[r] = 0;
+                secondNonMissMembrRghtSize[r] = secondNonMissMembrSize[r];
+              }
+            }
+          }
+          double *userResponse = dvector(1, nonMissMembrSize);
+          char   *userSplitIndicator = cvector(1, nonMissMembrSize);
+          for (j = 1; j < splitLength; j++) {
+            if (factorFlag == TRUE) {
+              priorMembrIter = 0;
+              leftSize = 0;
+              for (r = 1; r <= RF_rSize; r++) {
+                secondNonMissMembrLeftSize[r] = 0;
+                secondNonMissMembrRghtSize[r] = 0;
+              }
+            }
+            virtuallySplitNode(treeID,
+                               factorFlag,
+                               mwcpSizeAbsolute,
+                               covariate,
+                               repMembrIndx,
                                repMembrSize,
-                               indxx,
-                               nonMissMembrSizeStatic,
                                nonMissMembrIndx,
-                               multImpFlag);
-      if (!((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP)))) {
-        unstackSplitSurv(localEventTimeCount,
-                         localEventTimeIndex,
-                         localEventTimeSize,
-                         nodeParentEvent,
-                         nodeParentAtRisk,
-                         nodeLeftEvent,
-                         nodeLeftAtRisk,
-                         nodeRightEvent,
-                         nodeRightAtRisk);
+                               nonMissMembrSize,
+                               indxx,
+                               splitVectorPtr,
+                               j,
+                               localSplitIndicator,
+                               & leftSize,
+                               priorMembrIter,
+                               & currentMembrIter);
+            delta        = 0.0;
+            deltaPartial = 0.0;
+            deltaNorm    = 0;
+            for (r = 1; r <= RF_rSize; r++) {
+              if (impurity[r]) {
+                if (factorFlag == TRUE) {
+                  for (k = 1; k <= nonMissMembrSize; k++) {
+                    if (secondNonMissMembrFlag[r][k] == TRUE) {
+                      if (localSplitIndicator[ nonMissMembrIndx[indxx[k]] ] == LEFT) {
+                        secondNonMissMembrLeftSize[r] ++;
+                      }
+                      else {
+                      }
+                    }
+                  }
+                  secondNonMissMembrRghtSize[r] = secondNonMissMembrSize[r] - secondNonMissMembrLeftSize[r];
+                }
+                else {
+                  for (k = priorMembrIter + 1; k < currentMembrIter; k++) {
+                    if (secondNonMissMembrFlag[r][k] == TRUE) {
+                      secondNonMissMembrLeftSize[r] ++;
+                      secondNonMissMembrRghtSize[r] --;
+                    }
+                  }
+                }  
+                if ((secondNonMissMembrLeftSize[r] > 0) && (secondNonMissMembrRghtSize[r] > 0)) {
+                  m = 0;
+                  for (k = 1; k <= nonMissMembrSize; k++) {
+                    if (secondNonMissMembrFlag[r][k] == TRUE) {
+                      userResponse[++m] = RF_response[treeID][r][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ];
+                      userSplitIndicator[m] = localSplitIndicator[ nonMissMembrIndx[indxx[k]] ];
+                    }
+                  }
+                  deltaNorm ++;
+                  if ((strcmp(RF_rType[r], "C") == 0) ||
+                      (strcmp(RF_rType[r], "I") == 0)) {
+                    deltaPartial = customFunctionArray[CLAS_FAM][RF_splitCustomIdx](m,
+                                                                                    userSplitIndicator,
+                                                                                    NULL,
+                                                                                    NULL,
+                                                                                    0,
+                                                                                    0,
+                                                                                    NULL,
+                                                                                    userResponse,
+                                                                                    mean[r],
+                                                                                    variance[r],
+                                                                                    RF_rFactorSize[RF_rFactorMap[r]]);
+                  }
+                  else {
+                    deltaPartial = (customFunctionArray[REGR_FAM][RF_splitCustomIdx])(m,
+                                                                                      userSplitIndicator,
+                                                                                      NULL,
+                                                                                      NULL,
+                                                                                      0,
+                                                                                      0,
+                                                                                      NULL,
+                                                                                      userResponse,
+                                                                                      mean[r],
+                                                                                      variance[r],
+                                                                                      0);
+                  }
+                  delta += deltaPartial;
+                }
+              }  
+            }  
+            if (deltaNorm > 0) {
+              delta = delta / (double) deltaNorm;
+            }
+            else {
+              delta = NA_REAL;
+            }
+            updateMaximumSplit(treeID,
+                               parent,
+                               delta,
+                               candidateCovariateCount,
+                               covariate,
+                               j,
+                               factorFlag,
+                               mwcpSizeAbsolute,
+                               repMembrSize,
+                               localSplitIndicator,
+                               & deltaMax,
+                               splitParameterMax,
+                               splitValueMaxCont,
+                               splitValueMaxFactSize,
+                               splitValueMaxFactPtr,
+                               splitVectorPtr,
+                               splitIndicator);
+            if (factorFlag == FALSE) {
+              priorMembrIter = currentMembrIter - 1;
+            }
+          }  
+          free_dvector (userResponse, 1, nonMissMembrSize);
+          free_cvector (userSplitIndicator, 1, nonMissMembrSize);
+          unstackSplitVector(treeID,
+                             splitVectorSize,
+                             splitLength,
+                             factorFlag,
+                             deterministicSplitFlag,
+                             mwcpSizeAbsolute,
+                             splitVectorPtr);
+        }  
+        unselectRandomCovariates(treeID,
+                                 parent,
+                                 repMembrSize,
+                                 indxx,
+                                 nonMissMembrSizeStatic,
+                                 nonMissMembrIndx,
+                                 multImpFlag);
+        if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
+          free_cvector(tempNonMissMembrFlag, 1, nonMissMembrSize);
+        }
+        else {
+          for (r = 1; r <= RF_rSize; r++)  {
+            free_cvector(secondNonMissMembrFlag[r], 1, nonMissMembrSize);
+          }
+        }
+      }  
+      free_new_vvector(secondNonMissMembrFlag,  1, RF_rSize, NRUTIL_CPTR);
+      free_uivector(secondNonMissMembrSize,     1, RF_rSize);
+      free_uivector(secondNonMissMembrLeftSize, 1, RF_rSize);
+      free_uivector(secondNonMissMembrRghtSize, 1, RF_rSize);
+      unstackRandomCovariates(treeID,
+                              parent,
+                              randomCovariateIndex,
+                              uniformCovariateSize,
+                              cdf,
+                              cdfSize,
+                              cdfSort,
+                              density,
+                              densitySize,
+                              densitySwap,
+                              repMembrSize);
+      unstackSplitIndicator(repMembrSize, localSplitIndicator);
+    }  
+    free_cvector(impurity,   1, RF_rSize);
+    free_dvector(mean,       1, RF_rSize);
+    free_dvector(variance,   1, RF_rSize);
+  }  
+  unstackPreSplit(preliminaryResult,
+                  multImpFlag,
+                  TRUE,  
+                  repMembrSize,
+                  splitVector,
+                  nonMissMembrIndxStatic);
+  result = summarizeSplitResult(*splitParameterMax,
+                                *splitValueMaxCont,
+                                *splitValueMaxFactSize,
+                                *splitValueMaxFactPtr,
+                                 splitStatistic,
+                                 deltaMax);
+  return result;
+}
+char customSurvivalSplit (uint    treeID,
+                          Node   *parent,
+                          uint   *repMembrIndx,
+                          uint    repMembrSize,
+                          uint   *allMembrIndx,
+                          uint    allMembrSize,
+                          uint   *splitParameterMax,
+                          double *splitValueMaxCont,
+                          uint   *splitValueMaxFactSize,
+                          uint  **splitValueMaxFactPtr,
+                          double *splitStatistic,
+                          char  **splitIndicator,
+                          char    multImpFlag) {
+  uint   *randomCovariateIndex;
+  uint    uniformCovariateIndex;
+  uint    uniformCovariateSize;
+  double *cdf;
+  uint    cdfSize;
+  uint   *cdfSort;
+  uint   *density;
+  uint    densitySize;
+  uint  **densitySwap;
+  uint     covariate;
+  double  *splitVector;
+  uint     splitVectorSize;
+  uint nonMissMembrSize, nonMissMembrSizeStatic;
+  uint *nonMissMembrIndx, *nonMissMembrIndxStatic;
+  uint   *indxx;
+  uint priorMembrIter, currentMembrIter;
+  uint leftSize;
+  char *localSplitIndicator;
+  uint splitLength;
+  void *splitVectorPtr;
+  char factorFlag;
+  uint mwcpSizeAbsolute;
+  char deterministicSplitFlag;
+  char preliminaryResult, result;
+  double delta, deltaMax;
+  uint j, k, m;
+  localSplitIndicator    = NULL;  
+  mwcpSizeAbsolute       = 0;     
+  *splitParameterMax     = 0;
+  *splitValueMaxFactSize = 0;
+  *splitValueMaxFactPtr  = NULL;
+  *splitValueMaxCont     = NA_REAL;
+  deltaMax               = NA_REAL;
+  preliminaryResult = getPreSplitResult(treeID,
+                                        parent,
+                                        repMembrSize,
+                                        repMembrIndx,
+                                        & nonMissMembrSizeStatic,
+                                        & nonMissMembrIndxStatic,
+                                        & splitVector,
+                                        & parent -> mean,
+                                        multImpFlag,
+                                        FALSE);
+  if (preliminaryResult) {
+    stackSplitIndicator(repMembrSize, & localSplitIndicator);
+    stackRandomCovariates(treeID,
+                          parent,
+                          repMembrSize,
+                          multImpFlag,
+                          & randomCovariateIndex,
+                          & uniformCovariateSize,
+                          & cdf,
+                          & cdfSize,
+                          & cdfSort,
+                          & density,
+                          & densitySize,
+                          & densitySwap);
+    uint *localEventTimeCount, *localEventTimeIndex;
+    uint  localEventTimeSize;
+    uint *nodeParentEvent,  *nodeLeftEvent,  *nodeRightEvent;
+    uint *nodeParentAtRisk, *nodeLeftAtRisk, *nodeRightAtRisk;
+    localEventTimeSize = 0;  
+    delta = 0;  
+    if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
+      stackAndGetSplitSurv(treeID,
+                           repMembrIndx,
+                           repMembrSize,
+                           nonMissMembrIndxStatic,
+                           nonMissMembrSizeStatic,
+                           & localEventTimeCount,
+                           & localEventTimeIndex,
+                           & localEventTimeSize,
+                           & nodeParentEvent,
+                           & nodeParentAtRisk,
+                           & nodeLeftEvent,
+                           & nodeLeftAtRisk,
+                           & nodeRightEvent,
+                           & nodeRightAtRisk);
+    }
+    uint actualCovariateCount = 0;
+    uint candidateCovariateCount = 0;
+    while (selectRandomCovariates(treeID,
+                                  parent,
+                                  repMembrIndx,
+                                  repMembrSize,
+                                  randomCovariateIndex,
+                                  & uniformCovariateSize,
+                                  & uniformCovariateIndex,
+                                  cdf,
+                                  & cdfSize,
+                                  cdfSort,
+                                  density,
+                                  & densitySize,
+                                  densitySwap,
+                                  & covariate,
+                                  & actualCovariateCount,
+                                  & candidateCovariateCount,
+                                  splitVector,
+                                  & splitVectorSize,
+                                  & indxx,
+                                  nonMissMembrSizeStatic,
+                                  nonMissMembrIndxStatic,
+                                  & nonMissMembrSize,
+                                  & nonMissMembrIndx,
+                                  multImpFlag)) {
+      splitLength = stackAndConstructSplitVector(treeID,
+                                                 repMembrSize,
+                                                 covariate,
+                                                 splitVector,
+                                                 splitVectorSize,
+                                                 & factorFlag,
+                                                 & deterministicSplitFlag,
+                                                 & mwcpSizeAbsolute,
+                                                 & splitVectorPtr);
+      if (!((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP)))) {
+        stackAndGetSplitSurv(treeID,
+                             repMembrIndx,
+                             repMembrSize,
+                             nonMissMembrIndx,
+                             nonMissMembrSize,
+                             & localEventTimeCount,
+                             & localEventTimeIndex,
+                             & localEventTimeSize,
+                             & nodeParentEvent,
+                             & nodeParentAtRisk,
+                             & nodeLeftEvent,
+                             & nodeLeftAtRisk,
+                             & nodeRightEvent,
+                             & nodeRightAtRisk);
+      }
+      if (localEventTimeSize > 0) {
+        for (j = 1; j <= repMembrSize; j++) {
+          localSplitIndicator[j] = NEITHER;
+        }
+        leftSize = 0;
+        priorMembrIter = 0;
+        if (factorFlag == FALSE) {
+          for (j = 1; j <= nonMissMembrSize; j++) {
+            localSplitIndicator[ nonMissMembrIndx[indxx[j]] ] = RIGHT;
+          }
+        }
+        double *userTime  = dvector(1, nonMissMembrSize);
+        double *userEvent = dvector(1, nonMissMembrSize);
+        double *userEventTime = dvector(1, localEventTimeSize);
+        char   *userSplitIndicator = cvector(1, nonMissMembrSize);
+        uint   *userSort  = uivector(1, nonMissMembrSize);
+        double *tempTime  = dvector(1, nonMissMembrSize);
+        for (k = 1; k <= nonMissMembrSize; k++) {
+          tempTime[k]  = RF_time[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ];
+        }
+        indexx(nonMissMembrSize, tempTime, userSort);
+        for (k = 1; k <= nonMissMembrSize; k++) {
+          userTime[k]  = RF_time[treeID][ repMembrIndx[nonMissMembrIndx[indxx[userSort[k]]]] ];
+          userEvent[k] = RF_status[treeID][ repMembrIndx[nonMissMembrIndx[indxx[userSort[k]]]] ];
+        }
+        for (m = 1; m <= localEventTimeSize; m++) {
+          userEventTime[m] = RF_masterTime[localEventTimeIndex[m]];
+        }
+        for (j = 1; j < splitLength; j++) {
+          if (factorFlag == TRUE) {
+            priorMembrIter = 0;
+            leftSize = 0;
+          }
+          virtuallySplitNode(treeID,
+                             factorFlag,
+                             mwcpSizeAbsolute,
+                             covariate,
+                             repMembrIndx,
+                             repMembrSize,
+                             nonMissMembrIndx,
+                             nonMissMembrSize,
+                             indxx,
+                             splitVectorPtr,
+                             j,
+                             localSplitIndicator,
+                             & leftSize,
+                             priorMembrIter,
+                             & currentMembrIter);
+          for (k = 1; k <= nonMissMembrSize; k++) {
+            userSplitIndicator[k] = localSplitIndicator[ nonMissMembrIndx[indxx[userSort[k]]] ];
+          }
+          delta = customFunctionArray[SURV_FAM][RF_splitCustomIdx](nonMissMembrSize,
+                                                                   userSplitIndicator,
+                                                                   userTime,
+                                                                   userEvent,
+                                                                   0,
+                                                                   localEventTimeSize,
+                                                                   userEventTime,
+                                                                   NULL,
+                                                                   0,
+                                                                   0,
+                                                                   0);
+          updateMaximumSplit(treeID,
+                             parent,
+                             delta,
+                             candidateCovariateCount,
+                             covariate,
+                             j,
+                             factorFlag,
+                             mwcpSizeAbsolute,
+                             repMembrSize,
+                             localSplitIndicator,
+                             & deltaMax,
+                             splitParameterMax,
+                             splitValueMaxCont,
+                             splitValueMaxFactSize,
+                             splitValueMaxFactPtr,
+                             splitVectorPtr,
+                             splitIndicator);
+          if (factorFlag == FALSE) {
+            priorMembrIter = currentMembrIter - 1;
+          }
+        }  
+        free_uivector(userSort, 1, nonMissMembrSize);
+        free_dvector(tempTime, 1, nonMissMembrSize);
+        free_dvector (userTime, 1, nonMissMembrSize);
+        free_dvector (userEvent, 1, nonMissMembrSize);
+        free_dvector (userEventTime, 1, localEventTimeSize);
+        free_cvector (userSplitIndicator, 1, nonMissMembrSize);
+      }  
+      else {
+      }
+      unstackSplitVector(treeID,
+                         splitVectorSize,
+                         splitLength,
+                         factorFlag,
+                         deterministicSplitFlag,
+                         mwcpSizeAbsolute,
+                         splitVectorPtr);
+      unselectRandomCovariates(treeID,
+                               parent,
+                               repMembrSize,
+                               indxx,
+                               nonMissMembrSizeStatic,
+                               nonMissMembrIndx,
+                               multImpFlag);
+      if (!((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP)))) {
+        unstackSplitSurv(localEventTimeCount,
+                         localEventTimeIndex,
+                         localEventTimeSize,
+                         nodeParentEvent,
+                         nodeParentAtRisk,
+                         nodeLeftEvent,
+                         nodeLeftAtRisk,
+                         nodeRightEvent,
+                         nodeRightAtRisk);
+      }
+    }  
+    if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
+      unstackSplitSurv(localEventTimeCount,
+                       localEventTimeIndex,
+                       localEventTimeSize,
+                       nodeParentEvent,
+                       nodeParentAtRisk,
+                       nodeLeftEvent,
+                       nodeLeftAtRisk,
+                       nodeRightEvent,
+                       nodeRightAtRisk);
+    }
+    unstackRandomCovariates(treeID,
+                            parent,
+                            randomCovariateIndex,
+                            uniformCovariateSize,
+                            cdf,
+                            cdfSize,
+                            cdfSort,
+                            density,
+                            densitySize,
+                            densitySwap,
+                            repMembrSize);
+    unstackSplitIndicator(repMembrSize, localSplitIndicator);
+  }  
+  unstackPreSplit(preliminaryResult,
+                  multImpFlag,
+                  FALSE,  
+                  repMembrSize,
+                  splitVector,
+                  nonMissMembrIndxStatic);
+  result = summarizeSplitResult(*splitParameterMax,
+                                *splitValueMaxCont,
+                                *splitValueMaxFactSize,
+                                *splitValueMaxFactPtr,
+                                 splitStatistic,
+                                 deltaMax);
+  return result;
+}
+char customCompetingRiskSplit (uint    treeID,
+                               Node   *parent,
+                               uint   *repMembrIndx,
+                               uint    repMembrSize,
+                               uint   *allMembrIndx,
+                               uint    allMembrSize,
+                               uint   *splitParameterMax,
+                               double *splitValueMaxCont,
+                               uint   *splitValueMaxFactSize,
+                               uint  **splitValueMaxFactPtr,
+                               double *splitStatistic,
+                               char  **splitIndicator,
+                               char    multImpFlag) {
+  uint   *randomCovariateIndex;
+  uint    uniformCovariateIndex;
+  uint    uniformCovariateSize;
+  double *cdf;
+  uint    cdfSize;
+  uint   *cdfSort;
+  uint   *density;
+  uint    densitySize;
+  uint  **densitySwap;
+  uint     covariate;
+  double  *splitVector;
+  uint     splitVectorSize;
+  uint nonMissMembrSize, nonMissMembrSizeStatic;
+  uint *nonMissMembrIndx, *nonMissMembrIndxStatic;
+  uint   *indxx;
+  uint priorMembrIter, currentMembrIter;
+  uint leftSize;
+  char *localSplitIndicator;
+  uint splitLength;
+  void *splitVectorPtr;
+  char factorFlag;
+  uint mwcpSizeAbsolute;
+  char deterministicSplitFlag;
+  char preliminaryResult, result;
+  double delta, deltaMax;
+  uint j, k, m;
+  localSplitIndicator    = NULL;  
+  mwcpSizeAbsolute       = 0;     
+  *splitParameterMax     = 0;
+  *splitValueMaxFactSize = 0;
+  *splitValueMaxFactPtr  = NULL;
+  *splitValueMaxCont     = NA_REAL;
+  deltaMax               = NA_REAL;
+  preliminaryResult = getPreSplitResult(treeID,
+                                        parent,
+                                        repMembrSize,
+                                        repMembrIndx,
+                                        & nonMissMembrSizeStatic,
+                                        & nonMissMembrIndxStatic,
+                                        & splitVector,
+                                        & parent -> mean,
+                                        multImpFlag,
+                                        FALSE);
+  if (preliminaryResult) {
+    stackSplitIndicator(repMembrSize, & localSplitIndicator);
+    stackRandomCovariates(treeID,
+                          parent,
+                          repMembrSize,
+                          multImpFlag,
+                          & randomCovariateIndex,
+                          & uniformCovariateSize,
+                          & cdf,
+                          & cdfSize,
+                          & cdfSort,
+                          & density,
+                          & densitySize,
+                          & densitySwap);
+    uint *localEventTimeCount, *localEventTimeIndex;
+    uint  localEventTimeSize;
+    uint *nodeParentEvent,  *nodeLeftEvent,  *nodeRightEvent;
+    uint *nodeParentAtRisk, *nodeLeftAtRisk, *nodeRightAtRisk;
+    localEventTimeSize = 0;  
+    delta = 0;  
+    if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
+      stackAndGetSplitSurv(treeID,
+                           repMembrIndx,
+                           repMembrSize,
+                           nonMissMembrIndxStatic,
+                           nonMissMembrSizeStatic,
+                           & localEventTimeCount,
+                           & localEventTimeIndex,
+                           & localEventTimeSize,
+                           & nodeParentEvent,
+                           & nodeParentAtRisk,
+                           & nodeLeftEvent,
+                           & nodeLeftAtRisk,
+                           & nodeRightEvent,
+                           & nodeRightAtRisk);
+   }
+    uint actualCovariateCount = 0;
+    uint candidateCovariateCount = 0;
+    while (selectRandomCovariates(treeID,
+                                  parent,
+                                  repMembrIndx,
+                                  repMembrSize,
+                                  randomCovariateIndex,
+                                  & uniformCovariateSize,
+                                  & uniformCovariateIndex,
+                                  cdf,
+                                  & cdfSize,
+                                  cdfSort,
+                                  density,
+                                  & densitySize,
+                                  densitySwap,
+                                  & covariate,
+                                  & actualCovariateCount,
+                                  & candidateCovariateCount,
+                                  splitVector,
+                                  & splitVectorSize,
+                                  & indxx,
+                                  nonMissMembrSizeStatic,
+                                  nonMissMembrIndxStatic,
+                                  & nonMissMembrSize,
+                                  & nonMissMembrIndx,
+                                  multImpFlag)) {
+      splitLength = stackAndConstructSplitVector(treeID,
+                                                 repMembrSize,
+                                                 covariate,
+                                                 splitVector,
+                                                 splitVectorSize,
+                                                 & factorFlag,
+                                                 & deterministicSplitFlag,
+                                                 & mwcpSizeAbsolute,
+                                                 & splitVectorPtr);
+      if (!((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP)))) {
+        stackAndGetSplitSurv(treeID,
+                             repMembrIndx,
+                             repMembrSize,
+                             nonMissMembrIndx,
+                             nonMissMembrSize,
+                             & localEventTimeCount,
+                             & localEventTimeIndex,
+                             & localEventTimeSize,
+                             & nodeParentEvent,
+                             & nodeParentAtRisk,
+                             & nodeLeftEvent,
+                             & nodeLeftAtRisk,
+                             & nodeRightEvent,
+                             & nodeRightAtRisk);
+      }
+      if (localEventTimeSize > 0) {
+        for (j = 1; j <= repMembrSize; j++) {
+          localSplitIndicator[j] = NEITHER;
+        }
+        leftSize = 0;
+        priorMembrIter = 0;
+        if (factorFlag == FALSE) {
+          for (j = 1; j <= nonMissMembrSize; j++) {
+            localSplitIndicator[ nonMissMembrIndx[indxx[j]] ] = RIGHT;
+          }
+        }
+        double *userTime  = dvector(1, nonMissMembrSize);
+        double *userEvent = dvector(1, nonMissMembrSize);
+        double *userEventTime = dvector(1, localEventTimeSize);
+        char   *userSplitIndicator = cvector(1, nonMissMembrSize);
+        uint   *userSort  = uivector(1, nonMissMembrSize);
+        double *tempTime  = dvector(1, nonMissMembrSize);
+        for (k = 1; k <= nonMissMembrSize; k++) {
+          tempTime[k]  = RF_time[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ];
+        }
+        indexx(nonMissMembrSize, tempTime, userSort);
+        for (k = 1; k <= nonMissMembrSize; k++) {
+          userTime[k]  = RF_time[treeID][ repMembrIndx[nonMissMembrIndx[indxx[userSort[k]]]] ];
+          userEvent[k] = RF_status[treeID][ repMembrIndx[nonMissMembrIndx[indxx[userSort[k]]]] ];
+        }
+        for (m = 1; m <= localEventTimeSize; m++) {
+          userEventTime[m] = RF_masterTime[localEventTimeIndex[m]];
+        }
+        for (j = 1; j < splitLength; j++) {
+          if (factorFlag == TRUE) {
+            priorMembrIter = 0;
+            leftSize = 0;
+          }
+          virtuallySplitNode(treeID,
+                             factorFlag,
+                             mwcpSizeAbsolute,
+                             covariate,
+                             repMembrIndx,
+                             repMembrSize,
+                             nonMissMembrIndx,
+                             nonMissMembrSize,
+                             indxx,
+                             splitVectorPtr,
+                             j,
+                             localSplitIndicator,
+                             & leftSize,
+                             priorMembrIter,
+                             & currentMembrIter);
+          for (k = 1; k <= nonMissMembrSize; k++) {
+            userSplitIndicator[k] = localSplitIndicator[ nonMissMembrIndx[indxx[userSort[k]]] ];
+          }
+          delta = customFunctionArray[CRSK_FAM][RF_splitCustomIdx](nonMissMembrSize,
+                                                                   userSplitIndicator,
+                                                                   userTime,
+                                                                   userEvent,
+                                                                   RF_eventType[RF_eventTypeSize],
+                                                                   localEventTimeSize,
+                                                                   userEventTime,
+                                                                   NULL,
+                                                                   0,
+                                                                   0,
+                                                                   0);
+          updateMaximumSplit(treeID,
+                             parent,
+                             delta,
+                             candidateCovariateCount,
+                             covariate,
+                             j,
+                             factorFlag,
+                             mwcpSizeAbsolute,
+                             repMembrSize,
+                             localSplitIndicator,
+                             & deltaMax,
+                             splitParameterMax,
+                             splitValueMaxCont,
+                             splitValueMaxFactSize,
+                             splitValueMaxFactPtr,
+                             splitVectorPtr,
+                             splitIndicator);
+          if (factorFlag == FALSE) {
+            priorMembrIter = currentMembrIter - 1;
+          }
+        }  
+        free_uivector(userSort, 1, nonMissMembrSize);
+        free_dvector(tempTime, 1, nonMissMembrSize);
+        free_dvector (userTime, 1, nonMissMembrSize);
+        free_dvector (userEvent, 1, nonMissMembrSize);
+        free_dvector (userEventTime, 1, localEventTimeSize);
+        free_cvector (userSplitIndicator, 1, nonMissMembrSize);
+      }  
+      else {
+      }
+      unstackSplitVector(treeID,
+                         splitVectorSize,
+                         splitLength,
+                         factorFlag,
+                         deterministicSplitFlag,
+                         mwcpSizeAbsolute,
+                         splitVectorPtr);
+      unselectRandomCovariates(treeID,
+                               parent,
+                               repMembrSize,
+                               indxx,
+                               nonMissMembrSizeStatic,
+                               nonMissMembrIndx,
+                               multImpFlag);
+      if (!((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP)))) {
+        unstackSplitSurv(localEventTimeCount,
+                         localEventTimeIndex,
+                         localEventTimeSize,
+                         nodeParentEvent,
+                         nodeParentAtRisk,
+                         nodeLeftEvent,
+                         nodeLeftAtRisk,
+                         nodeRightEvent,
+                         nodeRightAtRisk);
+      }
+    }  
+    if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
+        unstackSplitSurv(localEventTimeCount,
+                         localEventTimeIndex,
+                         localEventTimeSize,
+                         nodeParentEvent,
+                         nodeParentAtRisk,
+                         nodeLeftEvent,
+                         nodeLeftAtRisk,
+                         nodeRightEvent,
+                         nodeRightAtRisk);
+    }
+    unstackRandomCovariates(treeID,
+                            parent,
+                            randomCovariateIndex,
+                            uniformCovariateSize,
+                            cdf,
+                            cdfSize,
+                            cdfSort,
+                            density,
+                            densitySize,
+                            densitySwap,
+                            repMembrSize);
+    unstackSplitIndicator(repMembrSize, localSplitIndicator);
+  }  
+  unstackPreSplit(preliminaryResult,
+                  multImpFlag,
+                  FALSE,  
+                  repMembrSize,
+                  splitVector,
+                  nonMissMembrIndxStatic);
+  result = summarizeSplitResult(*splitParameterMax,
+                                *splitValueMaxCont,
+                                *splitValueMaxFactSize,
+                                *splitValueMaxFactPtr,
+                                splitStatistic,
+                                deltaMax);
+  return result;
+}
+void stackSplitIndicator(uint   nodeSize,
+                         char **localSplitIndicator) {
+  if (nodeSize > 0) {
+    *localSplitIndicator = cvector(1, nodeSize);
+  }
+}
+void unstackSplitIndicator(uint  nodeSize,
+                           char *localSplitIndicator) {
+  if (nodeSize > 0) {
+    if (nodeSize > 0) {
+      free_cvector(localSplitIndicator, 1, nodeSize);
+    }
+  }
+}
+void stackSplitEventScratch(uint treeID) {
+  uint i;
+  RF_splitEventTimeCount[treeID] = uivector(1, RF_masterTimeSize);
+  RF_splitEventTimeIndex[treeID] = uivector(1, RF_masterTimeSize);
+  for (i = 1; i <= RF_masterTimeSize; i++) {
+    RF_splitEventTimeCount[treeID][i] = 0;
+  }
+}
+void unstackSplitEventScratch(uint treeID) {
+  free_uivector(RF_splitEventTimeCount[treeID], 1, RF_masterTimeSize);
+  free_uivector(RF_splitEventTimeIndex[treeID], 1, RF_masterTimeSize);
+  RF_splitEventTimeCount[treeID] = NULL;
+  RF_splitEventTimeIndex[treeID] = NULL;
+}
+void stackSplitEventTime(uint   treeID,
+                         uint **localEventTimeCount,
+                         uint **localEventTimeIndex) {
+  *localEventTimeCount = RF_splitEventTimeCount[treeID];
+  *localEventTimeIndex = RF_splitEventTimeIndex[treeID];
+}
+void unstackSplitEventTime(uint *localEventTimeCount,
+                           uint *localEventTimeIndex,
+                           uint  eventTimeSize) {
+  uint i;
+  for (i = 1; i <= eventTimeSize; i++) {
+    localEventTimeCount[localEventTimeIndex[i]] = 0;
+  }
+}
+uint getSplitEventTime(uint   treeID,
+                       uint   *repMembrIndx,
+                       uint    repMembrSize,
+                       uint   *nonMissMembrIndx,
+                       uint    nonMissMembrSize,
+                       uint   *localEventTimeCount,
+                       uint   *localEventTimeIndex) {
+  uint i, timeIndex;
+  uint eventTimeSize;
+  eventTimeSize = 0;
+  for (i = 1; i <= nonMissMembrSize; i++) {
+    if (RF_status[treeID][ repMembrIndx[nonMissMembrIndx[i]] ] > 0) {
+      timeIndex = RF_masterTimeIndex[treeID][ repMembrIndx[nonMissMembrIndx[i]] ];
+      if (localEventTimeCount[timeIndex] == 0) {
+        localEventTimeIndex[++eventTimeSize] = timeIndex;
+      }
+      localEventTimeCount[timeIndex] ++;
+    }
+  }
+  hpsortui(localEventTimeIndex, eventTimeSize);
+  return (eventTimeSize);
+}
+void stackSplitEventAndRisk(uint   eventTimeSize,
+                            uint **nodeParentEvent,
+                            uint **nodeParentAtRisk,
+                            uint **nodeLeftEvent,
+                            uint **nodeLeftAtRisk,
+                            uint **nodeRightEvent,
+                            uint **nodeRightAtRisk) {
+  if (eventTimeSize > 0) {
+    *nodeParentEvent  = uivector(1, eventTimeSize);
+    *nodeParentAtRisk = uivector(1, eventTimeSize);
+    *nodeLeftEvent  = uivector(1, eventTimeSize);
+    *nodeLeftAtRisk = uivector(1, eventTimeSize);
+    *nodeRightEvent  = uivector(1, eventTimeSize);
+    *nodeRightAtRisk = uivector(1, eventTimeSize);
+  }
+  else {
+    *nodeParentEvent = *nodeParentAtRisk = *nodeLeftEvent  = *nodeLeftAtRisk = *nodeRightEvent  = *nodeRightAtRisk = NULL;
+  }
+}
+void unstackSplitEventAndRisk(uint  eventTimeSize,
+                              uint *nodeParentEvent,
+                              uint *nodeParentAtRisk,
+                              uint *nodeLeftEvent,
+                              uint *nodeLeftAtRisk,
+                              uint *nodeRightEvent,
+                              uint *nodeRightAtRisk) {
+  if (eventTimeSize > 0) {
+    free_uivector(nodeParentEvent, 1, eventTimeSize);
+    free_uivector(nodeParentAtRisk, 1, eventTimeSize);
+    free_uivector(nodeLeftEvent, 1, eventTimeSize);
+    free_uivector(nodeLeftAtRisk, 1, eventTimeSize);
+    free_uivector(nodeRightEvent, 1, eventTimeSize);
+    free_uivector(nodeRightAtRisk, 1, eventTimeSize);
+  }
+}
+void getSplitEventAndRisk(uint    treeID,
+                          uint   *repMembrIndx,
+                          uint    repMembrSize,
+                          uint   *nonMissMembrIndx,
+                          uint    nonMissMembrSize,
+                          uint   *localEventTimeCount,
+                          uint   *localEventTimeIndex,
+                          uint    localEventTimeSize,
+                          uint   *nodeParentEvent,
+                          uint   *nodeParentAtRisk) {
+  uint i, low, high, mid, timeIndex;
+  for (i=1; i <= localEventTimeSize; i++) {
+    nodeParentAtRisk[i] = 0;
+    nodeParentEvent[i] = localEventTimeCount[localEventTimeIndex[i]];
+  }
+  for (i = 1; i <= nonMissMembrSize; i++) {
+    timeIndex = RF_masterTimeIndex[treeID][ repMembrIndx[nonMissMembrIndx[i]] ];
+    low = 0;
+    high = localEventTimeSize;
+    while (low < high) {
+      mid = (low + high + 1) >> 1;
+      if (localEventTimeIndex[mid] <= timeIndex) {
+        low = mid;
+      }
+      else {
+        high = mid - 1;
+      }
+    }
+    if (low > 0) {
+      nodeParentAtRisk[low] ++;
+    }
+  }
+  for (i = localEventTimeSize; i > 1; i--) {
+    nodeParentAtRisk[i-1] += nodeParentAtRisk[i];
+  }
+}
+void stackAndGetSplitSurv(uint    treeID,
+                          uint   *repMembrIndx,
+                          uint    repMembrSize,
+                          uint   *nonMissMembrIndx,
+                          uint    nonMissMembrSize,
+                          uint  **localEventTimeCount,
+                          uint  **localEventTimeIndex,
+                          uint   *localEventTimeSize,
+                          uint  **nodeParentEvent,
+                          uint  **nodeParentAtRisk,
+                          uint  **nodeLeftEvent,
+                          uint  **nodeLeftAtRisk,
+                          uint  **nodeRightEvent,
+                          uint  **nodeRightAtRisk) {
+  stackSplitEventTime(treeID, localEventTimeCount, localEventTimeIndex);
+  *localEventTimeSize = getSplitEventTime( treeID,
+                                           repMembrIndx,
+                                           repMembrSize,
+                                           nonMissMembrIndx,
+                                           nonMissMembrSize,
+                                          *localEventTimeCount,
+                                          *localEventTimeIndex);
+  stackSplitEventAndRisk(*localEventTimeSize,
+                          nodeParentEvent,
+                          nodeParentAtRisk,
+                          nodeLeftEvent,
+                          nodeLeftAtRisk,
+                          nodeRightEvent,
+                          nodeRightAtRisk);
+  getSplitEventAndRisk( treeID,
+                        repMembrIndx,
+                        repMembrSize,
+                        nonMissMembrIndx,
+                        nonMissMembrSize,
+                       *localEventTimeCount,
+                       *localEventTimeIndex,
+                       *localEventTimeSize,
+                       *nodeParentEvent,
+                       *nodeParentAtRisk);
+}
+void unstackSplitSurv(uint *localEventTimeCount,
+                      uint *localEventTimeIndex,
+                      uint  eventTimeSize,
+                      uint *nodeParentEvent,
+                      uint *nodeParentAtRisk,
+                      uint *nodeLeftEvent,
+                      uint *nodeLeftAtRisk,
+                      uint *nodeRightEvent,
+                      uint *nodeRightAtRisk) {
+  unstackSplitEventTime(localEventTimeCount,
+                        localEventTimeIndex,
+                        eventTimeSize);
+  unstackSplitEventAndRisk(eventTimeSize,
+                           nodeParentEvent,
+                           nodeParentAtRisk,
+                           nodeLeftEvent,
+                           nodeLeftAtRisk,
+                           nodeRightEvent,
+                           nodeRightAtRisk);
+}
+void stackLogRankIncrement(uint     repMembrSize,
+                           uint     localEventTimeSize,
+                           uint   **membrTimeIndex,
+                           double **eventRatioSum,
+                           double **riskRatioSum,
+                           double **riskRatioSqrSum,
+                           double **fenwickCount,
+                           double **fenwickSum) {
+  if (localEventTimeSize > 0) {
+    *membrTimeIndex  = uivector(1, repMembrSize);
+    *eventRatioSum   = dvector(0, localEventTimeSize);
+    *riskRatioSum    = dvector(0, localEventTimeSize);
+    *riskRatioSqrSum = dvector(0, localEventTimeSize);
+    *fenwickCount    = dvector(1, localEventTimeSize);
+    *fenwickSum      = dvector(1, localEventTimeSize);
+  }
+  else {
+    *membrTimeIndex = NULL;
+    *eventRatioSum = *riskRatioSum = *riskRatioSqrSum = *fenwickCount = *fenwickSum = NULL;
+  }
+}
+void unstackLogRankIncrement(uint    repMembrSize,
+                             uint    localEventTimeSize,
+                             uint   *membrTimeIndex,
+                             double *eventRatioSum,
+                             double *riskRatioSum,
+                             double *riskRatioSqrSum,
+                             double *fenwickCount,
+                             double *fenwickSum) {
+  if (localEventTimeSize > 0) {
+    free_uivector(membrTimeIndex, 1, repMembrSize);
+    free_dvector(eventRatioSum, 0, localEventTimeSize);
+    free_dvector(riskRatioSum, 0, localEventTimeSize);
+    free_dvector(riskRatioSqrSum, 0, localEventTimeSize);
+    free_dvector(fenwickCount, 1, localEventTimeSize);
+    free_dvector(fenwickSum, 1, localEventTimeSize);
+  }
+}
+void getLogRankIncrement(uint    treeID,
+                         uint   *repMembrIndx,
+                         uint   *nonMissMembrIndx,
+                         uint    nonMissMembrSize,
+                         uint   *localEventTimeIndex,
+                         uint    localEventTimeSize,
+                         uint   *nodeParentEvent,
+                         uint   *nodeParentAtRisk,
+                         uint   *membrTimeIndex,
+                         double *eventRatioSum,
+                         double *riskRatioSum,
+                         double *riskRatioSqrSum) {
+  uint i, low, high, mid, timeIndex;
+  double variance;
+  eventRatioSum[0] = riskRatioSum[0] = riskRatioSqrSum[0] = 0.0;
+  for (i = 1; i <= localEventTimeSize; i++) {
+    variance = 0.0;
+    if (nodeParentAtRisk[i] >= 2) {
+      variance = ((double) (nodeParentAtRisk[i] - nodeParentEvent[i]) / (nodeParentAtRisk[i] - 1)) * nodeParentEvent[i];
+    }
+    eventRatioSum[i]   = eventRatioSum[i-1]   + ((double) nodeParentEvent[i] / nodeParentAtRisk[i]);
+    riskRatioSum[i]    = riskRatioSum[i-1]    + (variance / nodeParentAtRisk[i]);
+    riskRatioSqrSum[i] = riskRatioSqrSum[i-1] + (variance / ((double) nodeParentAtRisk[i] * nodeParentAtRisk[i]));
+  }
+  for (i = 1; i <= nonMissMembrSize; i++) {
+    timeIndex = RF_masterTimeIndex[treeID][ repMembrIndx[nonMissMembrIndx[i]] ];
+    low = 0;
+    high = localEventTimeSize;
+    while (low < high) {
+      mid = (low + high + 1) >> 1;
+      if (localEventTimeIndex[mid] <= timeIndex) {
+        low = mid;
+      }
+      else {
+        high = mid - 1;
+      }
+    }
+    membrTimeIndex[nonMissMembrIndx[i]] = low;
+  }
+}
+void getLogRankScore(uint    treeID,
+                     uint   *repMembrIndx,
+                     uint   *nonMissMembrIndx,
+                     uint    nonMissMembrSize,
+                     double *survivalRank,
+                     double *meanSurvRank,
+                     double *varSurvRank) {
+  double *survivalTime;
+  uint   *survivalTimeIndx;
+  double  cumulativeHazard, cumulativeStep;
+  uint    i, j, k;
+  *meanSurvRank = *varSurvRank = 0.0;
+  if (nonMissMembrSize == 0) {
+    return;
+  }
+  survivalTime = dvector(1, nonMissMembrSize);
+  survivalTimeIndx = uivector(1, nonMissMembrSize);
+  for (i = 1; i <= nonMissMembrSize; i++) {
+    survivalTime[i] = (double) RF_masterTimeIndex[treeID][ repMembrIndx[nonMissMembrIndx[i]] ];
+  }
+  indexx(nonMissMembrSize, survivalTime, survivalTimeIndx);
+  cumulativeHazard = 0.0;
+  i = 1;
+  while (i <= nonMissMembrSize) {
+    j = i;
+    cumulativeStep = 0.0;
+    while ((j <= nonMissMembrSize) && (survivalTime[survivalTimeIndx[j]] == survivalTime[survivalTimeIndx[i]])) {
+      cumulativeStep = cumulativeStep + RF_status[treeID][ repMembrIndx[nonMissMembrIndx[survivalTimeIndx[j]]] ];
+      j++;
+    }
+    cumulativeHazard = cumulativeHazard + (cumulativeStep / (nonMissMembrSize - (j - 1) + 1));
+    for (k = i; k < j; k++) {
+      survivalRank[nonMissMembrIndx[survivalTimeIndx[k]]] = RF_status[treeID][ repMembrIndx[nonMissMembrIndx[survivalTimeIndx[k]]] ] - cumulativeHazard;
+      *meanSurvRank = *meanSurvRank + survivalRank[nonMissMembrIndx[survivalTimeIndx[k]]];
+      *varSurvRank = *varSurvRank + pow(survivalRank[nonMissMembrIndx[survivalTimeIndx[k]]], 2.0);
+    }
+    i = j;
+  }
+  *varSurvRank = ( *varSurvRank - (pow(*meanSurvRank, 2.0) / nonMissMembrSize) ) / (nonMissMembrSize - 1);
+  *meanSurvRank = *meanSurvRank / nonMissMembrSize;
+  free_dvector(survivalTime, 1, nonMissMembrSize);
+  free_uivector(survivalTimeIndx, 1, nonMissMembrSize);
+}
+void getLogRankTimeRank(uint    treeID,
+                        uint   *repMembrIndx,
+                        uint   *nonMissMembrIndx,
+                        uint    nonMissMembrSize,
+                        uint   *survivalTimeRank) {
+  double *survivalTime;
+  uint   *survivalTimeIndx;
+  uint    i, j, k;
+  if (nonMissMembrSize == 0) {
+    return;
+  }
+  survivalTime = dvector(1, nonMissMembrSize);
+  survivalTimeIndx = uivector(1, nonMissMembrSize);
+  for (i = 1; i <= nonMissMembrSize; i++) {
+    survivalTime[i] = (double) RF_masterTimeIndex[treeID][ repMembrIndx[nonMissMembrIndx[i]] ];
+  }
+  indexx(nonMissMembrSize, survivalTime, survivalTimeIndx);
+  i = 1;
+  while (i <= nonMissMembrSize) {
+    j = i;
+    while ((j <= nonMissMembrSize) && (survivalTime[survivalTimeIndx[j]] == survivalTime[survivalTimeIndx[i]])) {
+      j++;
+    }
+    for (k = i; k < j; k++) {
+      survivalTimeRank[nonMissMembrIndx[survivalTimeIndx[k]]] = j - 1;
+    }
+    i = j;
+  }
+  free_dvector(survivalTime, 1, nonMissMembrSize);
+  free_uivector(survivalTimeIndx, 1, nonMissMembrSize);
+}
+void getLogRankCovariateScore(uint    treeID,
+                              uint   *repMembrIndx,
+                              uint   *nonMissMembrIndx,
+                              uint    nonMissMembrSize,
+                              uint   *indxx,
+                              uint   *survivalTimeRank,
+                              double *survivalRank,
+                              double *meanSurvRank,
+                              double *varSurvRank) {
+  double *cumulativeScore;
+  double  score;
+  uint    k;
+  cumulativeScore = dvector(0, nonMissMembrSize);
+  cumulativeScore[0] = 0.0;
+  for (k = 1; k <= nonMissMembrSize; k++) {
+    cumulativeScore[k] = cumulativeScore[k-1] + (RF_status[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] / (nonMissMembrSize - survivalTimeRank[nonMissMembrIndx[indxx[k]]] + 1) );
+  }
+  *meanSurvRank = *varSurvRank = 0;
+  for (k = 1; k <= nonMissMembrSize; k++) {
+    score = RF_status[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ] - cumulativeScore[ survivalTimeRank[nonMissMembrIndx[indxx[k]]] ];
+    survivalRank[nonMissMembrIndx[k]] = score;
+    *meanSurvRank = *meanSurvRank + score;
+    *varSurvRank = *varSurvRank + pow(score, 2.0);
+  }
+  *varSurvRank = ( *varSurvRank - (pow(*meanSurvRank, 2.0) / nonMissMembrSize) ) / (nonMissMembrSize - 1);
+  *meanSurvRank = *meanSurvRank / nonMissMembrSize;
+  free_dvector(cumulativeScore, 0, nonMissMembrSize);
+}
+void updateFenwick(double *tree, uint size, uint index, double value) {
+  while (index <= size) {
+    tree[index] += value;
+    index += index & (~index + 1);
+  }
+}
+double sumFenwick(double *tree, uint index) {
+  double result;
+  result = 0.0;
+  while (index > 0) {
+    result += tree[index];
+    index -= index & (~index + 1);
+  }
+  return result;
+}
+uint stackAndConstructSplitVector (uint     treeID,
+                                   uint     repMembrSize,
+                                   uint     randomCovariateIndex,
+                                   double  *splitVector,
+                                   uint     splitVectorSize,
+                                   char    *factorFlag,
+                                   char    *deterministicSplitFlag,
+                                   uint    *mwcpSizeAbsolute,
+                                   void   **splitVectorPtr) {
+  uint  sworIndex;
+  uint *sworVector;
+  uint  sworVectorSize;
+  uint j, j2, k2;
+  uint factorSizeAbsolute;
+  uint offset;
+  uint splitLength;
+  uint relativePair;
+  splitLength = 0;  
+  (*splitVectorPtr) = NULL;  
+  if (strcmp(RF_xType[randomCovariateIndex], "C") == 0) {
+    *factorFlag = TRUE;
+    if(RF_factorList[treeID][splitVectorSize] == NULL) {
+      RF_factorList[treeID][splitVectorSize] = makeFactor(splitVectorSize, FALSE);
+    }
+    factorSizeAbsolute = RF_xFactorSize[RF_xFactorMap[randomCovariateIndex]];
+    *mwcpSizeAbsolute = RF_factorList[treeID][factorSizeAbsolute] -> mwcpSize;
+    if (RF_splitRule == RAND_SPLIT) {
+      splitLength = 1 + 1;
+      *deterministicSplitFlag = FALSE;
+    }
+    else {
+      if(RF_splitRandomCount == 0) {
+        *deterministicSplitFlag = TRUE;
+        if ((RF_factorList[treeID][splitVectorSize] -> r) > MAX_EXACT_LEVEL) {
+          *deterministicSplitFlag = FALSE;
+        }
+        else {
+          if ( *((uint *) RF_factorList[treeID][splitVectorSize] -> complementaryPairCount) >= repMembrSize ) {
+            *deterministicSplitFlag = FALSE;
+          }
+        }
+        if (*deterministicSplitFlag == FALSE) {
+          splitLength = repMembrSize + 1;
+        }
+        else {
+          splitLength = *((uint*) RF_factorList[treeID][splitVectorSize] -> complementaryPairCount) + 1;
+        }
+      }
+      else {
+        *deterministicSplitFlag = FALSE;
+        if ((RF_factorList[treeID][splitVectorSize] -> r) <= MAX_EXACT_LEVEL) {
+          if (*((uint*) RF_factorList[treeID][splitVectorSize] -> complementaryPairCount) <= ((RF_splitRandomCount <= repMembrSize) ? RF_splitRandomCount : repMembrSize)) {
+            splitLength = *((uint*) RF_factorList[treeID][splitVectorSize] -> complementaryPairCount) + 1;
+            *deterministicSplitFlag = TRUE;
+          }
+        }
+        if (*deterministicSplitFlag == FALSE) {
+          splitLength = 1 + ((RF_splitRandomCount <= repMembrSize) ? RF_splitRandomCount : repMembrSize);
+        }
+      }  
+    }  
+    (*splitVectorPtr) = uivector(1, splitLength * (*mwcpSizeAbsolute));
+    for (offset = 1; offset <= *mwcpSizeAbsolute; offset++) {
+      ((uint*) (*splitVectorPtr) + ((splitLength - 1) * (*mwcpSizeAbsolute)))[offset] = 0;
+    }
+    if (*deterministicSplitFlag) {
+      bookFactor(RF_factorList[treeID][splitVectorSize]);
+      j2 = 0;
+      for (j = 1; j <= RF_factorList[treeID][splitVectorSize] -> cardinalGroupCount; j++) {
+        for (k2 = 1; k2 <= ((uint*) RF_factorList[treeID][splitVectorSize] -> cardinalGroupSize)[j]; k2++) {
+          ++j2;
+          relativePair = (RF_factorList[treeID][splitVectorSize] -> cardinalGroupBinary)[j][k2];
+          convertRelToAbsBinaryPair(treeID,
+                                    splitVectorSize,
+                                    factorSizeAbsolute,
+                                    relativePair,
+                                    splitVector,
+                                    (uint*) (*splitVectorPtr) + ((j2 - 1) * (*mwcpSizeAbsolute)));
+        }
+      }
+    }  
+    else {
+      for (j = 1; j < splitLength; j++) {
+        getRandomPair(treeID, splitVectorSize, factorSizeAbsolute, splitVector, (uint*) (*splitVectorPtr) + ((j - 1) * (*mwcpSizeAbsolute)));
+      }
+    }
+  }  
+  else {
+    *factorFlag = FALSE;
+    if (RF_splitRule == RAND_SPLIT) {
+      splitLength = 1 + 1;
+      *deterministicSplitFlag = FALSE;
+    }
+    else {
+      if(RF_splitRandomCount == 0) {
+        splitLength = splitVectorSize;
+        (*splitVectorPtr) = splitVector;
+        *deterministicSplitFlag = TRUE;
+      }
+      else {
+        if (splitVectorSize <= RF_splitRandomCount) {
+          splitLength = splitVectorSize;
+          (*splitVectorPtr) = splitVector;
+          *deterministicSplitFlag = TRUE;
+        }
+        else {
+          splitLength = RF_splitRandomCount + 1;
+          *deterministicSplitFlag = FALSE;
+        }
+      }  
+    }  
+    if (*deterministicSplitFlag == FALSE) {
+      (*splitVectorPtr) = dvector(1, splitLength);
+      ((double*) (*splitVectorPtr))[splitLength] = 0;
+      if (RF_splitRule == RAND_SPLIT) {
+        ((double*) (*splitVectorPtr))[1]  = splitVector[(uint) ceil(ran1B(treeID) * ((splitVectorSize - 1) * 1.0))];
+      }
+      else {
+        sworVector = uivector(1, splitVectorSize);
+        sworVectorSize = splitVectorSize - 1;
+        for (j = 1; j <= sworVectorSize; j++) {
+          sworVector[j] = j;
+        }
+        for (j = 1; j < splitLength; j++) {
+          sworIndex = (uint) ceil(ran1B(treeID) * (sworVectorSize * 1.0));
+          ((double*) (*splitVectorPtr))[j]  = splitVector[sworVector[sworIndex]];
+          sworVector[sworIndex] = sworVector[sworVectorSize];
+          sworVectorSize --;
+        }
+        free_uivector (sworVector, 1, splitVectorSize);
+        sort(((double*) (*splitVectorPtr)), splitLength-1);
+      }
+    }
+  }  
+  return splitLength;
+}
+void unstackSplitVector(uint   treeID,
+                        uint   splitVectorSize,
+                        uint   splitLength,
+                        char   factorFlag,
+                        char   deterministicSplitFlag,
+                        uint   mwcpSizeAbsolute,
+                        void  *splitVectorPtr) {
+  if (factorFlag == TRUE) {
+    free_uivector(splitVectorPtr, 1, splitLength * mwcpSizeAbsolute);
+    if (deterministicSplitFlag == FALSE) {
+      if (splitVectorSize > SAFE_FACTOR_SIZE) {
+        unbookFactor(RF_factorList[treeID][splitVectorSize]);
+      }
+    }
+  }
+  else {
+    if (deterministicSplitFlag == FALSE) {
+      free_dvector(splitVectorPtr, 1, splitLength);
+    }
+  }
+}
+void stackRandomCovariates(uint      treeID,
+                           Node     *parent,
+                           uint      repMembrSize,
+                           char      multImpFlag,
+                           uint    **covariateIndex,
+                           uint     *covariateSize,
+                           double  **cdf,
+                           uint     *cdfSize,
+                           uint    **cdfSort,
+                           uint    **density,
+                           uint     *densitySize,
+                           uint   ***densitySwap) {
+  initializeCDF(treeID,
+                (RF_xWeightType == RF_WGHT_UNIFORM) ? NULL : NULL, 
+                (RF_xWeightType == RF_WGHT_UNIFORM) ? (parent -> permissibleSplit) : (parent -> permissibleSplit),
+                (RF_xWeightType == RF_WGHT_UNIFORM) ? parent -> xSize : parent -> xSize,
+                RF_xWeightType,
+                RF_xWeight,
+                RF_xWeightSorted,
+                RF_xWeightDensitySize,
+                covariateIndex,
+                covariateSize,
+                cdf,
+                cdfSize,
+                cdfSort,
+                density,
+                densitySize,
+                densitySwap);
+}
+void unstackRandomCovariates(uint     treeID,
+                             Node    *parent,
+                             uint    *covariateIndex,
+                             uint     covariateSize,
+                             double  *cdf,
+                             uint     cdfSize,
+                             uint    *cdfSort,
+                             uint    *density,
+                             uint     densitySize,
+                             uint   **densitySwap,
+                             uint     repMembrSize) {
+  discardCDF(treeID,
+             (RF_xWeightType == RF_WGHT_UNIFORM) ? parent -> xSize : parent -> xSize,
+             RF_xWeightType,
+             RF_xWeight,
+             RF_xWeightDensitySize,
+             covariateIndex,
+             density,
+             densitySwap,
+             cdf,
+             cdfSort);
+}
+char selectRandomCovariates(uint     treeID,
+                            Node     *parent,
+                            uint     *repMembrIndx,
+                            uint      repMembrSize,
+                            uint     *covariateIndex,
+                            uint     *uniformCovariateSize,
+                            uint     *uniformCovariateIndex,
+                            double   *cdf,
+                            uint     *cdfSize,
+                            uint     *cdfSort,
+                            uint     *density,
+                            uint     *densitySize,
+                            uint    **densitySwap,
+                            uint     *covariate,
+                            uint     *actualCovariateCount,
+                            uint     *candidateCovariateCount,
+                            double   *splitVector,
+                            uint     *splitVectorSize,
+                            uint    **indxx,
+                            uint      nonMissMembrSizeStatic,
+                            uint     *nonMissMembrIndxStatic,
+                            uint     *nonMissMembrSize,
+                            uint    **nonMissMembrIndx,
+                            char      multImpFlag) {
+  uint i, ii;
+  uint binMin, binMax;
+  uint candidateCovariate;
+  uint offset;
+  double *nonMissSplit;
+  char mPredictorFlag;
+  char splittable;
+  if (nonMissMembrSizeStatic < 1) {
+    RFprintf("\nRF-SRC:  *** ERROR *** ");
+    RFprintf("\nRF-SRC:  Invalid nonMissMembrSizeStatic encountered in selectRandomCovariates():  %10d", nonMissMembrSizeStatic);
+    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+    error("\nRF-SRC:  The application will now exit.\n");
+  }
+  nonMissSplit = dvector(1, repMembrSize);
+  (*covariate) = candidateCovariate = -1;
+  splittable = FALSE;
+  if (RF_optHigh & OPT_SORT_ONCE) {
+    (*indxx) = NULL;
+  }
+  else {
+    (*indxx) = uivector(1, repMembrSize);
+  }
+  if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
+    *nonMissMembrSize = nonMissMembrSizeStatic;
+    *nonMissMembrIndx = nonMissMembrIndxStatic;
+  }
+  else {
+    *nonMissMembrSize = 0;
+    *nonMissMembrIndx = uivector(1, nonMissMembrSizeStatic);
+  }
+  while ( ((*candidateCovariateCount) < RF_randomCovariateCount) &&
+          (candidateCovariate != 0) && (splittable == FALSE)) {
+    candidateCovariate = sampleFromCDF(ran1B,
+                                       treeID,
+                                       RF_xWeightType,
+                                       covariateIndex,
+                                       *uniformCovariateSize,
+                                       uniformCovariateIndex,
+                                       cdf,
+                                       *cdfSize,
+                                       cdfSort,
+                                       density,
+                                       *densitySize);
+    if (candidateCovariate != 0) {
+      updateCDF(treeID,
+                RF_xWeightType,
+                RF_xWeight,
+                covariateIndex,
+                uniformCovariateSize,
+                *uniformCovariateIndex,
+                cdf,
+                cdfSize,
+                density,
+                densitySize,
+                densitySwap,
+                candidateCovariate);
+      (*actualCovariateCount) ++;
+      (*candidateCovariateCount) ++;
+      splittable = TRUE;
+      if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
+        for (i = 1; i <= repMembrSize; i++) {
+          nonMissSplit[i] = RF_observation[treeID][candidateCovariate][repMembrIndx[i]];
+        }
+        *nonMissMembrSize = nonMissMembrSizeStatic;
+        *nonMissMembrIndx = nonMissMembrIndxStatic;
+      }
+      else {
+        offset = RF_rSize + candidateCovariate;
+        (*nonMissMembrSize) = 0;
+        for (i = 1; i <= nonMissMembrSizeStatic; i++) {
+          ii = nonMissMembrIndxStatic[i];
+          mPredictorFlag = FALSE;
+          if (RF_mRecordMap[repMembrIndx[ii]] > 0) {
+            if (RF_mpSign[offset][RF_mRecordMap[repMembrIndx[ii]]] == 1) {
+                mPredictorFlag = TRUE;
+            }
+          }
+          if (!mPredictorFlag) {
+            (*nonMissMembrSize) ++;
+            (*nonMissMembrIndx)[*nonMissMembrSize] = ii;
+            nonMissSplit[*nonMissMembrSize] = RF_observation[treeID][candidateCovariate][repMembrIndx[(*nonMissMembrIndx)[*nonMissMembrSize]]];
+          }
+        }  
+      }  
+      if ((*nonMissMembrSize) == 0) {
+        splittable = FALSE;
+      }
+      if (splittable) {
+        if ((RF_optHigh & OPT_SPLT_HIST) && (RF_histBinSize[candidateCovariate] > 0)) {
+          binMin = binMax = RF_histBinCode[candidateCovariate][repMembrIndx[(*nonMissMembrIndx)[1]]];
+          for (i = 2; i <= (*nonMissMembrSize); i++) {
+            ii = RF_histBinCode[candidateCovariate][repMembrIndx[(*nonMissMembrIndx)[i]]];
+            if (ii < binMin) {
+              binMin = ii;
+            }
+            if (ii > binMax) {
+              binMax = ii;
+            }
+          }
+          (*splitVectorSize) = binMax - binMin + 1;
+        }
+        else {
+          if (RF_optHigh & OPT_SORT_ONCE) {
+            (*indxx) = RF_presortIndex[treeID][candidateCovariate] + (parent -> presortOffset);
+          }
+          else {
+            indexx((*nonMissMembrSize),
+                   nonMissSplit,
+                   (*indxx));
+          }
+          splitVector[1] = nonMissSplit[(*indxx)[1]];
+          (*splitVectorSize) = 1;
+          for (i = 2; i <= (*nonMissMembrSize); i++) {
+            if (nonMissSplit[(*indxx)[i]] > splitVector[(*splitVectorSize)]) {
+              (*splitVectorSize) ++;
+              splitVector[(*splitVectorSize)] = nonMissSplit[(*indxx)[i]];
+            }
+          }
+        }
+        if((*splitVectorSize) >= 2) {
+          (*covariate) = candidateCovariate;
+        }
+        else {
+          splittable = FALSE;
+        }
+      }  
+      if (!splittable) {
+        (parent -> permissibleSplit)[candidateCovariate] = FALSE;
+        (*actualCovariateCount) --;
+      }
+    }  
+    else {
+    }
+  }  
+  if (!splittable) {
+    if (!(RF_optHigh & OPT_SORT_ONCE)) {
+      free_uivector(*indxx, 1, repMembrSize);
+    }
+    if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
+      *nonMissMembrSize = 0;
+      *nonMissMembrIndx = NULL;
+    }
+    else {
+      *nonMissMembrSize = 0;
+      free_uivector(*nonMissMembrIndx, 1, nonMissMembrSizeStatic);
+    }
+  }
+  free_dvector(nonMissSplit, 1, repMembrSize);
+  return splittable;
+}
+void unselectRandomCovariates(uint      treeID,
+                              Node     *parent,
+                              uint      repMembrSize,
+                              uint     *indxx,
+                              uint     nonMissMembrSizeStatic,
+                              uint    *nonMissMembrIndx,
+                              char      multImpFlag) {
+  if (!(RF_optHigh & OPT_SORT_ONCE)) {
+    free_uivector((indxx), 1, repMembrSize);
+  }
+  if (!((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP)))) {
+    free_uivector(nonMissMembrIndx, 1, nonMissMembrSizeStatic);
+  }
+}
+uint getSplitCandidateSize() {
+  uint result;
+  result = 0;
+  if ((RF_optHigh & OPT_SPLT_PARL) && (!(RF_optHigh & OPT_SPLT_HIST))) {
+    result = 1;
+    if ((RF_numThreads > 1) && (RF_forestSize < (uint) RF_numThreads)) {
+      result = RF_numThreads;
+    }
+  }
+  return result;
+}
+SplitCandidate **stackSplitCandidates(uint candidateSize, uint repMembrSize, uint classSize) {
+  SplitCandidate **candidate;
+  uint c;
+  candidate = (SplitCandidate **) new_vvector(1, candidateSize, NRUTIL_SPTR);
+  for (c = 1; c <= candidateSize; c++) {
+    candidate[c] = (SplitCandidate *) gblock((size_t) sizeof(SplitCandidate));
+    candidate[c] -> splitVector         = dvector(1, repMembrSize);
+    candidate[c] -> localSplitIndicator = cvector(1, repMembrSize);
+    candidate[c] -> classSize           = classSize;
+    if (classSize > 0) {
+      candidate[c] -> parentClassProp = uivector(1, classSize);
+      candidate[c] -> leftClassProp   = uivector(1, classSize);
+      candidate[c] -> rghtClassProp   = uivector(1, classSize);
+    }
+    else {
+      candidate[c] -> parentClassProp = NULL;
+      candidate[c] -> leftClassProp   = NULL;
+      candidate[c] -> rghtClassProp   = NULL;
+    }
+  }
+  return candidate;
+}
+void unstackSplitCandidates(SplitCandidate **candidate, uint candidateSize, uint repMembrSize) {
+  uint c;
+  for (c = 1; c <= candidateSize; c++) {
+    free_dvector(candidate[c] -> splitVector, 1, repMembrSize);
+    free_cvector(candidate[c] -> localSplitIndicator, 1, repMembrSize);
+    if (candidate[c] -> classSize > 0) {
+      free_uivector(candidate[c] -> parentClassProp, 1, candidate[c] -> classSize);
+      free_uivector(candidate[c] -> leftClassProp, 1, candidate[c] -> classSize);
+      free_uivector(candidate[c] -> rghtClassProp, 1, candidate[c] -> classSize);
+    }
+    free_gblock(candidate[c], (size_t) sizeof(SplitCandidate));
+  }
+  free_new_vvector(candidate, 1, candidateSize, NRUTIL_SPTR);
+}
+uint selectSplitCandidates(uint             treeID,
+                           Node            *parent,
+                           uint            *repMembrIndx,
+                           uint             repMembrSize,
+                           uint            *covariateIndex,
+                           uint            *uniformCovariateSize,
+                           uint            *uniformCovariateIndex,
+                           double          *cdf,
+                           uint            *cdfSize,
+                           uint            *cdfSort,
+                           uint            *density,
+                           uint            *densitySize,
+                           uint           **densitySwap,
+                           uint            *actualCovariateCount,
+                           uint            *candidateCovariateCount,
+                           uint             nonMissMembrSizeStatic,
+                           uint            *nonMissMembrIndxStatic,
+                           char             multImpFlag,
+                           SplitCandidate **candidate,
+                           uint             candidateSize) {
+  SplitCandidate *current;
+  uint candidateCount;
+  candidateCount = 0;
+  while ((candidateCount < candidateSize) &&
+         selectRandomCovariates(treeID,
+                                parent,
+                                repMembrIndx,
+                                repMembrSize,
+                                covariateIndex,
+                                uniformCovariateSize,
+                                uniformCovariateIndex,
+                                cdf,
+                                cdfSize,
+                                cdfSort,
+                                density,
+                                densitySize,
+                                densitySwap,
+                                & candidate[candidateCount + 1] -> covariate,
+                                actualCovariateCount,
+                                candidateCovariateCount,
+                                candidate[candidateCount + 1] -> splitVector,
+                                & candidate[candidateCount + 1] -> splitVectorSize,
+                                & candidate[candidateCount + 1] -> indxx,
+                                nonMissMembrSizeStatic,
+                                nonMissMembrIndxStatic,
+                                & candidate[candidateCount + 1] -> nonMissMembrSize,
+                                & candidate[candidateCount + 1] -> nonMissMembrIndx,
+                                multImpFlag)) {
+    current = candidate[++candidateCount];
+    current -> candidateCovariateCount = *candidateCovariateCount;
+    current -> splitLength = stackAndConstructSplitVector(treeID,
+                                                          repMembrSize,
+                                                          current -> covariate,
+                                                          current -> splitVector,
+                                                          current -> splitVectorSize,
+                                                          & current -> factorFlag,
+                                                          & current -> deterministicSplitFlag,
+                                                          & current -> mwcpSizeAbsolute,
+                                                          & current -> splitVectorPtr);
+    current -> deltaMax          = NA_REAL;
+    current -> splitParameterMax = 0;
+    current -> splitValueMaxCont = NA_REAL;
+    if (current -> factorFlag == TRUE) {
+      current -> splitValueMaxFactSize = current -> mwcpSizeAbsolute;
+      current -> splitValueMaxFactPtr  = uivector(1, current -> splitValueMaxFactSize);
+    }
+    else {
+      current -> splitValueMaxFactSize = 0;
+      current -> splitValueMaxFactPtr  = NULL;
+    }
+  }
+  return candidateCount;
+}
+void unselectSplitCandidates(uint             treeID,
+                             Node            *parent,
+                             uint            *repMembrIndx,
+                             uint             repMembrSize,
+                             uint             nonMissMembrSizeStatic,
+                             char             multImpFlag,
+                             SplitCandidate **candidate,
+                             uint             candidateCount,
+                             double          *deltaMax,
+                             uint            *splitParameterMax,
+                             double          *splitValueMaxCont,
+                             uint            *splitValueMaxFactSize,
+                             uint           **splitValueMaxFactPtr,
+                             char           **splitIndicator) {
+  SplitCandidate *current;
+  char flag;
+  uint c, i, k;
+  for (c = 1; c <= candidateCount; c++) {
+    current = candidate[c];
+    if (ISNA(current -> deltaMax)) {
+      flag = FALSE;
+    }
+    else {
+      if (ISNA(*deltaMax)) {
+        flag = TRUE;
+      }
+      else {
+        if (((current -> deltaMax) - *deltaMax) > EPSILON) {
+          flag = TRUE;
+        }
+        else {
+          flag = FALSE;
+        }
+      }
+    }
+    if (flag) {
+      *deltaMax = current -> deltaMax;
+      *splitParameterMax = current -> splitParameterMax;
+      *splitValueMaxCont = current -> splitValueMaxCont;
+      if (*splitValueMaxFactSize > 0) {
+        free_uivector(*splitValueMaxFactPtr, 1, *splitValueMaxFactSize);
+      }
+      *splitValueMaxFactSize = current -> splitValueMaxFactSize;
+      *splitValueMaxFactPtr  = current -> splitValueMaxFactPtr;
+      current -> splitValueMaxFactSize = 0;
+      current -> splitValueMaxFactPtr  = NULL;
+      if (*splitIndicator == NULL) {
+        *splitIndicator = cvector(1, repMembrSize);
+      }
+      for (k = 1; k <= repMembrSize; k++) {
+        (*splitIndicator)[k] = NEITHER;
+      }
+      for (k = 1; k <= current -> nonMissMembrSize; k++) {
+        i = (current -> nonMissMembrIndx)[k];
+        if (current -> factorFlag == TRUE) {
+          (*splitIndicator)[i] = splitOnFactor((uint) RF_observation[treeID][current -> covariate][repMembrIndx[i]], *splitValueMaxFactPtr);
+        }
+        else {
+          (*splitIndicator)[i] = (RF_observation[treeID][current -> covariate][repMembrIndx[i]] <= *splitValueMaxCont) ? LEFT : RIGHT;
+        }
+      }
+    }
+    if (current -> splitValueMaxFactSize > 0) {
+      free_uivector(current -> splitValueMaxFactPtr, 1, current -> splitValueMaxFactSize);
+    }
+    unstackSplitVector(treeID,
+                       current -> splitVectorSize,
+                       current -> splitLength,
+                       current -> factorFlag,
+                       current -> deterministicSplitFlag,
+                       current -> mwcpSizeAbsolute,
+                       current -> splitVectorPtr);
+    unselectRandomCovariates(treeID,
+                             parent,
+                             repMembrSize,
+                             current -> indxx,
+                             nonMissMembrSizeStatic,
+                             current -> nonMissMembrIndx,
+                             multImpFlag);
+  }
+}
+uint virtuallySplitNode(uint  treeID,
+                           char  factorFlag,
+                           uint  mwcpSizeAbsolute,
+                           uint  randomCovariate,
+                           uint *repMembrIndx,
+                           uint  repMembrSize,
+                           uint *nonMissMembrIndx,
+                           uint  nonMissMembrSize,
+                           uint *indxx,
+                           void *splitVectorPtr,
+                           uint  offset,
+                           char *localSplitIndicator,
+                           uint *leftSize,
+                           uint  priorMembrIter,
+                           uint *currentMembrIter) {
+  char daughterFlag;
+  char iterFlag;
+  iterFlag = TRUE;
+  *currentMembrIter = priorMembrIter;
+  while (iterFlag) {
+    (*currentMembrIter) ++;
+    if (factorFlag == TRUE) {
+      daughterFlag = splitOnFactor((uint)  RF_observation[treeID][randomCovariate][    repMembrIndx[nonMissMembrIndx[indxx[*currentMembrIter]]]     ],
+                                   (uint*) splitVectorPtr + ((offset - 1) * mwcpSizeAbsolute));
+      if ((*currentMembrIter) == nonMissMembrSize) {
+        iterFlag = FALSE;
+      }
+    }
+    else {
+      if (RF_observation[treeID][randomCovariate][   repMembrIndx[nonMissMembrIndx[indxx[*currentMembrIter]]]    ] <= ((double*) splitVectorPtr)[offset]) {
+        daughterFlag = LEFT;
+      }
+      else {
+        daughterFlag = RIGHT;
+        iterFlag = FALSE;
+      }
+    }
+    localSplitIndicator[     nonMissMembrIndx[indxx[*currentMembrIter]]   ] = daughterFlag;
+    if (daughterFlag == LEFT) {
+      (*leftSize) ++;
+    }  
+    else {
+    }
+  }  
+  return (*leftSize);
+ }
+void getReweightedRandomPair (uint    treeID,
+                              uint    relativeFactorSize,
+                              uint    absoluteFactorSize,
+                              double *absoluteLevel,
+                              uint   *result) {
+  uint randomGroupIndex;
+  if(RF_factorList[treeID][relativeFactorSize] == NULL) {
+    RFprintf("\nRF-SRC:  *** ERROR *** ");
+    RFprintf("\nRF-SRC:  Factor not allocated for size:  %10d", relativeFactorSize);
+    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+    error("\nRF-SRC:  The application will now exit.\n");
+  }
+  randomGroupIndex = (uint) ceil(ran1B(treeID) * ((RF_factorList[treeID][relativeFactorSize] -> cardinalGroupCount) * 1.0));
+  createRandomBinaryPair(treeID, relativeFactorSize, absoluteFactorSize, randomGroupIndex, absoluteLevel, result);
+}
+void getRandomPair (uint treeID, uint relativeFactorSize, uint absoluteFactorSize, double *absoluteLevel, uint *result) {
+  uint randomGroupIndex;
+  double randomValue;
+  uint k;
+  if(RF_factorList[treeID][relativeFactorSize] == NULL) {
+    RFprintf("\nRF-SRC:  *** ERROR *** ");
+    RFprintf("\nRF-SRC:  Factor not allocated for size:  %10d", relativeFactorSize);
+    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+    error("\nRF-SRC:  The application will now exit.\n");
+  }
+  double *cdf = dvector(1, RF_factorList[treeID][relativeFactorSize] -> cardinalGroupCount);
+  if (relativeFactorSize <= MAX_EXACT_LEVEL) {
+    for (k=1; k <= RF_factorList[treeID][relativeFactorSize] -> cardinalGroupCount; k++) {
+      cdf[k] = (double) ((uint*) RF_factorList[treeID][relativeFactorSize] -> cardinalGroupSize)[k];
+    }
+  }
+  else {
+    for (k=1; k <= RF_factorList[treeID][relativeFactorSize] -> cardinalGroupCount; k++) {
+      cdf[k] = ((double*) RF_factorList[treeID][relativeFactorSize] -> cardinalGroupSize)[k];
+    }
+  }
+  for (k=2; k <= RF_factorList[treeID][relativeFactorSize] -> cardinalGroupCount; k++) {
+    cdf[k] += cdf[k-1];
+  }
+  randomValue = ceil((ran1B(treeID) * cdf[RF_factorList[treeID][relativeFactorSize] -> cardinalGroupCount]));
+  randomGroupIndex = 1;
+  while (randomValue > cdf[randomGroupIndex]) {
+    randomGroupIndex ++;
+  }
+  free_dvector(cdf, 1, RF_factorList[treeID][relativeFactorSize] -> cardinalGroupCount);
+  createRandomBinaryPair(treeID, relativeFactorSize, absoluteFactorSize, randomGroupIndex, absoluteLevel, result);
+}
+void createRandomBinaryPair(uint    treeID,
+                            uint    relativeFactorSize,
+                            uint    absoluteFactorSize,
+                            uint    groupIndex,
+                            double *absoluteLevel,
+                            uint   *pair) {
+  uint mwcpLevelIdentifier;
+  uint mwcpSizeAbsolute;
+  uint offset, levelSize, levelIndex;
+  uint k;
+  levelIndex = 0;  
+  mwcpSizeAbsolute = RF_factorList[treeID][absoluteFactorSize] -> mwcpSize;
+  uint *levelVector = uivector(1, relativeFactorSize);
+  uint *randomLevel = uivector(1, groupIndex);
+  for (k = 1; k <= relativeFactorSize; k++) {
+    levelVector[k] = k;
+  }
+  levelSize = relativeFactorSize;
+  for (k = 1; k <= groupIndex; k++) {
+    randomLevel[k] = sampleUniformlyFromVector(treeID,
+                                               levelVector,
+                                               levelSize,
+                                               &levelIndex);
+    levelVector[levelIndex] = levelVector[levelSize];
+    levelSize --;
+  }
+  for (k = 1; k <= groupIndex; k++) {
+    randomLevel[k] = (uint) absoluteLevel[randomLevel[k]];
+  }
+  for (offset = 1; offset <= mwcpSizeAbsolute; offset++) {
+    pair[offset] = 0;
+  }
+  for (k = 1; k <= groupIndex; k++) {
+    mwcpLevelIdentifier = (randomLevel[k] >> (3 + ulog2(SIZE_OF_INTEGER))) + ((randomLevel[k] & (MAX_EXACT_LEVEL - 1)) ? 1 : 0);
+    pair[mwcpLevelIdentifier] += upower(2, randomLevel[k] - ((mwcpLevelIdentifier - 1) * MAX_EXACT_LEVEL) - 1 );
+  }
+  free_uivector(levelVector, 1, relativeFactorSize);
+  free_uivector(randomLevel, 1, groupIndex);
+}
+void convertRelToAbsBinaryPair(uint    treeID,
+                               uint    relativeFactorSize,
+                               uint    absoluteFactorSize,
+                               uint    relativePair,
+                               double *absoluteLevel,
+                               uint   *pair) {
+  uint mwcpLevelIdentifier;
+  uint mwcpSizeAbsolute;
+  uint coercedAbsoluteLevel;
+  uint k, offset;
+  mwcpSizeAbsolute = RF_factorList[treeID][absoluteFactorSize] -> mwcpSize;
+  for (offset = 1; offset <= mwcpSizeAbsolute; offset++) {
+    pair[offset] = 0;
+  }
+  for (k = 1; k <= relativeFactorSize; k++) {
+    if (relativePair & ((uint) 0x01)) {
+      coercedAbsoluteLevel = (uint) absoluteLevel[k];
+      mwcpLevelIdentifier = (coercedAbsoluteLevel >> (3 + ulog2(SIZE_OF_INTEGER))) + ((coercedAbsoluteLevel & (MAX_EXACT_LEVEL - 1)) ? 1 : 0);
+      pair[mwcpLevelIdentifier] += upower(2, coercedAbsoluteLevel - ((mwcpLevelIdentifier - 1) * MAX_EXACT_LEVEL) - 1 );
+    }
+    relativePair = relativePair >> 1;
+  }
+}
+char summarizeSplitResult(uint    splitParameterMax,
+                          double  splitValueMaxCont,
+                          uint    splitValueMaxFactSize,
+                          uint   *splitValueMaxFactPtr,
+                          double *splitStatistic,
+                          double  deltaMax) {
+  char result;
+  if (splitParameterMax > 0) {
+    *splitStatistic = deltaMax;
+    result = TRUE;
+  }
+  else {
+    result = FALSE;
+  }
+  return result;
+}
+char getPreSplitResult (uint      treeID,
+                        Node     *parent,
+                        uint      repMembrSize,
+                        uint     *repMembrIndx,
+                        uint     *nonMissMembrSize,
+                        uint    **nonMissMembrIndx,
+                        double  **splitVector,
+                        double   *preSplitMean,
+                        char      multImpFlag,
+                        char      multVarFlag) {
+  uint i, r;
+  char mResponseFlag;
+  char result;
+  if (repMembrSize >= (2 * RF_minimumNodeSize)) {
+    result = TRUE;
+  }
+  else {
+    result = FALSE;
+  }
+  if (result) {
+    if (RF_maximumNodeDepth < 0) {
+      result = TRUE;
+    }
+    else {
+      if (parent -> depth < (uint) RF_maximumNodeDepth) {
+        result = TRUE;
+      }
+      else {
+        result = FALSE;
+      }
+    }
+  }
+  if (result) {
+    *splitVector = dvector(1, repMembrSize);
+    if ((RF_mRecordSize == 0) || multImpFlag || !(RF_optHigh & OPT_MISS_SKIP) || multVarFlag) {
+      (*nonMissMembrSize) = repMembrSize;
+      (*nonMissMembrIndx) = RF_identityMembershipIndex;
+    }
+    else {
+      *nonMissMembrIndx = uivector(1, repMembrSize);
+      (*nonMissMembrSize) = 0;
+      for (i = 1; i <= repMembrSize; i++) {
+        mResponseFlag = FALSE;
+        if (RF_mRecordMap[repMembrIndx[i]] > 0) {
+          for (r = 1; r <= RF_rSize; r++) {
+            if (RF_mpSign[r][RF_mRecordMap[repMembrIndx[i]]] == 1) {
+              mResponseFlag = TRUE;
+            }
+          }
+        }
+        if (!mResponseFlag) {
+          (*nonMissMembrSize) ++;
+          (*nonMissMembrIndx)[(*nonMissMembrSize)] = i;
+        }
+      }  
+    }  
+    if (!multVarFlag) {
+      if ((RF_timeIndex > 0) && (RF_statusIndex > 0)) {
+        uint q,k,m;
+        uint *evntProp = uivector(1, RF_eventTypeSize + 1);
+        for (q=1; q <= RF_eventTypeSize + 1; q++) {
+          evntProp[q] = 0;
+        }
+        for (i = 1; i <= (*nonMissMembrSize); i++) {
+          m = (uint) RF_status[treeID][repMembrIndx[(*nonMissMembrIndx)[i]]];
+          if (m > 0) {
+            evntProp[RF_eventTypeIndex[m]] ++;
+          }
+          else {
+            evntProp[RF_eventTypeSize + 1] ++;
+          }
+        }
+        k = 0;
+        for (q = 1; q <= RF_eventTypeSize + 1; q++) {
+          if(evntProp[q] > 0) {
+            k ++;
+          }
+        }
+        if (k == 0) {
+          result = FALSE;
+        }
+        else {
+          if (k == 1) {
+            if (evntProp[RF_eventTypeSize + 1] > 0) {
+              result = FALSE;
+            }
+            else {
+              result = getVariance(repMembrSize,
+                                   repMembrIndx,
+                                   *nonMissMembrSize,
+                                   *nonMissMembrIndx,
+                                   RF_time[treeID],
+                                   preSplitMean,
+                                   NULL);
+            }
+          }
+        }
+        free_uivector(evntProp, 1, RF_eventTypeSize + 1);
+      }
+      else {
+        result = getVariance(repMembrSize,
+                             repMembrIndx,
+                             *nonMissMembrSize,
+                             *nonMissMembrIndx,
+                             RF_response[treeID][1],
+                             preSplitMean,
+                             NULL);
+      }
+    }
+    if (!result) {
+      free_dvector(*splitVector, 1, repMembrSize);
+      (*nonMissMembrSize) = 0;
+      if (!((RF_mRecordSize == 0) || multImpFlag || !(RF_optHigh & OPT_MISS_SKIP) || multVarFlag)) {
+        free_uivector(*nonMissMembrIndx, 1, repMembrSize);
+      }
+    }
+  }
+  return result;
+}
+void unstackPreSplit (char      preliminaryResult,
+                      char      multImpFlag,
+                      char      multVarFlag,
+                      uint      repMembrSize,
+                      double   *splitVector,
+                      uint     *nonMissMembrIndx) {
+  if (preliminaryResult) {
+    free_dvector(splitVector, 1, repMembrSize);
+    if (!((RF_mRecordSize == 0) || multImpFlag || !(RF_optHigh & OPT_MISS_SKIP) || multVarFlag)) {
+      free_uivector(nonMissMembrIndx, 1, repMembrSize);
+    }
+  }
+  else {
+  }
+}
+char updateMaximumSplit(uint    treeID,
+                        Node   *parent,
+                        double  delta,
+                        uint    candidateCovariateCount,
+                        uint    covariate,
+                        uint    index,
+                        char    factorFlag,
+                        uint    mwcpSizeAbsolute,
+                        uint    repMembrSize,
+                        char   *localSplitIndicator,
+                        double *deltaMax,
+                        uint   *splitParameterMax,
+                        double *splitValueMaxCont,
+                        uint   *splitValueMaxFactSize,
+                        uint  **splitValueMaxFactPtr,
+                        void   *splitVectorPtr,
+                        char  **splitIndicator) {
+  char flag;
+  uint k;
+  if (RF_opt & OPT_NODE_STAT) {
+    updateNodeStatistics(parent, delta, candidateCovariateCount, covariate);
+  }
+  if(ISNA(delta)) {
+    flag = FALSE;
+  }
+  else {
+    if(ISNA(*deltaMax)) {
+      flag = TRUE;
+    }
+    else {
+      if ((delta - *deltaMax) > EPSILON) {
+        flag = TRUE;
+      }
+      else {
+        flag = FALSE;
+      }
+    }
+  }
+  if (flag) {
+    *deltaMax = delta;
+    *splitParameterMax = covariate;
+    if (factorFlag == TRUE) {
+      if (*splitValueMaxFactSize > 0) {
+        if (*splitValueMaxFactSize != mwcpSizeAbsolute) {
+          free_uivector(*splitValueMaxFactPtr, 1, *splitValueMaxFactSize);
+          *splitValueMaxFactSize = mwcpSizeAbsolute;
+          *splitValueMaxFactPtr = uivector(1, *splitValueMaxFactSize);
+        }
+      }
+      else {
+        *splitValueMaxFactSize = mwcpSizeAbsolute;
+        *splitValueMaxFactPtr = uivector(1, *splitValueMaxFactSize);
+      }
+      *splitValueMaxCont = NA_REAL;
+      for (k=1; k <= *splitValueMaxFactSize; k++) {
+        (*splitValueMaxFactPtr)[k] =
+          ((uint*) splitVectorPtr + ((index - 1) * (*splitValueMaxFactSize)))[k];
+      }
+    }
+    else {
+      if (*splitValueMaxFactSize > 0) {
+        free_uivector(*splitValueMaxFactPtr, 1, *splitValueMaxFactSize);
+        *splitValueMaxFactSize = 0;
+        *splitValueMaxFactPtr = NULL;
+      }
+      else {
       }
-    }  
-    if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
-      unstackSplitSurv(localEventTimeCount,
-                       localEventTimeIndex,
-                       localEventTimeSize,
-                       nodeParentEvent,
-                       nodeParentAtRisk,
-                       nodeLeftEvent,
-                       nodeLeftAtRisk,
-                       nodeRightEvent,
-                       nodeRightAtRisk);
+      *splitValueMaxCont = ((double*) splitVectorPtr)[index];
     }
-    unstackRandomCovariates(treeID,
-                            parent,
-                            randomCovariateIndex,
-                            uniformCovariateSize,
-                            cdf,
-                            cdfSize,
-                            cdfSort,
-                            density,
-                            densitySize,
-                            densitySwap,
-                            repMembrSize);
-    unstackSplitIndicator(repMembrSize, localSplitIndicator);
-  }  
-  unstackPreSplit(preliminaryResult,
-                  multImpFlag,
-                  FALSE,  
-                  repMembrSize,
-                  splitVector,
-                  nonMissMembrIndxStatic);
-  result = summarizeSplitResult(*splitParameterMax,
-                                *splitValueMaxCont,
-                                *splitValueMaxFactSize,
-                                *splitValueMaxFactPtr,
-                                 splitStatistic,
-                                 deltaMax);
-  return result;
+    if (splitIndicator != NULL) {
+      if (*splitIndicator == NULL) {
+        *splitIndicator = cvector(1, repMembrSize);
+      }
+      for (k=1; k <= repMembrSize; k++) {
+        (*splitIndicator)[k] = localSplitIndicator[k];
+      }
+    }
+  }
+  else {
+  }
+  return flag;
 }
-char customCompetingRiskSplit (uint    treeID,
-                               Node   *parent,
-                               uint   *repMembrIndx,
-                               uint    repMembrSize,
-                               uint   *allMembrIndx,
-                               uint    allMembrSize,
-                               uint   *splitParameterMax,
-                               double *splitValueMaxCont,
-                               uint   *splitValueMaxFactSize,
-                               uint  **splitValueMaxFactPtr,
-                               double *splitStatistic,
-                               char  **splitIndicator,
-                               char    multImpFlag) {
-  uint   *randomCovariateIndex;
-  uint    uniformCovariateIndex;
-  uint    uniformCovariateSize;
-  double *cdf;
-  uint    cdfSize;
-  uint   *cdfSort;
-  uint   *density;
-  uint    densitySize;
-  uint  **densitySwap;
-  uint     covariate;
-  double  *splitVector;
-  uint     splitVectorSize;
-  uint nonMissMembrSize, nonMissMembrSizeStatic;
-  uint *nonMissMembrIndx, *nonMissMembrIndxStatic;
-  uint   *indxx;
-  uint priorMembrIter, currentMembrIter;
-  uint leftSize;
-  char *localSplitIndicator;
-  uint splitLength;
-  void *splitVectorPtr;
-  char factorFlag;
-  uint mwcpSizeAbsolute;
-  char deterministicSplitFlag;
-  char preliminaryResult, result;
-  double delta, deltaMax;
-  uint j, k, m;
-  localSplitIndicator    = NULL;  
-  mwcpSizeAbsolute       = 0;     
-  *splitParameterMax     = 0;
-  *splitValueMaxFactSize = 0;
-  *splitValueMaxFactPtr  = NULL;
-  *splitValueMaxCont     = NA_REAL;
-  deltaMax               = NA_REAL;
-  preliminaryResult = getPreSplitResult(treeID,
-                                        parent,
-                                        repMembrSize,
-                                        repMembrIndx,
-                                        & nonMissMembrSizeStatic,
-                                        & nonMissMembrIndxStatic,
-                                        & splitVector,
-                                        & parent -> mean,
-                                        multImpFlag,
-                                        FALSE);
-  if (preliminaryResult) {
-    stackSplitIndicator(repMembrSize, & localSplitIndicator);
-    stackRandomCovariates(treeID,
-                          parent,
-                          repMembrSize,
-                          multImpFlag,
-                          & randomCovariateIndex,
-                          & uniformCovariateSize,
-                          & cdf,
-                          & cdfSize,
-                          & cdfSort,
-                          & density,
-                          & densitySize,
-                          & densitySwap);
-    uint *localEventTimeCount, *localEventTimeIndex;
-    uint  localEventTimeSize;
-    uint *nodeParentEvent,  *nodeLeftEvent,  *nodeRightEvent;
-    uint *nodeParentAtRisk, *nodeLeftAtRisk, *nodeRightAtRisk;
-    localEventTimeSize = 0;  
-    delta = 0;  
-    if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
-      stackAndGetSplitSurv(treeID,
-                           repMembrIndx,
-                           repMembrSize,
-                           nonMissMembrIndxStatic,
-                           nonMissMembrSizeStatic,
-                           & localEventTimeCount,
-                           & localEventTimeIndex,
-                           & localEventTimeSize,
-                           & nodeParentEvent,
-                           & nodeParentAtRisk,
-                           & nodeLeftEvent,
-                           & nodeLeftAtRisk,
-                           & nodeRightEvent,
-                           & nodeRightAtRisk);
-   }
-    uint actualCovariateCount = 0;
-    uint candidateCovariateCount = 0;
-    while (selectRandomCovariates(treeID,
-                                  parent,
-                                  repMembrIndx,
-                                  repMembrSize,
-                                  randomCovariateIndex,
-                                  & uniformCovariateSize,
-                                  & uniformCovariateIndex,
-                                  cdf,
-                                  & cdfSize,
-                                  cdfSort,
-                                  density,
-                                  & densitySize,
-                                  densitySwap,
-                                  & covariate,
-                                  & actualCovariateCount,
-                                  & candidateCovariateCount,
-                                  splitVector,
-                                  & splitVectorSize,
-                                  & indxx,
-                                  nonMissMembrSizeStatic,
-                                  nonMissMembrIndxStatic,
-                                  & nonMissMembrSize,
-                                  & nonMissMembrIndx,
-                                  multImpFlag)) {
-      splitLength = stackAndConstructSplitVector(treeID,
-                                                 repMembrSize,
-                                                 covariate,
-                                                 splitVector,
-                                                 splitVectorSize,
-                                                 & factorFlag,
-                                                 & deterministicSplitFlag,
-                                                 & mwcpSizeAbsolute,
-                                                 & splitVectorPtr);
-      if (!((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP)))) {
-        stackAndGetSplitSurv(treeID,
-                             repMembrIndx,
-                             repMembrSize,
-                             nonMissMembrIndx,
-                             nonMissMembrSize,
-                             & localEventTimeCount,
-                             & localEventTimeIndex,
-                             & localEventTimeSize,
-                             & nodeParentEvent,
-                             & nodeParentAtRisk,
-                             & nodeLeftEvent,
-                             & nodeLeftAtRisk,
-                             & nodeRightEvent,
-                             & nodeRightAtRisk);
+void updateNodeStatistics(Node *parent, double delta, uint candidateCovariateCount, uint covariate) {
+  char flag;
+  if(ISNA(delta)) {
+    flag = FALSE;
+  }
+  else {
+    if(ISNA((parent -> mtryStat)[candidateCovariateCount])) {
+      flag = TRUE;
+    }
+    else {
+      if ((delta - (parent -> mtryStat)[candidateCovariateCount]) > EPSILON) {
+        flag = TRUE;
+      }
+      else {
+        flag = FALSE;
+      }
+    }
+  }
+  if (flag) {
+    (parent -> mtryIndx)[candidateCovariateCount] = covariate;
+    (parent -> mtryStat)[candidateCovariateCount] = delta;
+  }
+}
+void getMeanResponseNew(uint       treeID,
+                        Terminal  *parent,
+                        uint      *repMembrIndx,
+                        uint       repMembrSize,
+                        uint      *allMembrIndx,
+                        uint       allMembrSize) {
+  uint *membershipIndex;
+  uint  membershipSize;
+  uint i, j;
+  stackMeanResponse(parent, RF_rNonFactorCount);
+  if ((RF_opt & OPT_BOOT_NODE) | (RF_opt & OPT_BOOT_NONE)) {
+    membershipIndex = allMembrIndx;
+    membershipSize  = allMembrSize;
+  }
+  else {
+    membershipIndex = repMembrIndx;
+    membershipSize  = repMembrSize;
+  }
+  parent -> membrCount = membershipSize;
+  for (j=1; j <= RF_rNonFactorCount; j++) {
+    (parent -> meanResponse)[j] = 0.0;
+  }
+  for (i=1; i <= membershipSize; i++) {
+    for (j=1; j <= RF_rNonFactorCount; j++) {
+      (parent -> meanResponse)[j] += RF_response[treeID][RF_rNonFactorIndex[j]][membershipIndex[i]];
+    }
+  }
+  if (parent -> membrCount > 0) {
+    for (j=1; j <= RF_rNonFactorCount; j++) {
+      (parent -> meanResponse)[j] = (parent -> meanResponse)[j] / (double) (parent -> membrCount);
+    }
+  }
+  else {
+    if (!(RF_opt & OPT_OUTC_TYPE)) {
+      RFprintf("\nRF-SRC:  *** ERROR *** ");
+      RFprintf("\nRF-SRC:  Zero node count encountered in getMeanResponse() in (tree, leaf) = (%10d, %10d)  \n", treeID, parent -> nodeID);
+      RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+      error("\nRF-SRC:  The application will now exit.\n");
+    }
+  }
+}
+void restoreMeanResponseNew(uint       treeID,
+                            Terminal  *parent) {
+  uint leaf;
+  leaf = parent -> nodeID;
+  if ((parent -> membrCount) > 0) {
+      (parent -> meanResponse) = RF_TN_REGR_ptr[treeID][leaf];
+  }
+  else {
+    RFprintf("\nRF-SRC:  *** ERROR *** ");
+    RFprintf("\nRF-SRC:  Zero node count encountered in restoreMeanResponse() in (tree, leaf) = (%10d, %10d)  \n", treeID, parent -> nodeID);
+    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+    error("\nRF-SRC:  The application will now exit.\n");
+  }
+}
+void updateEnsembleMean(uint     mode,
+                        uint     treeID,
+                        uint     serialTreeID,
+                        char     omitDenominator) {
+  char oobFlag, fullFlag, selectionFlag, outcomeFlag;
+  Terminal ***termMembershipPtr;
+  uint    *membershipIndex;
+  uint     membershipSize;
+  double    **ensembleRGRptr;
+  double    **ensembleRGRnum;
+  uint       *ensembleDen;
+  Terminal *parent;
+  uint i, j;
+  uint ii;
+  uint partialIndex;
+  ensembleRGRptr = NULL;  
+  ensembleRGRnum = NULL;  
+  ensembleDen    = NULL;  
+  oobFlag = fullFlag = FALSE;
+  switch (mode) {
+  case RF_PRED:
+    if (RF_opt & OPT_FENS) {
+      fullFlag = TRUE;
+    }
+    termMembershipPtr = RF_ftTermMembership;
+    break;
+  default:
+    if (RF_opt & OPT_OENS) {
+      if (RF_oobSize[treeID] > 0) {
+        oobFlag = TRUE;
       }
-      if (localEventTimeSize > 0) {
-        for (j = 1; j <= repMembrSize; j++) {
-          localSplitIndicator[j] = NEITHER;
-        }
-        leftSize = 0;
-        priorMembrIter = 0;
-        if (factorFlag == FALSE) {
-          for (j = 1; j <= nonMissMembrSize; j++) {
-            localSplitIndicator[ nonMissMembrIndx[indxx[j]] ] = RIGHT;
-          }
+    }
+    if (RF_opt & OPT_FENS) {
+      fullFlag = TRUE;
+    }
+    termMembershipPtr = RF_tTermMembership;
+    break;
+  }
+  partialIndex = getEnsemblePartialIndex(treeID);
+  outcomeFlag = (RF_ensemblePartialFlag) ? FALSE : TRUE;
+  while ((oobFlag == TRUE) || (fullFlag == TRUE)) {
+    if (oobFlag == TRUE) {
+      ensembleRGRptr = RF_oobEnsembleRGRptr;
+      ensembleRGRnum = RF_oobEnsembleRGRnum;
+      ensembleDen    = RF_oobEnsembleDen;
+      if (RF_ensemblePartialFlag) {
+        ensembleRGRnum = RF_oobEnsembleRGRpart[partialIndex];
+        ensembleDen    = RF_oobEnsembleDenPart[partialIndex];
+      }
+      membershipSize  = RF_oobSize[treeID];
+      membershipIndex = RF_oobMembershipIndex[treeID];
+    }
+    else {
+      ensembleRGRptr = RF_fullEnsembleRGRptr;
+      ensembleRGRnum = RF_fullEnsembleRGRnum;
+      ensembleDen    = RF_fullEnsembleDen;
+      if (RF_ensemblePartialFlag) {
+        ensembleRGRnum = RF_fullEnsembleRGRpart[partialIndex];
+        ensembleDen    = RF_fullEnsembleDenPart[partialIndex];
+      }
+      switch (mode) {
+      case RF_PRED:
+        membershipSize = RF_fobservationSize;
+        membershipIndex = RF_fidentityMembershipIndex;
+        break;
+      default:
+        membershipSize  = RF_observationSize;
+        membershipIndex = RF_identityMembershipIndex;
+        break;
+      }
+    }
+    for (i = 1; i <= membershipSize; i++) {
+      ii = membershipIndex[i];
+      parent = termMembershipPtr[treeID][ii];
+      selectionFlag = TRUE;
+      if (RF_opt & OPT_OUTC_TYPE) {
+        if ((parent -> meanResponse) != NULL) {
         }
-        double *userTime  = dvector(1, nonMissMembrSize);
-        double *userEvent = dvector(1, nonMissMembrSize);
-        double *userEventTime = dvector(1, localEventTimeSize);
-        char   *userSplitIndicator = cvector(1, nonMissMembrSize);
-        uint   *userSort  = uivector(1, nonMissMembrSize);
-        double *tempTime  = dvector(1, nonMissMembrSize);
-        for (k = 1; k <= nonMissMembrSize; k++) {
-          tempTime[k]  = RF_time[treeID][ repMembrIndx[nonMissMembrIndx[indxx[k]]] ];
+        else {
+          selectionFlag = FALSE;
         }
-        indexx(nonMissMembrSize, tempTime, userSort);
-        for (k = 1; k <= nonMissMembrSize; k++) {
-          userTime[k]  = RF_time[treeID][ repMembrIndx[nonMissMembrIndx[indxx[userSort[k]]]] ];
-          userEvent[k] = RF_status[treeID][ repMembrIndx[nonMissMembrIndx[indxx[userSort[k]]]] ];
+      }
+      if (selectionFlag) {
+        for (j=1; j <= RF_rTargetNonFactorCount; j++) {
+          ensembleRGRnum[j][ii] += (parent -> meanResponse)[RF_rNonFactorMap[RF_rTargetNonFactor[j]]];
         }
-        for (m = 1; m <= localEventTimeSize; m++) {
-          userEventTime[m] = RF_masterTime[localEventTimeIndex[m]];
+        if(!omitDenominator) {
+          ensembleDen[ii] ++;
         }
-        for (j = 1; j < splitLength; j++) {
-          if (factorFlag == TRUE) {
-            priorMembrIter = 0;
-            leftSize = 0;
-          }
-          virtuallySplitNode(treeID,
-                             factorFlag,
-                             mwcpSizeAbsolute,
-                             covariate,
-                             repMembrIndx,
-                             repMembrSize,
-                             nonMissMembrIndx,
-                             nonMissMembrSize,
-                             indxx,
-                             splitVectorPtr,
-                             j,
-                             localSplitIndicator,
-                             & leftSize,
-                             priorMembrIter,
-                             & currentMembrIter);
-          for (k = 1; k <= nonMissMembrSize; k++) {
-            userSplitIndicator[k] = localSplitIndicator[ nonMissMembrIndx[indxx[userSort[k]]] ];
-          }
-          delta = customFunctionArray[CRSK_FAM][RF_splitCustomIdx](nonMissMembrSize,
-                                                                   userSplitIndicator,
-                                                                   userTime,
-                                                                   userEvent,
-                                                                   RF_eventType[RF_eventTypeSize],
-                                                                   localEventTimeSize,
-                                                                   userEventTime,
-                                                                   NULL,
-                                                                   0,
-                                                                   0,
-                                                                   0);
-          updateMaximumSplit(treeID,
-                             parent,
-                             delta,
-                             candidateCovariateCount,
-                             covariate,
-                             j,
-                             factorFlag,
-                             mwcpSizeAbsolute,
-                             repMembrSize,
-                             localSplitIndicator,
-                             & deltaMax,
-                             splitParameterMax,
-                             splitValueMaxCont,
-                             splitValueMaxFactSize,
-                             splitValueMaxFactPtr,
-                             splitVectorPtr,
-                             splitIndicator);
-          if (factorFlag == FALSE) {
-            priorMembrIter = currentMembrIter - 1;
-          }
-        }  
-        free_uivector(userSort, 1, nonMissMembrSize);
-        free_dvector(tempTime, 1, nonMissMembrSize);
-        free_dvector (userTime, 1, nonMissMembrSize);
-        free_dvector (userEvent, 1, nonMissMembrSize);
-        free_dvector (userEventTime, 1, localEventTimeSize);
-        free_cvector (userSplitIndicator, 1, nonMissMembrSize);
-      }  
-      else {
       }
-      unstackSplitVector(treeID,
-                         splitVectorSize,
-                         splitLength,
-                         factorFlag,
-                         deterministicSplitFlag,
-                         mwcpSizeAbsolute,
-                         splitVectorPtr);
-      unselectRandomCovariates(treeID,
-                               parent,
-                               repMembrSize,
-                               indxx,
-                               nonMissMembrSizeStatic,
-                               nonMissMembrIndx,
-                               multImpFlag);
-      if (!((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP)))) {
-        unstackSplitSurv(localEventTimeCount,
-                         localEventTimeIndex,
-                         localEventTimeSize,
-                         nodeParentEvent,
-                         nodeParentAtRisk,
-                         nodeLeftEvent,
-                         nodeLeftAtRisk,
-                         nodeRightEvent,
-                         nodeRightAtRisk);
+      if (outcomeFlag) {
+        if (ensembleDen[ii] != 0) {
+          for (j=1; j <= RF_rTargetNonFactorCount; j++) {
+            ensembleRGRptr[j][ii] = ensembleRGRnum[j][ii] / ensembleDen[ii];
+          }
+        }
       }
     }  
-    if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
-        unstackSplitSurv(localEventTimeCount,
-                         localEventTimeIndex,
-                         localEventTimeSize,
-                         nodeParentEvent,
-                         nodeParentAtRisk,
-                         nodeLeftEvent,
-                         nodeLeftAtRisk,
-                         nodeRightEvent,
-                         nodeRightAtRisk);
+    if (outcomeFlag == TRUE) {
+      outcomeFlag = FALSE;
+    }
+    if (oobFlag == TRUE) {
+      oobFlag = FALSE;
+    }
+    else {
+        fullFlag = FALSE;
     }
-    unstackRandomCovariates(treeID,
-                            parent,
-                            randomCovariateIndex,
-                            uniformCovariateSize,
-                            cdf,
-                            cdfSize,
-                            cdfSort,
-                            density,
-                            densitySize,
-                            densitySwap,
-                            repMembrSize);
-    unstackSplitIndicator(repMembrSize, localSplitIndicator);
   }  
-  unstackPreSplit(preliminaryResult,
-                  multImpFlag,
-                  FALSE,  
-                  repMembrSize,
-                  splitVector,
-                  nonMissMembrIndxStatic);
-  result = summarizeSplitResult(*splitParameterMax,
-                                *splitValueMaxCont,
-                                *splitValueMaxFactSize,
-                                *splitValueMaxFactPtr,
-                                splitStatistic,
-                                deltaMax);
+}
+double getMeanSquareError(uint    size,
+                          double *responsePtr,
+                          double *predictedOutcome,
+                          uint   *denomCount) {
+  uint i;
+  uint cumDenomCount;
+  double result;
+  cumDenomCount = 0;
+  result = 0.0;
+  for (i=1; i <= size; i++) {
+    if (denomCount[i] != 0) {
+      cumDenomCount += 1;
+      result += pow (responsePtr[i] - predictedOutcome[i], 2.0);
+    }
+  }  
+  if (cumDenomCount == 0) {
+    result = NA_REAL;
+  }
+  else {
+    result = result / (double) cumDenomCount;
+  }
   return result;
 }
-void stackSplitIndicator(uint   nodeSize,
-                         char **localSplitIndicator) {
-  if (nodeSize > 0) {
-    *localSplitIndicator = cvector(1, nodeSize);
+char getVariance(uint    repMembrSize,
+                 uint   *repMembrIndx,
+                 uint    nonMissMembrSize,
+                 uint   *nonMissMembrIndx,
+                 double *targetResponse,
+                 double *mean,
+                 double *variance) {
+  uint i;
+  uint denom;
+  double meanResult, varResult;
+  char result;
+  uint *genIndx;
+  uint  genSize;
+  if (nonMissMembrIndx == NULL) {
+    genIndx = RF_identityMembershipIndex;
+    genSize = repMembrSize;
   }
-}
-void unstackSplitIndicator(uint  nodeSize,
-                           char *localSplitIndicator) {
-  if (nodeSize > 0) {
-    if (nodeSize > 0) {
-      free_cvector(localSplitIndicator, 1, nodeSize);
+  else {
+    genIndx = nonMissMembrIndx;
+    genSize = nonMissMembrSize;
+  }
+  denom      = 0;
+  meanResult = 0.0;
+  for (i = 1; i <= genSize; i++) {
+    if(!ISNA(targetResponse[repMembrIndx[genIndx[i]]])) {
+      denom ++;
+      meanResult += targetResponse[repMembrIndx[genIndx[i]]];
     }
   }
-}
-void stackSplitEventTime(uint **localEventTimeCount,
-                         uint **localEventTimeIndex) {
-  *localEventTimeCount = uivector(1, RF_masterTimeSize);
-  *localEventTimeIndex = uivector(1, RF_masterTimeSize);
-}
-void unstackSplitEventTime(uint *localEventTimeCount,
-                           uint *localEventTimeIndex) {
-  free_uivector(localEventTimeCount, 1, RF_masterTimeSize);
-  free_uivector(localEventTimeIndex, 1, RF_masterTimeSize);
-}
-uint getSplitEventTime(uint   treeID,
-                       uint   *repMembrIndx,
-                       uint    repMembrSize,
-                       uint   *nonMissMembrIndx,
-                       uint    nonMissMembrSize,
-                       uint   *localEventTimeCount,
-                       uint   *localEventTimeIndex) {
-  uint i;
-  uint eventTimeSize;
-  eventTimeSize = 0;
-  for (i=1; i <= RF_masterTimeSize; i++) {
-    localEventTimeCount[i] = 0;
+  if (denom > 0) {
+    meanResult = meanResult / (double) denom;
   }
-  for (i = 1; i <= nonMissMembrSize; i++) {
-    if (RF_status[treeID][ repMembrIndx[nonMissMembrIndx[i]] ] > 0) {
-      localEventTimeCount[RF_masterTimeIndex[treeID][ repMembrIndx[nonMissMembrIndx[i]] ]] ++;
+  else {
+    meanResult = NA_REAL;
+  }
+  if (mean != NULL) {
+    *mean = meanResult;
+  }
+  varResult = 0.0;
+  if(!ISNA(meanResult)) {
+    for (i = 1; i <= genSize; i++) {
+      if(!ISNA(targetResponse[repMembrIndx[genIndx[i]]])) {
+        varResult += pow(meanResult - targetResponse[repMembrIndx[genIndx[i]]], 2.0);
+      }
     }
+    varResult = varResult / (double) denom;
+    result = ((varResult <= EPSILON) ? FALSE : TRUE);
+  }
+  else {
+    varResult = NA_REAL;
+    result = FALSE;
+  }
+  if (variance != NULL) {
+    *variance = varResult;
   }
-  for (i=1; i <= RF_masterTimeSize; i++) {
-    if (localEventTimeCount[i] > 0) {
-      localEventTimeIndex[++eventTimeSize] = i;
+  return(result);
+}
+void restoreMeanResponse(uint treeID) {
+  Terminal *parent;
+  uint leaf;
+  uint j;
+  for (leaf = 1; leaf <= RF_tLeafCount[treeID]; leaf++) {
+    parent = RF_tTermList[treeID][leaf];
+    if ((parent -> membrCount) > 0) {
+      for (j = 1; j <= RF_rNonFactorCount; j++) {
+        (parent -> meanResponse)[j] = RF_TN_REGR_ptr[treeID][leaf][j];
+      }
+    }
+    else {
+      RFprintf("\nRF-SRC:  *** ERROR *** ");
+      RFprintf("\nRF-SRC:  Zero node count encountered in restoreMeanResponse() in (tree, leaf) = (%10d, %10d)  \n", treeID, parent -> nodeID);
+      RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+      error("\nRF-SRC:  The application will now exit.\n");
     }
   }
-  return (eventTimeSize);
 }
-void stackSplitEventAndRisk(uint   eventTimeSize,
-                            uint **nodeParentEvent,
-                            uint **nodeParentAtRisk,
-                            uint **nodeLeftEvent,
-                            uint **nodeLeftAtRisk,
-                            uint **nodeRightEvent,
-                            uint **nodeRightAtRisk) {
-  if (eventTimeSize > 0) {
-    *nodeParentEvent  = uivector(1, eventTimeSize);
-    *nodeParentAtRisk = uivector(1, eventTimeSize);
-    *nodeLeftEvent  = uivector(1, eventTimeSize);
-    *nodeLeftAtRisk = uivector(1, eventTimeSize);
-    *nodeRightEvent  = uivector(1, eventTimeSize);
-    *nodeRightAtRisk = uivector(1, eventTimeSize);
+void getMultiClassProbNew (uint       treeID,
+                           Terminal  *parent,
+                           uint      *repMembrIndx,
+                           uint       repMembrSize,
+                           uint      *allMembrIndx,
+                           uint       allMembrSize) {
+  uint *membershipIndex;
+  uint  membershipSize;
+  double maxValue, maxClass;
+  uint i, j, k;
+  stackMultiClassProb(parent, RF_rFactorCount, RF_rFactorSize);
+  if ((RF_opt & OPT_BOOT_NODE) | (RF_opt & OPT_BOOT_NONE)) {
+    membershipIndex = allMembrIndx;
+    membershipSize  = allMembrSize;
   }
   else {
-    *nodeParentEvent = *nodeParentAtRisk = *nodeLeftEvent  = *nodeLeftAtRisk = *nodeRightEvent  = *nodeRightAtRisk = NULL;
+    membershipIndex = repMembrIndx;
+    membershipSize  = repMembrSize;
   }
-}
-void unstackSplitEventAndRisk(uint  eventTimeSize,
-                              uint *nodeParentEvent,
-                              uint *nodeParentAtRisk,
-                              uint *nodeLeftEvent,
-                              uint *nodeLeftAtRisk,
-                              uint *nodeRightEvent,
-                              uint *nodeRightAtRisk) {
-  if (eventTimeSize > 0) {
-    free_uivector(nodeParentEvent, 1, eventTimeSize);
-    free_uivector(nodeParentAtRisk, 1, eventTimeSize);
-    free_uivector(nodeLeftEvent, 1, eventTimeSize);
-    free_uivector(nodeLeftAtRisk, 1, eventTimeSize);
-    free_uivector(nodeRightEvent, 1, eventTimeSize);
-    free_uivector(nodeRightAtRisk, 1, eventTimeSize);
+  parent -> membrCount = membershipSize;
+  for (j=1; j <= RF_rFactorCount; j++) {
+    for (k=1; k <= RF_rFactorSize[j]; k++) {
+      (parent -> multiClassProb)[j][k] = 0;
+    }
   }
-}
-void getSplitEventAndRisk(uint    treeID,
-                          uint   *repMembrIndx,
-                          uint    repMembrSize,
-                          uint   *nonMissMembrIndx,
-                          uint    nonMissMembrSize,
-                          uint   *localEventTimeCount,
-                          uint   *localEventTimeIndex,
-                          uint    localEventTimeSize,
-                          uint   *nodeParentEvent,
-                          uint   *nodeParentAtRisk) {
-  uint i, j;
-  for (i=1; i <= localEventTimeSize; i++) {
-    nodeParentAtRisk[i] = 0;
-    nodeParentEvent[i] = localEventTimeCount[localEventTimeIndex[i]];
-    for (j = 1; j <= nonMissMembrSize; j++) {
-      if (localEventTimeIndex[i] <= RF_masterTimeIndex[treeID][ repMembrIndx[nonMissMembrIndx[j]] ]) {
-        nodeParentAtRisk[i] ++;
+  for (i = 1; i <= membershipSize; i++) {
+    for (j=1; j <= RF_rFactorCount; j++) {
+      (parent -> multiClassProb)[j][(uint) RF_response[treeID][RF_rFactorIndex[j]][membershipIndex[i]]] ++;
+    }
+  }
+  if ((parent -> membrCount) > 0) {
+    for (j=1; j <= RF_rFactorCount; j++) {
+      maxValue = 0;
+      maxClass = 0;
+      for (k=1; k <= RF_rFactorSize[j]; k++) {
+        if (maxValue < (double) (parent -> multiClassProb[j][k])) {
+          maxValue = (double) parent -> multiClassProb[j][k];
+          maxClass = (double) k;
+        }
       }
+      (parent -> maxClass)[j] = maxClass;
+    }
+  }
+  else {
+    if (!(RF_opt & OPT_OUTC_TYPE)) {
+      RFprintf("\nRF-SRC:  *** ERROR *** ");
+      RFprintf("\nRF-SRC:  Zero node count encountered in getMultiClassProb() in (tree, leaf) = (%10d, %10d)  \n", treeID, parent -> nodeID);
+      RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+      error("\nRF-SRC:  The application will now exit.\n");
     }
   }
 }
-void stackAndGetSplitSurv(uint    treeID,
-                          uint   *repMembrIndx,
-                          uint    repMembrSize,
-                          uint   *nonMissMembrIndx,
-                          uint    nonMissMembrSize,
-                          uint  **localEventTimeCount,
-                          uint  **localEventTimeIndex,
-                          uint   *localEventTimeSize,
-                          uint  **nodeParentEvent,
-                          uint  **nodeParentAtRisk,
-                          uint  **nodeLeftEvent,
-                          uint  **nodeLeftAtRisk,
-                          uint  **nodeRightEvent,
-                          uint  **nodeRightAtRisk) {
-  stackSplitEventTime(localEventTimeCount, localEventTimeIndex);
-  *localEventTimeSize = getSplitEventTime( treeID,
-                                           repMembrIndx,
-                                           repMembrSize,
-                                           nonMissMembrIndx,
-                                           nonMissMembrSize,
-                                          *localEventTimeCount,
-                                          *localEventTimeIndex);
-  stackSplitEventAndRisk(*localEventTimeSize,
-                          nodeParentEvent,
-                          nodeParentAtRisk,
-                          nodeLeftEvent,
-                          nodeLeftAtRisk,
-                          nodeRightEvent,
-                          nodeRightAtRisk);
-  getSplitEventAndRisk( treeID,
-                        repMembrIndx,
-                        repMembrSize,
-                        nonMissMembrIndx,
-                        nonMissMembrSize,
-                       *localEventTimeCount,
-                       *localEventTimeIndex,
-                       *localEventTimeSize,
-                       *nodeParentEvent,
-                       *nodeParentAtRisk);
-}
-void unstackSplitSurv(uint *localEventTimeCount,
-                      uint *localEventTimeIndex,
-                      uint  eventTimeSize,
-                      uint *nodeParentEvent,
-                      uint *nodeParentAtRisk,
-                      uint *nodeLeftEvent,
-                      uint *nodeLeftAtRisk,
-                      uint *nodeRightEvent,
-                      uint *nodeRightAtRisk) {
-  unstackSplitEventTime(localEventTimeCount,
-                        localEventTimeIndex);
-  unstackSplitEventAndRisk(eventTimeSize,
-                           nodeParentEvent,
-                           nodeParentAtRisk,
-                           nodeLeftEvent,
-                           nodeLeftAtRisk,
-                           nodeRightEvent,
-                           nodeRightAtRisk);
+void restoreMultiClassProbNew (uint       treeID,
+                               Terminal  *parent) {
+  double maxValue, maxClass;
+  uint j, k;
+  if ((parent -> membrCount) > 0) {
+    (parent -> multiClassProb) = RF_TN_CLAS_ptr[treeID][parent -> nodeID];      
+    (parent -> maxClass) = dvector(1, RF_rFactorCount);
+    (parent -> rfCount) = RF_rFactorCount;
+    for (j = 1; j <= RF_rFactorCount; j++) {
+      maxValue = 0;
+      maxClass = 0;
+      for (k=1; k <= RF_rFactorSize[j]; k++) {
+        if (maxValue < (double) ((parent -> multiClassProb)[j][k])) {
+          maxValue = (double) (parent -> multiClassProb)[j][k];
+          maxClass = (double) k;
+        }
+      }
+      (parent -> maxClass)[j] = maxClass;
+    }
+  }
+  else {
+    RFprintf("\nRF-SRC:  *** ERROR *** ");
+    RFprintf("\nRF-SRC:  Zero node count encountered in restoreMultiClassProb() in (tree, leaf):  (%10d, %10d) \n", treeID, parent -> nodeID);
+    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+    error("\nRF-SRC:  The application will now exit.\n");
+  }
 }
-uint stackAndConstructSplitVector (uint     treeID,
-                                   uint     repMembrSize,
-                                   uint     randomCovariateIndex,
-                                   double  *splitVector,
-                                   uint     splitVectorSize,
-                                   char    *factorFlag,
-                                   char    *deterministicSplitFlag,
-                                   uint    *mwcpSizeAbsolute,
-                                   void   **splitVectorPtr) {
-  uint  sworIndex;
-  uint *sworVector;
-  uint  sworVectorSize;
-  uint j, j2, k2;
-  uint factorSizeAbsolute;
-  uint offset;
-  uint splitLength;
-  uint relativePair;
-  splitLength = 0;  
-  (*splitVectorPtr) = NULL;  
-  if (strcmp(RF_xType[randomCovariateIndex], "C") == 0) {
-    *factorFlag = TRUE;
-    if(RF_factorList[treeID][splitVectorSize] == NULL) {
-      RF_factorList[treeID][splitVectorSize] = makeFactor(splitVectorSize, FALSE);
+void updateEnsembleMultiClass(uint      mode,
+                              uint      treeID,
+                              uint      serialTreeID,
+                              char     omitDenominator) {
+  char oobFlag, fullFlag, selectionFlag, outcomeFlag;
+  Terminal ***termMembershipPtr;
+  uint    *membershipIndex;
+  uint     membershipSize;
+  double   ***ensembleCLSptr;
+  double   ***ensembleCLSnum;
+  uint       *ensembleDen;
+  Terminal *parent;
+  double maxValue;
+  double maxClass;
+  uint i, j, k;
+  uint ii;
+  uint partialIndex;
+  ensembleCLSptr = NULL;  
+  ensembleCLSnum = NULL;  
+  ensembleDen    = NULL;  
+  oobFlag = fullFlag = FALSE;
+  switch (mode) {
+  case RF_PRED:
+    if (RF_opt & OPT_FENS) {
+      fullFlag = TRUE;
     }
-    factorSizeAbsolute = RF_xFactorSize[RF_xFactorMap[randomCovariateIndex]];
-    *mwcpSizeAbsolute = RF_factorList[treeID][factorSizeAbsolute] -> mwcpSize;
-    if (RF_splitRule == RAND_SPLIT) {
-      splitLength = 1 + 1;
-      *deterministicSplitFlag = FALSE;
+    termMembershipPtr = RF_ftTermMembership;
+    break;
+  default:
+    if (RF_opt & OPT_OENS) {
+      if (RF_oobSize[treeID] > 0) {
+        oobFlag = TRUE;
+      }
+    }
+    if (RF_opt & OPT_FENS) {
+      fullFlag = TRUE;
+    }
+    termMembershipPtr = RF_tTermMembership;
+    break;
+  }
+  partialIndex = getEnsemblePartialIndex(treeID);
+  outcomeFlag = (RF_ensemblePartialFlag) ? FALSE : TRUE;
+  while ((oobFlag == TRUE) || (fullFlag == TRUE)) {
+    if (oobFlag == TRUE) {
+      ensembleCLSptr = RF_oobEnsembleCLSptr;
+      ensembleCLSnum = RF_oobEnsembleCLSnum;
+      ensembleDen    = RF_oobEnsembleDen;
+      if (RF_ensemblePartialFlag) {
+        ensembleCLSnum = RF_oobEnsembleCLSpart[partialIndex];
+        ensembleDen    = RF_oobEnsembleDenPart[partialIndex];
+      }
+      membershipSize  = RF_oobSize[treeID];
+      membershipIndex = RF_oobMembershipIndex[treeID];
     }
     else {
-      if(RF_splitRandomCount == 0) {
-        *deterministicSplitFlag = TRUE;
-        if ((RF_factorList[treeID][splitVectorSize] -> r) > MAX_EXACT_LEVEL) {
-          *deterministicSplitFlag = FALSE;
+      ensembleCLSptr = RF_fullEnsembleCLSptr;
+      ensembleCLSnum = RF_fullEnsembleCLSnum;
+      ensembleDen    = RF_fullEnsembleDen;
+      if (RF_ensemblePartialFlag) {
+        ensembleCLSnum = RF_fullEnsembleCLSpart[partialIndex];
+        ensembleDen    = RF_fullEnsembleDenPart[partialIndex];
+      }
+      switch (mode) {
+      case RF_PRED:
+        membershipSize = RF_fobservationSize;
+        membershipIndex = RF_fidentityMembershipIndex;
+        break;
+      default:
+        membershipSize  = RF_observationSize;
+        membershipIndex = RF_identityMembershipIndex;
+        break;
+      }
+    }
+    for (i = 1; i <= membershipSize; i++) {
+      ii = membershipIndex[i];
+      parent = termMembershipPtr[treeID][ii];
+      selectionFlag = TRUE;
+      if (RF_opt & OPT_OUTC_TYPE) {
+        if ((parent -> maxClass) != NULL) {
         }
         else {
-          if ( *((uint *) RF_factorList[treeID][splitVectorSize] -> complementaryPairCount) >= repMembrSize ) {
-            *deterministicSplitFlag = FALSE;
-          }
+          selectionFlag = FALSE;
         }
-        if (*deterministicSplitFlag == FALSE) {
-          splitLength = repMembrSize + 1;
+      }
+      if (selectionFlag) {
+        for (j=1; j <= RF_rTargetFactorCount; j++) {
+          for (k=1; k <= RF_rFactorSize[RF_rFactorMap[RF_rTargetFactor[j]]]; k++) {
+            ensembleCLSnum[j][k][ii] += (double) (parent -> multiClassProb)[RF_rFactorMap[RF_rTargetFactor[j]]][k] / (double) (parent -> membrCount);
+          }
         }
-        else {
-          splitLength = *((uint*) RF_factorList[treeID][splitVectorSize] -> complementaryPairCount) + 1;
+        if(!omitDenominator) {
+          ensembleDen[ii] ++;
         }
       }
-      else {
-        *deterministicSplitFlag = FALSE;
-        if ((RF_factorList[treeID][splitVectorSize] -> r) <= MAX_EXACT_LEVEL) {
-          if (*((uint*) RF_factorList[treeID][splitVectorSize] -> complementaryPairCount) <= ((RF_splitRandomCount <= repMembrSize) ? RF_splitRandomCount : repMembrSize)) {
-            splitLength = *((uint*) RF_factorList[treeID][splitVectorSize] -> complementaryPairCount) + 1;
-            *deterministicSplitFlag = TRUE;
+      if (outcomeFlag) {
+        if (ensembleDen[ii] != 0) {
+          for (j=1; j <= RF_rTargetFactorCount; j++) {
+            maxValue = 0;
+            maxClass = 0;
+            for (k=1; k <= RF_rFactorSize[RF_rFactorMap[RF_rTargetFactor[j]]]; k++) {
+              if (maxValue < ensembleCLSnum[j][k][ii]) {
+                maxValue = ensembleCLSnum[j][k][ii];
+                maxClass = (double) k;
+              }
+            }
+            ensembleCLSptr[j][1][ii] = maxClass;
           }
         }
-        if (*deterministicSplitFlag == FALSE) {
-          splitLength = 1 + ((RF_splitRandomCount <= repMembrSize) ? RF_splitRandomCount : repMembrSize);
-        }
-      }  
+      }
     }  
-    (*splitVectorPtr) = uivector(1, splitLength * (*mwcpSizeAbsolute));
-    for (offset = 1; offset <= *mwcpSizeAbsolute; offset++) {
-      ((uint*) (*splitVectorPtr) + ((splitLength - 1) * (*mwcpSizeAbsolute)))[offset] = 0;
+    if (outcomeFlag == TRUE) {
+      outcomeFlag = FALSE;
     }
-    if (*deterministicSplitFlag) {
-      bookFactor(RF_factorList[treeID][splitVectorSize]);
-      j2 = 0;
-      for (j = 1; j <= RF_factorList[treeID][splitVectorSize] -> cardinalGroupCount; j++) {
-        for (k2 = 1; k2 <= ((uint*) RF_factorList[treeID][splitVectorSize] -> cardinalGroupSize)[j]; k2++) {
-          ++j2;
-          relativePair = (RF_factorList[treeID][splitVectorSize] -> cardinalGroupBinary)[j][k2];
-          convertRelToAbsBinaryPair(treeID,
-                                    splitVectorSize,
-                                    factorSizeAbsolute,
-                                    relativePair,
-                                    splitVector,
-                                    (uint*) (*splitVectorPtr) + ((j2 - 1) * (*mwcpSizeAbsolute)));
-        }
+    if (oobFlag == TRUE) {
+      oobFlag = FALSE;
+    }
+    else {
+      fullFlag = FALSE;
+    }
+  }  
+}
+double getBrierScore(uint     obsSize,
+                     uint     rTarget,
+                     double  *responsePtr,
+                     double **outcomeCLS,
+                     uint    *denomCount,
+                     double  *cpv) {
+  uint k;
+  uint against;
+  uint *oaaResponse;
+  uint cumDenomCount;
+  double result;
+  oaaResponse = uivector(1, obsSize);
+  result = 0.0;
+  cumDenomCount = 0;
+  for (k = 1; k <= obsSize; k ++) {
+    if (denomCount[k] != 0) {
+      cumDenomCount += 1;
+    }
+  }
+  for (against = 1; against < RF_rFactorSize[RF_rFactorMap[rTarget]]; against++) {
+    for (k = 1; k <= obsSize; k ++) {
+      if ((uint) responsePtr[k] == against) {
+        oaaResponse[k] = 1;
       }
-    }  
+      else {
+        oaaResponse[k] = 0;
+      }
+    }
+    cpv[against] = 0.0;
+    for (k = 1; k <= obsSize; k ++) {
+      if (denomCount[k] != 0) {
+        cpv[against] += pow(((double) oaaResponse[k] - (outcomeCLS[against][k] / (double) denomCount[k])), 2.0);
+      }
+    }
+    if (cumDenomCount == 0) {
+      cpv[against] = NA_REAL;
+    }
     else {
-      for (j = 1; j < splitLength; j++) {
-        getRandomPair(treeID, splitVectorSize, factorSizeAbsolute, splitVector, (uint*) (*splitVectorPtr) + ((j - 1) * (*mwcpSizeAbsolute)));
+      cpv[against] = cpv[against] / (double) cumDenomCount;
+      result += cpv[against];
+    }
+  }
+  if (cumDenomCount == 0) {
+    result = NA_REAL;
+  }
+  else {
+    result = result / RF_rFactorSize[RF_rFactorMap[rTarget]];
+  }
+  free_uivector(oaaResponse, 1, obsSize);
+  return result;
+}
+void getConditionalClassificationIndex(uint     size,
+                                       uint     rTarget,
+                                       double  *responsePtr,
+                                       double  *outcomeCLS,
+                                       uint    *denomCount,
+                                       double  *cpv) {
+  uint i, k;
+  uint cumDenomCount;
+  uint *condClassificationCount;
+  cumDenomCount = 0;
+  condClassificationCount = uivector(1, RF_rFactorSize[RF_rFactorMap[rTarget]]);
+  for (k=1; k <= RF_rFactorSize[RF_rFactorMap[rTarget]]; k++) {
+    condClassificationCount[k] = 0;
+    cpv[k] = 0;
+  }
+  for (i = 1; i <= size; i++) {
+    condClassificationCount[(uint) responsePtr[i]] ++;
+    if (denomCount[i] != 0) {
+      cumDenomCount += 1;
+      if (responsePtr[i] == outcomeCLS[i]) {
+        cpv[(uint) responsePtr[i]] += 1.0;
       }
     }
   }  
-  else {
-    *factorFlag = FALSE;
-    if (RF_splitRule == RAND_SPLIT) {
-      splitLength = 1 + 1;
-      *deterministicSplitFlag = FALSE;
+  if (cumDenomCount == 0) {
+    for (k=1; k <= RF_rFactorSize[RF_rFactorMap[rTarget]]; k++) {
+      cpv[k] = NA_REAL;
     }
-    else {
-      if(RF_splitRandomCount == 0) {
-        splitLength = splitVectorSize;
-        (*splitVectorPtr) = splitVector;
-        *deterministicSplitFlag = TRUE;
+  }
+  else {
+    for (k=1; k <= RF_rFactorSize[RF_rFactorMap[rTarget]]; k++) {
+      if (condClassificationCount[k] != 0) {
+        cpv[k] = 1.0 - cpv[k] / (double) condClassificationCount[k];
       }
       else {
-        if (splitVectorSize <= RF_splitRandomCount) {
-          splitLength = splitVectorSize;
-          (*splitVectorPtr) = splitVector;
-          *deterministicSplitFlag = TRUE;
-        }
-        else {
-          splitLength = RF_splitRandomCount + 1;
-          *deterministicSplitFlag = FALSE;
-        }
-      }  
-    }  
-    if (*deterministicSplitFlag == FALSE) {
-      (*splitVectorPtr) = dvector(1, splitLength);
-      ((double*) (*splitVectorPtr))[splitLength] = 0;
-      if (RF_splitRule == RAND_SPLIT) {
-        ((double*) (*splitVectorPtr))[1]  = splitVector[(uint) ceil(ran1B(treeID) * ((splitVectorSize - 1) * 1.0))];
+        cpv[k] = NA_REAL;
       }
-      else {
-        sworVector = uivector(1, splitVectorSize);
-        sworVectorSize = splitVectorSize - 1;
-        for (j = 1; j <= sworVectorSize; j++) {
-          sworVector[j] = j;
-        }
-        for (j = 1; j < splitLength; j++) {
-          sworIndex = (uint) ceil(ran1B(treeID) * (sworVectorSize * 1.0));
-          ((double*) (*splitVectorPtr))[j]  = splitVector[sworVector[sworIndex]];
-          sworVector[sworIndex] = sworVector[sworVectorSize];
-          sworVectorSize --;
-        }
-        free_uivector (sworVector, 1, splitVectorSize);
-        sort(((double*) (*splitVectorPtr)), splitLength-1);
+    }
+  }
+  free_uivector(condClassificationCount, 1, RF_rFactorSize[RF_rFactorMap[rTarget]]);
+  return;
+}
+double getClassificationIndex(uint    size,
+                              double *responsePtr,
+                              double *predictedOutcome,
+                              uint   *denomCount) {
+  uint i;
+  uint cumDenomCount;
+  double result;
+  cumDenomCount = 0;
+  result = 0.0;
+  for (i=1; i <= size; i++) {
+    if (denomCount[i] > 0) {
+      cumDenomCount += 1;
+      if (responsePtr[i] == predictedOutcome[i]) {
+        result += 1.0;
       }
     }
   }  
-  return splitLength;
+  if (cumDenomCount == 0) {
+    result = NA_REAL;
+  }
+  else {
+    result = 1.0 - result / (double) cumDenomCount;
+  }
+  return result;
 }
-void unstackSplitVector(uint   treeID,
-                        uint   splitVectorSize,
-                        uint   splitLength,
-                        char   factorFlag,
-                        char   deterministicSplitFlag,
-                        uint   mwcpSizeAbsolute,
-                        void  *splitVectorPtr) {
-  if (factorFlag == TRUE) {
-    free_uivector(splitVectorPtr, 1, splitLength * mwcpSizeAbsolute);
-    if (deterministicSplitFlag == FALSE) {
-      if (splitVectorSize > SAFE_FACTOR_SIZE) {
-        unbookFactor(RF_factorList[treeID][splitVectorSize]);
+void restoreMultiClassProb(uint treeID) {
+  Terminal *parent;
+  double maxValue, maxClass;
+  uint leaf;
+  uint j, k;
+  for (leaf = 1; leaf <= RF_tLeafCount[treeID]; leaf++) {
+    parent = RF_tTermList[treeID][leaf];
+    if ((parent -> membrCount) > 0) {
+      for (j = 1; j <= RF_rFactorCount; j++) {
+        for (k = 1; k <= RF_rFactorSize[j]; k++) {
+          (parent -> multiClassProb)[j][k] = RF_TN_CLAS_ptr[treeID][leaf][j][k];
+        }
+        maxValue = 0;
+        maxClass = 0;
+        for (k=1; k <= RF_rFactorSize[j]; k++) {
+          if (maxValue < (double) (parent -> multiClassProb[j][k])) {
+            maxValue = (double) parent -> multiClassProb[j][k];
+            maxClass = (double) k;
+          }
+        }
+        (parent -> maxClass)[j] = maxClass;
       }
     }
+    else {
+      RFprintf("\nRF-SRC:  *** ERROR *** ");
+      RFprintf("\nRF-SRC:  Zero node count encountered in restoreMultiClassProb() in (tree, leaf) = (%10d, %10d)  \n", treeID, parent -> nodeID);
+      RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+      error("\nRF-SRC:  The application will now exit.\n");
+    }
+  }
+}
+void getAtRiskAndEventCountsNew(uint       treeID,
+                                Terminal  *parent,
+                                uint      *repMembrIndx,
+                                uint       repMembrSize,
+                                uint      *allMembrIndx,
+                                uint       allMembrSize) {
+  uint *membershipIndex;
+  uint  membershipSize;
+  uint i, j, k;
+  uint ii;
+  char eventFlag;
+  if ((RF_opt & OPT_BOOT_NODE) | (RF_opt & OPT_BOOT_NONE)) {
+    membershipIndex = allMembrIndx;
+    membershipSize  = allMembrSize;
   }
   else {
-    if (deterministicSplitFlag == FALSE) {
-      free_dvector(splitVectorPtr, 1, splitLength);
+    membershipIndex = repMembrIndx;
+    membershipSize  = repMembrSize;
+  }
+  parent -> membrCount = membershipSize;
+  stackAtRiskAndEventCounts(parent, RF_eventTypeSize, RF_masterTimeSize);
+  for (j = 1; j <= RF_masterTimeSize; j++) {
+    (parent -> atRiskCount)[j]    = 0;
+    for (k = 1; k <= RF_eventTypeSize; k++) {
+      (parent -> eventCount)[k][j] = 0;
     }
   }
-}
-void stackRandomCovariates(uint      treeID,
-                           Node     *parent,
-                           uint      repMembrSize,
-                           char      multImpFlag,
-                           uint    **covariateIndex,
-                           uint     *covariateSize,
-                           double  **cdf,
-                           uint     *cdfSize,
-                           uint    **cdfSort,
-                           uint    **density,
-                           uint     *densitySize,
-                           uint   ***densitySwap) {
-  initializeCDF(treeID,
-                (RF_xWeightType == RF_WGHT_UNIFORM) ? NULL : NULL, 
-                (RF_xWeightType == RF_WGHT_UNIFORM) ? (parent -> permissibleSplit) : (parent -> permissibleSplit),
-                (RF_xWeightType == RF_WGHT_UNIFORM) ? parent -> xSize : parent -> xSize,
-                RF_xWeightType,
-                RF_xWeight,
-                RF_xWeightSorted,
-                RF_xWeightDensitySize,
-                covariateIndex,
-                covariateSize,
-                cdf,
-                cdfSize,
-                cdfSort,
-                density,
-                densitySize,
-                densitySwap);
-}
-void unstackRandomCovariates(uint     treeID,
-                             Node    *parent,
-                             uint    *covariateIndex,
-                             uint     covariateSize,
-                             double  *cdf,
-                             uint     cdfSize,
-                             uint    *cdfSort,
-                             uint    *density,
-                             uint     densitySize,
-                             uint   **densitySwap,
-                             uint     repMembrSize) {
-  discardCDF(treeID,
-             (RF_xWeightType == RF_WGHT_UNIFORM) ? parent -> xSize : parent -> xSize,
-             RF_xWeightType,
-             RF_xWeight,
-             RF_xWeightDensitySize,
-             covariateIndex,
-             density,
-             densitySwap,
-             cdf,
-             cdfSort);
-}
-char selectRandomCovariates(uint     treeID,
-                            Node     *parent,
-                            uint     *repMembrIndx,
-                            uint      repMembrSize,
-                            uint     *covariateIndex,
-                            uint     *uniformCovariateSize,
-                            uint     *uniformCovariateIndex,
-                            double   *cdf,
-                            uint     *cdfSize,
-                            uint     *cdfSort,
-                            uint     *density,
-                            uint     *densitySize,
-                            uint    **densitySwap,
-                            uint     *covariate,
-                            uint     *actualCovariateCount,
-                            uint     *candidateCovariateCount,
-                            double   *splitVector,
-                            uint     *splitVectorSize,
-                            uint    **indxx,
-                            uint      nonMissMembrSizeStatic,
-                            uint     *nonMissMembrIndxStatic,
-                            uint     *nonMissMembrSize,
-                            uint    **nonMissMembrIndx,
-                            char      multImpFlag) {
-  uint i, ii;
-  uint candidateCovariate;
-  uint offset;
-  double *nonMissSplit;
-  char mPredictorFlag;
-  char splittable;
-  if (nonMissMembrSizeStatic < 1) {
-    RFprintf("\nRF-SRC:  *** ERROR *** ");
-    RFprintf("\nRF-SRC:  Invalid nonMissMembrSizeStatic encountered in selectRandomCovariates():  %10d", nonMissMembrSizeStatic);
-    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-    error("\nRF-SRC:  The application will now exit.\n");
+  for (i=1; i <= membershipSize; i++) {
+    ii = membershipIndex[i];
+    for (j = 1; j <= RF_masterTimeIndex[treeID][ii]; j++) {
+      (parent -> atRiskCount)[j] ++;
+    }
+    if (RF_status[treeID][ii] > 0) {
+      if (RF_eventTypeSize > 1) {
+        k = RF_eventTypeIndex[(uint) RF_status[treeID][ii]];
+      }
+      else {
+        k = 1;
+      }
+      (parent -> eventCount)[k][RF_masterTimeIndex[treeID][ii]] ++;
+    }
+  }
+  parent -> eTimeSize = 0;
+  for (j = 1; j <= RF_masterTimeSize; j++) {
+    eventFlag = FALSE;
+    for (k = 1; k <= RF_eventTypeSize; k++) {
+      if ((parent -> eventCount)[k][j] > 0) {
+        eventFlag = TRUE;
+        k = RF_eventTypeSize;
+      }
+    }
+    if (eventFlag == TRUE) {
+      (parent -> eTimeSize)++;
+    }
   }
-  nonMissSplit = dvector(1, repMembrSize);
-  (*covariate) = candidateCovariate = -1;
-  splittable = FALSE;
-  (*indxx) = uivector(1, repMembrSize);
-  if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
-    *nonMissMembrSize = nonMissMembrSizeStatic;
-    *nonMissMembrIndx = nonMissMembrIndxStatic;
+  stackEventTimeIndex(parent, parent -> eTimeSize);
+  for (j = 1; j <= parent -> eTimeSize; j++) {
+    (parent -> eventTimeIndex)[j] = 0;
+  }
+  i = 0;
+  for (j = 1; j <= RF_masterTimeSize; j++) {
+    eventFlag = FALSE;
+    for (k = 1; k <= RF_eventTypeSize; k++) {
+      if ((parent -> eventCount)[k][j] > 0) {
+        eventFlag = TRUE;
+        k = RF_eventTypeSize;
+      }
+    }
+    if (eventFlag == TRUE) {
+      (parent -> eventTimeIndex)[++i] = j;
+    }
+  }
+  if (parent -> membrCount > 0) {
   }
   else {
-    *nonMissMembrSize = 0;
-    *nonMissMembrIndx = uivector(1, nonMissMembrSizeStatic);
+    if (!(RF_opt & OPT_OUTC_TYPE)) {
+      RFprintf("\nRF-SRC:  *** ERROR *** ");
+      RFprintf("\nRF-SRC:  Zero node count encountered in getAtRiskAndEventCounts() in (tree, leaf) = (%10d, %10d)  \n", treeID, parent -> nodeID);
+      error("\nRF-SRC:  The application will now exit.\n");
+    }
   }
-  while ( ((*candidateCovariateCount) < RF_randomCovariateCount) &&
-          (candidateCovariate != 0) && (splittable == FALSE)) {
-    candidateCovariate = sampleFromCDF(ran1B,
-                                       treeID,
-                                       RF_xWeightType,
-                                       covariateIndex,
-                                       *uniformCovariateSize,
-                                       uniformCovariateIndex,
-                                       cdf,
-                                       *cdfSize,
-                                       cdfSort,
-                                       density,
-                                       *densitySize);
-    if (candidateCovariate != 0) {
-      updateCDF(treeID,
-                RF_xWeightType,
-                RF_xWeight,
-                covariateIndex,
-                uniformCovariateSize,
-                *uniformCovariateIndex,
-                cdf,
-                cdfSize,
-                density,
-                densitySize,
-                densitySwap,
-                candidateCovariate);
-      (*actualCovariateCount) ++;
-      (*candidateCovariateCount) ++;
-      splittable = TRUE;
-      if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
-        for (i = 1; i <= repMembrSize; i++) {
-          nonMissSplit[i] = RF_observation[treeID][candidateCovariate][repMembrIndx[i]];
+}
+void getLocalRatios(uint treeID, Terminal *parent) {
+  uint j, q;
+  if (parent -> membrCount > 0) {
+    if(parent -> eTimeSize > 0) {
+      stackLocalRatio(parent, RF_eventTypeSize, parent -> eTimeSize);
+      for (j=1; j <= RF_eventTypeSize; j++) {
+        for (q = 1; q <= parent -> eTimeSize; q++) {
+          (parent -> localRatio)[j][q] = 0.0;
         }
-        *nonMissMembrSize = nonMissMembrSizeStatic;
-        *nonMissMembrIndx = nonMissMembrIndxStatic;
       }
-      else {
-        offset = RF_rSize + candidateCovariate;
-        (*nonMissMembrSize) = 0;
-        for (i = 1; i <= nonMissMembrSizeStatic; i++) {
-          ii = nonMissMembrIndxStatic[i];
-          mPredictorFlag = FALSE;
-          if (RF_mRecordMap[repMembrIndx[ii]] > 0) {
-            if (RF_mpSign[offset][RF_mRecordMap[repMembrIndx[ii]]] == 1) {
-                mPredictorFlag = TRUE;
+      for (j=1; j <= RF_eventTypeSize; j++) {
+        for (q = 1; q <= parent -> eTimeSize; q++) {
+          if ((parent -> eventCount)[j][(parent -> eventTimeIndex)[q]] > 0) {
+            if ((parent -> atRiskCount)[(parent -> eventTimeIndex)[q]] >= 1) {
+              (parent -> localRatio)[j][q] = ((double) (parent -> eventCount)[j][(parent -> eventTimeIndex)[q]] / (parent -> atRiskCount)[(parent -> eventTimeIndex)[q]]);
+            }
+            else {
+              RFprintf("\nRF-SRC:  *** ERROR *** ");
+              RFprintf("\nRF-SRC:  Zero At Risk Count encountered in local ratio calculation for (tree, leaf) = (%10d, %10d)", treeID, parent -> nodeID);
+              RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+              error("\nRF-SRC:  The application will now exit.\n");
             }
           }
-          if (!mPredictorFlag) {
-            (*nonMissMembrSize) ++;
-            (*nonMissMembrIndx)[*nonMissMembrSize] = ii;
-            nonMissSplit[*nonMissMembrSize] = RF_observation[treeID][candidateCovariate][repMembrIndx[(*nonMissMembrIndx)[*nonMissMembrSize]]];
-          }
-        }  
-      }  
-      if ((*nonMissMembrSize) == 0) {
-        splittable = FALSE;
+        }
       }
-      if (splittable) {
-        indexx((*nonMissMembrSize),
-               nonMissSplit,
-               (*indxx));
-        splitVector[1] = nonMissSplit[(*indxx)[1]];
-        (*splitVectorSize) = 1;
-        for (i = 2; i <= (*nonMissMembrSize); i++) {
-          if (nonMissSplit[(*indxx)[i]] > splitVector[(*splitVectorSize)]) {
-            (*splitVectorSize) ++;
-            splitVector[(*splitVectorSize)] = nonMissSplit[(*indxx)[i]];
-          }
+    }
+  }
+}
+void getLocalSurvival(uint treeID, Terminal *parent) {
+  uint j, q;
+  if(parent -> eTimeSize > 0) {
+    stackLocalSurvival(parent, parent -> eTimeSize);
+    for (q = 1; q <= parent -> eTimeSize; q++) {
+      (parent -> localSurvival)[q] = 0.0;
+    }
+    for (q = 1; q <= parent -> eTimeSize; q++) {
+      for (j = 1; j <= RF_eventTypeSize; j++) {
+        (parent -> localSurvival)[q] += (parent -> localRatio)[j][q];
+      }
+      (parent -> localSurvival)[q] = 1.0 - (parent -> localSurvival)[q];
+    }  
+    for (q = 2; q <= parent -> eTimeSize; q++) {
+      (parent -> localSurvival)[q] *= (parent -> localSurvival)[q-1];
+    }
+  }
+}
+void getLocalNelsonAalen(uint treeID, Terminal *parent) {
+  uint q;
+  if (parent -> eTimeSize > 0) {
+    stackLocalNelsonAalen(parent, parent -> eTimeSize);
+    for (q = 1; q <= parent -> eTimeSize; q++) {
+      (parent -> localNelsonAalen)[q] = 0.0;
+    }
+    for (q = 1; q <= parent -> eTimeSize; q++) {
+      (parent -> localNelsonAalen)[q] = (parent -> localRatio)[1][q];
+    }
+    for (q = 2; q <= parent -> eTimeSize; q++) {
+      (parent -> localNelsonAalen)[q] += (parent -> localNelsonAalen)[q-1];
+    }
+  }
+}
+void getLocalCSH(uint treeID, Terminal *parent) {
+  uint j, q;
+    if (parent -> eTimeSize > 0) {
+      stackLocalCSH(parent, RF_eventTypeSize, parent -> eTimeSize);
+      for (j=1; j <= RF_eventTypeSize; j++) {
+        for (q = 1; q <= parent -> eTimeSize; q++) {
+          (parent -> localCSH)[j][q] = 0.0;
         }
-        if((*splitVectorSize) >= 2) {
-          (*covariate) = candidateCovariate;
+      }
+      for (j=1; j <= RF_eventTypeSize; j++) {
+        for (q = 1; q <= parent -> eTimeSize; q++) {
+          (parent -> localCSH)[j][q] = (parent -> localRatio)[j][q];
         }
-        else {
-          splittable = FALSE;
+        for (q = 2; q <= parent -> eTimeSize; q++) {
+          (parent -> localCSH)[j][q] += (parent -> localCSH)[j][q-1];
         }
-      }  
-      if (!splittable) {
-        (parent -> permissibleSplit)[candidateCovariate] = FALSE;
-        (*actualCovariateCount) --;
       }
-    }  
-    else {
     }
-  }  
-  if (!splittable) {
-    free_uivector(*indxx, 1, repMembrSize);
-    if ((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP))) {
-      *nonMissMembrSize = 0;
-      *nonMissMembrIndx = NULL;
+}
+void getLocalCIF(uint treeID, Terminal *parent) {
+  uint j, q;
+  if(parent -> eTimeSize > 0) {
+    stackLocalCIF(parent, RF_eventTypeSize, parent -> eTimeSize);
+    for (j=1; j <= RF_eventTypeSize; j++) {
+      for (q = 1; q <= parent -> eTimeSize; q++) {
+        (parent -> localCIF)[j][q] = 0.0;
+      }
     }
-    else {
-      *nonMissMembrSize = 0;
-      free_uivector(*nonMissMembrIndx, 1, nonMissMembrSizeStatic);
+    for (j=1; j <= RF_eventTypeSize; j++) {
+      (parent -> localCIF)[j][1] = (parent -> localRatio)[j][1];
+      for (q = 2; q <= parent -> eTimeSize; q++) {
+        (parent -> localCIF)[j][q] = (parent -> localSurvival)[q-1] * (parent -> localRatio)[j][q];
+      }
+      for (q = 2; q <= parent -> eTimeSize; q++) {
+        (parent -> localCIF)[j][q] += (parent -> localCIF)[j][q-1];
+      }
     }
   }
-  free_dvector(nonMissSplit, 1, repMembrSize);
-  return splittable;
 }
-void unselectRandomCovariates(uint      treeID,
-                              Node     *parent,
-                              uint      repMembrSize,
-                              uint     *indxx,
-                              uint     nonMissMembrSizeStatic,
-                              uint    *nonMissMembrIndx,
-                              char      multImpFlag) {
-  free_uivector((indxx), 1, repMembrSize);
-  if (!((RF_mRecordSize == 0) || (multImpFlag) || (!(RF_optHigh & OPT_MISS_SKIP)))) {
-    free_uivector(nonMissMembrIndx, 1, nonMissMembrSizeStatic);
+void getSurvival(uint treeID, Terminal *parent) {
+  uint priorTimePointIndex, currentTimePointIndex;
+  uint i, k;
+  stackSurvival(parent, RF_sortedTimeInterestSize);
+  for (k=1; k <= RF_sortedTimeInterestSize; k++) {
+    (parent -> survival)[k] = 0.0;
   }
-}
-uint virtuallySplitNode(uint  treeID,
-                           char  factorFlag,
-                           uint  mwcpSizeAbsolute,
-                           uint  randomCovariate,
-                           uint *repMembrIndx,
-                           uint  repMembrSize,
-                           uint *nonMissMembrIndx,
-                           uint  nonMissMembrSize,
-                           uint *indxx,
-                           void *splitVectorPtr,
-                           uint  offset,
-                           char *localSplitIndicator,
-                           uint *leftSize,
-                           uint  priorMembrIter,
-                           uint *currentMembrIter) {
-  char daughterFlag;
-  char iterFlag;
-  iterFlag = TRUE;
-  *currentMembrIter = priorMembrIter;
-  while (iterFlag) {
-    (*currentMembrIter) ++;
-    if (factorFlag == TRUE) {
-      daughterFlag = splitOnFactor((uint)  RF_observation[treeID][randomCovariate][    repMembrIndx[nonMissMembrIndx[indxx[*currentMembrIter]]]     ],
-                                   (uint*) splitVectorPtr + ((offset - 1) * mwcpSizeAbsolute));
-      if ((*currentMembrIter) == nonMissMembrSize) {
-        iterFlag = FALSE;
+  if (parent -> eTimeSize > 0) {
+    priorTimePointIndex = 0;
+    currentTimePointIndex = 1;
+    for (i = 1; i <= (parent -> eTimeSize); i++) {
+      for (k = priorTimePointIndex + 1; k <= RF_sortedTimeInterestSize; k++) {
+        if (RF_timeInterest[k] <= RF_masterTime[(parent -> eventTimeIndex)[i]] ) {
+          currentTimePointIndex = k;
+        }
+        else {
+          k = RF_sortedTimeInterestSize;
+        }
+      }
+      (parent -> survival)[currentTimePointIndex] = (parent -> localSurvival)[i];
+      if (i == 1) {
+        for(k = 1; k < currentTimePointIndex; k++) {
+          (parent -> survival)[k] = 1.0;
+        }
+      }
+      if (i > 1) {
+        for(k = priorTimePointIndex + 1; k < currentTimePointIndex; k++) {
+          (parent -> survival)[k] = (parent -> survival)[priorTimePointIndex];
+        }
+      }
+      if (i == (parent -> eTimeSize)) {
+        for(k = currentTimePointIndex + 1; k <= RF_sortedTimeInterestSize; k++) {
+          (parent -> survival)[k] = (parent -> survival)[currentTimePointIndex];
+        }
       }
+      priorTimePointIndex = currentTimePointIndex;
     }
-    else {
-      if (RF_observation[treeID][randomCovariate][   repMembrIndx[nonMissMembrIndx[indxx[*currentMembrIter]]]    ] <= ((double*) splitVectorPtr)[offset]) {
-        daughterFlag = LEFT;
+  }
+  else {
+    for (k=1; k <= RF_sortedTimeInterestSize; k++) {
+      (parent -> survival)[k] = 1.0;
+    }
+  }
+}
+void getNelsonAalen(uint treeID, Terminal *parent) {
+  uint i, k, q;
+  uint priorTimePointIndex, currentTimePointIndex;
+  stackNelsonAalen(parent, RF_sortedTimeInterestSize);
+  for (q = 1; q <= RF_sortedTimeInterestSize; q++) {
+    (parent -> nelsonAalen)[q] = 0.0;
+  }
+  priorTimePointIndex = 0;
+  currentTimePointIndex = 1;
+  for (i = 1; i <= (parent -> eTimeSize); i++) {
+    for (k = priorTimePointIndex + 1; k <= RF_sortedTimeInterestSize; k++) {
+      if (RF_timeInterest[k] <= RF_masterTime[(parent -> eventTimeIndex)[i]] ) {
+        currentTimePointIndex = k;
       }
       else {
-        daughterFlag = RIGHT;
-        iterFlag = FALSE;
+        k = RF_sortedTimeInterestSize;
       }
     }
-    localSplitIndicator[     nonMissMembrIndx[indxx[*currentMembrIter]]   ] = daughterFlag;
-    if (daughterFlag == LEFT) {
-      (*leftSize) ++;
-    }  
-    else {
+    (parent -> nelsonAalen)[currentTimePointIndex] = (parent -> localNelsonAalen)[i];
+    if (i > 1) {
+      for(k = priorTimePointIndex + 1; k < currentTimePointIndex; k++) {
+        (parent -> nelsonAalen)[k] = (parent -> nelsonAalen)[priorTimePointIndex];
+      }
     }
-  }  
-  return (*leftSize);
- }
-void getReweightedRandomPair (uint    treeID,
-                              uint    relativeFactorSize,
-                              uint    absoluteFactorSize,
-                              double *absoluteLevel,
-                              uint   *result) {
-  uint randomGroupIndex;
-  if(RF_factorList[treeID][relativeFactorSize] == NULL) {
-    RFprintf("\nRF-SRC:  *** ERROR *** ");
-    RFprintf("\nRF-SRC:  Factor not allocated for size:  %10d", relativeFactorSize);
-    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-    error("\nRF-SRC:  The application will now exit.\n");
+    if (i == (parent -> eTimeSize)) {
+      for(k = currentTimePointIndex + 1; k <= RF_sortedTimeInterestSize; k++) {
+        (parent -> nelsonAalen)[k] = (parent -> nelsonAalen)[currentTimePointIndex];
+      }
+    }
+    priorTimePointIndex = currentTimePointIndex;
   }
-  randomGroupIndex = (uint) ceil(ran1B(treeID) * ((RF_factorList[treeID][relativeFactorSize] -> cardinalGroupCount) * 1.0));
-  createRandomBinaryPair(treeID, relativeFactorSize, absoluteFactorSize, randomGroupIndex, absoluteLevel, result);
 }
-void getRandomPair (uint treeID, uint relativeFactorSize, uint absoluteFactorSize, double *absoluteLevel, uint *result) {
-  uint randomGroupIndex;
-  double randomValue;
-  uint k;
-  if(RF_factorList[treeID][relativeFactorSize] == NULL) {
-    RFprintf("\nRF-SRC:  *** ERROR *** ");
-    RFprintf("\nRF-SRC:  Factor not allocated for size:  %10d", relativeFactorSize);
-    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-    error("\nRF-SRC:  The application will now exit.\n");
-  }
-  double *cdf = dvector(1, RF_factorList[treeID][relativeFactorSize] -> cardinalGroupCount);
-  if (relativeFactorSize <= MAX_EXACT_LEVEL) {
-    for (k=1; k <= RF_factorList[treeID][relativeFactorSize] -> cardinalGroupCount; k++) {
-      cdf[k] = (double) ((uint*) RF_factorList[treeID][relativeFactorSize] -> cardinalGroupSize)[k];
+void getCSH(uint treeID, Terminal *parent) {
+  uint priorTimePointIndex, currentTimePointIndex;
+  uint i, j, k;
+  stackCSH(parent, RF_eventTypeSize, RF_sortedTimeInterestSize);
+  for (j=1; j <= RF_eventTypeSize; j++) {
+    for (k=1; k <= RF_sortedTimeInterestSize; k++) {
+      (parent -> CSH)[j][k] = 0.0;
     }
   }
-  else {
-    for (k=1; k <= RF_factorList[treeID][relativeFactorSize] -> cardinalGroupCount; k++) {
-      cdf[k] = ((double*) RF_factorList[treeID][relativeFactorSize] -> cardinalGroupSize)[k];
+  priorTimePointIndex = 0;
+  currentTimePointIndex = 1;
+  for (i = 1; i <= (parent -> eTimeSize); i++) {
+    for (k = priorTimePointIndex + 1; k <= RF_sortedTimeInterestSize; k++) {
+      if (RF_timeInterest[k] <= RF_masterTime[(parent -> eventTimeIndex)[i]] ) {
+        currentTimePointIndex = k;
+      }
+      else {
+        k = RF_sortedTimeInterestSize;
+      }
     }
+    for (j=1; j <= RF_eventTypeSize; j++) {
+      (parent -> CSH)[j][currentTimePointIndex] = (parent -> localCSH)[j][i];
+      if (i > 1) {
+        for(k = priorTimePointIndex + 1; k < currentTimePointIndex; k++) {
+          (parent -> CSH)[j][k] = (parent -> CSH)[j][priorTimePointIndex];
+        }
+      }
+      if (i == (parent -> eTimeSize)) {
+        for(k = currentTimePointIndex + 1; k <= RF_sortedTimeInterestSize; k++) {
+          (parent -> CSH)[j][k] = (parent -> CSH)[j][currentTimePointIndex];
+        }
+      }
+    }
+    priorTimePointIndex = currentTimePointIndex;
   }
-  for (k=2; k <= RF_factorList[treeID][relativeFactorSize] -> cardinalGroupCount; k++) {
-    cdf[k] += cdf[k-1];
-  }
-  randomValue = ceil((ran1B(treeID) * cdf[RF_factorList[treeID][relativeFactorSize] -> cardinalGroupCount]));
-  randomGroupIndex = 1;
-  while (randomValue > cdf[randomGroupIndex]) {
-    randomGroupIndex ++;
-  }
-  free_dvector(cdf, 1, RF_factorList[treeID][relativeFactorSize] -> cardinalGroupCount);
-  createRandomBinaryPair(treeID, relativeFactorSize, absoluteFactorSize, randomGroupIndex, absoluteLevel, result);
 }
-void createRandomBinaryPair(uint    treeID,
-                            uint    relativeFactorSize,
-                            uint    absoluteFactorSize,
-                            uint    groupIndex,
-                            double *absoluteLevel,
-                            uint   *pair) {
-  uint mwcpLevelIdentifier;
-  uint mwcpSizeAbsolute;
-  uint offset, levelSize, levelIndex;
-  uint k;
-  levelIndex = 0;  
-  mwcpSizeAbsolute = RF_factorList[treeID][absoluteFactorSize] -> mwcpSize;
-  uint *levelVector = uivector(1, relativeFactorSize);
-  uint *randomLevel = uivector(1, groupIndex);
-  for (k = 1; k <= relativeFactorSize; k++) {
-    levelVector[k] = k;
-  }
-  levelSize = relativeFactorSize;
-  for (k = 1; k <= groupIndex; k++) {
-    randomLevel[k] = sampleUniformlyFromVector(treeID,
-                                               levelVector,
-                                               levelSize,
-                                               &levelIndex);
-    levelVector[levelIndex] = levelVector[levelSize];
-    levelSize --;
-  }
-  for (k = 1; k <= groupIndex; k++) {
-    randomLevel[k] = (uint) absoluteLevel[randomLevel[k]];
-  }
-  for (offset = 1; offset <= mwcpSizeAbsolute; offset++) {
-    pair[offset] = 0;
+void getCIF(uint treeID, Terminal *parent) {
+  uint priorTimePointIndex, currentTimePointIndex;
+  uint i, j, k;
+  stackCIF(parent, RF_eventTypeSize, RF_sortedTimeInterestSize);
+  for (j=1; j <= RF_eventTypeSize; j++) {
+    for (k=1; k <= RF_sortedTimeInterestSize; k++) {
+      (parent -> CIF)[j][k] = 0.0;
+    }
   }
-  for (k = 1; k <= groupIndex; k++) {
-    mwcpLevelIdentifier = (randomLevel[k] >> (3 + ulog2(SIZE_OF_INTEGER))) + ((randomLevel[k] & (MAX_EXACT_LEVEL - 1)) ? 1 : 0);
-    pair[mwcpLevelIdentifier] += upower(2, randomLevel[k] - ((mwcpLevelIdentifier - 1) * MAX_EXACT_LEVEL) - 1 );
+  priorTimePointIndex = 0;
+  currentTimePointIndex = 1;
+  for (i = 1; i <= (parent -> eTimeSize); i++) {
+    for (k = priorTimePointIndex + 1; k <= RF_sortedTimeInterestSize; k++) {
+      if (RF_timeInterest[k] <= RF_masterTime[(parent -> eventTimeIndex)[i]] ) {
+        currentTimePointIndex = k;
+      }
+      else {
+        k = RF_sortedTimeInterestSize;
+      }
+    }
+    for (j = 1; j <= RF_eventTypeSize; j++) {
+      (parent -> CIF)[j][currentTimePointIndex] = (parent -> localCIF)[j][i];
+      if (i > 1) {
+        for(k = priorTimePointIndex + 1; k < currentTimePointIndex; k++) {
+          (parent -> CIF)[j][k] = (parent -> CIF)[j][priorTimePointIndex];
+        }
+      }
+      if (i == (parent -> eTimeSize)) {
+        for(k = currentTimePointIndex + 1; k <= RF_sortedTimeInterestSize; k++) {
+          (parent -> CIF)[j][k] = (parent -> CIF)[j][currentTimePointIndex];
+        }
+      }
+    }
+    priorTimePointIndex = currentTimePointIndex;
   }
-  free_uivector(levelVector, 1, relativeFactorSize);
-  free_uivector(randomLevel, 1, groupIndex);
 }
-void convertRelToAbsBinaryPair(uint    treeID,
-                               uint    relativeFactorSize,
-                               uint    absoluteFactorSize,
-                               uint    relativePair,
-                               double *absoluteLevel,
-                               uint   *pair) {
-  uint mwcpLevelIdentifier;
-  uint mwcpSizeAbsolute;
-  uint coercedAbsoluteLevel;
-  uint k, offset;
-  mwcpSizeAbsolute = RF_factorList[treeID][absoluteFactorSize] -> mwcpSize;
-  for (offset = 1; offset <= mwcpSizeAbsolute; offset++) {
-    pair[offset] = 0;
+void getMortality(uint treeID, Terminal *parent) {
+  uint j, q;
+  stackMortality(parent, RF_eventTypeSize);
+  for (j = 1; j <= RF_eventTypeSize; j++) {
+    (parent -> mortality)[j] = 0.0;
   }
-  for (k = 1; k <= relativeFactorSize; k++) {
-    if (relativePair & ((uint) 0x01)) {
-      coercedAbsoluteLevel = (uint) absoluteLevel[k];
-      mwcpLevelIdentifier = (coercedAbsoluteLevel >> (3 + ulog2(SIZE_OF_INTEGER))) + ((coercedAbsoluteLevel & (MAX_EXACT_LEVEL - 1)) ? 1 : 0);
-      pair[mwcpLevelIdentifier] += upower(2, coercedAbsoluteLevel - ((mwcpLevelIdentifier - 1) * MAX_EXACT_LEVEL) - 1 );
+  if (!(RF_opt & OPT_COMP_RISK)) {
+    for (q = 1; q <= RF_sortedTimeInterestSize; q++) {
+      (parent -> mortality)[1] += (parent -> nelsonAalen)[q];
     }
-    relativePair = relativePair >> 1;
-  }
-}
-char summarizeSplitResult(uint    splitParameterMax,
-                          double  splitValueMaxCont,
-                          uint    splitValueMaxFactSize,
-                          uint   *splitValueMaxFactPtr,
-                          double *splitStatistic,
-                          double  deltaMax) {
-  char result;
-  if (splitParameterMax > 0) {
-    *splitStatistic = deltaMax;
-    result = TRUE;
   }
   else {
-    result = FALSE;
+    for (j = 1; j <= RF_eventTypeSize; j ++) {
+      for (q = 1; q <= RF_sortedTimeInterestSize - 1; q++) {
+        (parent -> mortality)[j] += (parent -> CIF)[j][q] * (RF_timeInterest[q+1] - RF_timeInterest[q]);
+      }
+    }
   }
-  return result;
 }
-char getPreSplitResult (uint      treeID,
-                        Node     *parent,
-                        uint      repMembrSize,
-                        uint     *repMembrIndx,
-                        uint     *nonMissMembrSize,
-                        uint    **nonMissMembrIndx,
-                        double  **splitVector,
-                        double   *preSplitMean,
-                        char      multImpFlag,
-                        char      multVarFlag) {
-  uint i, r;
-  char mResponseFlag;
-  char result;
-  if (repMembrSize >= (2 * RF_minimumNodeSize)) {
-    result = TRUE;
+void restoreSurvival(uint treeID, Terminal *parent) {
+  (parent -> survival) = RF_TN_SURV_ptr[treeID][parent -> nodeID];
+  if (parent -> membrCount > 0) {
   }
   else {
-    result = FALSE;
+    RFprintf("\nRF-SRC:  *** ERROR *** ");
+    RFprintf("\nRF-SRC:  Zero node count encountered in restoreSurvival() in (tree, leaf) = (%10d, %10d)  \n", treeID, parent -> nodeID);
+    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+    error("\nRF-SRC:  The application will now exit.\n");
   }
-  if (result) {
-    if (RF_maximumNodeDepth < 0) {
-      result = TRUE;
+}
+void restoreMortality(uint treeID, Terminal *parent) {
+  (parent -> mortality) = RF_TN_MORT_ptr[treeID][parent -> nodeID];
+}
+void restoreNelsonAalen(uint treeID, Terminal *parent) {
+  (parent -> nelsonAalen) = RF_TN_NLSN_ptr[treeID][parent -> nodeID];
+}
+void restoreCSH(uint treeID, Terminal *parent) {
+  (parent -> CSH) = RF_TN_CSHZ_ptr[treeID][parent -> nodeID];
+}
+void restoreCIF(uint treeID, Terminal *parent) {
+  (parent -> CIF) = RF_TN_CIFN_ptr[treeID][parent -> nodeID];
+}
+void updateEnsembleSurvival(uint mode,
+                            uint treeID,
+                            uint serialTreeID) {
+  char oobFlag, fullFlag, selectionFlag, outcomeFlag;
+  Terminal ***termMembershipPtr;
+  uint    *membershipIndex;
+  uint     membershipSize;
+  double ***ensembleSRGnum;
+  double ***ensembleCIFnum;
+  double  **ensembleSRVnum;
+  double  **ensembleMRTptr;
+  double  **ensembleMRTnum;
+  uint     *ensembleDen;
+  Terminal *parent;
+  uint i, j, k;
+  uint ii;
+  uint partialIndex;
+  ensembleSRGnum = NULL;  
+  ensembleCIFnum = NULL;  
+  ensembleSRVnum = NULL;  
+  ensembleMRTptr = NULL;  
+  ensembleMRTnum = NULL;  
+  ensembleDen    = NULL;  
+  oobFlag = fullFlag = FALSE;
+  switch (mode) {
+  case RF_PRED:
+    if (RF_opt & OPT_FENS) {
+      fullFlag = TRUE;
     }
-    else {
-      if (parent -> depth < (uint) RF_maximumNodeDepth) {
-        result = TRUE;
-      }
-      else {
-        result = FALSE;
+    termMembershipPtr = RF_ftTermMembership;
+    break;
+  default:
+    if (RF_opt & OPT_OENS) {
+      if (RF_oobSize[treeID] > 0) {
+        oobFlag = TRUE;
       }
     }
+    if (RF_opt & OPT_FENS) {
+      fullFlag = TRUE;
+    }
+    termMembershipPtr = RF_tTermMembership;
+    break;
   }
-  if (result) {
-    *splitVector = dvector(1, repMembrSize);
-    if ((RF_mRecordSize == 0) || multImpFlag || !(RF_optHigh & OPT_MISS_SKIP) || multVarFlag) {
-      (*nonMissMembrSize) = repMembrSize;
-      (*nonMissMembrIndx) = RF_identityMembershipIndex;
+  partialIndex = getEnsemblePartialIndex(treeID);
+  outcomeFlag = (RF_ensemblePartialFlag) ? FALSE : TRUE;
+  while ((oobFlag == TRUE) || (fullFlag == TRUE)) {
+    if (oobFlag == TRUE) {
+      ensembleSRGnum = RF_oobEnsembleSRGnum;
+      ensembleMRTptr = RF_oobEnsembleMRTptr;        
+      ensembleMRTnum = RF_oobEnsembleMRTnum;
+      ensembleSRVnum = RF_oobEnsembleSRVnum;
+      ensembleCIFnum = RF_oobEnsembleCIFnum;
+      ensembleDen    = RF_oobEnsembleDen;
+      if (RF_ensemblePartialFlag) {
+        ensembleSRGnum = RF_oobEnsembleSRGpart[partialIndex];
+        ensembleMRTnum = RF_oobEnsembleMRTpart[partialIndex];
+        ensembleSRVnum = RF_oobEnsembleSRVpart[partialIndex];
+        ensembleCIFnum = RF_oobEnsembleCIFpart[partialIndex];
+        ensembleDen    = RF_oobEnsembleDenPart[partialIndex];
+      }
+      membershipSize  = RF_oobSize[treeID];
+      membershipIndex = RF_oobMembershipIndex[treeID];
     }
     else {
-      *nonMissMembrIndx = uivector(1, repMembrSize);
-      (*nonMissMembrSize) = 0;
-      for (i = 1; i <= repMembrSize; i++) {
-        mResponseFlag = FALSE;
-        if (RF_mRecordMap[repMembrIndx[i]] > 0) {
-          for (r = 1; r <= RF_rSize; r++) {
-            if (RF_mpSign[r][RF_mRecordMap[repMembrIndx[i]]] == 1) {
-              mResponseFlag = TRUE;
-            }
-          }
-        }
-        if (!mResponseFlag) {
-          (*nonMissMembrSize) ++;
-          (*nonMissMembrIndx)[(*nonMissMembrSize)] = i;
+      ensembleSRGnum = RF_fullEnsembleSRGnum;
+      ensembleMRTptr = RF_fullEnsembleMRTptr;
+      ensembleMRTnum = RF_fullEnsembleMRTnum;        
+      ensembleSRVnum = RF_fullEnsembleSRVnum;
+      ensembleCIFnum = RF_fullEnsembleCIFnum;
+      ensembleDen    = RF_fullEnsembleDen;
+      if (RF_ensemblePartialFlag) {
+        ensembleSRGnum = RF_fullEnsembleSRGpart[partialIndex];
+        ensembleMRTnum = RF_fullEnsembleMRTpart[partialIndex];
+        ensembleSRVnum = RF_fullEnsembleSRVpart[partialIndex];
+        ensembleCIFnum = RF_fullEnsembleCIFpart[partialIndex];
+        ensembleDen    = RF_fullEnsembleDenPart[partialIndex];
+      }
+      switch (mode) {
+      case RF_PRED:
+        membershipSize = RF_fobservationSize;
+        membershipIndex = RF_fidentityMembershipIndex;
+        break;
+      default:
+        membershipSize  = RF_observationSize;
+        membershipIndex = RF_identityMembershipIndex;
+        break;
+      }
+    }
+    for (i = 1; i <= membershipSize; i++) {
+      ii = membershipIndex[i];
+      parent = termMembershipPtr[treeID][ii];
+      selectionFlag = TRUE;
+      if (RF_opt & OPT_OUTC_TYPE) {
+        if ((parent -> membrCount) > 0) {
         }
-      }  
-    }  
-    if (!multVarFlag) {
-      if ((RF_timeIndex > 0) && (RF_statusIndex > 0)) {
-        uint q,k,m;
-        uint *evntProp = uivector(1, RF_eventTypeSize + 1);
-        for (q=1; q <= RF_eventTypeSize + 1; q++) {
-          evntProp[q] = 0;
+        else {
+          selectionFlag = FALSE;
         }
-        for (i = 1; i <= (*nonMissMembrSize); i++) {
-          m = (uint) RF_status[treeID][repMembrIndx[(*nonMissMembrIndx)[i]]];
-          if (m > 0) {
-            evntProp[RF_eventTypeIndex[m]] ++;
-          }
-          else {
-            evntProp[RF_eventTypeSize + 1] ++;
+      }
+      if (selectionFlag) {
+        ensembleDen[ii] ++;
+        if (!(RF_opt & OPT_COMP_RISK)) {
+          ensembleMRTnum[1][ii] += parent -> mortality[1];
+          for (k=1; k <= RF_sortedTimeInterestSize; k++) {
+            ensembleSRGnum[1][k][ii] += parent -> nelsonAalen[k];
+            ensembleSRVnum[k][ii] += parent -> survival[k];
           }
-        }
-        k = 0;
-        for (q = 1; q <= RF_eventTypeSize + 1; q++) {
-          if(evntProp[q] > 0) {
-            k ++;
+          if (outcomeFlag) {
+            if (ensembleDen[ii] != 0) {
+              ensembleMRTptr[1][ii] = ensembleMRTnum[1][ii] / ensembleDen[ii];
+            }
           }
         }
-        if (k == 0) {
-          result = FALSE;
-        }
         else {
-          if (k == 1) {
-            if (evntProp[RF_eventTypeSize + 1] > 0) {
-              result = FALSE;
+          for (j = 1; j <= RF_eventTypeSize; j++) {
+            ensembleMRTnum[j][ii] += parent -> mortality[j];
+            for (k=1; k <= RF_sortedTimeInterestSize; k++) {
+              ensembleSRGnum[j][k][ii] += parent -> CSH[j][k];
+              ensembleCIFnum[j][k][ii] += parent -> CIF[j][k];
             }
-            else {
-              result = getVariance(repMembrSize,
-                                   repMembrIndx,
-                                   *nonMissMembrSize,
-                                   *nonMissMembrIndx,
-                                   RF_time[treeID],
-                                   preSplitMean,
-                                   NULL);
+          }
+          if (outcomeFlag) {
+            if (ensembleDen[ii] != 0) {
+              for (j = 1; j <= RF_eventTypeSize; j ++) {
+                ensembleMRTptr[j][ii] = ensembleMRTnum[j][ii] / ensembleDen[ii];
+              }
             }
           }
         }
-        free_uivector(evntProp, 1, RF_eventTypeSize + 1);
-      }
-      else {
-        result = getVariance(repMembrSize,
-                             repMembrIndx,
-                             *nonMissMembrSize,
-                             *nonMissMembrIndx,
-                             RF_response[treeID][1],
-                             preSplitMean,
-                             NULL);
       }
+    }  
+    if (outcomeFlag == TRUE) {
+      outcomeFlag = FALSE;
     }
-    if (!result) {
-      free_dvector(*splitVector, 1, repMembrSize);
-      (*nonMissMembrSize) = 0;
-      if (!((RF_mRecordSize == 0) || multImpFlag || !(RF_optHigh & OPT_MISS_SKIP) || multVarFlag)) {
-        free_uivector(*nonMissMembrIndx, 1, repMembrSize);
-      }
+    if (oobFlag == TRUE) {
+      oobFlag = FALSE;
     }
-  }
-  return result;
-}
-void unstackPreSplit (char      preliminaryResult,
-                      char      multImpFlag,
-                      char      multVarFlag,
-                      uint      repMembrSize,
-                      double   *splitVector,
-                      uint     *nonMissMembrIndx) {
-  if (preliminaryResult) {
-    free_dvector(splitVector, 1, repMembrSize);
-    if (!((RF_mRecordSize == 0) || multImpFlag || !(RF_optHigh & OPT_MISS_SKIP) || multVarFlag)) {
-      free_uivector(nonMissMembrIndx, 1, repMembrSize);
+    else {
+      fullFlag = FALSE;
     }
-  }
-  else {
-  }
+  }  
 }
-char updateMaximumSplit(uint    treeID,
-                        Node   *parent,
-                        double  delta,
-                        uint    candidateCovariateCount,
-                        uint    covariate,
-                        uint    index,
-                        char    factorFlag,
-                        uint    mwcpSizeAbsolute,
-                        uint    repMembrSize,
-                        char   *localSplitIndicator,
-                        double *deltaMax,
-                        uint   *splitParameterMax,
-                        double *splitValueMaxCont,
-                        uint   *splitValueMaxFactSize,
-                        uint  **splitValueMaxFactPtr,
-                        void   *splitVectorPtr,
-                        char  **splitIndicator) {
-  char flag;
-  uint k;
-  if (RF_opt & OPT_NODE_STAT) {
-    updateNodeStatistics(parent, delta, candidateCovariateCount, covariate);
-  }
-  if(ISNA(delta)) {
-    flag = FALSE;
-  }
-  else {
-    if(ISNA(*deltaMax)) {
-      flag = TRUE;
+void getEnsembleMortalityCR(uint      mode,
+                            uint      treeID,
+                            uint      obsSize,
+                            double  **ensembleMRTptr,
+                            uint     *ensembleDen,
+                            double  **cMortality) {
+  uint i, j;
+  for (i = 1; i <= obsSize; i++) {
+    if (ensembleDen[i] != 0) {
+      for (j = 1; j <= RF_eventTypeSize; j ++) {
+        cMortality[j][i] = ensembleMRTptr[j][i] / ensembleDen[i];
+      }
     }
     else {
-      if ((delta - *deltaMax) > EPSILON) {
-        flag = TRUE;
-      }
-      else {
-        flag = FALSE;
+      for (j = 1; j <= RF_eventTypeSize; j ++) {
+        cMortality[j][i] = NA_REAL;
       }
     }
   }
-  if (flag) {
-    *deltaMax = delta;
-    *splitParameterMax = covariate;
-    if (factorFlag == TRUE) {
-      if (*splitValueMaxFactSize > 0) {
-        if (*splitValueMaxFactSize != mwcpSizeAbsolute) {
-          free_uivector(*splitValueMaxFactPtr, 1, *splitValueMaxFactSize);
-          *splitValueMaxFactSize = mwcpSizeAbsolute;
-          *splitValueMaxFactPtr = uivector(1, *splitValueMaxFactSize);
-        }
-      }
-      else {
-        *splitValueMaxFactSize = mwcpSizeAbsolute;
-        *splitValueMaxFactPtr = uivector(1, *splitValueMaxFactSize);
-      }
-      *splitValueMaxCont = NA_REAL;
-      for (k=1; k <= *splitValueMaxFactSize; k++) {
-        (*splitValueMaxFactPtr)[k] =
-          ((uint*) splitVectorPtr + ((index - 1) * (*splitValueMaxFactSize)))[k];
-      }
+}
+void getEnsembleMortality(uint      mode,
+                          uint      treeID,
+                          uint      obsSize,
+                          double  **ensembleMRTptr,
+                          uint     *ensembleDen,
+                          double   *mortality) {
+  uint i;
+  for (i = 1; i <= obsSize; i++) {
+    if (ensembleDen[i] != 0) {
+      mortality[i] = ensembleMRTptr[1][i] / ensembleDen[i];
     }
     else {
-      if (*splitValueMaxFactSize > 0) {
-        free_uivector(*splitValueMaxFactPtr, 1, *splitValueMaxFactSize);
-        *splitValueMaxFactSize = 0;
-        *splitValueMaxFactPtr = NULL;
-      }
-      else {
-      }
-      *splitValueMaxCont = ((double*) splitVectorPtr)[index];
-    }
-    if (*splitIndicator == NULL) {
-     *splitIndicator = cvector(1, repMembrSize);
+      mortality[i] = NA_REAL;
     }
-   for (k=1; k <= repMembrSize; k++) {
-     (*splitIndicator)[k] = localSplitIndicator[k];
-   }
   }
-  else {
+}
+void getConditionalConcordanceArrays(uint     j,
+                                     double  *timePtr,
+                                     double  *statusPtr,
+                                     double  *mortalityPtr,
+                                     uint    *genericEnsembleDenPtr,
+                                     uint    *meIndividualSize,
+                                     uint   **eIndividual,
+                                     double  *subsettedTime,
+                                     double  *subsettedStatus,
+                                     double  *subsettedMortality,
+                                     uint    *subsettedEnsembleDen) {
+  uint i;
+  if (!(RF_opt & OPT_COMP_RISK)) {
+    RFprintf("\nRF-SRC:  *** ERROR *** ");
+    RFprintf("\nRF-SRC:  Attempt to update event type subsets in a non-CR analysis.");
+    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+    error("\nRF-SRC:  The application will now exit.\n");
+  }
+  for (i = 1; i <= meIndividualSize[j]; i++) {
+    subsettedTime[i]        = timePtr[eIndividual[j][i]];
+    subsettedStatus[i]      = statusPtr[eIndividual[j][i]];
+    subsettedMortality[i]   = mortalityPtr[eIndividual[j][i]];
+    subsettedEnsembleDen[i] = genericEnsembleDenPtr[eIndividual[j][i]];
   }
-  return flag;
 }
-void updateNodeStatistics(Node *parent, double delta, uint candidateCovariateCount, uint covariate) {
-  char flag;
-  if(ISNA(delta)) {
-    flag = FALSE;
+double getConcordanceIndex(int     polarity,
+                           uint    size,
+                           double *timePtr,
+                           double *statusPtr,
+                           double *predictedOutcome,
+                           uint   *denCount) {
+  double result;
+  if (RF_optHigh & OPT_CONC_PAIR) {
+    result = getConcordanceIndexPairwise(polarity, size, timePtr, statusPtr, predictedOutcome, denCount);
   }
   else {
-    if(ISNA((parent -> mtryStat)[candidateCovariateCount])) {
-      flag = TRUE;
+    result = getConcordanceIndexSorted(polarity, size, timePtr, statusPtr, predictedOutcome, denCount);
+  }
+  return result;
+}
+uint getConcordancePrefix(double *sortedValue, uint size, double value, char type) {
+  uint low, high, mid;
+  char flag;
+  low = 0;
+  high = size;
+  while (low < high) {
+    mid = (low + high + 1) >> 1;
+    switch (type) {
+    case 1:
+      flag = (value - sortedValue[mid] > EPSILON);
+      break;
+    case 2:
+      flag = (value - sortedValue[mid] >= EPSILON);
+      break;
+    case 3:
+      flag = (sortedValue[mid] - value < EPSILON);
+      break;
+    default:
+      flag = (sortedValue[mid] - value <= EPSILON);
+      break;
     }
-    else {
-      if ((delta - (parent -> mtryStat)[candidateCovariateCount]) > EPSILON) {
-        flag = TRUE;
-      }
-      else {
-        flag = FALSE;
-      }
+    if (flag) {
+      low = mid;
     }
+    else {
+      high = mid - 1;
+    }
+  }
+  return low;
+}
+double getConcordanceIndexSorted(int     polarity,
+                                 uint    size,
+                                 double *timePtr,
+                                 double *statusPtr,
+                                 double *predictedOutcome,
+                                 uint   *denCount) {
+  uint    validSize, eventSize;
+  uint   *validIndx, *timeIndx, *predIndx, *predRank;
+  double *validTime, *validPred, *sortedTime, *sortedPred;
+  uint   *eventLower, *eventUpper, *predLess, *predTieLow, *predTieHigh;
+  double *allTree, *censTree, *eventTree;
+  double *lowerCensCount, *lowerCensLess, *lowerCensTie, *lowerEventCount, *lowerEventTie;
+  double  censCount, eventCount;
+  double  allLess, allTie, censLess, censTie, eventTie;
+  double  concordancePairSize, concordanceWorseCount;
+  double  tiedPairSize, tiedWorseCount;
+  double  result;
+  uint    sweep, pass;
+  uint    i, k, q;
+  validSize = 0;
+  for (i = 1; i <= size; i++) {
+    if (denCount[i] != 0) {
+      validSize ++;
+    }
+  }
+  if (validSize < 2) {
+    return NA_REAL;
+  }
+  validIndx  = uivector(1, validSize);
+  validTime  = dvector(1, validSize);
+  validPred  = dvector(1, validSize);
+  sortedTime = dvector(1, validSize);
+  sortedPred = dvector(1, validSize);
+  timeIndx   = uivector(1, validSize);
+  predIndx   = uivector(1, validSize);
+  predRank   = uivector(1, validSize);
+  k = 0;
+  for (i = 1; i <= size; i++) {
+    if (denCount[i] != 0) {
+      validIndx[++k] = i;
+      validTime[k] = timePtr[i];
+      validPred[k] = predictedOutcome[i];
+    }
+  }
+  indexx(validSize, validTime, timeIndx);
+  indexx(validSize, validPred, predIndx);
+  for (k = 1; k <= validSize; k++) {
+    sortedTime[k] = validTime[timeIndx[k]];
+    sortedPred[k] = validPred[predIndx[k]];
+    predRank[predIndx[k]] = k;
+  }
+  eventSize = 0;
+  for (k = 1; k <= validSize; k++) {
+    if (statusPtr[validIndx[timeIndx[k]]] > 0) {
+      eventSize ++;
+    }
+  }
+  concordancePairSize = concordanceWorseCount = 0.0;
+  tiedPairSize = tiedWorseCount = 0.0;
+  if (eventSize > 0) {
+    eventLower  = uivector(1, eventSize);
+    eventUpper  = uivector(1, eventSize);
+    predLess    = uivector(1, eventSize);
+    predTieLow  = uivector(1, eventSize);
+    predTieHigh = uivector(1, eventSize);
+    lowerCensCount  = dvector(1, eventSize);
+    lowerCensLess   = dvector(1, eventSize);
+    lowerCensTie    = dvector(1, eventSize);
+    lowerEventCount = dvector(1, eventSize);
+    lowerEventTie   = dvector(1, eventSize);
+    allTree   = dvector(1, validSize);
+    censTree  = dvector(1, validSize);
+    eventTree = dvector(1, validSize);
+    q = 0;
+    for (k = 1; k <= validSize; k++) {
+      i = timeIndx[k];
+      if (statusPtr[validIndx[i]] > 0) {
+        q++;
+        eventLower[q]  = getConcordancePrefix(sortedTime, validSize, validTime[i], 1);
+        eventUpper[q]  = getConcordancePrefix(sortedTime, validSize, validTime[i], 4);
+        predLess[q]    = getConcordancePrefix(sortedPred, validSize, validPred[i], 1);
+        predTieLow[q]  = getConcordancePrefix(sortedPred, validSize, validPred[i], 2);
+        predTieHigh[q] = getConcordancePrefix(sortedPred, validSize, validPred[i], 3);
+      }
+    }
+    for (pass = 1; pass <= 2; pass++) {
+      for (k = 1; k <= validSize; k++) {
+        allTree[k] = censTree[k] = eventTree[k] = 0.0;
+      }
+      censCount = eventCount = 0.0;
+      sweep = 0;
+      q = 0;
+      for (k = 1; k <= validSize; k++) {
+        i = timeIndx[k];
+        if (statusPtr[validIndx[i]] > 0) {
+          q++;
+          while (sweep < ((pass == 1) ? eventLower[q] : eventUpper[q])) {
+            sweep++;
+            updateFenwick(allTree, validSize, predRank[timeIndx[sweep]], 1.0);
+            if (statusPtr[validIndx[timeIndx[sweep]]] > 0) {
+              updateFenwick(eventTree, validSize, predRank[timeIndx[sweep]], 1.0);
+              eventCount = eventCount + 1.0;
+            }
+            else if (statusPtr[validIndx[timeIndx[sweep]]] == 0) {
+              updateFenwick(censTree, validSize, predRank[timeIndx[sweep]], 1.0);
+              censCount = censCount + 1.0;
+            }
+          }
+          censLess = sumFenwick(censTree, predLess[q]);
+          censTie  = sumFenwick(censTree, predTieHigh[q]) - sumFenwick(censTree, predTieLow[q]);
+          eventTie = sumFenwick(eventTree, predTieHigh[q]) - sumFenwick(eventTree, predTieLow[q]);
+          if (pass == 1) {
+            lowerCensCount[q]  = censCount;
+            lowerCensLess[q]   = censLess;
+            lowerCensTie[q]    = censTie;
+            lowerEventCount[q] = eventCount;
+            lowerEventTie[q]   = eventTie;
+          }
+          else {
+            allLess = sumFenwick(allTree, predLess[q]);
+            allTie  = sumFenwick(allTree, predTieHigh[q]) - sumFenwick(allTree, predTieLow[q]);
+            concordancePairSize   += 2.0 * (validSize - eventUpper[q]);
+            concordanceWorseCount += 2.0 * (predLess[q] - allLess) + ((predTieHigh[q] - predTieLow[q]) - allTie);
+            concordancePairSize   += 2.0 * (censCount - lowerCensCount[q]);
+            concordanceWorseCount += 2.0 * (censLess - lowerCensLess[q]) + (censTie - lowerCensTie[q]);
+            tiedPairSize   += 2.0 * (eventCount - lowerEventCount[q] - 1.0);
+            tiedWorseCount += 2.0 * (eventTie - lowerEventTie[q] - 1.0) + ((eventCount - lowerEventCount[q]) - (eventTie - lowerEventTie[q]));
+          }
+        }
+      }
+    }
+    concordancePairSize   += tiedPairSize / 2.0;
+    concordanceWorseCount += tiedWorseCount / 2.0;
+    free_uivector(eventLower, 1, eventSize);
+    free_uivector(eventUpper, 1, eventSize);
+    free_uivector(predLess, 1, eventSize);
+    free_uivector(predTieLow, 1, eventSize);
+    free_uivector(predTieHigh, 1, eventSize);
+    free_dvector(lowerCensCount, 1, eventSize);
+    free_dvector(lowerCensLess, 1, eventSize);
+    free_dvector(lowerCensTie, 1, eventSize);
+    free_dvector(lowerEventCount, 1, eventSize);
+    free_dvector(lowerEventTie, 1, eventSize);
+    free_dvector(allTree, 1, validSize);
+    free_dvector(censTree, 1, validSize);
+    free_dvector(eventTree, 1, validSize);
+  }
+  free_uivector(validIndx, 1, validSize);
+  free_dvector(validTime, 1, validSize);
+  free_dvector(validPred, 1, validSize);
+  free_dvector(sortedTime, 1, validSize);
+  free_dvector(sortedPred, 1, validSize);
+  free_uivector(timeIndx, 1, validSize);
+  free_uivector(predIndx, 1, validSize);
+  free_uivector(predRank, 1, validSize);
+  if (concordancePairSize == 0) {
+    result = NA_REAL;
   }
-  if (flag) {
-    (parent -> mtryIndx)[candidateCovariateCount] = covariate;
-    (parent -> mtryStat)[candidateCovariateCount] = delta;
+  else {
+    result = 1.0 - (concordanceWorseCount / concordancePairSize);
   }
+  return result;
 }
-void getMeanResponseNew(uint       treeID,
-                        Terminal  *parent,
-                        uint      *repMembrIndx,
-                        uint       repMembrSize,
-                        uint      *allMembrIndx,
-                        uint       allMembrSize) {
-  uint *membershipIndex;
-  uint  membershipSize;
-  uint i, j;
-  stackMeanResponse(parent, RF_rNonFactorCount);
-  if ((RF_opt & OPT_BOOT_NODE) | (RF_opt & OPT_BOOT_NONE)) {
-    membershipIndex = allMembrIndx;
-    membershipSize  = allMembrSize;
+double getConcordanceIndexPairwise(int     polarity,
+                                   uint    size,
+                                   double *timePtr,
+                                   double *statusPtr,
+                                   double *predictedOutcome,
+                                   uint   *denCount) {
+  uint i,j;
+  uint concordancePairSize;
+  uint concordanceWorseCount;
+  double result;
+  concordancePairSize = concordanceWorseCount = 0;
+  for (i=1; i < size; i++) {
+    for (j=i+1; j <= size; j++) {
+      if (denCount[i] != 0  && denCount[j] != 0) {
+        if ( ((timePtr[i] - timePtr[j] > EPSILON) && (statusPtr[j] > 0)) ||
+             ((fabs(timePtr[i] - timePtr[j]) <= EPSILON) && (statusPtr[j] > 0) && (statusPtr[i] == 0)) ) {
+          concordancePairSize += 2;
+          if (predictedOutcome[j] - predictedOutcome[i] > EPSILON) {
+            concordanceWorseCount += 2;
+          }
+          else if (fabs(predictedOutcome[j] - predictedOutcome[i]) < EPSILON) {
+            concordanceWorseCount += 1;
+          }
+        }
+        else if ( ((timePtr[j] - timePtr[i]) > EPSILON  && (statusPtr[i] > 0)) ||
+                  ((fabs(timePtr[j] - timePtr[i]) <= EPSILON)  && (statusPtr[i] > 0) && (statusPtr[j] == 0)) ) {
+          concordancePairSize += 2;
+          if ( predictedOutcome[i] - predictedOutcome[j] > EPSILON ) {
+            concordanceWorseCount += 2;
+          }
+          else if (fabs(predictedOutcome[i] - predictedOutcome[j]) < EPSILON) {
+            concordanceWorseCount += 1;
+          }
+        }
+        else if ( (fabs(timePtr[i]- timePtr[j]) <= EPSILON) && (statusPtr[i] > 0) && (statusPtr[j] > 0) ) {
+          concordancePairSize += 2;
+          if (fabs(predictedOutcome[i] - predictedOutcome[j]) < EPSILON) {
+            concordanceWorseCount += 2;
+          }
+          else {
+            concordanceWorseCount += 1;
+          }
+        }
+      }  
+    }  
+  }  
+  if (concordancePairSize == 0) {
+    result = NA_REAL;
   }
   else {
-    membershipIndex = repMembrIndx;
-    membershipSize  = repMembrSize;
+    result = 1.0 - ((double) concordanceWorseCount / (double) concordancePairSize);
   }
-  parent -> membrCount = membershipSize;
-  for (j=1; j <= RF_rNonFactorCount; j++) {
-    (parent -> meanResponse)[j] = 0.0;
+  return result;
+}
+void getCRPerformance (uint     mode,
+                       uint     obsSize,
+                       double **responsePtr,
+                       double **yearsLost,
+                       uint    *denom,
+                       double  *performanceVector) {
+  uint   mRecordSize;
+  int  **mpSign;
+  uint  *mRecordIndex;
+  uint  *meIndividualSize;
+  uint **eIndividual;
+  double concordanceIndex;
+  uint j;
+  if (!(RF_opt & OPT_COMP_RISK)) {
+    RFprintf("\nRF-SRC:  *** ERROR *** ");
+    RFprintf("\nRF-SRC:  Attempt at conditional performance updates in a non-CR analysis.");
+    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+    error("\nRF-SRC:  The application will now exit.\n");
   }
-  for (i=1; i <= membershipSize; i++) {
-    for (j=1; j <= RF_rNonFactorCount; j++) {
-      (parent -> meanResponse)[j] += RF_response[treeID][RF_rNonFactorIndex[j]][membershipIndex[i]];
+  if (RF_mStatusSize > 0) {
+    if (mode != RF_PRED) {
+      mRecordSize = RF_mRecordSize;
+      mpSign = RF_mpSign;
+      mRecordIndex = RF_mRecordIndex;
+    }
+    else {
+      mRecordSize = RF_fmRecordSize;
+      mpSign = RF_fmpSign;
+      mRecordIndex = RF_fmRecordIndex;
+    }
+    meIndividualSize  = uivector(1, RF_eventTypeSize);
+    eIndividual = (uint **) new_vvector(1, RF_eventTypeSize, NRUTIL_UPTR);
+    for (j = 1; j <= RF_eventTypeSize; j++) {
+      eIndividual[j] = uivector(1, RF_eIndividualSize[j] + RF_mStatusSize + 1);
     }
+    updateEventTypeSubsets(responsePtr[RF_statusIndex], mRecordSize, mpSign, mRecordIndex, meIndividualSize, eIndividual);
   }
-  if (parent -> membrCount > 0) {
-    for (j=1; j <= RF_rNonFactorCount; j++) {
-      (parent -> meanResponse)[j] = (parent -> meanResponse)[j] / (double) (parent -> membrCount);
+  else {
+    meIndividualSize  = RF_eIndividualSize;
+    eIndividual = RF_eIndividualIn;
+  }
+  double *subsettedTime      = dvector(1, obsSize);
+  double *subsettedStatus    = dvector(1, obsSize);
+  double *subsettedMortality = dvector(1, obsSize);
+  uint *subsettedEnsembleDen = uivector(1, obsSize);
+  for (j = 1; j <= RF_eventTypeSize; j++) {
+    getConditionalConcordanceArrays(j,
+                                    responsePtr[RF_timeIndex],
+                                    responsePtr[RF_statusIndex],
+                                    yearsLost[j],
+                                    denom,
+                                    meIndividualSize,
+                                    eIndividual,
+                                    subsettedTime,
+                                    subsettedStatus,
+                                    subsettedMortality,
+                                    subsettedEnsembleDen);
+    concordanceIndex = getConcordanceIndex(1,
+                                           meIndividualSize[j],
+                                           subsettedTime,
+                                           subsettedStatus,
+                                           subsettedMortality,
+                                           subsettedEnsembleDen);
+    if (ISNA(concordanceIndex)) {
+      performanceVector[j] = NA_REAL;
+    }
+    else {
+      performanceVector[j] = concordanceIndex;
     }
   }
-  else {
-    if (!(RF_opt & OPT_OUTC_TYPE)) {
-      RFprintf("\nRF-SRC:  *** ERROR *** ");
-      RFprintf("\nRF-SRC:  Zero node count encountered in getMeanResponse() in (tree, leaf) = (%10d, %10d)  \n", treeID, parent -> nodeID);
-      RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-      error("\nRF-SRC:  The application will now exit.\n");
+  if (RF_mStatusSize > 0) {
+    free_uivector(meIndividualSize, 1, RF_eventTypeSize);
+    for (j = 1; j <= RF_eventTypeSize; j++) {
+      free_uivector(eIndividual[j], 1, RF_eIndividualSize[j] + RF_mStatusSize + 1);
     }
+    free_new_vvector(eIndividual, 1, RF_eventTypeSize, NRUTIL_UPTR);
   }
+  free_dvector(subsettedTime, 1, obsSize);
+  free_dvector(subsettedStatus, 1, obsSize);
+  free_dvector(subsettedMortality, 1, obsSize);
+  free_uivector(subsettedEnsembleDen, 1, obsSize);
 }
-void restoreMeanResponseNew(uint       treeID,
-                            Terminal  *parent) {
-  uint leaf;
-  leaf = parent -> nodeID;
-  if ((parent -> membrCount) > 0) {
-      (parent -> meanResponse) = RF_TN_REGR_ptr[treeID][leaf];
-  }
-  else {
-    RFprintf("\nRF-SRC:  *** ERROR *** ");
-    RFprintf("\nRF-SRC:  Zero node count encountered in restoreMeanResponse() in (tree, leaf) = (%10d, %10d)  \n", treeID, parent -> nodeID);
-    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-    error("\nRF-SRC:  The application will now exit.\n");
-  }
-}
-void updateEnsembleMean(uint     mode,
-                        uint     treeID,
-                        uint     serialTreeID,
-                        char     omitDenominator) {
-  char oobFlag, fullFlag, selectionFlag, outcomeFlag;
-  Terminal ***termMembershipPtr;
-  uint    *membershipIndex;
-  uint     membershipSize;
-  double    **ensembleRGRptr;
-  double    **ensembleRGRnum;
-  uint       *ensembleDen;
-  Terminal *parent;
-  uint i, j;
-  uint ii;
-  ensembleRGRptr = NULL;  
-  ensembleRGRnum = NULL;  
-  ensembleDen    = NULL;  
-  oobFlag = fullFlag = FALSE;
-  switch (mode) {
+char imputeNode (uint     type,
+                 char     termFlag,
+                 char     chainFlag,
+                 uint     treeID,
+                 Node    *nodePtr,
+                 uint    *repMembrIndx,
+                 uint     repMembrSize,
+                 uint    *allMembrIndx,
+                 uint     allMembrSize) {
+  double  **response;
+  double  **predictor;
+  double    imputedValue;
+  uint     *mRecordMap;
+  uint      mpIndexSize;
+  int     **mpSign;
+  int      *mpIndex;
+  int      *mvNSptr;
+  uint      mRecordSize;
+  double *valuePtr, *imputePtr;
+  char mPredictorFlag;
+  int  signedSignatureIndex;
+  uint unsignedIndexSource;
+  uint unsignedIndexTarget;
+  char result;
+  uint   *glmpIndexPtr;
+  double *glmpValuePtr;
+  uint   *glmpIndexSize;
+  uint  *glmpIndexParentPtr;
+  uint   glmpIndexParentSize;
+  char mvFlag;
+  uint i,p;
+  uint localDistributionSize;
+  mvNSptr = NULL;  
+  mpIndex = NULL;  
+  mpSign  = NULL;  
+  mpIndexSize  = 0;  
+  mRecordMap = NULL;  
+  mRecordSize = 0;    
+  predictor  = NULL;  
+  response   = NULL;  
+  imputedValue = 0.0;  
+  glmpIndexPtr = NULL;
+  glmpValuePtr = NULL;
+  glmpIndexSize = NULL;
+  glmpIndexParentPtr = NULL;
+  glmpIndexParentSize = 0;
+  result = FALSE;
+  switch (type) {
   case RF_PRED:
-    if (RF_opt & OPT_FENS) {
-      fullFlag = TRUE;
+    mRecordSize = RF_fmRecordSize;
+    if (mRecordSize > 0) {
+      response = RF_fresponse[treeID];
+      predictor = RF_fobservation[treeID];
+      mRecordMap = RF_fmRecordMap;
+      mpIndexSize = RF_fmpIndexSize;
+      mpSign = RF_fmpSign;
+      mpIndex = RF_fmpIndex;
+      mvNSptr = nodePtr -> fmpSign;
+      if (!termFlag) {
+        if((nodePtr -> parent) == NULL) {
+          glmpIndexParentPtr = uivector(1, mpIndexSize);
+          glmpIndexParentSize = mpIndexSize;
+          for (p = 1; p <= glmpIndexParentSize; p++) {
+            glmpIndexParentPtr[p] = p;
+          }
+          stackNodeFLMPIndex(nodePtr, glmpIndexParentSize);
+          glmpIndexPtr  = nodePtr -> flmpIndex;
+          glmpIndexSize = & (nodePtr -> flmpIndexActualSize);
+          *glmpIndexSize = 0;
+        }
+        else {
+          if((nodePtr -> parent) -> flmpIndexActualSize > 0) {
+            glmpIndexParentPtr = (nodePtr -> parent) -> flmpIndex;
+            glmpIndexParentSize = (nodePtr -> parent) -> flmpIndexActualSize;
+            stackNodeFLMPIndex(nodePtr, glmpIndexParentSize);
+            glmpIndexPtr  = nodePtr -> flmpIndex;
+            glmpIndexSize = & (nodePtr -> flmpIndexActualSize);
+            *glmpIndexSize = 0;
+          }
+          else {
+            glmpIndexParentPtr  = NULL;
+            glmpIndexParentSize = 0;
+            glmpIndexPtr = glmpIndexSize = NULL;
+          }
+        }  
+      }  
+      else {
+        glmpIndexParentPtr = uivector(1, mpIndexSize);
+        glmpIndexParentSize = mpIndexSize;
+        for (p = 1; p <= glmpIndexParentSize; p++) {
+          glmpIndexParentPtr[p] = p;
+        }
+        stackNodeFLMPIndex(nodePtr, glmpIndexParentSize);
+        glmpIndexPtr  = nodePtr -> flmpIndex;
+        glmpValuePtr  = nodePtr -> flmpValue;
+        glmpIndexSize = & (nodePtr -> flmpIndexActualSize);
+        *glmpIndexSize = 0;
+      }
+      result = TRUE;
     }
-    termMembershipPtr = RF_ftTermMembership;
     break;
   default:
-    if (RF_opt & OPT_OENS) {
-      if (RF_oobSize[treeID] > 0) {
-        oobFlag = TRUE;
+    mRecordSize = RF_mRecordSize;
+    if (mRecordSize > 0) {
+      response = RF_response[treeID];
+      predictor = RF_observation[treeID];
+      mRecordMap = RF_mRecordMap;
+      mpIndexSize = RF_mpIndexSize;
+      mpSign = RF_mpSign;
+      mpIndex = RF_mpIndex;
+      mvNSptr = nodePtr -> mpSign;
+      if (!termFlag) {
+        if((nodePtr -> parent) == NULL) {
+          glmpIndexParentPtr = uivector(1, mpIndexSize);
+          glmpIndexParentSize = mpIndexSize;
+          for (p = 1; p <= glmpIndexParentSize; p++) {
+            glmpIndexParentPtr[p] = p;
+          }
+          stackNodeLMPIndex(nodePtr, glmpIndexParentSize);
+          glmpIndexPtr  = nodePtr -> lmpIndex;
+          glmpIndexSize = & (nodePtr -> lmpIndexActualSize);
+          *glmpIndexSize = 0;
+        }
+        else {
+          if((nodePtr -> parent) -> lmpIndexActualSize > 0) {
+            glmpIndexParentPtr = (nodePtr -> parent) -> lmpIndex;
+            glmpIndexParentSize = (nodePtr -> parent) -> lmpIndexActualSize;
+            stackNodeLMPIndex(nodePtr, glmpIndexParentSize);
+            glmpIndexPtr  = nodePtr -> lmpIndex;
+            glmpIndexSize = & (nodePtr -> lmpIndexActualSize);
+            *glmpIndexSize = 0;
+          }
+          else {
+            glmpIndexParentPtr = NULL;
+            glmpIndexParentSize = 0;
+            glmpIndexPtr = glmpIndexSize = NULL;
+          }
+        }  
+      }  
+      else {
+        glmpIndexParentPtr = uivector(1, mpIndexSize);
+        glmpIndexParentSize = mpIndexSize;
+        for (p = 1; p <= glmpIndexParentSize; p++) {
+          glmpIndexParentPtr[p] = p;
+        }
+        stackNodeLMPIndex(nodePtr, glmpIndexParentSize);
+        glmpIndexPtr  = nodePtr -> lmpIndex;
+        glmpValuePtr  = nodePtr -> lmpValue;
+        glmpIndexSize = & (nodePtr -> lmpIndexActualSize);
+        *glmpIndexSize = 0;
       }
+      result = TRUE;
     }
-    if (RF_opt & OPT_FENS) {
-      fullFlag = TRUE;
-    }
-    termMembershipPtr = RF_tTermMembership;
     break;
   }
-  outcomeFlag = TRUE;
-  while ((oobFlag == TRUE) || (fullFlag == TRUE)) {
-    if (oobFlag == TRUE) {
-      ensembleRGRptr = RF_oobEnsembleRGRptr;
-      ensembleRGRnum = RF_oobEnsembleRGRnum;
-      ensembleDen    = RF_oobEnsembleDen;
-      membershipSize  = RF_oobSize[treeID];
-      membershipIndex = RF_oobMembershipIndex[treeID];
-    }
-    else {
-      ensembleRGRptr = RF_fullEnsembleRGRptr;
-      ensembleRGRnum = RF_fullEnsembleRGRnum;
-      ensembleDen    = RF_fullEnsembleDen;
-      switch (mode) {
-      case RF_PRED:
-        membershipSize = RF_fobservationSize;
-        membershipIndex = RF_fidentityMembershipIndex;
-        break;
-      default:
-        membershipSize  = RF_observationSize;
-        membershipIndex = RF_identityMembershipIndex;
-        break;
+  if (result == FALSE) {
+    RFprintf("\nRF-SRC:  *** ERROR *** ");
+    RFprintf("\nRF-SRC:  Attempt to impute node with no missingness in type:  %10d", type);
+    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+    error("\nRF-SRC:  The application will now exit.\n");
+  }
+  nodePtr -> imputed = TRUE;
+  double *localDistribution = dvector(1, repMembrSize + 1);
+  for (p = 1; p <= glmpIndexParentSize; p++) {
+    if (mvNSptr[glmpIndexParentPtr[p]] != -1) {
+      signedSignatureIndex = mpIndex[glmpIndexParentPtr[p]];
+      if (signedSignatureIndex < 0) {
+        unsignedIndexSource = unsignedIndexTarget = (uint) abs(signedSignatureIndex);
+        valuePtr = RF_response[treeID][(uint) abs(signedSignatureIndex)];
+        imputePtr = response[(uint) abs(signedSignatureIndex)];
       }
-    }
-    for (i = 1; i <= membershipSize; i++) {
-      ii = membershipIndex[i];
-      parent = termMembershipPtr[treeID][ii];
-      selectionFlag = TRUE;
-      if (RF_opt & OPT_OUTC_TYPE) {
-        if ((parent -> meanResponse) != NULL) {
+      else {
+        unsignedIndexSource = RF_rSize + (uint) signedSignatureIndex;
+        if (type == RF_PRED) {
+          if (RF_frSize > 0) {
+            unsignedIndexTarget = RF_rSize + (uint) signedSignatureIndex;
+          }
+          else {
+            unsignedIndexTarget = (uint) signedSignatureIndex;
+          }
         }
         else {
-          selectionFlag = FALSE;
+          unsignedIndexTarget = RF_rSize + (uint) signedSignatureIndex;
         }
+        valuePtr = RF_observation[treeID][(uint) signedSignatureIndex];
+        imputePtr = predictor[(uint) signedSignatureIndex];
       }
-      if (selectionFlag) {
-        for (j=1; j <= RF_rTargetNonFactorCount; j++) {
-          ensembleRGRnum[j][ii] += (parent -> meanResponse)[RF_rNonFactorMap[RF_rTargetNonFactor[j]]];
+      localDistributionSize = 0;
+      for (i = 1; i <= repMembrSize; i++) {
+        mPredictorFlag = TRUE;
+        if (RF_mRecordMap[repMembrIndx[i]] == 0) {
+          mPredictorFlag = FALSE;
         }
-        if(!omitDenominator) {
-          ensembleDen[ii] ++;
+        else if (RF_mpSign[unsignedIndexSource][RF_mRecordMap[repMembrIndx[i]]] == 0) {
+          mPredictorFlag = FALSE;
         }
-      }
-      if (outcomeFlag) {
-        if (ensembleDen[ii] != 0) {
-          for (j=1; j <= RF_rTargetNonFactorCount; j++) {
-            ensembleRGRptr[j][ii] = ensembleRGRnum[j][ii] / ensembleDen[ii];
+        if (mPredictorFlag == FALSE) {
+          localDistributionSize ++;
+          localDistribution[localDistributionSize] = valuePtr[repMembrIndx[i]];
+        }
+      }  
+      if (termFlag) {
+        if (localDistributionSize == 0) {
+          for (i = 1; i <= repMembrSize; i++) {
+            mPredictorFlag = TRUE;
+            if (RF_mRecordMap[repMembrIndx[i]] == 0) {
+              mPredictorFlag = FALSE;
+            }
+            else if (RF_mpSign[unsignedIndexSource][RF_mRecordMap[repMembrIndx[i]]] == 0) {
+              mPredictorFlag = FALSE;
+            }
+            if (mPredictorFlag == TRUE) {
+              localDistributionSize ++;
+              localDistribution[localDistributionSize] = valuePtr[repMembrIndx[i]];
+            }
+          }  
+        }
+        if (localDistributionSize > 0) {
+          if (signedSignatureIndex < 0) {
+            if (strcmp(RF_rType[(uint) abs(signedSignatureIndex)], "T") == 0) {
+              imputedValue = getMeanValue(localDistribution, localDistributionSize);
+              imputedValue = getNearestMasterTime(imputedValue, chainFlag, treeID);
+            }
+            else if (strcmp(RF_rType[(uint) abs(signedSignatureIndex)], "S") == 0) {
+              imputedValue = getMaximalValue(localDistribution, localDistributionSize, chainFlag, treeID);
+            }
+            else if (strcmp(RF_rType[(uint) abs(signedSignatureIndex)], "R") == 0) {
+              imputedValue = getMeanValue(localDistribution, localDistributionSize);
+            }
+            else if (strcmp(RF_rType[(uint) abs(signedSignatureIndex)], "I") == 0) {
+              imputedValue = getMaximalValue(localDistribution, localDistributionSize, chainFlag, treeID);
+            }
+            else if (strcmp(RF_rType[(uint) abs(signedSignatureIndex)], "C") == 0) {
+              imputedValue = getMaximalValue(localDistribution, localDistributionSize, chainFlag, treeID);
+            }
+          }
+          else {
+            if (strcmp(RF_xType[(uint) signedSignatureIndex], "R") == 0) {
+              imputedValue = getMeanValue(localDistribution, localDistributionSize);
+            }
+            else {
+              imputedValue = getMaximalValue(localDistribution, localDistributionSize, chainFlag, treeID);
+            }
+          }
+        }  
+        else {
+          if (!(RF_opt & OPT_OUTC_TYPE)) {
+            RFprintf("\nRF-SRC:  *** ERROR *** ");
+            RFprintf("\nRF-SRC:  NULL distribution encountered during imputation in type:  %10d", type);
+            RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+            error("\nRF-SRC:  The application will now exit.\n");
+          }
+          else {
+            imputedValue = NA_REAL;
           }
         }
-      }
-    }  
-    if (outcomeFlag == TRUE) {
-      outcomeFlag = FALSE;
-    }
-    if (oobFlag == TRUE) {
-      oobFlag = FALSE;
-    }
-    else {
-        fullFlag = FALSE;
-    }
-  }  
-}
-double getMeanSquareError(uint    size,
-                          double *responsePtr,
-                          double *predictedOutcome,
-                          uint   *denomCount) {
-  uint i;
-  uint cumDenomCount;
-  double result;
-  cumDenomCount = 0;
-  result = 0.0;
-  for (i=1; i <= size; i++) {
-    if (denomCount[i] != 0) {
-      cumDenomCount += 1;
-      result += pow (responsePtr[i] - predictedOutcome[i], 2.0);
-    }
-  }  
-  if (cumDenomCount == 0) {
-    result = NA_REAL;
-  }
-  else {
-    result = result / (double) cumDenomCount;
-  }
-  return result;
-}
-char getVariance(uint    repMembrSize,
-                 uint   *repMembrIndx,
-                 uint    nonMissMembrSize,
-                 uint   *nonMissMembrIndx,
-                 double *targetResponse,
-                 double *mean,
-                 double *variance) {
-  uint i;
-  uint denom;
-  double meanResult, varResult;
-  char result;
-  uint *genIndx;
-  uint  genSize;
-  if (nonMissMembrIndx == NULL) {
-    genIndx = RF_identityMembershipIndex;
-    genSize = repMembrSize;
-  }
-  else {
-    genIndx = nonMissMembrIndx;
-    genSize = nonMissMembrSize;
-  }
-  denom      = 0;
-  meanResult = 0.0;
-  for (i = 1; i <= genSize; i++) {
-    if(!ISNA(targetResponse[repMembrIndx[genIndx[i]]])) {
-      denom ++;
-      meanResult += targetResponse[repMembrIndx[genIndx[i]]];
-    }
-  }
-  if (denom > 0) {
-    meanResult = meanResult / (double) denom;
-  }
-  else {
-    meanResult = NA_REAL;
-  }
-  if (mean != NULL) {
-    *mean = meanResult;
-  }
-  varResult = 0.0;
-  if(!ISNA(meanResult)) {
-    for (i = 1; i <= genSize; i++) {
-      if(!ISNA(targetResponse[repMembrIndx[genIndx[i]]])) {
-        varResult += pow(meanResult - targetResponse[repMembrIndx[genIndx[i]]], 2.0);
-      }
-    }
-    varResult = varResult / (double) denom;
-    result = ((varResult <= EPSILON) ? FALSE : TRUE);
-  }
-  else {
-    varResult = NA_REAL;
-    result = FALSE;
-  }
-  if (variance != NULL) {
-    *variance = varResult;
-  }
-  return(result);
-}
-void restoreMeanResponse(uint treeID) {
-  Terminal *parent;
-  uint leaf;
-  uint j;
-  for (leaf = 1; leaf <= RF_tLeafCount[treeID]; leaf++) {
-    parent = RF_tTermList[treeID][leaf];
-    if ((parent -> membrCount) > 0) {
-      for (j = 1; j <= RF_rNonFactorCount; j++) {
-        (parent -> meanResponse)[j] = RF_TN_REGR_ptr[treeID][leaf][j];
-      }
-    }
-    else {
-      RFprintf("\nRF-SRC:  *** ERROR *** ");
-      RFprintf("\nRF-SRC:  Zero node count encountered in restoreMeanResponse() in (tree, leaf) = (%10d, %10d)  \n", treeID, parent -> nodeID);
-      RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-      error("\nRF-SRC:  The application will now exit.\n");
-    }
-  }
-}
-void getMultiClassProbNew (uint       treeID,
-                           Terminal  *parent,
-                           uint      *repMembrIndx,
-                           uint       repMembrSize,
-                           uint      *allMembrIndx,
-                           uint       allMembrSize) {
-  uint *membershipIndex;
-  uint  membershipSize;
-  double maxValue, maxClass;
-  uint i, j, k;
-  stackMultiClassProb(parent, RF_rFactorCount, RF_rFactorSize);
-  if ((RF_opt & OPT_BOOT_NODE) | (RF_opt & OPT_BOOT_NONE)) {
-    membershipIndex = allMembrIndx;
-    membershipSize  = allMembrSize;
-  }
-  else {
-    membershipIndex = repMembrIndx;
-    membershipSize  = repMembrSize;
-  }
-  parent -> membrCount = membershipSize;
-  for (j=1; j <= RF_rFactorCount; j++) {
-    for (k=1; k <= RF_rFactorSize[j]; k++) {
-      (parent -> multiClassProb)[j][k] = 0;
-    }
-  }
-  for (i = 1; i <= membershipSize; i++) {
-    for (j=1; j <= RF_rFactorCount; j++) {
-      (parent -> multiClassProb)[j][(uint) RF_response[treeID][RF_rFactorIndex[j]][membershipIndex[i]]] ++;
-    }
-  }
-  if ((parent -> membrCount) > 0) {
-    for (j=1; j <= RF_rFactorCount; j++) {
-      maxValue = 0;
-      maxClass = 0;
-      for (k=1; k <= RF_rFactorSize[j]; k++) {
-        if (maxValue < (double) (parent -> multiClassProb[j][k])) {
-          maxValue = (double) parent -> multiClassProb[j][k];
-          maxClass = (double) k;
+      }  
+      mvFlag = FALSE;
+      for (i = 1; i <= allMembrSize; i++) {
+        if (mRecordMap[allMembrIndx[i]] > 0) {
+          if(mpSign[unsignedIndexTarget][mRecordMap[allMembrIndx[i]]] == 1) {
+            mvFlag = TRUE;
+            if (localDistributionSize > 0) {
+              if (termFlag) {
+                imputePtr[allMembrIndx[i]] = imputedValue;
+              }
+              else {
+                imputePtr[allMembrIndx[i]] = getSampleValue(localDistribution, localDistributionSize, chainFlag, treeID);
+              }
+            }
+            else {
+            }
+          }
+        }
+      }  
+      if (mvFlag) {
+        glmpIndexPtr[++(*glmpIndexSize)] = glmpIndexParentPtr[p];
+        if (termFlag) {
+          glmpValuePtr[(*glmpIndexSize)] = imputedValue;
         }
       }
-      (parent -> maxClass)[j] = maxClass;
+    }  
+  }  
+  free_dvector(localDistribution, 1, repMembrSize + 1);
+  if (!termFlag) {
+    if((nodePtr -> parent) == NULL) {
+      free_uivector(glmpIndexParentPtr, 1, mpIndexSize);
     }
   }
   else {
-    if (!(RF_opt & OPT_OUTC_TYPE)) {
-      RFprintf("\nRF-SRC:  *** ERROR *** ");
-      RFprintf("\nRF-SRC:  Zero node count encountered in getMultiClassProb() in (tree, leaf) = (%10d, %10d)  \n", treeID, parent -> nodeID);
-      RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-      error("\nRF-SRC:  The application will now exit.\n");
+    free_uivector(glmpIndexParentPtr, 1, mpIndexSize);
+  }
+  if((nodePtr -> parent) != NULL) {
+    if( ((((nodePtr -> parent) -> left) -> imputed) == TRUE) && ((((nodePtr -> parent) -> right) -> imputed) == TRUE) ) {
+      switch (type) {
+      case RF_PRED:
+        unstackNodeFLMPIndex(nodePtr -> parent);
+        break;
+      default:
+        unstackNodeLMPIndex(nodePtr -> parent);
+        break;
+      }
     }
   }
-}
-void restoreMultiClassProbNew (uint       treeID,
-                               Terminal  *parent) {
-  double maxValue, maxClass;
-  uint j, k;
-  if ((parent -> membrCount) > 0) {
-    (parent -> multiClassProb) = RF_TN_CLAS_ptr[treeID][parent -> nodeID];      
-    (parent -> maxClass) = dvector(1, RF_rFactorCount);
-    (parent -> rfCount) = RF_rFactorCount;
-    for (j = 1; j <= RF_rFactorCount; j++) {
-      maxValue = 0;
-      maxClass = 0;
-      for (k=1; k <= RF_rFactorSize[j]; k++) {
-        if (maxValue < (double) ((parent -> multiClassProb)[j][k])) {
-          maxValue = (double) (parent -> multiClassProb)[j][k];
-          maxClass = (double) k;
-        }
+  return TRUE;
+}  
+char restoreNodeMembership(uint  r,
+                           uint  mode,
+                           char  rootFlag,
+                           uint  treeID,
+                           Node *parent,
+                           uint *repMembrIndx,
+                           uint  repMembrSize,
+                           uint *allMembrIndx,
+                           uint  allMembrSize,
+                           uint *ngAllMembrIndx,
+                           uint  ngAllMembrSize,
+                           uint *bootMembrIndxIter) {
+  char  bootResult;
+  char leftResult, rghtResult;
+  char terminalFlag;
+  char bsUpdateFlag;
+  uint *bootMembrIndx;
+  uint *leftRepMembrIndx;
+  uint *rghtRepMembrIndx;
+  uint *leftAllMembrIndx;
+  uint *rghtAllMembrIndx;
+  uint *ngLeftAllMembrIndx;  
+  uint *ngRghtAllMembrIndx;  
+  uint bootMembrSize;
+  uint leftRepMembrSize, rghtRepMembrSize;
+  uint leftAllMembrSize, ngLeftAllMembrSize;
+  uint rghtAllMembrSize, ngRghtAllMembrSize;
+  uint jLeft;
+  uint jRght;
+  char factorFlag;
+  char daughterFlag;
+  uint i;
+  factorFlag = FALSE; 
+  bootResult = TRUE;
+  terminalFlag = TRUE;
+  bsUpdateFlag = FALSE;
+ if (rootFlag | (RF_opt & OPT_BOOT_NODE)) {
+    if (!(RF_opt & OPT_BOOT_NONE) && !(RF_opt & OPT_BOOT_NODE)) {
+      bootMembrIndx  = uivector(1, RF_bootstrapSize);
+      bootMembrSize = RF_bootstrapSize;
+    }
+    else {
+      bootMembrIndx  = uivector(1, allMembrSize);
+      bootMembrSize = allMembrSize;
+    }
+    bootResult = bootstrap (mode,
+                            treeID,
+                            parent,
+                            allMembrIndx,
+                            allMembrSize,
+                            bootMembrIndx,
+                            bootMembrSize);
+    if (rootFlag & bootResult) {
+      if (!(RF_opt & OPT_BOOT_NODE)) {
+        bsUpdateFlag = TRUE;
       }
-      (parent -> maxClass)[j] = maxClass;
+      repMembrIndx = bootMembrIndx;
+      repMembrSize = bootMembrSize;
     }
   }
   else {
-    RFprintf("\nRF-SRC:  *** ERROR *** ");
-    RFprintf("\nRF-SRC:  Zero node count encountered in restoreMultiClassProb() in (tree, leaf):  (%10d, %10d) \n", treeID, parent -> nodeID);
-    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-    error("\nRF-SRC:  The application will now exit.\n");
+    bootMembrIndx = repMembrIndx;
+    bootMembrSize = repMembrSize;
+    parent -> mpSign = (parent -> parent) -> mpSign;
+    parent -> fmpSign = (parent -> parent) -> fmpSign;
   }
-}
-void updateEnsembleMultiClass(uint      mode,
-                              uint      treeID,
-                              uint      serialTreeID,
-                              char     omitDenominator) {
-  char oobFlag, fullFlag, selectionFlag, outcomeFlag;
-  Terminal ***termMembershipPtr;
-  uint    *membershipIndex;
-  uint     membershipSize;
-  double   ***ensembleCLSptr;
-  double   ***ensembleCLSnum;
-  uint       *ensembleDen;
-  Terminal *parent;
-  double maxValue;
-  double maxClass;
-  uint i, j, k;
-  uint ii;
-  ensembleCLSptr = NULL;  
-  ensembleCLSnum = NULL;  
-  ensembleDen    = NULL;  
-  oobFlag = fullFlag = FALSE;
-  switch (mode) {
-  case RF_PRED:
-    if (RF_opt & OPT_FENS) {
-      fullFlag = TRUE;
-    }
-    termMembershipPtr = RF_ftTermMembership;
-    break;
-  default:
-    if (RF_opt & OPT_OENS) {
-      if (RF_oobSize[treeID] > 0) {
-        oobFlag = TRUE;
+  if (bootResult) {
+    if (RF_mRecordSize > 0) {
+      imputeNode(RF_GROW,
+                 FALSE,
+                 TRUE,
+                 treeID,
+                 parent,
+                 bootMembrIndx,
+                 bootMembrSize,
+                 allMembrIndx,
+                 allMembrSize);
+      if (RF_timeIndex > 0) {
+        if (RF_mTimeFlag == TRUE) {
+          updateTimeIndexArray(treeID,
+                               allMembrIndx,
+                               allMembrSize,
+                               RF_time[treeID],
+                               FALSE,
+                               FALSE,
+                               RF_masterTimeIndex[treeID]);
+        }
       }
     }
-    if (RF_opt & OPT_FENS) {
-      fullFlag = TRUE;
-    }
-    termMembershipPtr = RF_tTermMembership;
-    break;
-  }
-  outcomeFlag = TRUE;
-  while ((oobFlag == TRUE) || (fullFlag == TRUE)) {
-    if (oobFlag == TRUE) {
-      ensembleCLSptr = RF_oobEnsembleCLSptr;
-      ensembleCLSnum = RF_oobEnsembleCLSnum;
-      ensembleDen    = RF_oobEnsembleDen;
-      membershipSize  = RF_oobSize[treeID];
-      membershipIndex = RF_oobMembershipIndex[treeID];
+    switch (mode) {
+    case RF_PRED:
+      if (RF_fmRecordSize > 0) {
+        imputeNode(RF_PRED,
+                   FALSE,
+                   FALSE,
+                   treeID,
+                   parent,
+                   bootMembrIndx,
+                   bootMembrSize,
+                   ngAllMembrIndx,
+                   ngAllMembrSize);
+      }
+      break;
+    default:
+      break;
     }
-    else {
-      ensembleCLSptr = RF_fullEnsembleCLSptr;
-      ensembleCLSnum = RF_fullEnsembleCLSnum;
-      ensembleDen    = RF_fullEnsembleDen;
-      switch (mode) {
-      case RF_PRED:
-        membershipSize = RF_fobservationSize;
-        membershipIndex = RF_fidentityMembershipIndex;
-        break;
-      default:
-        membershipSize  = RF_observationSize;
-        membershipIndex = RF_identityMembershipIndex;
-        break;
+  }  
+  if (bootResult) {
+    if (RF_opt & OPT_NODE_STAT) {
+      if (RF_ptnCount == 0) {
+        if (((RF_timeIndex > 0) && (RF_statusIndex > 0)) || (RF_rSize == 0)) {
+          parent -> variance = NA_REAL;
+        }
+        else {
+          getVariance(repMembrSize, repMembrIndx, 0, NULL, RF_response[treeID][1], NULL, & (parent -> variance));
+        }
       }
     }
-    for (i = 1; i <= membershipSize; i++) {
-      ii = membershipIndex[i];
-      parent = termMembershipPtr[treeID][ii];
-      selectionFlag = TRUE;
-      if (RF_opt & OPT_OUTC_TYPE) {
-        if ((parent -> maxClass) != NULL) {
+    if (((parent -> left) != NULL) && ((parent -> right) != NULL)) {
+      terminalFlag = FALSE;
+      leftAllMembrIndx = rghtAllMembrIndx = NULL;
+      leftAllMembrSize = rghtAllMembrSize = 0;
+      leftRepMembrIndx = rghtRepMembrIndx = NULL;
+      leftRepMembrSize = rghtRepMembrSize = 0;
+      if (getRestoreNodeMembershipGrowFlag(mode)) {
+      }
+      else {
+        uint *membershipIndicator = uivector(1, RF_observationSize);
+        leftAllMembrSize = rghtAllMembrSize = 0;
+        factorFlag = FALSE;
+        if (RF_xFactorSplitFlag[parent -> splitParameter]) {
+          factorFlag = TRUE;
+        }
+        for (i = 1; i <= allMembrSize; i++) {
+          daughterFlag = RIGHT;
+          if (factorFlag == TRUE) {
+            daughterFlag = splitOnFactor((uint) RF_observation[treeID][parent -> splitParameter][allMembrIndx[i]], parent -> splitValueFactPtr);
+          }
+          else {
+            if ( RF_observation[treeID][parent -> splitParameter][allMembrIndx[i]] <= (parent -> splitValueCont) ) {
+              daughterFlag = LEFT;
+            }
+          }
+          membershipIndicator[allMembrIndx[i]] = daughterFlag;
+          if (daughterFlag == LEFT) {
+            leftAllMembrSize ++;
+            RF_tNodeMembership[treeID][allMembrIndx[i]] = parent -> left;
+          }
+          else {
+            rghtAllMembrSize ++;
+            RF_tNodeMembership[treeID][allMembrIndx[i]] = parent -> right;
+          }
+        }  
+        leftAllMembrIndx  = uivector(1, leftAllMembrSize + 1);
+        rghtAllMembrIndx  = uivector(1, rghtAllMembrSize + 1);
+        jLeft = jRght = 0;
+        for (i = 1; i <= allMembrSize; i++) {
+          if (membershipIndicator[allMembrIndx[i]] == LEFT) {
+            leftAllMembrIndx[++jLeft] = allMembrIndx[i];
+          }
+          else {
+            rghtAllMembrIndx[++jRght] = allMembrIndx[i];
+          }
         }
-        else {
-          selectionFlag = FALSE;
+        if (RF_opt & OPT_BOOT_NODE) {
+          leftRepMembrIndx = leftAllMembrIndx;
+          leftRepMembrSize = leftAllMembrSize;
+          rghtRepMembrIndx = rghtAllMembrIndx;
+          rghtRepMembrSize = rghtAllMembrSize;
         }
-      }
-      if (selectionFlag) {
-        for (j=1; j <= RF_rTargetFactorCount; j++) {
-          for (k=1; k <= RF_rFactorSize[RF_rFactorMap[RF_rTargetFactor[j]]]; k++) {
-            ensembleCLSnum[j][k][ii] += (double) (parent -> multiClassProb)[RF_rFactorMap[RF_rTargetFactor[j]]][k] / (double) (parent -> membrCount);
+        else {
+          leftRepMembrIndx  = uivector(1, bootMembrSize + 1);
+          rghtRepMembrIndx  = uivector(1, bootMembrSize + 1);
+          leftRepMembrSize = rghtRepMembrSize = 0;
+          for (i = 1; i <= bootMembrSize; i++) {
+            if (membershipIndicator[bootMembrIndx[i]] == LEFT) {
+              leftRepMembrIndx[++leftRepMembrSize] = bootMembrIndx[i];
+            }
+            else {
+              rghtRepMembrIndx[++rghtRepMembrSize] = bootMembrIndx[i];
+            }
           }
         }
-        if(!omitDenominator) {
-          ensembleDen[ii] ++;
-        }
-      }
-      if (outcomeFlag) {
-        if (ensembleDen[ii] != 0) {
-          for (j=1; j <= RF_rTargetFactorCount; j++) {
-            maxValue = 0;
-            maxClass = 0;
-            for (k=1; k <= RF_rFactorSize[RF_rFactorMap[RF_rTargetFactor[j]]]; k++) {
-              if (maxValue < ensembleCLSnum[j][k][ii]) {
-                maxValue = ensembleCLSnum[j][k][ii];
-                maxClass = (double) k;
-              }
+        free_uivector(membershipIndicator, 1, RF_observationSize);
+      }  
+      ngLeftAllMembrIndx = ngRghtAllMembrIndx = NULL;
+      ngLeftAllMembrSize = ngRghtAllMembrSize = 0;
+      if ((mode == RF_PRED) && (RF_flatForest == NULL)) {
+        uint *ngMembershipIndicator = uivector(1, RF_fobservationSize);
+        for (i=1; i <= ngAllMembrSize; i++) {
+          daughterFlag = RIGHT;
+          if (factorFlag == TRUE) {
+            daughterFlag = splitOnFactor((uint) RF_fobservation[treeID][parent -> splitParameter][ngAllMembrIndx[i]], parent -> splitValueFactPtr);
+          }
+          else {
+            if ( RF_fobservation[treeID][parent -> splitParameter][ngAllMembrIndx[i]] <= (parent -> splitValueCont) ) {
+              daughterFlag = LEFT;
             }
-            ensembleCLSptr[j][1][ii] = maxClass;
+          }
+          if (daughterFlag == LEFT) {
+            ngMembershipIndicator[ngAllMembrIndx[i]] = LEFT;
+            ngLeftAllMembrSize ++;
+            RF_ftNodeMembership[treeID][ngAllMembrIndx[i]] = parent -> left;
+          }
+          else {
+            ngMembershipIndicator[ngAllMembrIndx[i]] = RIGHT;
+            ngRghtAllMembrSize ++;
+            RF_ftNodeMembership[treeID][ngAllMembrIndx[i]] = parent -> right;
+          }
+        }  
+        ngLeftAllMembrIndx  = uivector(1, ngLeftAllMembrSize + 1);
+        ngRghtAllMembrIndx  = uivector(1, ngRghtAllMembrSize + 1);
+        jLeft = jRght = 0;
+        for (i = 1; i <= ngAllMembrSize; i++) {
+          if (ngMembershipIndicator[ngAllMembrIndx[i]] == LEFT) {
+            ngLeftAllMembrIndx[++jLeft] = ngAllMembrIndx[i];
+          }
+          else {
+            ngRghtAllMembrIndx[++jRght] = ngAllMembrIndx[i];
           }
         }
+        free_uivector(ngMembershipIndicator, 1, RF_fobservationSize);
+      }  
+      leftResult = restoreNodeMembership(r,
+                                         mode,
+                                         FALSE,
+                                         treeID,
+                                         parent -> left,
+                                         leftRepMembrIndx,
+                                         leftRepMembrSize,
+                                         leftAllMembrIndx,
+                                         leftAllMembrSize,
+                                         ngLeftAllMembrIndx,
+                                         ngLeftAllMembrSize,
+                                         bootMembrIndxIter);
+      if(!leftResult) {
       }
-    }  
-    if (outcomeFlag == TRUE) {
-      outcomeFlag = FALSE;
-    }
-    if (oobFlag == TRUE) {
-      oobFlag = FALSE;
-    }
-    else {
-      fullFlag = FALSE;
-    }
-  }  
-}
-double getBrierScore(uint     obsSize,
-                     uint     rTarget,
-                     double  *responsePtr,
-                     double **outcomeCLS,
-                     uint    *denomCount,
-                     double  *cpv) {
-  uint k;
-  uint against;
-  uint *oaaResponse;
-  uint cumDenomCount;
-  double result;
-  oaaResponse = uivector(1, obsSize);
-  result = 0.0;
-  cumDenomCount = 0;
-  for (k = 1; k <= obsSize; k ++) {
-    if (denomCount[k] != 0) {
-      cumDenomCount += 1;
-    }
-  }
-  for (against = 1; against < RF_rFactorSize[RF_rFactorMap[rTarget]]; against++) {
-    for (k = 1; k <= obsSize; k ++) {
-      if ((uint) responsePtr[k] == against) {
-        oaaResponse[k] = 1;
+      rghtResult = restoreNodeMembership(r,
+                                         mode,
+                                         FALSE,
+                                         treeID,
+                                         parent -> right,
+                                         rghtRepMembrIndx,
+                                         rghtRepMembrSize,
+                                         rghtAllMembrIndx,
+                                         rghtAllMembrSize,
+                                         ngRghtAllMembrIndx,
+                                         ngRghtAllMembrSize,
+                                         bootMembrIndxIter);
+      if(!rghtResult) {
+      }
+      if (getRestoreNodeMembershipGrowFlag(mode)) {
       }
       else {
-        oaaResponse[k] = 0;
+        free_uivector(leftAllMembrIndx, 1, leftAllMembrSize + 1);
+        free_uivector(rghtAllMembrIndx, 1, rghtAllMembrSize + 1);
+        if (RF_opt & OPT_BOOT_NODE) {
+        }
+        else {
+          free_uivector(leftRepMembrIndx, 1, bootMembrSize + 1);
+          free_uivector(rghtRepMembrIndx, 1, bootMembrSize + 1);
+        }
       }
-    }
-    cpv[against] = 0.0;
-    for (k = 1; k <= obsSize; k ++) {
-      if (denomCount[k] != 0) {
-        cpv[against] += pow(((double) oaaResponse[k] - (outcomeCLS[against][k] / (double) denomCount[k])), 2.0);
+      if ((mode == RF_PRED) && (RF_flatForest == NULL)) {
+        free_uivector(ngLeftAllMembrIndx, 1, ngLeftAllMembrSize + 1);
+        free_uivector(ngRghtAllMembrIndx, 1, ngRghtAllMembrSize + 1);
       }
-    }
-    if (cumDenomCount == 0) {
-      cpv[against] = NA_REAL;
-    }
+    }  
     else {
-      cpv[against] = cpv[against] / (double) cumDenomCount;
-      result += cpv[against];
     }
-  }
-  if (cumDenomCount == 0) {
-    result = NA_REAL;
-  }
+  }  
   else {
-    result = result / RF_rFactorSize[RF_rFactorMap[rTarget]];
-  }
-  free_uivector(oaaResponse, 1, obsSize);
-  return result;
-}
-void getConditionalClassificationIndex(uint     size,
-                                       uint     rTarget,
-                                       double  *responsePtr,
-                                       double  *outcomeCLS,
-                                       uint    *denomCount,
-                                       double  *cpv) {
-  uint i, k;
-  uint cumDenomCount;
-  uint *condClassificationCount;
-  cumDenomCount = 0;
-  condClassificationCount = uivector(1, RF_rFactorSize[RF_rFactorMap[rTarget]]);
-  for (k=1; k <= RF_rFactorSize[RF_rFactorMap[rTarget]]; k++) {
-    condClassificationCount[k] = 0;
-    cpv[k] = 0;
-  }
-  for (i = 1; i <= size; i++) {
-    condClassificationCount[(uint) responsePtr[i]] ++;
-    if (denomCount[i] != 0) {
-      cumDenomCount += 1;
-      if (responsePtr[i] == outcomeCLS[i]) {
-        cpv[(uint) responsePtr[i]] += 1.0;
+    if (rootFlag) {
+      if (!bootResult) {
+        terminalFlag = FALSE;
       }
     }
-  }  
-  if (cumDenomCount == 0) {
-    for (k=1; k <= RF_rFactorSize[RF_rFactorMap[rTarget]]; k++) {
-      cpv[k] = NA_REAL;
-    }
-  }
-  else {
-    for (k=1; k <= RF_rFactorSize[RF_rFactorMap[rTarget]]; k++) {
-      if (condClassificationCount[k] != 0) {
-        cpv[k] = 1.0 - cpv[k] / (double) condClassificationCount[k];
+  }   
+  if (terminalFlag) {
+    parent -> pseudoTerminal = TRUE;
+    imputeNodeAndSummarize(r,
+                           mode,
+                           treeID,
+                           parent,
+                           bootMembrIndx,
+                           bootMembrSize,
+                           allMembrIndx,
+                           allMembrSize,
+                           ngAllMembrIndx,
+                           ngAllMembrSize);
+    if (r == RF_nImpute) {
+      if (getRestoreNodeMembershipGrowFlag(mode)) {
       }
       else {
-        cpv[k] = NA_REAL;
-      }
-    }
-  }
-  free_uivector(condClassificationCount, 1, RF_rFactorSize[RF_rFactorMap[rTarget]]);
-  return;
-}
-double getClassificationIndex(uint    size,
-                              double *responsePtr,
-                              double *predictedOutcome,
-                              uint   *denomCount) {
-  uint i;
-  uint cumDenomCount;
-  double result;
-  cumDenomCount = 0;
-  result = 0.0;
-  for (i=1; i <= size; i++) {
-    if (denomCount[i] > 0) {
-      cumDenomCount += 1;
-      if (responsePtr[i] == predictedOutcome[i]) {
-        result += 1.0;
+        if ((RF_opt & OPT_PERF) |
+            (RF_opt & OPT_PERF_CALB) |
+            (RF_opt & OPT_OENS) |
+            (RF_opt & OPT_FENS)) {
+          updateTerminalNodeOutcomesNew(treeID,
+                                        RF_tTermList[treeID][parent -> nodeID],
+                                        bootMembrIndx,
+                                        bootMembrSize,
+                                        allMembrIndx,
+                                        allMembrSize);
+        }
       }
     }
+    if (RF_opt & OPT_BOOT_NODE) {
+      bsUpdateFlag = TRUE;
+    }
   }  
-  if (cumDenomCount == 0) {
-    result = NA_REAL;
-  }
-  else {
-    result = 1.0 - result / (double) cumDenomCount;
+  if (bsUpdateFlag) {
+    for (i = 1; i <= bootMembrSize; i++) {
+      RF_bootMembershipIndex[treeID][++(*bootMembrIndxIter)] = bootMembrIndx[i];
+      RF_bootMembershipFlag[treeID][bootMembrIndx[i]] = TRUE;
+      RF_oobMembershipFlag[treeID][bootMembrIndx[i]]  = FALSE;
+      RF_bootMembershipCount[treeID][bootMembrIndx[i]] ++;
+    }
   }
-  return result;
-}
-void restoreMultiClassProb(uint treeID) {
-  Terminal *parent;
-  double maxValue, maxClass;
-  uint leaf;
-  uint j, k;
-  for (leaf = 1; leaf <= RF_tLeafCount[treeID]; leaf++) {
-    parent = RF_tTermList[treeID][leaf];
-    if ((parent -> membrCount) > 0) {
-      for (j = 1; j <= RF_rFactorCount; j++) {
-        for (k = 1; k <= RF_rFactorSize[j]; k++) {
-          (parent -> multiClassProb)[j][k] = RF_TN_CLAS_ptr[treeID][leaf][j][k];
-        }
-        maxValue = 0;
-        maxClass = 0;
-        for (k=1; k <= RF_rFactorSize[j]; k++) {
-          if (maxValue < (double) (parent -> multiClassProb[j][k])) {
-            maxValue = (double) parent -> multiClassProb[j][k];
-            maxClass = (double) k;
-          }
-        }
-        (parent -> maxClass)[j] = maxClass;
-      }
+  if (rootFlag | (RF_opt & OPT_BOOT_NODE)) {
+    if (!(RF_opt & OPT_BOOT_NONE) && !(RF_opt & OPT_BOOT_NODE)) {
+      free_uivector(bootMembrIndx, 1, RF_bootstrapSize);
     }
     else {
-      RFprintf("\nRF-SRC:  *** ERROR *** ");
-      RFprintf("\nRF-SRC:  Zero node count encountered in restoreMultiClassProb() in (tree, leaf) = (%10d, %10d)  \n", treeID, parent -> nodeID);
-      RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-      error("\nRF-SRC:  The application will now exit.\n");
+      free_uivector(bootMembrIndx, 1, allMembrSize);
     }
   }
-}
-void getAtRiskAndEventCountsNew(uint       treeID,
-                                Terminal  *parent,
-                                uint      *repMembrIndx,
-                                uint       repMembrSize,
-                                uint      *allMembrIndx,
-                                uint       allMembrSize) {
-  uint *membershipIndex;
-  uint  membershipSize;
-  uint i, j, k;
-  uint ii;
-  char eventFlag;
-  if ((RF_opt & OPT_BOOT_NODE) | (RF_opt & OPT_BOOT_NONE)) {
-    membershipIndex = allMembrIndx;
-    membershipSize  = allMembrSize;
-  }
-  else {
-    membershipIndex = repMembrIndx;
-    membershipSize  = repMembrSize;
-  }
-  parent -> membrCount = membershipSize;
-  stackAtRiskAndEventCounts(parent, RF_eventTypeSize, RF_masterTimeSize);
-  for (j = 1; j <= RF_masterTimeSize; j++) {
-    (parent -> atRiskCount)[j]    = 0;
-    for (k = 1; k <= RF_eventTypeSize; k++) {
-      (parent -> eventCount)[k][j] = 0;
+  return bootResult;
+}  
+void imputeNodeAndSummarize(uint     r,
+                            uint     mode,
+                            uint     treeID,
+                            Node    *parent,
+                            uint    *repMembrIndx,
+                            uint     repMembrSize,
+                            uint    *allMembrIndx,
+                            uint     allMembrSize,
+                            uint    *ngAllMembrIndx,
+                            uint     ngAllMembrSize) {
+  uint multImpFlag;
+  if (r == 1) {
+    if (RF_mRecordSize > 0) {
+      unstackNodeLMPIndex(RF_tNodeList[treeID][parent -> nodeID]);
+      imputeNode(RF_GROW, 
+                 TRUE,    
+                 TRUE,    
+                 treeID,
+                 parent,
+                 repMembrIndx,
+                 repMembrSize,
+                 allMembrIndx,
+                 allMembrSize);
+      if (mode != RF_PRED) {
+        xferMissingness(RF_GROW, RF_tNodeList[treeID][parent -> nodeID], RF_tTermList[treeID][parent -> nodeID]);
+      }
     }
-  }
-  for (i=1; i <= membershipSize; i++) {
-    ii = membershipIndex[i];
-    for (j = 1; j <= RF_masterTimeIndex[treeID][ii]; j++) {
-      (parent -> atRiskCount)[j] ++;
+    if (mode == RF_PRED) {
+      if (RF_fmRecordSize > 0) {
+        unstackNodeFLMPIndex(RF_tNodeList[treeID][parent -> nodeID]);
+        imputeNode(RF_PRED, 
+                   TRUE,    
+                   FALSE,   
+                   treeID,
+                   parent,
+                   repMembrIndx,
+                   repMembrSize,
+                   ngAllMembrIndx,
+                   ngAllMembrSize);
+        xferMissingness(RF_PRED, RF_tNodeList[treeID][parent -> nodeID], RF_tTermList[treeID][parent -> nodeID]);
+      }
     }
-    if (RF_status[treeID][ii] > 0) {
-      if (RF_eventTypeSize > 1) {
-        k = RF_eventTypeIndex[(uint) RF_status[treeID][ii]];
+  }
+  else {
+    if (mode == RF_GROW) {
+      multImpFlag = FALSE;
+      if (r < RF_nImpute) {
+        multImpFlag = TRUE;
       }
       else {
-        k = 1;
+        if (RF_opt & OPT_IMPU_ONLY) {
+          multImpFlag = TRUE;
+        }
+      }
+      if (multImpFlag) {
+        if (RF_mRecordSize > 0) {
+          imputeNode(RF_GROW, 
+                     TRUE,    
+                     FALSE,   
+                     treeID,
+                     parent,
+                     repMembrIndx,
+                     repMembrSize,
+                     allMembrIndx,
+                     allMembrSize);
+          xferMissingness(RF_GROW, RF_tNodeList[treeID][parent -> nodeID], RF_tTermList[treeID][parent -> nodeID]);
+        }
       }
-      (parent -> eventCount)[k][RF_masterTimeIndex[treeID][ii]] ++;
     }
   }
-  parent -> eTimeSize = 0;
-  for (j = 1; j <= RF_masterTimeSize; j++) {
-    eventFlag = FALSE;
-    for (k = 1; k <= RF_eventTypeSize; k++) {
-      if ((parent -> eventCount)[k][j] > 0) {
-        eventFlag = TRUE;
-        k = RF_eventTypeSize;
-      }
+}
+void imputeUpdateShadow (uint      mode,
+                         double  **shadowResponse,
+                         double  **shadowPredictor) {
+  uint     mRecordSize;
+  uint    *mRecordIndex;
+  uint     mpIndexSize;
+  int    **mpSign;
+  int     *mpIndex;
+  double **outResponse;
+  double **outPredictor;
+  double  *valuePtr;
+  double  *outputPtr;
+  uint unsignedIndex;
+  char outcomeFlag, predictorFlag;
+  uint rspSize;
+  uint i, p;
+  mRecordSize  = 0;     
+  mRecordIndex = NULL;  
+  mpIndexSize  = 0;     
+  mpSign       = NULL;  
+  mpIndex      = NULL;  
+  outResponse  = NULL;  
+  outPredictor = NULL;  
+  valuePtr     = NULL;  
+  outputPtr    = NULL;  
+  unsignedIndex = 0;    
+  switch (mode) {
+  case RF_PRED:
+    mRecordSize = RF_fmRecordSize;
+    mRecordIndex = RF_fmRecordIndex;
+    mpIndexSize = RF_fmpIndexSize;
+    mpSign = RF_fmpSign;
+    mpIndex = RF_fmpIndex;
+    if (shadowResponse != NULL) {
+      outResponse  = RF_sImputeResponsePtr;
     }
-    if (eventFlag == TRUE) {
-      (parent -> eTimeSize)++;
+    if (shadowPredictor != NULL) {
+      outPredictor = RF_sImputePredictorPtr;
     }
-  }
-  stackEventTimeIndex(parent, parent -> eTimeSize);
-  for (j = 1; j <= parent -> eTimeSize; j++) {
-    (parent -> eventTimeIndex)[j] = 0;
-  }
-  i = 0;
-  for (j = 1; j <= RF_masterTimeSize; j++) {
-    eventFlag = FALSE;
-    for (k = 1; k <= RF_eventTypeSize; k++) {
-      if ((parent -> eventCount)[k][j] > 0) {
-        eventFlag = TRUE;
-        k = RF_eventTypeSize;
-      }
+    rspSize = RF_frSize;
+    break;
+  default:
+    mRecordSize = RF_mRecordSize;
+    mRecordIndex = RF_mRecordIndex;
+    mpIndexSize = RF_mpIndexSize;
+    mpSign = RF_mpSign;
+    mpIndex = RF_mpIndex;
+    if (shadowResponse != NULL) {
+      outResponse  = RF_sImputeResponsePtr;
     }
-    if (eventFlag == TRUE) {
-      (parent -> eventTimeIndex)[++i] = j;
+    if (shadowPredictor != NULL) {
+      outPredictor = RF_sImputePredictorPtr;
     }
+    rspSize = RF_rSize;
+    break;
   }
-  if (parent -> membrCount > 0) {
-  }
-  else {
-    if (!(RF_opt & OPT_OUTC_TYPE)) {
-      RFprintf("\nRF-SRC:  *** ERROR *** ");
-      RFprintf("\nRF-SRC:  Zero node count encountered in getAtRiskAndEventCounts() in (tree, leaf) = (%10d, %10d)  \n", treeID, parent -> nodeID);
-      error("\nRF-SRC:  The application will now exit.\n");
-    }
+  if (mRecordSize == 0) {
+    RFprintf("\nRF-SRC:  *** ERROR *** ");
+    RFprintf("\nRF-SRC:  Attempt to update shadow data with no missingness in mode:  %10d", mode);
+    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+    error("\nRF-SRC:  The application will now exit.\n");
   }
-}
-void getLocalRatios(uint treeID, Terminal *parent) {
-  uint j, q;
-  if (parent -> membrCount > 0) {
-    if(parent -> eTimeSize > 0) {
-      stackLocalRatio(parent, RF_eventTypeSize, parent -> eTimeSize);
-      for (j=1; j <= RF_eventTypeSize; j++) {
-        for (q = 1; q <= parent -> eTimeSize; q++) {
-          (parent -> localRatio)[j][q] = 0.0;
-        }
+  for (p = 1; p <= mpIndexSize; p++) {
+    if (mpIndex[p] < 0) {
+      if (shadowResponse != NULL) {
+        unsignedIndex = (uint) abs(mpIndex[p]);
+        valuePtr = shadowResponse[(uint) abs(mpIndex[p])];
+        outputPtr = outResponse[(uint) abs(mpIndex[p])];
+        outcomeFlag = TRUE;
       }
-      for (j=1; j <= RF_eventTypeSize; j++) {
-        for (q = 1; q <= parent -> eTimeSize; q++) {
-          if ((parent -> eventCount)[j][(parent -> eventTimeIndex)[q]] > 0) {
-            if ((parent -> atRiskCount)[(parent -> eventTimeIndex)[q]] >= 1) {
-              (parent -> localRatio)[j][q] = ((double) (parent -> eventCount)[j][(parent -> eventTimeIndex)[q]] / (parent -> atRiskCount)[(parent -> eventTimeIndex)[q]]);
-            }
-            else {
-              RFprintf("\nRF-SRC:  *** ERROR *** ");
-              RFprintf("\nRF-SRC:  Zero At Risk Count encountered in local ratio calculation for (tree, leaf) = (%10d, %10d)", treeID, parent -> nodeID);
-              RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-              error("\nRF-SRC:  The application will now exit.\n");
-            }
-          }
-        }
+      else {
+        outcomeFlag = FALSE;
       }
+      predictorFlag = FALSE;
     }
-  }
-}
-void getLocalSurvival(uint treeID, Terminal *parent) {
-  uint j, q;
-  if(parent -> eTimeSize > 0) {
-    stackLocalSurvival(parent, parent -> eTimeSize);
-    for (q = 1; q <= parent -> eTimeSize; q++) {
-      (parent -> localSurvival)[q] = 0.0;
+    else {
+      if (shadowPredictor != NULL) {
+        unsignedIndex = (uint) mpIndex[p] + rspSize;
+        valuePtr = shadowPredictor[(uint) mpIndex[p]];
+        outputPtr = outPredictor[(uint) mpIndex[p]];
+        predictorFlag = TRUE;
+      }
+      else {
+        predictorFlag = FALSE;
+      }
+      outcomeFlag = FALSE;
     }
-    for (q = 1; q <= parent -> eTimeSize; q++) {
-      for (j = 1; j <= RF_eventTypeSize; j++) {
-        (parent -> localSurvival)[q] += (parent -> localRatio)[j][q];
+    if ( (outcomeFlag && (shadowResponse != NULL))  || (predictorFlag && (shadowPredictor != NULL)) ) {
+      for (i = 1; i <= mRecordSize; i++) {
+        if (mpSign[unsignedIndex][i] == 1) {
+          if (ISNA(outputPtr[i])) {
+          }
+          valuePtr[mRecordIndex[i]] = outputPtr[i];
+        }
       }
-      (parent -> localSurvival)[q] = 1.0 - (parent -> localSurvival)[q];
     }  
-    for (q = 2; q <= parent -> eTimeSize; q++) {
-      (parent -> localSurvival)[q] *= (parent -> localSurvival)[q-1];
-    }
+  }  
+}
+void imputeSummary(uint      mode,
+                   char      selectionFlag) {
+  imputeCommon(mode,
+               0,
+               selectionFlag,
+               TRUE);
+}
+void imputeResponse(uint      mode,
+                    uint      serialTreeID,
+                    double  **tempResponse) {
+  switch(mode) {
+  case RF_PRED:
+    imputeCommon(mode, serialTreeID, ACTIVE, FALSE);
+    imputeUpdateShadow(mode, tempResponse, NULL);
+    break;
+  default:
+    imputeCommon(mode, serialTreeID, FALSE, FALSE);
+    imputeUpdateShadow(mode, tempResponse, NULL);
+    break;
   }
 }
-void getLocalNelsonAalen(uint treeID, Terminal *parent) {
-  uint q;
-  if (parent -> eTimeSize > 0) {
-    stackLocalNelsonAalen(parent, parent -> eTimeSize);
-    for (q = 1; q <= parent -> eTimeSize; q++) {
-      (parent -> localNelsonAalen)[q] = 0.0;
+void imputeCommon(uint      mode,
+                  uint      serialTreeID,
+                  char      selectionFlag,
+                  char      predictorFlag) {
+  uint *localSerialIndex;
+  uint  localSerialCount;
+  uint *serialPtr;
+  char mFlag;
+  char outcomeFlag;
+  uint     mRecordSize;
+  uint    *mRecordIndex;
+  uint     mpIndexSize;
+  int    **mpSign;
+  int     *mpIndex;
+  double **outResponse;
+  double **outPredictor;
+  double *valuePtr;
+  double *naivePtr;
+  uint    unsignedSignatureIndex;
+  Terminal ***termMembershipPtr;
+  Terminal *info;
+  double imputedValue;
+  uint localDistributionSize;
+  uint maxDistributionSize;
+  uint rspSize;
+  char result;
+  uint i, p, v, tree;
+  valuePtr      = NULL;  
+  naivePtr      = NULL;  
+  unsignedSignatureIndex = 0;     
+  maxDistributionSize = 0;  
+  outResponse         = 0;  
+  outPredictor        = 0;  
+  rspSize = 0;  
+  mpIndex = 0;  
+  mpSign  = 0;  
+  mpIndexSize  = 0;  
+  mRecordIndex = 0;  
+  mRecordSize  = 0;  
+  localSerialIndex = NULL;  
+  if ((selectionFlag != TRUE) && (selectionFlag != FALSE) && (selectionFlag != ACTIVE)) {
+    RFprintf("\nRF-SRC:  *** ERROR *** ");
+    RFprintf("\nRF-SRC:  Invalid selectionFlag in imputeCommon():  %10d", selectionFlag);
+    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+    error("\nRF-SRC:  The application will now exit.\n");
+  }
+  result = FALSE;
+  switch (mode) {
+  case RF_PRED:
+    if (RF_fmRecordSize > 0) {
+      mRecordSize = RF_fmRecordSize;
+      mRecordIndex = RF_fmRecordIndex;
+      mpIndexSize = RF_fmpIndexSize;
+      mpSign = RF_fmpSign;
+      mpIndex = RF_fmpIndex;
+      maxDistributionSize = ((RF_observationSize) > (RF_forestSize)) ? (RF_observationSize) : (RF_forestSize);
+      outResponse  = RF_sImputeResponsePtr;
+      outPredictor = RF_sImputePredictorPtr;
+      rspSize = RF_frSize;
+      termMembershipPtr = RF_ftTermMembership;
+      result = TRUE;
     }
-    for (q = 1; q <= parent -> eTimeSize; q++) {
-      (parent -> localNelsonAalen)[q] = (parent -> localRatio)[1][q];
+    break;
+  default:
+    if (RF_mRecordSize > 0) {
+      mRecordSize = RF_mRecordSize;
+      mRecordIndex = RF_mRecordIndex;
+      mpIndexSize = RF_mpIndexSize;
+      mpSign = RF_mpSign;
+      mpIndex = RF_mpIndex;
+      maxDistributionSize = ((RF_observationSize) > (RF_forestSize)) ? (RF_observationSize) : (RF_forestSize);
+      outResponse  = RF_sImputeResponsePtr;
+      outPredictor = RF_sImputePredictorPtr;
+      rspSize = RF_rSize;
+      termMembershipPtr = RF_tTermMembership;
+      result = TRUE;
     }
-    for (q = 2; q <= parent -> eTimeSize; q++) {
-      (parent -> localNelsonAalen)[q] += (parent -> localNelsonAalen)[q-1];
+    break;
+  }
+  if (result == FALSE) {
+    RFprintf("\nRF-SRC:  *** ERROR *** ");
+    RFprintf("\nRF-SRC:  Attempt to impute in imputeCommon() with no missingness in mode:  %10d", mode);
+    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+    error("\nRF-SRC:  The application will now exit.\n");
+  }
+  if (serialTreeID == 0) {
+    localSerialIndex = uivector(1, RF_forestSize);
+    for (tree = 1; tree <= RF_forestSize; tree++) {
+      localSerialIndex[tree] = tree;
     }
+    serialPtr = localSerialIndex;
+    localSerialCount = RF_forestSize;
   }
-}
-void getLocalCSH(uint treeID, Terminal *parent) {
-  uint j, q;
-    if (parent -> eTimeSize > 0) {
-      stackLocalCSH(parent, RF_eventTypeSize, parent -> eTimeSize);
-      for (j=1; j <= RF_eventTypeSize; j++) {
-        for (q = 1; q <= parent -> eTimeSize; q++) {
-          (parent -> localCSH)[j][q] = 0.0;
-        }
+  else {
+    serialPtr = RF_serialTreeIndex;
+    localSerialCount = serialTreeID;
+  }
+  imputedValue = 0.0;  
+  double *localDistribution = dvector(1, maxDistributionSize);
+  char  *naiveFlag = cvector(1, mpIndexSize);
+  char **naiveSign = cmatrix(1, mRecordSize, 1, mpIndexSize);
+  for (p = 1; p <= mpIndexSize; p++) {
+    naiveFlag[p] = FALSE;
+  }
+  for (i = 1; i <= mRecordSize; i++) {
+    outcomeFlag = TRUE;
+    for (p = 1; p <= mpIndexSize; p++) {
+      naiveSign[i][p] = FALSE;
+      if (mpIndex[p] < 0) {
+        unsignedSignatureIndex = (uint) abs(mpIndex[p]);
       }
-      for (j=1; j <= RF_eventTypeSize; j++) {
-        for (q = 1; q <= parent -> eTimeSize; q++) {
-          (parent -> localCSH)[j][q] = (parent -> localRatio)[j][q];
-        }
-        for (q = 2; q <= parent -> eTimeSize; q++) {
-          (parent -> localCSH)[j][q] += (parent -> localCSH)[j][q-1];
+      else {
+        if (predictorFlag == TRUE) {
+          unsignedSignatureIndex = (uint) mpIndex[p] + rspSize;
         }
+        outcomeFlag = FALSE;
+      }
+      if (outcomeFlag || predictorFlag) {
+        if (mpSign[unsignedSignatureIndex][i] == 1) {
+          localDistributionSize = 0;
+          for (tree = 1; tree <= localSerialCount; tree++) {
+            if (RF_tLeafCount[serialPtr[tree]] > 0) {
+              if ((RF_dmRecordBootFlag[serialPtr[tree]][i] == selectionFlag) || (selectionFlag == ACTIVE)) {
+                info = termMembershipPtr[serialPtr[tree]][mRecordIndex[i]];
+                for (v = 1; v <= info -> lmiSize; v++) {
+                  if ((info -> lmiIndex)[v] == p) {
+                        if (!ISNA((info -> lmiValue)[v])) {
+                          localDistribution[++localDistributionSize] = (info -> lmiValue)[v];
+                        }
+                        else {
+                        }  
+                    v = info -> lmiSize;
+                  }
+                }
+              }  
+            }  
+            else {
+            }
+          }  
+          if (localDistributionSize > 0) {
+            if (mpIndex[p] < 0) {
+              if (strcmp(RF_rType[(uint) abs(mpIndex[p])], "T") == 0) {
+                imputedValue = getMeanValue(localDistribution, localDistributionSize);
+              }
+              else if (strcmp(RF_rType[(uint) abs(mpIndex[p])], "S") == 0) {
+                imputedValue = getMaximalValue(localDistribution, localDistributionSize, FALSE, localSerialCount);
+              }
+              else if (strcmp(RF_rType[(uint) abs(mpIndex[p])], "R") == 0) {
+                imputedValue = getMeanValue(localDistribution, localDistributionSize);
+              }
+              else if (strcmp(RF_rType[(uint) abs(mpIndex[p])], "I") == 0) {
+                imputedValue = getMaximalValue(localDistribution, localDistributionSize, FALSE, localSerialCount);
+              }
+              else if (strcmp(RF_rType[(uint) abs(mpIndex[p])], "C") == 0) {
+                imputedValue = getMaximalValue(localDistribution, localDistributionSize, FALSE, localSerialCount);
+              }
+              outResponse[(uint) abs(mpIndex[p])][i] = imputedValue;
+            }  
+            else {
+              if (strcmp(RF_xType[(uint) mpIndex[p]], "R") == 0) {
+                imputedValue = getMeanValue(localDistribution, localDistributionSize);
+              }
+              else {
+                imputedValue = getMaximalValue(localDistribution, localDistributionSize, FALSE, localSerialCount);
+              }
+              outPredictor[(uint) mpIndex[p]][i] = imputedValue;
+            }
+          }  
+          else {
+            naiveFlag[p] = TRUE;
+            naiveSign[i][p] = TRUE;
+          }
+        }  
+      }  
+      else {
+        p = mpIndexSize;
       }
+    }  
+  }  
+  outcomeFlag = TRUE;
+  for (p = 1; p <= mpIndexSize; p++) {
+    if (mpIndex[p] < 0) {
+      unsignedSignatureIndex = (uint) abs(mpIndex[p]);
+      valuePtr = RF_responseIn[(uint) abs(mpIndex[p])];
+      naivePtr = outResponse[(uint) abs(mpIndex[p])];
     }
-}
-void getLocalCIF(uint treeID, Terminal *parent) {
-  uint j, q;
-  if(parent -> eTimeSize > 0) {
-    stackLocalCIF(parent, RF_eventTypeSize, parent -> eTimeSize);
-    for (j=1; j <= RF_eventTypeSize; j++) {
-      for (q = 1; q <= parent -> eTimeSize; q++) {
-        (parent -> localCIF)[j][q] = 0.0;
+    else {
+      if (predictorFlag == TRUE) {
+        unsignedSignatureIndex = (uint) mpIndex[p] + rspSize;
+        valuePtr = RF_observationIn[(uint) mpIndex[p]];
+        naivePtr = outPredictor[(uint) mpIndex[p]];
       }
+      outcomeFlag = FALSE;
     }
-    for (j=1; j <= RF_eventTypeSize; j++) {
-      (parent -> localCIF)[j][1] = (parent -> localRatio)[j][1];
-      for (q = 2; q <= parent -> eTimeSize; q++) {
-        (parent -> localCIF)[j][q] = (parent -> localSurvival)[q-1] * (parent -> localRatio)[j][q];
-      }
-      for (q = 2; q <= parent -> eTimeSize; q++) {
-        (parent -> localCIF)[j][q] += (parent -> localCIF)[j][q-1];
-      }
+    if (outcomeFlag || predictorFlag) {
+      if (naiveFlag[p] == TRUE) {
+        localDistributionSize = 0;
+        for (i=1; i <= RF_observationSize; i++) {
+          mFlag = TRUE;
+          if (RF_mRecordMap[i] == 0) {
+            mFlag = FALSE;
+          }
+          else if (RF_mpSign[unsignedSignatureIndex][RF_mRecordMap[i]] == 0) {
+            mFlag = FALSE;
+          }
+          if (mFlag == FALSE) {
+            localDistribution[++localDistributionSize] = valuePtr[i];
+          }
+        }  
+        if (localDistributionSize > 0) {
+          for (i=1; i <= mRecordSize; i++) {
+            if (naiveSign[i][p] == TRUE) {
+              naivePtr[i] = getSampleValue(localDistribution, localDistributionSize, FALSE, localSerialCount);
+            }
+          }
+        }  
+        else {
+          if (mpIndex[p] < 0) {
+            RFprintf("\nRF-SRC:  *** ERROR *** ");
+            RFprintf("\nRF-SRC:  Naive imputation failed for [indv, outcome] = [%10d, %10d] \n", mRecordIndex[i], mpIndex[p]);
+            RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+            error("\nRF-SRC:  The application will now exit.\n");
+          }
+          else {
+          }
+        }
+      }  
+    }  
+    else {
+      p = mpIndexSize;
     }
+  }  
+  if (serialTreeID == 0) {
+    free_uivector(localSerialIndex, 1, RF_forestSize);
   }
+  free_dvector(localDistribution, 1, maxDistributionSize);
+  free_cvector(naiveFlag, 1, mpIndexSize);
+  free_cmatrix(naiveSign, 1, mRecordSize, 1, mpIndexSize);
 }
-void getSurvival(uint treeID, Terminal *parent) {
-  uint priorTimePointIndex, currentTimePointIndex;
-  uint i, k;
-  stackSurvival(parent, RF_sortedTimeInterestSize);
-  for (k=1; k <= RF_sortedTimeInterestSize; k++) {
-    (parent -> survival)[k] = 0.0;
-  }
-  if (parent -> eTimeSize > 0) {
-    priorTimePointIndex = 0;
-    currentTimePointIndex = 1;
-    for (i = 1; i <= (parent -> eTimeSize); i++) {
-      for (k = priorTimePointIndex + 1; k <= RF_sortedTimeInterestSize; k++) {
-        if (RF_timeInterest[k] <= RF_masterTime[(parent -> eventTimeIndex)[i]] ) {
-          currentTimePointIndex = k;
-        }
-        else {
-          k = RF_sortedTimeInterestSize;
-        }
-      }
-      (parent -> survival)[currentTimePointIndex] = (parent -> localSurvival)[i];
-      if (i == 1) {
-        for(k = 1; k < currentTimePointIndex; k++) {
-          (parent -> survival)[k] = 1.0;
-        }
-      }
-      if (i > 1) {
-        for(k = priorTimePointIndex + 1; k < currentTimePointIndex; k++) {
-          (parent -> survival)[k] = (parent -> survival)[priorTimePointIndex];
-        }
+void imputeMultipleTime (char selectionFlag) {
+  double  *outTime;
+  char     result;
+  uint i;
+  result = FALSE;
+    if (RF_timeIndex > 0) {
+      if (RF_mRecordSize > 0) {
+      if (RF_mTimeFlag == TRUE) {
+        result = TRUE;
       }
-      if (i == (parent -> eTimeSize)) {
-        for(k = currentTimePointIndex + 1; k <= RF_sortedTimeInterestSize; k++) {
-          (parent -> survival)[k] = (parent -> survival)[currentTimePointIndex];
-        }
+      else {
+        RFprintf("\nRF-SRC:  *** ERROR *** ");
+        RFprintf("\nRF-SRC:  Attempt to multiply impute time with no missingness in time vector.");
       }
-      priorTimePointIndex = currentTimePointIndex;
     }
   }
   else {
-    for (k=1; k <= RF_sortedTimeInterestSize; k++) {
-      (parent -> survival)[k] = 1.0;
-    }
+    RFprintf("\nRF-SRC:  *** ERROR *** ");
+    RFprintf("\nRF-SRC:  Attempt to multiply impute time in a !SURV environment.");
   }
-}
-void getNelsonAalen(uint treeID, Terminal *parent) {
-  uint i, k, q;
-  uint priorTimePointIndex, currentTimePointIndex;
-  stackNelsonAalen(parent, RF_sortedTimeInterestSize);
-  for (q = 1; q <= RF_sortedTimeInterestSize; q++) {
-    (parent -> nelsonAalen)[q] = 0.0;
+  if (result == FALSE) {
+    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+    error("\nRF-SRC:  The application will now exit.\n");
   }
-  priorTimePointIndex = 0;
-  currentTimePointIndex = 1;
-  for (i = 1; i <= (parent -> eTimeSize); i++) {
-    for (k = priorTimePointIndex + 1; k <= RF_sortedTimeInterestSize; k++) {
-      if (RF_timeInterest[k] <= RF_masterTime[(parent -> eventTimeIndex)[i]] ) {
-        currentTimePointIndex = k;
-      }
-      else {
-        k = RF_sortedTimeInterestSize;
-      }
-    }
-    (parent -> nelsonAalen)[currentTimePointIndex] = (parent -> localNelsonAalen)[i];
-    if (i > 1) {
-      for(k = priorTimePointIndex + 1; k < currentTimePointIndex; k++) {
-        (parent -> nelsonAalen)[k] = (parent -> nelsonAalen)[priorTimePointIndex];
-      }
-    }
-    if (i == (parent -> eTimeSize)) {
-      for(k = currentTimePointIndex + 1; k <= RF_sortedTimeInterestSize; k++) {
-        (parent -> nelsonAalen)[k] = (parent -> nelsonAalen)[currentTimePointIndex];
-      }
+  outTime  = RF_sImputeResponsePtr[RF_timeIndex];
+  for (i=1; i <= RF_mRecordSize; i++) {
+    if(RF_mpSign[RF_timeIndex][i] == 1) {
+      outTime[i] = getNearestMasterTime(outTime[i], FALSE, 1);
     }
-    priorTimePointIndex = currentTimePointIndex;
   }
 }
-void getCSH(uint treeID, Terminal *parent) {
-  uint priorTimePointIndex, currentTimePointIndex;
-  uint i, j, k;
-  stackCSH(parent, RF_eventTypeSize, RF_sortedTimeInterestSize);
-  for (j=1; j <= RF_eventTypeSize; j++) {
-    for (k=1; k <= RF_sortedTimeInterestSize; k++) {
-      (parent -> CSH)[j][k] = 0.0;
+double getNearestMasterTime (double   meanValue,
+                             char     chainFlag,
+                             uint     treeID) {
+  double leftDistance, rightDistance;
+  uint minimumIndex;
+  uint j;
+    leftDistance = meanValue - RF_masterTime[1];
+    rightDistance = RF_masterTime[RF_masterTimeSize] - meanValue;
+    if ( ((leftDistance > EPSILON) || (fabs(leftDistance) < EPSILON)) &&
+         ((rightDistance > EPSILON) || (fabs(rightDistance) < EPSILON)) ) {
     }
-  }
-  priorTimePointIndex = 0;
-  currentTimePointIndex = 1;
-  for (i = 1; i <= (parent -> eTimeSize); i++) {
-    for (k = priorTimePointIndex + 1; k <= RF_sortedTimeInterestSize; k++) {
-      if (RF_timeInterest[k] <= RF_masterTime[(parent -> eventTimeIndex)[i]] ) {
-        currentTimePointIndex = k;
-      }
-      else {
-        k = RF_sortedTimeInterestSize;
-      }
+    else {
+      RFprintf("\nRF-SRC:  *** ERROR *** ");
+      RFprintf("\nRF-SRC:  The summary mean value for time is out of range:  %12.4f <= %12.4f <= %12.4f", RF_masterTime[1], meanValue, RF_masterTime[RF_masterTimeSize]);
+      RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+      error("\nRF-SRC:  The application will now exit.\n");
     }
-    for (j=1; j <= RF_eventTypeSize; j++) {
-      (parent -> CSH)[j][currentTimePointIndex] = (parent -> localCSH)[j][i];
-      if (i > 1) {
-        for(k = priorTimePointIndex + 1; k < currentTimePointIndex; k++) {
-          (parent -> CSH)[j][k] = (parent -> CSH)[j][priorTimePointIndex];
-        }
-      }
-      if (i == (parent -> eTimeSize)) {
-        for(k = currentTimePointIndex + 1; k <= RF_sortedTimeInterestSize; k++) {
-          (parent -> CSH)[j][k] = (parent -> CSH)[j][currentTimePointIndex];
-        }
-      }
+  leftDistance = rightDistance = 0;
+  minimumIndex = RF_masterTimeSize;
+  for (j = 1; j <= RF_masterTimeSize; j++) {
+    if (meanValue <= RF_masterTime[j]) {
+      minimumIndex = j;
+      j = RF_masterTimeSize;
     }
-    priorTimePointIndex = currentTimePointIndex;
   }
-}
-void getCIF(uint treeID, Terminal *parent) {
-  uint priorTimePointIndex, currentTimePointIndex;
-  uint i, j, k;
-  stackCIF(parent, RF_eventTypeSize, RF_sortedTimeInterestSize);
-  for (j=1; j <= RF_eventTypeSize; j++) {
-    for (k=1; k <= RF_sortedTimeInterestSize; k++) {
-      (parent -> CIF)[j][k] = 0.0;
-    }
+  if (minimumIndex == 1) {
   }
-  priorTimePointIndex = 0;
-  currentTimePointIndex = 1;
-  for (i = 1; i <= (parent -> eTimeSize); i++) {
-    for (k = priorTimePointIndex + 1; k <= RF_sortedTimeInterestSize; k++) {
-      if (RF_timeInterest[k] <= RF_masterTime[(parent -> eventTimeIndex)[i]] ) {
-        currentTimePointIndex = k;
-      }
-      else {
-        k = RF_sortedTimeInterestSize;
-      }
+  else {
+    leftDistance = meanValue - RF_masterTime[minimumIndex-1];
+    rightDistance = RF_masterTime[minimumIndex] - meanValue;
+    if (leftDistance < rightDistance) {
+      minimumIndex = minimumIndex - 1;
     }
-    for (j = 1; j <= RF_eventTypeSize; j++) {
-      (parent -> CIF)[j][currentTimePointIndex] = (parent -> localCIF)[j][i];
-      if (i > 1) {
-        for(k = priorTimePointIndex + 1; k < currentTimePointIndex; k++) {
-          (parent -> CIF)[j][k] = (parent -> CIF)[j][priorTimePointIndex];
+    else {
+      if (fabs(leftDistance - rightDistance) < EPSILON) {
+        if(chainFlag) {
+          if (ran1A(treeID) <= 0.5) {
+            minimumIndex = minimumIndex - 1;
+          }
         }
-      }
-      if (i == (parent -> eTimeSize)) {
-        for(k = currentTimePointIndex + 1; k <= RF_sortedTimeInterestSize; k++) {
-          (parent -> CIF)[j][k] = (parent -> CIF)[j][currentTimePointIndex];
+        else {
+          if (ran1B(treeID) <= 0.5) {
+            minimumIndex = minimumIndex - 1;
+          }
         }
       }
     }
-    priorTimePointIndex = currentTimePointIndex;
   }
+  return RF_masterTime[minimumIndex];
 }
-void getMortality(uint treeID, Terminal *parent) {
-  uint j, q;
-  stackMortality(parent, RF_eventTypeSize);
-  for (j = 1; j <= RF_eventTypeSize; j++) {
-    (parent -> mortality)[j] = 0.0;
+double getMaximalValue(double *value, uint size, char chainFlag, uint treeID) {
+  double result;
+  uint classCount, maximalClassSize, maximalClassCount;
+  uint randomIndex;
+  uint j;
+  uint   *classSize  = uivector(1, size);
+  for (j = 1; j <= size; j++) {
+    classSize[j] = 0;
   }
-  if (!(RF_opt & OPT_COMP_RISK)) {
-    for (q = 1; q <= RF_sortedTimeInterestSize; q++) {
-      (parent -> mortality)[1] += (parent -> nelsonAalen)[q];
+  hpsort(value, size);
+  classCount = 1;
+  classSize[1] = 1;
+  for (j = 2; j <= size; j++) {
+    if (value[j] > value[classCount]) {
+      classCount ++;
+      value[classCount] = value[j];
+    }
+    classSize[classCount] ++;
+  }
+  maximalClassSize = maximalClassCount = 0;
+  for (j=1; j <= classCount; j++) {
+    if (classSize[j] > maximalClassSize) {
+      maximalClassSize = classSize[j];
+    }
+  }
+  for (j=1; j <= classCount; j++) {
+    if (classSize[j] == maximalClassSize) {
+      maximalClassCount ++;
+    }
+  }
+  if (maximalClassCount > 1) {
+    if(chainFlag) {
+      randomIndex = (uint) ceil(ran1A(treeID)*((maximalClassCount)*1.0));
+    }
+    else {
+      randomIndex = (uint) ceil(ran1B(treeID)*((maximalClassCount)*1.0));
     }
   }
   else {
-    for (j = 1; j <= RF_eventTypeSize; j ++) {
-      for (q = 1; q <= RF_sortedTimeInterestSize - 1; q++) {
-        (parent -> mortality)[j] += (parent -> CIF)[j][q] * (RF_timeInterest[q+1] - RF_timeInterest[q]);
-      }
+    randomIndex = 1;
+  }
+  j = 0;
+  while (randomIndex > 0) {
+    j++;
+    if (classSize[j] == maximalClassSize) {
+      randomIndex --;
     }
   }
+  result = value[j];
+  free_uivector(classSize, 1, size);
+  return result;
 }
-void restoreSurvival(uint treeID, Terminal *parent) {
-  (parent -> survival) = RF_TN_SURV_ptr[treeID][parent -> nodeID];
-  if (parent -> membrCount > 0) {
+double getMedianValue(double *value, uint size) {
+  double result;
+  uint medianIndex;
+  sort(value, size);
+  if (size > 1) {
+    medianIndex = (uint) ceil(size/2);
   }
   else {
-    RFprintf("\nRF-SRC:  *** ERROR *** ");
-    RFprintf("\nRF-SRC:  Zero node count encountered in restoreSurvival() in (tree, leaf) = (%10d, %10d)  \n", treeID, parent -> nodeID);
-    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-    error("\nRF-SRC:  The application will now exit.\n");
+    medianIndex = 1;
   }
+  result = value[medianIndex];
+  return result;
 }
-void restoreMortality(uint treeID, Terminal *parent) {
-  (parent -> mortality) = RF_TN_MORT_ptr[treeID][parent -> nodeID];
-}
-void restoreNelsonAalen(uint treeID, Terminal *parent) {
-  (parent -> nelsonAalen) = RF_TN_NLSN_ptr[treeID][parent -> nodeID];
-}
-void restoreCSH(uint treeID, Terminal *parent) {
-  (parent -> CSH) = RF_TN_CSHZ_ptr[treeID][parent -> nodeID];
-}
-void restoreCIF(uint treeID, Terminal *parent) {
-  (parent -> CIF) = RF_TN_CIFN_ptr[treeID][parent -> nodeID];
+double getMeanValue(double *value, uint size) {
+  double result;
+  uint j;
+  result = 0.0;
+  for (j = 1; j <= size; j++) {
+    result = result + value[j];
+  }
+  result = result / size;
+  return result;
 }
-void updateEnsembleSurvival(uint mode,
-                            uint treeID,
-                            uint serialTreeID) {
-  char oobFlag, fullFlag, selectionFlag, outcomeFlag;
-  Terminal ***termMembershipPtr;
-  uint    *membershipIndex;
-  uint     membershipSize;
-  double ***ensembleSRGnum;
-  double ***ensembleCIFnum;
-  double  **ensembleSRVnum;
-  double  **ensembleMRTptr;
-  double  **ensembleMRTnum;
-  uint     *ensembleDen;
-  Terminal *parent;
-  uint i, j, k;
-  uint ii;
-  ensembleSRGnum = NULL;  
-  ensembleCIFnum = NULL;  
-  ensembleSRVnum = NULL;  
-  ensembleMRTptr = NULL;  
-  ensembleMRTnum = NULL;  
-  ensembleDen    = NULL;  
-  oobFlag = fullFlag = FALSE;
-  switch (mode) {
-  case RF_PRED:
-    if (RF_opt & OPT_FENS) {
-      fullFlag = TRUE;
-    }
-    termMembershipPtr = RF_ftTermMembership;
-    break;
-  default:
-    if (RF_opt & OPT_OENS) {
-      if (RF_oobSize[treeID] > 0) {
-        oobFlag = TRUE;
-      }
-    }
-    if (RF_opt & OPT_FENS) {
-      fullFlag = TRUE;
-    }
-    termMembershipPtr = RF_tTermMembership;
-    break;
+double getSampleValue(double *value, uint size, char chainFlag, uint treeID) {
+  uint randomIndex;
+  if(chainFlag) {
+    randomIndex = (uint) ceil(ran1A(treeID)*((size)*1.0));
   }
-  outcomeFlag = TRUE;
-  while ((oobFlag == TRUE) || (fullFlag == TRUE)) {
-    if (oobFlag == TRUE) {
-      ensembleSRGnum = RF_oobEnsembleSRGnum;
-      ensembleMRTptr = RF_oobEnsembleMRTptr;        
-      ensembleMRTnum = RF_oobEnsembleMRTnum;
-      ensembleSRVnum = RF_oobEnsembleSRVnum;
-      ensembleCIFnum = RF_oobEnsembleCIFnum;
-      ensembleDen    = RF_oobEnsembleDen;
-      membershipSize  = RF_oobSize[treeID];
-      membershipIndex = RF_oobMembershipIndex[treeID];
-    }
-    else {
-      ensembleSRGnum = RF_fullEnsembleSRGnum;
-      ensembleMRTptr = RF_fullEnsembleMRTptr;
-      ensembleMRTnum = RF_fullEnsembleMRTnum;        
-      ensembleSRVnum = RF_fullEnsembleSRVnum;
-      ensembleCIFnum = RF_fullEnsembleCIFnum;
-      ensembleDen    = RF_fullEnsembleDen;
-      switch (mode) {
-      case RF_PRED:
-        membershipSize = RF_fobservationSize;
-        membershipIndex = RF_fidentityMembershipIndex;
-        break;
-      default:
-        membershipSize  = RF_observationSize;
-        membershipIndex = RF_identityMembershipIndex;
-        break;
-      }
-    }
-    for (i = 1; i <= membershipSize; i++) {
-      ii = membershipIndex[i];
-      parent = termMembershipPtr[treeID][ii];
-      selectionFlag = TRUE;
-      if (RF_opt & OPT_OUTC_TYPE) {
-        if ((parent -> membrCount) > 0) {
-        }
-        else {
-          selectionFlag = FALSE;
-        }
-      }
-      if (selectionFlag) {
-        ensembleDen[ii] ++;
-        if (!(RF_opt & OPT_COMP_RISK)) {
-          ensembleMRTnum[1][ii] += parent -> mortality[1];
-          for (k=1; k <= RF_sortedTimeInterestSize; k++) {
-            ensembleSRGnum[1][k][ii] += parent -> nelsonAalen[k];
-            ensembleSRVnum[k][ii] += parent -> survival[k];
-          }
-          if (outcomeFlag) {
-            if (ensembleDen[ii] != 0) {
-              ensembleMRTptr[1][ii] = ensembleMRTnum[1][ii] / ensembleDen[ii];
-            }
-          }
-        }
-        else {
-          for (j = 1; j <= RF_eventTypeSize; j++) {
-            ensembleMRTnum[j][ii] += parent -> mortality[j];
-            for (k=1; k <= RF_sortedTimeInterestSize; k++) {
-              ensembleSRGnum[j][k][ii] += parent -> CSH[j][k];
-              ensembleCIFnum[j][k][ii] += parent -> CIF[j][k];
-            }
-          }
-          if (outcomeFlag) {
-            if (ensembleDen[ii] != 0) {
-              for (j = 1; j <= RF_eventTypeSize; j ++) {
-                ensembleMRTptr[j][ii] = ensembleMRTnum[j][ii] / ensembleDen[ii];
-              }
-            }
-          }
-        }
-      }
-    }  
-    if (outcomeFlag == TRUE) {
-      outcomeFlag = FALSE;
-    }
-    if (oobFlag == TRUE) {
-      oobFlag = FALSE;
-    }
-    else {
-      fullFlag = FALSE;
-    }
-  }  
+  else {
+    randomIndex = (uint) ceil(ran1B(treeID)*((size)*1.0));
+  }
+  return value[randomIndex];
 }
-void getEnsembleMortalityCR(uint      mode,
-                            uint      treeID,
-                            uint      obsSize,
-                            double  **ensembleMRTptr,
-                            uint     *ensembleDen,
-                            double  **cMortality) {
-  uint i, j;
-  for (i = 1; i <= obsSize; i++) {
-    if (ensembleDen[i] != 0) {
-      for (j = 1; j <= RF_eventTypeSize; j ++) {
-        cMortality[j][i] = ensembleMRTptr[j][i] / ensembleDen[i];
+uint getRecordMap(uint    *map,
+                  uint     obsSize,
+                  double **resp,
+                  double **data) {
+  uint i, p, r;
+  uint mSize;
+  char mFlag;
+  mSize  = 0;
+  for (i = 1; i <= obsSize; i++) {
+    mFlag = FALSE;
+    if (resp != NULL) {
+      for (r = 1; r <= RF_rSize; r++) {
+        if (ISNA(resp[r][i])) {
+          mFlag = TRUE;
+          r = RF_rSize;
+        }
       }
     }
-    else {
-      for (j = 1; j <= RF_eventTypeSize; j ++) {
-        cMortality[j][i] = NA_REAL;
+    if (mFlag == FALSE) {
+      for (p = 1; p <= RF_xSize; p++) {
+        if (ISNA(data[p][i])) {
+          mFlag = TRUE;
+          p = RF_xSize;
+        }
       }
     }
-  }
-}
-void getEnsembleMortality(uint      mode,
-                          uint      treeID,
-                          uint      obsSize,
-                          double  **ensembleMRTptr,
-                          uint     *ensembleDen,
-                          double   *mortality) {
-  uint i;
-  for (i = 1; i <= obsSize; i++) {
-    if (ensembleDen[i] != 0) {
-      mortality[i] = ensembleMRTptr[1][i] / ensembleDen[i];
+    if (mFlag == TRUE) {
+      mSize ++;
+      map[i] = mSize;
     }
     else {
-      mortality[i] = NA_REAL;
+      map[i] = 0;
     }
   }
+  return mSize;
 }
-void getConditionalConcordanceArrays(uint     j,
-                                     double  *timePtr,
-                                     double  *statusPtr,
-                                     double  *mortalityPtr,
-                                     uint    *genericEnsembleDenPtr,
-                                     uint    *meIndividualSize,
-                                     uint   **eIndividual,
-                                     double  *subsettedTime,
-                                     double  *subsettedStatus,
-                                     double  *subsettedMortality,
-                                     uint    *subsettedEnsembleDen) {
-  uint i;
-  if (!(RF_opt & OPT_COMP_RISK)) {
-    RFprintf("\nRF-SRC:  *** ERROR *** ");
-    RFprintf("\nRF-SRC:  Attempt to update event type subsets in a non-CR analysis.");
-    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-    error("\nRF-SRC:  The application will now exit.\n");
+void updateTimeIndexArray(uint    treeID,
+                          uint   *allMembrIndx,
+                          uint    allMembrSize,
+                          double *time,
+                          char    naAllowFlag,
+                          char    noIdxAllowFlag,
+                          uint   *masterTimeIndex) {
+  uint *membrIndx;
+  char idxFoundFlag;
+  uint i,k;
+  if (allMembrIndx == NULL) {
+    membrIndx = uivector(1, allMembrSize);
+    for (i = 1; i <= allMembrSize; i++) {
+      membrIndx[i] = i;
+    }
   }
-  for (i = 1; i <= meIndividualSize[j]; i++) {
-    subsettedTime[i]        = timePtr[eIndividual[j][i]];
-    subsettedStatus[i]      = statusPtr[eIndividual[j][i]];
-    subsettedMortality[i]   = mortalityPtr[eIndividual[j][i]];
-    subsettedEnsembleDen[i] = genericEnsembleDenPtr[eIndividual[j][i]];
+  else {
+    membrIndx = allMembrIndx;
   }
-}
-double getConcordanceIndex(int     polarity,
-                           uint    size,
-                           double *timePtr,
-                           double *statusPtr,
-                           double *predictedOutcome,
-                           uint   *denCount) {
-  uint i,j;
-  uint concordancePairSize;
-  uint concordanceWorseCount;
-  double result;
-  concordancePairSize = concordanceWorseCount = 0;
-  for (i=1; i < size; i++) {
-    for (j=i+1; j <= size; j++) {
-      if (denCount[i] != 0  && denCount[j] != 0) {
-        if ( ((timePtr[i] - timePtr[j] > EPSILON) && (statusPtr[j] > 0)) ||
-             ((fabs(timePtr[i] - timePtr[j]) <= EPSILON) && (statusPtr[j] > 0) && (statusPtr[i] == 0)) ) {
-          concordancePairSize += 2;
-          if (predictedOutcome[j] - predictedOutcome[i] > EPSILON) {
-            concordanceWorseCount += 2;
-          }
-          else if (fabs(predictedOutcome[j] - predictedOutcome[i]) < EPSILON) {
-            concordanceWorseCount += 1;
-          }
-        }
-        else if ( ((timePtr[j] - timePtr[i]) > EPSILON  && (statusPtr[i] > 0)) ||
-                  ((fabs(timePtr[j] - timePtr[i]) <= EPSILON)  && (statusPtr[i] > 0) && (statusPtr[j] == 0)) ) {
-          concordancePairSize += 2;
-          if ( predictedOutcome[i] - predictedOutcome[j] > EPSILON ) {
-            concordanceWorseCount += 2;
-          }
-          else if (fabs(predictedOutcome[i] - predictedOutcome[j]) < EPSILON) {
-            concordanceWorseCount += 1;
-          }
-        }
-        else if ( (fabs(timePtr[i]- timePtr[j]) <= EPSILON) && (statusPtr[i] > 0) && (statusPtr[j] > 0) ) {
-          concordancePairSize += 2;
-          if (fabs(predictedOutcome[i] - predictedOutcome[j]) < EPSILON) {
-            concordanceWorseCount += 2;
-          }
-          else {
-            concordanceWorseCount += 1;
-          }
+  for (i=1; i <= allMembrSize; i++) {
+    idxFoundFlag = FALSE;
+    if (!ISNA(time[membrIndx[i]])) {
+      k = 1;
+      while (k <= RF_masterTimeSize) {
+        if (time[membrIndx[i]] == RF_masterTime[k]) {
+          masterTimeIndex[membrIndx[i]] = k;
+          idxFoundFlag = TRUE;
+          k = RF_masterTimeSize;
         }
-      }  
-    }  
-  }  
-  if (concordancePairSize == 0) {
-    result = NA_REAL;
+        k++;
+      }
+    }
+    else {
+      if (naAllowFlag == FALSE) {
+        RFprintf("\nRF-SRC:  *** ERROR *** ");
+        RFprintf("\nRF-SRC:  Missing event time encountered for individual:  %10d, %12.4f", i, time[membrIndx[i]]);
+        RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+        error("\nRF-SRC:  The application will now exit.\n");
+      }
+      else {
+        masterTimeIndex[membrIndx[i]] = 0;
+        idxFoundFlag = TRUE;
+      }
+    }
+    if (idxFoundFlag == FALSE) {
+      if (noIdxAllowFlag == FALSE) {
+        RFprintf("\nRF-SRC:  *** ERROR *** ");
+        RFprintf("\nRF-SRC:  Invalid event time encountered for individual:  %10d, %12.4f", i, time[membrIndx[i]]);
+        RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+        error("\nRF-SRC:  The application will now exit.\n");
+      }
+      else {
+        masterTimeIndex[membrIndx[i]] = 0;
+      }
+    }
   }
-  else {
-    result = 1.0 - ((double) concordanceWorseCount / (double) concordancePairSize);
+  if (allMembrIndx == NULL) {
+    free_uivector(membrIndx, 1, allMembrSize);
   }
-  return result;
-}
-void getCRPerformance (uint     mode,
-                       uint     obsSize,
-                       double **responsePtr,
-                       double **yearsLost,
-                       uint    *denom,
-                       double  *performanceVector) {
-  uint   mRecordSize;
-  int  **mpSign;
-  uint  *mRecordIndex;
-  uint  *meIndividualSize;
-  uint **eIndividual;
-  double concordanceIndex;
-  uint j;
-  if (!(RF_opt & OPT_COMP_RISK)) {
+}  
+void updateEventTypeSubsets(double *summaryStatus,
+                            uint    mRecordSize,
+                            int   **mpSign,
+                            uint   *mRecordIndex,
+                            uint   *meIndividualSize,
+                            uint  **eIndividual) {
+  uint i, j;
+  if (RF_eventTypeSize == 1) {
     RFprintf("\nRF-SRC:  *** ERROR *** ");
-    RFprintf("\nRF-SRC:  Attempt at conditional performance updates in a non-CR analysis.");
+    RFprintf("\nRF-SRC:  Attempt to update event type subsets in a non-CR analysis.");
     RFprintf("\nRF-SRC:  Please Contact Technical Support.");
     error("\nRF-SRC:  The application will now exit.\n");
   }
-  if (RF_mStatusSize > 0) {
-    if (mode != RF_PRED) {
-      mRecordSize = RF_mRecordSize;
-      mpSign = RF_mpSign;
-      mRecordIndex = RF_mRecordIndex;
-    }
-    else {
-      mRecordSize = RF_fmRecordSize;
-      mpSign = RF_fmpSign;
-      mRecordIndex = RF_fmRecordIndex;
-    }
-    meIndividualSize  = uivector(1, RF_eventTypeSize);
-    eIndividual = (uint **) new_vvector(1, RF_eventTypeSize, NRUTIL_UPTR);
-    for (j = 1; j <= RF_eventTypeSize; j++) {
-      eIndividual[j] = uivector(1, RF_eIndividualSize[j] + RF_mStatusSize + 1);
+  for (j = 1; j <= RF_eventTypeSize; j++) {
+    for (i = 1; i <= RF_eIndividualSize[j]; i++) {
+      eIndividual[j][i] = RF_eIndividualIn[j][i];
     }
-    updateEventTypeSubsets(responsePtr[RF_statusIndex], mRecordSize, mpSign, mRecordIndex, meIndividualSize, eIndividual);
   }
-  else {
-    meIndividualSize  = RF_eIndividualSize;
-    eIndividual = RF_eIndividualIn;
-  }
-  double *subsettedTime      = dvector(1, obsSize);
-  double *subsettedStatus    = dvector(1, obsSize);
-  double *subsettedMortality = dvector(1, obsSize);
-  uint *subsettedEnsembleDen = uivector(1, obsSize);
-  for (j = 1; j <= RF_eventTypeSize; j++) {
-    getConditionalConcordanceArrays(j,
-                                    responsePtr[RF_timeIndex],
-                                    responsePtr[RF_statusIndex],
-                                    yearsLost[j],
-                                    denom,
-                                    meIndividualSize,
-                                    eIndividual,
-                                    subsettedTime,
-                                    subsettedStatus,
-                                    subsettedMortality,
-                                    subsettedEnsembleDen);
-    concordanceIndex = getConcordanceIndex(1,
-                                           meIndividualSize[j],
-                                           subsettedTime,
-                                           subsettedStatus,
-                                           subsettedMortality,
-                                           subsettedEnsembleDen);
-    if (ISNA(concordanceIndex)) {
-      performanceVector[j] = NA_REAL;
+  if (RF_mStatusSize > 0) {
+    uint *eventCounter = uivector(1, RF_eventTypeSize);
+    for (j = 1; j <= RF_eventTypeSize; j++) {
+      eventCounter[j] = RF_eIndividualSize[j];
     }
-    else {
-      performanceVector[j] = concordanceIndex;
+    for (i = 1; i <= mRecordSize; i++) {
+      if (mpSign[RF_statusIndex][i] == 1) {
+        if ((uint) summaryStatus[mRecordIndex[i]] > 0) {
+          j = RF_eventTypeIndex[(uint) summaryStatus[mRecordIndex[i]]];
+          eventCounter[j] ++;
+          eIndividual[j][eventCounter[j]] = mRecordIndex[i];
+        }
+        else {
+          for (j=1; j <= RF_eventTypeSize; j++) {
+            eventCounter[j] ++;
+            eIndividual[j][eventCounter[j]] = mRecordIndex[i];
+          }
+        }
+      }
     }
-  }
-  if (RF_mStatusSize > 0) {
-    free_uivector(meIndividualSize, 1, RF_eventTypeSize);
     for (j = 1; j <= RF_eventTypeSize; j++) {
-      free_uivector(eIndividual[j], 1, RF_eIndividualSize[j] + RF_mStatusSize + 1);
+      meIndividualSize[j] = eventCounter[j];
     }
-    free_new_vvector(eIndividual, 1, RF_eventTypeSize, NRUTIL_UPTR);
+    free_uivector(eventCounter, 1, RF_eventTypeSize);
   }
-  free_dvector(subsettedTime, 1, obsSize);
-  free_dvector(subsettedStatus, 1, obsSize);
-  free_dvector(subsettedMortality, 1, obsSize);
-  free_uivector(subsettedEnsembleDen, 1, obsSize);
 }
-char imputeNode (uint     type,
-                 char     termFlag,
-                 char     chainFlag,
-                 uint     treeID,
-                 Node    *nodePtr,
-                 uint    *repMembrIndx,
-                 uint     repMembrSize,
-                 uint    *allMembrIndx,
-                 uint     allMembrSize) {
-  double  **response;
-  double  **predictor;
-  double    imputedValue;
-  uint     *mRecordMap;
-  uint      mpIndexSize;
-  int     **mpSign;
-  int      *mpIndex;
-  int      *mvNSptr;
-  uint      mRecordSize;
-  double *valuePtr, *imputePtr;
-  char mPredictorFlag;
-  int  signedSignatureIndex;
-  uint unsignedIndexSource;
-  uint unsignedIndexTarget;
-  char result;
-  uint   *glmpIndexPtr;
-  double *glmpValuePtr;
-  uint   *glmpIndexSize;
-  uint  *glmpIndexParentPtr;
-  uint   glmpIndexParentSize;
-  char mvFlag;
-  uint i,p;
-  uint localDistributionSize;
-  mvNSptr = NULL;  
-  mpIndex = NULL;  
-  mpSign  = NULL;  
-  mpIndexSize  = 0;  
-  mRecordMap = NULL;  
-  mRecordSize = 0;    
-  predictor  = NULL;  
-  response   = NULL;  
-  imputedValue = 0.0;  
-  glmpIndexPtr = NULL;
-  glmpValuePtr = NULL;
-  glmpIndexSize = NULL;
-  glmpIndexParentPtr = NULL;
-  glmpIndexParentSize = 0;
-  result = FALSE;
-  switch (type) {
-  case RF_PRED:
-    mRecordSize = RF_fmRecordSize;
-    if (mRecordSize > 0) {
-      response = RF_fresponse[treeID];
-      predictor = RF_fobservation[treeID];
-      mRecordMap = RF_fmRecordMap;
-      mpIndexSize = RF_fmpIndexSize;
-      mpSign = RF_fmpSign;
-      mpIndex = RF_fmpIndex;
-      mvNSptr = nodePtr -> fmpSign;
-      if (!termFlag) {
-        if((nodePtr -> parent) == NULL) {
-          glmpIndexParentPtr = uivector(1, mpIndexSize);
-          glmpIndexParentSize = mpIndexSize;
-          for (p = 1; p <= glmpIndexParentSize; p++) {
-            glmpIndexParentPtr[p] = p;
+void stackShadow (uint mode, uint treeID) {
+  uint *nonMissIndex;
+  uint *permuteIndex;
+  uint * permuteSize;
+  char *nullSplitShadowFlag;
+  char  vimpShadowFlag;
+  uint  unsignedIndexSource;
+  uint  mpIndexIter;
+  uint i, j, p;
+  nonMissIndex        = NULL;  
+  permuteIndex        = NULL;  
+  permuteSize         = NULL;  
+  nullSplitShadowFlag = NULL;  
+  if (RF_opt & OPT_SPLT_NULL) {
+    nullSplitShadowFlag = cvector(1, RF_rSize);
+    for (p = 1; p <= RF_rSize; p++) {
+      nullSplitShadowFlag[p] = TRUE;
+    }
+    RF_response[treeID] = (double **) new_vvector(1, RF_rSize, NRUTIL_DPTR);
+    nonMissIndex = uivector(1, RF_observationSize);
+    permuteIndex = uivector(1, RF_observationSize);
+    permuteSize  = uivector(1, RF_rSize);
+    for (p = 1; p <= RF_rSize; p++) {
+      RF_response[treeID][p] = dvector(1, RF_observationSize);
+      for (i = 1; i <= RF_observationSize; i++) {
+        RF_response[treeID][p][i] = RF_responseIn[p][i];
+      }
+    }
+    mpIndexIter = 1;
+    for (p = 1; p <= RF_rSize; p++) {
+      permuteSize[p] = RF_observationSize;
+      for (i = 1; i <= RF_observationSize; i++) {
+        nonMissIndex[i] = i;
+      }
+      if (RF_mRecordSize > 0) {
+        if (RF_mpIndex[mpIndexIter] < 0) {
+          unsignedIndexSource = (uint) abs(RF_mpIndex[p]);
+          if (unsignedIndexSource == p) {
+            permuteSize[unsignedIndexSource] = 0;
+            for (i = 1; i <= RF_observationSize; i++) {
+              if (RF_mRecordMap[i] == 0) {
+                nonMissIndex[++(permuteSize[unsignedIndexSource])] = i;
+              }
+              else {
+                if (RF_mpSign[unsignedIndexSource][RF_mRecordMap[i]] == 0) {
+                  nonMissIndex[++(permuteSize[unsignedIndexSource])] = i;
+                }
+              }
+            }
+            mpIndexIter++;
           }
-          stackNodeFLMPIndex(nodePtr, glmpIndexParentSize);
-          glmpIndexPtr  = nodePtr -> flmpIndex;
-          glmpIndexSize = & (nodePtr -> flmpIndexActualSize);
-          *glmpIndexSize = 0;
         }
-        else {
-          if((nodePtr -> parent) -> flmpIndexActualSize > 0) {
-            glmpIndexParentPtr = (nodePtr -> parent) -> flmpIndex;
-            glmpIndexParentSize = (nodePtr -> parent) -> flmpIndexActualSize;
-            stackNodeFLMPIndex(nodePtr, glmpIndexParentSize);
-            glmpIndexPtr  = nodePtr -> flmpIndex;
-            glmpIndexSize = & (nodePtr -> flmpIndexActualSize);
-            *glmpIndexSize = 0;
-          }
-          else {
-            glmpIndexParentPtr  = NULL;
-            glmpIndexParentSize = 0;
-            glmpIndexPtr = glmpIndexSize = NULL;
-          }
-        }  
       }  
-      else {
-        glmpIndexParentPtr = uivector(1, mpIndexSize);
-        glmpIndexParentSize = mpIndexSize;
-        for (p = 1; p <= glmpIndexParentSize; p++) {
-          glmpIndexParentPtr[p] = p;
+      if(nullSplitShadowFlag[p]) {
+        permute (1, treeID, permuteSize[p], permuteIndex);
+        for (i = 1; i <= permuteSize[p]; i++) {
+          RF_response[treeID][p][nonMissIndex[i]] = RF_responseIn[p][nonMissIndex[permuteIndex[i]]];
         }
-        stackNodeFLMPIndex(nodePtr, glmpIndexParentSize);
-        glmpIndexPtr  = nodePtr -> flmpIndex;
-        glmpValuePtr  = nodePtr -> flmpValue;
-        glmpIndexSize = & (nodePtr -> flmpIndexActualSize);
-        *glmpIndexSize = 0;
       }
-      result = TRUE;
     }
-    break;
-  default:
-    mRecordSize = RF_mRecordSize;
-    if (mRecordSize > 0) {
-      response = RF_response[treeID];
-      predictor = RF_observation[treeID];
-      mRecordMap = RF_mRecordMap;
-      mpIndexSize = RF_mpIndexSize;
-      mpSign = RF_mpSign;
-      mpIndex = RF_mpIndex;
-      mvNSptr = nodePtr -> mpSign;
-      if (!termFlag) {
-        if((nodePtr -> parent) == NULL) {
-          glmpIndexParentPtr = uivector(1, mpIndexSize);
-          glmpIndexParentSize = mpIndexSize;
-          for (p = 1; p <= glmpIndexParentSize; p++) {
-            glmpIndexParentPtr[p] = p;
+    if (RF_timeIndex > 0) {
+      RF_time[treeID] = RF_response[treeID][RF_timeIndex];
+      RF_masterTimeIndex[treeID] = uivector(1, RF_observationSize);
+      updateTimeIndexArray(treeID,
+                           NULL,
+                           RF_observationSize,
+                           RF_time[treeID],
+                           TRUE,
+                           FALSE,
+                           RF_masterTimeIndex[treeID]);
+    }
+    if (RF_statusIndex > 0) {
+      RF_status[treeID] =  RF_response[treeID][RF_statusIndex];
+    }
+  }
+  else {
+    if (RF_mResponseFlag == TRUE) {
+      RF_response[treeID] = (double **) new_vvector(1, RF_rSize, NRUTIL_DPTR);
+      for (p = 1; p <= RF_rSize; p++) {
+        RF_response[treeID][p] = RF_responseIn[p];
+      }
+      for (p = 1; p <= RF_mpIndexSize; p++) {
+        if (RF_mpIndex[p] < 0) {
+          RF_response[treeID][(uint) abs(RF_mpIndex[p])] = dvector(1, RF_observationSize);
+          for (i = 1; i <= RF_observationSize; i++) {
+            RF_response[treeID][(uint) abs(RF_mpIndex[p])][i] = RF_responseIn[(uint) abs(RF_mpIndex[p])][i];
           }
-          stackNodeLMPIndex(nodePtr, glmpIndexParentSize);
-          glmpIndexPtr  = nodePtr -> lmpIndex;
-          glmpIndexSize = & (nodePtr -> lmpIndexActualSize);
-          *glmpIndexSize = 0;
         }
         else {
-          if((nodePtr -> parent) -> lmpIndexActualSize > 0) {
-            glmpIndexParentPtr = (nodePtr -> parent) -> lmpIndex;
-            glmpIndexParentSize = (nodePtr -> parent) -> lmpIndexActualSize;
-            stackNodeLMPIndex(nodePtr, glmpIndexParentSize);
-            glmpIndexPtr  = nodePtr -> lmpIndex;
-            glmpIndexSize = & (nodePtr -> lmpIndexActualSize);
-            *glmpIndexSize = 0;
+          p = RF_mpIndexSize;
+        }
+      }
+      if (RF_timeIndex > 0) {
+        RF_time[treeID] = RF_response[treeID][RF_timeIndex];
+        if (RF_mTimeFlag == TRUE) {
+          RF_masterTimeIndex[treeID] = uivector(1, RF_observationSize);
+          for (i = 1; i <= RF_observationSize; i++) {
+            RF_masterTimeIndex[treeID][i] = RF_masterTimeIndexIn[i];
           }
-          else {
-            glmpIndexParentPtr = NULL;
-            glmpIndexParentSize = 0;
-            glmpIndexPtr = glmpIndexSize = NULL;
+        }
+        else {
+          RF_masterTimeIndex[treeID] = RF_masterTimeIndexIn;
+        }
+      }
+      if (RF_statusIndex > 0) {
+        RF_status[treeID] =  RF_response[treeID][RF_statusIndex];
+      }
+    }
+  }
+  if (RF_opt & OPT_SPLT_NULL) {
+    free_uivector(nonMissIndex, 1, RF_observationSize);
+    free_uivector(permuteIndex, 1, RF_observationSize);
+    free_uivector(permuteSize,  1, RF_rSize);
+    free_cvector(nullSplitShadowFlag, 1, RF_rSize);
+  }
+  if (mode == RF_PRED) {
+    if (RF_frSize > 0) {
+      if (RF_fmResponseFlag == TRUE) {
+        RF_fresponse[treeID] = (double **) new_vvector(1, RF_rSize, NRUTIL_DPTR);
+        for (p = 1; p <= RF_frSize; p++) {
+          RF_fresponse[treeID][p] = RF_fresponseIn[p];
+        }
+        for (p = 1; p <= RF_fmpIndexSize; p++) {
+          if (RF_fmpIndex[p] < 0) {
+            RF_fresponse[treeID][(uint) abs(RF_fmpIndex[p])] = dvector(1, RF_fobservationSize);
+            for (i = 1; i <= RF_fobservationSize; i++) {
+              RF_fresponse[treeID][(uint) abs(RF_fmpIndex[p])][i] = RF_fresponseIn[(uint) abs(RF_fmpIndex[p])][i];
+            }
+          }
+          else {
+            p = RF_fmpIndexSize;
           }
-        }  
-      }  
-      else {
-        glmpIndexParentPtr = uivector(1, mpIndexSize);
-        glmpIndexParentSize = mpIndexSize;
-        for (p = 1; p <= glmpIndexParentSize; p++) {
-          glmpIndexParentPtr[p] = p;
         }
-        stackNodeLMPIndex(nodePtr, glmpIndexParentSize);
-        glmpIndexPtr  = nodePtr -> lmpIndex;
-        glmpValuePtr  = nodePtr -> lmpValue;
-        glmpIndexSize = & (nodePtr -> lmpIndexActualSize);
-        *glmpIndexSize = 0;
       }
-      result = TRUE;
     }
-    break;
   }
-  if (result == FALSE) {
-    RFprintf("\nRF-SRC:  *** ERROR *** ");
-    RFprintf("\nRF-SRC:  Attempt to impute node with no missingness in type:  %10d", type);
-    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-    error("\nRF-SRC:  The application will now exit.\n");
+  if (RF_rFactorCount + RF_xFactorCount > 0) {
+    RF_factorList[treeID] = (Factor **) new_vvector(1, RF_maxFactorLevel, NRUTIL_FPTR);
+    for (j = 1; j <= RF_maxFactorLevel; j++) {
+      RF_factorList[treeID][j] = NULL;
+    }
+    for (j = 1; j <= RF_xFactorCount; j++) {
+      if (RF_factorList[treeID][RF_xFactorSize[j]] == NULL) {
+        RF_factorList[treeID][RF_xFactorSize[j]] = makeFactor(RF_xFactorSize[j], FALSE);
+      }
+    }
+    for (j = 1; j <= RF_rFactorCount; j++) {
+      if (RF_factorList[treeID][RF_rFactorSize[j]] == NULL) {
+        RF_factorList[treeID][RF_rFactorSize[j]] = makeFactor(RF_rFactorSize[j], FALSE);
+      }
+    }
   }
-  nodePtr -> imputed = TRUE;
-  double *localDistribution = dvector(1, repMembrSize + 1);
-  for (p = 1; p <= glmpIndexParentSize; p++) {
-    if (mvNSptr[glmpIndexParentPtr[p]] != -1) {
-      signedSignatureIndex = mpIndex[glmpIndexParentPtr[p]];
-      if (signedSignatureIndex < 0) {
-        unsignedIndexSource = unsignedIndexTarget = (uint) abs(signedSignatureIndex);
-        valuePtr = RF_response[treeID][(uint) abs(signedSignatureIndex)];
-        imputePtr = response[(uint) abs(signedSignatureIndex)];
+  vimpShadowFlag = FALSE;
+  if ((RF_opt & OPT_VIMP) && (RF_opt & OPT_VIMP_TYP1) && !(RF_opt & OPT_VIMP_TYP2)) {
+    vimpShadowFlag = TRUE;
+  }
+  if(vimpShadowFlag == TRUE) {
+    RF_observation[treeID] = dmatrix(1, RF_xSize, 1, RF_observationSize);
+    for (p = 1; p <= RF_xSize; p++) {
+      for (i = 1; i <= RF_observationSize; i++) {
+        RF_observation[treeID][p][i] = RF_observationIn[p][i];
       }
-      else {
-        unsignedIndexSource = RF_rSize + (uint) signedSignatureIndex;
-        if (type == RF_PRED) {
-          if (RF_frSize > 0) {
-            unsignedIndexTarget = RF_rSize + (uint) signedSignatureIndex;
-          }
-          else {
-            unsignedIndexTarget = (uint) signedSignatureIndex;
+    }
+  }
+  else {
+    if(RF_mPredictorFlag == TRUE) {
+      RF_observation[treeID] = (double **) new_vvector(1, RF_xSize, NRUTIL_DPTR);
+      for (p = 1; p <= RF_xSize; p++) {
+        RF_observation[treeID][p] = RF_observationIn[p];
+      }
+      for (p = 1; p <= RF_mpIndexSize; p++) {
+        if (RF_mpIndex[p] > 0) {
+          RF_observation[treeID][(uint) RF_mpIndex[p]] = dvector(1, RF_observationSize);
+          for (i = 1; i <= RF_observationSize; i++) {
+            RF_observation[treeID][(uint) RF_mpIndex[p]][i] = RF_observationIn[(uint) RF_mpIndex[p]][i];
           }
         }
-        else {
-          unsignedIndexTarget = RF_rSize + (uint) signedSignatureIndex;
-        }
-        valuePtr = RF_observation[treeID][(uint) signedSignatureIndex];
-        imputePtr = predictor[(uint) signedSignatureIndex];
       }
-      localDistributionSize = 0;
-      for (i = 1; i <= repMembrSize; i++) {
-        mPredictorFlag = TRUE;
-        if (RF_mRecordMap[repMembrIndx[i]] == 0) {
-          mPredictorFlag = FALSE;
-        }
-        else if (RF_mpSign[unsignedIndexSource][RF_mRecordMap[repMembrIndx[i]]] == 0) {
-          mPredictorFlag = FALSE;
+    }
+  }
+  if (mode == RF_PRED) {
+    if(vimpShadowFlag == TRUE) {
+      RF_fobservation[treeID] = dmatrix(1, RF_xSize, 1, RF_fobservationSize);
+      for (p = 1; p <= RF_xSize; p++) {
+        for (i = 1; i <= RF_fobservationSize; i++) {
+          RF_fobservation[treeID][p][i] = RF_fobservationIn[p][i];
         }
-        if (mPredictorFlag == FALSE) {
-          localDistributionSize ++;
-          localDistribution[localDistributionSize] = valuePtr[repMembrIndx[i]];
+      }
+    }
+    else {
+      if(RF_fmPredictorFlag == TRUE) {
+        RF_fobservation[treeID] = (double **) new_vvector(1, RF_xSize, NRUTIL_DPTR);
+        for (p = 1; p <= RF_xSize; p++) {
+          RF_fobservation[treeID][p] = RF_fobservationIn[p];
         }
-      }  
-      if (termFlag) {
-        if (localDistributionSize == 0) {
-          for (i = 1; i <= repMembrSize; i++) {
-            mPredictorFlag = TRUE;
-            if (RF_mRecordMap[repMembrIndx[i]] == 0) {
-              mPredictorFlag = FALSE;
-            }
-            else if (RF_mpSign[unsignedIndexSource][RF_mRecordMap[repMembrIndx[i]]] == 0) {
-              mPredictorFlag = FALSE;
-            }
-            if (mPredictorFlag == TRUE) {
-              localDistributionSize ++;
-              localDistribution[localDistributionSize] = valuePtr[repMembrIndx[i]];
+        for (p = 1; p <= RF_fmpIndexSize; p++) {
+          if (RF_fmpIndex[p] > 0) {
+            RF_fobservation[treeID][(uint) RF_fmpIndex[p]] = dvector(1, RF_fobservationSize);
+            for (i = 1; i <= RF_fobservationSize; i++) {
+              RF_fobservation[treeID][(uint) RF_fmpIndex[p]][i] = RF_fobservationIn[(uint) RF_fmpIndex[p]][i];
             }
-          }  
+          }
         }
-        if (localDistributionSize > 0) {
-          if (signedSignatureIndex < 0) {
-            if (strcmp(RF_rType[(uint) abs(signedSignatureIndex)], "T") == 0) {
-              imputedValue = getMeanValue(localDistribution, localDistributionSize);
-              imputedValue = getNearestMasterTime(imputedValue, chainFlag, treeID);
-            }
-            else if (strcmp(RF_rType[(uint) abs(signedSignatureIndex)], "S") == 0) {
-              imputedValue = getMaximalValue(localDistribution, localDistributionSize, chainFlag, treeID);
-            }
-            else if (strcmp(RF_rType[(uint) abs(signedSignatureIndex)], "R") == 0) {
-              imputedValue = getMeanValue(localDistribution, localDistributionSize);
-            }
-            else if (strcmp(RF_rType[(uint) abs(signedSignatureIndex)], "I") == 0) {
-              imputedValue = getMaximalValue(localDistribution, localDistributionSize, chainFlag, treeID);
-            }
-            else if (strcmp(RF_rType[(uint) abs(signedSignatureIndex)], "C") == 0) {
-              imputedValue = getMaximalValue(localDistribution, localDistributionSize, chainFlag, treeID);
-            }
+      }
+    }
+  }  
+}
+void unstackShadow (uint mode, uint treeID, char respFlag, char covrFlag) {
+  char vimpShadowFlag;
+  uint k, p;
+  if (respFlag) {
+    if (RF_opt & OPT_SPLT_NULL) {
+      for (p = 1; p <= RF_rSize; p++) {
+        free_dvector(RF_response[treeID][p], 1, RF_observationSize);
+      }
+      free_new_vvector(RF_response[treeID], 1, RF_rSize, NRUTIL_DPTR);
+      if (RF_timeIndex > 0) {
+        free_uivector(RF_masterTimeIndex[treeID], 1, RF_observationSize);
+      }
+    }
+    else {
+      if (RF_mResponseFlag == TRUE) {
+        for (p = 1; p <= RF_mpIndexSize; p++) {
+          if (RF_mpIndex[p] < 0) {
+            free_dvector(RF_response[treeID][(uint) abs(RF_mpIndex[p])], 1, RF_observationSize);
           }
           else {
-            if (strcmp(RF_xType[(uint) signedSignatureIndex], "R") == 0) {
-              imputedValue = getMeanValue(localDistribution, localDistributionSize);
-            }
-            else {
-              imputedValue = getMaximalValue(localDistribution, localDistributionSize, chainFlag, treeID);
-            }
-          }
-        }  
-        else {
-          if (!(RF_opt & OPT_OUTC_TYPE)) {
-            RFprintf("\nRF-SRC:  *** ERROR *** ");
-            RFprintf("\nRF-SRC:  NULL distribution encountered during imputation in type:  %10d", type);
-            RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-            error("\nRF-SRC:  The application will now exit.\n");
+            p = RF_mpIndexSize;
           }
-          else {
-            imputedValue = NA_REAL;
+        }
+        free_new_vvector(RF_response[treeID], 1, RF_rSize, NRUTIL_DPTR);
+        if (RF_timeIndex > 0) {
+          if (RF_mTimeFlag == TRUE) {
+            free_uivector(RF_masterTimeIndex[treeID], 1, RF_observationSize);
           }
         }
-      }  
-      mvFlag = FALSE;
-      for (i = 1; i <= allMembrSize; i++) {
-        if (mRecordMap[allMembrIndx[i]] > 0) {
-          if(mpSign[unsignedIndexTarget][mRecordMap[allMembrIndx[i]]] == 1) {
-            mvFlag = TRUE;
-            if (localDistributionSize > 0) {
-              if (termFlag) {
-                imputePtr[allMembrIndx[i]] = imputedValue;
-              }
-              else {
-                imputePtr[allMembrIndx[i]] = getSampleValue(localDistribution, localDistributionSize, chainFlag, treeID);
-              }
+      }
+    }
+    if (mode == RF_PRED) {
+      if (RF_frSize > 0) {
+        if (RF_fmResponseFlag == TRUE) {
+          for (p = 1; p <= RF_fmpIndexSize; p++) {
+            if (RF_fmpIndex[p] < 0) {
+              free_dvector(RF_fresponse[treeID][(uint) abs(RF_fmpIndex[p])], 1, RF_fobservationSize);
             }
             else {
+              p = RF_fmpIndexSize;
             }
           }
+          free_new_vvector(RF_fresponse[treeID], 1, RF_rSize, NRUTIL_DPTR);
         }
-      }  
-      if (mvFlag) {
-        glmpIndexPtr[++(*glmpIndexSize)] = glmpIndexParentPtr[p];
-        if (termFlag) {
-          glmpValuePtr[(*glmpIndexSize)] = imputedValue;
+      }
+    }
+    if (RF_rFactorCount + RF_xFactorCount > 0) {
+      if (RF_factorList[treeID] != NULL) {
+        for (k = 1; k <= RF_maxFactorLevel; k++) {
+          if (RF_factorList[treeID][k] != NULL) {
+            free_Factor(RF_factorList[treeID][k]);
+          }
+        }
+        free_new_vvector(RF_factorList[treeID], 1, RF_maxFactorLevel, NRUTIL_FPTR);
+        RF_factorList[treeID] = NULL;
+      }
+    }
+  }
+  if (covrFlag) {
+    vimpShadowFlag = FALSE;
+    if ((RF_opt & OPT_VIMP) && (RF_opt & OPT_VIMP_TYP1) && !(RF_opt & OPT_VIMP_TYP2)) {
+      vimpShadowFlag = TRUE;
+    }
+    if(vimpShadowFlag == TRUE) {
+      free_dmatrix(RF_observation[treeID], 1, RF_xSize, 1, RF_observationSize);
+    }
+    else {
+      if(RF_mPredictorFlag == TRUE) {
+        for (p = 1; p <= RF_mpIndexSize; p++) {
+          if (RF_mpIndex[p] > 0) {
+            free_dvector(RF_observation[treeID][(uint) RF_mpIndex[p]], 1, RF_observationSize);
+          }
+        }
+        free_new_vvector(RF_observation[treeID], 1, RF_xSize, NRUTIL_DPTR);
+      }
+    }
+    if (mode == RF_PRED) {
+      if(vimpShadowFlag == TRUE) {
+        free_dmatrix(RF_fobservation[treeID], 1, RF_xSize, 1, RF_fobservationSize);
+      }
+      else {
+        if(RF_fmPredictorFlag == TRUE) {
+          for (p = 1; p <= RF_fmpIndexSize; p++) {
+            if (RF_fmpIndex[p] > 0) {
+              free_dvector(RF_fobservation[treeID][(uint) RF_fmpIndex[p]], 1, RF_fobservationSize);
+            }
+          }
+          free_new_vvector(RF_fobservation[treeID], 1, RF_xSize, NRUTIL_DPTR);
         }
       }
-    }  
-  }  
-  free_dvector(localDistribution, 1, repMembrSize + 1);
-  if (!termFlag) {
-    if((nodePtr -> parent) == NULL) {
-      free_uivector(glmpIndexParentPtr, 1, mpIndexSize);
     }
   }
-  else {
-    free_uivector(glmpIndexParentPtr, 1, mpIndexSize);
+}
+char xferMissingness(uint mode, Node *source, Terminal *destination) {
+  uint   *sourceIndexPtr;
+  double *sourceValuePtr;
+  uint   *sourceAllocSizePtr;
+  uint   *sourceActualSizePtr;
+  char result;
+  char xferFlag;
+  sourceIndexPtr = NULL;  
+  sourceValuePtr = NULL;  
+  sourceAllocSizePtr = NULL;  
+  sourceActualSizePtr = NULL;  
+  result = FALSE;
+  if (mode != RF_PRED) {
+    if (RF_mRecordSize > 0) {
+      result = TRUE;
+      sourceIndexPtr = source -> lmpIndex;
+      sourceValuePtr = source -> lmpValue;
+      sourceAllocSizePtr = & (source -> lmpIndexAllocSize);
+      sourceActualSizePtr = & (source -> lmpIndexActualSize);
+    }
   }
-  if((nodePtr -> parent) != NULL) {
-    if( ((((nodePtr -> parent) -> left) -> imputed) == TRUE) && ((((nodePtr -> parent) -> right) -> imputed) == TRUE) ) {
-      switch (type) {
-      case RF_PRED:
-        unstackNodeFLMPIndex(nodePtr -> parent);
-        break;
-      default:
-        unstackNodeLMPIndex(nodePtr -> parent);
-        break;
-      }
+  else {
+    if (RF_fmRecordSize > 0) {
+      result = TRUE;
+      sourceIndexPtr = source -> flmpIndex;
+      sourceValuePtr = source -> flmpValue;
+      sourceAllocSizePtr = & (source -> flmpIndexAllocSize);
+      sourceActualSizePtr = & (source -> flmpIndexActualSize);
     }
   }
-  return TRUE;
-}  
-char restoreNodeMembership(uint  r,
-                           uint  mode,
-                           char  rootFlag,
-                           uint  treeID,
-                           Node *parent,
-                           uint *repMembrIndx,
-                           uint  repMembrSize,
-                           uint *allMembrIndx,
-                           uint  allMembrSize,
-                           uint *ngAllMembrIndx,
-                           uint  ngAllMembrSize,
-                           uint *bootMembrIndxIter) {
+  if (result == FALSE) {
+    RFprintf("\nRF-SRC:  *** ERROR *** ");
+    RFprintf("\nRF-SRC:  Attempt to update forest impute data with no missingness in mode:  %10d", mode);
+    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+    error("\nRF-SRC:  The application will now exit.\n");
+  }
+  if (*sourceActualSizePtr > 0) {
+    (destination -> lmiIndex) = sourceIndexPtr;
+    (destination -> lmiValue) = sourceValuePtr;
+    (destination -> lmiSize)  = *sourceActualSizePtr;
+    (destination -> lmiAllocSize)  = *sourceAllocSizePtr;    
+    sourceIndexPtr = NULL;
+    sourceValuePtr = NULL;
+    *sourceAllocSizePtr  = 0;
+    *sourceActualSizePtr  = 0;
+    xferFlag = TRUE;
+  }
+  else {
+    xferFlag = FALSE;
+  }
+  return xferFlag;
+}
+char getMarginalNodeMembership(uint     mode,
+                               char     rootFlag,
+                               uint     treeID,
+                               Node    *parent,
+                               uint    *allMembrIndx,
+                               uint     allMembrSize,
+                               double **observationPtr) {
   char  bootResult;
   char leftResult, rghtResult;
   char terminalFlag;
-  char bsUpdateFlag;
-  uint *bootMembrIndx;
-  uint *leftRepMembrIndx;
-  uint *rghtRepMembrIndx;
   uint *leftAllMembrIndx;
   uint *rghtAllMembrIndx;
-  uint *ngLeftAllMembrIndx;  
-  uint *ngRghtAllMembrIndx;  
-  uint bootMembrSize;
-  uint leftRepMembrSize, rghtRepMembrSize;
-  uint leftAllMembrSize, ngLeftAllMembrSize;
-  uint rghtAllMembrSize, ngRghtAllMembrSize;
+  uint leftAllMembrSize;
+  uint rghtAllMembrSize;
   uint jLeft;
   uint jRght;
   char factorFlag;
   char daughterFlag;
-  uint i;
+  uint obsSize;
+  uint i, j;
   factorFlag = FALSE; 
-  bootResult = TRUE;
   terminalFlag = TRUE;
-  bsUpdateFlag = FALSE;
- if (rootFlag | (RF_opt & OPT_BOOT_NODE)) {
-    if (!(RF_opt & OPT_BOOT_NONE) && !(RF_opt & OPT_BOOT_NODE)) {
-      bootMembrIndx  = uivector(1, RF_bootstrapSize);
-      bootMembrSize = RF_bootstrapSize;
-    }
-    else {
-      bootMembrIndx  = uivector(1, allMembrSize);
-      bootMembrSize = allMembrSize;
-    }
-    bootResult = bootstrap (mode,
-                            treeID,
-                            parent,
-                            allMembrIndx,
-                            allMembrSize,
-                            bootMembrIndx,
-                            bootMembrSize);
-    if (rootFlag & bootResult) {
-      if (!(RF_opt & OPT_BOOT_NODE)) {
-        bsUpdateFlag = TRUE;
-      }
-      repMembrIndx = bootMembrIndx;
-      repMembrSize = bootMembrSize;
-    }
+  if (mode != RF_PRED) {
+    obsSize = RF_observationSize;
   }
   else {
-    bootMembrIndx = repMembrIndx;
-    bootMembrSize = repMembrSize;
-    parent -> mpSign = (parent -> parent) -> mpSign;
-    parent -> fmpSign = (parent -> parent) -> fmpSign;
+    obsSize = RF_fobservationSize;
   }
-  if (bootResult) {
-    if (RF_mRecordSize > 0) {
-      imputeNode(RF_GROW,
-                 FALSE,
-                 TRUE,
-                 treeID,
-                 parent,
-                 bootMembrIndx,
-                 bootMembrSize,
-                 allMembrIndx,
-                 allMembrSize);
-      if (RF_timeIndex > 0) {
-        if (RF_mTimeFlag == TRUE) {
-          updateTimeIndexArray(treeID,
-                               allMembrIndx,
-                               allMembrSize,
-                               RF_time[treeID],
-                               FALSE,
-                               FALSE,
-                               RF_masterTimeIndex[treeID]);
-        }
-      }
-    }
-    switch (mode) {
-    case RF_PRED:
-      if (RF_fmRecordSize > 0) {
-        imputeNode(RF_PRED,
-                   FALSE,
-                   FALSE,
-                   treeID,
-                   parent,
-                   bootMembrIndx,
-                   bootMembrSize,
-                   ngAllMembrIndx,
-                   ngAllMembrSize);
-      }
-      break;
-    default:
-      break;
-    }
-  }  
-  if (bootResult) {
-    if (RF_opt & OPT_NODE_STAT) {
-      if (RF_ptnCount == 0) {
-        if (((RF_timeIndex > 0) && (RF_statusIndex > 0)) || (RF_rSize == 0)) {
-          parent -> variance = NA_REAL;
-        }
-        else {
-          getVariance(repMembrSize, repMembrIndx, 0, NULL, RF_response[treeID][1], NULL, & (parent -> variance));
-        }
-      }
-    }
-    if (((parent -> left) != NULL) && ((parent -> right) != NULL)) {
-      terminalFlag = FALSE;
-      leftAllMembrIndx = rghtAllMembrIndx = NULL;
-      leftAllMembrSize = rghtAllMembrSize = 0;
-      leftRepMembrIndx = rghtRepMembrIndx = NULL;
-      leftRepMembrSize = rghtRepMembrSize = 0;
-      if (getRestoreNodeMembershipGrowFlag(mode)) {
-      }
-      else {
-        uint *membershipIndicator = uivector(1, RF_observationSize);
-        leftAllMembrSize = rghtAllMembrSize = 0;
-        factorFlag = FALSE;
-        if (strcmp(RF_xType[parent -> splitParameter], "C") == 0) {
-          factorFlag = TRUE;
-        }
-        for (i = 1; i <= allMembrSize; i++) {
-          daughterFlag = RIGHT;
-          if (factorFlag == TRUE) {
-            daughterFlag = splitOnFactor((uint) RF_observation[treeID][parent -> splitParameter][allMembrIndx[i]], parent -> splitValueFactPtr);
-          }
-          else {
-            if ( RF_observation[treeID][parent -> splitParameter][allMembrIndx[i]] <= (parent -> splitValueCont) ) {
-              daughterFlag = LEFT;
-            }
-          }
-          membershipIndicator[allMembrIndx[i]] = daughterFlag;
-          if (daughterFlag == LEFT) {
-            leftAllMembrSize ++;
-            RF_tNodeMembership[treeID][allMembrIndx[i]] = parent -> left;
-          }
-          else {
-            rghtAllMembrSize ++;
-            RF_tNodeMembership[treeID][allMembrIndx[i]] = parent -> right;
-          }
-        }  
-        leftAllMembrIndx  = uivector(1, leftAllMembrSize + 1);
-        rghtAllMembrIndx  = uivector(1, rghtAllMembrSize + 1);
-        jLeft = jRght = 0;
-        for (i = 1; i <= allMembrSize; i++) {
-          if (membershipIndicator[allMembrIndx[i]] == LEFT) {
-            leftAllMembrIndx[++jLeft] = allMembrIndx[i];
-          }
-          else {
-            rghtAllMembrIndx[++jRght] = allMembrIndx[i];
-          }
-        }
-        if (RF_opt & OPT_BOOT_NODE) {
-          leftRepMembrIndx = leftAllMembrIndx;
-          leftRepMembrSize = leftAllMembrSize;
-          rghtRepMembrIndx = rghtAllMembrIndx;
-          rghtRepMembrSize = rghtAllMembrSize;
-        }
-        else {
-          leftRepMembrIndx  = uivector(1, bootMembrSize + 1);
-          rghtRepMembrIndx  = uivector(1, bootMembrSize + 1);
-          leftRepMembrSize = rghtRepMembrSize = 0;
-          for (i = 1; i <= bootMembrSize; i++) {
-            if (membershipIndicator[bootMembrIndx[i]] == LEFT) {
-              leftRepMembrIndx[++leftRepMembrSize] = bootMembrIndx[i];
-            }
-            else {
-              rghtRepMembrIndx[++rghtRepMembrSize] = bootMembrIndx[i];
-            }
-          }
+  if (RF_tLeafCount[treeID] > 0) {
+    bootResult = TRUE;
+    if (((parent -> left) != NULL) && ((parent -> right) != NULL)) {
+      terminalFlag = FALSE;
+      leftAllMembrIndx = rghtAllMembrIndx = NULL;
+      leftAllMembrSize = rghtAllMembrSize = 0;
+      uint *membershipIndicator = uivector(1, obsSize);
+      leftAllMembrSize = rghtAllMembrSize = 0;
+      daughterFlag = RIGHT;
+      if (daughterFlag != NEITHER) {
+        factorFlag = FALSE;
+        if (RF_xFactorSplitFlag[parent -> splitParameter]) {
+          factorFlag = TRUE;
         }
-        free_uivector(membershipIndicator, 1, RF_observationSize);
-      }  
-      ngLeftAllMembrIndx = ngRghtAllMembrIndx = NULL;
-      ngLeftAllMembrSize = ngRghtAllMembrSize = 0;
-      if (mode == RF_PRED) {
-        uint *ngMembershipIndicator = uivector(1, RF_fobservationSize);
-        for (i=1; i <= ngAllMembrSize; i++) {
+        for (i = 1; i <= allMembrSize; i++) {
           daughterFlag = RIGHT;
           if (factorFlag == TRUE) {
-            daughterFlag = splitOnFactor((uint) RF_fobservation[treeID][parent -> splitParameter][ngAllMembrIndx[i]], parent -> splitValueFactPtr);
+            daughterFlag = splitOnFactor((uint) observationPtr[parent -> splitParameter][allMembrIndx[i]], parent -> splitValueFactPtr);
           }
           else {
-            if ( RF_fobservation[treeID][parent -> splitParameter][ngAllMembrIndx[i]] <= (parent -> splitValueCont) ) {
+            if ( observationPtr[parent -> splitParameter][allMembrIndx[i]] <= (parent -> splitValueCont) ) {
               daughterFlag = LEFT;
             }
           }
+          membershipIndicator[allMembrIndx[i]] = daughterFlag;
           if (daughterFlag == LEFT) {
-            ngMembershipIndicator[ngAllMembrIndx[i]] = LEFT;
-            ngLeftAllMembrSize ++;
-            RF_ftNodeMembership[treeID][ngAllMembrIndx[i]] = parent -> left;
+            leftAllMembrSize ++;
           }
           else {
-            ngMembershipIndicator[ngAllMembrIndx[i]] = RIGHT;
-            ngRghtAllMembrSize ++;
-            RF_ftNodeMembership[treeID][ngAllMembrIndx[i]] = parent -> right;
+            rghtAllMembrSize ++;
           }
         }  
-        ngLeftAllMembrIndx  = uivector(1, ngLeftAllMembrSize + 1);
-        ngRghtAllMembrIndx  = uivector(1, ngRghtAllMembrSize + 1);
-        jLeft = jRght = 0;
-        for (i = 1; i <= ngAllMembrSize; i++) {
-          if (ngMembershipIndicator[ngAllMembrIndx[i]] == LEFT) {
-            ngLeftAllMembrIndx[++jLeft] = ngAllMembrIndx[i];
+      }  
+      leftAllMembrIndx  = uivector(1, leftAllMembrSize + 1);
+      rghtAllMembrIndx  = uivector(1, rghtAllMembrSize + 1);
+      jLeft = jRght = 0;
+      if (daughterFlag == NEITHER) {
+        for (i = 1; i <= allMembrSize; i++) {
+          leftAllMembrIndx[++jLeft] = allMembrIndx[i];
+          rghtAllMembrIndx[++jRght] = allMembrIndx[i];
+        }
+      }
+      else {
+        for (i = 1; i <= allMembrSize; i++) {
+          if (membershipIndicator[allMembrIndx[i]] == LEFT) {
+            leftAllMembrIndx[++jLeft] = allMembrIndx[i];
           }
           else {
-            ngRghtAllMembrIndx[++jRght] = ngAllMembrIndx[i];
+            rghtAllMembrIndx[++jRght] = allMembrIndx[i];
           }
         }
-        free_uivector(ngMembershipIndicator, 1, RF_fobservationSize);
-      }  
-      leftResult = restoreNodeMembership(r,
-                                         mode,
-                                         FALSE,
-                                         treeID,
-                                         parent -> left,
-                                         leftRepMembrIndx,
-                                         leftRepMembrSize,
-                                         leftAllMembrIndx,
-                                         leftAllMembrSize,
-                                         ngLeftAllMembrIndx,
-                                         ngLeftAllMembrSize,
-                                         bootMembrIndxIter);
+      }
+      free_uivector(membershipIndicator, 1, obsSize);
+      leftResult = getMarginalNodeMembership(mode,
+                                             FALSE,
+                                             treeID,
+                                             parent -> left,
+                                             leftAllMembrIndx,
+                                             leftAllMembrSize,
+                                             observationPtr);
       if(!leftResult) {
       }
-      rghtResult = restoreNodeMembership(r,
-                                         mode,
-                                         FALSE,
-                                         treeID,
-                                         parent -> right,
-                                         rghtRepMembrIndx,
-                                         rghtRepMembrSize,
-                                         rghtAllMembrIndx,
-                                         rghtAllMembrSize,
-                                         ngRghtAllMembrIndx,
-                                         ngRghtAllMembrSize,
-                                         bootMembrIndxIter);
+      rghtResult = getMarginalNodeMembership(mode,
+                                             FALSE,
+                                             treeID,
+                                             parent -> right,
+                                             rghtAllMembrIndx,
+                                             rghtAllMembrSize,
+                                             observationPtr);
       if(!rghtResult) {
       }
-      if (getRestoreNodeMembershipGrowFlag(mode)) {
-      }
-      else {
-        free_uivector(leftAllMembrIndx, 1, leftAllMembrSize + 1);
-        free_uivector(rghtAllMembrIndx, 1, rghtAllMembrSize + 1);
-        if (RF_opt & OPT_BOOT_NODE) {
-        }
-        else {
-          free_uivector(leftRepMembrIndx, 1, bootMembrSize + 1);
-          free_uivector(rghtRepMembrIndx, 1, bootMembrSize + 1);
-        }
-      }
-      if (mode == RF_PRED) {
-        free_uivector(ngLeftAllMembrIndx, 1, ngLeftAllMembrSize + 1);
-        free_uivector(ngRghtAllMembrIndx, 1, ngRghtAllMembrSize + 1);
-      }
+      free_uivector(leftAllMembrIndx, 1, leftAllMembrSize + 1);
+      free_uivector(rghtAllMembrIndx, 1, rghtAllMembrSize + 1);
     }  
     else {
     }
   }  
   else {
     if (rootFlag) {
-      if (!bootResult) {
-        terminalFlag = FALSE;
-      }
+      bootResult = FALSE;
+      terminalFlag = FALSE;
     }
-  }   
+  }
   if (terminalFlag) {
-    parent -> pseudoTerminal = TRUE;
-    imputeNodeAndSummarize(r,
-                           mode,
-                           treeID,
-                           parent,
-                           bootMembrIndx,
-                           bootMembrSize,
-                           allMembrIndx,
-                           allMembrSize,
-                           ngAllMembrIndx,
-                           ngAllMembrSize);
-    if (r == RF_nImpute) {
-      if (getRestoreNodeMembershipGrowFlag(mode)) {
+    for (i = 1; i <= allMembrSize; i++) {
+      RF_utTermMembership[treeID][allMembrIndx[i]][++ RF_utTermMembershipCount[treeID][allMembrIndx[i]]] = (parent -> nodeID);
+      if ((RF_utTermMembershipCount[treeID][allMembrIndx[i]]) == (RF_utTermMembershipAlloc[treeID][allMembrIndx[i]] * MARGINAL_SIZE)) {
+        RF_utTermMembershipAlloc[treeID][allMembrIndx[i]] ++;
+        uint *utTermMembershipNew = uivector(1, RF_utTermMembershipAlloc[treeID][allMembrIndx[i]] * MARGINAL_SIZE);
+        for (j = 1; j <= RF_utTermMembershipCount[treeID][allMembrIndx[i]]; j++) {
+          utTermMembershipNew[j] = RF_utTermMembership[treeID][allMembrIndx[i]][j];
+        }
+        free_uivector(RF_utTermMembership[treeID][allMembrIndx[i]], 1, (RF_utTermMembershipAlloc[treeID][allMembrIndx[i]] - 1) * MARGINAL_SIZE);
+        RF_utTermMembership[treeID][allMembrIndx[i]] = utTermMembershipNew;
       }
-      else {
-        if ((RF_opt & OPT_PERF) |
-            (RF_opt & OPT_PERF_CALB) |
-            (RF_opt & OPT_OENS) |
-            (RF_opt & OPT_FENS)) {
-          updateTerminalNodeOutcomesNew(treeID,
-                                        RF_tTermList[treeID][parent -> nodeID],
-                                        bootMembrIndx,
-                                        bootMembrSize,
-                                        allMembrIndx,
-                                        allMembrSize);
+    }
+  }  
+  return bootResult;
+}
+void acquireTree(uint mode, uint r, uint b) {
+  Node  *rootPtr;
+  uint **mwcpPtrPtr;
+  uint   nodeOffset;
+  char multImpFlag;
+  uint *allMembrIndx;
+  uint *fallMembrIndx;
+  uint bootMembrIndxIter;
+  char  result;
+  Node     ***gNodeMembership;
+  Terminal ***gTermMembership;
+  uint     obsSize;
+  char     terminalFlag;
+  uint i;
+  obsSize    = 0;  
+  gNodeMembership = NULL;  
+  gTermMembership = NULL;  
+  multImpFlag = FALSE;
+  terminalFlag = getPredictTerminalFlag(mode);
+  if (mode == RF_GROW) {
+    if (r > 1) {
+      multImpFlag = TRUE;
+    }
+  }
+#ifdef _OPENMP
+#endif
+  bindDataReplica(b);
+  stackArena(mode);
+  rootPtr = makeNode((mode == RF_GROW) ? RF_xSize : 0,
+                     (mode == RF_GROW) ? 0 : 0,
+                     (RF_opt & OPT_USPV_STAT) ? RF_randomResponseCount : 0,  
+                     (mode == RF_GROW) ? ( (RF_opt & OPT_NODE_STAT) ? RF_randomCovariateCount : 0)  : 0);  
+  if (terminalFlag) {
+    RF_tNodeMembership[b] = NULL;
+    RF_bootMembershipIndex[b] = NULL;
+    RF_bootMembershipFlag[b] = NULL;
+    RF_bootMembershipCount[b] = NULL;
+    RF_oobMembershipFlag[b] = NULL;
+    RF_ibgMembershipIndex[b] = NULL;
+    RF_oobMembershipIndex[b] = NULL;
+    allMembrIndx = NULL;
+  }
+  else {
+    RF_tNodeMembership[b] = (Node **) new_vvector(1, RF_observationSize, NRUTIL_NPTR);
+    RF_bootMembershipIndex[b] = uivector(1, RF_bootstrapSize);
+    RF_bootMembershipFlag[b] = cvector(1, RF_observationSize);
+    RF_bootMembershipCount[b] = uivector(1, RF_observationSize);
+    RF_oobMembershipFlag[b] = cvector(1, RF_observationSize);
+    RF_ibgMembershipIndex[b] = uivector(1, RF_observationSize);
+    RF_oobMembershipIndex[b] = uivector(1, RF_observationSize);
+    allMembrIndx = uivector(1, RF_observationSize);
+  }
+  if (mode == RF_PRED) {
+    RF_ftNodeMembership[b] = (Node **) new_vvector(1, RF_fobservationSize, NRUTIL_NPTR);
+  }
+  if (mode != RF_PRED) {
+    obsSize = RF_observationSize;
+    gNodeMembership = RF_tNodeMembership;
+    gTermMembership = RF_tTermMembership;
+  }
+  else {
+    obsSize = RF_fobservationSize;
+    gNodeMembership = RF_ftNodeMembership;
+    gTermMembership = RF_ftTermMembership;
+  }
+  if (mode == RF_PRED) {
+    fallMembrIndx = uivector(1, RF_fobservationSize);
+  }
+  else {
+    fallMembrIndx = NULL;
+  }
+  if (RF_ptnCount > 0) {
+    RF_pNodeMembership[b] = (Node **) new_vvector(1, obsSize, NRUTIL_NPTR);
+  }
+  stackShadow(mode, b);
+  if (mode == RF_GROW) {
+    if (RF_nImpute > 1) {
+      if (r > 1) {
+        if (RF_mRecordSize > 0) {
+          imputeUpdateShadow(RF_GROW,
+                             RF_response[b],
+                             RF_observation[b]);
+        }
+        if (RF_timeIndex > 0) {
+          if (RF_mTimeFlag == TRUE) {
+            updateTimeIndexArray(0,
+                                 NULL,
+                                 RF_observationSize,
+                                 RF_time[b],
+                                 FALSE,
+                                 FALSE,
+                                 RF_masterTimeIndex[b]);
+          }
         }
       }
     }
-    if (RF_opt & OPT_BOOT_NODE) {
-      bsUpdateFlag = TRUE;
+  }
+  rootPtr -> parent = NULL;
+  rootPtr -> nodeID = 1;
+  RF_root[b] = rootPtr;
+  RF_maxDepth[b] = 0;
+  bootMembrIndxIter = 0;
+  if (!terminalFlag) {
+    for (i = 1; i <= RF_observationSize; i++) {
+      allMembrIndx[i] = i;
+      RF_tNodeMembership[b][i] = RF_root[b];
+      RF_bootMembershipFlag[b][i]  = FALSE;
+      RF_bootMembershipCount[b][i] = 0;
+      RF_oobMembershipFlag[b][i]   = TRUE;
+    }
+  }
+  if (RF_ptnCount > 0) {
+    for (i = 1; i <= obsSize; i++) {
+      RF_pNodeMembership[b][i] = gNodeMembership[b][i];
+    }
+  }
+  RF_orderedLeafCount[b] = 0;
+  if (mode == RF_GROW) {
+    RF_tLeafCount[b] = 0;
+    stackNodeAndTermList(b, 0);
+    if (RF_timeIndex > 0) {
+      stackSplitEventScratch(b);
+    }
+    result = growTree (r,
+                       TRUE,
+                       multImpFlag,
+                       b,
+                       rootPtr,
+                       NULL,
+                       0,
+                       allMembrIndx,
+                       RF_observationSize,
+                       0,
+                       RF_maxDepth + b,
+                       & bootMembrIndxIter);
+    if (RF_timeIndex > 0) {
+      unstackSplitEventScratch(b);
+    }
+    if (result) {
     }
   }  
-  if (bsUpdateFlag) {
-    for (i = 1; i <= bootMembrSize; i++) {
-      RF_bootMembershipIndex[treeID][++(*bootMembrIndxIter)] = bootMembrIndx[i];
-      RF_bootMembershipFlag[treeID][bootMembrIndx[i]] = TRUE;
-      RF_oobMembershipFlag[treeID][bootMembrIndx[i]]  = FALSE;
-      RF_bootMembershipCount[treeID][bootMembrIndx[i]] ++;
+  else {
+    if (mode == RF_PRED) {
+      for (i=1; i <= RF_fobservationSize; i++) {
+        fallMembrIndx[i] = i;
+        RF_ftNodeMembership[b][i] = RF_root[b];
+      }
     }
-  }
-  if (rootFlag | (RF_opt & OPT_BOOT_NODE)) {
-    if (!(RF_opt & OPT_BOOT_NONE) && !(RF_opt & OPT_BOOT_NODE)) {
-      free_uivector(bootMembrIndx, 1, RF_bootstrapSize);
+    nodeOffset = RF_restoreTreeOffset[b];
+    mwcpPtrPtr = & RF_mwcpPtr[b];
+    if (RF_tLeafCount[b] > 0) {
+      stackNodeAndTermList(b, RF_tLeafCount[b]);
+    }
+    restoreTree(mode,
+                b,
+                rootPtr,
+                & nodeOffset,
+                RF_treeID_,
+                RF_nodeID_,
+                RF_parmID_,
+                RF_contPT_,
+                RF_mwcpSZ_,
+                mwcpPtrPtr,
+                0,
+                RF_maxDepth + b);
+    if (terminalFlag) {
+      result = (RF_tLeafCount[b] > 0) ? TRUE : FALSE;
     }
     else {
-      free_uivector(bootMembrIndx, 1, allMembrSize);
+      result = restoreNodeMembership(r,
+                                     mode,
+                                     TRUE,
+                                     b,
+                                     rootPtr,
+                                     NULL,
+                                     0,
+                                     allMembrIndx,
+                                     RF_observationSize,
+                                     fallMembrIndx,
+                                     RF_fobservationSize,
+                                     & bootMembrIndxIter);
     }
-  }
-  return bootResult;
-}  
-void imputeNodeAndSummarize(uint     r,
-                            uint     mode,
-                            uint     treeID,
-                            Node    *parent,
-                            uint    *repMembrIndx,
-                            uint     repMembrSize,
-                            uint    *allMembrIndx,
-                            uint     allMembrSize,
-                            uint    *ngAllMembrIndx,
-                            uint     ngAllMembrSize) {
-  uint multImpFlag;
-  if (r == 1) {
-    if (RF_mRecordSize > 0) {
-      unstackNodeLMPIndex(RF_tNodeList[treeID][parent -> nodeID]);
-      imputeNode(RF_GROW, 
-                 TRUE,    
-                 TRUE,    
-                 treeID,
-                 parent,
-                 repMembrIndx,
-                 repMembrSize,
-                 allMembrIndx,
-                 allMembrSize);
-      if (mode != RF_PRED) {
-        xferMissingness(RF_GROW, RF_tNodeList[treeID][parent -> nodeID], RF_tTermList[treeID][parent -> nodeID]);
+    if (result) {
+      if (getRestoreNodeMembershipGrowFlag(mode) && !terminalFlag) {
+        restoreNodeMembershipGrow(b);
       }
-    }
-    if (mode == RF_PRED) {
-      if (RF_fmRecordSize > 0) {
-        unstackNodeFLMPIndex(RF_tNodeList[treeID][parent -> nodeID]);
-        imputeNode(RF_PRED, 
-                   TRUE,    
-                   FALSE,   
-                   treeID,
-                   parent,
-                   repMembrIndx,
-                   repMembrSize,
-                   ngAllMembrIndx,
-                   ngAllMembrSize);
-        xferMissingness(RF_PRED, RF_tNodeList[treeID][parent -> nodeID], RF_tTermList[treeID][parent -> nodeID]);
+      if (RF_flatForest != NULL) {
+        restoreFlatMembership(b);
       }
     }
-  }
-  else {
-    if (mode == RF_GROW) {
-      multImpFlag = FALSE;
-      if (r < RF_nImpute) {
-        multImpFlag = TRUE;
+  }  
+  if (result) {
+    stackAndInitTermMembership(mode, b);
+  }  
+  if (result) {
+    if (RF_ptnCount > 0) {
+      for (i = 1; i <= obsSize; i++) {
+        RF_pNodeMembership[b][i] = gNodeMembership[b][i];
       }
-      else {
-        if (RF_opt & OPT_IMPU_ONLY) {
-          multImpFlag = TRUE;
+      RF_pLeafCount[b] = pruneTree(obsSize, b, RF_ptnCount);
+      RF_pNodeList[b] = (Node **) new_vvector(1, RF_pLeafCount[b] + 1, NRUTIL_NPTR);
+      i = 0;
+      getPTNodeList(RF_root[b], RF_pNodeList[b], &i);
+      free_new_vvector(RF_pNodeList[b], 1, RF_pLeafCount[b] + 1, NRUTIL_NPTR);
+    }
+    RF_oobSize[b] = 0;
+    RF_ibgSize[b] = 0;
+    if (!terminalFlag) {
+      for (i=1; i <= RF_observationSize; i++) {
+        if (RF_bootMembershipFlag[b][i] == FALSE) {
+          RF_oobSize[b] ++;
+          RF_oobMembershipIndex[b][RF_oobSize[b]] = i;
         }
-      }
-      if (multImpFlag) {
-        if (RF_mRecordSize > 0) {
-          imputeNode(RF_GROW, 
-                     TRUE,    
-                     FALSE,   
-                     treeID,
-                     parent,
-                     repMembrIndx,
-                     repMembrSize,
-                     allMembrIndx,
-                     allMembrSize);
-          xferMissingness(RF_GROW, RF_tNodeList[treeID][parent -> nodeID], RF_tTermList[treeID][parent -> nodeID]);
+        else {
+          RF_ibgSize[b] ++;
+          RF_ibgMembershipIndex[b][RF_ibgSize[b]] = i;
         }
       }
     }
-  }
-}
-void imputeUpdateShadow (uint      mode,
-                         double  **shadowResponse,
-                         double  **shadowPredictor) {
-  uint     mRecordSize;
-  uint    *mRecordIndex;
-  uint     mpIndexSize;
-  int    **mpSign;
-  int     *mpIndex;
-  double **outResponse;
-  double **outPredictor;
-  double  *valuePtr;
-  double  *outputPtr;
-  uint unsignedIndex;
-  char outcomeFlag, predictorFlag;
-  uint rspSize;
-  uint i, p;
-  mRecordSize  = 0;     
-  mRecordIndex = NULL;  
-  mpIndexSize  = 0;     
-  mpSign       = NULL;  
-  mpIndex      = NULL;  
-  outResponse  = NULL;  
-  outPredictor = NULL;  
-  valuePtr     = NULL;  
-  outputPtr    = NULL;  
-  unsignedIndex = 0;    
-  switch (mode) {
-  case RF_PRED:
-    mRecordSize = RF_fmRecordSize;
-    mRecordIndex = RF_fmRecordIndex;
-    mpIndexSize = RF_fmpIndexSize;
-    mpSign = RF_fmpSign;
-    mpIndex = RF_fmpIndex;
-    if (shadowResponse != NULL) {
-      outResponse  = RF_sImputeResponsePtr;
-    }
-    if (shadowPredictor != NULL) {
-      outPredictor = RF_sImputePredictorPtr;
+    if (mode != RF_PRED) {
+      if (RF_mRecordSize > 0) {
+        for (i = 1; i <= RF_mRecordSize; i++) {
+          if (RF_bootMembershipFlag[b][RF_mRecordIndex[i]] == TRUE) {
+            RF_dmRecordBootFlag[b][i] = TRUE;
+          }
+          else {
+            RF_dmRecordBootFlag[b][i] = FALSE;
+          }
+        }
+      }  
+    }  
+    if (mode == RF_REST) {
+      if(RF_sobservationSize > 0) {
+        RF_soobSize[b] = 0;
+        for (i = 1; i <= RF_sobservationSize; i++) {
+          if (RF_bootMembershipFlag[b][RF_sobservationIndv[i]] == FALSE) {
+            RF_soobSize[b] ++;
+          }
+        }
+      }
     }
-    rspSize = RF_frSize;
-    break;
-  default:
-    mRecordSize = RF_mRecordSize;
-    mRecordIndex = RF_mRecordIndex;
-    mpIndexSize = RF_mpIndexSize;
-    mpSign = RF_mpSign;
-    mpIndex = RF_mpIndex;
-    if (shadowResponse != NULL) {
-      outResponse  = RF_sImputeResponsePtr;
+  }  
+  if (result) {
+    if (RF_opt & OPT_MEMB) {
+      for (i=1; i <= obsSize; i++) {
+        RF_tTermMembershipIndexPtr[b][i] = gTermMembership[b][i] -> nodeID;
+        if (RF_ptnCount > 0) {
+          RF_pNodeMembershipIndexPtr[b][i] = RF_pNodeMembership[b][i] -> nodeID;
+        }
+      }
     }
-    if (shadowPredictor != NULL) {
-      outPredictor = RF_sImputePredictorPtr;
+    else if (RF_opt & OPT_PROX) {
+      for (i=1; i <= obsSize; i++) {
+        RF_tTermMembershipIndexPtr[b][i] = gTermMembership[b][i] -> nodeID;
+      }
     }
-    rspSize = RF_rSize;
-    break;
-  }
-  if (mRecordSize == 0) {
-    RFprintf("\nRF-SRC:  *** ERROR *** ");
-    RFprintf("\nRF-SRC:  Attempt to update shadow data with no missingness in mode:  %10d", mode);
-    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-    error("\nRF-SRC:  The application will now exit.\n");
-  }
-  for (p = 1; p <= mpIndexSize; p++) {
-    if (mpIndex[p] < 0) {
-      if (shadowResponse != NULL) {
-        unsignedIndex = (uint) abs(mpIndex[p]);
-        valuePtr = shadowResponse[(uint) abs(mpIndex[p])];
-        outputPtr = outResponse[(uint) abs(mpIndex[p])];
-        outcomeFlag = TRUE;
+    if (r == RF_nImpute) {
+      if ((RF_opt & OPT_PERF) |
+          (RF_opt & OPT_PERF_CALB) |
+          (RF_opt & OPT_OENS) |
+          (RF_opt & OPT_FENS)) {
+        updateEnsembleCalculations(multImpFlag, mode, b);
       }
-      else {
-        outcomeFlag = FALSE;
+      if (RF_opt & (OPT_SPLDPTH_F | OPT_SPLDPTH_T)) {
+#ifdef _OPENMP
+#pragma omp critical (_update_splitdepth)
+#endif
+        { 
+          updateSplitDepth(b, RF_root[b], RF_maxDepth[b]);
+        }
       }
-      predictorFlag = FALSE;
-    }
-    else {
-      if (shadowPredictor != NULL) {
-        unsignedIndex = (uint) mpIndex[p] + rspSize;
-        valuePtr = shadowPredictor[(uint) mpIndex[p]];
-        outputPtr = outPredictor[(uint) mpIndex[p]];
-        predictorFlag = TRUE;
+      if (RF_opt & OPT_VUSE) {
+        getVariablesUsed(b, RF_root[b], RF_varUsedPtr[b]);
       }
-      else {
-        predictorFlag = FALSE;
+      if (RF_opt & OPT_VIMP) {
+        uint vimpCount;
+        if (RF_opt & OPT_VIMP_JOIN) {
+          vimpCount = 1;
+        }
+        else {
+          vimpCount = RF_intrPredictorSize;
+        }
+        for (uint intrIndex = 1; intrIndex <= vimpCount; intrIndex++) {
+          uint pp;
+          if (!(RF_opt & OPT_VIMP_JOIN)) {
+          pp = RF_intrPredictor[intrIndex];
+          }
+          else {
+            pp = 0;
+          }
+          stackVimpMembership(mode, & RF_vimpMembership[intrIndex][b]);
+          getVimpMembership(mode, b, RF_vimpMembership[intrIndex][b], pp);
+          updateVimpCalculations(mode, b, intrIndex, RF_vimpMembership[intrIndex][b]);
+          unstackVimpMembership(mode, RF_vimpMembership[intrIndex][b]);
+        }
       }
-      outcomeFlag = FALSE;
-    }
-    if ( (outcomeFlag && (shadowResponse != NULL))  || (predictorFlag && (shadowPredictor != NULL)) ) {
-      for (i = 1; i <= mRecordSize; i++) {
-        if (mpSign[unsignedIndex][i] == 1) {
-          if (ISNA(outputPtr[i])) {
+      if (RF_opt & OPT_PROX) {
+        updateProximity(mode, b);
+      }
+      if (mode == RF_GROW) {
+        if (RF_opt & OPT_TREE) {
+          if (RF_optHigh & OPT_TERM) {
+            saveTerminalNodeOutputObjects(b);
           }
-          valuePtr[mRecordIndex[i]] = outputPtr[i];
         }
       }
+      if ((RF_opt & OPT_NODE_STAT) || (RF_opt & OPT_USPV_STAT)) {
+        if (mode != RF_GROW) {
+          nodeOffset = RF_restoreTreeOffset[b];
+          saveStatistics(mode,
+                         b,
+                         RF_root[b],
+                         & nodeOffset,
+                         RF_spltST_,         
+                         RF_spltVR_,         
+                         RF_uspvST_ptr,      
+                         RF_mtryID_ptr,      
+                         RF_mtryST_ptr       
+                         );
+        }
+      }
+      if (RF_treeRecordFlag) {
+        saveTreeRecord(mode, b);
+      }
     }  
   }  
-}
-void imputeSummary(uint      mode,
-                   char      selectionFlag) {
-  imputeCommon(mode,
-               0,
-               selectionFlag,
-               TRUE);
-}
-void imputeResponse(uint      mode,
-                    uint      serialTreeID,
-                    double  **tempResponse) {
-  switch(mode) {
-  case RF_PRED:
-    imputeCommon(mode, serialTreeID, ACTIVE, FALSE);
-    imputeUpdateShadow(mode, tempResponse, NULL);
-    break;
-  default:
-    imputeCommon(mode, serialTreeID, FALSE, FALSE);
-    imputeUpdateShadow(mode, tempResponse, NULL);
-    break;
+  else {
   }
-}
-void imputeCommon(uint      mode,
-                  uint      serialTreeID,
-                  char      selectionFlag,
-                  char      predictorFlag) {
-  uint *localSerialIndex;
-  uint  localSerialCount;
-  uint *serialPtr;
-  char mFlag;
-  char outcomeFlag;
-  uint     mRecordSize;
-  uint    *mRecordIndex;
-  uint     mpIndexSize;
-  int    **mpSign;
-  int     *mpIndex;
-  double **outResponse;
-  double **outPredictor;
-  double *valuePtr;
-  double *naivePtr;
-  uint    unsignedSignatureIndex;
-  Terminal ***termMembershipPtr;
-  Terminal *info;
-  double imputedValue;
-  uint localDistributionSize;
-  uint maxDistributionSize;
-  uint rspSize;
-  char result;
-  uint i, p, v, tree;
-  valuePtr      = NULL;  
-  naivePtr      = NULL;  
-  unsignedSignatureIndex = 0;     
-  maxDistributionSize = 0;  
-  outResponse         = 0;  
-  outPredictor        = 0;  
-  rspSize = 0;  
-  mpIndex = 0;  
-  mpSign  = 0;  
-  mpIndexSize  = 0;  
-  mRecordIndex = 0;  
-  mRecordSize  = 0;  
-  localSerialIndex = NULL;  
-  if ((selectionFlag != TRUE) && (selectionFlag != FALSE) && (selectionFlag != ACTIVE)) {
-    RFprintf("\nRF-SRC:  *** ERROR *** ");
-    RFprintf("\nRF-SRC:  Invalid selectionFlag in imputeCommon():  %10d", selectionFlag);
-    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-    error("\nRF-SRC:  The application will now exit.\n");
+  freeTree(b, RF_root[b], TRUE);
+  unstackAuxiliary2(mode, b);
+  unstackAuxiliary(mode, b);
+  unstackNodeList(b);
+  unstackShadow(mode, b, TRUE, TRUE);
+  if (!terminalFlag) {
+    free_uivector(allMembrIndx, 1, RF_observationSize);
   }
-  result = FALSE;
-  switch (mode) {
-  case RF_PRED:
-    if (RF_fmRecordSize > 0) {
-      mRecordSize = RF_fmRecordSize;
-      mRecordIndex = RF_fmRecordIndex;
-      mpIndexSize = RF_fmpIndexSize;
-      mpSign = RF_fmpSign;
-      mpIndex = RF_fmpIndex;
-      maxDistributionSize = ((RF_observationSize) > (RF_forestSize)) ? (RF_observationSize) : (RF_forestSize);
-      outResponse  = RF_sImputeResponsePtr;
-      outPredictor = RF_sImputePredictorPtr;
-      rspSize = RF_frSize;
-      termMembershipPtr = RF_ftTermMembership;
-      result = TRUE;
+  if (mode == RF_PRED) {
+    free_uivector(fallMembrIndx, 1, RF_fobservationSize);
+  }
+  if (!(RF_opt & OPT_MISS)) {
+    for (i = 1; i <= RF_tLeafCount[b]; i++) {
+      freeTerminal(RF_tTermList[b][i]);
     }
-    break;
-  default:
-    if (RF_mRecordSize > 0) {
-      mRecordSize = RF_mRecordSize;
-      mRecordIndex = RF_mRecordIndex;
-      mpIndexSize = RF_mpIndexSize;
-      mpSign = RF_mpSign;
-      mpIndex = RF_mpIndex;
-      maxDistributionSize = ((RF_observationSize) > (RF_forestSize)) ? (RF_observationSize) : (RF_forestSize);
-      outResponse  = RF_sImputeResponsePtr;
-      outPredictor = RF_sImputePredictorPtr;
-      rspSize = RF_rSize;
-      termMembershipPtr = RF_tTermMembership;
-      result = TRUE;
+    unstackTermList(b);
+    if (RF_tLeafCount[b] > 0) {
+      unstackTermMembership(mode, b);
     }
-    break;
   }
-  if (result == FALSE) {
-    RFprintf("\nRF-SRC:  *** ERROR *** ");
-    RFprintf("\nRF-SRC:  Attempt to impute in imputeCommon() with no missingness in mode:  %10d", mode);
-    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-    error("\nRF-SRC:  The application will now exit.\n");
-  }
-  if (serialTreeID == 0) {
-    localSerialIndex = uivector(1, RF_forestSize);
-    for (tree = 1; tree <= RF_forestSize; tree++) {
-      localSerialIndex[tree] = tree;
+  unstackArena(mode);
+  if (r == RF_nImpute) {
+    if (RF_deterministicFlag) {
+      commitTree(mode, multImpFlag, b);
     }
-    serialPtr = localSerialIndex;
-    localSerialCount = RF_forestSize;
-  }
-  else {
-    serialPtr = RF_serialTreeIndex;
-    localSerialCount = serialTreeID;
-  }
-  imputedValue = 0.0;  
-  double *localDistribution = dvector(1, maxDistributionSize);
-  char  *naiveFlag = cvector(1, mpIndexSize);
-  char **naiveSign = cmatrix(1, mRecordSize, 1, mpIndexSize);
-  for (p = 1; p <= mpIndexSize; p++) {
-    naiveFlag[p] = FALSE;
-  }
-  for (i = 1; i <= mRecordSize; i++) {
-    outcomeFlag = TRUE;
-    for (p = 1; p <= mpIndexSize; p++) {
-      naiveSign[i][p] = FALSE;
-      if (mpIndex[p] < 0) {
-        unsignedSignatureIndex = (uint) abs(mpIndex[p]);
-      }
-      else {
-        if (predictorFlag == TRUE) {
-          unsignedSignatureIndex = (uint) mpIndex[p] + rspSize;
-        }
-        outcomeFlag = FALSE;
-      }
-      if (outcomeFlag || predictorFlag) {
-        if (mpSign[unsignedSignatureIndex][i] == 1) {
-          localDistributionSize = 0;
-          for (tree = 1; tree <= localSerialCount; tree++) {
-            if (RF_tLeafCount[serialPtr[tree]] > 0) {
-              if ((RF_dmRecordBootFlag[serialPtr[tree]][i] == selectionFlag) || (selectionFlag == ACTIVE)) {
-                info = termMembershipPtr[serialPtr[tree]][mRecordIndex[i]];
-                for (v = 1; v <= info -> lmiSize; v++) {
-                  if ((info -> lmiIndex)[v] == p) {
-                        if (!ISNA((info -> lmiValue)[v])) {
-                          localDistribution[++localDistributionSize] = (info -> lmiValue)[v];
-                        }
-                        else {
-                        }  
-                    v = info -> lmiSize;
-                  }
-                }
-              }  
-            }  
-            else {
-            }
-          }  
-          if (localDistributionSize > 0) {
-            if (mpIndex[p] < 0) {
-              if (strcmp(RF_rType[(uint) abs(mpIndex[p])], "T") == 0) {
-                imputedValue = getMeanValue(localDistribution, localDistributionSize);
-              }
-              else if (strcmp(RF_rType[(uint) abs(mpIndex[p])], "S") == 0) {
-                imputedValue = getMaximalValue(localDistribution, localDistributionSize, FALSE, localSerialCount);
-              }
-              else if (strcmp(RF_rType[(uint) abs(mpIndex[p])], "R") == 0) {
-                imputedValue = getMeanValue(localDistribution, localDistributionSize);
-              }
-              else if (strcmp(RF_rType[(uint) abs(mpIndex[p])], "I") == 0) {
-                imputedValue = getMaximalValue(localDistribution, localDistributionSize, FALSE, localSerialCount);
-              }
-              else if (strcmp(RF_rType[(uint) abs(mpIndex[p])], "C") == 0) {
-                imputedValue = getMaximalValue(localDistribution, localDistributionSize, FALSE, localSerialCount);
-              }
-              outResponse[(uint) abs(mpIndex[p])][i] = imputedValue;
-            }  
-            else {
-              if (strcmp(RF_xType[(uint) mpIndex[p]], "R") == 0) {
-                imputedValue = getMeanValue(localDistribution, localDistributionSize);
-              }
-              else {
-                imputedValue = getMaximalValue(localDistribution, localDistributionSize, FALSE, localSerialCount);
-              }
-              outPredictor[(uint) mpIndex[p]][i] = imputedValue;
-            }
-          }  
-          else {
-            naiveFlag[p] = TRUE;
-            naiveSign[i][p] = TRUE;
-          }
-        }  
-      }  
-      else {
-        p = mpIndexSize;
+  }
+}
+uint getReplicaIndex() {
+  uint result;
+  result = 1;
+#if defined(_OPENMP) && (_OPENMP >= 201511)
+  if (RF_replicaCount > 1) {
+    int place = omp_get_place_num();
+    if (place >= 0) {
+      result = (((uint) place * RF_replicaCount) / omp_get_num_places()) + 1;
+    }
+  }
+#endif
+  return result;
+}
+void stackDataReplicas(uint mode) {
+  uint k;
+  RF_replicaCount = 1;
+#if defined(_OPENMP) && (_OPENMP >= 201511)
+  if ((RF_optHigh & OPT_NUMA_REPL) && (RF_numThreads > 1) && (RF_mRecordSize == 0)) {
+    RF_replicaCount = omp_get_num_places();
+    if (RF_replicaCount > RF_numThreads) {
+      RF_replicaCount = RF_numThreads;
+    }
+    if (RF_replicaCount < 1) {
+      RF_replicaCount = 1;
+    }
+  }
+#endif
+  if (RF_replicaCount > 1) {
+    RF_observationReplica = (double ***) new_vvector(1, RF_replicaCount, NRUTIL_DPTR2);
+    RF_responseReplica = (double ***) new_vvector(1, RF_replicaCount, NRUTIL_DPTR2);
+    RF_masterTimeIndexReplica = (uint **) new_vvector(1, RF_replicaCount, NRUTIL_UPTR);
+    for (k = 1; k <= RF_replicaCount; k++) {
+      RF_observationReplica[k] = NULL;
+      RF_responseReplica[k] = NULL;
+      RF_masterTimeIndexReplica[k] = NULL;
+    }
+#if defined(_OPENMP) && (_OPENMP >= 201511)
+#pragma omp parallel num_threads(RF_replicaCount) proc_bind(spread)
+#endif
+    {
+      stackDataReplica(getReplicaIndex());
+    }
+  }
+}
+void stackDataReplica(uint k) {
+  double **observation;
+  double **response;
+  uint    *masterTimeIndex;
+  uint i, j;
+  observation = response = NULL;
+  masterTimeIndex = NULL;
+#ifdef _OPENMP
+#pragma omp critical (_stack_replica)
+#endif
+  {
+    if (RF_observationReplica[k] == NULL) {
+      observation = (double **) new_vvector(1, RF_xSize, NRUTIL_DPTR);
+      if (RF_rSize > 0) {
+        response = (double **) new_vvector(1, RF_rSize, NRUTIL_DPTR);
+        if (RF_timeIndex > 0) {
+          masterTimeIndex = uivector(1, RF_observationSize);
+        }
       }
-    }  
-  }  
-  outcomeFlag = TRUE;
-  for (p = 1; p <= mpIndexSize; p++) {
-    if (mpIndex[p] < 0) {
-      unsignedSignatureIndex = (uint) abs(mpIndex[p]);
-      valuePtr = RF_responseIn[(uint) abs(mpIndex[p])];
-      naivePtr = outResponse[(uint) abs(mpIndex[p])];
+      RF_observationReplica[k] = observation;
+      RF_responseReplica[k] = response;
+      RF_masterTimeIndexReplica[k] = masterTimeIndex;
     }
-    else {
-      if (predictorFlag == TRUE) {
-        unsignedSignatureIndex = (uint) mpIndex[p] + rspSize;
-        valuePtr = RF_observationIn[(uint) mpIndex[p]];
-        naivePtr = outPredictor[(uint) mpIndex[p]];
+  }
+  if (observation != NULL) {
+    for (j = 1; j <= RF_xSize; j++) {
+      observation[j] = dvector(1, RF_observationSize);
+      for (i = 1; i <= RF_observationSize; i++) {
+        observation[j][i] = RF_observationIn[j][i];
       }
-      outcomeFlag = FALSE;
     }
-    if (outcomeFlag || predictorFlag) {
-      if (naiveFlag[p] == TRUE) {
-        localDistributionSize = 0;
-        for (i=1; i <= RF_observationSize; i++) {
-          mFlag = TRUE;
-          if (RF_mRecordMap[i] == 0) {
-            mFlag = FALSE;
-          }
-          else if (RF_mpSign[unsignedSignatureIndex][RF_mRecordMap[i]] == 0) {
-            mFlag = FALSE;
-          }
-          if (mFlag == FALSE) {
-            localDistribution[++localDistributionSize] = valuePtr[i];
-          }
-        }  
-        if (localDistributionSize > 0) {
-          for (i=1; i <= mRecordSize; i++) {
-            if (naiveSign[i][p] == TRUE) {
-              naivePtr[i] = getSampleValue(localDistribution, localDistributionSize, FALSE, localSerialCount);
-            }
-          }
-        }  
-        else {
-          if (mpIndex[p] < 0) {
-            RFprintf("\nRF-SRC:  *** ERROR *** ");
-            RFprintf("\nRF-SRC:  Naive imputation failed for [indv, outcome] = [%10d, %10d] \n", mRecordIndex[i], mpIndex[p]);
-            RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-            error("\nRF-SRC:  The application will now exit.\n");
-          }
-          else {
-          }
+    if (response != NULL) {
+      for (j = 1; j <= RF_rSize; j++) {
+        response[j] = dvector(1, RF_observationSize);
+        for (i = 1; i <= RF_observationSize; i++) {
+          response[j][i] = RF_responseIn[j][i];
         }
-      }  
-    }  
-    else {
-      p = mpIndexSize;
+      }
+    }
+    if (masterTimeIndex != NULL) {
+      for (i = 1; i <= RF_observationSize; i++) {
+        masterTimeIndex[i] = RF_masterTimeIndexIn[i];
+      }
     }
-  }  
-  if (serialTreeID == 0) {
-    free_uivector(localSerialIndex, 1, RF_forestSize);
   }
-  free_dvector(localDistribution, 1, maxDistributionSize);
-  free_cvector(naiveFlag, 1, mpIndexSize);
-  free_cmatrix(naiveSign, 1, mRecordSize, 1, mpIndexSize);
 }
-void imputeMultipleTime (char selectionFlag) {
-  double  *outTime;
-  char     result;
-  uint i;
-  result = FALSE;
-    if (RF_timeIndex > 0) {
-      if (RF_mRecordSize > 0) {
-      if (RF_mTimeFlag == TRUE) {
-        result = TRUE;
+void unstackDataReplicas(uint mode) {
+  uint b, j, k;
+  if (RF_replicaCount > 1) {
+    for (b = 1; b <= RF_forestSize; b++) {
+      RF_observation[b] = RF_observationIn;
+      if (RF_rSize > 0) {
+        RF_response[b] = RF_responseIn;
+        if (RF_timeIndex > 0) {
+          RF_time[b] = RF_responseIn[RF_timeIndex];
+          RF_masterTimeIndex[b] = RF_masterTimeIndexIn;
+        }
+        if (RF_statusIndex > 0) {
+          RF_status[b] = RF_responseIn[RF_statusIndex];
+        }
       }
-      else {
-        RFprintf("\nRF-SRC:  *** ERROR *** ");
-        RFprintf("\nRF-SRC:  Attempt to multiply impute time with no missingness in time vector.");
+    }
+    for (k = 1; k <= RF_replicaCount; k++) {
+      if (RF_observationReplica[k] != NULL) {
+        for (j = 1; j <= RF_xSize; j++) {
+          free_dvector(RF_observationReplica[k][j], 1, RF_observationSize);
+        }
+        free_new_vvector(RF_observationReplica[k], 1, RF_xSize, NRUTIL_DPTR);
+      }
+      if (RF_responseReplica[k] != NULL) {
+        for (j = 1; j <= RF_rSize; j++) {
+          free_dvector(RF_responseReplica[k][j], 1, RF_observationSize);
+        }
+        free_new_vvector(RF_responseReplica[k], 1, RF_rSize, NRUTIL_DPTR);
+      }
+      if (RF_masterTimeIndexReplica[k] != NULL) {
+        free_uivector(RF_masterTimeIndexReplica[k], 1, RF_observationSize);
       }
     }
+    free_new_vvector(RF_observationReplica, 1, RF_replicaCount, NRUTIL_DPTR2);
+    free_new_vvector(RF_responseReplica, 1, RF_replicaCount, NRUTIL_DPTR2);
+    free_new_vvector(RF_masterTimeIndexReplica, 1, RF_replicaCount, NRUTIL_UPTR);
+    RF_replicaCount = 1;
   }
-  else {
-    RFprintf("\nRF-SRC:  *** ERROR *** ");
-    RFprintf("\nRF-SRC:  Attempt to multiply impute time in a !SURV environment.");
+}
+void bindDataReplica(uint b) {
+  uint k;
+  if (RF_replicaCount > 1) {
+    k = getReplicaIndex();
+    if (RF_observationReplica[k] != NULL) {
+      RF_observation[b] = RF_observationReplica[k];
+      if (RF_rSize > 0) {
+        RF_response[b] = RF_responseReplica[k];
+        if (RF_timeIndex > 0) {
+          RF_time[b] = RF_responseReplica[k][RF_timeIndex];
+          RF_masterTimeIndex[b] = RF_masterTimeIndexReplica[k];
+        }
+        if (RF_statusIndex > 0) {
+          RF_status[b] = RF_responseReplica[k][RF_statusIndex];
+        }
+      }
+    }
   }
-  if (result == FALSE) {
-    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-    error("\nRF-SRC:  The application will now exit.\n");
+}
+void acquireForest(uint mode, uint r) {
+  uint b;
+  double busyStart = getThreadClock();
+  if ((RF_deterministicFlag) && (r == RF_nImpute)) {
+#ifdef _OPENMP
+#pragma omp for ordered schedule(dynamic, 1) nowait
+#endif
+    for (b = 1; b <= RF_forestSize; b++) {
+      acquireTree(mode, r, b);
+    }
   }
-  outTime  = RF_sImputeResponsePtr[RF_timeIndex];
-  for (i=1; i <= RF_mRecordSize; i++) {
-    if(RF_mpSign[RF_timeIndex][i] == 1) {
-      outTime[i] = getNearestMasterTime(outTime[i], FALSE, 1);
+  else {
+#ifdef _OPENMP
+#pragma omp for schedule(runtime) nowait
+#endif
+    for (b = 1; b <= RF_forestSize; b++) {
+      acquireTree(mode, r, b);
+    }
+  }
+  updateThreadBusyTime(busyStart);
+}
+Arena *suspendArena() {
+  Arena *arena;
+  arena = RF_arenaCurrent;
+  RF_arenaCurrent = NULL;
+  return arena;
+}
+void resumeArena(Arena *arena) {
+  RF_arenaCurrent = arena;
+}
+/*
+  The tree arena is owned by the calling thread and lives from stackArena()
+  to unstackArena() around the growth of a single tree.  Every block taken
+  from it through gblock() must be released before unstackArena(), which
+  treats a non-zero live count as a fatal error.  Storage that outlives
+  the tree must be allocated between suspendArena() and resumeArena().
+  RF_arenaCurrent is reset at every .Call() entry point so that an arena
+  abandoned by an error() is never reused.
+*/
+void stackArena(uint mode) {
+  RF_arenaCurrent = NULL;
+  if (!(RF_opt & OPT_MISS)) {
+    RF_arenaCurrent = makeArena();
+  }
+}
+void unstackArena(uint mode) {
+  Arena *arena;
+  arena = RF_arenaCurrent;
+  RF_arenaCurrent = NULL;
+  if (arena != NULL) {
+#ifdef _OPENMP
+#pragma omp critical (_update_arena)
+#endif
+    { 
+      RF_arenaTotal += (double) arena -> total;
+      if ((double) arena -> peak > RF_arenaPeak) {
+        RF_arenaPeak = (double) arena -> peak;
+      }
     }
+    freeArena(arena);
   }
 }
-double getNearestMasterTime (double   meanValue,
-                             char     chainFlag,
-                             uint     treeID) {
-  double leftDistance, rightDistance;
-  uint minimumIndex;
-  uint j;
-    leftDistance = meanValue - RF_masterTime[1];
-    rightDistance = RF_masterTime[RF_masterTimeSize] - meanValue;
-    if ( ((leftDistance > EPSILON) || (fabs(leftDistance) < EPSILON)) &&
-         ((rightDistance > EPSILON) || (fabs(rightDistance) < EPSILON)) ) {
+void finalizeProximity(uint mode) {
+  uint  obsSize;
+  uint  activeCount;
+  uint  pairCount;
+  char  fullFlag;
+  uint  b;
+  if (mode != RF_PRED) {
+    obsSize = RF_observationSize;
+  }
+  else {
+    obsSize = RF_fobservationSize;
+  }
+  fullFlag = ((RF_opt & OPT_PROX_IBG) && (RF_opt & OPT_PROX_OOB)) ? TRUE : FALSE;
+  RF_proximityLeafCount = uivector(1, RF_forestSize);
+  RF_proximityLeafIndex = (uint **) new_vvector(1, RF_forestSize, NRUTIL_UPTR);
+  RF_proximityLeafMembr = (uint **) new_vvector(1, RF_forestSize, NRUTIL_UPTR);
+  activeCount = 0;
+  for (b = 1; b <= RF_forestSize; b++) {
+    RF_proximityLeafCount[b] = 0;
+    RF_proximityLeafIndex[b] = NULL;
+    RF_proximityLeafMembr[b] = NULL;
+    if (RF_proximityTree[b]) {
+      activeCount ++;
+      stackProximityLeaf(b, obsSize, fullFlag);
     }
-    else {
-      RFprintf("\nRF-SRC:  *** ERROR *** ");
-      RFprintf("\nRF-SRC:  The summary mean value for time is out of range:  %12.4f <= %12.4f <= %12.4f", RF_masterTime[1], meanValue, RF_masterTime[RF_masterTimeSize]);
-      RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-      error("\nRF-SRC:  The application will now exit.\n");
+  }
+  if (!fullFlag) {
+    stackProximityMask(obsSize, activeCount);
+  }
+  if (RF_optHigh & OPT_PROX_SPRS) {
+    finalizeSparseProximity(obsSize, fullFlag, activeCount);
+  }
+  else {
+    pairCount = (obsSize + 1) >> 1;
+    if (RF_numThreads > 0) {
+#ifdef _OPENMP
+#pragma omp parallel num_threads(RF_numThreads)
+#endif
+      {
+        double busyStart = getThreadClock();
+#ifdef _OPENMP
+#pragma omp for schedule(runtime) nowait
+#endif
+        for (uint k = 1; k <= pairCount; k++) {
+          finalizeProximityRow(k, fullFlag, activeCount);
+          if (obsSize + 1 - k != k) {
+            finalizeProximityRow(obsSize + 1 - k, fullFlag, activeCount);
+          }
+        }
+        updateThreadBusyTime(busyStart);
+      }
     }
-  leftDistance = rightDistance = 0;
-  minimumIndex = RF_masterTimeSize;
-  for (j = 1; j <= RF_masterTimeSize; j++) {
-    if (meanValue <= RF_masterTime[j]) {
-      minimumIndex = j;
-      j = RF_masterTimeSize;
+    else {
+      double busyStart = getThreadClock();
+      for (uint i = 1; i <= obsSize; i++) {
+        finalizeProximityRow(i, fullFlag, activeCount);
+      }
+      updateThreadBusyTime(busyStart);
     }
   }
-  if (minimumIndex == 1) {
+  for (b = 1; b <= RF_forestSize; b++) {
+    if (RF_proximityTree[b]) {
+      unstackProximityLeaf(b, obsSize);
+    }
+  }
+  if (!fullFlag) {
+    unstackProximityMask(obsSize);
+  }
+  free_uivector(RF_proximityLeafCount, 1, RF_forestSize);
+  free_new_vvector(RF_proximityLeafIndex, 1, RF_forestSize, NRUTIL_UPTR);
+  free_new_vvector(RF_proximityLeafMembr, 1, RF_forestSize, NRUTIL_UPTR);
+}
+void finalizeSparseProximity(uint obsSize, char fullFlag, uint activeCount) {
+  SEXP   proxValue, proxIndex, proxColumn;
+  double *value;
+  uint   *index;
+  uint   *column;
+  double  pairSize;
+  uint    totalSize;
+  uint    i, k, offset;
+  RF_proximityRowSize   = uivector(1, obsSize);
+  RF_proximityRowColumn = (uint **) new_vvector(1, obsSize, NRUTIL_UPTR);
+  RF_proximityRowValue  = (double **) new_vvector(1, obsSize, NRUTIL_DPTR);
+  if (RF_numThreads > 0) {
+#ifdef _OPENMP
+#pragma omp parallel num_threads(RF_numThreads)
+#endif
+    {
+      double busyStart = getThreadClock();
+      double *rowCount = dvector(1, obsSize);
+      uint   *rowTouch = uivector(1, obsSize);
+      for (uint j = 1; j <= obsSize; j++) {
+        rowCount[j] = 0;
+      }
+#ifdef _OPENMP
+#pragma omp for schedule(runtime) nowait
+#endif
+      for (uint ii = 1; ii <= obsSize; ii++) {
+        finalizeSparseProximityRow(ii, fullFlag, activeCount, rowCount, rowTouch);
+      }
+      free_dvector(rowCount, 1, obsSize);
+      free_uivector(rowTouch, 1, obsSize);
+      updateThreadBusyTime(busyStart);
+    }
   }
   else {
-    leftDistance = meanValue - RF_masterTime[minimumIndex-1];
-    rightDistance = RF_masterTime[minimumIndex] - meanValue;
-    if (leftDistance < rightDistance) {
-      minimumIndex = minimumIndex - 1;
+    double busyStart = getThreadClock();
+    double *rowCount = dvector(1, obsSize);
+    uint   *rowTouch = uivector(1, obsSize);
+    for (uint j = 1; j <= obsSize; j++) {
+      rowCount[j] = 0;
     }
-    else {
-      if (fabs(leftDistance - rightDistance) < EPSILON) {
-        if(chainFlag) {
-          if (ran1A(treeID) <= 0.5) {
-            minimumIndex = minimumIndex - 1;
-          }
-        }
-        else {
-          if (ran1B(treeID) <= 0.5) {
-            minimumIndex = minimumIndex - 1;
+    for (uint ii = 1; ii <= obsSize; ii++) {
+      finalizeSparseProximityRow(ii, fullFlag, activeCount, rowCount, rowTouch);
+    }
+    free_dvector(rowCount, 1, obsSize);
+    free_uivector(rowTouch, 1, obsSize);
+    updateThreadBusyTime(busyStart);
+  }
+  pairSize = 0;
+  for (i = 1; i <= obsSize; i++) {
+    pairSize += (double) RF_proximityRowSize[i];
+  }
+  if (pairSize >= (double) R_LEN_T_MAX) {
+    for (i = 1; i <= obsSize; i++) {
+      if (RF_proximityRowSize[i] > 0) {
+        free_uivector(RF_proximityRowColumn[i], 1, RF_proximityRowSize[i]);
+        free_dvector(RF_proximityRowValue[i], 1, RF_proximityRowSize[i]);
+      }
+    }
+    free_uivector(RF_proximityRowSize, 1, obsSize);
+    free_new_vvector(RF_proximityRowColumn, 1, obsSize, NRUTIL_UPTR);
+    free_new_vvector(RF_proximityRowValue, 1, obsSize, NRUTIL_DPTR);
+    RFprintf("\nRF-SRC:  *** ERROR *** ");
+    RFprintf("\nRF-SRC:  Sparse proximity has %20.0f non-zero entries, which exceeds the R vector limit of %10d.", pairSize, R_LEN_T_MAX);
+    RFprintf("\nRF-SRC:  Please reduce proximity.topk, or set it if it is zero.");
+    error("\nRF-SRC:  The application will now exit.\n");
+  }
+  totalSize = (uint) pairSize;
+  PROTECT(proxValue  = NEW_NUMERIC(totalSize));
+  PROTECT(proxIndex  = NEW_INTEGER(obsSize + 1));
+  PROTECT(proxColumn = NEW_INTEGER(totalSize));
+  SET_VECTOR_ELT(sexpVector[RF_OUTP_ID], RF_proximitySexpIndex, proxValue);
+  SET_VECTOR_ELT(sexpVector[RF_OUTP_ID], RF_proximitySexpIndex + 1, proxIndex);
+  SET_VECTOR_ELT(sexpVector[RF_OUTP_ID], RF_proximitySexpIndex + 2, proxColumn);
+  value  = NUMERIC_POINTER(proxValue);  value --;
+  index  = (uint*) INTEGER_POINTER(proxIndex);  index --;
+  column = (uint*) INTEGER_POINTER(proxColumn);  column --;
+  offset = 0;
+  for (i = 1; i <= obsSize; i++) {
+    index[i] = offset + 1;
+    for (k = 1; k <= RF_proximityRowSize[i]; k++) {
+      column[offset + k] = RF_proximityRowColumn[i][k];
+      value[offset + k]  = RF_proximityRowValue[i][k];
+    }
+    offset += RF_proximityRowSize[i];
+    if (RF_proximityRowSize[i] > 0) {
+      free_uivector(RF_proximityRowColumn[i], 1, RF_proximityRowSize[i]);
+      free_dvector(RF_proximityRowValue[i], 1, RF_proximityRowSize[i]);
+    }
+  }
+  index[obsSize + 1] = offset + 1;
+  free_uivector(RF_proximityRowSize, 1, obsSize);
+  free_new_vvector(RF_proximityRowColumn, 1, obsSize, NRUTIL_UPTR);
+  free_new_vvector(RF_proximityRowValue, 1, obsSize, NRUTIL_DPTR);
+}
+void finalizeSparseProximityRow(uint    ii,
+                                char    fullFlag,
+                                uint    activeCount,
+                                double *rowCount,
+                                uint   *rowTouch) {
+  uint   *leafIndex;
+  uint   *leafMembr;
+  double *rowValue;
+  uint   *rowOrder;
+  double  threshold;
+  uint    touchCount, tieCount, keepCount;
+  uint    leaf;
+  uint    b, jj, k, t;
+  touchCount = 0;
+  for (b = 1; b <= RF_forestSize; b++) {
+    if (RF_proximityTree[b]) {
+      if (fullFlag || RF_proximityFlag[b][ii]) {
+        leafIndex = RF_proximityLeafIndex[b];
+        leafMembr = RF_proximityLeafMembr[b];
+        leaf = RF_tTermMembershipIndexPtr[b][ii];
+        for (k = leafIndex[leaf]; k < leafIndex[leaf + 1]; k++) {
+          jj = leafMembr[k];
+          if (rowCount[jj] == 0) {
+            rowTouch[++touchCount] = jj;
           }
+          rowCount[jj] ++;
         }
       }
     }
   }
-  return RF_masterTime[minimumIndex];
-}
-double getMaximalValue(double *value, uint size, char chainFlag, uint treeID) {
-  double result;
-  uint classCount, maximalClassSize, maximalClassCount;
-  uint randomIndex;
-  uint j;
-  uint   *classSize  = uivector(1, size);
-  for (j = 1; j <= size; j++) {
-    classSize[j] = 0;
+  RF_proximityRowSize[ii] = 0;
+  if (touchCount == 0) {
+    return;
   }
-  hpsort(value, size);
-  classCount = 1;
-  classSize[1] = 1;
-  for (j = 2; j <= size; j++) {
-    if (value[j] > value[classCount]) {
-      classCount ++;
-      value[classCount] = value[j];
+  hpsortui(rowTouch, touchCount);
+  rowValue = dvector(1, touchCount);
+  for (t = 1; t <= touchCount; t++) {
+    jj = rowTouch[t];
+    if (fullFlag) {
+      rowValue[t] = rowCount[jj] / activeCount;
     }
-    classSize[classCount] ++;
+    else {
+      rowValue[t] = rowCount[jj] / getProximityDenominator(ii, jj);
+    }
+    rowCount[jj] = 0;
   }
-  maximalClassSize = maximalClassCount = 0;
-  for (j=1; j <= classCount; j++) {
-    if (classSize[j] > maximalClassSize) {
-      maximalClassSize = classSize[j];
+  keepCount = touchCount;
+  threshold = 0;
+  tieCount = 0;
+  if ((RF_proximityTopK > 0) && (touchCount > RF_proximityTopK)) {
+    keepCount = RF_proximityTopK;
+    rowOrder = uivector(1, touchCount);
+    for (t = 1; t <= touchCount; t++) {
+      rowValue[t] = - rowValue[t];
+    }
+    indexx(touchCount, rowValue, rowOrder);
+    for (t = 1; t <= touchCount; t++) {
+      rowValue[t] = - rowValue[t];
+    }
+    threshold = rowValue[rowOrder[keepCount]];
+    tieCount = keepCount;
+    for (t = 1; t <= touchCount; t++) {
+      if (rowValue[t] > threshold) {
+        tieCount --;
+      }
     }
+    free_uivector(rowOrder, 1, touchCount);
   }
-  for (j=1; j <= classCount; j++) {
-    if (classSize[j] == maximalClassSize) {
-      maximalClassCount ++;
+  RF_proximityRowColumn[ii] = uivector(1, keepCount);
+  RF_proximityRowValue[ii]  = dvector(1, keepCount);
+  k = 0;
+  for (t = 1; t <= touchCount; t++) {
+    if ((keepCount == touchCount) || (rowValue[t] > threshold) || ((rowValue[t] == threshold) && (tieCount > 0))) {
+      if ((keepCount < touchCount) && (rowValue[t] == threshold)) {
+        tieCount --;
+      }
+      k ++;
+      RF_proximityRowColumn[ii][k] = rowTouch[t];
+      RF_proximityRowValue[ii][k]  = rowValue[t];
+    }
+  }
+  RF_proximityRowSize[ii] = keepCount;
+  free_dvector(rowValue, 1, touchCount);
+}
+void finalizeProximityRow(uint ii, char fullFlag, uint activeCount) {
+  uint *leafIndex;
+  uint *leafMembr;
+  uint  leaf;
+  uint  b, jj, k;
+  for (b = 1; b <= RF_forestSize; b++) {
+    if (RF_proximityTree[b]) {
+      if (fullFlag || RF_proximityFlag[b][ii]) {
+        leafIndex = RF_proximityLeafIndex[b];
+        leafMembr = RF_proximityLeafMembr[b];
+        leaf = RF_tTermMembershipIndexPtr[b][ii];
+        for (k = leafIndex[leaf]; k < leafIndex[leaf + 1]; k++) {
+          jj = leafMembr[k];
+          if (jj > ii) {
+            break;
+          }
+          RF_proximityPtr[ii][jj] ++;
+        }
+      }
     }
   }
-  if (maximalClassCount > 1) {
-    if(chainFlag) {
-      randomIndex = (uint) ceil(ran1A(treeID)*((maximalClassCount)*1.0));
+  for (jj = 1; jj <= ii; jj++) {
+    if (fullFlag) {
+      if (activeCount > 0) {
+        RF_proximityPtr[ii][jj] = RF_proximityPtr[ii][jj] / activeCount;
+      }
+      else {
+        RF_proximityPtr[ii][jj] = NA_REAL;
+      }
     }
     else {
-      randomIndex = (uint) ceil(ran1B(treeID)*((maximalClassCount)*1.0));
+      k = getProximityDenominator(ii, jj);
+      if (k > 0) {
+        RF_proximityPtr[ii][jj] = RF_proximityPtr[ii][jj] / k;
+      }
+      else {
+        RF_proximityPtr[ii][jj] = NA_REAL;
+      }
     }
   }
-  else {
-    randomIndex = 1;
+}
+void stackProximityMask(uint obsSize, uint activeCount) {
+  uint maskBit;
+  uint b, i, t, w;
+  RF_proximityMaskSize = (activeCount + 31) >> 5;
+  if (RF_proximityMaskSize < 1) {
+    RF_proximityMaskSize = 1;
   }
-  j = 0;
-  while (randomIndex > 0) {
-    j++;
-    if (classSize[j] == maximalClassSize) {
-      randomIndex --;
-    }
+  RF_proximityMask = uivector(1, obsSize * RF_proximityMaskSize);
+  for (i = 1; i <= obsSize * RF_proximityMaskSize; i++) {
+    RF_proximityMask[i] = 0;
   }
-  result = value[j];
-  free_uivector(classSize, 1, size);
-  return result;
-}
-double getMedianValue(double *value, uint size) {
-  double result;
-  uint medianIndex;
-  sort(value, size);
-  if (size > 1) {
-    medianIndex = (uint) ceil(size/2);
+  RF_proximityMaskPtr = (uint **) new_vvector(1, obsSize, NRUTIL_UPTR);
+  RF_proximityMaskPtr[1] = RF_proximityMask;
+  for (i = 2; i <= obsSize; i++) {
+    RF_proximityMaskPtr[i] = RF_proximityMaskPtr[i-1] + RF_proximityMaskSize;
   }
-  else {
-    medianIndex = 1;
+  t = 0;
+  for (b = 1; b <= RF_forestSize; b++) {
+    if (RF_proximityTree[b]) {
+      w = (t >> 5) + 1;
+      maskBit = 1U << (t & 31);
+      for (i = 1; i <= obsSize; i++) {
+        if (RF_proximityFlag[b][i]) {
+          RF_proximityMaskPtr[i][w] |= maskBit;
+        }
+      }
+      t ++;
+    }
+  }
+}
+void unstackProximityMask(uint obsSize) {
+  free_uivector(RF_proximityMask, 1, obsSize * RF_proximityMaskSize);
+  free_new_vvector(RF_proximityMaskPtr, 1, obsSize, NRUTIL_UPTR);
+}
+uint getProximityDenominator(uint ii, uint jj) {
+  uint *maskI;
+  uint *maskJ;
+  uint  x, count;
+  uint  w;
+  maskI = RF_proximityMaskPtr[ii];
+  maskJ = RF_proximityMaskPtr[jj];
+  count = 0;
+  for (w = 1; w <= RF_proximityMaskSize; w++) {
+    x = maskI[w] & maskJ[w];
+    x = x - ((x >> 1) & 0x55555555);
+    x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+    x = (x + (x >> 4)) & 0x0F0F0F0F;
+    count += (x * 0x01010101) >> 24;
+  }
+  return count;
+}
+void stackProximityLeaf(uint b, uint obsSize, char fullFlag) {
+  uint *tTermMembershipIndexPtr;
+  uint *leafIndex;
+  uint *leafMembr;
+  uint *leafCursor;
+  uint  leafCount;
+  uint  i;
+  tTermMembershipIndexPtr = RF_tTermMembershipIndexPtr[b];
+  leafCount = 0;
+  for (i = 1; i <= obsSize; i++) {
+    if (fullFlag || RF_proximityFlag[b][i]) {
+      if (tTermMembershipIndexPtr[i] > leafCount) {
+        leafCount = tTermMembershipIndexPtr[i];
+      }
+    }
   }
-  result = value[medianIndex];
-  return result;
-}
-double getMeanValue(double *value, uint size) {
-  double result;
-  uint j;
-  result = 0.0;
-  for (j = 1; j <= size; j++) {
-    result = result + value[j];
+  leafIndex = uivector(1, leafCount + 1);
+  leafMembr = uivector(1, obsSize);
+  leafCursor = uivector(1, leafCount);
+  for (i = 1; i <= leafCount + 1; i++) {
+    leafIndex[i] = 0;
   }
-  result = result / size;
-  return result;
-}
-double getSampleValue(double *value, uint size, char chainFlag, uint treeID) {
-  uint randomIndex;
-  if(chainFlag) {
-    randomIndex = (uint) ceil(ran1A(treeID)*((size)*1.0));
+  for (i = 1; i <= obsSize; i++) {
+    if (fullFlag || RF_proximityFlag[b][i]) {
+      leafIndex[tTermMembershipIndexPtr[i] + 1] ++;
+    }
   }
-  else {
-    randomIndex = (uint) ceil(ran1B(treeID)*((size)*1.0));
+  leafIndex[1] = 1;
+  for (i = 2; i <= leafCount + 1; i++) {
+    leafIndex[i] += leafIndex[i - 1];
+  }
+  for (i = 1; i <= leafCount; i++) {
+    leafCursor[i] = leafIndex[i];
   }
-  return value[randomIndex];
-}
-uint getRecordMap(uint    *map,
-                  uint     obsSize,
-                  double **resp,
-                  double **data) {
-  uint i, p, r;
-  uint mSize;
-  char mFlag;
-  mSize  = 0;
   for (i = 1; i <= obsSize; i++) {
-    mFlag = FALSE;
-    if (resp != NULL) {
-      for (r = 1; r <= RF_rSize; r++) {
-        if (ISNA(resp[r][i])) {
-          mFlag = TRUE;
-          r = RF_rSize;
-        }
-      }
+    if (fullFlag || RF_proximityFlag[b][i]) {
+      leafMembr[leafCursor[tTermMembershipIndexPtr[i]] ++] = i;
     }
-    if (mFlag == FALSE) {
-      for (p = 1; p <= RF_xSize; p++) {
-        if (ISNA(data[p][i])) {
-          mFlag = TRUE;
-          p = RF_xSize;
-        }
-      }
+  }
+  free_uivector(leafCursor, 1, leafCount);
+  RF_proximityLeafCount[b] = leafCount;
+  RF_proximityLeafIndex[b] = leafIndex;
+  RF_proximityLeafMembr[b] = leafMembr;
+}
+void unstackProximityLeaf(uint b, uint obsSize) {
+  free_uivector(RF_proximityLeafIndex[b], 1, RF_proximityLeafCount[b] + 1);
+  free_uivector(RF_proximityLeafMembr[b], 1, obsSize);
+}
+void updateProximity(uint mode, uint b) {
+  uint  *membershipIndex;
+  uint   membershipSize;
+  uint   i;
+  if (!((RF_opt & OPT_PROX_IBG) && (RF_opt & OPT_PROX_OOB))) {
+    if((RF_opt & OPT_PROX_IBG)  && !(RF_opt & OPT_PROX_OOB)) {
+      membershipIndex = RF_ibgMembershipIndex[b];
+      membershipSize  = RF_ibgSize[b];
     }
-    if (mFlag == TRUE) {
-      mSize ++;
-      map[i] = mSize;
+    else if(!(RF_opt & OPT_PROX_IBG)  && (RF_opt & OPT_PROX_OOB)) {
+      membershipIndex = RF_oobMembershipIndex[b];
+      membershipSize  = RF_oobSize[b];
     }
     else {
-      map[i] = 0;
+      RFprintf("\nRF-SRC:  *** ERROR *** ");
+      RFprintf("\nRF-SRC:  Illegal updateProximity() call.");
+      RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+      error("\nRF-SRC:  The application will now exit.\n");
     }
-  }
-  return mSize;
-}
-void updateTimeIndexArray(uint    treeID,
-                          uint   *allMembrIndx,
-                          uint    allMembrSize,
-                          double *time,
-                          char    naAllowFlag,
-                          char    noIdxAllowFlag,
-                          uint   *masterTimeIndex) {
-  uint *membrIndx;
-  char idxFoundFlag;
-  uint i,k;
-  if (allMembrIndx == NULL) {
-    membrIndx = uivector(1, allMembrSize);
-    for (i = 1; i <= allMembrSize; i++) {
-      membrIndx[i] = i;
+    for (i = 1; i <= membershipSize; i++) {
+      RF_proximityFlag[b][membershipIndex[i]] = TRUE;
     }
   }
-  else {
-    membrIndx = allMembrIndx;
-  }
-  for (i=1; i <= allMembrSize; i++) {
-    idxFoundFlag = FALSE;
-    if (!ISNA(time[membrIndx[i]])) {
-      k = 1;
-      while (k <= RF_masterTimeSize) {
-        if (time[membrIndx[i]] == RF_masterTime[k]) {
-          masterTimeIndex[membrIndx[i]] = k;
-          idxFoundFlag = TRUE;
-          k = RF_masterTimeSize;
-        }
-        k++;
+  RF_proximityTree[b] = TRUE;
+}
+void updateSplitDepth(uint treeID, Node *rootPtr, uint maxDepth) {
+  Node  *parent;
+  double *localSplitDepth;
+  uint index;
+  uint i, j, k;
+  if (RF_tLeafCount[treeID] > 0) {
+    index = 0;  
+    if (RF_opt & (OPT_SPLDPTH_F | OPT_SPLDPTH_T)) {
+      if (RF_opt & OPT_SPLDPTH_F) {
+        index = 1;
+      }
+      else {
+        index = treeID;
       }
     }
     else {
-      if (naAllowFlag == FALSE) {
-        RFprintf("\nRF-SRC:  *** ERROR *** ");
-        RFprintf("\nRF-SRC:  Missing event time encountered for individual:  %10d, %12.4f", i, time[membrIndx[i]]);
-        RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-        error("\nRF-SRC:  The application will now exit.\n");
+      RFprintf("\nRF-SRC:  *** ERROR *** ");
+      RFprintf("\nRF-SRC:  Illegal updateSplitDepth() call.");
+      RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+      error("\nRF-SRC:  The application will now exit.\n");
+    }
+    localSplitDepth = dvector(1, RF_xSize);
+    for (i = 1; i <= RF_observationSize; i++) {
+      for (j = 1; j <= RF_xSize; j++) {
+        localSplitDepth[j] = NA_REAL;
       }
-      else {
-        masterTimeIndex[membrIndx[i]] = 0;
-        idxFoundFlag = TRUE;
+      parent = RF_tNodeMembership[treeID][i];
+      for (k = 1; k <= parent -> depth; k++) {
+        if (ISNA(localSplitDepth[(parent -> splitDepth)[k]])) {
+          localSplitDepth[(parent -> splitDepth)[k]] = (double) k;
+        }
       }
-    }
-    if (idxFoundFlag == FALSE) {
-      if (noIdxAllowFlag == FALSE) {
-        RFprintf("\nRF-SRC:  *** ERROR *** ");
-        RFprintf("\nRF-SRC:  Invalid event time encountered for individual:  %10d, %12.4f", i, time[membrIndx[i]]);
-        RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-        error("\nRF-SRC:  The application will now exit.\n");
+      for (j = 1; j <= RF_xSize; j++) {
+        if (ISNA(localSplitDepth[j])) {
+          localSplitDepth[j] = (double) maxDepth + 1;
+        }
       }
-      else {
-        masterTimeIndex[membrIndx[i]] = 0;
+      for (j = 1; j <= RF_xSize; j++) {
+        RF_splitDepthPtr[index][j][i] += localSplitDepth[j];
       }
     }
+    free_dvector(localSplitDepth, 1, RF_xSize);
+    freeSplitDepth(treeID);
   }
-  if (allMembrIndx == NULL) {
-    free_uivector(membrIndx, 1, allMembrSize);
-  }
-}  
-void updateEventTypeSubsets(double *summaryStatus,
-                            uint    mRecordSize,
-                            int   **mpSign,
-                            uint   *mRecordIndex,
-                            uint   *meIndividualSize,
-                            uint  **eIndividual) {
+}
+char pruneBranch(uint obsSize,
+                 uint treeID,
+                 Node **nodesAtDepth,
+                 uint nadCount,
+                 uint ptnTarget,
+                 uint ptnCurrent) {
+  char pruneFlag;
   uint i, j;
-  if (RF_eventTypeSize == 1) {
+  pruneFlag = TRUE;
+  double *varianceAtDepth =  dvector(1, nadCount);
+  uint   *vadSortedIndex  = uivector(1, nadCount);
+  for (i = 1; i <= nadCount; i++) {
+    varianceAtDepth[i] = nodesAtDepth[i] -> variance;
+  }
+  indexx(nadCount, varianceAtDepth, vadSortedIndex);
+  j = nadCount;
+  while ((j >= 1) && pruneFlag) {
+    nodesAtDepth[vadSortedIndex[j]] -> pseudoTerminal = TRUE;
+    (nodesAtDepth[vadSortedIndex[j]] -> left)  -> pseudoTerminal = FALSE;
+    (nodesAtDepth[vadSortedIndex[j]] -> right) -> pseudoTerminal = FALSE;
+    for (i = 1; i <= obsSize; i++) {
+      if ( (RF_pNodeMembership[treeID][i] == nodesAtDepth[vadSortedIndex[j]] -> left) ||
+           (RF_pNodeMembership[treeID][i] == nodesAtDepth[vadSortedIndex[j]] -> right)) {
+        RF_pNodeMembership[treeID][i] = nodesAtDepth[vadSortedIndex[j]];
+      }
+    }
+    j --;
+    ptnCurrent --;
+    if (ptnCurrent <= ptnTarget) {
+      pruneFlag = FALSE;
+    }
+  }
+  free_dvector(varianceAtDepth, 1, nadCount);
+  free_uivector(vadSortedIndex, 1, nadCount);
+  return pruneFlag;
+}
+uint pruneTree(uint obsSize, uint treeID, uint ptnTarget) {
+  Node **nodesAtDepth;
+  uint   ptnCurrent;
+  uint   nadCount;
+  uint   tagDepth;
+  char   pruneFlag;
+  uint   i;
+  if (ptnTarget < 1) {
     RFprintf("\nRF-SRC:  *** ERROR *** ");
-    RFprintf("\nRF-SRC:  Attempt to update event type subsets in a non-CR analysis.");
+    RFprintf("\nRF-SRC:  Illegal target PTN count in pruneTree():  %10d", ptnTarget);
     RFprintf("\nRF-SRC:  Please Contact Technical Support.");
     error("\nRF-SRC:  The application will now exit.\n");
   }
-  for (j = 1; j <= RF_eventTypeSize; j++) {
-    for (i = 1; i <= RF_eIndividualSize[j]; i++) {
-      eIndividual[j][i] = RF_eIndividualIn[j][i];
-    }
+  if (RF_tLeafCount[treeID] == 0) {
+    RFprintf("\nRF-SRC:  *** ERROR *** ");
+    RFprintf("\nRF-SRC:  Illegal call to pruneTree() on a rejected tree:  %10d", treeID);
+    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+    error("\nRF-SRC:  The application will now exit.\n");
   }
-  if (RF_mStatusSize > 0) {
-    uint *eventCounter = uivector(1, RF_eventTypeSize);
-    for (j = 1; j <= RF_eventTypeSize; j++) {
-      eventCounter[j] = RF_eIndividualSize[j];
+  nodesAtDepth = (Node **) new_vvector(1, RF_tLeafCount[treeID], NRUTIL_NPTR);
+  ptnCurrent = RF_tLeafCount[treeID];
+  tagDepth = getMaximumDepth(RF_root[treeID]) - 1;
+  pruneFlag = (ptnCurrent > ptnTarget) && (tagDepth > 0);
+  while (pruneFlag) {
+    for (i = 1; i <= RF_tLeafCount[treeID]; i++) {
+      nodesAtDepth[i] = NULL;
     }
-    for (i = 1; i <= mRecordSize; i++) {
-      if (mpSign[RF_statusIndex][i] == 1) {
-        if ((uint) summaryStatus[mRecordIndex[i]] > 0) {
-          j = RF_eventTypeIndex[(uint) summaryStatus[mRecordIndex[i]]];
-          eventCounter[j] ++;
-          eIndividual[j][eventCounter[j]] = mRecordIndex[i];
-        }
-        else {
-          for (j=1; j <= RF_eventTypeSize; j++) {
-            eventCounter[j] ++;
-            eIndividual[j][eventCounter[j]] = mRecordIndex[i];
-          }
-        }
-      }
+    nadCount = 0;
+    getNodesAtDepth(RF_root[treeID], tagDepth, nodesAtDepth, &nadCount);
+    pruneFlag = pruneBranch(obsSize, treeID, nodesAtDepth, nadCount, ptnTarget, ptnCurrent);
+    if(pruneFlag) {
+      ptnCurrent -= nadCount;
+      tagDepth --;
     }
-    for (j = 1; j <= RF_eventTypeSize; j++) {
-      meIndividualSize[j] = eventCounter[j];
+    else {
+      ptnCurrent = ptnTarget;
     }
-    free_uivector(eventCounter, 1, RF_eventTypeSize);
   }
+  free_new_vvector(nodesAtDepth, 1, RF_tLeafCount[treeID], NRUTIL_NPTR);
+  return ptnCurrent;
 }
-void stackShadow (uint mode, uint treeID) {
-  uint *nonMissIndex;
-  uint *permuteIndex;
-  uint * permuteSize;
-  char *nullSplitShadowFlag;
-  char  vimpShadowFlag;
-  uint  unsignedIndexSource;
-  uint  mpIndexIter;
-  uint i, j, p;
-  nonMissIndex        = NULL;  
-  permuteIndex        = NULL;  
-  permuteSize         = NULL;  
-  nullSplitShadowFlag = NULL;  
-  if (RF_opt & OPT_SPLT_NULL) {
-    nullSplitShadowFlag = cvector(1, RF_rSize);
-    for (p = 1; p <= RF_rSize; p++) {
-      nullSplitShadowFlag[p] = TRUE;
-    }
-    RF_response[treeID] = (double **) new_vvector(1, RF_rSize, NRUTIL_DPTR);
-    nonMissIndex = uivector(1, RF_observationSize);
-    permuteIndex = uivector(1, RF_observationSize);
-    permuteSize  = uivector(1, RF_rSize);
-    for (p = 1; p <= RF_rSize; p++) {
-      RF_response[treeID][p] = dvector(1, RF_observationSize);
-      for (i = 1; i <= RF_observationSize; i++) {
-        RF_response[treeID][p][i] = RF_responseIn[p][i];
-      }
+void unstackAuxiliary2(uint mode, uint b) {
+  if (!getPredictTerminalFlag(mode)) {
+    free_uivector(RF_bootMembershipIndex[b], 1, RF_bootstrapSize);
+    free_uivector(RF_bootMembershipCount[b], 1, RF_observationSize);
+  }
+}
+void unstackAuxiliary(uint mode, uint b) {
+  uint obsSize;
+  obsSize = 0;  
+  if (!getPredictTerminalFlag(mode)) {
+    free_new_vvector(RF_tNodeMembership[b], 1, RF_observationSize, NRUTIL_NPTR);
+    free_cvector(RF_bootMembershipFlag[b], 1, RF_observationSize);
+    free_cvector(RF_oobMembershipFlag[b], 1, RF_observationSize);
+    free_uivector(RF_ibgMembershipIndex[b], 1, RF_observationSize);
+    free_uivector(RF_oobMembershipIndex[b], 1, RF_observationSize);
+  }
+  if (mode == RF_PRED) {
+    free_new_vvector(RF_ftNodeMembership[b],  1, RF_fobservationSize, NRUTIL_NPTR);
+  }
+  if (RF_ptnCount > 0) {
+    if (mode != RF_PRED) {
+      obsSize = RF_observationSize;
     }
-    mpIndexIter = 1;
-    for (p = 1; p <= RF_rSize; p++) {
-      permuteSize[p] = RF_observationSize;
-      for (i = 1; i <= RF_observationSize; i++) {
-        nonMissIndex[i] = i;
-      }
-      if (RF_mRecordSize > 0) {
-        if (RF_mpIndex[mpIndexIter] < 0) {
-          unsignedIndexSource = (uint) abs(RF_mpIndex[p]);
-          if (unsignedIndexSource == p) {
-            permuteSize[unsignedIndexSource] = 0;
-            for (i = 1; i <= RF_observationSize; i++) {
-              if (RF_mRecordMap[i] == 0) {
-                nonMissIndex[++(permuteSize[unsignedIndexSource])] = i;
-              }
-              else {
-                if (RF_mpSign[unsignedIndexSource][RF_mRecordMap[i]] == 0) {
-                  nonMissIndex[++(permuteSize[unsignedIndexSource])] = i;
-                }
-              }
-            }
-            mpIndexIter++;
-          }
-        }
-      }  
-      if(nullSplitShadowFlag[p]) {
-        permute (1, treeID, permuteSize[p], permuteIndex);
-        for (i = 1; i <= permuteSize[p]; i++) {
-          RF_response[treeID][p][nonMissIndex[i]] = RF_responseIn[p][nonMissIndex[permuteIndex[i]]];
-        }
-      }
+    else {
+      obsSize = RF_fobservationSize;
     }
-    if (RF_timeIndex > 0) {
-      RF_time[treeID] = RF_response[treeID][RF_timeIndex];
-      RF_masterTimeIndex[treeID] = uivector(1, RF_observationSize);
-      updateTimeIndexArray(treeID,
-                           NULL,
-                           RF_observationSize,
-                           RF_time[treeID],
-                           TRUE,
-                           FALSE,
-                           RF_masterTimeIndex[treeID]);
+    free_new_vvector(RF_pNodeMembership[b], 1, obsSize, NRUTIL_NPTR);
+  }
+}
+void stackNodeAndTermList(uint treeID, uint length) {
+  uint temp;
+  uint size; 
+  if (length == 0) {
+    temp = ((RF_minimumNodeSize - 1 ) << 1);
+    if (RF_observationSize > temp) { 
+      size = RF_observationSize - temp;
     }
-    if (RF_statusIndex > 0) {
-      RF_status[treeID] =  RF_response[treeID][RF_statusIndex];
+    else {
+      size = 1;
     }
   }
   else {
-    if (RF_mResponseFlag == TRUE) {
-      RF_response[treeID] = (double **) new_vvector(1, RF_rSize, NRUTIL_DPTR);
-      for (p = 1; p <= RF_rSize; p++) {
-        RF_response[treeID][p] = RF_responseIn[p];
-      }
-      for (p = 1; p <= RF_mpIndexSize; p++) {
-        if (RF_mpIndex[p] < 0) {
-          RF_response[treeID][(uint) abs(RF_mpIndex[p])] = dvector(1, RF_observationSize);
-          for (i = 1; i <= RF_observationSize; i++) {
-            RF_response[treeID][(uint) abs(RF_mpIndex[p])][i] = RF_responseIn[(uint) abs(RF_mpIndex[p])][i];
-          }
-        }
-        else {
-          p = RF_mpIndexSize;
-        }
-      }
-      if (RF_timeIndex > 0) {
-        RF_time[treeID] = RF_response[treeID][RF_timeIndex];
-        if (RF_mTimeFlag == TRUE) {
-          RF_masterTimeIndex[treeID] = uivector(1, RF_observationSize);
-          for (i = 1; i <= RF_observationSize; i++) {
-            RF_masterTimeIndex[treeID][i] = RF_masterTimeIndexIn[i];
-          }
-        }
-        else {
-          RF_masterTimeIndex[treeID] = RF_masterTimeIndexIn;
-        }
-      }
-      if (RF_statusIndex > 0) {
-        RF_status[treeID] =  RF_response[treeID][RF_statusIndex];
-      }
+    size = length;
+  }
+  RF_tNodeListLength[treeID]  = size;
+  RF_tNodeList[treeID] = (Node **) new_vvector(1, size , NRUTIL_NPTR);
+  RF_tTermList[treeID] = (Terminal **) new_vvector(1, size, NRUTIL_TPTR);
+}
+void unstackNodeList(uint treeID) {
+  if (RF_tNodeListLength[treeID] > 0) {
+    free_new_vvector(RF_tNodeList[treeID], 1, RF_tNodeListLength[treeID], NRUTIL_NPTR);
+  }
+}
+void unstackTermList(uint treeID) {
+  if (RF_tNodeListLength[treeID] > 0) {
+    free_new_vvector(RF_tTermList[treeID], 1, RF_tNodeListLength[treeID], NRUTIL_NPTR);
+  }
+}
+void stackAndInitTermMembership(uint mode, uint treeID) {
+  uint j;
+  if (getPredictTerminalFlag(mode)) {
+    RF_tTermMembership[treeID] = NULL;
+  }
+  else {
+    RF_tTermMembership[treeID] = (Terminal **) new_vvector(1, RF_observationSize, NRUTIL_TPTR);
+    for (j = 1; j <= RF_observationSize; j++) {
+      RF_tTermMembership[treeID][j] = RF_tTermList[treeID][RF_tNodeMembership[treeID][j] -> nodeID];
     }
   }
-  if (RF_opt & OPT_SPLT_NULL) {
-    free_uivector(nonMissIndex, 1, RF_observationSize);
-    free_uivector(permuteIndex, 1, RF_observationSize);
-    free_uivector(permuteSize,  1, RF_rSize);
-    free_cvector(nullSplitShadowFlag, 1, RF_rSize);
+  if (mode == RF_PRED) {
+    RF_ftTermMembership[treeID] = (Terminal **) new_vvector(1, RF_fobservationSize, NRUTIL_TPTR);
+    for (j = 1; j <= RF_fobservationSize; j++) {
+      RF_ftTermMembership[treeID][j] = RF_tTermList[treeID][RF_ftNodeMembership[treeID][j] -> nodeID];
+    }
+  }
+}
+void unstackTermMembership(uint mode, uint treeID) {
+  if (!getPredictTerminalFlag(mode)) {
+    free_new_vvector(RF_tTermMembership[treeID], 1, RF_observationSize, NRUTIL_TPTR);
   }
   if (mode == RF_PRED) {
-    if (RF_frSize > 0) {
-      if (RF_fmResponseFlag == TRUE) {
-        RF_fresponse[treeID] = (double **) new_vvector(1, RF_rSize, NRUTIL_DPTR);
-        for (p = 1; p <= RF_frSize; p++) {
-          RF_fresponse[treeID][p] = RF_fresponseIn[p];
-        }
-        for (p = 1; p <= RF_fmpIndexSize; p++) {
-          if (RF_fmpIndex[p] < 0) {
-            RF_fresponse[treeID][(uint) abs(RF_fmpIndex[p])] = dvector(1, RF_fobservationSize);
-            for (i = 1; i <= RF_fobservationSize; i++) {
-              RF_fresponse[treeID][(uint) abs(RF_fmpIndex[p])][i] = RF_fresponseIn[(uint) abs(RF_fmpIndex[p])][i];
-            }
-          }
-          else {
-            p = RF_fmpIndexSize;
-          }
-        }
-      }
+    free_new_vvector(RF_ftTermMembership[treeID], 1, RF_fobservationSize, NRUTIL_TPTR);
+  }
+}
+Node *getTerminalNode(uint treeID, uint leaf) {
+  uint i, j;
+  Node *parent;
+  parent = NULL;
+  for (j = 1; j <= RF_observationSize; j++) {
+    if ((RF_tNodeMembership[treeID][j] -> nodeID) == leaf) {
+      parent = RF_tNodeMembership[treeID][j];
+      j = RF_observationSize;
     }
   }
-  if (RF_rFactorCount + RF_xFactorCount > 0) {
-    RF_factorList[treeID] = (Factor **) new_vvector(1, RF_maxFactorLevel, NRUTIL_FPTR);
-    for (j = 1; j <= RF_maxFactorLevel; j++) {
-      RF_factorList[treeID][j] = NULL;
+  if (parent == NULL) {
+    Rprintf("\nDiagnostic Trace of (individual, boot, node, leaf) vectors in data set:  ");
+    Rprintf("\n        index         boot         node         leaf \n");
+    for (i = 1; i <= RF_observationSize; i++) {
+      Rprintf(" %12d %12d %12x %12d \n", i,
+              RF_bootMembershipFlag[treeID][i], RF_tNodeMembership[treeID][i],
+              RF_tNodeMembership[treeID][i] -> nodeID);
     }
-    for (j = 1; j <= RF_xFactorCount; j++) {
-      if (RF_factorList[treeID][RF_xFactorSize[j]] == NULL) {
-        RF_factorList[treeID][RF_xFactorSize[j]] = makeFactor(RF_xFactorSize[j], FALSE);
+    Rprintf("\nDiagnostic State of TRAIN (SHADOW) data:  ");
+    Rprintf("\n       index       status         time   observations -> \n");
+    Rprintf("\n                                      ");
+    for (i=1; i <= RF_xSize; i++) {
+      Rprintf(" %12d", i);
+    }
+    Rprintf("\n");
+    for (j = 1; j <= RF_observationSize; j++) {
+      Rprintf("%12d %12.4f %12.4f", j, RF_status[treeID][j], RF_time[treeID][j]);
+      for (i=1; i <= RF_xSize; i++) {
+        Rprintf(" %12.4f", (RF_observation[treeID][i][j]));
       }
+      Rprintf("\n");
     }
-    for (j = 1; j <= RF_rFactorCount; j++) {
-      if (RF_factorList[treeID][RF_rFactorSize[j]] == NULL) {
-        RF_factorList[treeID][RF_rFactorSize[j]] = makeFactor(RF_rFactorSize[j], FALSE);
+    Rprintf("\nDiagnostic State of TRAIN (INCOMING) data:  ");
+    Rprintf("\n       index       status         time   observations -> \n");
+    Rprintf("\n                                      ");
+    for (i=1; i <= RF_xSize; i++) {
+      Rprintf(" %12d", i);
+    }
+    Rprintf("\n");
+    for (j = 1; j <= RF_observationSize; j++) {
+      Rprintf("%12d %12.4f %12.4f", j, RF_responseIn[RF_statusIndex][j], RF_responseIn[RF_timeIndex][j]);
+      for (i=1; i <= RF_xSize; i++) {
+        Rprintf(" %12.4f", (RF_observationIn[i][j]));
       }
+      Rprintf("\n");
     }
+    Rprintf("\nRF-SRC:  *** ERROR *** ");
+    Rprintf("\nRF-SRC:  Proxy member for (tree, node) = (%12d, %12d) not found.", treeID, leaf);
+    Rprintf("\nRF-SRC:  Please Contact Technical Support.");
+    error("\nRF-SRC:  The application will now exit.\n");
   }
-  vimpShadowFlag = FALSE;
-  if ((RF_opt & OPT_VIMP) && (RF_opt & OPT_VIMP_TYP1) && !(RF_opt & OPT_VIMP_TYP2)) {
-    vimpShadowFlag = TRUE;
+  return parent;
+}
+void getRawNodeSize(uint  type,
+                    uint  treeID,
+                    Node *parent,
+                    uint *repMembrIndx,
+                    uint *repMembrSize,
+                    uint *allMembrIndx,
+                    uint *allMembrSize) {
+  uint      obsSize;
+  Node   ***nodeMembershipPtr;
+  uint      bootMembrSize;
+  uint i;
+  obsSize           = 0;     
+  nodeMembershipPtr = NULL;  
+  switch (type) {
+  case RF_PRED:
+    obsSize = RF_fobservationSize;
+    nodeMembershipPtr = RF_ftNodeMembership;
+    break;
+  default:
+    obsSize = RF_observationSize;
+    nodeMembershipPtr = RF_tNodeMembership;
+    break;
   }
-  if(vimpShadowFlag == TRUE) {
-    RF_observation[treeID] = dmatrix(1, RF_xSize, 1, RF_observationSize);
-    for (p = 1; p <= RF_xSize; p++) {
-      for (i = 1; i <= RF_observationSize; i++) {
-        RF_observation[treeID][p][i] = RF_observationIn[p][i];
-      }
+  bootMembrSize = RF_bootstrapSize;
+  *repMembrSize = 0;
+  for (i=1; i <= bootMembrSize; i++) {
+    if (RF_tNodeMembership[treeID][RF_bootMembershipIndex[treeID][i]] == parent) {
+      repMembrIndx[++(*repMembrSize)] = RF_bootMembershipIndex[treeID][i];
     }
   }
-  else {
-    if(RF_mPredictorFlag == TRUE) {
-      RF_observation[treeID] = (double **) new_vvector(1, RF_xSize, NRUTIL_DPTR);
-      for (p = 1; p <= RF_xSize; p++) {
-        RF_observation[treeID][p] = RF_observationIn[p];
-      }
-      for (p = 1; p <= RF_mpIndexSize; p++) {
-        if (RF_mpIndex[p] > 0) {
-          RF_observation[treeID][(uint) RF_mpIndex[p]] = dvector(1, RF_observationSize);
-          for (i = 1; i <= RF_observationSize; i++) {
-            RF_observation[treeID][(uint) RF_mpIndex[p]][i] = RF_observationIn[(uint) RF_mpIndex[p]][i];
-          }
-        }
-      }
+  *allMembrSize = 0;
+  for (i=1; i <= obsSize; i++) {
+    if (nodeMembershipPtr[treeID][i] == parent) {
+      allMembrIndx[++(*allMembrSize)] = i;
     }
   }
-  if (mode == RF_PRED) {
-    if(vimpShadowFlag == TRUE) {
-      RF_fobservation[treeID] = dmatrix(1, RF_xSize, 1, RF_fobservationSize);
-      for (p = 1; p <= RF_xSize; p++) {
-        for (i = 1; i <= RF_fobservationSize; i++) {
-          RF_fobservation[treeID][p][i] = RF_fobservationIn[p][i];
-        }
-      }
-    }
-    else {
-      if(RF_fmPredictorFlag == TRUE) {
-        RF_fobservation[treeID] = (double **) new_vvector(1, RF_xSize, NRUTIL_DPTR);
-        for (p = 1; p <= RF_xSize; p++) {
-          RF_fobservation[treeID][p] = RF_fobservationIn[p];
-        }
-        for (p = 1; p <= RF_fmpIndexSize; p++) {
-          if (RF_fmpIndex[p] > 0) {
-            RF_fobservation[treeID][(uint) RF_fmpIndex[p]] = dvector(1, RF_fobservationSize);
-            for (i = 1; i <= RF_fobservationSize; i++) {
-              RF_fobservation[treeID][(uint) RF_fmpIndex[p]][i] = RF_fobservationIn[(uint) RF_fmpIndex[p]][i];
-            }
-          }
-        }
-      }
-    }
-  }  
 }
-void unstackShadow (uint mode, uint treeID, char respFlag, char covrFlag) {
-  char vimpShadowFlag;
-  uint k, p;
-  if (respFlag) {
-    if (RF_opt & OPT_SPLT_NULL) {
-      for (p = 1; p <= RF_rSize; p++) {
-        free_dvector(RF_response[treeID][p], 1, RF_observationSize);
-      }
-      free_new_vvector(RF_response[treeID], 1, RF_rSize, NRUTIL_DPTR);
-      if (RF_timeIndex > 0) {
-        free_uivector(RF_masterTimeIndex[treeID], 1, RF_observationSize);
-      }
+char forkAndUpdate(uint    treeID,
+                   Node   *parent,
+                   uint   *repMembrIndx,
+                   uint    repMembrSize,
+                   uint   *allMembrIndx,
+                   uint    allMembrSize,
+                   uint    splitParameterMax,
+                   double  splitValueMaxCont,
+                   uint    splitValueMaxFactSize,
+                   uint   *splitValueMaxFactPtr,
+                   double  splitStatistic,
+                   char   *localSplitIndicator,
+                   char    multImpFlag,
+                   char   *membershipIndicator,
+                   uint   *leftDaughterSize,
+                   uint   *rghtDaughterSize) {
+  char factorFlag;
+  char daughterFlag;
+  char result;
+  uint i;
+  factorFlag = FALSE; 
+  result = forkNode(parent,
+                    splitParameterMax,
+                    splitValueMaxCont,
+                    splitValueMaxFactSize,
+                    splitValueMaxFactPtr);
+  if (result == TRUE) {
+    parent -> splitStatistic = splitStatistic;
+    RF_tLeafCount[treeID]++;
+    ((parent -> left) -> nodeID) = (parent -> nodeID);
+    ((parent -> right) -> nodeID) = RF_tLeafCount[treeID];
+    factorFlag = FALSE;
+    if (strcmp(RF_xType[splitParameterMax], "C") == 0) {
+      factorFlag = TRUE;
     }
-    else {
-      if (RF_mResponseFlag == TRUE) {
-        for (p = 1; p <= RF_mpIndexSize; p++) {
-          if (RF_mpIndex[p] < 0) {
-            free_dvector(RF_response[treeID][(uint) abs(RF_mpIndex[p])], 1, RF_observationSize);
-          }
-          else {
-            p = RF_mpIndexSize;
-          }
-        }
-        free_new_vvector(RF_response[treeID], 1, RF_rSize, NRUTIL_DPTR);
-        if (RF_timeIndex > 0) {
-          if (RF_mTimeFlag == TRUE) {
-            free_uivector(RF_masterTimeIndex[treeID], 1, RF_observationSize);
-          }
-        }
-      }
+    *leftDaughterSize = *rghtDaughterSize = 0;
+    for (i = 1; i <= allMembrSize; i++) {
+      membershipIndicator[allMembrIndx[i]] = NEITHER;
     }
-    if (mode == RF_PRED) {
-      if (RF_frSize > 0) {
-        if (RF_fmResponseFlag == TRUE) {
-          for (p = 1; p <= RF_fmpIndexSize; p++) {
-            if (RF_fmpIndex[p] < 0) {
-              free_dvector(RF_fresponse[treeID][(uint) abs(RF_fmpIndex[p])], 1, RF_fobservationSize);
-            }
-            else {
-              p = RF_fmpIndexSize;
-            }
-          }
-          free_new_vvector(RF_fresponse[treeID], 1, RF_rSize, NRUTIL_DPTR);
-        }
-      }
+    for (i = 1; i <= repMembrSize; i++) {
+      membershipIndicator[repMembrIndx[i]] = localSplitIndicator[i];
     }
-    if (RF_rFactorCount + RF_xFactorCount > 0) {
-      if (RF_factorList[treeID] != NULL) {
-        for (k = 1; k <= RF_maxFactorLevel; k++) {
-          if (RF_factorList[treeID][k] != NULL) {
-            free_Factor(RF_factorList[treeID][k]);
-          }
+    for (i = 1; i <= allMembrSize; i++) {
+      if(membershipIndicator[allMembrIndx[i]] == NEITHER) {
+        daughterFlag = RIGHT;
+        if (factorFlag == TRUE) {
+          daughterFlag = splitOnFactor((uint) RF_observation[treeID][splitParameterMax][allMembrIndx[i]], splitValueMaxFactPtr);
         }
-        free_new_vvector(RF_factorList[treeID], 1, RF_maxFactorLevel, NRUTIL_FPTR);
-        RF_factorList[treeID] = NULL;
-      }
-    }
-  }
-  if (covrFlag) {
-    vimpShadowFlag = FALSE;
-    if ((RF_opt & OPT_VIMP) && (RF_opt & OPT_VIMP_TYP1) && !(RF_opt & OPT_VIMP_TYP2)) {
-      vimpShadowFlag = TRUE;
-    }
-    if(vimpShadowFlag == TRUE) {
-      free_dmatrix(RF_observation[treeID], 1, RF_xSize, 1, RF_observationSize);
-    }
-    else {
-      if(RF_mPredictorFlag == TRUE) {
-        for (p = 1; p <= RF_mpIndexSize; p++) {
-          if (RF_mpIndex[p] > 0) {
-            free_dvector(RF_observation[treeID][(uint) RF_mpIndex[p]], 1, RF_observationSize);
+        else {
+          if (RF_observation[treeID][splitParameterMax][allMembrIndx[i]] <= splitValueMaxCont) {
+            daughterFlag = LEFT;
           }
         }
-        free_new_vvector(RF_observation[treeID], 1, RF_xSize, NRUTIL_DPTR);
-      }
-    }
-    if (mode == RF_PRED) {
-      if(vimpShadowFlag == TRUE) {
-        free_dmatrix(RF_fobservation[treeID], 1, RF_xSize, 1, RF_fobservationSize);
+        membershipIndicator[allMembrIndx[i]] = daughterFlag;
       }
       else {
-        if(RF_fmPredictorFlag == TRUE) {
-          for (p = 1; p <= RF_fmpIndexSize; p++) {
-            if (RF_fmpIndex[p] > 0) {
-              free_dvector(RF_fobservation[treeID][(uint) RF_fmpIndex[p]], 1, RF_fobservationSize);
-            }
-          }
-          free_new_vvector(RF_fobservation[treeID], 1, RF_xSize, NRUTIL_DPTR);
-        }
+        daughterFlag = membershipIndicator[allMembrIndx[i]];
       }
-    }
-  }
-}
-char xferMissingness(uint mode, Node *source, Terminal *destination) {
-  uint   *sourceIndexPtr;
-  double *sourceValuePtr;
-  uint   *sourceAllocSizePtr;
-  uint   *sourceActualSizePtr;
-  char result;
-  char xferFlag;
-  sourceIndexPtr = NULL;  
-  sourceValuePtr = NULL;  
-  sourceAllocSizePtr = NULL;  
-  sourceActualSizePtr = NULL;  
-  result = FALSE;
-  if (mode != RF_PRED) {
-    if (RF_mRecordSize > 0) {
-      result = TRUE;
-      sourceIndexPtr = source -> lmpIndex;
-      sourceValuePtr = source -> lmpValue;
-      sourceAllocSizePtr = & (source -> lmpIndexAllocSize);
-      sourceActualSizePtr = & (source -> lmpIndexActualSize);
-    }
+      if (daughterFlag == LEFT) {
+        (*leftDaughterSize) ++;
+        RF_tNodeMembership[treeID][allMembrIndx[i]] = parent -> left;
+      }
+      else {
+        (*rghtDaughterSize) ++;
+        RF_tNodeMembership[treeID][allMembrIndx[i]] = parent -> right;
+      }
+    }  
   }
   else {
-    if (RF_fmRecordSize > 0) {
-      result = TRUE;
-      sourceIndexPtr = source -> flmpIndex;
-      sourceValuePtr = source -> flmpValue;
-      sourceAllocSizePtr = & (source -> flmpIndexAllocSize);
-      sourceActualSizePtr = & (source -> flmpIndexActualSize);
-    }
-  }
-  if (result == FALSE) {
     RFprintf("\nRF-SRC:  *** ERROR *** ");
-    RFprintf("\nRF-SRC:  Attempt to update forest impute data with no missingness in mode:  %10d", mode);
+    RFprintf("\nRF-SRC:  forkNode() failed.");
     RFprintf("\nRF-SRC:  Please Contact Technical Support.");
     error("\nRF-SRC:  The application will now exit.\n");
   }
-  if (*sourceActualSizePtr > 0) {
-    (destination -> lmiIndex) = sourceIndexPtr;
-    (destination -> lmiValue) = sourceValuePtr;
-    (destination -> lmiSize)  = *sourceActualSizePtr;
-    (destination -> lmiAllocSize)  = *sourceAllocSizePtr;    
-    sourceIndexPtr = NULL;
-    sourceValuePtr = NULL;
-    *sourceAllocSizePtr  = 0;
-    *sourceActualSizePtr  = 0;
-    xferFlag = TRUE;
+  if (localSplitIndicator != NULL) {
+    free_cvector(localSplitIndicator, 1, repMembrSize);
   }
   else {
-    xferFlag = FALSE;
+    RFprintf("\nRF-SRC:  *** ERROR *** ");
+    RFprintf("\nRF-SRC:  NULL Local Split Indicator encountered in forkAndUpdate().");
+    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+    error("\nRF-SRC:  The application will now exit.\n");
   }
-  return xferFlag;
+  return result;
 }
-char getMarginalNodeMembership(uint     mode,
-                               char     rootFlag,
-                               uint     treeID,
-                               Node    *parent,
-                               uint    *allMembrIndx,
-                               uint     allMembrSize,
-                               double **observationPtr) {
+char growTree (uint     r,
+               char     rootFlag,
+               char     multImpFlag,
+               uint     treeID,
+               Node    *parent,
+               uint    *repMembrIndx,
+               uint     repMembrSize,
+               uint    *allMembrIndx,
+               uint     allMembrSize,
+               uint     depth,
+               uint    *maximumDepth,
+               uint    *bootMembrIndxIter) {
   char  bootResult;
+  char  splitResult;
+  char  forkResult;
   char leftResult, rghtResult;
   char terminalFlag;
+  char bsUpdateFlag;
+  uint *bootMembrIndx;
+  uint *leftRepMembrIndx;
+  uint *rghtRepMembrIndx;
   uint *leftAllMembrIndx;
   uint *rghtAllMembrIndx;
+  uint bootMembrSize;
   uint leftAllMembrSize;
   uint rghtAllMembrSize;
-  uint jLeft;
-  uint jRght;
-  char factorFlag;
-  char daughterFlag;
-  uint obsSize;
-  uint i, j;
-  factorFlag = FALSE; 
+  uint leftRepMembrSize;
+  uint rghtRepMembrSize;
+  char *membershipIndicator;
+  uint     splitParameterMax;
+  double   splitValueMaxCont;
+  uint     splitValueMaxFactSize;
+  uint    *splitValueMaxFactPtr;
+  double   splitStatistic;
+  char    *splitIndicator;
+  uint i, k, p;
+  parent -> depth = depth;
+  bootResult = TRUE;
   terminalFlag = TRUE;
-  if (mode != RF_PRED) {
-    obsSize = RF_observationSize;
-  }
-  else {
-    obsSize = RF_fobservationSize;
+  bsUpdateFlag = FALSE;
+  splitIndicator = NULL;
+  if (rootFlag) {
+    stackSplitPartition(treeID);
   }
-  if (RF_tLeafCount[treeID] > 0) {
-    bootResult = TRUE;
-    if (((parent -> left) != NULL) && ((parent -> right) != NULL)) {
-      terminalFlag = FALSE;
-      leftAllMembrIndx = rghtAllMembrIndx = NULL;
-      leftAllMembrSize = rghtAllMembrSize = 0;
-      uint *membershipIndicator = uivector(1, obsSize);
-      leftAllMembrSize = rghtAllMembrSize = 0;
-      daughterFlag = RIGHT;
-      if (daughterFlag != NEITHER) {
-        factorFlag = FALSE;
-        if (strcmp(RF_xType[parent -> splitParameter], "C") == 0) {
-          factorFlag = TRUE;
+  if (rootFlag | (RF_opt & OPT_BOOT_NODE)) {
+    if (!(RF_opt & OPT_BOOT_NONE) && !(RF_opt & OPT_BOOT_NODE)) {
+      bootMembrIndx  = uivector(1, RF_bootstrapSize);
+      bootMembrSize = RF_bootstrapSize;
+    }
+    else {
+      bootMembrIndx  = uivector(1, allMembrSize);
+      bootMembrSize = allMembrSize;
+    }
+    bootResult = bootstrap (RF_GROW,
+                            treeID,
+                            parent,
+                            allMembrIndx,
+                            allMembrSize,
+                            bootMembrIndx,
+                            bootMembrSize);
+    if (rootFlag & bootResult) {
+      if (!(RF_opt & OPT_BOOT_NODE)) {
+        bsUpdateFlag = TRUE;
+        for (i = 1; i <= bootMembrSize; i++) {
+          RF_bootMembershipIndex[treeID][++(*bootMembrIndxIter)] = bootMembrIndx[i];
         }
-        for (i = 1; i <= allMembrSize; i++) {
-          daughterFlag = RIGHT;
-          if (factorFlag == TRUE) {
-            daughterFlag = splitOnFactor((uint) observationPtr[parent -> splitParameter][allMembrIndx[i]], parent -> splitValueFactPtr);
+      }
+      if (RF_optHigh & OPT_SORT_ONCE) {
+        stackPresortIndex(treeID, bootMembrIndx, bootMembrSize);
+      }
+      if (RF_mRecordSize > 0) {
+        if (TRUE) {
+          for (p = 1; p <= RF_mpIndexSize; p++) {
+            if (RF_mpIndex[p] > 0) {
+              if (parent -> mpSign[p] == -1) {
+                (parent -> permissibleSplit)[RF_mpIndex[p]] = FALSE;
+              }
+            }
           }
-          else {
-            if ( observationPtr[parent -> splitParameter][allMembrIndx[i]] <= (parent -> splitValueCont) ) {
-              daughterFlag = LEFT;
+        }
+        else {
+          k = 0;
+          for (p = 1; p <= RF_xSize; p++) {      
+            if (parent -> mpSign[RF_rSize + p] != -1) {
+              parent -> permissibleSplitIndex[++k] = p;
             }
           }
-          membershipIndicator[allMembrIndx[i]] = daughterFlag;
-          if (daughterFlag == LEFT) {
-            leftAllMembrSize ++;
+          parent -> permissibleSizeActual = k;
+        }
+      }
+      else {
+        if (FALSE) {
+          for (p = 1; p <= RF_xSize; p++) {      
+            parent -> permissibleSplitIndex[p] = p;
           }
-          else {
-            rghtAllMembrSize ++;
+          parent -> permissibleSizeActual = parent -> permissibleSizeAlloc;
+        }
+      }
+    }
+  }
+  else {
+    bootMembrIndx = repMembrIndx;
+    bootMembrSize = repMembrSize;
+    parent -> mpSign = (parent -> parent) -> mpSign;
+  }
+  if (bootResult) {
+    if (multImpFlag == FALSE) {
+      if (RF_mRecordSize > 0) {
+        imputeNode(RF_GROW,
+                   FALSE,  
+                   TRUE,   
+                   treeID,
+                   parent,
+                   bootMembrIndx,
+                   bootMembrSize,
+                   allMembrIndx,
+                   allMembrSize);
+        if (RF_timeIndex > 0) {
+          if (RF_mTimeFlag == TRUE) {
+            updateTimeIndexArray(treeID,
+                                 allMembrIndx,
+                                 allMembrSize,
+                                 RF_time[treeID],
+                                 FALSE,
+                                 FALSE,
+                                 RF_masterTimeIndex[treeID]);
           }
-        }  
-      }  
-      leftAllMembrIndx  = uivector(1, leftAllMembrSize + 1);
-      rghtAllMembrIndx  = uivector(1, rghtAllMembrSize + 1);
-      jLeft = jRght = 0;
-      if (daughterFlag == NEITHER) {
-        for (i = 1; i <= allMembrSize; i++) {
-          leftAllMembrIndx[++jLeft] = allMembrIndx[i];
-          rghtAllMembrIndx[++jRght] = allMembrIndx[i];
         }
-      }
-      else {
-        for (i = 1; i <= allMembrSize; i++) {
-          if (membershipIndicator[allMembrIndx[i]] == LEFT) {
-            leftAllMembrIndx[++jLeft] = allMembrIndx[i];
-          }
-          else {
-            rghtAllMembrIndx[++jRght] = allMembrIndx[i];
-          }
+      }
+    }  
+  }  
+  if (bootResult) {
+    if (rootFlag) {
+      RF_tLeafCount[treeID] = 1;
+    }
+    splitResult = getBestSplit(treeID,
+                               parent,
+                               bootMembrIndx,
+                               bootMembrSize,
+                               allMembrIndx,
+                               allMembrSize,
+                               & splitParameterMax,
+                               & splitValueMaxCont,
+                               & splitValueMaxFactSize,
+                               & splitValueMaxFactPtr,
+                               & splitStatistic,
+                               & splitIndicator,
+                               multImpFlag);
+    if (splitResult == TRUE) {
+      if (FALSE) {
+        parent -> permissibleSizeActual = parent -> permissibleSizeAlloc;
+      }
+      else {
+      }
+      terminalFlag = FALSE;
+      membershipIndicator = RF_splitMembershipFlag[treeID];
+      forkResult = forkAndUpdate(treeID,
+                                 parent,
+                                 bootMembrIndx,
+                                 bootMembrSize,
+                                 allMembrIndx,
+                                 allMembrSize,
+                                 splitParameterMax,
+                                 splitValueMaxCont,
+                                 splitValueMaxFactSize,
+                                 splitValueMaxFactPtr,
+                                 splitStatistic,
+                                 splitIndicator,
+                                 multImpFlag,
+                                 membershipIndicator,
+                                 &leftAllMembrSize,
+                                 &rghtAllMembrSize);
+      if (forkResult == TRUE) {
+        partitionMembership(treeID, allMembrIndx, allMembrSize, membershipIndicator);
+        leftAllMembrIndx = allMembrIndx;
+        rghtAllMembrIndx = allMembrIndx + leftAllMembrSize;
+        if (RF_opt & OPT_BOOT_NODE) {
+          leftRepMembrIndx = leftAllMembrIndx;
+          leftRepMembrSize = leftAllMembrSize;
+          rghtRepMembrIndx = rghtAllMembrIndx;
+          rghtRepMembrSize = rghtAllMembrSize;
+        }
+        else {
+          if (RF_optHigh & OPT_SORT_ONCE) {
+            partitionPresortIndex(treeID,
+                                  parent,
+                                  bootMembrIndx,
+                                  bootMembrSize,
+                                  membershipIndicator);
+          }
+          leftRepMembrSize = partitionMembership(treeID, bootMembrIndx, bootMembrSize, membershipIndicator);
+          rghtRepMembrSize = bootMembrSize - leftRepMembrSize;
+          leftRepMembrIndx = bootMembrIndx;
+          rghtRepMembrIndx = bootMembrIndx + leftRepMembrSize;
+        }
+        leftResult = growTree (r,
+                               FALSE,
+                               multImpFlag,
+                               treeID,
+                               parent -> left,
+                               leftRepMembrIndx,
+                               leftRepMembrSize,
+                               leftAllMembrIndx,
+                               leftAllMembrSize,
+                               (parent -> depth) + 1,
+                               maximumDepth,
+                               bootMembrIndxIter);
+        if(!leftResult) {
+        }
+        rghtResult = growTree (r,
+                               FALSE,
+                               multImpFlag,
+                               treeID,
+                               parent -> right,
+                               rghtRepMembrIndx,
+                               rghtRepMembrSize,
+                               rghtAllMembrIndx,
+                               rghtAllMembrSize,
+                               (parent -> depth) + 1,
+                               maximumDepth,
+                               bootMembrIndxIter);
+        if(!rghtResult) {
         }
       }
-      free_uivector(membershipIndicator, 1, obsSize);
-      leftResult = getMarginalNodeMembership(mode,
-                                             FALSE,
-                                             treeID,
-                                             parent -> left,
-                                             leftAllMembrIndx,
-                                             leftAllMembrSize,
-                                             observationPtr);
-      if(!leftResult) {
-      }
-      rghtResult = getMarginalNodeMembership(mode,
-                                             FALSE,
-                                             treeID,
-                                             parent -> right,
-                                             rghtAllMembrIndx,
-                                             rghtAllMembrSize,
-                                             observationPtr);
-      if(!rghtResult) {
+      else {
+        RFprintf("\nRF-SRC:  *** ERROR *** ");
+        RFprintf("\nRF-SRC:  forkAndUpdate(%10d) failed.", treeID);
+        RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+        error("\nRF-SRC:  The application will now exit.\n");
       }
-      free_uivector(leftAllMembrIndx, 1, leftAllMembrSize + 1);
-      free_uivector(rghtAllMembrIndx, 1, rghtAllMembrSize + 1);
     }  
     else {
+      parent -> splitFlag = FALSE;
+      if (TRUE) {
+        free_cvector(parent -> permissibleSplit, 1, parent -> xSize);
+        parent -> permissibleSplit = NULL;
+        parent -> xSize = 0;
+      }
+      else {
+        free_uivector(parent -> permissibleSplitIndex, 1, parent -> permissibleSizeAlloc);
+        parent -> permissibleSplitIndex = NULL;
+        parent -> permissibleSizeAlloc = 0;
+      }
     }
   }  
   else {
     if (rootFlag) {
-      bootResult = FALSE;
-      terminalFlag = FALSE;
+      if (!bootResult) {
+        terminalFlag = FALSE;
+      }
     }
-  }
+  }  
   if (terminalFlag) {
-    for (i = 1; i <= allMembrSize; i++) {
-      RF_utTermMembership[treeID][allMembrIndx[i]][++ RF_utTermMembershipCount[treeID][allMembrIndx[i]]] = (parent -> nodeID);
-      if ((RF_utTermMembershipCount[treeID][allMembrIndx[i]]) == (RF_utTermMembershipAlloc[treeID][allMembrIndx[i]] * MARGINAL_SIZE)) {
-        RF_utTermMembershipAlloc[treeID][allMembrIndx[i]] ++;
-        uint *utTermMembershipNew = uivector(1, RF_utTermMembershipAlloc[treeID][allMembrIndx[i]] * MARGINAL_SIZE);
-        for (j = 1; j <= RF_utTermMembershipCount[treeID][allMembrIndx[i]]; j++) {
-          utTermMembershipNew[j] = RF_utTermMembership[treeID][allMembrIndx[i]][j];
-        }
-        free_uivector(RF_utTermMembership[treeID][allMembrIndx[i]], 1, (RF_utTermMembershipAlloc[treeID][allMembrIndx[i]] - 1) * MARGINAL_SIZE);
-        RF_utTermMembership[treeID][allMembrIndx[i]] = utTermMembershipNew;
+    parent -> pseudoTerminal = TRUE;
+    RF_tNodeList[treeID][parent -> nodeID] = parent;
+    RF_tTermList[treeID][parent -> nodeID] = makeTerminal();
+    RF_tTermList[treeID][parent -> nodeID] -> nodeID = parent -> nodeID;
+    if (RF_opt & OPT_MISS) {
+      imputeNodeAndSummarize(r,
+                             RF_GROW,
+                             treeID,
+                             parent,
+                             bootMembrIndx,
+                             bootMembrSize,
+                             allMembrIndx,
+                             allMembrSize,
+                             NULL,
+                             0);
+    }
+    if ((RF_opt & OPT_PERF) |
+        (RF_opt & OPT_PERF_CALB) |
+        (RF_opt & OPT_OENS) |
+        (RF_opt & OPT_FENS)) {
+      updateTerminalNodeOutcomesNew(treeID,
+                                    RF_tTermList[treeID][parent -> nodeID],
+                                    bootMembrIndx,
+                                    bootMembrSize,
+                                    allMembrIndx,
+                                    allMembrSize);
+    }
+    if (RF_opt & OPT_BOOT_NODE) {
+      bsUpdateFlag = TRUE;
+      for (i = 1; i <= bootMembrSize; i++) {
+        RF_bootMembershipIndex[treeID][++(*bootMembrIndxIter)] = bootMembrIndx[i];
       }
     }
+    if (RF_opt & (OPT_SPLDPTH_F | OPT_SPLDPTH_T)) {
+      getSplitDepth(parent, maximumDepth);
+    }
   }  
-  return bootResult;
-}
-void acquireTree(uint mode, uint r, uint b) {
-  Node  *rootPtr;
-  uint **mwcpPtrPtr;
-  uint   nodeOffset;
-  char multImpFlag;
-  uint *allMembrIndx;
-  uint *fallMembrIndx;
-  uint bootMembrIndxIter;
-  char  result;
-  Node     ***gNodeMembership;
-  Terminal ***gTermMembership;
-  uint     obsSize;
-  uint i;
-  obsSize    = 0;  
-  gNodeMembership = NULL;  
-  gTermMembership = NULL;  
-  multImpFlag = FALSE;
-  if (mode == RF_GROW) {
-    if (r > 1) {
-      multImpFlag = TRUE;
+  if (bsUpdateFlag) {
+    for (i = 1; i <= bootMembrSize; i++) {
+      RF_bootMembershipFlag[treeID][bootMembrIndx[i]] = TRUE;
+      RF_oobMembershipFlag[treeID][bootMembrIndx[i]]  = FALSE;
+      RF_bootMembershipCount[treeID][bootMembrIndx[i]] ++;
     }
-  }
-#ifdef _OPENMP
-#endif
-  rootPtr = makeNode((mode == RF_GROW) ? RF_xSize : 0,
-                     (mode == RF_GROW) ? 0 : 0,
-                     (RF_opt & OPT_USPV_STAT) ? RF_randomResponseCount : 0,  
-                     (mode == RF_GROW) ? ( (RF_opt & OPT_NODE_STAT) ? RF_randomCovariateCount : 0)  : 0);  
-  RF_tNodeMembership[b] = (Node **) new_vvector(1, RF_observationSize, NRUTIL_NPTR);
-  RF_bootMembershipIndex[b] = uivector(1, RF_bootstrapSize);
-  RF_bootMembershipFlag[b] = cvector(1, RF_observationSize);
-  RF_bootMembershipCount[b] = uivector(1, RF_observationSize);
-  RF_oobMembershipFlag[b] = cvector(1, RF_observationSize);
-  RF_ibgMembershipIndex[b] = uivector(1, RF_observationSize);
-  RF_oobMembershipIndex[b] = uivector(1, RF_observationSize);
-  allMembrIndx = uivector(1, RF_observationSize);
-  if (mode == RF_PRED) {
-    RF_ftNodeMembership[b] = (Node **) new_vvector(1, RF_fobservationSize, NRUTIL_NPTR);
-  }
-  if (mode != RF_PRED) {
-    obsSize = RF_observationSize;
-    gNodeMembership = RF_tNodeMembership;
-    gTermMembership = RF_tTermMembership;
-  }
-  else {
-    obsSize = RF_fobservationSize;
-    gNodeMembership = RF_ftNodeMembership;
-    gTermMembership = RF_ftTermMembership;
-  }
-  if (mode == RF_PRED) {
-    fallMembrIndx = uivector(1, RF_fobservationSize);
-  }
-  else {
-    fallMembrIndx = NULL;
-  }
-  if (RF_ptnCount > 0) {
-    RF_pNodeMembership[b] = (Node **) new_vvector(1, obsSize, NRUTIL_NPTR);
-  }
-  stackShadow(mode, b);
-  if (mode == RF_GROW) {
-    if (RF_nImpute > 1) {
-      if (r > 1) {
-        if (RF_mRecordSize > 0) {
-          imputeUpdateShadow(RF_GROW,
-                             RF_response[b],
-                             RF_observation[b]);
-        }
-        if (RF_timeIndex > 0) {
-          if (RF_mTimeFlag == TRUE) {
-            updateTimeIndexArray(0,
-                                 NULL,
-                                 RF_observationSize,
-                                 RF_time[b],
-                                 FALSE,
-                                 FALSE,
-                                 RF_masterTimeIndex[b]);
-          }
-        }
+    if (RF_opt & OPT_MEMB) {
+      for (i=1; i <=  bootMembrSize; i++) {
+        RF_bootstrapMembershipPtr[treeID][bootMembrIndx[i]] ++;
       }
     }
   }
-  rootPtr -> parent = NULL;
-  rootPtr -> nodeID = 1;
-  RF_root[b] = rootPtr;
-  RF_maxDepth[b] = 0;
-  bootMembrIndxIter = 0;
-  for (i = 1; i <= RF_observationSize; i++) {
-    allMembrIndx[i] = i;
-    RF_tNodeMembership[b][i] = RF_root[b];
-    RF_bootMembershipFlag[b][i]  = FALSE;
-    RF_bootMembershipCount[b][i] = 0;
-    RF_oobMembershipFlag[b][i]   = TRUE;
-  }
-  if (RF_ptnCount > 0) {
-    for (i = 1; i <= obsSize; i++) {
-      RF_pNodeMembership[b][i] = gNodeMembership[b][i];
+  if (rootFlag | (RF_opt & OPT_BOOT_NODE)) {
+    if (RF_optHigh & OPT_SORT_ONCE) {
+      unstackPresortIndex(treeID, bootMembrSize);
     }
-  }
-  RF_orderedLeafCount[b] = 0;
-  if (mode == RF_GROW) {
-    RF_tLeafCount[b] = 0;
-    stackNodeAndTermList(b, 0);
-    result = growTree (r,
-                       TRUE,
-                       multImpFlag,
-                       b,
-                       rootPtr,
-                       NULL,
-                       0,
-                       allMembrIndx,
-                       RF_observationSize,
-                       0,
-                       RF_maxDepth + b,
-                       & bootMembrIndxIter);
-    if (result) {
+    if (!(RF_opt & OPT_BOOT_NONE) && !(RF_opt & OPT_BOOT_NODE)) {
+      free_uivector(bootMembrIndx, 1, RF_bootstrapSize);
     }
-  }  
-  else {
-    if (mode == RF_PRED) {
-      for (i=1; i <= RF_fobservationSize; i++) {
-        fallMembrIndx[i] = i;
-        RF_ftNodeMembership[b][i] = RF_root[b];
+    else {
+      free_uivector(bootMembrIndx, 1, allMembrSize);
+    }
+  }
+  if (rootFlag) {
+    unstackSplitPartition(treeID);
+  }
+  return bootResult;
+}
+char restoreTree(uint    mode,
+                 uint    b,
+                 Node   *parent,
+                 uint   *offset,
+                 uint   *treeID,
+                 uint   *nodeID,
+                 uint   *parmID,
+                 double *contPT,
+                 uint   *mwcpSZ,
+                 uint  **mwcpPtr,
+                 uint    depth,
+                 uint   *maximumDepth) {
+  char terminalFlag;
+  uint i;
+  if (b != treeID[*offset]) {
+    RFprintf("\nRF-SRC:  Diagnostic Trace of Tree Record:  \n");
+    RFprintf("\nRF-SRC:      treeID     nodeID     parmID       spltPT     mwcpSZ ");
+    RFprintf("\nRF-SRC:  %10d %10d %10d %12.4f %10d \n", treeID[*offset], nodeID[*offset], parmID[*offset], contPT[*offset], mwcpSZ[*offset]);
+    RFprintf("\nRF-SRC:  *** ERROR *** ");
+    RFprintf("\nRF-SRC:  Invalid forest input record in tree:  %10d", b);
+    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+    error("\nRF-SRC:  The application will now exit.\n");
+  }
+  parent -> depth = depth;
+  parent -> left  = NULL;
+  parent -> right = NULL;
+  parent -> splitFlag = FALSE;
+  parent -> nodeID = nodeID[*offset];
+  parent -> splitParameter = parmID[*offset];
+  if ((parent -> splitParameter) != 0) {
+    if (RF_xFactorSplitFlag[parent -> splitParameter]) {
+      parent -> splitValueFactSize = mwcpSZ[*offset];
+      parent -> splitValueFactPtr = uivector(1, mwcpSZ[*offset]);
+      for (i = 1; i <= parent -> splitValueFactSize; i++) {
+        (*mwcpPtr) ++;
+        (parent -> splitValueFactPtr)[i] = **mwcpPtr;
       }
+      parent -> splitValueCont = NA_REAL;
     }
-    nodeOffset = RF_restoreTreeOffset[b];
-    mwcpPtrPtr = & RF_mwcpPtr[b];
-    if (RF_tLeafCount[b] > 0) {
-      stackNodeAndTermList(b, RF_tLeafCount[b]);
+    else {
+      parent -> splitValueCont = contPT[*offset];
+      parent -> splitValueFactSize = 0;
+      parent -> splitValueFactPtr = NULL;
     }
+  }
+  else {
+    parent -> splitValueCont     = NA_REAL;
+    parent -> splitValueFactSize = 0;
+    parent -> splitValueFactPtr  = NULL;
+  }
+  (*offset) ++;
+  if ((parent -> splitParameter) != 0) {
+    terminalFlag = FALSE;
+    parent -> left  = makeNode(0, 0, parent -> urStatSize, parent -> mtrySize);
+    setParent(parent ->  left, parent);
     restoreTree(mode,
                 b,
-                rootPtr,
-                & nodeOffset,
-                RF_treeID_,
-                RF_nodeID_,
-                RF_parmID_,
-                RF_contPT_,
-                RF_mwcpSZ_,
-                mwcpPtrPtr,
-                0,
-                RF_maxDepth + b);
-    result = restoreNodeMembership(r,
-                                   mode,
-                                   TRUE,
-                                   b,
-                                   rootPtr,
-                                   NULL,
-                                   0,
-                                   allMembrIndx,
-                                   RF_observationSize,
-                                   fallMembrIndx,
-                                   RF_fobservationSize,
-                                   & bootMembrIndxIter);
-    if (result) {
-      if (getRestoreNodeMembershipGrowFlag(mode)) {
-        restoreNodeMembershipGrow(b);
-      }
-    }
-  }  
-  if (result) {
-    stackAndInitTermMembership(mode, b);
-  }  
-  if (result) {
-    if (RF_ptnCount > 0) {
-      for (i = 1; i <= obsSize; i++) {
-        RF_pNodeMembership[b][i] = gNodeMembership[b][i];
-      }
-      RF_pLeafCount[b] = pruneTree(obsSize, b, RF_ptnCount);
-      RF_pNodeList[b] = (Node **) new_vvector(1, RF_pLeafCount[b] + 1, NRUTIL_NPTR);
-      i = 0;
-      getPTNodeList(RF_root[b], RF_pNodeList[b], &i);
-      free_new_vvector(RF_pNodeList[b], 1, RF_pLeafCount[b] + 1, NRUTIL_NPTR);
+                parent -> left,
+                offset,
+                treeID,
+                nodeID,
+                parmID,
+                contPT,
+                mwcpSZ,
+                mwcpPtr,
+                parent -> depth + 1,
+                maximumDepth);
+    parent -> right = makeNode(0, 0, parent -> urStatSize, parent -> mtrySize);
+    setParent(parent -> right, parent);
+    restoreTree(mode,
+                b,
+                parent -> right,
+                offset,
+                treeID,
+                nodeID,
+                parmID,
+                contPT,
+                mwcpSZ,
+                mwcpPtr,
+                parent -> depth + 1,
+                maximumDepth);
+  }
+  else {
+    terminalFlag = TRUE;
+  }
+  if (terminalFlag) {
+    if (RF_opt & (OPT_SPLDPTH_F | OPT_SPLDPTH_T)) {
+      getSplitDepth(parent, maximumDepth);
     }
-    RF_oobSize[b] = 0;
-    RF_ibgSize[b] = 0;
-    for (i=1; i <= RF_observationSize; i++) {
-      if (RF_bootMembershipFlag[b][i] == FALSE) {
-        RF_oobSize[b] ++;
-        RF_oobMembershipIndex[b][RF_oobSize[b]] = i;
+    RF_tNodeList[b][parent -> nodeID] = parent;
+    RF_tTermList[b][parent -> nodeID] = makeTerminal();
+    RF_tTermList[b][parent -> nodeID] -> nodeID = parent -> nodeID;
+    if (getRestoreNodeMembershipGrowFlag(mode)) {
+      RF_tTermList[b][parent -> nodeID] -> membrCount = RF_TN_MCNT_ptr[b][parent -> nodeID];
+      if (RF_tTermList[b][parent -> nodeID] -> membrCount == 0) {
+        RFprintf("\nRF-SRC:  *** ERROR *** ");
+        RFprintf("\nRF-SRC:  Zero node count encountered during fast restore in (tree, leaf):  %10d %10d", b, parent -> nodeID);
+        RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+        error("\nRF-SRC:  The application will now exit.\n");
       }
-      else {
-        RF_ibgSize[b] ++;
-        RF_ibgMembershipIndex[b][RF_ibgSize[b]] = i;
+      if ((RF_opt & OPT_PERF) |
+          (RF_opt & OPT_PERF_CALB) |
+          (RF_opt & OPT_OENS) |
+          (RF_opt & OPT_FENS)) {
+        restoreTerminalNodeOutcomes(b, RF_tTermList[b][parent -> nodeID]);
       }
     }
-    if (mode != RF_PRED) {
-      if (RF_mRecordSize > 0) {
-        for (i = 1; i <= RF_mRecordSize; i++) {
-          if (RF_bootMembershipFlag[b][RF_mRecordIndex[i]] == TRUE) {
-            RF_dmRecordBootFlag[b][i] = TRUE;
-          }
-          else {
-            RF_dmRecordBootFlag[b][i] = FALSE;
-          }
-        }
-      }  
-    }  
-    if (mode == RF_REST) {
-      if(RF_sobservationSize > 0) {
-        RF_soobSize[b] = 0;
-        for (i = 1; i <= RF_sobservationSize; i++) {
-          if (RF_bootMembershipFlag[b][RF_sobservationIndv[i]] == FALSE) {
-            RF_soobSize[b] ++;
-          }
+  }
+  return (!terminalFlag);
+}
+FlatForest *makeFlatForest(uint forestSize, uint nodeCount, uint *mwcpPT) {
+  FlatForest *forest;
+  forest = (FlatForest*) gblock((size_t) sizeof(FlatForest));
+  forest -> forestSize = forestSize;
+  forest -> nodeCount  = nodeCount;
+  forest -> rootID  = uivector(1, forestSize);
+  forest -> depth   = uivector(1, forestSize);
+  forest -> mwcpCount = uivector(1, forestSize);
+  forest -> parmID  = uivector(1, nodeCount);
+  forest -> contPT  = dvector(1, nodeCount);
+  forest -> childID = uivector(1, nodeCount);
+  forest -> nodeID  = uivector(1, nodeCount);
+  forest -> mwcpSZ  = uivector(1, nodeCount);
+  forest -> mwcpID  = uivector(1, nodeCount);
+  forest -> mwcpPT  = mwcpPT;
+  return forest;
+}
+void freeFlatForest(FlatForest *forest) {
+  free_uivector(forest -> rootID, 1, forest -> forestSize);
+  free_uivector(forest -> depth, 1, forest -> forestSize);
+  free_uivector(forest -> mwcpCount, 1, forest -> forestSize);
+  free_uivector(forest -> parmID, 1, forest -> nodeCount);
+  free_dvector(forest -> contPT, 1, forest -> nodeCount);
+  free_uivector(forest -> childID, 1, forest -> nodeCount);
+  free_uivector(forest -> nodeID, 1, forest -> nodeCount);
+  free_uivector(forest -> mwcpSZ, 1, forest -> nodeCount);
+  free_uivector(forest -> mwcpID, 1, forest -> nodeCount);
+  free_gblock(forest, (size_t) sizeof(FlatForest));
+}
+void flattenTree(FlatForest *forest,
+                 uint        b,
+                 uint        offset,
+                 uint        nodeCount,
+                 uint        mwcpOffset,
+                 uint       *parmID,
+                 double     *contPT,
+                 uint       *nodeID,
+                 uint       *mwcpSZ) {
+  uint *leftIndex;
+  uint *rghtIndex;
+  uint *mwcpIndex;
+  uint *stackIndex;
+  uint *queueIndex;
+  uint *levelIndex;
+  uint  stackSize;
+  uint  head, tail;
+  uint  k, p, q;
+  forest -> rootID[b] = offset;
+  forest -> depth[b] = 0;
+  forest -> mwcpCount[b] = 0;
+  if (nodeCount > 0) {
+    leftIndex  = uivector(1, nodeCount);
+    rghtIndex  = uivector(1, nodeCount);
+    mwcpIndex  = uivector(1, nodeCount);
+    stackIndex = uivector(1, nodeCount);
+    queueIndex = uivector(1, nodeCount);
+    levelIndex = uivector(1, nodeCount);
+    stackSize = 0;
+    for (k = 1; k <= nodeCount; k++) {
+      leftIndex[k] = rghtIndex[k] = 0;
+      mwcpIndex[k] = mwcpOffset;
+      mwcpOffset += mwcpSZ[offset + k - 1];
+      if (k > 1) {
+        if (parmID[offset + k - 2] != 0) {
+          leftIndex[k - 1] = k;
         }
+        else {
+          rghtIndex[stackIndex[stackSize --]] = k;
+        }
+      }
+      if (parmID[offset + k - 1] != 0) {
+        stackIndex[++ stackSize] = k;
+      }
+    }
+    forest -> mwcpCount[b] = mwcpOffset - mwcpIndex[1];
+    forest -> parmID[offset] = 1;
+    queueIndex[1] = 1;
+    levelIndex[1] = 0;
+    head = tail = 1;
+    while (head <= tail) {
+      p = queueIndex[head];
+      q = offset + p - 1;
+      k = offset + head - 1;
+      forest -> contPT[k] = contPT[q];
+      forest -> nodeID[k] = nodeID[q];
+      forest -> mwcpSZ[k] = mwcpSZ[q];
+      forest -> mwcpID[k] = mwcpIndex[p];
+      if (leftIndex[p] != 0) {
+        forest -> parmID[k] = parmID[q];
+        forest -> childID[k] = offset + tail;
+        forest -> parmID[offset + tail] = forest -> parmID[offset + tail + 1] = parmID[q];
+        queueIndex[++ tail] = leftIndex[p];
+        levelIndex[tail] = levelIndex[head] + 1;
+        queueIndex[++ tail] = rghtIndex[p];
+        levelIndex[tail] = levelIndex[head] + 1;
       }
-    }
-  }  
-  if (result) {
-    if (RF_opt & OPT_MEMB) {
-      for (i=1; i <= obsSize; i++) {
-        RF_tTermMembershipIndexPtr[b][i] = gTermMembership[b][i] -> nodeID;
-        if (RF_ptnCount > 0) {
-          RF_pNodeMembershipIndexPtr[b][i] = RF_pNodeMembership[b][i] -> nodeID;
+      else {
+        forest -> childID[k] = k;
+        if (levelIndex[head] > forest -> depth[b]) {
+          forest -> depth[b] = levelIndex[head];
         }
       }
+      head ++;
     }
-    if (r == RF_nImpute) {
-      if ((RF_opt & OPT_PERF) |
-          (RF_opt & OPT_PERF_CALB) |
-          (RF_opt & OPT_OENS) |
-          (RF_opt & OPT_FENS)) {
-        updateEnsembleCalculations(multImpFlag, mode, b);
-      }
-      if (RF_opt & (OPT_SPLDPTH_F | OPT_SPLDPTH_T)) {
-#ifdef _OPENMP
-#pragma omp critical (_update_splitdepth)
+    free_uivector(leftIndex, 1, nodeCount);
+    free_uivector(rghtIndex, 1, nodeCount);
+    free_uivector(mwcpIndex, 1, nodeCount);
+    free_uivector(stackIndex, 1, nodeCount);
+    free_uivector(queueIndex, 1, nodeCount);
+    free_uivector(levelIndex, 1, nodeCount);
+  }
+}
+uint getFlatTerminal(FlatForest *forest, uint b, double **observation, uint i) {
+  uint k;
+  char daughterFlag;
+  k = forest -> rootID[b];
+  while (forest -> childID[k] != k) {
+    if (forest -> mwcpSZ[k] > 0) {
+      daughterFlag = splitOnFactor((uint) observation[forest -> parmID[k]][i], forest -> mwcpPT + forest -> mwcpID[k]);
+    }
+    else {
+      daughterFlag = (observation[forest -> parmID[k]][i] <= forest -> contPT[k]) ? LEFT : RIGHT;
+    }
+    k = forest -> childID[k] + ((daughterFlag == LEFT) ? 0 : 1);
+  }
+  return forest -> nodeID[k];
+}
+void getFlatTerminalBlock(FlatForest *forest,
+                          uint        b,
+                          double    **observation,
+                          uint        offset,
+                          uint        size,
+                          uint       *nodeIndex) {
+  uint   *parmID;
+  double *contPT;
+  uint   *childID;
+  uint   *mwcpSZ;
+  uint level, i, k;
+  parmID  = forest -> parmID;
+  contPT  = forest -> contPT;
+  childID = forest -> childID;
+  mwcpSZ  = forest -> mwcpSZ;
+  for (i = 1; i <= size; i++) {
+    nodeIndex[i] = forest -> rootID[b];
+  }
+  if (forest -> mwcpCount[b] == 0) {
+    for (level = 1; level <= forest -> depth[b]; level++) {
+#if defined(_OPENMP) && (_OPENMP >= 201307)
+#pragma omp simd private(k)
 #endif
-        { 
-          updateSplitDepth(b, RF_root[b], RF_maxDepth[b]);
-        }
-      }
-      if (RF_opt & OPT_VUSE) {
-        getVariablesUsed(b, RF_root[b], RF_varUsedPtr[b]);
+      for (i = 1; i <= size; i++) {
+        k = nodeIndex[i];
+        nodeIndex[i] = childID[k] + ((childID[k] != k) & !(observation[parmID[k]][offset + i] <= contPT[k]));
       }
-      if (RF_opt & OPT_VIMP) {
-        uint vimpCount;
-        if (RF_opt & OPT_VIMP_JOIN) {
-          vimpCount = 1;
+    }
+  }
+  else {
+    for (level = 1; level <= forest -> depth[b]; level++) {
+      for (i = 1; i <= size; i++) {
+        k = nodeIndex[i];
+        if (mwcpSZ[k] > 0) {
+          nodeIndex[i] = childID[k] + ((splitOnFactor((uint) observation[parmID[k]][offset + i], forest -> mwcpPT + forest -> mwcpID[k]) == LEFT) ? 0 : 1);
         }
         else {
-          vimpCount = RF_intrPredictorSize;
-        }
-        for (uint intrIndex = 1; intrIndex <= vimpCount; intrIndex++) {
-          uint pp;
-          if (!(RF_opt & OPT_VIMP_JOIN)) {
-          pp = RF_intrPredictor[intrIndex];
-          }
-          else {
-            pp = 0;
-          }
-          stackVimpMembership(mode, & RF_vimpMembership[intrIndex][b]);
-          getVimpMembership(mode, b, RF_vimpMembership[intrIndex][b], pp);
-          updateVimpCalculations(mode, b, intrIndex, RF_vimpMembership[intrIndex][b]);
-          unstackVimpMembership(mode, RF_vimpMembership[intrIndex][b]);
+          nodeIndex[i] = childID[k] + ((childID[k] != k) & !(observation[parmID[k]][offset + i] <= contPT[k]));
         }
       }
-      if (RF_opt & OPT_PROX) {
+    }
+  }
+  for (i = 1; i <= size; i++) {
+    nodeIndex[i] = forest -> nodeID[nodeIndex[i]];
+  }
+}
+char getFlatForestFlag(uint mode) {
+  char result;
+  result = FALSE;
+  if (mode == RF_PRED) {
+    if (RF_fmRecordSize == 0) {
+      result = TRUE;
+    }
+  }
+  return result;
+}
+void stackFlatForest(uint mode) {
+  uint b;
+  RF_flatForest = NULL;
+  if (getFlatForestFlag(mode)) {
+    RF_flatForest = makeFlatForest(RF_forestSize, RF_totalNodeCount, RF_mwcpPT_);
+    if (RF_numThreads > 0) {
 #ifdef _OPENMP
-#pragma omp critical (_update_proximity)
+#pragma omp parallel for num_threads(RF_numThreads) schedule(dynamic, 1)
 #endif
-        { 
-          updateProximity(mode, b);
-        }
+      for (b = 1; b <= RF_forestSize; b++) {
+        flattenTree(RF_flatForest,
+                    b,
+                    RF_restoreTreeOffset[b],
+                    RF_nodeCount[b],
+                    RF_restoreMWCPOffset[b],
+                    RF_parmID_,
+                    RF_contPT_,
+                    RF_nodeID_,
+                    RF_mwcpSZ_);
       }
-      if (mode == RF_GROW) {
-        if (RF_opt & OPT_TREE) {
-#ifdef _OPENMP
-#pragma omp critical (_save_tree)
-#endif
-          { 
-            mwcpPtrPtr = & RF_mwcpIterator;
-            saveTree(b,
-                     RF_root[b],
-                     & RF_totalNodeCount,
-                     RF_treeID_,
-                     RF_nodeID_,
-                     RF_parmID_,
-                     RF_contPT_,
-                     RF_mwcpSZ_,
-                     mwcpPtrPtr,
-                     RF_mwcpCount);
-          }
-          if (RF_optHigh & OPT_TERM) {
-            saveTerminalNodeOutputObjects(b);
-          }
-        }
+    }
+    else {
+      for (b = 1; b <= RF_forestSize; b++) {
+        flattenTree(RF_flatForest,
+                    b,
+                    RF_restoreTreeOffset[b],
+                    RF_nodeCount[b],
+                    RF_restoreMWCPOffset[b],
+                    RF_parmID_,
+                    RF_contPT_,
+                    RF_nodeID_,
+                    RF_mwcpSZ_);
       }
-      if ((RF_opt & OPT_NODE_STAT) || (RF_opt & OPT_USPV_STAT)) {
-#ifdef _OPENMP
-#pragma omp critical (_save_stats)
-#endif
-        { 
-          saveStatistics(mode,
-                         b,
-                         RF_root[b],
-                         & RF_totalNodeCount2,
-                         RF_spltST_,         
-                         RF_spltVR_,         
-                         RF_uspvST_ptr,      
-                         RF_mtryID_ptr,      
-                         RF_mtryST_ptr       
-                         );
-        }
+    }
+  }
+}
+void unstackFlatForest(uint mode) {
+  if (RF_flatForest != NULL) {
+    freeFlatForest(RF_flatForest);
+    RF_flatForest = NULL;
+  }
+}
+void restoreFlatMembership(uint b) {
+  uint *nodeIndex;
+  uint  offset, size;
+  uint  i;
+  nodeIndex = uivector(1, FLAT_BLOCK_SIZE);
+  for (offset = 0; offset < RF_fobservationSize; offset += FLAT_BLOCK_SIZE) {
+    size = ((RF_fobservationSize - offset) < FLAT_BLOCK_SIZE) ? (RF_fobservationSize - offset) : FLAT_BLOCK_SIZE;
+    getFlatTerminalBlock(RF_flatForest, b, RF_fobservation[b], offset, size, nodeIndex);
+    for (i = 1; i <= size; i++) {
+      RF_ftNodeMembership[b][offset + i] = RF_tNodeList[b][nodeIndex[i]];
+    }
+  }
+  free_uivector(nodeIndex, 1, FLAT_BLOCK_SIZE);
+}
+ScoreForest *makeScoreForest(uint forestSize, uint xSize, uint outcomeSize, uint nodeCount, uint mwcpSize) {
+  ScoreForest *forest;
+  forest = (ScoreForest*) gblock((size_t) sizeof(ScoreForest));
+  forest -> forestSize  = forestSize;
+  forest -> xSize       = xSize;
+  forest -> outcomeSize = outcomeSize;
+  forest -> treeCount   = 0;
+  forest -> leafSize    = 0;
+  forest -> mwcpSize    = (mwcpSize > 0) ? mwcpSize : 1;
+  forest -> numThreads  = 0;
+  forest -> xLevels     = uivector(1, xSize);
+  forest -> leafCount   = uivector(1, forestSize);
+  forest -> leafOffset  = uivector(1, forestSize);
+  forest -> mwcpPT      = uivector(1, forest -> mwcpSize);
+  forest -> leafValue   = NULL;
+  forest -> flatForest  = makeFlatForest(forestSize, nodeCount, forest -> mwcpPT);
+  return forest;
+}
+void freeScoreForest(ScoreForest *forest) {
+  if (forest -> leafValue != NULL) {
+    free_dvector(forest -> leafValue, 1, forest -> leafSize * forest -> outcomeSize);
+  }
+  freeFlatForest(forest -> flatForest);
+  free_uivector(forest -> xLevels, 1, forest -> xSize);
+  free_uivector(forest -> leafCount, 1, forest -> forestSize);
+  free_uivector(forest -> leafOffset, 1, forest -> forestSize);
+  free_uivector(forest -> mwcpPT, 1, forest -> mwcpSize);
+  free_gblock(forest, (size_t) sizeof(ScoreForest));
+}
+char restoreScoreLeafValues(ScoreForest *forest,
+                            uint         timeInterestSize,
+                            uint         eventTypeSize,
+                            char         crFlag,
+                            uint         regrCount,
+                            uint         classCount,
+                            uint        *classSize,
+                            double      *tnSURV,
+                            double      *tnMORT,
+                            double      *tnNLSN,
+                            double      *tnCSHZ,
+                            double      *tnCIFN,
+                            double      *tnREGR,
+                            uint        *tnCLAS,
+                            uint        *tnMCNT) {
+  double *value;
+  uint    levelSize;
+  uint    m, j, k, t, q;
+  levelSize = 0;
+  for (j = 1; j <= classCount; j++) {
+    levelSize += classSize[j];
+  }
+  forest -> leafValue = dvector(1, forest -> leafSize * forest -> outcomeSize);
+  for (m = 1; m <= forest -> leafSize; m++) {
+    if (tnMCNT[m] == 0) {
+      RFprintf("\nRF-SRC:  *** ERROR *** ");
+      RFprintf("\nRF-SRC:  Zero node count encountered in terminal node record:  %10d", m);
+      RFprintf("\nRF-SRC:  The application will now exit.\n");
+      return FALSE;
+    }
+    value = forest -> leafValue + (m - 1) * forest -> outcomeSize;
+    if (eventTypeSize == 0) {
+      for (k = 1; k <= regrCount; k++) {
+        value[k] = tnREGR[(m - 1) * regrCount + k];
       }
-    }  
-  }  
-  else {
+      for (q = 1; q <= levelSize; q++) {
+        value[regrCount + q] = (double) tnCLAS[(m - 1) * levelSize + q] / (double) tnMCNT[m];
+      }
+    }
+    else if (!crFlag) {
+      value[1] = tnMORT[(m - 1) * eventTypeSize + 1];
+      for (t = 1; t <= timeInterestSize; t++) {
+        value[1 + t] = tnSURV[(m - 1) * timeInterestSize + t];
+        value[1 + timeInterestSize + t] = tnNLSN[(m - 1) * timeInterestSize + t];
+      }
+    }
+    else {
+      for (j = 1; j <= eventTypeSize; j++) {
+        value[j] = tnMORT[(m - 1) * eventTypeSize + j];
+        for (t = 1; t <= timeInterestSize; t++) {
+          q = (j - 1) * timeInterestSize + t;
+          value[eventTypeSize + q] = tnCSHZ[(m - 1) * eventTypeSize * timeInterestSize + q];
+          value[eventTypeSize + (eventTypeSize * timeInterestSize) + q] = tnCIFN[(m - 1) * eventTypeSize * timeInterestSize + q];
+        }
+      }
+    }
   }
-  freeTree(b, RF_root[b], TRUE);
-  unstackAuxiliary2(mode, b);
-  unstackAuxiliary(mode, b);
-  unstackNodeList(b);
-  unstackShadow(mode, b, TRUE, TRUE);
-  free_uivector(allMembrIndx, 1, RF_observationSize);
-  if (mode == RF_PRED) {
-    free_uivector(fallMembrIndx, 1, RF_fobservationSize);
+  return TRUE;
+}
+uint getFlatTerminalVector(FlatForest *forest, uint b, double *x, uint stride) {
+  uint k;
+  char daughterFlag;
+  k = forest -> rootID[b];
+  while (forest -> childID[k] != k) {
+    if (forest -> mwcpSZ[k] > 0) {
+      daughterFlag = splitOnFactor((uint) x[(forest -> parmID[k] - 1) * stride], forest -> mwcpPT + forest -> mwcpID[k]);
+    }
+    else {
+      daughterFlag = (x[(forest -> parmID[k] - 1) * stride] <= forest -> contPT[k]) ? LEFT : RIGHT;
+    }
+    k = forest -> childID[k] + ((daughterFlag == LEFT) ? 0 : 1);
   }
-  if (!(RF_opt & OPT_MISS)) {
-    for (i = 1; i <= RF_tLeafCount[b]; i++) {
-      freeTerminal(RF_tTermList[b][i]);
+  return forest -> nodeID[k];
+}
+char getScoreVectorFlag(ScoreForest *forest, double *x, uint stride) {
+  double value;
+  uint p;
+  for (p = 1; p <= forest -> xSize; p++) {
+    value = x[(p - 1) * stride];
+    if (ISNAN(value)) {
+      return FALSE;
     }
-    unstackTermList(b);
-    if (RF_tLeafCount[b] > 0) {
-      unstackTermMembership(mode, b);
+    if (forest -> xLevels[p] > 0) {
+      if ((value < 1) || (value > forest -> xLevels[p]) || (value != floor(value))) {
+        return FALSE;
+      }
     }
   }
+  return TRUE;
 }
-void finalizeProximity(uint mode) {
-  uint  obsSize;
-  if (mode != RF_PRED) {
-    obsSize = RF_observationSize;
+char scoreForestRow(ScoreForest *forest, double *x, uint xStride, double *ensemble, uint ensembleStride) {
+  double *value;
+  uint    leaf;
+  uint    b, j;
+  if (!getScoreVectorFlag(forest, x, xStride)) {
+    for (j = 1; j <= forest -> outcomeSize; j++) {
+      ensemble[(j - 1) * ensembleStride] = NA_REAL;
+    }
+    return FALSE;
   }
-  else {
-    obsSize = RF_fobservationSize;
+  for (j = 1; j <= forest -> outcomeSize; j++) {
+    ensemble[(j - 1) * ensembleStride] = 0.0;
   }
-  if (RF_numThreads > 0) {
+  for (b = 1; b <= forest -> forestSize; b++) {
+    if (forest -> leafCount[b] > 0) {
+      leaf = getFlatTerminalVector(forest -> flatForest, b, x, xStride);
+      value = forest -> leafValue + (forest -> leafOffset[b] + leaf - 1) * forest -> outcomeSize;
+      for (j = 1; j <= forest -> outcomeSize; j++) {
+        ensemble[(j - 1) * ensembleStride] += value[j];
+      }
+    }
+  }
+  for (j = 1; j <= forest -> outcomeSize; j++) {
+    ensemble[(j - 1) * ensembleStride] = ensemble[(j - 1) * ensembleStride] / forest -> treeCount;
+  }
+  return TRUE;
+}
+uint scoreForestRows(ScoreForest *forest, double *x, uint rowSize, double *ensemble) {
+  uint invalidCount;
+  uint i;
+  invalidCount = 0;
+  if ((forest -> numThreads > 1) && (rowSize > 1)) {
 #ifdef _OPENMP
-#pragma omp parallel for num_threads(RF_numThreads)
+#pragma omp parallel for num_threads(forest -> numThreads) schedule(static) reduction(+:invalidCount)
 #endif
-    for (uint i = 1; i <= obsSize; i++) {
-      for (uint j = 1; j <= i; j++) {
-        if (RF_proximityDenPtr[i][j] > 0) {
-          RF_proximityPtr[i][j] = RF_proximityPtr[i][j] /  RF_proximityDenPtr[i][j];
-        }
-        else {
-          RF_proximityPtr[i][j] = NA_REAL;
-        }
+    for (i = 1; i <= rowSize; i++) {
+      if (!scoreForestRow(forest, x + i - 1, rowSize, ensemble + i - 1, rowSize)) {
+        invalidCount ++;
       }
     }
   }
   else {
-    for (uint i = 1; i <= obsSize; i++) {
-      for (uint j = 1; j <= i; j++) {
-        if (RF_proximityDenPtr[i][j] > 0) {
-          RF_proximityPtr[i][j] = RF_proximityPtr[i][j] /  RF_proximityDenPtr[i][j];
-        }
-        else {
-          RF_proximityPtr[i][j] = NA_REAL;
-        }
+    for (i = 1; i <= rowSize; i++) {
+      if (!scoreForestRow(forest, x + i - 1, rowSize, ensemble + i - 1, rowSize)) {
+        invalidCount ++;
       }
     }
   }
+  return invalidCount;
 }
-void updateProximity(uint mode, uint b) {
-  uint  *tTermMembershipIndexPtr;
-  uint  *membershipIndex;
-  uint   membershipSize;
-  uint  mtnmFlag;
-  if((RF_opt & OPT_PROX_IBG) && (RF_opt & OPT_PROX_OOB)) {
-    if (mode != RF_PRED) {
-      membershipSize = RF_observationSize;
-      membershipIndex = RF_identityMembershipIndex;
-    }
-    else {
-      membershipSize = RF_fobservationSize;
-      membershipIndex = RF_fidentityMembershipIndex;
+ScoreWorker *makeScoreWorker(uint maxRows, uint xSize, uint outcomeSize) {
+  ScoreWorker *worker;
+  uint k;
+  worker = (ScoreWorker*) gblock((size_t) sizeof(ScoreWorker));
+  worker -> maxRows      = maxRows;
+  worker -> xSize        = xSize;
+  worker -> outcomeSize  = (outcomeSize > SCORE_HIST_SIZE) ? outcomeSize : SCORE_HIST_SIZE;
+  worker -> requestCount = 0;
+  worker -> rowCount     = 0;
+  worker -> x            = dvector(1, maxRows * xSize);
+  worker -> ensemble     = dvector(1, maxRows * worker -> outcomeSize);
+  worker -> latency      = uivector(1, SCORE_HIST_SIZE);
+  for (k = 1; k <= SCORE_HIST_SIZE; k++) {
+    worker -> latency[k] = 0;
+  }
+  return worker;
+}
+void freeScoreWorker(ScoreWorker *worker) {
+  free_dvector(worker -> x, 1, worker -> maxRows * worker -> xSize);
+  free_dvector(worker -> ensemble, 1, worker -> maxRows * worker -> outcomeSize);
+  free_uivector(worker -> latency, 1, SCORE_HIST_SIZE);
+  free_gblock(worker, (size_t) sizeof(ScoreWorker));
+}
+uint getScoreLatencyBin(double seconds) {
+  double usec;
+  uint bin;
+  usec = seconds * 1.0e6;
+  bin = 1;
+  while ((usec >= 2.0) && (bin < SCORE_HIST_SIZE)) {
+    usec = usec / 2.0;
+    bin ++;
+  }
+  return bin;
+}
+#ifndef _WIN32
+double getScoreClock() {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double) now.tv_sec + 1.0e-9 * (double) now.tv_nsec;
+}
+void catchScoreSignal(int signal) {
+  RF_scoreSignal = TRUE;
+}
+void getScoreInterrupt(void *dummy) {
+  R_CheckUserInterrupt();
+}
+char getScoreStopFlag(char *stopFlag) {
+  char flag;
+#ifdef _OPENMP
+#pragma omp atomic read
+#endif
+  flag = *stopFlag;
+  return flag;
+}
+void setScoreStopFlag(char *stopFlag) {
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
+  *stopFlag = TRUE;
+}
+void checkScoreInterrupt(char *stopFlag) {
+  if (getThreadIndex() == 1) {
+    if (RF_scoreSignal || !R_ToplevelExec(getScoreInterrupt, NULL)) {
+      setScoreStopFlag(stopFlag);
     }
   }
-  else {
-    if((RF_opt & OPT_PROX_IBG)  && !(RF_opt & OPT_PROX_OOB)) {
-      membershipIndex = RF_ibgMembershipIndex[b];
-      membershipSize  = RF_ibgSize[b];
+}
+char readScoreFrame(int fd, void *buffer, size_t size, char *stopFlag) {
+  struct pollfd request;
+  char  *position;
+  ssize_t count;
+  double idleTime;
+  position = (char*) buffer;
+  idleTime = getScoreClock();
+  while (size > 0) {
+    if (getScoreStopFlag(stopFlag)) {
+      return FALSE;
     }
-    else if(!(RF_opt & OPT_PROX_IBG)  && (RF_opt & OPT_PROX_OOB)) {
-      membershipIndex = RF_oobMembershipIndex[b];
-      membershipSize  = RF_oobSize[b];
+    request.fd = fd;
+    request.events = POLLIN;
+    request.revents = 0;
+    if (poll(&request, 1, SCORE_POLL_MSEC) <= 0) {
+      checkScoreInterrupt(stopFlag);
+      if ((getScoreClock() - idleTime) * 1.0e3 >= SCORE_IDLE_MSEC) {
+        return FALSE;
+      }
+      continue;
     }
-    else {
-      RFprintf("\nRF-SRC:  *** ERROR *** ");
-      RFprintf("\nRF-SRC:  Illegal finalizeProximity() call.");
-      RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-      error("\nRF-SRC:  The application will now exit.\n");
+    count = recv(fd, position, size, 0);
+    if (count < 0) {
+      if ((errno == EINTR) || (errno == EAGAIN)) {
+        continue;
+      }
+      return FALSE;
+    }
+    if (count == 0) {
+      return FALSE;
     }
+    position += count;
+    size -= (size_t) count;
+    idleTime = getScoreClock();
   }
-  mtnmFlag = FALSE;
-  if (!mtnmFlag) {
-    tTermMembershipIndexPtr = RF_tTermMembershipIndexPtr[b];
-      for (uint i = 1; i <= membershipSize; i++) {
-        uint ii, jj;
-        ii = membershipIndex[i];
-        for (uint j = 1; j <= i; j++) {
-          jj = membershipIndex[j];
-          RF_proximityDenPtr[ii][jj] ++;
-          if ( tTermMembershipIndexPtr[ii] == tTermMembershipIndexPtr[jj] ) {
-            RF_proximityPtr[ii][jj] ++;
-          }
-        }
+  return TRUE;
+}
+char writeScoreFrame(int fd, void *buffer, size_t size) {
+  char  *position;
+  ssize_t count;
+  int flags;
+#ifdef MSG_NOSIGNAL
+  flags = MSG_NOSIGNAL;
+#else
+  flags = 0;
+#endif
+  position = (char*) buffer;
+  while (size > 0) {
+    count = send(fd, position, size, flags);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
       }
+      return FALSE;
+    }
+    position += count;
+    size -= (size_t) count;
   }
+  return TRUE;
 }
-void updateSplitDepth(uint treeID, Node *rootPtr, uint maxDepth) {
-  Node  *parent;
-  double *localSplitDepth;
-  uint index;
-  uint i, j, k;
-  if (RF_tLeafCount[treeID] > 0) {
-    index = 0;  
-    if (RF_opt & (OPT_SPLDPTH_F | OPT_SPLDPTH_T)) {
-      if (RF_opt & OPT_SPLDPTH_F) {
-        index = 1;
+void serveScoreConnection(int            fd,
+                          ScoreForest  **forest,
+                          uint           forestCount,
+                          ScoreWorker  **worker,
+                          uint           workerCount,
+                          uint           w,
+                          char          *stopFlag) {
+  ScoreForest *current;
+  uint   header[SCORE_HEADER_SIZE + 1];
+  uint   reply[SCORE_HEADER_SIZE + 1];
+  double startTime;
+  size_t payloadSize;
+  char   closeFlag;
+  uint   count;
+  uint   i, k;
+  closeFlag = FALSE;
+  while (!closeFlag && readScoreFrame(fd, header + 1, SCORE_HEADER_SIZE * sizeof(uint), stopFlag)) {
+    startTime = getScoreClock();
+    reply[1] = SCORE_STAT_OK;
+    reply[2] = header[2];
+    reply[3] = 0;
+    reply[4] = 0;
+    payloadSize = 0;
+    switch (header[1]) {
+    case SCORE_CMD_ROWS:
+      if ((header[2] < 1) || (header[2] > forestCount)) {
+        reply[1] = SCORE_STAT_FOREST;
+        closeFlag = TRUE;
+        break;
       }
-      else {
-        index = treeID;
+      current = forest[header[2]];
+      if ((header[3] < 1) || (header[3] > worker[w] -> maxRows) || (header[4] != current -> xSize)) {
+        reply[1] = SCORE_STAT_SIZE;
+        closeFlag = TRUE;
+        break;
       }
-    }
-    else {
-      RFprintf("\nRF-SRC:  *** ERROR *** ");
-      RFprintf("\nRF-SRC:  Illegal updateSplitDepth() call.");
-      RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-      error("\nRF-SRC:  The application will now exit.\n");
-    }
-    localSplitDepth = dvector(1, RF_xSize);
-    for (i = 1; i <= RF_observationSize; i++) {
-      for (j = 1; j <= RF_xSize; j++) {
-        localSplitDepth[j] = NA_REAL;
+      if (!readScoreFrame(fd, worker[w] -> x + 1, header[3] * header[4] * sizeof(double), stopFlag)) {
+        return;
       }
-      parent = RF_tNodeMembership[treeID][i];
-      for (k = 1; k <= parent -> depth; k++) {
-        if (ISNA(localSplitDepth[(parent -> splitDepth)[k]])) {
-          localSplitDepth[(parent -> splitDepth)[k]] = (double) k;
-        }
+      for (i = 1; i <= header[3]; i++) {
+        scoreForestRow(current,
+                       worker[w] -> x + 1 + (i - 1) * current -> xSize,
+                       1,
+                       worker[w] -> ensemble + 1 + (i - 1) * current -> outcomeSize,
+                       1);
       }
-      for (j = 1; j <= RF_xSize; j++) {
-        if (ISNA(localSplitDepth[j])) {
-          localSplitDepth[j] = (double) maxDepth + 1;
+      reply[3] = header[3];
+      reply[4] = current -> outcomeSize;
+      payloadSize = header[3] * current -> outcomeSize * sizeof(double);
+      break;
+    case SCORE_CMD_STAT:
+      for (k = 1; k <= SCORE_HIST_SIZE; k++) {
+        worker[w] -> ensemble[k] = 0;
+        for (i = 1; i <= workerCount; i++) {
+#ifdef _OPENMP
+#pragma omp atomic read
+#endif
+          count = worker[i] -> latency[k];
+          worker[w] -> ensemble[k] += (double) count;
         }
       }
-      for (j = 1; j <= RF_xSize; j++) {
-        RF_splitDepthPtr[index][j][i] += localSplitDepth[j];
+      reply[3] = SCORE_HIST_SIZE;
+      reply[4] = 1;
+      payloadSize = SCORE_HIST_SIZE * sizeof(double);
+      break;
+    case SCORE_CMD_QUIT:
+      setScoreStopFlag(stopFlag);
+      closeFlag = TRUE;
+      break;
+    default:
+      reply[1] = SCORE_STAT_COMMAND;
+      closeFlag = TRUE;
+      break;
+    }
+    if (!writeScoreFrame(fd, reply + 1, SCORE_HEADER_SIZE * sizeof(uint))) {
+      return;
+    }
+    if (payloadSize > 0) {
+      if (!writeScoreFrame(fd, worker[w] -> ensemble + 1, payloadSize)) {
+        return;
       }
     }
-    free_dvector(localSplitDepth, 1, RF_xSize);
-    freeSplitDepth(treeID);
+    if ((header[1] == SCORE_CMD_ROWS) && (reply[1] == SCORE_STAT_OK)) {
+      worker[w] -> requestCount ++;
+      worker[w] -> rowCount += header[3];
+      k = getScoreLatencyBin(getScoreClock() - startTime);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+      worker[w] -> latency[k] ++;
+    }
   }
 }
-char pruneBranch(uint obsSize,
-                 uint treeID,
-                 Node **nodesAtDepth,
-                 uint nadCount,
-                 uint ptnTarget,
-                 uint ptnCurrent) {
-  char pruneFlag;
-  uint i, j;
-  pruneFlag = TRUE;
-  double *varianceAtDepth =  dvector(1, nadCount);
-  uint   *vadSortedIndex  = uivector(1, nadCount);
-  for (i = 1; i <= nadCount; i++) {
-    varianceAtDepth[i] = nodesAtDepth[i] -> variance;
-  }
-  indexx(nadCount, varianceAtDepth, vadSortedIndex);
-  j = nadCount;
-  while ((j >= 1) && pruneFlag) {
-    nodesAtDepth[vadSortedIndex[j]] -> pseudoTerminal = TRUE;
-    (nodesAtDepth[vadSortedIndex[j]] -> left)  -> pseudoTerminal = FALSE;
-    (nodesAtDepth[vadSortedIndex[j]] -> right) -> pseudoTerminal = FALSE;
-    for (i = 1; i <= obsSize; i++) {
-      if ( (RF_pNodeMembership[treeID][i] == nodesAtDepth[vadSortedIndex[j]] -> left) ||
-           (RF_pNodeMembership[treeID][i] == nodesAtDepth[vadSortedIndex[j]] -> right)) {
-        RF_pNodeMembership[treeID][i] = nodesAtDepth[vadSortedIndex[j]];
+#endif
+void saveTree(uint    b,
+              Node   *parent,
+              uint   *offset,
+              uint   *treeID,
+              uint   *nodeID,
+              uint   *parmID,
+              double *contPT,
+              uint   *mwcpSZ,
+              uint  **mwcpPtr,
+              uint   *mwcpCT) {
+  uint i;
+  treeID[*offset] = b;
+  nodeID[*offset] = parent -> nodeID;
+  parmID[*offset] = parent -> splitParameter;
+  if ((parent -> splitParameter) != 0) {
+    if (RF_xFactorSplitFlag[parent -> splitParameter]) {
+      mwcpSZ[*offset] = parent -> splitValueFactSize;
+      for (i = 1; i <= mwcpSZ[*offset]; i++) {
+        (*mwcpPtr) ++;
+        **mwcpPtr = (parent -> splitValueFactPtr)[i];
+        mwcpCT[b] ++;
       }
+      contPT[*offset] = NA_REAL;
     }
-    j --;
-    ptnCurrent --;
-    if (ptnCurrent <= ptnTarget) {
-      pruneFlag = FALSE;
+    else {
+      contPT[*offset] = parent -> splitValueCont;
+      mwcpSZ[*offset] = 0;
     }
   }
-  free_dvector(varianceAtDepth, 1, nadCount);
-  free_uivector(vadSortedIndex, 1, nadCount);
-  return pruneFlag;
+  else {
+    contPT[*offset] = NA_REAL;
+    mwcpSZ[*offset] = 0;
+  }
+  (*offset) ++;
+  if (((parent -> left) != NULL) && ((parent -> right) != NULL)) {
+    saveTree(b, parent ->  left, offset, treeID, nodeID, parmID, contPT, mwcpSZ, mwcpPtr, mwcpCT);
+    saveTree(b, parent -> right, offset, treeID, nodeID, parmID, contPT, mwcpSZ, mwcpPtr, mwcpCT);
+  }
 }
-uint pruneTree(uint obsSize, uint treeID, uint ptnTarget) {
-  Node **nodesAtDepth;
-  uint   ptnCurrent;
-  uint   nadCount;
-  uint   tagDepth;
-  char   pruneFlag;
-  uint   i;
-  if (ptnTarget < 1) {
+void freeTree(uint treeID, Node *parent, char rootFlag) {
+  if (((parent -> left) != NULL) && ((parent -> right) != NULL)) {
+    freeTree(treeID, parent -> left, FALSE);
+    freeTree(treeID, parent -> right, FALSE);
+  }
+  freeNode(parent);
+}
+void getSplitDepth(Node *parent, uint *maximumDepth) {
+  Node *reversePtr;
+  uint i;
+  if (!(RF_opt & (OPT_SPLDPTH_F | OPT_SPLDPTH_T))) {
     RFprintf("\nRF-SRC:  *** ERROR *** ");
-    RFprintf("\nRF-SRC:  Illegal target PTN count in pruneTree():  %10d", ptnTarget);
+    RFprintf("\nRF-SRC:  Call to calculate split depth without the option being active.");
     RFprintf("\nRF-SRC:  Please Contact Technical Support.");
     error("\nRF-SRC:  The application will now exit.\n");
   }
-  if (RF_tLeafCount[treeID] == 0) {
+  if (parent -> depth > 0) {
+    *maximumDepth = ((parent -> depth > *maximumDepth) ? parent -> depth : *maximumDepth);
+    stackSplitDepth(parent, parent -> depth);
+    reversePtr = parent;
+    for (i = 1; i <= parent -> depth; i++) {
+      if ((reversePtr -> parent) == NULL) {
+        RFprintf("\nRF-SRC:  *** ERROR *** ");
+        RFprintf("\nRF-SRC:  Reverse parsing of tree failed in restoreTree().");
+        RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+        error("\nRF-SRC:  The application will now exit.\n");
+      }
+      (parent -> splitDepth)[(parent -> depth) - i + 1] = (reversePtr -> parent) -> splitParameter;
+      reversePtr = reversePtr -> parent;
+    }
+  }
+}
+void freeSplitDepth(uint treeID) {
+  uint j;
+  for (j = 1; j <= RF_tLeafCount[treeID]; j++) {
+    unstackSplitDepth(RF_tNodeList[treeID][j]);
+  }
+}
+void saveStatistics(char     mode,
+                    uint     b,
+                    Node    *parent,
+                    uint    *offset,
+                    double  *spltST,
+                    double  *spltVR,
+                    uint   **uspvST,
+                    uint   **mtryID,
+                    double **mtryST) {
+  uint i;
+  if (!(RF_opt & OPT_NODE_STAT) && !(RF_opt & OPT_USPV_STAT)) {
     RFprintf("\nRF-SRC:  *** ERROR *** ");
-    RFprintf("\nRF-SRC:  Illegal call to pruneTree() on a rejected tree:  %10d", treeID);
+    RFprintf("\nRF-SRC:  Inconsistent call to saveStatistics().  The options are NOT active.");
     RFprintf("\nRF-SRC:  Please Contact Technical Support.");
+    RFprintf("\nRF-SRC:  The application will now exit.\n");
     error("\nRF-SRC:  The application will now exit.\n");
   }
-  nodesAtDepth = (Node **) new_vvector(1, RF_tLeafCount[treeID], NRUTIL_NPTR);
-  ptnCurrent = RF_tLeafCount[treeID];
-  tagDepth = getMaximumDepth(RF_root[treeID]) - 1;
-  pruneFlag = (ptnCurrent > ptnTarget) && (tagDepth > 0);
-  while (pruneFlag) {
-    for (i = 1; i <= RF_tLeafCount[treeID]; i++) {
-      nodesAtDepth[i] = NULL;
-    }
-    nadCount = 0;
-    getNodesAtDepth(RF_root[treeID], tagDepth, nodesAtDepth, &nadCount);
-    pruneFlag = pruneBranch(obsSize, treeID, nodesAtDepth, nadCount, ptnTarget, ptnCurrent);
-    if(pruneFlag) {
-      ptnCurrent -= nadCount;
-      tagDepth --;
+  if (RF_opt & OPT_NODE_STAT) {  
+    if (mode == RF_GROW) {
+      spltST[*offset] = parent -> splitStatistic;
+      for(i = 1; i <= RF_randomCovariateCount; i++) {
+        mtryID[*offset][i] = parent -> mtryIndx[i];
+        mtryST[*offset][i] = parent -> mtryStat[i];
+      }
     }
     else {
-      ptnCurrent = ptnTarget;
+      if (RF_ptnCount == 0) {
+        spltST[*offset] = parent -> variance;
+      }
+      else {
+        spltST[*offset] = parent -> pseudoTerminal;
+      }
     }
   }
-  free_new_vvector(nodesAtDepth, 1, RF_tLeafCount[treeID], NRUTIL_NPTR);
-  return ptnCurrent;
-}
-void unstackAuxiliary2(uint mode, uint b) {
-  free_uivector(RF_bootMembershipIndex[b], 1, RF_bootstrapSize);
-  free_uivector(RF_bootMembershipCount[b], 1, RF_observationSize);
-}
-void unstackAuxiliary(uint mode, uint b) {
-  uint obsSize;
-  obsSize = 0;  
-  free_new_vvector(RF_tNodeMembership[b], 1, RF_observationSize, NRUTIL_NPTR);
-  free_cvector(RF_bootMembershipFlag[b], 1, RF_observationSize);
-  free_cvector(RF_oobMembershipFlag[b], 1, RF_observationSize);
-  free_uivector(RF_ibgMembershipIndex[b], 1, RF_observationSize);
-  free_uivector(RF_oobMembershipIndex[b], 1, RF_observationSize);
-  if (mode == RF_PRED) {
-    free_new_vvector(RF_ftNodeMembership[b],  1, RF_fobservationSize, NRUTIL_NPTR);
-  }
-  if (RF_ptnCount > 0) {
-    if (mode != RF_PRED) {
-      obsSize = RF_observationSize;
-    }
-    else {
-      obsSize = RF_fobservationSize;
+  if (RF_opt & OPT_USPV_STAT) {
+    if (mode == RF_GROW) {
+      for (i = 1; i <= RF_randomResponseCount; i++) {
+        uspvST[*offset][i] = (parent -> urStat)[i];
+      }
     }
-    free_new_vvector(RF_pNodeMembership[b], 1, obsSize, NRUTIL_NPTR);
+  }
+  (*offset) ++;
+  if (((parent -> left) != NULL) && ((parent -> right) != NULL)) {
+    saveStatistics(mode, b, parent ->  left, offset, spltST, spltVR, uspvST, mtryID, mtryST);
+    saveStatistics(mode, b, parent -> right, offset, spltST, spltVR, uspvST, mtryID, mtryST);
   }
 }
-void stackNodeAndTermList(uint treeID, uint length) {
-  uint temp;
-  uint size; 
-  if (length == 0) {
-    temp = ((RF_minimumNodeSize - 1 ) << 1);
-    if (RF_observationSize > temp) { 
-      size = RF_observationSize - temp;
+void getTreeRecordSize(Node *parent, uint *nodeCount, uint *mwcpCount) {
+  (*nodeCount) ++;
+  if ((parent -> splitParameter) != 0) {
+    if (RF_xFactorSplitFlag[parent -> splitParameter]) {
+      (*mwcpCount) += parent -> splitValueFactSize;
     }
-    else {
-      size = 1;
+  }
+  if (((parent -> left) != NULL) && ((parent -> right) != NULL)) {
+    getTreeRecordSize(parent ->  left, nodeCount, mwcpCount);
+    getTreeRecordSize(parent -> right, nodeCount, mwcpCount);
+  }
+}
+TreeRecord *makeTreeRecord(uint nodeCount, uint mwcpCount) {
+  TreeRecord *record;
+  Arena      *arena;
+  arena = suspendArena();
+  record = (TreeRecord*) gblock((size_t) sizeof(TreeRecord));
+  record -> nodeCount = nodeCount;
+  record -> mwcpCount = mwcpCount;
+  record -> treeID = record -> nodeID = record -> parmID = record -> mwcpSZ = record -> mwcpPT = NULL;
+  record -> contPT = record -> spltST = NULL;
+  record -> mtryID = record -> uspvST = NULL;
+  record -> mtryST = NULL;
+  if (RF_opt & OPT_TREE) {
+    record -> treeID = uivector(1, nodeCount);
+    record -> nodeID = uivector(1, nodeCount);
+    record -> parmID = uivector(1, nodeCount);
+    record -> contPT = dvector(1, nodeCount);
+    record -> mwcpSZ = uivector(1, nodeCount);
+    if (mwcpCount > 0) {
+      record -> mwcpPT = uivector(1, mwcpCount);
     }
   }
-  else {
-    size = length;
+  if (RF_opt & OPT_NODE_STAT) {
+    record -> spltST = dvector(1, nodeCount);
+    record -> mtryID = uimatrix(1, nodeCount, 1, RF_randomCovariateCount);
+    record -> mtryST = dmatrix(1, nodeCount, 1, RF_randomCovariateCount);
   }
-  RF_tNodeListLength[treeID]  = size;
-  RF_tNodeList[treeID] = (Node **) new_vvector(1, size , NRUTIL_NPTR);
-  RF_tTermList[treeID] = (Terminal **) new_vvector(1, size, NRUTIL_TPTR);
-}
-void unstackNodeList(uint treeID) {
-  if (RF_tNodeListLength[treeID] > 0) {
-    free_new_vvector(RF_tNodeList[treeID], 1, RF_tNodeListLength[treeID], NRUTIL_NPTR);
+  if (RF_opt & OPT_USPV_STAT) {
+    record -> uspvST = uimatrix(1, nodeCount, 1, RF_randomResponseCount);
   }
+  resumeArena(arena);
+  return record;
 }
-void unstackTermList(uint treeID) {
-  if (RF_tNodeListLength[treeID] > 0) {
-    free_new_vvector(RF_tTermList[treeID], 1, RF_tNodeListLength[treeID], NRUTIL_NPTR);
+void freeTreeRecord(TreeRecord *record) {
+  uint nodeCount;
+  nodeCount = record -> nodeCount;
+  if (record -> treeID != NULL) {
+    free_uivector(record -> treeID, 1, nodeCount);
+    free_uivector(record -> nodeID, 1, nodeCount);
+    free_uivector(record -> parmID, 1, nodeCount);
+    free_dvector(record -> contPT, 1, nodeCount);
+    free_uivector(record -> mwcpSZ, 1, nodeCount);
   }
-}
-void stackAndInitTermMembership(uint mode, uint treeID) {
-  uint j;
-  RF_tTermMembership[treeID] = (Terminal **) new_vvector(1, RF_observationSize, NRUTIL_TPTR);
-  for (j = 1; j <= RF_observationSize; j++) {
-    RF_tTermMembership[treeID][j] = RF_tTermList[treeID][RF_tNodeMembership[treeID][j] -> nodeID];
+  if (record -> mwcpPT != NULL) {
+    free_uivector(record -> mwcpPT, 1, record -> mwcpCount);
   }
-  if (mode == RF_PRED) {
-    RF_ftTermMembership[treeID] = (Terminal **) new_vvector(1, RF_fobservationSize, NRUTIL_TPTR);
-    for (j = 1; j <= RF_fobservationSize; j++) {
-      RF_ftTermMembership[treeID][j] = RF_tTermList[treeID][RF_ftNodeMembership[treeID][j] -> nodeID];
-    }
+  if (record -> spltST != NULL) {
+    free_dvector(record -> spltST, 1, nodeCount);
+    free_uimatrix(record -> mtryID, 1, nodeCount, 1, RF_randomCovariateCount);
+    free_dmatrix(record -> mtryST, 1, nodeCount, 1, RF_randomCovariateCount);
   }
-}
-void unstackTermMembership(uint mode, uint treeID) {
-  free_new_vvector(RF_tTermMembership[treeID], 1, RF_observationSize, NRUTIL_TPTR);
-  if (mode == RF_PRED) {
-    free_new_vvector(RF_ftTermMembership[treeID], 1, RF_fobservationSize, NRUTIL_TPTR);
+  if (record -> uspvST != NULL) {
+    free_uimatrix(record -> uspvST, 1, nodeCount, 1, RF_randomResponseCount);
   }
+  free_gblock(record, (size_t) sizeof(TreeRecord));
 }
-Node *getTerminalNode(uint treeID, uint leaf) {
-  uint i, j;
-  Node *parent;
-  parent = NULL;
-  for (j = 1; j <= RF_observationSize; j++) {
-    if ((RF_tNodeMembership[treeID][j] -> nodeID) == leaf) {
-      parent = RF_tNodeMembership[treeID][j];
-      j = RF_observationSize;
+void stackTreeRecords(uint mode) {
+  uint b;
+  RF_treeRecordFlag = FALSE;
+  if (mode == RF_GROW) {
+    if ((RF_opt & OPT_TREE) || (RF_opt & OPT_NODE_STAT) || (RF_opt & OPT_USPV_STAT)) {
+      RF_treeRecordFlag = TRUE;
+      RF_treeRecord = (TreeRecord **) new_vvector(1, RF_forestSize, NRUTIL_RPTR);
+      for (b = 1; b <= RF_forestSize; b++) {
+        RF_treeRecord[b] = NULL;
+      }
     }
   }
-  if (parent == NULL) {
-    Rprintf("\nDiagnostic Trace of (individual, boot, node, leaf) vectors in data set:  ");
-    Rprintf("\n        index         boot         node         leaf \n");
-    for (i = 1; i <= RF_observationSize; i++) {
-      Rprintf(" %12d %12d %12x %12d \n", i,
-              RF_bootMembershipFlag[treeID][i], RF_tNodeMembership[treeID][i],
-              RF_tNodeMembership[treeID][i] -> nodeID);
+}
+void saveTreeRecord(uint mode, uint b) {
+  TreeRecord *record;
+  uint  nodeCount, mwcpCount;
+  uint  offset;
+  uint *mwcpPtr;
+  nodeCount = mwcpCount = 0;
+  getTreeRecordSize(RF_root[b], & nodeCount, & mwcpCount);
+  record = makeTreeRecord(nodeCount, mwcpCount);
+  if (RF_opt & OPT_TREE) {
+    offset = 1;
+    mwcpPtr = record -> mwcpPT;
+    saveTree(b,
+             RF_root[b],
+             & offset,
+             record -> treeID,
+             record -> nodeID,
+             record -> parmID,
+             record -> contPT,
+             record -> mwcpSZ,
+             & mwcpPtr,
+             RF_mwcpCount);
+  }
+  if ((RF_opt & OPT_NODE_STAT) || (RF_opt & OPT_USPV_STAT)) {
+    offset = 1;
+    saveStatistics(mode,
+                   b,
+                   RF_root[b],
+                   & offset,
+                   record -> spltST,
+                   NULL,
+                   record -> uspvST,
+                   record -> mtryID,
+                   record -> mtryST);
+  }
+  RF_treeRecord[b] = record;
+}
+void copyTreeRecord(uint b, uint nodeOffset, uint mwcpOffset) {
+  TreeRecord *record;
+  uint i, j, k;
+  record = RF_treeRecord[b];
+  if (record != NULL) {
+    for (i = 1; i <= record -> nodeCount; i++) {
+      k = nodeOffset + i;
+      if (RF_opt & OPT_TREE) {
+        RF_treeID_[k] = record -> treeID[i];
+        RF_nodeID_[k] = record -> nodeID[i];
+        RF_parmID_[k] = record -> parmID[i];
+        RF_contPT_[k] = record -> contPT[i];
+        RF_mwcpSZ_[k] = record -> mwcpSZ[i];
+      }
+      if (RF_opt & OPT_NODE_STAT) {
+        RF_spltST_[k] = record -> spltST[i];
+        for (j = 1; j <= RF_randomCovariateCount; j++) {
+          RF_mtryID_ptr[k][j] = record -> mtryID[i][j];
+          RF_mtryST_ptr[k][j] = record -> mtryST[i][j];
+        }
+      }
+      if (RF_opt & OPT_USPV_STAT) {
+        for (j = 1; j <= RF_randomResponseCount; j++) {
+          RF_uspvST_ptr[k][j] = record -> uspvST[i][j];
+        }
+      }
     }
-    Rprintf("\nDiagnostic State of TRAIN (SHADOW) data:  ");
-    Rprintf("\n       index       status         time   observations -> \n");
-    Rprintf("\n                                      ");
-    for (i=1; i <= RF_xSize; i++) {
-      Rprintf(" %12d", i);
+    if (record -> mwcpPT != NULL) {
+      for (i = 1; i <= record -> mwcpCount; i++) {
+        RF_mwcpPT_[mwcpOffset + i] = record -> mwcpPT[i];
+      }
     }
-    Rprintf("\n");
-    for (j = 1; j <= RF_observationSize; j++) {
-      Rprintf("%12d %12.4f %12.4f", j, RF_status[treeID][j], RF_time[treeID][j]);
-      for (i=1; i <= RF_xSize; i++) {
-        Rprintf(" %12.4f", (RF_observation[treeID][i][j]));
+    freeTreeRecord(record);
+    RF_treeRecord[b] = NULL;
+  }
+}
+void finalizeTreeRecords(uint mode) {
+  uint *nodeOffset;
+  uint *mwcpOffset;
+  uint  b;
+  if (RF_treeRecordFlag) {
+    nodeOffset = uivector(1, RF_forestSize + 1);
+    mwcpOffset = uivector(1, RF_forestSize + 1);
+    nodeOffset[1] = mwcpOffset[1] = 0;
+    for (b = 1; b <= RF_forestSize; b++) {
+      nodeOffset[b + 1] = nodeOffset[b];
+      mwcpOffset[b + 1] = mwcpOffset[b];
+      if (RF_treeRecord[b] != NULL) {
+        nodeOffset[b + 1] += RF_treeRecord[b] -> nodeCount;
+        mwcpOffset[b + 1] += RF_treeRecord[b] -> mwcpCount;
       }
-      Rprintf("\n");
     }
-    Rprintf("\nDiagnostic State of TRAIN (INCOMING) data:  ");
-    Rprintf("\n       index       status         time   observations -> \n");
-    Rprintf("\n                                      ");
-    for (i=1; i <= RF_xSize; i++) {
-      Rprintf(" %12d", i);
+    if (RF_numThreads > 0) {
+#ifdef _OPENMP
+#pragma omp parallel num_threads(RF_numThreads)
+#endif
+      {
+        double busyStart = getThreadClock();
+#ifdef _OPENMP
+#pragma omp for schedule(runtime) nowait
+#endif
+        for (uint t = 1; t <= RF_forestSize; t++) {
+          copyTreeRecord(t, nodeOffset[t], mwcpOffset[t]);
+        }
+        updateThreadBusyTime(busyStart);
+      }
     }
-    Rprintf("\n");
-    for (j = 1; j <= RF_observationSize; j++) {
-      Rprintf("%12d %12.4f %12.4f", j, RF_responseIn[RF_statusIndex][j], RF_responseIn[RF_timeIndex][j]);
-      for (i=1; i <= RF_xSize; i++) {
-        Rprintf(" %12.4f", (RF_observationIn[i][j]));
+    else {
+      double busyStart = getThreadClock();
+      for (b = 1; b <= RF_forestSize; b++) {
+        copyTreeRecord(b, nodeOffset[b], mwcpOffset[b]);
       }
-      Rprintf("\n");
+      updateThreadBusyTime(busyStart);
     }
-    Rprintf("\nRF-SRC:  *** ERROR *** ");
-    Rprintf("\nRF-SRC:  Proxy member for (tree, node) = (%12d, %12d) not found.", treeID, leaf);
-    Rprintf("\nRF-SRC:  Please Contact Technical Support.");
-    error("\nRF-SRC:  The application will now exit.\n");
+    if (RF_opt & OPT_TREE) {
+      RF_totalNodeCount = nodeOffset[RF_forestSize + 1] + 1;
+      RF_mwcpIterator = RF_mwcpPT_ + mwcpOffset[RF_forestSize + 1];
+    }
+    if ((RF_opt & OPT_NODE_STAT) || (RF_opt & OPT_USPV_STAT)) {
+      RF_totalNodeCount2 = nodeOffset[RF_forestSize + 1] + 1;
+    }
+    free_uivector(nodeOffset, 1, RF_forestSize + 1);
+    free_uivector(mwcpOffset, 1, RF_forestSize + 1);
+    free_new_vvector(RF_treeRecord, 1, RF_forestSize, NRUTIL_RPTR);
   }
-  return parent;
 }
-void getRawNodeSize(uint  type,
-                    uint  treeID,
-                    Node *parent,
-                    uint *repMembrIndx,
-                    uint *repMembrSize,
-                    uint *allMembrIndx,
-                    uint *allMembrSize) {
-  uint      obsSize;
-  Node   ***nodeMembershipPtr;
-  uint      bootMembrSize;
+uint getMaximumDepth(Node *parent) {
+  uint result, rLeft, rRight;
+  result = parent -> depth;
+  if (((parent -> left) != NULL) && ((parent -> right) != NULL)) {
+    rLeft = getMaximumDepth(parent ->  left);
+    rRight = getMaximumDepth(parent -> right);
+    result = (rLeft > rRight) ? rLeft : rRight;
+  }
+  return result;
+}
+void getNodesAtDepth(Node *parent, uint tagDepth, Node **nodesAtDepth, uint *nadCount) {
+  char recurseFlag;
+  recurseFlag = TRUE;
+  if (tagDepth == parent -> depth) {
+    if ((parent -> splitParameter) != 0) {
+      (*nadCount) ++;
+      nodesAtDepth[*nadCount] = parent;
+    }
+    recurseFlag = FALSE;
+  }
+  else {
+    if (((parent -> left) == NULL) && ((parent -> right) == NULL)) {
+      recurseFlag = FALSE;
+    }
+  }
+  if (recurseFlag) {
+    getNodesAtDepth(parent ->  left, tagDepth, nodesAtDepth, nadCount);
+    getNodesAtDepth(parent -> right, tagDepth, nodesAtDepth, nadCount);
+  }
+}
+void getTreeInfo(uint treeID, Node *parent) {
+  if (((parent -> left) != NULL) && ((parent -> right) != NULL)) {
+    getTreeInfo(treeID, parent ->  left);
+    getTreeInfo(treeID, parent -> right);
+  }
+}
+void getPTNodeList(Node    *parent,
+                   Node   **list,
+                   uint    *offset) {
+  if (!(parent -> pseudoTerminal)) {
+    getPTNodeList(parent ->  left, list, offset);
+    getPTNodeList(parent -> right, list, offset);
+  }
+  else {
+    (*offset) ++;
+    list[*offset] = parent;
+  }
+}
+void restoreNodeMembershipGrow(uint treeID) {
   uint i;
-  obsSize           = 0;     
-  nodeMembershipPtr = NULL;  
-  switch (type) {
-  case RF_PRED:
-    obsSize = RF_fobservationSize;
-    nodeMembershipPtr = RF_ftNodeMembership;
-    break;
-  default:
-    obsSize = RF_observationSize;
-    nodeMembershipPtr = RF_tNodeMembership;
-    break;
+  for (i = 1; i <= RF_observationSize; i++) {
+    RF_tNodeMembership[treeID][i] = RF_tNodeList[treeID][RF_TN_MEMB_ptr[treeID][i]];
   }
-  bootMembrSize = RF_bootstrapSize;
-  *repMembrSize = 0;
-  for (i=1; i <= bootMembrSize; i++) {
-    if (RF_tNodeMembership[treeID][RF_bootMembershipIndex[treeID][i]] == parent) {
-      repMembrIndx[++(*repMembrSize)] = RF_bootMembershipIndex[treeID][i];
+}
+char getRestoreNodeMembershipGrowFlag(char mode) {
+  char flag;
+  flag = FALSE;
+  if (getPredictTerminalFlag(mode)) {
+    flag = TRUE;
+  }
+  else if ((RF_optHigh & OPT_TERM) && (!(RF_opt & (OPT_BOOT_NODE | OPT_BOOT_NONE)))) {
+    switch (mode) {
+    case RF_PRED:
+      if (RF_fmRecordSize == 0) {
+        flag = TRUE;
+      }
+      break;
+    default:
+      flag = TRUE;
+      break;
     }
   }
-  *allMembrSize = 0;
-  for (i=1; i <= obsSize; i++) {
-    if (nodeMembershipPtr[treeID][i] == parent) {
-      allMembrIndx[++(*allMembrSize)] = i;
+  return flag;
+}
+char getPredictTerminalFlag(uint mode) {
+  char flag;
+  flag = FALSE;
+  if ((mode == RF_PRED) && (RF_optHigh & OPT_TERM) && (RF_flatForest != NULL)) {
+    if (!(RF_opt & (OPT_NODE_STAT | OPT_SPLDPTH_F | OPT_SPLDPTH_T)) && (RF_ptnCount == 0)) {
+      flag = TRUE;
+      if ((RF_opt & OPT_PROX) && ((RF_opt & OPT_PROX_FUL) != OPT_PROX_FUL)) {
+        flag = FALSE;
+      }
     }
   }
+  return flag;
 }
-char forkAndUpdate(uint    treeID,
-                   Node   *parent,
-                   uint   *repMembrIndx,
-                   uint    repMembrSize,
-                   uint   *allMembrIndx,
-                   uint    allMembrSize,
-                   uint    splitParameterMax,
-                   double  splitValueMaxCont,
-                   uint    splitValueMaxFactSize,
-                   uint   *splitValueMaxFactPtr,
-                   double  splitStatistic,
-                   char   *localSplitIndicator,
-                   char    multImpFlag,
-                   char   *membershipIndicator,
-                   uint   *leftDaughterSize,
-                   uint   *rghtDaughterSize) {
-  char factorFlag;
-  char daughterFlag;
-  char result;
-  uint i;
-  factorFlag = FALSE; 
-  result = forkNode(parent,
-                    splitParameterMax,
-                    splitValueMaxCont,
-                    splitValueMaxFactSize,
-                    splitValueMaxFactPtr);
-  if (result == TRUE) {
-    parent -> splitStatistic = splitStatistic;
-    RF_tLeafCount[treeID]++;
-    ((parent -> left) -> nodeID) = (parent -> nodeID);
-    ((parent -> right) -> nodeID) = RF_tLeafCount[treeID];
-    factorFlag = FALSE;
-    if (strcmp(RF_xType[splitParameterMax], "C") == 0) {
-      factorFlag = TRUE;
+void updateTerminalNodeOutcomesNew (uint       treeID,
+                                    Terminal  *parent,
+                                    uint      *repMembrIndx,
+                                    uint       repMembrSize,
+                                    uint      *allMembrIndx,
+                                    uint       allMembrSize) {
+  if ((RF_timeIndex > 0) && (RF_statusIndex > 0)) {
+    getAtRiskAndEventCountsNew(treeID, parent, repMembrIndx, repMembrSize, allMembrIndx, allMembrSize);
+    getLocalRatios(treeID, parent);
+    getLocalSurvival(treeID, parent);
+    if (!(RF_opt & OPT_COMP_RISK)) {
+      getLocalNelsonAalen(treeID, parent);
     }
-    *leftDaughterSize = *rghtDaughterSize = 0;
-    for (i = 1; i <= allMembrSize; i++) {
-      membershipIndicator[allMembrIndx[i]] = NEITHER;
+    else {
+      getLocalCSH(treeID, parent);
+      getLocalCIF(treeID, parent);
     }
-    for (i = 1; i <= repMembrSize; i++) {
-      membershipIndicator[repMembrIndx[i]] = localSplitIndicator[i];
+    unstackAtRiskAndEventCounts(parent);
+    if (!(RF_opt & OPT_COMP_RISK)) {
+      getSurvival(treeID, parent);
+      getNelsonAalen(treeID, parent);
     }
-    for (i = 1; i <= allMembrSize; i++) {
-      if(membershipIndicator[allMembrIndx[i]] == NEITHER) {
-        daughterFlag = RIGHT;
-        if (factorFlag == TRUE) {
-          daughterFlag = splitOnFactor((uint) RF_observation[treeID][splitParameterMax][allMembrIndx[i]], splitValueMaxFactPtr);
-        }
-        else {
-          if (RF_observation[treeID][splitParameterMax][allMembrIndx[i]] <= splitValueMaxCont) {
-            daughterFlag = LEFT;
-          }
-        }
-        membershipIndicator[allMembrIndx[i]] = daughterFlag;
+    else {
+      getCSH(treeID, parent);
+      getCIF(treeID, parent);
+    }
+    getMortality(treeID, parent);
+    freeTerminalNodeLocalSurvivalStructures(parent);
+  }
+  else {
+    if(RF_rFactorCount > 0) {
+      getMultiClassProbNew(treeID, parent, repMembrIndx, repMembrSize, allMembrIndx, allMembrSize);
+    }
+    if(RF_rNonFactorCount > 0) {
+      getMeanResponseNew(treeID, parent, repMembrIndx, repMembrSize, allMembrIndx, allMembrSize);
+    }
+  }
+}
+void restoreTerminalNodeOutcomes (uint treeID, Terminal *parent) {
+    if ((RF_timeIndex > 0) && (RF_statusIndex > 0)) {
+      if (!(RF_opt & OPT_COMP_RISK)) {
+        restoreSurvival (treeID, parent);
+        restoreNelsonAalen (treeID, parent);
       }
       else {
-        daughterFlag = membershipIndicator[allMembrIndx[i]];
+        restoreCSH (treeID, parent);
+        restoreCIF (treeID, parent);
       }
-      if (daughterFlag == LEFT) {
-        (*leftDaughterSize) ++;
-        RF_tNodeMembership[treeID][allMembrIndx[i]] = parent -> left;
+      restoreMortality (treeID, parent);
+    }
+    else {
+      if(RF_rFactorCount > 0) {
+        restoreMultiClassProbNew (treeID, parent);
       }
-      else {
-        (*rghtDaughterSize) ++;
-        RF_tNodeMembership[treeID][allMembrIndx[i]] = parent -> right;
+      if(RF_rNonFactorCount > 0) {
+        restoreMeanResponseNew (treeID, parent);
       }
-    }  
-  }
-  else {
-    RFprintf("\nRF-SRC:  *** ERROR *** ");
-    RFprintf("\nRF-SRC:  forkNode() failed.");
-    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-    error("\nRF-SRC:  The application will now exit.\n");
-  }
-  if (localSplitIndicator != NULL) {
-    free_cvector(localSplitIndicator, 1, repMembrSize);
-  }
-  else {
-    RFprintf("\nRF-SRC:  *** ERROR *** ");
-    RFprintf("\nRF-SRC:  NULL Local Split Indicator encountered in forkAndUpdate().");
-    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-    error("\nRF-SRC:  The application will now exit.\n");
-  }
-  return result;
+    }
 }
-char growTree (uint     r,
-               char     rootFlag,
-               char     multImpFlag,
-               uint     treeID,
-               Node    *parent,
-               uint    *repMembrIndx,
-               uint     repMembrSize,
-               uint    *allMembrIndx,
-               uint     allMembrSize,
-               uint     depth,
-               uint    *maximumDepth,
-               uint    *bootMembrIndxIter) {
-  char  bootResult;
-  char  splitResult;
-  char  forkResult;
-  char leftResult, rghtResult;
-  char terminalFlag;
-  char bsUpdateFlag;
-  uint *bootMembrIndx;
-  uint *leftRepMembrIndx;
-  uint *rghtRepMembrIndx;
-  uint *leftAllMembrIndx;
-  uint *rghtAllMembrIndx;
-  uint bootMembrSize;
-  uint leftAllMembrSize;
-  uint rghtAllMembrSize;
-  uint leftRepMembrSize, jLeft;
-  uint rghtRepMembrSize, jRght;
-  uint     splitParameterMax;
-  double   splitValueMaxCont;
-  uint     splitValueMaxFactSize;
-  uint    *splitValueMaxFactPtr;
-  double   splitStatistic;
-  char    *splitIndicator;
-  uint i, k, p;
-  parent -> depth = depth;
-  bootResult = TRUE;
-  terminalFlag = TRUE;
-  bsUpdateFlag = FALSE;
-  splitIndicator = NULL;
-  if (rootFlag | (RF_opt & OPT_BOOT_NODE)) {
-    if (!(RF_opt & OPT_BOOT_NONE) && !(RF_opt & OPT_BOOT_NODE)) {
-      bootMembrIndx  = uivector(1, RF_bootstrapSize);
-      bootMembrSize = RF_bootstrapSize;
+void updateEnsembleCalculations (char      multImpFlag,
+                                 uint      mode,
+                                 uint      b) {
+  uint      thisSerialTreeCount;
+  uint      j;
+  Arena    *arena;
+  thisSerialTreeCount  = 0;      
+  if (RF_deterministicFlag) {
+    RF_treeEnsembleFlag[b] = TRUE;
+    if (RF_ensemblePartialFlag) {
+      if (RF_tLeafCount[b] > 0) {
+        arena = suspendArena();
+        stackEnsemblePartial(mode, b);
+        resumeArena(arena);
+      }
     }
+  }
+  else { 
+#ifdef _OPENMP
+#pragma omp critical (_update_ensemble)
+#endif
+    if (RF_tLeafCount[b] > 0) {
+      RF_serialTreeIndex[++RF_serialTreeCount] = b;
+      thisSerialTreeCount = RF_serialTreeCount;
+      if (!RF_ensemblePartialFlag) {
+        updateEnsembleOutcomes(mode, b, thisSerialTreeCount);
+        updateEnsemblePerformance(mode, multImpFlag, b, thisSerialTreeCount);
+      }
+    }  
     else {
-      bootMembrIndx  = uivector(1, allMembrSize);
-      bootMembrSize = allMembrSize;
-    }
-    bootResult = bootstrap (RF_GROW,
-                            treeID,
-                            parent,
-                            allMembrIndx,
-                            allMembrSize,
-                            bootMembrIndx,
-                            bootMembrSize);
-    if (rootFlag & bootResult) {
-      if (!(RF_opt & OPT_BOOT_NODE)) {
-        bsUpdateFlag = TRUE;
+      RF_serialTreeIndex[++RF_serialTreeCount] = b;
+    }  
+    if (RF_userTraceFlag) {
+      double userTimeElapsedFromStart;
+      double userTimeElapsedFromSplit;
+      double userTimeRemaining;
+      time_t current;
+      current = time(NULL);
+      userTimeElapsedFromSplit = (double) (current - RF_userTimeSplit);
+      if ((userTimeElapsedFromSplit) > (double) RF_userTraceFlag) {
+        userTimeElapsedFromStart = (double) (current - RF_userTimeStart);
+        userTimeRemaining = (userTimeElapsedFromStart / RF_serialTreeCount * RF_forestSize) - userTimeElapsedFromStart;
+        RFprintf("\nTrees Grown:  %6d,    Time Remaining (sec):  %6.0f", RF_serialTreeCount, ceil(userTimeRemaining));
+        RF_userTimeSplit = current;
       }
-      if (RF_mRecordSize > 0) {
-        if (TRUE) {
-          for (p = 1; p <= RF_mpIndexSize; p++) {
-            if (RF_mpIndex[p] > 0) {
-              if (parent -> mpSign[p] == -1) {
-                (parent -> permissibleSplit)[RF_mpIndex[p]] = FALSE;
-              }
-            }
+    }
+  } 
+  if (RF_ensemblePartialFlag) {
+    if (RF_tLeafCount[b] > 0) {
+      updateEnsembleOutcomes(mode, b, thisSerialTreeCount);
+    }
+  }
+  if (RF_tLeafCount[b] > 0) {
+    if (mode == RF_GROW) {
+      if ((RF_timeIndex > 0) && (RF_statusIndex > 0)) {
+        if (!(RF_optHigh & OPT_TERM)) {
+          for (j = 1; j <= RF_tLeafCount[b]; j++) {
+            freeTerminalNodeSurvivalStructuresNonVimp(RF_tTermList[b][j]);
           }
         }
-        else {
-          k = 0;
-          for (p = 1; p <= RF_xSize; p++) {      
-            if (parent -> mpSign[RF_rSize + p] != -1) {
-              parent -> permissibleSplitIndex[++k] = p;
+        if (!(RF_opt & OPT_VIMP)) {
+          if (!(RF_optHigh & OPT_TERM)) {
+            for (j = 1; j <= RF_tLeafCount[b]; j++) {
+              freeTerminalNodeSurvivalStructuresFinal(RF_tTermList[b][j]);
             }
           }
-          parent -> permissibleSizeActual = k;
         }
       }
       else {
-        if (FALSE) {
-          for (p = 1; p <= RF_xSize; p++) {      
-            parent -> permissibleSplitIndex[p] = p;
+        if (!(RF_opt & OPT_VIMP)) {
+          if (!(RF_optHigh & OPT_TERM)) {
+            for (j = 1; j <= RF_tLeafCount[b]; j++) {
+              freeTerminalNodeNonSurvivalStructures(RF_tTermList[b][j]);
+            }
           }
-          parent -> permissibleSizeActual = parent -> permissibleSizeAlloc;
         }
       }
     }
-  }
-  else {
-    bootMembrIndx = repMembrIndx;
-    bootMembrSize = repMembrSize;
-    parent -> mpSign = (parent -> parent) -> mpSign;
-  }
-  if (bootResult) {
-    if (multImpFlag == FALSE) {
-      if (RF_mRecordSize > 0) {
-        imputeNode(RF_GROW,
-                   FALSE,  
-                   TRUE,   
-                   treeID,
-                   parent,
-                   bootMembrIndx,
-                   bootMembrSize,
-                   allMembrIndx,
-                   allMembrSize);
-        if (RF_timeIndex > 0) {
-          if (RF_mTimeFlag == TRUE) {
-            updateTimeIndexArray(treeID,
-                                 allMembrIndx,
-                                 allMembrSize,
-                                 RF_time[treeID],
-                                 FALSE,
-                                 FALSE,
-                                 RF_masterTimeIndex[treeID]);
+    else {
+      if ((RF_timeIndex > 0) && (RF_statusIndex > 0)) {
+        for (j = 1; j <= RF_tLeafCount[b]; j++) {
+          freeTerminalNodeSurvivalStructuresNonVimp(RF_tTermList[b][j]);
+        }
+        if (!(RF_opt & OPT_VIMP)) {
+          for (j = 1; j <= RF_tLeafCount[b]; j++) {
+            freeTerminalNodeSurvivalStructuresFinal(RF_tTermList[b][j]);
           }
         }
       }
-    }  
-  }  
-  if (bootResult) {
-    if (rootFlag) {
-      RF_tLeafCount[treeID] = 1;
-    }
-    splitResult = getBestSplit(treeID,
-                               parent,
-                               bootMembrIndx,
-                               bootMembrSize,
-                               allMembrIndx,
-                               allMembrSize,
-                               & splitParameterMax,
-                               & splitValueMaxCont,
-                               & splitValueMaxFactSize,
-                               & splitValueMaxFactPtr,
-                               & splitStatistic,
-                               & splitIndicator,
-                               multImpFlag);
-    if (splitResult == TRUE) {
-      if (FALSE) {
-        parent -> permissibleSizeActual = parent -> permissibleSizeAlloc;
-      }
       else {
-      }
-      terminalFlag = FALSE;
-      char *membershipIndicator = cvector(1, RF_observationSize);
-      forkResult = forkAndUpdate(treeID,
-                                 parent,
-                                 bootMembrIndx,
-                                 bootMembrSize,
-                                 allMembrIndx,
-                                 allMembrSize,
-                                 splitParameterMax,
-                                 splitValueMaxCont,
-                                 splitValueMaxFactSize,
-                                 splitValueMaxFactPtr,
-                                 splitStatistic,
-                                 splitIndicator,
-                                 multImpFlag,
-                                 membershipIndicator,
-                                 &leftAllMembrSize,
-                                 &rghtAllMembrSize);
-      if (forkResult == TRUE) {
-        leftAllMembrIndx  = uivector(1, leftAllMembrSize);
-        rghtAllMembrIndx  = uivector(1, rghtAllMembrSize);
-        jLeft = jRght = 0;
-        for (i = 1; i <= allMembrSize; i++) {
-          if (membershipIndicator[allMembrIndx[i]] == LEFT) {
-            leftAllMembrIndx[++jLeft] = allMembrIndx[i];
-          }
-          else {
-            rghtAllMembrIndx[++jRght] = allMembrIndx[i];
-          }
-        }
-        if (RF_opt & OPT_BOOT_NODE) {
-          leftRepMembrIndx = leftAllMembrIndx;
-          leftRepMembrSize = leftAllMembrSize;
-          rghtRepMembrIndx = rghtAllMembrIndx;
-          rghtRepMembrSize = rghtAllMembrSize;
-        }
-        else {
-          leftRepMembrIndx  = uivector(1, bootMembrSize);
-          rghtRepMembrIndx  = uivector(1, bootMembrSize);
-          leftRepMembrSize = rghtRepMembrSize = 0;
-          for (i = 1; i <= bootMembrSize; i++) {
-            if (membershipIndicator[bootMembrIndx[i]] == LEFT) {
-              leftRepMembrIndx[++leftRepMembrSize] = bootMembrIndx[i];
-            }
-            else {
-              rghtRepMembrIndx[++rghtRepMembrSize] = bootMembrIndx[i];
-            }
+        if (!(RF_opt & OPT_VIMP)) {
+          for (j = 1; j <= RF_tLeafCount[b]; j++) {
+            freeTerminalNodeNonSurvivalStructures(RF_tTermList[b][j]);
           }
         }
-        free_cvector(membershipIndicator, 1, RF_observationSize);
-        leftResult = growTree (r,
-                               FALSE,
-                               multImpFlag,
-                               treeID,
-                               parent -> left,
-                               leftRepMembrIndx,
-                               leftRepMembrSize,
-                               leftAllMembrIndx,
-                               leftAllMembrSize,
-                               (parent -> depth) + 1,
-                               maximumDepth,
-                               bootMembrIndxIter);
-        if(!leftResult) {
-        }
-        rghtResult = growTree (r,
-                               FALSE,
-                               multImpFlag,
-                               treeID,
-                               parent -> right,
-                               rghtRepMembrIndx,
-                               rghtRepMembrSize,
-                               rghtAllMembrIndx,
-                               rghtAllMembrSize,
-                               (parent -> depth) + 1,
-                               maximumDepth,
-                               bootMembrIndxIter);
-        if(!rghtResult) {
-        }
-        free_uivector(leftAllMembrIndx, 1, leftAllMembrSize);
-        free_uivector(rghtAllMembrIndx, 1, rghtAllMembrSize);
-        if (RF_opt & OPT_BOOT_NODE) {
-        }
-        else {
-          free_uivector(leftRepMembrIndx, 1, bootMembrSize);
-          free_uivector(rghtRepMembrIndx, 1, bootMembrSize);
-        }
-      }
-      else {
-        RFprintf("\nRF-SRC:  *** ERROR *** ");
-        RFprintf("\nRF-SRC:  forkAndUpdate(%10d) failed.", treeID);
-        RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-        error("\nRF-SRC:  The application will now exit.\n");
-      }
-    }  
-    else {
-      parent -> splitFlag = FALSE;
-      if (TRUE) {
-        free_cvector(parent -> permissibleSplit, 1, parent -> xSize);
-        parent -> permissibleSplit = NULL;
-        parent -> xSize = 0;
       }
-      else {
-        free_uivector(parent -> permissibleSplitIndex, 1, parent -> permissibleSizeAlloc);
-        parent -> permissibleSplitIndex = NULL;
-        parent -> permissibleSizeAlloc = 0;
+    }
+    if (RF_opt & OPT_VIMP) {
+      if (RF_opt & OPT_VIMP_LEOB) {
+        summarizeTreePerformance(mode, b);
       }
     }
   }  
+}
+void updateEnsembleOutcomes(uint mode, uint b, uint serialTreeID) {
+  char potentiallyMixedMultivariate;
+  if ((RF_timeIndex > 0) && (RF_statusIndex > 0)) {
+    updateEnsembleSurvival(mode, b, serialTreeID);
+  }  
   else {
-    if (rootFlag) {
-      if (!bootResult) {
-        terminalFlag = FALSE;
+    potentiallyMixedMultivariate = FALSE;
+    if (RF_rTargetFactorCount > 0) {
+      updateEnsembleMultiClass(mode, b, serialTreeID, potentiallyMixedMultivariate);
+      potentiallyMixedMultivariate = TRUE;
+    }
+    if (RF_rTargetNonFactorCount > 0) {
+      updateEnsembleMean(mode, b, serialTreeID, potentiallyMixedMultivariate);
+      potentiallyMixedMultivariate = TRUE;
+    }
+  }
+}
+void updateEnsemblePerformance(uint mode, char multImpFlag, uint b, uint thisSerialTreeCount) {
+  updateGenericEnsemblePerformance(mode,
+                                   multImpFlag,
+                                   b,
+                                   thisSerialTreeCount,
+                                   (mode == RF_PRED) ? RF_fullEnsembleDen : RF_oobEnsembleDen,
+                                   (mode == RF_PRED) ? RF_fullEnsembleMRTptr : RF_oobEnsembleMRTptr,
+                                   (mode == RF_PRED) ? RF_fullEnsembleCLSptr : RF_oobEnsembleCLSptr,
+                                   (mode == RF_PRED) ? RF_fullEnsembleRGRptr : RF_oobEnsembleRGRptr);
+}
+void updateGenericEnsemblePerformance(uint       mode,
+                                      char       multImpFlag,
+                                      uint       b,
+                                      uint       thisSerialTreeCount,
+                                      uint      *ensembleDen,
+                                      double   **ensembleMRTptr,
+                                      double  ***ensembleCLSptr,
+                                      double   **ensembleRGRptr) {
+  uint      obsSize;
+  double  **responsePtr;
+  char      respImputeFlag;
+  responsePtr = NULL;  
+  obsSize = (mode == RF_PRED) ?  RF_fobservationSize : RF_observationSize;
+  if (getPerformanceFlag(mode, thisSerialTreeCount)) {
+    respImputeFlag = stackAndImputePerfResponse(mode,
+                                                multImpFlag,
+                                                b,
+                                                thisSerialTreeCount,
+                                                &responsePtr);
+  }
+  else {
+    respImputeFlag = FALSE;
+  }
+  if (getPerformanceFlag(mode, thisSerialTreeCount)) {
+    if ((RF_timeIndex > 0) && (RF_statusIndex > 0)) {
+      getPerformance(thisSerialTreeCount,
+                     mode,
+                     obsSize,
+                     responsePtr,
+                     ensembleDen,
+                     ensembleMRTptr,
+                     NULL,
+                     NULL,
+                     RF_perfMRTptr[thisSerialTreeCount],
+                     NULL,
+                     NULL);
+    }
+    else {
+      if (RF_rTargetFactorCount > 0) {
+        getPerformance(thisSerialTreeCount,
+                       mode,
+                       obsSize,
+                       responsePtr,
+                       ensembleDen,
+                       NULL,
+                       ensembleCLSptr,
+                       NULL,
+                       NULL,
+                       RF_perfCLSptr[thisSerialTreeCount],
+                       NULL);
+      }
+      if (RF_rTargetNonFactorCount > 0) {
+        getPerformance(thisSerialTreeCount,
+                       mode,
+                       obsSize,
+                       responsePtr,
+                       ensembleDen,
+                       NULL,
+                       NULL,
+                       ensembleRGRptr,
+                       NULL,
+                       NULL,
+                       RF_perfRGRptr[thisSerialTreeCount]);
       }
     }
+    unstackImputeResponse(respImputeFlag, obsSize, responsePtr);
   }  
-  if (terminalFlag) {
-    parent -> pseudoTerminal = TRUE;
-    RF_tNodeList[treeID][parent -> nodeID] = parent;
-    RF_tTermList[treeID][parent -> nodeID] = makeTerminal();
-    RF_tTermList[treeID][parent -> nodeID] -> nodeID = parent -> nodeID;
-    if (RF_opt & OPT_MISS) {
-      imputeNodeAndSummarize(r,
-                             RF_GROW,
-                             treeID,
-                             parent,
-                             bootMembrIndx,
-                             bootMembrSize,
-                             allMembrIndx,
-                             allMembrSize,
-                             NULL,
-                             0);
-    }
-    if ((RF_opt & OPT_PERF) |
-        (RF_opt & OPT_PERF_CALB) |
-        (RF_opt & OPT_OENS) |
-        (RF_opt & OPT_FENS)) {
-      updateTerminalNodeOutcomesNew(treeID,
-                                    RF_tTermList[treeID][parent -> nodeID],
-                                    bootMembrIndx,
-                                    bootMembrSize,
-                                    allMembrIndx,
-                                    allMembrSize);
+}
+uint getEnsemblePartialIndex(uint treeID) {
+  uint result;
+  result = 1;
+  if (RF_ensemblePartialFlag) {
+    result = (RF_deterministicFlag) ? treeID : getThreadIndex();
+  }
+  return result;
+}
+uint getThreadIndex() {
+  uint result;
+  result = 1;
+#ifdef _OPENMP
+  result = omp_get_thread_num() + 1;
+#endif
+  return result;
+}
+void stackThreadSchedule() {
+  uint i;
+  RF_threadBusySize = (RF_numThreads > 0) ? RF_numThreads : 1;
+  RF_threadBusyTime = dvector(1, RF_threadBusySize);
+  for (i = 1; i <= RF_threadBusySize; i++) {
+    RF_threadBusyTime[i] = 0.0;
+  }
+#ifdef _OPENMP
+  omp_get_schedule(& RF_threadScheduleKind, & RF_threadScheduleChunk);
+  switch ((RF_optHigh & OPT_SCHD) >> 22) {
+  case 0:
+    omp_set_schedule(omp_sched_static, 0);
+    break;
+  case 1:
+    omp_set_schedule(omp_sched_dynamic, 1);
+    break;
+  default:
+    omp_set_schedule(omp_sched_guided, 1);
+    break;
+  }
+#endif
+}
+void unstackThreadSchedule() {
+  uint i;
+  if (RF_userTraceFlag) {
+    RFprintf("\nThread Busy Time (sec):  ");
+    for (i = 1; i <= RF_threadBusySize; i++) {
+      RFprintf("%10.3f", RF_threadBusyTime[i]);
     }
-    if (RF_opt & OPT_BOOT_NODE) {
-      bsUpdateFlag = TRUE;
+    RFprintf("\n");
+  }
+#ifdef _OPENMP
+  omp_set_schedule(RF_threadScheduleKind, RF_threadScheduleChunk);
+#endif
+  free_dvector(RF_threadBusyTime, 1, RF_threadBusySize);
+}
+double getThreadClock() {
+#ifdef _OPENMP
+  return omp_get_wtime();
+#else
+  return ((double) clock()) / CLOCKS_PER_SEC;
+#endif
+}
+void updateThreadBusyTime(double busyStart) {
+  RF_threadBusyTime[getThreadIndex()] += getThreadClock() - busyStart;
+}
+char getEnsemblePartialFlag(uint mode) {
+  char result;
+  uint obsSize, setCount;
+  result = FALSE;
+  if (((RF_numThreads > 1) && (RF_optHigh & OPT_ENSB_PART)) || (RF_deterministicFlag)) {
+    if ((RF_opt & OPT_OENS) || (RF_opt & OPT_FENS)) {
+      result = TRUE;
+      if ((RF_opt & OPT_PERF) | (RF_opt & OPT_PERF_CALB)) {
+        if (!(RF_optHigh & OPT_TREE_ERR) && !(RF_deterministicFlag)) {
+          result = FALSE;
+        }
+      }
+      if (RF_opt & OPT_SPLT_NULL) {
+        result = FALSE;
+      }
+      if (((mode == RF_PRED) ? RF_fmRecordSize : RF_mRecordSize) > 0) {
+        result = FALSE;
+      }
     }
-    if (RF_opt & (OPT_SPLDPTH_F | OPT_SPLDPTH_T)) {
-      getSplitDepth(parent, maximumDepth);
+  }
+  if ((result) && (!RF_deterministicFlag)) {
+    obsSize = (mode == RF_PRED) ?  RF_fobservationSize : RF_observationSize;
+    setCount = 0;
+    if ((mode != RF_PRED) && (RF_opt & OPT_OENS)) {
+      setCount ++;
     }
-  }  
-  if (bsUpdateFlag) {
-    for (i = 1; i <= bootMembrSize; i++) {
-      RF_bootMembershipIndex[treeID][++(*bootMembrIndxIter)] = bootMembrIndx[i];
-      RF_bootMembershipFlag[treeID][bootMembrIndx[i]] = TRUE;
-      RF_oobMembershipFlag[treeID][bootMembrIndx[i]]  = FALSE;
-      RF_bootMembershipCount[treeID][bootMembrIndx[i]] ++;
+    if (RF_opt & OPT_FENS) {
+      setCount ++;
     }
-    if (RF_opt & OPT_MEMB) {
-      for (i=1; i <=  bootMembrSize; i++) {
-        RF_bootstrapMembershipPtr[treeID][bootMembrIndx[i]] ++;
+    if ((double) RF_numThreads * setCount * getEnsembleNumeratorSize(obsSize) > PARTIAL_BUDGET_SIZE) {
+      result = FALSE;
+      if (RF_userTraceFlag) {
+        RFprintf("\nRF-SRC:  Per-thread ensemble partials exceed the memory budget, using the shared ensemble.");
       }
     }
   }
-  if (rootFlag | (RF_opt & OPT_BOOT_NODE)) {
-    if (!(RF_opt & OPT_BOOT_NONE) && !(RF_opt & OPT_BOOT_NODE)) {
-      free_uivector(bootMembrIndx, 1, RF_bootstrapSize);
+  return result;
+}
+double getEnsembleNumeratorSize(uint obsSize) {
+  double result;
+  uint j;
+  result = 0.5;
+  if ((RF_timeIndex > 0) && (RF_statusIndex > 0)) {
+    result += (double) RF_eventTypeSize * (RF_sortedTimeInterestSize + 1);
+    if (!(RF_opt & OPT_COMP_RISK)) {
+      result += (double) RF_sortedTimeInterestSize;
     }
     else {
-      free_uivector(bootMembrIndx, 1, allMembrSize);
+      result += (double) RF_eventTypeSize * RF_sortedTimeInterestSize;
     }
   }
-  return bootResult;
+  else {
+    for (j = 1; j <= RF_rTargetFactorCount; j++) {
+      result += (double) RF_rFactorSize[RF_rFactorMap[RF_rTargetFactor[j]]];
+    }
+    result += (double) RF_rTargetNonFactorCount;
+  }
+  return result * obsSize;
 }
-char restoreTree(uint    mode,
-                 uint    b,
-                 Node   *parent,
-                 uint   *offset,
-                 uint   *treeID,
-                 uint   *nodeID,
-                 uint   *parmID,
-                 double *contPT,
-                 uint   *mwcpSZ,
-                 uint  **mwcpPtr,
-                 uint    depth,
-                 uint   *maximumDepth) {
-  char terminalFlag;
-  uint i;
-  if (b != treeID[*offset]) {
-    RFprintf("\nRF-SRC:  Diagnostic Trace of Tree Record:  \n");
-    RFprintf("\nRF-SRC:      treeID     nodeID     parmID       spltPT     mwcpSZ ");
-    RFprintf("\nRF-SRC:  %10d %10d %10d %12.4f %10d \n", treeID[*offset], nodeID[*offset], parmID[*offset], contPT[*offset], mwcpSZ[*offset]);
-    RFprintf("\nRF-SRC:  *** ERROR *** ");
-    RFprintf("\nRF-SRC:  Invalid forest input record in tree:  %10d", b);
-    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-    error("\nRF-SRC:  The application will now exit.\n");
+void stackEnsembleNumerators(uint       obsSize,
+                             uint     **ensembleDen,
+                             double ****ensembleSRGnum,
+                             double  ***ensembleMRTnum,
+                             double  ***ensembleSRVnum,
+                             double ****ensembleCIFnum,
+                             double ****ensembleCLSnum,
+                             double  ***ensembleRGRnum) {
+  uint i, j, k;
+  *ensembleSRGnum = *ensembleCIFnum = *ensembleCLSnum = NULL;
+  *ensembleMRTnum = *ensembleSRVnum = *ensembleRGRnum = NULL;
+  *ensembleDen = uivector(1, obsSize);
+  for (i = 1; i <= obsSize; i++) {
+    (*ensembleDen)[i] = 0;
   }
-  parent -> depth = depth;
-  parent -> left  = NULL;
-  parent -> right = NULL;
-  parent -> splitFlag = FALSE;
-  parent -> nodeID = nodeID[*offset];
-  parent -> splitParameter = parmID[*offset];
-  if ((parent -> splitParameter) != 0) {
-    if (strcmp(RF_xType[parent -> splitParameter], "C") == 0) {
-      parent -> splitValueFactSize = mwcpSZ[*offset];
-      parent -> splitValueFactPtr = uivector(1, mwcpSZ[*offset]);
-      for (i = 1; i <= parent -> splitValueFactSize; i++) {
-        (*mwcpPtr) ++;
-        (parent -> splitValueFactPtr)[i] = **mwcpPtr;
+  if ((RF_timeIndex > 0) && (RF_statusIndex > 0)) {
+    *ensembleSRGnum = (double ***) new_vvector(1, RF_eventTypeSize, NRUTIL_DPTR2);
+    *ensembleMRTnum = (double **) new_vvector(1, RF_eventTypeSize, NRUTIL_DPTR);
+    for (j = 1; j <= RF_eventTypeSize; j++) {
+      (*ensembleSRGnum)[j] = dmatrix(1, RF_sortedTimeInterestSize, 1, obsSize);
+      (*ensembleMRTnum)[j] = dvector(1, obsSize);
+      for (i = 1; i <= obsSize; i++) {
+        (*ensembleMRTnum)[j][i] = 0.0;
+        for (k = 1; k <= RF_sortedTimeInterestSize; k++) {
+          (*ensembleSRGnum)[j][k][i] = 0.0;
+        }
+      }
+    }
+    if (!(RF_opt & OPT_COMP_RISK)) {
+      *ensembleSRVnum = dmatrix(1, RF_sortedTimeInterestSize, 1, obsSize);
+      for (k = 1; k <= RF_sortedTimeInterestSize; k++) {
+        for (i = 1; i <= obsSize; i++) {
+          (*ensembleSRVnum)[k][i] = 0.0;
+        }
       }
-      parent -> splitValueCont = NA_REAL;
     }
     else {
-      parent -> splitValueCont = contPT[*offset];
-      parent -> splitValueFactSize = 0;
-      parent -> splitValueFactPtr = NULL;
+      *ensembleCIFnum = (double ***) new_vvector(1, RF_eventTypeSize, NRUTIL_DPTR2);
+      for (j = 1; j <= RF_eventTypeSize; j++) {
+        (*ensembleCIFnum)[j] = dmatrix(1, RF_sortedTimeInterestSize, 1, obsSize);
+        for (k = 1; k <= RF_sortedTimeInterestSize; k++) {
+          for (i = 1; i <= obsSize; i++) {
+            (*ensembleCIFnum)[j][k][i] = 0.0;
+          }
+        }
+      }
     }
   }
   else {
-    parent -> splitValueCont     = NA_REAL;
-    parent -> splitValueFactSize = 0;
-    parent -> splitValueFactPtr  = NULL;
+    if (RF_rTargetFactorCount > 0) {
+      *ensembleCLSnum = (double ***) new_vvector(1, RF_rTargetFactorCount, NRUTIL_DPTR2);
+      for (j = 1; j <= RF_rTargetFactorCount; j++) {
+        (*ensembleCLSnum)[j] = dmatrix(1, RF_rFactorSize[RF_rFactorMap[RF_rTargetFactor[j]]], 1, obsSize);
+        for (k = 1; k <= RF_rFactorSize[RF_rFactorMap[RF_rTargetFactor[j]]]; k++) {
+          for (i = 1; i <= obsSize; i++) {
+            (*ensembleCLSnum)[j][k][i] = 0.0;
+          }
+        }
+      }
+    }
+    if (RF_rTargetNonFactorCount > 0) {
+      *ensembleRGRnum = dmatrix(1, RF_rTargetNonFactorCount, 1, obsSize);
+      for (j = 1; j <= RF_rTargetNonFactorCount; j++) {
+        for (i = 1; i <= obsSize; i++) {
+          (*ensembleRGRnum)[j][i] = 0.0;
+        }
+      }
+    }
   }
-  (*offset) ++;
-  if ((parent -> splitParameter) != 0) {
-    terminalFlag = FALSE;
-    parent -> left  = makeNode(0, 0, parent -> urStatSize, parent -> mtrySize);
-    setParent(parent ->  left, parent);
-    restoreTree(mode,
-                b,
-                parent -> left,
-                offset,
-                treeID,
-                nodeID,
-                parmID,
-                contPT,
-                mwcpSZ,
-                mwcpPtr,
-                parent -> depth + 1,
-                maximumDepth);
-    parent -> right = makeNode(0, 0, parent -> urStatSize, parent -> mtrySize);
-    setParent(parent -> right, parent);
-    restoreTree(mode,
-                b,
-                parent -> right,
-                offset,
-                treeID,
-                nodeID,
-                parmID,
-                contPT,
-                mwcpSZ,
-                mwcpPtr,
-                parent -> depth + 1,
-                maximumDepth);
+}
+void unstackEnsembleNumerators(uint      obsSize,
+                               uint     *ensembleDen,
+                               double ***ensembleSRGnum,
+                               double  **ensembleMRTnum,
+                               double  **ensembleSRVnum,
+                               double ***ensembleCIFnum,
+                               double ***ensembleCLSnum,
+                               double  **ensembleRGRnum) {
+  uint j;
+  free_uivector(ensembleDen, 1, obsSize);
+  if ((RF_timeIndex > 0) && (RF_statusIndex > 0)) {
+    for (j = 1; j <= RF_eventTypeSize; j++) {
+      free_dmatrix(ensembleSRGnum[j], 1, RF_sortedTimeInterestSize, 1, obsSize);
+      free_dvector(ensembleMRTnum[j], 1, obsSize);
+    }
+    free_new_vvector(ensembleSRGnum, 1, RF_eventTypeSize, NRUTIL_DPTR2);
+    free_new_vvector(ensembleMRTnum, 1, RF_eventTypeSize, NRUTIL_DPTR);
+    if (!(RF_opt & OPT_COMP_RISK)) {
+      free_dmatrix(ensembleSRVnum, 1, RF_sortedTimeInterestSize, 1, obsSize);
+    }
+    else {
+      for (j = 1; j <= RF_eventTypeSize; j++) {
+        free_dmatrix(ensembleCIFnum[j], 1, RF_sortedTimeInterestSize, 1, obsSize);
+      }
+      free_new_vvector(ensembleCIFnum, 1, RF_eventTypeSize, NRUTIL_DPTR2);
+    }
   }
   else {
-    terminalFlag = TRUE;
-  }
-  if (terminalFlag) {
-    if (RF_opt & (OPT_SPLDPTH_F | OPT_SPLDPTH_T)) {
-      getSplitDepth(parent, maximumDepth);
+    if (RF_rTargetFactorCount > 0) {
+      for (j = 1; j <= RF_rTargetFactorCount; j++) {
+        free_dmatrix(ensembleCLSnum[j], 1, RF_rFactorSize[RF_rFactorMap[RF_rTargetFactor[j]]], 1, obsSize);
+      }
+      free_new_vvector(ensembleCLSnum, 1, RF_rTargetFactorCount, NRUTIL_DPTR2);
     }
-    RF_tNodeList[b][parent -> nodeID] = parent;
-    RF_tTermList[b][parent -> nodeID] = makeTerminal();
-    RF_tTermList[b][parent -> nodeID] -> nodeID = parent -> nodeID;
-    if (getRestoreNodeMembershipGrowFlag(mode)) {
-      RF_tTermList[b][parent -> nodeID] -> membrCount = RF_TN_MCNT_ptr[b][parent -> nodeID];
-      if (RF_tTermList[b][parent -> nodeID] -> membrCount == 0) {
-        RFprintf("\nRF-SRC:  *** ERROR *** ");
-        RFprintf("\nRF-SRC:  Zero node count encountered during fast restore in (tree, leaf):  %10d %10d", b, parent -> nodeID);
-        RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-        error("\nRF-SRC:  The application will now exit.\n");
+    if (RF_rTargetNonFactorCount > 0) {
+      free_dmatrix(ensembleRGRnum, 1, RF_rTargetNonFactorCount, 1, obsSize);
+    }
+  }
+}
+void reduceEnsembleNumerators(uint      obsSize,
+                              uint     *partialDen,
+                              double ***partialSRGnum,
+                              double  **partialMRTnum,
+                              double  **partialSRVnum,
+                              double ***partialCIFnum,
+                              double ***partialCLSnum,
+                              double  **partialRGRnum,
+                              uint     *ensembleDen,
+                              double ***ensembleSRGnum,
+                              double  **ensembleMRTnum,
+                              double  **ensembleSRVnum,
+                              double ***ensembleCIFnum,
+                              double ***ensembleCLSnum,
+                              double  **ensembleRGRnum) {
+  uint i, j, k;
+  for (i = 1; i <= obsSize; i++) {
+    if (partialDen[i] > 0) {
+      ensembleDen[i] += partialDen[i];
+      if ((RF_timeIndex > 0) && (RF_statusIndex > 0)) {
+        for (j = 1; j <= RF_eventTypeSize; j++) {
+          ensembleMRTnum[j][i] += partialMRTnum[j][i];
+          for (k = 1; k <= RF_sortedTimeInterestSize; k++) {
+            ensembleSRGnum[j][k][i] += partialSRGnum[j][k][i];
+          }
+        }
+        if (!(RF_opt & OPT_COMP_RISK)) {
+          for (k = 1; k <= RF_sortedTimeInterestSize; k++) {
+            ensembleSRVnum[k][i] += partialSRVnum[k][i];
+          }
+        }
+        else {
+          for (j = 1; j <= RF_eventTypeSize; j++) {
+            for (k = 1; k <= RF_sortedTimeInterestSize; k++) {
+              ensembleCIFnum[j][k][i] += partialCIFnum[j][k][i];
+            }
+          }
+        }
       }
-      if ((RF_opt & OPT_PERF) |
-          (RF_opt & OPT_PERF_CALB) |
-          (RF_opt & OPT_OENS) |
-          (RF_opt & OPT_FENS)) {
-        restoreTerminalNodeOutcomes(b, RF_tTermList[b][parent -> nodeID]);
+      else {
+        if (RF_rTargetFactorCount > 0) {
+          for (j = 1; j <= RF_rTargetFactorCount; j++) {
+            for (k = 1; k <= RF_rFactorSize[RF_rFactorMap[RF_rTargetFactor[j]]]; k++) {
+              ensembleCLSnum[j][k][i] += partialCLSnum[j][k][i];
+            }
+          }
+        }
+        if (RF_rTargetNonFactorCount > 0) {
+          for (j = 1; j <= RF_rTargetNonFactorCount; j++) {
+            ensembleRGRnum[j][i] += partialRGRnum[j][i];
+          }
+        }
       }
     }
   }
-  return (!terminalFlag);
 }
-void saveTree(uint    b,
-              Node   *parent,
-              uint   *offset,
-              uint   *treeID,
-              uint   *nodeID,
-              uint   *parmID,
-              double *contPT,
-              uint   *mwcpSZ,
-              uint  **mwcpPtr,
-              uint   *mwcpCT) {
-  uint i;
-  treeID[*offset] = b;
-  nodeID[*offset] = parent -> nodeID;
-  parmID[*offset] = parent -> splitParameter;
-  if ((parent -> splitParameter) != 0) {
-    if (strcmp(RF_xType[parent -> splitParameter], "C") == 0) {
-      mwcpSZ[*offset] = parent -> splitValueFactSize;
-      for (i = 1; i <= mwcpSZ[*offset]; i++) {
-        (*mwcpPtr) ++;
-        **mwcpPtr = (parent -> splitValueFactPtr)[i];
-        mwcpCT[b] ++;
+void stackEnsemblePartials(uint mode) {
+  uint t;
+  RF_ensemblePartialFlag = getEnsemblePartialFlag(mode);
+  if (RF_ensemblePartialFlag) {
+    RF_ensemblePartialSize = (RF_deterministicFlag) ? RF_forestSize : RF_numThreads;
+    RF_oobEnsembleDenPart    = (uint **)    new_vvector(1, RF_ensemblePartialSize, NRUTIL_UPTR);
+    RF_oobEnsembleSRGpart    = (double ****) new_vvector(1, RF_ensemblePartialSize, NRUTIL_DPTR3);
+    RF_oobEnsembleMRTpart    = (double ***) new_vvector(1, RF_ensemblePartialSize, NRUTIL_DPTR2);
+    RF_oobEnsembleSRVpart    = (double ***) new_vvector(1, RF_ensemblePartialSize, NRUTIL_DPTR2);
+    RF_oobEnsembleCIFpart    = (double ****) new_vvector(1, RF_ensemblePartialSize, NRUTIL_DPTR3);
+    RF_oobEnsembleCLSpart    = (double ****) new_vvector(1, RF_ensemblePartialSize, NRUTIL_DPTR3);
+    RF_oobEnsembleRGRpart    = (double ***) new_vvector(1, RF_ensemblePartialSize, NRUTIL_DPTR2);
+    RF_fullEnsembleDenPart   = (uint **)    new_vvector(1, RF_ensemblePartialSize, NRUTIL_UPTR);
+    RF_fullEnsembleSRGpart   = (double ****) new_vvector(1, RF_ensemblePartialSize, NRUTIL_DPTR3);
+    RF_fullEnsembleMRTpart   = (double ***) new_vvector(1, RF_ensemblePartialSize, NRUTIL_DPTR2);
+    RF_fullEnsembleSRVpart   = (double ***) new_vvector(1, RF_ensemblePartialSize, NRUTIL_DPTR2);
+    RF_fullEnsembleCIFpart   = (double ****) new_vvector(1, RF_ensemblePartialSize, NRUTIL_DPTR3);
+    RF_fullEnsembleCLSpart   = (double ****) new_vvector(1, RF_ensemblePartialSize, NRUTIL_DPTR3);
+    RF_fullEnsembleRGRpart   = (double ***) new_vvector(1, RF_ensemblePartialSize, NRUTIL_DPTR2);
+    for (t = 1; t <= RF_ensemblePartialSize; t++) {
+      RF_oobEnsembleDenPart[t]  = NULL;
+      RF_fullEnsembleDenPart[t] = NULL;
+      if (!RF_deterministicFlag) {
+        stackEnsemblePartial(mode, t);
       }
-      contPT[*offset] = NA_REAL;
     }
-    else {
-      contPT[*offset] = parent -> splitValueCont;
-      mwcpSZ[*offset] = 0;
+  }
+}
+void stackEnsemblePartial(uint mode, uint t) {
+  uint obsSize;
+  obsSize = (mode == RF_PRED) ?  RF_fobservationSize : RF_observationSize;
+  if ((mode != RF_PRED) && (RF_opt & OPT_OENS)) {
+    stackEnsembleNumerators(obsSize,
+                            & RF_oobEnsembleDenPart[t],
+                            & RF_oobEnsembleSRGpart[t],
+                            & RF_oobEnsembleMRTpart[t],
+                            & RF_oobEnsembleSRVpart[t],
+                            & RF_oobEnsembleCIFpart[t],
+                            & RF_oobEnsembleCLSpart[t],
+                            & RF_oobEnsembleRGRpart[t]);
+  }
+  if (RF_opt & OPT_FENS) {
+    stackEnsembleNumerators(obsSize,
+                            & RF_fullEnsembleDenPart[t],
+                            & RF_fullEnsembleSRGpart[t],
+                            & RF_fullEnsembleMRTpart[t],
+                            & RF_fullEnsembleSRVpart[t],
+                            & RF_fullEnsembleCIFpart[t],
+                            & RF_fullEnsembleCLSpart[t],
+                            & RF_fullEnsembleRGRpart[t]);
+  }
+}
+void unstackEnsemblePartial(uint mode, uint t) {
+  uint obsSize;
+  obsSize = (mode == RF_PRED) ?  RF_fobservationSize : RF_observationSize;
+  if (RF_oobEnsembleDenPart[t] != NULL) {
+    unstackEnsembleNumerators(obsSize,
+                              RF_oobEnsembleDenPart[t],
+                              RF_oobEnsembleSRGpart[t],
+                              RF_oobEnsembleMRTpart[t],
+                              RF_oobEnsembleSRVpart[t],
+                              RF_oobEnsembleCIFpart[t],
+                              RF_oobEnsembleCLSpart[t],
+                              RF_oobEnsembleRGRpart[t]);
+    RF_oobEnsembleDenPart[t] = NULL;
+  }
+  if (RF_fullEnsembleDenPart[t] != NULL) {
+    unstackEnsembleNumerators(obsSize,
+                              RF_fullEnsembleDenPart[t],
+                              RF_fullEnsembleSRGpart[t],
+                              RF_fullEnsembleMRTpart[t],
+                              RF_fullEnsembleSRVpart[t],
+                              RF_fullEnsembleCIFpart[t],
+                              RF_fullEnsembleCLSpart[t],
+                              RF_fullEnsembleRGRpart[t]);
+    RF_fullEnsembleDenPart[t] = NULL;
+  }
+}
+void unstackEnsemblePartials(uint mode) {
+  uint t;
+  if (RF_ensemblePartialFlag) {
+    for (t = 1; t <= RF_ensemblePartialSize; t++) {
+      unstackEnsemblePartial(mode, t);
+    }
+    free_new_vvector(RF_oobEnsembleDenPart, 1, RF_ensemblePartialSize, NRUTIL_UPTR);
+    free_new_vvector(RF_oobEnsembleSRGpart, 1, RF_ensemblePartialSize, NRUTIL_DPTR3);
+    free_new_vvector(RF_oobEnsembleMRTpart, 1, RF_ensemblePartialSize, NRUTIL_DPTR2);
+    free_new_vvector(RF_oobEnsembleSRVpart, 1, RF_ensemblePartialSize, NRUTIL_DPTR2);
+    free_new_vvector(RF_oobEnsembleCIFpart, 1, RF_ensemblePartialSize, NRUTIL_DPTR3);
+    free_new_vvector(RF_oobEnsembleCLSpart, 1, RF_ensemblePartialSize, NRUTIL_DPTR3);
+    free_new_vvector(RF_oobEnsembleRGRpart, 1, RF_ensemblePartialSize, NRUTIL_DPTR2);
+    free_new_vvector(RF_fullEnsembleDenPart, 1, RF_ensemblePartialSize, NRUTIL_UPTR);
+    free_new_vvector(RF_fullEnsembleSRGpart, 1, RF_ensemblePartialSize, NRUTIL_DPTR3);
+    free_new_vvector(RF_fullEnsembleMRTpart, 1, RF_ensemblePartialSize, NRUTIL_DPTR2);
+    free_new_vvector(RF_fullEnsembleSRVpart, 1, RF_ensemblePartialSize, NRUTIL_DPTR2);
+    free_new_vvector(RF_fullEnsembleCIFpart, 1, RF_ensemblePartialSize, NRUTIL_DPTR3);
+    free_new_vvector(RF_fullEnsembleCLSpart, 1, RF_ensemblePartialSize, NRUTIL_DPTR3);
+    free_new_vvector(RF_fullEnsembleRGRpart, 1, RF_ensemblePartialSize, NRUTIL_DPTR2);
+    RF_ensemblePartialFlag = FALSE;
+  }
+}
+void reduceEnsemblePartial(uint mode, uint t) {
+  uint obsSize;
+  obsSize = (mode == RF_PRED) ?  RF_fobservationSize : RF_observationSize;
+  if (RF_oobEnsembleDenPart[t] != NULL) {
+    reduceEnsembleNumerators(obsSize,
+                             RF_oobEnsembleDenPart[t],
+                             RF_oobEnsembleSRGpart[t],
+                             RF_oobEnsembleMRTpart[t],
+                             RF_oobEnsembleSRVpart[t],
+                             RF_oobEnsembleCIFpart[t],
+                             RF_oobEnsembleCLSpart[t],
+                             RF_oobEnsembleRGRpart[t],
+                             RF_oobEnsembleDen,
+                             RF_oobEnsembleSRGnum,
+                             RF_oobEnsembleMRTnum,
+                             RF_oobEnsembleSRVnum,
+                             RF_oobEnsembleCIFnum,
+                             RF_oobEnsembleCLSnum,
+                             RF_oobEnsembleRGRnum);
+  }
+  if (RF_fullEnsembleDenPart[t] != NULL) {
+    reduceEnsembleNumerators(obsSize,
+                             RF_fullEnsembleDenPart[t],
+                             RF_fullEnsembleSRGpart[t],
+                             RF_fullEnsembleMRTpart[t],
+                             RF_fullEnsembleSRVpart[t],
+                             RF_fullEnsembleCIFpart[t],
+                             RF_fullEnsembleCLSpart[t],
+                             RF_fullEnsembleRGRpart[t],
+                             RF_fullEnsembleDen,
+                             RF_fullEnsembleSRGnum,
+                             RF_fullEnsembleMRTnum,
+                             RF_fullEnsembleSRVnum,
+                             RF_fullEnsembleCIFnum,
+                             RF_fullEnsembleCLSnum,
+                             RF_fullEnsembleRGRnum);
+  }
+}
+char getVimpPartialFlag(uint mode) {
+  char result;
+  uint obsSize;
+  result = FALSE;
+  if (((RF_numThreads > 1) && (RF_optHigh & OPT_VIMP_PART)) || (RF_deterministicFlag)) {
+    if (RF_opt & OPT_VIMP) {
+      result = TRUE;
+    }
+  }
+  if ((result) && (!RF_deterministicFlag)) {
+    obsSize = (mode == RF_PRED) ?  RF_fobservationSize : RF_observationSize;
+    if ((double) RF_numThreads * getVimpPartialSlotSize() * getVimpNumeratorSize(obsSize) > PARTIAL_BUDGET_SIZE) {
+      result = FALSE;
+      if (RF_userTraceFlag) {
+        RFprintf("\nRF-SRC:  Per-thread importance partials exceed the memory budget, using the shared ensemble.");
+      }
     }
   }
+  return result;
+}
+uint getVimpPartialSlotSize() {
+  uint result;
+  if (RF_opt & OPT_VIMP_LEOB) {
+    result = 1;
+  }
   else {
-    contPT[*offset] = NA_REAL;
-    mwcpSZ[*offset] = 0;
+    result = (RF_opt & OPT_VIMP_JOIN) ? 1 : RF_intrPredictorSize;
   }
-  (*offset) ++;
-  if (((parent -> left) != NULL) && ((parent -> right) != NULL)) {
-    saveTree(b, parent ->  left, offset, treeID, nodeID, parmID, contPT, mwcpSZ, mwcpPtr, mwcpCT);
-    saveTree(b, parent -> right, offset, treeID, nodeID, parmID, contPT, mwcpSZ, mwcpPtr, mwcpCT);
+  return result;
+}
+double getVimpNumeratorSize(uint obsSize) {
+  double result;
+  uint j;
+  result = 0.5;
+  if ((RF_timeIndex > 0) && (RF_statusIndex > 0)) {
+    result += (double) RF_eventTypeSize;
   }
+  else {
+    for (j = 1; j <= RF_rTargetFactorCount; j++) {
+      result += (getVimpMaxVoteFlag()) ? 1.0 : (double) RF_rFactorSize[RF_rFactorMap[RF_rTargetFactor[j]]];
+    }
+    result += (double) RF_rTargetNonFactorCount;
+  }
+  return result * obsSize;
 }
-void freeTree(uint treeID, Node *parent, char rootFlag) {
-  if (((parent -> left) != NULL) && ((parent -> right) != NULL)) {
-    freeTree(treeID, parent -> left, FALSE);
-    freeTree(treeID, parent -> right, FALSE);
+char getVimpTreePartialFlag() {
+  char result;
+  result = FALSE;
+  if (RF_vimpPartialFlag) {
+    if ((RF_deterministicFlag) && !(RF_opt & OPT_VIMP_LEOB)) {
+      result = TRUE;
+    }
   }
-  freeNode(parent);
+  return result;
 }
-void getSplitDepth(Node *parent, uint *maximumDepth) {
-  Node *reversePtr;
-  uint i;
-  if (!(RF_opt & (OPT_SPLDPTH_F | OPT_SPLDPTH_T))) {
-    RFprintf("\nRF-SRC:  *** ERROR *** ");
-    RFprintf("\nRF-SRC:  Call to calculate split depth without the option being active.");
-    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-    error("\nRF-SRC:  The application will now exit.\n");
+uint getVimpPartialSlot(uint         treeID,
+                        uint         p,
+                        uint      ***vimpEnsembleDen,
+                        double   ****vimpEnsembleMRT,
+                        double  *****vimpEnsembleCLS,
+                        double   ****vimpEnsembleRGR) {
+  uint result;
+  uint t;
+  if (RF_vimpPartialFlag) {
+    t = (getVimpTreePartialFlag()) ? treeID : getThreadIndex();
+    *vimpEnsembleDen = RF_vimpEnsembleDenPart[t];
+    *vimpEnsembleMRT = RF_vimpEnsembleMRTpart[t];
+    *vimpEnsembleCLS = RF_vimpEnsembleCLSpart[t];
+    *vimpEnsembleRGR = RF_vimpEnsembleRGRpart[t];
+    result = (RF_opt & OPT_VIMP_LEOB) ? 1 : p;
   }
-  if (parent -> depth > 0) {
-    *maximumDepth = ((parent -> depth > *maximumDepth) ? parent -> depth : *maximumDepth);
-    stackSplitDepth(parent, parent -> depth);
-    reversePtr = parent;
-    for (i = 1; i <= parent -> depth; i++) {
-      if ((reversePtr -> parent) == NULL) {
-        RFprintf("\nRF-SRC:  *** ERROR *** ");
-        RFprintf("\nRF-SRC:  Reverse parsing of tree failed in restoreTree().");
-        RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-        error("\nRF-SRC:  The application will now exit.\n");
-      }
-      (parent -> splitDepth)[(parent -> depth) - i + 1] = (reversePtr -> parent) -> splitParameter;
-      reversePtr = reversePtr -> parent;
-    }
+  else {
+    *vimpEnsembleDen = RF_vimpEnsembleDen;
+    *vimpEnsembleMRT = RF_vimpEnsembleMRT;
+    *vimpEnsembleCLS = RF_vimpEnsembleCLS;
+    *vimpEnsembleRGR = RF_vimpEnsembleRGR;
+    result = p;
   }
+  return result;
 }
-void freeSplitDepth(uint treeID) {
-  uint j;
-  for (j = 1; j <= RF_tLeafCount[treeID]; j++) {
-    unstackSplitDepth(RF_tNodeList[treeID][j]);
+char getVimpMaxVoteFlag() {
+  char result;
+  result = FALSE;
+  if (RF_opt & OPT_VIMP_LEOB) {
+    if (!(RF_opt & OPT_PERF_CALB)) {
+      result = TRUE;
+    }
   }
+  return result;
 }
-void saveStatistics(char     mode,
-                    uint     b,
-                    Node    *parent,
-                    uint    *offset,
-                    double  *spltST,
-                    double  *spltVR,
-                    uint   **uspvST,
-                    uint   **mtryID,
-                    double **mtryST) {
-  uint i;
-  if (!(RF_opt & OPT_NODE_STAT) && !(RF_opt & OPT_USPV_STAT)) {
-    RFprintf("\nRF-SRC:  *** ERROR *** ");
-    RFprintf("\nRF-SRC:  Inconsistent call to saveStatistics().  The options are NOT active.");
-    RFprintf("\nRF-SRC:  Please Contact Technical Support.");
-    RFprintf("\nRF-SRC:  The application will now exit.\n");
-    error("\nRF-SRC:  The application will now exit.\n");
+void stackVimpEnsemble(uint        obsSize,
+                       uint        slotSize,
+                       uint     ***vimpEnsembleDen,
+                       double  ****vimpEnsembleMRT,
+                       double *****vimpEnsembleCLS,
+                       double  ****vimpEnsembleRGR) {
+  uint classSize;
+  uint i, j, k, m;
+  *vimpEnsembleMRT = NULL;
+  *vimpEnsembleCLS = NULL;
+  *vimpEnsembleRGR = NULL;
+  *vimpEnsembleDen = (uint **) new_vvector(1, slotSize, NRUTIL_UPTR);
+  for (i = 1; i <= slotSize; i++) {
+    (*vimpEnsembleDen)[i] = uivector(1, obsSize);
+    for (m = 1; m <= obsSize; m++) {
+      (*vimpEnsembleDen)[i][m] = 0;
+    }
   }
-  if (RF_opt & OPT_NODE_STAT) {  
-    if (mode == RF_GROW) {
-      spltST[*offset] = parent -> splitStatistic;
-      for(i = 1; i <= RF_randomCovariateCount; i++) {
-        mtryID[*offset][i] = parent -> mtryIndx[i];
-        mtryST[*offset][i] = parent -> mtryStat[i];
+  if ((RF_timeIndex > 0) && (RF_statusIndex > 0)) {
+    *vimpEnsembleMRT = (double ***) new_vvector(1, slotSize, NRUTIL_DPTR2);
+    for (i = 1; i <= slotSize; i++) {
+      (*vimpEnsembleMRT)[i] = (double **) new_vvector(1, RF_eventTypeSize, NRUTIL_DPTR);
+      for (k = 1; k <= RF_eventTypeSize; k++) {
+        (*vimpEnsembleMRT)[i][k] = dvector(1, obsSize);
+        for (m = 1; m <= obsSize; m++) {
+          (*vimpEnsembleMRT)[i][k][m] = 0;
+        }
       }
     }
-    else {
-      if (RF_ptnCount == 0) {
-        spltST[*offset] = parent -> variance;
-      }
-      else {
-        spltST[*offset] = parent -> pseudoTerminal;
+  }
+  else {
+    if (RF_rTargetFactorCount > 0) {
+      *vimpEnsembleCLS = (double ****) new_vvector(1, slotSize, NRUTIL_DPTR3);
+      for (i = 1; i <= slotSize; i++) {
+        (*vimpEnsembleCLS)[i] = (double ***) new_vvector(1, RF_rTargetFactorCount, NRUTIL_DPTR2);
+        for (j = 1; j <= RF_rTargetFactorCount; j++) {
+          classSize = (getVimpMaxVoteFlag()) ? 1 : RF_rFactorSize[RF_rFactorMap[RF_rTargetFactor[j]]];
+          (*vimpEnsembleCLS)[i][j] = (double **) new_vvector(1, classSize, NRUTIL_DPTR);
+          for (k = 1; k <= classSize; k++) {
+            (*vimpEnsembleCLS)[i][j][k] = dvector(1, obsSize);
+            for (m = 1; m <= obsSize; m++) {
+              (*vimpEnsembleCLS)[i][j][k][m] = 0;
+            }
+          }
+        }
       }
     }
-  }
-  if (RF_opt & OPT_USPV_STAT) {
-    if (mode == RF_GROW) {
-      for (i = 1; i <= RF_randomResponseCount; i++) {
-        uspvST[*offset][i] = (parent -> urStat)[i];
+    if (RF_rTargetNonFactorCount > 0) {
+      *vimpEnsembleRGR = (double ***) new_vvector(1, slotSize, NRUTIL_DPTR2);
+      for (i = 1; i <= slotSize; i++) {
+        (*vimpEnsembleRGR)[i] = (double **) new_vvector(1, RF_rTargetNonFactorCount, NRUTIL_DPTR);
+        for (k = 1; k <= RF_rTargetNonFactorCount; k++) {
+          (*vimpEnsembleRGR)[i][k] = dvector(1, obsSize);
+          for (m = 1; m <= obsSize; m++) {
+            (*vimpEnsembleRGR)[i][k][m] = 0;
+          }
+        }
       }
     }
   }
-  (*offset) ++;
-  if (((parent -> left) != NULL) && ((parent -> right) != NULL)) {
-    saveStatistics(mode, b, parent ->  left, offset, spltST, spltVR, uspvST, mtryID, mtryST);
-    saveStatistics(mode, b, parent -> right, offset, spltST, spltVR, uspvST, mtryID, mtryST);
-  }
 }
-uint getMaximumDepth(Node *parent) {
-  uint result, rLeft, rRight;
-  result = parent -> depth;
-  if (((parent -> left) != NULL) && ((parent -> right) != NULL)) {
-    rLeft = getMaximumDepth(parent ->  left);
-    rRight = getMaximumDepth(parent -> right);
-    result = (rLeft > rRight) ? rLeft : rRight;
+void unstackVimpEnsemble(uint       obsSize,
+                         uint       slotSize,
+                         uint     **vimpEnsembleDen,
+                         double  ***vimpEnsembleMRT,
+                         double ****vimpEnsembleCLS,
+                         double  ***vimpEnsembleRGR) {
+  uint classSize;
+  uint i, j, k;
+  for (i = 1; i <= slotSize; i++) {
+    free_uivector(vimpEnsembleDen[i], 1, obsSize);
   }
-  return result;
-}
-void getNodesAtDepth(Node *parent, uint tagDepth, Node **nodesAtDepth, uint *nadCount) {
-  char recurseFlag;
-  recurseFlag = TRUE;
-  if (tagDepth == parent -> depth) {
-    if ((parent -> splitParameter) != 0) {
-      (*nadCount) ++;
-      nodesAtDepth[*nadCount] = parent;
+  free_new_vvector(vimpEnsembleDen, 1, slotSize, NRUTIL_UPTR);
+  if (vimpEnsembleMRT != NULL) {
+    for (i = 1; i <= slotSize; i++) {
+      for (k = 1; k <= RF_eventTypeSize; k++) {
+        free_dvector(vimpEnsembleMRT[i][k], 1, obsSize);
+      }
+      free_new_vvector(vimpEnsembleMRT[i], 1, RF_eventTypeSize, NRUTIL_DPTR);
     }
-    recurseFlag = FALSE;
+    free_new_vvector(vimpEnsembleMRT, 1, slotSize, NRUTIL_DPTR2);
   }
-  else {
-    if (((parent -> left) == NULL) && ((parent -> right) == NULL)) {
-      recurseFlag = FALSE;
+  if (vimpEnsembleCLS != NULL) {
+    for (i = 1; i <= slotSize; i++) {
+      for (j = 1; j <= RF_rTargetFactorCount; j++) {
+        classSize = (getVimpMaxVoteFlag()) ? 1 : RF_rFactorSize[RF_rFactorMap[RF_rTargetFactor[j]]];
+        for (k = 1; k <= classSize; k++) {
+          free_dvector(vimpEnsembleCLS[i][j][k], 1, obsSize);
+        }
+        free_new_vvector(vimpEnsembleCLS[i][j], 1, classSize, NRUTIL_DPTR);
+      }
+      free_new_vvector(vimpEnsembleCLS[i], 1, RF_rTargetFactorCount, NRUTIL_DPTR2);
     }
+    free_new_vvector(vimpEnsembleCLS, 1, slotSize, NRUTIL_DPTR3);
   }
-  if (recurseFlag) {
-    getNodesAtDepth(parent ->  left, tagDepth, nodesAtDepth, nadCount);
-    getNodesAtDepth(parent -> right, tagDepth, nodesAtDepth, nadCount);
-  }
-}
-void getTreeInfo(uint treeID, Node *parent) {
-  if (((parent -> left) != NULL) && ((parent -> right) != NULL)) {
-    getTreeInfo(treeID, parent ->  left);
-    getTreeInfo(treeID, parent -> right);
+  if (vimpEnsembleRGR != NULL) {
+    for (i = 1; i <= slotSize; i++) {
+      for (k = 1; k <= RF_rTargetNonFactorCount; k++) {
+        free_dvector(vimpEnsembleRGR[i][k], 1, obsSize);
+      }
+      free_new_vvector(vimpEnsembleRGR[i], 1, RF_rTargetNonFactorCount, NRUTIL_DPTR);
+    }
+    free_new_vvector(vimpEnsembleRGR, 1, slotSize, NRUTIL_DPTR2);
   }
 }
-void getPTNodeList(Node    *parent,
-                   Node   **list,
-                   uint    *offset) {
-  if (!(parent -> pseudoTerminal)) {
-    getPTNodeList(parent ->  left, list, offset);
-    getPTNodeList(parent -> right, list, offset);
-  }
-  else {
-    (*offset) ++;
-    list[*offset] = parent;
+void stackVimpPartials(uint mode) {
+  uint t;
+  RF_vimpPartialFlag = getVimpPartialFlag(mode);
+  if (RF_vimpPartialFlag) {
+    if (getVimpTreePartialFlag()) {
+      RF_vimpPartialSize = RF_forestSize;
+    }
+    else {
+      RF_vimpPartialSize = (RF_numThreads > 1) ? RF_numThreads : 1;
+    }
+    RF_vimpPartialSlotSize = getVimpPartialSlotSize();
+    RF_vimpEnsembleDenPart = (uint ***) new_vvector(1, RF_vimpPartialSize, NRUTIL_UPTR2);
+    RF_vimpEnsembleMRTpart = (double ****) new_vvector(1, RF_vimpPartialSize, NRUTIL_DPTR3);
+    RF_vimpEnsembleCLSpart = (double *****) new_vvector(1, RF_vimpPartialSize, NRUTIL_DPTR4);
+    RF_vimpEnsembleRGRpart = (double ****) new_vvector(1, RF_vimpPartialSize, NRUTIL_DPTR3);
+    for (t = 1; t <= RF_vimpPartialSize; t++) {
+      RF_vimpEnsembleDenPart[t] = NULL;
+      if (!getVimpTreePartialFlag()) {
+        stackVimpPartial(mode, t);
+      }
+    }
   }
 }
-void restoreNodeMembershipGrow(uint treeID) {
-  uint i;
-  for (i = 1; i <= RF_observationSize; i++) {
-    RF_tNodeMembership[treeID][i] = RF_tNodeList[treeID][RF_TN_MEMB_ptr[treeID][i]];
+void stackVimpPartial(uint mode, uint t) {
+  uint obsSize;
+  obsSize = (mode == RF_PRED) ?  RF_fobservationSize : RF_observationSize;
+  stackVimpEnsemble(obsSize,
+                    RF_vimpPartialSlotSize,
+                    & RF_vimpEnsembleDenPart[t],
+                    & RF_vimpEnsembleMRTpart[t],
+                    & RF_vimpEnsembleCLSpart[t],
+                    & RF_vimpEnsembleRGRpart[t]);
+}
+void unstackVimpPartial(uint mode, uint t) {
+  uint obsSize;
+  if (RF_vimpEnsembleDenPart[t] != NULL) {
+    obsSize = (mode == RF_PRED) ?  RF_fobservationSize : RF_observationSize;
+    unstackVimpEnsemble(obsSize,
+                        RF_vimpPartialSlotSize,
+                        RF_vimpEnsembleDenPart[t],
+                        RF_vimpEnsembleMRTpart[t],
+                        RF_vimpEnsembleCLSpart[t],
+                        RF_vimpEnsembleRGRpart[t]);
+    RF_vimpEnsembleDenPart[t] = NULL;
+  }
+}
+void unstackVimpPartials(uint mode) {
+  uint t;
+  if (RF_vimpPartialFlag) {
+    for (t = 1; t <= RF_vimpPartialSize; t++) {
+      unstackVimpPartial(mode, t);
+    }
+    free_new_vvector(RF_vimpEnsembleDenPart, 1, RF_vimpPartialSize, NRUTIL_UPTR2);
+    free_new_vvector(RF_vimpEnsembleMRTpart, 1, RF_vimpPartialSize, NRUTIL_DPTR3);
+    free_new_vvector(RF_vimpEnsembleCLSpart, 1, RF_vimpPartialSize, NRUTIL_DPTR4);
+    free_new_vvector(RF_vimpEnsembleRGRpart, 1, RF_vimpPartialSize, NRUTIL_DPTR3);
+    RF_vimpPartialFlag = FALSE;
+  }
+}
+void reduceVimpPartial(uint mode, uint t) {
+  uint obsSize;
+  uint i, j, k, p;
+  if (RF_vimpEnsembleDenPart[t] != NULL) {
+    obsSize = (mode == RF_PRED) ?  RF_fobservationSize : RF_observationSize;
+    for (p = 1; p <= RF_vimpPartialSlotSize; p++) {
+      for (i = 1; i <= obsSize; i++) {
+        if (RF_vimpEnsembleDenPart[t][p][i] > 0) {
+          RF_vimpEnsembleDen[p][i] += RF_vimpEnsembleDenPart[t][p][i];
+          if ((RF_timeIndex > 0) && (RF_statusIndex > 0)) {
+            for (k = 1; k <= RF_eventTypeSize; k++) {
+              RF_vimpEnsembleMRT[p][k][i] += RF_vimpEnsembleMRTpart[t][p][k][i];
+            }
+          }
+          else {
+            if (RF_rTargetFactorCount > 0) {
+              for (j = 1; j <= RF_rTargetFactorCount; j++) {
+                for (k = 1; k <= RF_rFactorSize[RF_rFactorMap[RF_rTargetFactor[j]]]; k++) {
+                  RF_vimpEnsembleCLS[p][j][k][i] += RF_vimpEnsembleCLSpart[t][p][j][k][i];
+                }
+              }
+            }
+            if (RF_rTargetNonFactorCount > 0) {
+              for (j = 1; j <= RF_rTargetNonFactorCount; j++) {
+                RF_vimpEnsembleRGR[p][j][i] += RF_vimpEnsembleRGRpart[t][p][j][i];
+              }
+            }
+          }
+        }
+      }
+    }
   }
 }
-char getRestoreNodeMembershipGrowFlag(char mode) {
-  char flag;
-  flag = FALSE;
-  if ((RF_optHigh & OPT_TERM) && (!(RF_opt & (OPT_BOOT_NODE | OPT_BOOT_NONE)))) {
-    switch (mode) {
-    case RF_PRED:
-      if (RF_fmRecordSize == 0) {
-        flag = TRUE;
+void finalizeVimpPartials(uint mode) {
+  uint t;
+  if (RF_vimpPartialFlag) {
+    if (!(RF_opt & OPT_VIMP_LEOB)) {
+      for (t = 1; t <= RF_vimpPartialSize; t++) {
+        reduceVimpPartial(mode, t);
       }
-      break;
-    default:
-      flag = TRUE;
-      break;
     }
+    unstackVimpPartials(mode);
   }
-  return flag;
 }
-void updateTerminalNodeOutcomesNew (uint       treeID,
-                                    Terminal  *parent,
-                                    uint      *repMembrIndx,
-                                    uint       repMembrSize,
-                                    uint      *allMembrIndx,
-                                    uint       allMembrSize) {
-  if ((RF_timeIndex > 0) && (RF_statusIndex > 0)) {
-    getAtRiskAndEventCountsNew(treeID, parent, repMembrIndx, repMembrSize, allMembrIndx, allMembrSize);
-    getLocalRatios(treeID, parent);
-    getLocalSurvival(treeID, parent);
-    if (!(RF_opt & OPT_COMP_RISK)) {
-      getLocalNelsonAalen(treeID, parent);
-    }
-    else {
-      getLocalCSH(treeID, parent);
-      getLocalCIF(treeID, parent);
+void finalizeEnsemblePartials(uint mode, char multImpFlag) {
+  uint t;
+  if (RF_ensemblePartialFlag) {
+    for (t = 1; t <= RF_ensemblePartialSize; t++) {
+      reduceEnsemblePartial(mode, t);
     }
-    unstackAtRiskAndEventCounts(parent);
-    if (!(RF_opt & OPT_COMP_RISK)) {
-      getSurvival(treeID, parent);
-      getNelsonAalen(treeID, parent);
+    unstackEnsemblePartials(mode);
+    if (!RF_deterministicFlag) {
+      if (getPerformanceFlag(mode, RF_serialTreeCount)) {
+        refreshEnsemblePointers(mode);
+        updateEnsemblePerformance(mode, multImpFlag, 0, RF_serialTreeCount);
+      }
     }
-    else {
-      getCSH(treeID, parent);
-      getCIF(treeID, parent);
+  }
+}
+void refreshEnsemblePointers(uint mode) {
+  uint obsSize;
+  uint    *ensembleDen;
+  double **ensembleMRTptr;
+  double **ensembleMRTnum;
+  double ***ensembleCLSptr;
+  double ***ensembleCLSnum;
+  double **ensembleRGRptr;
+  double **ensembleRGRnum;
+  double maxValue, maxClass;
+  uint i, j, k;
+  obsSize = (mode == RF_PRED) ?  RF_fobservationSize : RF_observationSize;
+  if (mode == RF_PRED) {
+    ensembleDen    = RF_fullEnsembleDen;
+    ensembleMRTptr = RF_fullEnsembleMRTptr;
+    ensembleMRTnum = RF_fullEnsembleMRTnum;
+    ensembleCLSptr = RF_fullEnsembleCLSptr;
+    ensembleCLSnum = RF_fullEnsembleCLSnum;
+    ensembleRGRptr = RF_fullEnsembleRGRptr;
+    ensembleRGRnum = RF_fullEnsembleRGRnum;
+  }
+  else {
+    ensembleDen    = RF_oobEnsembleDen;
+    ensembleMRTptr = RF_oobEnsembleMRTptr;
+    ensembleMRTnum = RF_oobEnsembleMRTnum;
+    ensembleCLSptr = RF_oobEnsembleCLSptr;
+    ensembleCLSnum = RF_oobEnsembleCLSnum;
+    ensembleRGRptr = RF_oobEnsembleRGRptr;
+    ensembleRGRnum = RF_oobEnsembleRGRnum;
+  }
+  for (i = 1; i <= obsSize; i++) {
+    if (ensembleDen[i] != 0) {
+      if ((RF_timeIndex > 0) && (RF_statusIndex > 0)) {
+        for (j = 1; j <= ((RF_opt & OPT_COMP_RISK) ? RF_eventTypeSize : 1); j++) {
+          ensembleMRTptr[j][i] = ensembleMRTnum[j][i] / ensembleDen[i];
+        }
+      }
+      else {
+        for (j = 1; j <= RF_rTargetFactorCount; j++) {
+          maxValue = 0;
+          maxClass = 0;
+          for (k = 1; k <= RF_rFactorSize[RF_rFactorMap[RF_rTargetFactor[j]]]; k++) {
+            if (maxValue < ensembleCLSnum[j][k][i]) {
+              maxValue = ensembleCLSnum[j][k][i];
+              maxClass = (double) k;
+            }
+          }
+          ensembleCLSptr[j][1][i] = maxClass;
+        }
+        for (j = 1; j <= RF_rTargetNonFactorCount; j++) {
+          ensembleRGRptr[j][i] = ensembleRGRnum[j][i] / ensembleDen[i];
+        }
+      }
     }
-    getMortality(treeID, parent);
-    freeTerminalNodeLocalSurvivalStructures(parent);
   }
-  else {
-    if(RF_rFactorCount > 0) {
-      getMultiClassProbNew(treeID, parent, repMembrIndx, repMembrSize, allMembrIndx, allMembrSize);
+}
+char getDeterministicFlag(uint mode) {
+  char result;
+  result = FALSE;
+  if (RF_optHigh & OPT_DTRM) {
+    result = TRUE;
+    if (RF_opt & OPT_SPLT_NULL) {
+      result = FALSE;
     }
-    if(RF_rNonFactorCount > 0) {
-      getMeanResponseNew(treeID, parent, repMembrIndx, repMembrSize, allMembrIndx, allMembrSize);
+    if (((mode == RF_PRED) ? RF_fmRecordSize : RF_mRecordSize) > 0) {
+      result = FALSE;
     }
   }
+  return result;
 }
-void restoreTerminalNodeOutcomes (uint treeID, Terminal *parent) {
-    if ((RF_timeIndex > 0) && (RF_statusIndex > 0)) {
-      if (!(RF_opt & OPT_COMP_RISK)) {
-        restoreSurvival (treeID, parent);
-        restoreNelsonAalen (treeID, parent);
-      }
-      else {
-        restoreCSH (treeID, parent);
-        restoreCIF (treeID, parent);
-      }
-      restoreMortality (treeID, parent);
+void stackTreeCommits(uint mode) {
+  uint b;
+  RF_deterministicFlag = getDeterministicFlag(mode);
+  if (RF_deterministicFlag) {
+    RF_treeEnsembleFlag = cvector(1, RF_forestSize);
+    for (b = 1; b <= RF_forestSize; b++) {
+      RF_treeEnsembleFlag[b] = FALSE;
     }
-    else {
-      if(RF_rFactorCount > 0) {
-        restoreMultiClassProbNew (treeID, parent);
-      }
-      if(RF_rNonFactorCount > 0) {
-        restoreMeanResponseNew (treeID, parent);
+    RF_perfSnapshotSize = (RF_numThreads > 1) ? RF_numThreads : 1;
+    RF_perfSnapshotDen = (uint **) new_vvector(1, RF_perfSnapshotSize, NRUTIL_UPTR);
+    RF_perfSnapshotMRT = (double ***) new_vvector(1, RF_perfSnapshotSize, NRUTIL_DPTR2);
+    RF_perfSnapshotCLS = (double ****) new_vvector(1, RF_perfSnapshotSize, NRUTIL_DPTR3);
+    RF_perfSnapshotRGR = (double ***) new_vvector(1, RF_perfSnapshotSize, NRUTIL_DPTR2);
+    for (b = 1; b <= RF_perfSnapshotSize; b++) {
+      RF_perfSnapshotDen[b] = NULL;
+    }
+  }
+  else {
+    if (RF_optHigh & OPT_DTRM) {
+      if (RF_numThreads > 1) {
+        RF_numThreads = 1;
       }
     }
+  }
 }
-void updateEnsembleCalculations (char      multImpFlag,
-                                 uint      mode,
-                                 uint      b) {
-  uint      obsSize;
-  double  **responsePtr;
-  char      potentiallyMixedMultivariate;
-  char      respImputeFlag;
-  uint      thisSerialTreeCount;
-  uint      j;
-  potentiallyMixedMultivariate = FALSE;  
-  respImputeFlag       = FALSE;  
-  responsePtr          = NULL;   
-  obsSize              = 0;      
-  thisSerialTreeCount  = 0;      
-  obsSize = (mode == RF_PRED) ?  RF_fobservationSize : RF_observationSize;
-  { 
+void unstackTreeCommits(uint mode) {
+  uint t;
+  if (RF_deterministicFlag) {
+    free_cvector(RF_treeEnsembleFlag, 1, RF_forestSize);
+    for (t = 1; t <= RF_perfSnapshotSize; t++) {
+      unstackPerformanceSnapshot(mode, t);
+    }
+    free_new_vvector(RF_perfSnapshotDen, 1, RF_perfSnapshotSize, NRUTIL_UPTR);
+    free_new_vvector(RF_perfSnapshotMRT, 1, RF_perfSnapshotSize, NRUTIL_DPTR2);
+    free_new_vvector(RF_perfSnapshotCLS, 1, RF_perfSnapshotSize, NRUTIL_DPTR3);
+    free_new_vvector(RF_perfSnapshotRGR, 1, RF_perfSnapshotSize, NRUTIL_DPTR2);
+    RF_deterministicFlag = FALSE;
+  }
+}
+void commitTree(uint mode, char multImpFlag, uint b) {
+  uint serialTreeID;
+  uint t;
+  t = getThreadIndex();
+  serialTreeID = 0;
 #ifdef _OPENMP
-#pragma omp critical (_update_ensemble)
+#pragma omp ordered
 #endif
+  { 
+    serialTreeID = commitTreePartials(mode, b, t);
+  } 
+  if (serialTreeID > 0) {
+    updateGenericEnsemblePerformance(mode,
+                                     multImpFlag,
+                                     b,
+                                     serialTreeID,
+                                     RF_perfSnapshotDen[t],
+                                     RF_perfSnapshotMRT[t],
+                                     RF_perfSnapshotCLS[t],
+                                     RF_perfSnapshotRGR[t]);
+  }
+}
+uint commitTreePartials(uint mode, uint b, uint t) {
+  Arena *arena;
+  uint result;
+  result = 0;
+  if (RF_treeEnsembleFlag[b]) {
+    RF_serialTreeIndex[++RF_serialTreeCount] = b;
     if (RF_tLeafCount[b] > 0) {
-      RF_serialTreeIndex[++RF_serialTreeCount] = b;
-      thisSerialTreeCount = RF_serialTreeCount;
-      if ((RF_timeIndex > 0) && (RF_statusIndex > 0)) {
-        updateEnsembleSurvival(mode, b, thisSerialTreeCount);
-      }  
-      else {
-        potentiallyMixedMultivariate = FALSE;
-        if (RF_rTargetFactorCount > 0) {
-          updateEnsembleMultiClass(mode, b, thisSerialTreeCount, potentiallyMixedMultivariate);
-          potentiallyMixedMultivariate = TRUE;
-        }
-        if (RF_rTargetNonFactorCount > 0) {
-          updateEnsembleMean(mode, b, thisSerialTreeCount, potentiallyMixedMultivariate);
-          potentiallyMixedMultivariate = TRUE;
-        }
-      }
-      if (getPerformanceFlag(mode, thisSerialTreeCount)) {
-        respImputeFlag = stackAndImputePerfResponse(mode,
-                                                    multImpFlag,
-                                                    b,
-                                                    thisSerialTreeCount,
-                                                    &responsePtr);
-      }
-      else {
-        respImputeFlag = FALSE;
-      }
-      if (getPerformanceFlag(mode, thisSerialTreeCount)) {
-        if ((RF_timeIndex > 0) && (RF_statusIndex > 0)) {
-          getPerformance(thisSerialTreeCount,
-                         mode,
-                         obsSize,
-                         responsePtr,
-                         (mode == RF_PRED) ? RF_fullEnsembleDen : RF_oobEnsembleDen,
-                         (mode == RF_PRED) ? RF_fullEnsembleMRTptr : RF_oobEnsembleMRTptr,
-                         NULL,
-                         NULL,
-                         RF_perfMRTptr[thisSerialTreeCount],
-                         NULL,
-                         NULL);
-        }
-        else {
-          if (RF_rTargetFactorCount > 0) {
-            getPerformance(thisSerialTreeCount,
-                           mode,
-                           obsSize,
-                           responsePtr,
-                           (mode == RF_PRED) ? RF_fullEnsembleDen : RF_oobEnsembleDen,
-                           NULL,
-                           (mode == RF_PRED) ? RF_fullEnsembleCLSptr : RF_oobEnsembleCLSptr,
-                           NULL,
-                           NULL,
-                           RF_perfCLSptr[thisSerialTreeCount],
-                           NULL);
-          }
-          if (RF_rTargetNonFactorCount > 0) {
-            getPerformance(thisSerialTreeCount,
-                           mode,
-                           obsSize,
-                           responsePtr,
-                           (mode == RF_PRED) ? RF_fullEnsembleDen : RF_oobEnsembleDen,
-                           NULL,
-                           NULL,
-                           (mode == RF_PRED) ? RF_fullEnsembleRGRptr : RF_oobEnsembleRGRptr,
-                           NULL,
-                           NULL,
-                           RF_perfRGRptr[thisSerialTreeCount]);
+      if (RF_ensemblePartialFlag) {
+        reduceEnsemblePartial(mode, b);
+        unstackEnsemblePartial(mode, b);
+        if (getPerformanceFlag(mode, RF_serialTreeCount)) {
+          refreshEnsemblePointers(mode);
+          if (RF_perfSnapshotDen[t] == NULL) {
+            arena = suspendArena();
+            stackPerformanceSnapshot(mode, t);
+            resumeArena(arena);
           }
+          takePerformanceSnapshot(mode, t);
+          result = RF_serialTreeCount;
         }
-        unstackImputeResponse(respImputeFlag, obsSize, responsePtr);
-      }  
-    }  
-    else {
-      RF_serialTreeIndex[++RF_serialTreeCount] = b;
-    }  
-    if (RF_userTraceFlag) {
-      double userTimeElapsedFromStart;
-      double userTimeElapsedFromSplit;
-      double userTimeRemaining;
-      time_t current;
-      current = time(NULL);
-      userTimeElapsedFromSplit = (double) (current - RF_userTimeSplit);
-      if ((userTimeElapsedFromSplit) > (double) RF_userTraceFlag) {
-        userTimeElapsedFromStart = (double) (current - RF_userTimeStart);
-        userTimeRemaining = (userTimeElapsedFromStart / RF_serialTreeCount * RF_forestSize) - userTimeElapsedFromStart;
-        RFprintf("\nTrees Grown:  %6d,    Time Remaining (sec):  %6.0f", RF_serialTreeCount, ceil(userTimeRemaining));
-        RF_userTimeSplit = current;
       }
     }
-  } 
-  if (RF_tLeafCount[b] > 0) {
-    if (mode == RF_GROW) {
-      if ((RF_timeIndex > 0) && (RF_statusIndex > 0)) {
-        if (!(RF_optHigh & OPT_TERM)) {
-          for (j = 1; j <= RF_tLeafCount[b]; j++) {
-            freeTerminalNodeSurvivalStructuresNonVimp(RF_tTermList[b][j]);
-          }
-        }
-        if (!(RF_opt & OPT_VIMP)) {
-          if (!(RF_optHigh & OPT_TERM)) {
-            for (j = 1; j <= RF_tLeafCount[b]; j++) {
-              freeTerminalNodeSurvivalStructuresFinal(RF_tTermList[b][j]);
-            }
-          }
-        }
+  }
+  if (getVimpTreePartialFlag()) {
+    reduceVimpPartial(mode, b);
+    unstackVimpPartial(mode, b);
+  }
+  return result;
+}
+uint getPerformanceSnapshotClassSize(uint j) {
+  return (RF_opt & OPT_PERF_CALB) ? RF_rFactorSize[RF_rFactorMap[RF_rTargetFactor[j]]] : 1;
+}
+void stackPerformanceSnapshot(uint mode, uint t) {
+  uint obsSize;
+  uint j;
+  obsSize = (mode == RF_PRED) ?  RF_fobservationSize : RF_observationSize;
+  RF_perfSnapshotDen[t] = uivector(1, obsSize);
+  RF_perfSnapshotMRT[t] = NULL;
+  RF_perfSnapshotCLS[t] = NULL;
+  RF_perfSnapshotRGR[t] = NULL;
+  if ((RF_timeIndex > 0) && (RF_statusIndex > 0)) {
+    RF_perfSnapshotMRT[t] = dmatrix(1, (RF_opt & OPT_COMP_RISK) ? RF_eventTypeSize : 1, 1, obsSize);
+  }
+  else {
+    if (RF_rTargetFactorCount > 0) {
+      RF_perfSnapshotCLS[t] = (double ***) new_vvector(1, RF_rTargetFactorCount, NRUTIL_DPTR2);
+      for (j = 1; j <= RF_rTargetFactorCount; j++) {
+        RF_perfSnapshotCLS[t][j] = dmatrix(1, getPerformanceSnapshotClassSize(j), 1, obsSize);
       }
-      else {
-        if (!(RF_opt & OPT_VIMP)) {
-          if (!(RF_optHigh & OPT_TERM)) {
-            for (j = 1; j <= RF_tLeafCount[b]; j++) {
-              freeTerminalNodeNonSurvivalStructures(RF_tTermList[b][j]);
-            }
-          }
-        }
+    }
+    if (RF_rTargetNonFactorCount > 0) {
+      RF_perfSnapshotRGR[t] = dmatrix(1, RF_rTargetNonFactorCount, 1, obsSize);
+    }
+  }
+}
+void unstackPerformanceSnapshot(uint mode, uint t) {
+  uint obsSize;
+  uint j;
+  if (RF_perfSnapshotDen[t] != NULL) {
+    obsSize = (mode == RF_PRED) ?  RF_fobservationSize : RF_observationSize;
+    free_uivector(RF_perfSnapshotDen[t], 1, obsSize);
+    if (RF_perfSnapshotMRT[t] != NULL) {
+      free_dmatrix(RF_perfSnapshotMRT[t], 1, (RF_opt & OPT_COMP_RISK) ? RF_eventTypeSize : 1, 1, obsSize);
+    }
+    if (RF_perfSnapshotCLS[t] != NULL) {
+      for (j = 1; j <= RF_rTargetFactorCount; j++) {
+        free_dmatrix(RF_perfSnapshotCLS[t][j], 1, getPerformanceSnapshotClassSize(j), 1, obsSize);
       }
+      free_new_vvector(RF_perfSnapshotCLS[t], 1, RF_rTargetFactorCount, NRUTIL_DPTR2);
     }
-    else {
-      if ((RF_timeIndex > 0) && (RF_statusIndex > 0)) {
-        for (j = 1; j <= RF_tLeafCount[b]; j++) {
-          freeTerminalNodeSurvivalStructuresNonVimp(RF_tTermList[b][j]);
-        }
-        if (!(RF_opt & OPT_VIMP)) {
-          for (j = 1; j <= RF_tLeafCount[b]; j++) {
-            freeTerminalNodeSurvivalStructuresFinal(RF_tTermList[b][j]);
-          }
-        }
+    if (RF_perfSnapshotRGR[t] != NULL) {
+      free_dmatrix(RF_perfSnapshotRGR[t], 1, RF_rTargetNonFactorCount, 1, obsSize);
+    }
+    RF_perfSnapshotDen[t] = NULL;
+  }
+}
+void takePerformanceSnapshot(uint mode, uint t) {
+  uint      obsSize;
+  uint     *ensembleDen;
+  double  **ensembleMRTptr;
+  double ***ensembleCLSptr;
+  double  **ensembleRGRptr;
+  uint i, j, k;
+  obsSize = (mode == RF_PRED) ?  RF_fobservationSize : RF_observationSize;
+  ensembleDen    = (mode == RF_PRED) ? RF_fullEnsembleDen    : RF_oobEnsembleDen;
+  ensembleMRTptr = (mode == RF_PRED) ? RF_fullEnsembleMRTptr : RF_oobEnsembleMRTptr;
+  ensembleCLSptr = (mode == RF_PRED) ? RF_fullEnsembleCLSptr : RF_oobEnsembleCLSptr;
+  ensembleRGRptr = (mode == RF_PRED) ? RF_fullEnsembleRGRptr : RF_oobEnsembleRGRptr;
+  for (i = 1; i <= obsSize; i++) {
+    RF_perfSnapshotDen[t][i] = ensembleDen[i];
+  }
+  if (RF_perfSnapshotMRT[t] != NULL) {
+    for (j = 1; j <= ((RF_opt & OPT_COMP_RISK) ? RF_eventTypeSize : 1); j++) {
+      for (i = 1; i <= obsSize; i++) {
+        RF_perfSnapshotMRT[t][j][i] = ensembleMRTptr[j][i];
       }
-      else {
-        if (!(RF_opt & OPT_VIMP)) {
-          for (j = 1; j <= RF_tLeafCount[b]; j++) {
-            freeTerminalNodeNonSurvivalStructures(RF_tTermList[b][j]);
-          }
+    }
+  }
+  if (RF_perfSnapshotCLS[t] != NULL) {
+    for (j = 1; j <= RF_rTargetFactorCount; j++) {
+      for (k = 1; k <= getPerformanceSnapshotClassSize(j); k++) {
+        for (i = 1; i <= obsSize; i++) {
+          RF_perfSnapshotCLS[t][j][k][i] = ensembleCLSptr[j][k][i];
         }
       }
     }
-    if (RF_opt & OPT_VIMP) {
-      if (RF_opt & OPT_VIMP_LEOB) {
-        summarizeTreePerformance(mode, b);
+  }
+  if (RF_perfSnapshotRGR[t] != NULL) {
+    for (j = 1; j <= RF_rTargetNonFactorCount; j++) {
+      for (i = 1; i <= obsSize; i++) {
+        RF_perfSnapshotRGR[t][j][i] = ensembleRGRptr[j][i];
       }
     }
-  }  
+  }
 }
 char stackAndImputePerfResponse(uint      mode,
                                 char      multImpFlag,
@@ -16913,7 +21812,7 @@ Node *identifyPerturbedMembership (Node    *parent,
   Node *result = parent;
   if (((parent -> left) != NULL) && ((parent -> right) != NULL)) {
     daughterFlag = RIGHT;
-    if (strcmp(RF_xType[parent -> splitParameter], "C") == 0) {
+    if (RF_xFactorSplitFlag[parent -> splitParameter]) {
       daughterFlag = splitOnFactor((uint) shadowVIMP[parent -> splitParameter][index], parent -> splitValueFactPtr);
     }
     else {
@@ -16961,7 +21860,7 @@ Node *randomizeMembership(Node    *parent,
     }
     else {
       daughterFlag = RIGHT;
-      if (strcmp(RF_xType[parent -> splitParameter], "C") == 0) {
+      if (RF_xFactorSplitFlag[parent -> splitParameter]) {
         daughterFlag = splitOnFactor((uint) predictor[parent -> splitParameter][individual], parent -> splitValueFactPtr);
       }
       else {
@@ -17001,7 +21900,7 @@ Node *antiMembership(Node    *parent,
       }
     }
     daughterFlag = RIGHT;
-    if (strcmp(RF_xType[parent -> splitParameter], "C") == 0) {
+    if (RF_xFactorSplitFlag[parent -> splitParameter]) {
       daughterFlag = splitOnFactor((uint) predictor[parent -> splitParameter][individual], parent -> splitValueFactPtr);
     }
     else {
@@ -17027,7 +21926,7 @@ Node *antiMembership(Node    *parent,
   return result;
 }
 void permute(uint ranGenID, uint parallelID, uint n, uint *indx) {
-  float (*ranX) (uint);
+  double (*ranX) (uint);
   uint i,j,k;
   ranX = NULL;  
   if ((ranGenID != 1) && (ranGenID != 2) && (ranGenID != 3)) {
@@ -17047,18 +21946,67 @@ void permute(uint ranGenID, uint parallelID, uint n, uint *indx) {
     ranX = ran1C;
     break;
   }
-  for (i=1; i<= n; i++) {
+  if (RF_optHigh & OPT_PERM_CMPT) {
+    permuteCompatible(ranX, parallelID, n, indx);
+  }
+  else {
+    for (i=1; i<= n; i++) {
+      indx[i] = i;
+    }
+    for (i=n; i > 1; i--) {
+      k = (uint) ceil(ranX(parallelID)*(i*1.0));
+      if (k < 1) {
+        k = 1;
+      }
+      j = indx[i];
+      indx[i] = indx[k];
+      indx[k] = j;
+    }
+    if (n > 0) {
+      ranX(parallelID);
+    }
+  }
+}
+void permuteCompatible(double (*ranX) (uint), uint parallelID, uint n, uint *indx) {
+  uint *emptyCount;
+  uint  stride, step;
+  uint  i, j, k;
+  if (n == 0) {
+    return;
+  }
+  emptyCount = uivector(1, n);
+  for (i = 1; i <= n; i++) {
     indx[i] = 0;
+    emptyCount[i] = 0;
+  }
+  for (i = 1; i <= n; i++) {
+    emptyCount[i] ++;
+    j = i + (i & (~i + 1));
+    if (j <= n) {
+      emptyCount[j] += emptyCount[i];
+    }
   }
-  for (i=n; i > 0; i--) {
+  stride = 1;
+  while ((stride << 1) <= n) {
+    stride = stride << 1;
+  }
+  for (i = n; i > 0; i--) {
     k = (uint) ceil(ranX(parallelID)*(i*1.0));
-    for (j = 1; k > 0; j++) {
-      if (indx[j] == 0) {
-        k--;
+    j = 0;
+    for (step = stride; step > 0; step = step >> 1) {
+      if (((j + step) <= n) && (emptyCount[j + step] < k)) {
+        j += step;
+        k -= emptyCount[j];
       }
     }
-    indx[j-1] = i;
+    j++;
+    indx[j] = i;
+    while (j <= n) {
+      emptyCount[j] --;
+      j += j & (~j + 1);
+    }
   }
+  free_uivector(emptyCount, 1, n);
 }
 void getAntiMembership (uint       mode,
                         uint       treeID,
@@ -17314,9 +22262,20 @@ void updateVimpEnsemble (uint       mode,
                          uint       treeID,
                          Terminal **vimpMembership,
                          uint       p) {
+  uint     **vimpEnsembleDen;
+  double  ***vimpEnsembleMRT;
+  double ****vimpEnsembleCLS;
+  double  ***vimpEnsembleRGR;
   char   ensembleFlag;
   uint   obsSize;
+  uint   slot;
   uint i;
+  slot = getVimpPartialSlot(treeID,
+                            p,
+                            & vimpEnsembleDen,
+                            & vimpEnsembleMRT,
+                            & vimpEnsembleCLS,
+                            & vimpEnsembleRGR);
   if (RF_opt & OPT_VIMP_LEOB) {
     ensembleFlag = FALSE;
     switch (mode) {
@@ -17328,7 +22287,7 @@ void updateVimpEnsemble (uint       mode,
       break;
     }
     for (i = 1; i <= obsSize; i++) {
-      RF_vimpEnsembleDen[p][i] = 0;
+      vimpEnsembleDen[slot][i] = 0;
     }
   }
   else {
@@ -17336,12 +22295,13 @@ void updateVimpEnsemble (uint       mode,
   }
   updateGenericVimpEnsemble(mode,
                             treeID,
-                            p,              
+                            slot,           
                             vimpMembership, 
                             ensembleFlag,   
-                            RF_vimpEnsembleMRT,
-                            RF_vimpEnsembleCLS,
-                            RF_vimpEnsembleRGR);
+                            vimpEnsembleDen[slot],
+                            vimpEnsembleMRT,
+                            vimpEnsembleCLS,
+                            vimpEnsembleRGR);
 }
 void updateTreeEnsemble (uint       mode,
                          uint       treeID,
@@ -17362,6 +22322,7 @@ void updateTreeEnsemble (uint       mode,
                             1,              
                             termMembership, 
                             FALSE,          
+                            NULL,           
                             treeEnsembleMRT,
                             treeEnsembleCLS,
                             treeEnsembleRGR);
@@ -17371,6 +22332,7 @@ void updateGenericVimpEnsemble (uint       mode,
                                 uint       xVarIdx,
                                 Terminal **noiseMembership,
                                 char       ensembleFlag,
+                                uint      *genEnsembleDen,
                                 double  ***genEnsembleMRT,
                                 double ****genEnsembleCLS,
                                 double  ***genEnsembleRGR) {
@@ -17394,7 +22356,6 @@ void updateGenericVimpEnsemble (uint       mode,
       terminalNode = noiseMembership[ii];
       if ((terminalNode -> membrCount) > 0) {
         if (!ensembleFlag) {
-          RF_vimpEnsembleDen[xVarIdx][ii] = 1;
           if ((RF_timeIndex > 0) && (RF_statusIndex > 0)) {
             for (k=1; k <= RF_eventTypeSize; k++) {
               genEnsembleMRT[xVarIdx][k][ii] = terminalNode -> mortality[k];
@@ -17421,7 +22382,9 @@ void updateGenericVimpEnsemble (uint       mode,
               }
             }
           }
-          RF_vimpEnsembleDen[xVarIdx][ii] = 1;
+          if (genEnsembleDen != NULL) {
+            genEnsembleDen[ii] = 1;
+          }
         }
         else {
           if ((RF_timeIndex > 0) && (RF_statusIndex > 0)) {
@@ -17443,7 +22406,7 @@ void updateGenericVimpEnsemble (uint       mode,
               }
             }
           }
-          RF_vimpEnsembleDen[xVarIdx][ii] ++;
+          genEnsembleDen[ii] ++;
         }
       }
       else {
@@ -17462,6 +22425,14 @@ void summarizeVimpPerformance(uint       mode,
   uint      obsSize;
   double   **responsePtr;
   uint      *vimpDenom;
+  uint     **vimpEnsembleDen;
+  double  ***vimpEnsembleMRTslot;
+  double ****vimpEnsembleCLSslot;
+  double  ***vimpEnsembleRGRslot;
+  double   **vimpEnsembleMRT;
+  double  ***vimpEnsembleCLS;
+  double   **vimpEnsembleRGR;
+  uint       slot;
   double   **ensembleMRT;
   double  ***ensembleCLS;
   double   **ensembleRGR;
@@ -17493,14 +22464,32 @@ void summarizeVimpPerformance(uint       mode,
   else {
     imputeFlag = stackAndImputePerfResponse(mode, FALSE, 0, RF_forestSize, &responsePtr);
   } 
-  vimpDenom = RF_vimpEnsembleDen[p];
+  if (RF_opt & OPT_VIMP_LEOB) {
+    slot = getVimpPartialSlot(treeID,
+                              p,
+                              & vimpEnsembleDen,
+                              & vimpEnsembleMRTslot,
+                              & vimpEnsembleCLSslot,
+                              & vimpEnsembleRGRslot);
+  }
+  else {
+    slot = p;
+    vimpEnsembleDen     = RF_vimpEnsembleDen;
+    vimpEnsembleMRTslot = RF_vimpEnsembleMRT;
+    vimpEnsembleCLSslot = RF_vimpEnsembleCLS;
+    vimpEnsembleRGRslot = RF_vimpEnsembleRGR;
+  }
+  vimpDenom = vimpEnsembleDen[slot];
+  vimpEnsembleMRT = (vimpEnsembleMRTslot != NULL) ? vimpEnsembleMRTslot[slot] : NULL;
+  vimpEnsembleCLS = (vimpEnsembleCLSslot != NULL) ? vimpEnsembleCLSslot[slot] : NULL;
+  vimpEnsembleRGR = (vimpEnsembleRGRslot != NULL) ? vimpEnsembleRGRslot[slot] : NULL;
   if ((RF_timeIndex > 0) && (RF_statusIndex > 0)) {
     if (!(RF_opt & OPT_VIMP_LEOB)) {
       if (!(RF_opt & OPT_COMP_RISK)) {
-        getEnsembleMortality(mode, treeID, obsSize, RF_vimpEnsembleMRT[p], vimpDenom, RF_vimpEnsembleMRT[p][1]);
+        getEnsembleMortality(mode, treeID, obsSize, vimpEnsembleMRT, vimpDenom, vimpEnsembleMRT[1]);
       }
       else {
-        getEnsembleMortalityCR(mode, treeID, obsSize, RF_vimpEnsembleMRT[p], vimpDenom, RF_vimpEnsembleMRT[p]);
+        getEnsembleMortalityCR(mode, treeID, obsSize, vimpEnsembleMRT, vimpDenom, vimpEnsembleMRT);
       }
     }
   }  
@@ -17514,17 +22503,17 @@ void summarizeVimpPerformance(uint       mode,
                 maxValue = 0;
                 maxClass = 0;
                 for (k=1; k <= RF_rFactorSize[RF_rFactorMap[RF_rTargetFactor[j]]]; k++) {
-                  if (maxValue < RF_vimpEnsembleCLS[p][j][k][i]) {
-                    maxValue = RF_vimpEnsembleCLS[p][j][k][i];
+                  if (maxValue < vimpEnsembleCLS[j][k][i]) {
+                    maxValue = vimpEnsembleCLS[j][k][i];
                     maxClass = (double) k;
                   }
-                  RF_vimpEnsembleCLS[p][j][k][i] = NA_REAL;
+                  vimpEnsembleCLS[j][k][i] = NA_REAL;
                 }
-                RF_vimpEnsembleCLS[p][j][1][i] = maxClass;
+                vimpEnsembleCLS[j][1][i] = maxClass;
               }
               else {
                 for (k=2; k <= RF_rFactorSize[RF_rFactorMap[RF_rTargetFactor[j]]]; k++) {
-                  RF_vimpEnsembleCLS[p][j][k][i] = NA_REAL;
+                  vimpEnsembleCLS[j][k][i] = NA_REAL;
                 }
               }
             }
@@ -17537,7 +22526,7 @@ void summarizeVimpPerformance(uint       mode,
         for (j=1; j <= RF_rTargetNonFactorCount; j++) {
           for (i = 1; i <= obsSize; i++) {
             if(vimpDenom[i] > 0) {
-              RF_vimpEnsembleRGR[p][j][i] = RF_vimpEnsembleRGR[p][j][i] / vimpDenom[i];
+              vimpEnsembleRGR[j][i] = vimpEnsembleRGR[j][i] / vimpDenom[i];
             }
           }
         }
@@ -17551,14 +22540,14 @@ void summarizeVimpPerformance(uint       mode,
   vimpCLSptr = NULL;
   vimpRGRptr = NULL;
   if ((RF_timeIndex > 0) && (RF_statusIndex > 0)) {
-    ensembleMRT =  RF_vimpEnsembleMRT[p];
+    ensembleMRT =  vimpEnsembleMRT;
   }
   else {
     if (RF_rTargetFactorCount > 0) {
-      ensembleCLS = RF_vimpEnsembleCLS[p];
+      ensembleCLS = vimpEnsembleCLS;
     }
     if (RF_rTargetNonFactorCount > 0) {
-      ensembleRGR = RF_vimpEnsembleRGR[p];
+      ensembleRGR = vimpEnsembleRGR;
     }    
   }
   if (!(RF_opt & OPT_VIMP_LEOB)) {
@@ -17893,6 +22882,7 @@ void unstackTreeEnsemble(uint        mode,
   free_new_vvector(treeEnsembleRGR, 1, 1, NRUTIL_DPTR2);
 }
 void updateVimpCalculations (uint mode, uint b, uint intrIndex, Terminal **vimpMembership) {
+  Arena *arena;
   if (RF_tLeafCount[b] == 0) {
     RFprintf("\nRF-SRC:  *** ERROR *** ");
     RFprintf("\nRF-SRC:  Attempt to compute importance on a rejected tree:  %10d", b);
@@ -17905,15 +22895,30 @@ void updateVimpCalculations (uint mode, uint b, uint intrIndex, Terminal **vimpM
     RFprintf("\nRF-SRC:  Please Contact Technical Support.");
     error("\nRF-SRC:  The application will now exit.\n");
   }
-#ifdef _OPENMP
-#pragma omp critical (_update_gve)
-#endif
-  {  
+  if (RF_vimpPartialFlag) {
+    if (getVimpTreePartialFlag()) {
+      if (RF_vimpEnsembleDenPart[b] == NULL) {
+        arena = suspendArena();
+        stackVimpPartial(mode, b);
+        resumeArena(arena);
+      }
+    }
     updateVimpEnsemble(mode, b, vimpMembership, intrIndex);
     if (RF_opt & OPT_VIMP_LEOB) {
       summarizeVimpPerformance(mode, b, intrIndex);
     }
-  }  
+  }
+  else {
+#ifdef _OPENMP
+#pragma omp critical (_update_gve)
+#endif
+    {  
+      updateVimpEnsemble(mode, b, vimpMembership, intrIndex);
+      if (RF_opt & OPT_VIMP_LEOB) {
+        summarizeVimpPerformance(mode, b, intrIndex);
+      }
+    }  
+  }
 }
 void summarizeTreePerformance(uint mode, uint treeID) {
   uint  obsSize;
@@ -17971,6 +22976,7 @@ SEXP rfsrc(char mode, int seedValue, uint traceFlag) {
   int vimpCount, b, p;
   uint seedValueLC;
   RF_userTraceFlag = traceFlag;
+  RF_arenaCurrent = NULL;
   seedValueLC    = 0; 
   if (RF_nImpute < 1) {
     RFprintf("\nRF-SRC:  *** ERROR *** ");
@@ -18008,6 +23014,7 @@ SEXP rfsrc(char mode, int seedValue, uint traceFlag) {
     RF_numThreads = (RF_numThreads < omp_get_max_threads()) ? (RF_numThreads) : (omp_get_max_threads());
   }
 #endif
+  stackThreadSchedule();
   stackIncomingArrays(mode);
   stackPreDefinedCommonArrays();
   switch (mode) {
@@ -18024,6 +23031,22 @@ SEXP rfsrc(char mode, int seedValue, uint traceFlag) {
   initializeTimeArrays(mode);
   stackFactorArrays();
   stackMissingArrays(mode);
+  if (RF_optHigh & OPT_SORT_ONCE) {
+    if (RF_mRecordSize > 0) {
+      RF_optHigh = RF_optHigh & (~OPT_SORT_ONCE);
+    }
+    else {
+      stackPresortArrays();
+    }
+  }
+  if (RF_optHigh & OPT_SPLT_HIST) {
+    if (RF_mRecordSize > 0) {
+      RF_optHigh = RF_optHigh & (~OPT_SPLT_HIST);
+    }
+    else {
+      stackHistogramArrays();
+    }
+  }
   if (RF_statusIndex > 0) {
     stackCompetingArrays(mode);
   }
@@ -18084,9 +23107,16 @@ SEXP rfsrc(char mode, int seedValue, uint traceFlag) {
                                   sexpString,
                                   sexpVector);
 #ifdef _OPENMP
-  ran1A = &randomChainParallel;
-  ran1B = &randomUChainParallel;
-  ran1C = &randomUChainParallelCov;
+  if (RF_optHigh & OPT_RAND_CTR) {
+    ran1A = &randomChainParallelCounter;
+    ran1B = &randomUChainParallelCounter;
+    ran1C = &randomUChainParallelCovCounter;
+  }
+  else {
+    ran1A = &randomChainParallel;
+    ran1B = &randomUChainParallel;
+    ran1C = &randomUChainParallelCov;
+  }
   randomSetChain = &randomSetChainParallel;
   randomSetUChain = &randomSetUChainParallel;
   randomSetUChainCov = &randomSetUChainParallelCov;
@@ -18123,9 +23153,16 @@ SEXP rfsrc(char mode, int seedValue, uint traceFlag) {
     randomSetUChainCov(b, -seedValueLC);
   }
 #else
-  ran1A = &randomChainSerial;
-  ran1B = &randomUChainSerial;
-  ran1C = &randomUChainSerialCov;
+  if (RF_optHigh & OPT_RAND_CTR) {
+    ran1A = &randomChainSerialCounter;
+    ran1B = &randomUChainSerialCounter;
+    ran1C = &randomUChainSerialCovCounter;
+  }
+  else {
+    ran1A = &randomChainSerial;
+    ran1B = &randomUChainSerial;
+    ran1C = &randomUChainSerialCov;
+  }
   randomSetChain = &randomSetChainSerial;
   randomSetUChain = &randomSetUChainSerial;
   randomSetUChainCov = &randomSetUChainSerialCov;
@@ -18205,6 +23242,9 @@ SEXP rfsrc(char mode, int seedValue, uint traceFlag) {
       }
     }
   }
+  stackFlatForest(mode);
+  stackTreeCommits(mode);
+  stackDataReplicas(mode);
   for (r = 1; r <= RF_nImpute; r++) {
     if (RF_userTraceFlag) {
       if (RF_nImpute == 1) {
@@ -18274,23 +23314,45 @@ SEXP rfsrc(char mode, int seedValue, uint traceFlag) {
         }
       }
     }  
+    if (r == RF_nImpute) {
+      stackEnsemblePartials(mode);
+      stackVimpPartials(mode);
+      stackTreeRecords(mode);
+    }
     if (RF_userTraceFlag) {
       RF_userTimeStart = RF_userTimeSplit = time(NULL);
     }
+    RF_arenaPeak = RF_arenaTotal = 0.0;
     if (RF_numThreads > 0) {
+      if (RF_replicaCount > 1) {
+#if defined(_OPENMP) && (_OPENMP >= 201511)
+#pragma omp parallel num_threads(RF_numThreads) proc_bind(spread)
+#endif
+        {
+          acquireForest(mode, r);
+        }
+      }
+      else {
 #ifdef _OPENMP
-#pragma omp parallel for num_threads(RF_numThreads)
+#pragma omp parallel num_threads(RF_numThreads)
 #endif
-      for (b = 1; b <= RF_forestSize; b++) {
-        acquireTree(mode, r, b);
+        {
+          acquireForest(mode, r);
+        }
       }
     }
     else {
-      for (b = 1; b <= RF_forestSize; b++) {
-        acquireTree(mode, r, b);
+      acquireForest(mode, r);
+    }
+    if (RF_userTraceFlag) {
+      if (RF_arenaTotal > 0) {
+        RFprintf("\nArena Bytes (Peak Per Tree, Total):  %14.0f %14.0f", RF_arenaPeak, RF_arenaTotal);
       }
     }
     if (r == RF_nImpute) {
+      finalizeEnsemblePartials(mode, ((mode == RF_GROW) && (r > 1)) ? TRUE : FALSE);
+      finalizeVimpPartials(mode);
+      finalizeTreeRecords(mode);
       RF_rejectedTreeCount = RF_validTreeCount = RF_stumpedTreeCount = 0;
       for (b = 1; b <= RF_forestSize; b++) {
         if (RF_tLeafCount[b] == 0) {
@@ -18393,6 +23455,9 @@ SEXP rfsrc(char mode, int seedValue, uint traceFlag) {
       RFprintf("\n\n");
     }
   }  
+  unstackDataReplicas(mode);
+  unstackTreeCommits(mode);
+  unstackFlatForest(mode);
   if (RF_rejectedTreeCount < RF_forestSize) {
     if (RF_opt & OPT_VIMP) {
       if (RF_opt & OPT_VIMP_JOIN) {
@@ -18406,16 +23471,25 @@ SEXP rfsrc(char mode, int seedValue, uint traceFlag) {
       else {
         if (RF_numThreads > 0) {
 #ifdef _OPENMP
-#pragma omp parallel for num_threads(RF_numThreads)
+#pragma omp parallel num_threads(RF_numThreads)
 #endif
-          for (p = 1; p <= vimpCount; p++) {
-            summarizeVimpPerformance(mode, 0, p);
+          {
+            double busyStart = getThreadClock();
+#ifdef _OPENMP
+#pragma omp for schedule(runtime) nowait
+#endif
+            for (p = 1; p <= vimpCount; p++) {
+              summarizeVimpPerformance(mode, 0, p);
+            }
+            updateThreadBusyTime(busyStart);
           }
         }
         else {
+          double busyStart = getThreadClock();
           for (p = 1; p <= vimpCount; p++) {
             summarizeVimpPerformance(mode, 0, p);
           }
+          updateThreadBusyTime(busyStart);
         }
       }
       finalizeVimpPerformance(mode, RF_rejectedTreeCount);
@@ -18488,6 +23562,12 @@ SEXP rfsrc(char mode, int seedValue, uint traceFlag) {
   if (RF_rFactorCount > 0) {
     unstackClassificationArrays(mode);
   }
+  if (RF_optHigh & OPT_SORT_ONCE) {
+    unstackPresortArrays();
+  }
+  if (RF_optHigh & OPT_SPLT_HIST) {
+    unstackHistogramArrays();
+  }
   unstackMissingArrays(mode);
   unstackFactorArrays();
   switch (mode) {
@@ -18503,6 +23583,7 @@ SEXP rfsrc(char mode, int seedValue, uint traceFlag) {
   }
   unstackPreDefinedCommonArrays();
   unstackIncomingArrays(mode);
+  unstackThreadSchedule();
 #ifdef _OPENMP
   randomUnstack(RF_forestSize, RF_xSize);
 #else
@@ -71,6 +71,17 @@
 #ifdef _OPENMP
 #include           <omp.h>
 #endif
+#ifndef _WIN32
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#endif
 #ifndef NULL
 #define NULL 0
 #endif
@@ -131,7 +142,9 @@
 #define RF_MTRY_ID  48  
 #define RF_MTRY_ST  49  
 #define RF_MWCP_CT  50  
-#define RF_SEXP_CNT 51  
+#define RF_PROX_IDX 51  
+#define RF_PROX_COL 52  
+#define RF_SEXP_CNT 53  
 #define SEXP_TYPE_NUMERIC 0
 #define SEXP_TYPE_INTEGER 1
 #define OPT_FENS       0x000001  
@@ -175,6 +188,21 @@
 #define OPT_SPLT_CUST 0x00000F00 
 #define OPT_BOOT_SWOR 0x00001000 
 #define OPT_TREE_ERR  0x00002000 
+#define OPT_SORT_ONCE 0x00004000 
+#define OPT_CONC_PAIR 0x00008000 
+#define OPT_SPLT_HIST 0x000F0000 
+#define OPT_PERM_CMPT 0x00100000 
+#define OPT_RAND_CTR  0x00200000 
+#define OPT_SCHD      0x00C00000 
+#define OPT_SCHD_DYNM 0x00400000 
+#define OPT_SCHD_GUID 0x00800000 
+#define OPT_SPLT_PARL 0x01000000 
+#define OPT_PROX_SPRS 0x02000000 
+#define OPT_NUMA_REPL 0x04000000 
+#define OPT_DTRM      0x08000000 
+#define OPT_ENSB_PART 0x10000000 
+#define OPT_VIMP_PART 0x20000000 
+#define OPT_LRSCR_STD 0x40000000 
 #define ACTIVE    0x02
 #define LEFT      0x01
 #define RIGHT     0x00
@@ -208,6 +236,19 @@
 #define EXACT 1
 #define SIZE_OF_INTEGER sizeof(uint)
 #define MAX_EXACT_LEVEL SIZE_OF_INTEGER * 8
+#define FLAT_BLOCK_SIZE 256
+#define PARTIAL_BUDGET_SIZE 134217728
+#define SCORE_CMD_ROWS     1
+#define SCORE_CMD_STAT     2
+#define SCORE_CMD_QUIT     3
+#define SCORE_STAT_OK      0
+#define SCORE_STAT_FOREST  1
+#define SCORE_STAT_SIZE    2
+#define SCORE_STAT_COMMAND 3
+#define SCORE_HEADER_SIZE  4
+#define SCORE_HIST_SIZE   32
+#define SCORE_POLL_MSEC  250
+#define SCORE_IDLE_MSEC  30000
 #define SAFE_FACTOR_SIZE 16
 #define MARGINAL_SIZE 4
 #define RF_WGHT_UNIFORM 1
@@ -234,6 +275,7 @@ struct node {
   unsigned int *splitValueFactPtr;
   unsigned int nodeID;
   unsigned int depth;
+  unsigned int presortOffset;
   char pseudoTerminal;
   struct terminal *mate;
   struct node *left;
@@ -296,8 +338,133 @@ struct factor {
   unsigned int **cardinalGroupBinary;
   unsigned int mwcpSize;
 };
+#define ARENA_CHUNK_SIZE 0x100000
+typedef struct arenaBlock ArenaBlock;
+typedef struct arenaChunk ArenaChunk;
+typedef struct arena Arena;
+struct arenaBlock {
+  struct arenaChunk *chunk;
+  struct arenaBlock *prev;
+  size_t size;
+  size_t freed;
+};
+struct arenaChunk {
+  struct arena      *arena;
+  struct arenaChunk *prev;
+  struct arenaBlock *top;
+  size_t size;
+  size_t used;
+  size_t pad;
+};
+struct arena {
+  struct arenaChunk *chunk;
+  size_t live;
+  size_t peak;
+  size_t total;
+};
+#define RANDOM_NTAB 32
+#define CACHE_LINE_SIZE 64
+typedef struct randomStream RandomStream;
+typedef union randomSlot RandomSlot;
+struct randomStream {
+  int          seed;
+  int          iy;
+  int          iv[RANDOM_NTAB + 1];
+  unsigned int counter[2];
+  unsigned int block[4];
+  unsigned int blockIndex;
+};
+union randomSlot {
+  struct randomStream stream;
+  char pad[((sizeof(struct randomStream) + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE) * CACHE_LINE_SIZE];
+};
+typedef struct splitCandidate SplitCandidate;
+struct splitCandidate {
+  unsigned int   covariate;
+  unsigned int   candidateCovariateCount;
+  double        *splitVector;
+  unsigned int   splitVectorSize;
+  unsigned int  *indxx;
+  unsigned int   nonMissMembrSize;
+  unsigned int  *nonMissMembrIndx;
+  unsigned int   splitLength;
+  void          *splitVectorPtr;
+  char           factorFlag;
+  char           deterministicSplitFlag;
+  unsigned int   mwcpSizeAbsolute;
+  char          *localSplitIndicator;
+  double         deltaMax;
+  unsigned int   splitParameterMax;
+  double         splitValueMaxCont;
+  unsigned int   splitValueMaxFactSize;
+  unsigned int  *splitValueMaxFactPtr;
+  unsigned int   classSize;
+  unsigned int  *parentClassProp;
+  unsigned int  *leftClassProp;
+  unsigned int  *rghtClassProp;
+};
+typedef struct treeRecord TreeRecord;
+struct treeRecord {
+  unsigned int   nodeCount;
+  unsigned int   mwcpCount;
+  unsigned int  *treeID;
+  unsigned int  *nodeID;
+  unsigned int  *parmID;
+  double        *contPT;
+  unsigned int  *mwcpSZ;
+  unsigned int  *mwcpPT;
+  double        *spltST;
+  unsigned int **mtryID;
+  double       **mtryST;
+  unsigned int **uspvST;
+};
+typedef struct flatForest FlatForest;
+struct flatForest {
+  unsigned int   forestSize;
+  unsigned int   nodeCount;
+  unsigned int  *rootID;
+  unsigned int  *depth;
+  unsigned int  *mwcpCount;
+  unsigned int  *parmID;
+  double        *contPT;
+  unsigned int  *childID;
+  unsigned int  *nodeID;
+  unsigned int  *mwcpSZ;
+  unsigned int  *mwcpID;
+  unsigned int  *mwcpPT;
+};
+typedef struct scoreForest ScoreForest;
+struct scoreForest {
+  unsigned int   forestSize;
+  unsigned int   xSize;
+  unsigned int   outcomeSize;
+  unsigned int   treeCount;
+  unsigned int   leafSize;
+  unsigned int   mwcpSize;
+  int            numThreads;
+  unsigned int  *xLevels;
+  unsigned int  *leafCount;
+  unsigned int  *leafOffset;
+  unsigned int  *mwcpPT;
+  double        *leafValue;
+  FlatForest    *flatForest;
+};
+typedef struct scoreWorker ScoreWorker;
+struct scoreWorker {
+  unsigned int   maxRows;
+  unsigned int   xSize;
+  unsigned int   outcomeSize;
+  unsigned int   requestCount;
+  double         rowCount;
+  double        *x;
+  double        *ensemble;
+  unsigned int  *latency;
+};
 void randomStack(uint bSize, uint xSize);
 void randomUnstack(uint bSize, uint xSize);
+RandomSlot *stackRandomSlot(uint bSize, void **slotBlock);
+void unstackRandomSlot(uint bSize, void *slotBlock);
+void randomSetStream(RandomStream *stream, int value);
 void randomSetChainParallel(uint b, int value);
 void randomSetUChainParallel(uint b, int value);
 void randomSetUChainParallelCov(uint b, int value);
@@ -310,13 +477,21 @@ int randomGetUChainParallelCov(uint b);
 int randomGetChainSerial(uint b);
 int randomGetUChainSerial(uint b);
 int randomGetUChainSerialCov(uint b);
-float randomChainParallel(uint b);
-float randomUChainParallel(uint b);
-float randomUChainParallelCov(uint b);
-float randomChainSerial(uint b);
-float randomUChainSerial(uint b);
-float randomUChainSerialCov(uint b);
+double randomChainParallel(uint b);
+double randomUChainParallel(uint b);
+double randomUChainParallelCov(uint b);
+double randomChainSerial(uint b);
+double randomUChainSerial(uint b);
+double randomUChainSerialCov(uint b);
+double randomChainParallelCounter(uint b);
+double randomUChainParallelCounter(uint b);
+double randomUChainParallelCovCounter(uint b);
+double randomChainSerialCounter(uint b);
+double randomUChainSerialCounter(uint b);
+double randomUChainSerialCovCounter(uint b);
 float ran1_generic(int *iy, int *iv, int *idum);
+double ranCounter_generic(RandomStream *stream, uint streamID, uint b);
+void philox4x32(unsigned int *counter, unsigned int *key, unsigned int *result);
 void lcgenerator(unsigned int *seed, unsigned char reset);
 float ran1_original(int *idum);
 enum alloc_type{
@@ -327,6 +502,10 @@ enum alloc_type{
   NRUTIL_NPTR,   
   NRUTIL_TPTR,   
   NRUTIL_FPTR,   
+  NRUTIL_SPTR,   
+  NRUTIL_RPTR,   
+  NRUTIL_SFPTR,  
+  NRUTIL_SWPTR,  
   NRUTIL_DPTR2,  
   NRUTIL_UPTR2,  
   NRUTIL_IPTR2,  
@@ -350,6 +529,10 @@ void indexx(unsigned int n, double *arr, unsigned int *indx);
 void nrerror(char error_text[]);
 void *gblock(size_t size);
 void free_gblock(void *v, size_t size);
+Arena *makeArena();
+void freeArena(Arena *arena);
+void *arenaBlock(Arena *arena, size_t size);
+void free_arenaBlock(ArenaBlock *block);
 void *gvector(unsigned int nl, unsigned int nh, size_t size);
 void free_gvector(void *v, unsigned int nl, unsigned int nh, size_t size);
 char *cvector(unsigned int nl, unsigned int nh);
@@ -494,7 +677,7 @@ void updateCDF(uint    treeID,
                uint   *densitySize,
                uint  **densitySwap,
                uint    absoluteSlot);
-uint sampleFromCDF (float (*genericGenerator) (uint),
+uint sampleFromCDF (double (*genericGenerator) (uint),
                     uint    treeID,
                     uint    weightType,
                     uint   *sampleIndex,
@@ -547,6 +730,7 @@ SEXP rfsrcGrow(SEXP traceFlag,
                SEXP timeInterest,
                SEXP missTree,
                SEXP imputeSize,
+               SEXP proximityTopK,
                SEXP numThreads);
 SEXP rfsrcPredict(SEXP traceFlag,
                   SEXP seedPtr,
@@ -594,7 +778,43 @@ SEXP rfsrcPredict(SEXP traceFlag,
                   SEXP seed,
                   SEXP intrPredictorSize,
                   SEXP intrPredictor,
+                  SEXP proximityTopK,
                   SEXP numThreads);
+SEXP rfsrcScoreLoad(SEXP forestSize,
+                    SEXP rSize,
+                    SEXP rType,
+                    SEXP rLevels,
+                    SEXP xSize,
+                    SEXP xType,
+                    SEXP xLevels,
+                    SEXP timeInterestSize,
+                    SEXP eventTypeSize,
+                    SEXP crFlag,
+                    SEXP treeID,
+                    SEXP nodeID,
+                    SEXP parmID,
+                    SEXP contPT,
+                    SEXP mwcpSZ,
+                    SEXP mwcpPT,
+                    SEXP tnSURV,
+                    SEXP tnMORT,
+                    SEXP tnNLSN,
+                    SEXP tnCSHZ,
+                    SEXP tnCIFN,
+                    SEXP tnREGR,
+                    SEXP tnCLAS,
+                    SEXP tnMCNT,
+                    SEXP totalNodeCount,
+                    SEXP numThreads);
+SEXP rfsrcScore(SEXP handle,
+                SEXP xData,
+                SEXP rowSize,
+                SEXP ensemble);
+void finalizeScoreForest(SEXP handle);
+SEXP rfsrcScoreServe(SEXP handleList,
+                     SEXP socketPath,
+                     SEXP maxRows,
+                     SEXP numWorkers);
 SEXP rfsrcPartial(SEXP traceFlag,
                   SEXP seedPtr,
                   SEXP opt,
@@ -709,6 +929,21 @@ void stackPreDefinedCommonArrays();
 void unstackPreDefinedCommonArrays();
 void stackPreDefinedGrowthArrays();
 void unstackPreDefinedGrowthArrays();
+void stackHistogramArrays();
+void unstackHistogramArrays();
+void stackPresortArrays();
+void unstackPresortArrays();
+void stackPresortIndex(uint treeID, uint *membrIndx, uint membrSize);
+void unstackPresortIndex(uint treeID, uint membrSize);
+void partitionPresortIndex(uint  treeID,
+                           Node *parent,
+                           uint *repMembrIndx,
+                           uint  repMembrSize,
+                           char *membershipIndicator);
+void stackSplitPartition(uint treeID);
+void unstackSplitPartition(uint treeID);
+uint getSplitPartitionSize();
+uint partitionMembership(uint treeID, uint *membrIndx, uint membrSize, char *membershipIndicator);
 void stackPreDefinedRestoreArrays();
 void unstackPreDefinedRestoreArrays();
 void stackPreDefinedPredictArrays();
@@ -846,6 +1081,67 @@ char classificationXwghtSplit(uint    treeID,
                               double *splitStatistic,
                               char  **splitIndicator,
                               char    multImpFlag);
+void classificationCandidateSplit(uint    treeID,
+                                  Node   *parent,
+                                  uint   *repMembrIndx,
+                                  uint    repMembrSize,
+                                  uint   *nonMissMembrIndx,
+                                  uint    nonMissMembrSize,
+                                  uint   *indxx,
+                                  uint    covariate,
+                                  uint    candidateCovariateCount,
+                                  uint    splitLength,
+                                  void   *splitVectorPtr,
+                                  char    factorFlag,
+                                  uint    mwcpSizeAbsolute,
+                                  char   *localSplitIndicator,
+                                  uint   *parentClassProp,
+                                  uint   *leftClassProp,
+                                  uint   *rghtClassProp,
+                                  double *deltaMax,
+                                  uint   *splitParameterMax,
+                                  double *splitValueMaxCont,
+                                  uint   *splitValueMaxFactSize,
+                                  uint  **splitValueMaxFactPtr,
+                                  char  **splitIndicator);
+void regressionHistogramSplit(uint    treeID,
+                              Node   *parent,
+                              uint   *repMembrIndx,
+                              uint    repMembrSize,
+                              uint   *nonMissMembrIndx,
+                              uint    nonMissMembrSize,
+                              uint    covariate,
+                              uint    candidateCovariateCount,
+                              uint   *histCount,
+                              double *histSum,
+                              double *histSumSqr,
+                              char   *localSplitIndicator,
+                              double *deltaMax,
+                              uint   *splitParameterMax,
+                              double *splitValueMaxCont,
+                              uint   *splitValueMaxFactSize,
+                              uint  **splitValueMaxFactPtr,
+                              char  **splitIndicator);
+void classificationHistogramSplit(uint    treeID,
+                                  Node   *parent,
+                                  uint   *repMembrIndx,
+                                  uint    repMembrSize,
+                                  uint   *nonMissMembrIndx,
+                                  uint    nonMissMembrSize,
+                                  uint    covariate,
+                                  uint    candidateCovariateCount,
+                                  uint   *histCount,
+                                  uint  **histClass,
+                                  uint   *parentClassProp,
+                                  uint   *leftClassProp,
+                                  uint   *rghtClassProp,
+                                  char   *localSplitIndicator,
+                                  double *deltaMax,
+                                  uint   *splitParameterMax,
+                                  double *splitValueMaxCont,
+                                  uint   *splitValueMaxFactSize,
+                                  uint  **splitValueMaxFactPtr,
+                                  char  **splitIndicator);
 char regressionXwghtSplit(uint    treeID,
                           Node   *parent,
                           uint   *repMembrIndx,
@@ -859,6 +1155,26 @@ char regressionXwghtSplit(uint    treeID,
                           double *splitStatistic,
                           char  **splitIndicator,
                           char    multImpFlag);
+void regressionCandidateSplit(uint    treeID,
+                              Node   *parent,
+                              uint   *repMembrIndx,
+                              uint    repMembrSize,
+                              uint   *nonMissMembrIndx,
+                              uint    nonMissMembrSize,
+                              uint   *indxx,
+                              uint    covariate,
+                              uint    candidateCovariateCount,
+                              uint    splitLength,
+                              void   *splitVectorPtr,
+                              char    factorFlag,
+                              uint    mwcpSizeAbsolute,
+                              char   *localSplitIndicator,
+                              double *deltaMax,
+                              uint   *splitParameterMax,
+                              double *splitValueMaxCont,
+                              uint   *splitValueMaxFactSize,
+                              uint  **splitValueMaxFactPtr,
+                              char  **splitIndicator);
 char logRankNCR(uint    treeID,
                 Node   *parent,
                 uint   *repMembrIndx,
@@ -872,6 +1188,38 @@ char logRankNCR(uint    treeID,
                 double *splitStatistic,
                 char  **splitIndicator,
                 char    multImpFlag);
+void logRankNCRCandidateSplit(uint    treeID,
+                              Node   *parent,
+                              uint   *repMembrIndx,
+                              uint    repMembrSize,
+                              uint    localEventTimeSize,
+                              uint   *localEventTimeIndex,
+                              uint   *nodeParentEvent,
+                              uint   *nodeParentAtRisk,
+                              uint   *membrTimeIndex,
+                              double *eventRatioSum,
+                              double *riskRatioSum,
+                              double *riskRatioSqrSum,
+                              uint   *survivalTimeRank,
+                              double *nodeSurvivalRank,
+                              double  nodeMeanSurvRank,
+                              double  nodeVarSurvRank,
+                              uint   *nonMissMembrIndx,
+                              uint    nonMissMembrSize,
+                              uint   *indxx,
+                              uint    covariate,
+                              uint    candidateCovariateCount,
+                              uint    splitLength,
+                              void   *splitVectorPtr,
+                              char    factorFlag,
+                              uint    mwcpSizeAbsolute,
+                              char   *localSplitIndicator,
+                              double *deltaMax,
+                              uint   *splitParameterMax,
+                              double *splitValueMaxCont,
+                              uint   *splitValueMaxFactSize,
+                              uint  **splitValueMaxFactPtr,
+                              char  **splitIndicator);
 char logRankCR (uint    treeID,
                 Node   *parent,
                 uint   *repMembrIndx,
@@ -955,10 +1303,14 @@ void stackSplitIndicator(uint   nodeSize,
                          char **localSplitIndicator);
 void unstackSplitIndicator(uint  nodeSize,
                            char *localSplitIndicator);
-void stackSplitEventTime(uint **localEventTimeCount,
+void stackSplitEventScratch(uint treeID);
+void unstackSplitEventScratch(uint treeID);
+void stackSplitEventTime(uint   treeID,
+                         uint **localEventTimeCount,
                          uint **localEventTimeIndex);
 void unstackSplitEventTime(uint *localEventTimeCount,
-                           uint *localEventTimeIndex);
+                           uint *localEventTimeIndex,
+                           uint  eventTimeSize);
 uint getSplitEventTime(uint   treeID,
                        uint   *repMembrIndx,
                        uint    repMembrSize,
@@ -1013,6 +1365,57 @@ void unstackSplitSurv(uint *localEventTimeCount,
                       uint *nodeLeftAtRisk,
                       uint *nodeRightEvent,
                       uint *nodeRightAtRisk);
+void stackLogRankIncrement(uint     repMembrSize,
+                           uint     localEventTimeSize,
+                           uint   **membrTimeIndex,
+                           double **eventRatioSum,
+                           double **riskRatioSum,
+                           double **riskRatioSqrSum,
+                           double **fenwickCount,
+                           double **fenwickSum);
+void unstackLogRankIncrement(uint    repMembrSize,
+                             uint    localEventTimeSize,
+                             uint   *membrTimeIndex,
+                             double *eventRatioSum,
+                             double *riskRatioSum,
+                             double *riskRatioSqrSum,
+                             double *fenwickCount,
+                             double *fenwickSum);
+void getLogRankIncrement(uint    treeID,
+                         uint   *repMembrIndx,
+                         uint   *nonMissMembrIndx,
+                         uint    nonMissMembrSize,
+                         uint   *localEventTimeIndex,
+                         uint    localEventTimeSize,
+                         uint   *nodeParentEvent,
+                         uint   *nodeParentAtRisk,
+                         uint   *membrTimeIndex,
+                         double *eventRatioSum,
+                         double *riskRatioSum,
+                         double *riskRatioSqrSum);
+void getLogRankScore(uint    treeID,
+                     uint   *repMembrIndx,
+                     uint   *nonMissMembrIndx,
+                     uint    nonMissMembrSize,
+                     double *survivalRank,
+                     double *meanSurvRank,
+                     double *varSurvRank);
+void getLogRankTimeRank(uint    treeID,
+                        uint   *repMembrIndx,
+                        uint   *nonMissMembrIndx,
+                        uint    nonMissMembrSize,
+                        uint   *survivalTimeRank);
+void getLogRankCovariateScore(uint    treeID,
+                              uint   *repMembrIndx,
+                              uint   *nonMissMembrIndx,
+                              uint    nonMissMembrSize,
+                              uint   *indxx,
+                              uint   *survivalTimeRank,
+                              double *survivalRank,
+                              double *meanSurvRank,
+                              double *varSurvRank);
+void updateFenwick(double *tree, uint size, uint index, double value);
+double sumFenwick(double *tree, uint index);
 uint stackAndConstructSplitVector(uint     treeID,
                                   uint     localMembershipSize,
                                   uint     randomCovariateIndex,
@@ -1083,6 +1486,43 @@ void unselectRandomCovariates(uint      treeID,
                               uint      nonMissMembrSizeStatic,
                               uint     *nonMissMembrIndx,
                               char      multImpFlag);
+uint getSplitCandidateSize();
+SplitCandidate **stackSplitCandidates(uint candidateSize, uint repMembrSize, uint classSize);
+void unstackSplitCandidates(SplitCandidate **candidate, uint candidateSize, uint repMembrSize);
+uint selectSplitCandidates(uint             treeID,
+                           Node            *parent,
+                           uint            *repMembrIndx,
+                           uint             repMembrSize,
+                           uint            *covariateIndex,
+                           uint            *uniformCovariateSize,
+                           uint            *uniformCovariateIndex,
+                           double          *cdf,
+                           uint            *cdfSize,
+                           uint            *cdfSort,
+                           uint            *density,
+                           uint            *densitySize,
+                           uint           **densitySwap,
+                           uint            *actualCovariateCount,
+                           uint            *candidateCovariateCount,
+                           uint             nonMissMembrSizeStatic,
+                           uint            *nonMissMembrIndxStatic,
+                           char             multImpFlag,
+                           SplitCandidate **candidate,
+                           uint             candidateSize);
+void unselectSplitCandidates(uint             treeID,
+                             Node            *parent,
+                             uint            *repMembrIndx,
+                             uint             repMembrSize,
+                             uint             nonMissMembrSizeStatic,
+                             char             multImpFlag,
+                             SplitCandidate **candidate,
+                             uint             candidateCount,
+                             double          *deltaMax,
+                             uint            *splitParameterMax,
+                             double          *splitValueMaxCont,
+                             uint            *splitValueMaxFactSize,
+                             uint           **splitValueMaxFactPtr,
+                             char           **splitIndicator);
 uint virtuallySplitNode(uint  treeID,
                            char  factorFlag,
                            uint  mwcpSizeAbsolute,
@@ -1262,6 +1702,19 @@ double getConcordanceIndex(int     polarity,
                            double *statusPtr, 
                            double *predictedOutcome,
                            uint   *oobCount);
+uint getConcordancePrefix(double *sortedValue, uint size, double value, char type);
+double getConcordanceIndexSorted(int     polarity,
+                                 uint    size,
+                                 double *timePtr,
+                                 double *statusPtr,
+                                 double *predictedOutcome,
+                                 uint   *denCount);
+double getConcordanceIndexPairwise(int     polarity,
+                                   uint    size,
+                                   double *timePtr,
+                                   double *statusPtr,
+                                   double *predictedOutcome,
+                                   uint   *denCount);
 void getCRPerformance (uint     mode,
                        uint     obsSize,
                        double **responsePtr,
@@ -1349,7 +1802,29 @@ char getMarginalNodeMembership(uint     mode,
                                uint     allMembrSize,
                                double **observationPtr);
 void acquireTree(uint mode, uint r, uint b);
+uint getReplicaIndex();
+void stackDataReplicas(uint mode);
+void stackDataReplica(uint k);
+void unstackDataReplicas(uint mode);
+void bindDataReplica(uint b);
+void acquireForest(uint mode, uint r);
+Arena *suspendArena();
+void resumeArena(Arena *arena);
+void stackArena(uint mode);
+void unstackArena(uint mode);
 void finalizeProximity(uint mode);
+void finalizeSparseProximity(uint obsSize, char fullFlag, uint activeCount);
+void finalizeSparseProximityRow(uint    ii,
+                                char    fullFlag,
+                                uint    activeCount,
+                                double *rowCount,
+                                uint   *rowTouch);
+void finalizeProximityRow(uint ii, char fullFlag, uint activeCount);
+void stackProximityMask(uint obsSize, uint activeCount);
+void unstackProximityMask(uint obsSize);
+uint getProximityDenominator(uint ii, uint jj);
+void stackProximityLeaf(uint b, uint obsSize, char fullFlag);
+void unstackProximityLeaf(uint b, uint obsSize);
 void updateProximity(uint mode, uint b);
 void updateSplitDepth(uint treeID, Node *rootPtr, uint maxDepth);
 char pruneBranch(uint obsSize, uint treeID, Node **nodesAtDepth, uint nadCount, uint ptnTarget, uint ptnCurrent);
@@ -1409,6 +1884,69 @@ char restoreTree(uint    mode,
                  uint  **mwcpPtr,
                  uint    depth,
                  uint   *maximumDepth);
+FlatForest *makeFlatForest(uint forestSize, uint nodeCount, uint *mwcpPT);
+void freeFlatForest(FlatForest *forest);
+void flattenTree(FlatForest *forest,
+                 uint        b,
+                 uint        offset,
+                 uint        nodeCount,
+                 uint        mwcpOffset,
+                 uint       *parmID,
+                 double     *contPT,
+                 uint       *nodeID,
+                 uint       *mwcpSZ);
+uint getFlatTerminal(FlatForest *forest, uint b, double **observation, uint i);
+void getFlatTerminalBlock(FlatForest *forest,
+                          uint        b,
+                          double    **observation,
+                          uint        offset,
+                          uint        size,
+                          uint       *nodeIndex);
+char getFlatForestFlag(uint mode);
+void stackFlatForest(uint mode);
+void unstackFlatForest(uint mode);
+void restoreFlatMembership(uint b);
+ScoreForest *makeScoreForest(uint forestSize, uint xSize, uint outcomeSize, uint nodeCount, uint mwcpSize);
+void freeScoreForest(ScoreForest *forest);
+char restoreScoreLeafValues(ScoreForest *forest,
+                            uint         timeInterestSize,
+                            uint         eventTypeSize,
+                            char         crFlag,
+                            uint         regrCount,
+                            uint         classCount,
+                            uint        *classSize,
+                            double      *tnSURV,
+                            double      *tnMORT,
+                            double      *tnNLSN,
+                            double      *tnCSHZ,
+                            double      *tnCIFN,
+                            double      *tnREGR,
+                            uint        *tnCLAS,
+                            uint        *tnMCNT);
+uint getFlatTerminalVector(FlatForest *forest, uint b, double *x, uint stride);
+char getScoreVectorFlag(ScoreForest *forest, double *x, uint stride);
+char scoreForestRow(ScoreForest *forest, double *x, uint xStride, double *ensemble, uint ensembleStride);
+uint scoreForestRows(ScoreForest *forest, double *x, uint rowSize, double *ensemble);
+ScoreWorker *makeScoreWorker(uint maxRows, uint xSize, uint outcomeSize);
+void freeScoreWorker(ScoreWorker *worker);
+uint getScoreLatencyBin(double seconds);
+#ifndef _WIN32
+double getScoreClock();
+void catchScoreSignal(int signal);
+void getScoreInterrupt(void *dummy);
+char getScoreStopFlag(char *stopFlag);
+void setScoreStopFlag(char *stopFlag);
+void checkScoreInterrupt(char *stopFlag);
+char readScoreFrame(int fd, void *buffer, size_t size, char *stopFlag);
+char writeScoreFrame(int fd, void *buffer, size_t size);
+void serveScoreConnection(int            fd,
+                          ScoreForest  **forest,
+                          uint           forestCount,
+                          ScoreWorker  **worker,
+                          uint           workerCount,
+                          uint           w,
+                          char          *stopFlag);
+#endif
 void saveTree(uint    b,
               Node   *parent,
               uint   *offset,
@@ -1431,6 +1969,13 @@ void saveStatistics(char     mode,
                     uint   **uspvST,
                     uint   **mtryID,
                     double **mtryST);
+void getTreeRecordSize(Node *parent, uint *nodeCount, uint *mwcpCount);
+TreeRecord *makeTreeRecord(uint nodeCount, uint mwcpCount);
+void freeTreeRecord(TreeRecord *record);
+void stackTreeRecords(uint mode);
+void saveTreeRecord(uint mode, uint b);
+void copyTreeRecord(uint b, uint nodeOffset, uint mwcpOffset);
+void finalizeTreeRecords(uint mode);
 uint getMaximumDepth(Node *parent);
 void getNodesAtDepth(Node *parent, uint tagDepth, Node **nodesAtDepth, uint *nadCount);
 void getTreeInfo(uint treeID, Node *parent);
@@ -1439,6 +1984,7 @@ void getPTNodeList(Node    *parent,
                    uint    *offset);
 void restoreNodeMembershipGrow(uint treeID);
 char getRestoreNodeMembershipGrowFlag(char mode);
+char getPredictTerminalFlag(uint mode);
 void updateTerminalNodeOutcomesNew (uint       treeID,
                                     Terminal  *parent,
                                     uint      *repMembrIndx,
@@ -1451,6 +1997,100 @@ void restoreMembrCount(uint treeID);
 void updateEnsembleCalculations (char      multipleImputeFlag,
                                  uint      mode,
                                  uint      b);
+void updateEnsembleOutcomes(uint mode, uint b, uint serialTreeID);
+void updateEnsemblePerformance(uint mode, char multImpFlag, uint b, uint thisSerialTreeCount);
+void updateGenericEnsemblePerformance(uint       mode,
+                                      char       multImpFlag,
+                                      uint       b,
+                                      uint       thisSerialTreeCount,
+                                      uint      *ensembleDen,
+                                      double   **ensembleMRTptr,
+                                      double  ***ensembleCLSptr,
+                                      double   **ensembleRGRptr);
+uint getEnsemblePartialIndex(uint treeID);
+uint getThreadIndex();
+void stackThreadSchedule();
+void unstackThreadSchedule();
+double getThreadClock();
+void updateThreadBusyTime(double busyStart);
+char getEnsemblePartialFlag(uint mode);
+double getEnsembleNumeratorSize(uint obsSize);
+void stackEnsembleNumerators(uint       obsSize,
+                             uint     **ensembleDen,
+                             double ****ensembleSRGnum,
+                             double  ***ensembleMRTnum,
+                             double  ***ensembleSRVnum,
+                             double ****ensembleCIFnum,
+                             double ****ensembleCLSnum,
+                             double  ***ensembleRGRnum);
+void unstackEnsembleNumerators(uint      obsSize,
+                               uint     *ensembleDen,
+                               double ***ensembleSRGnum,
+                               double  **ensembleMRTnum,
+                               double  **ensembleSRVnum,
+                               double ***ensembleCIFnum,
+                               double ***ensembleCLSnum,
+                               double  **ensembleRGRnum);
+void reduceEnsembleNumerators(uint      obsSize,
+                              uint     *partialDen,
+                              double ***partialSRGnum,
+                              double  **partialMRTnum,
+                              double  **partialSRVnum,
+                              double ***partialCIFnum,
+                              double ***partialCLSnum,
+                              double  **partialRGRnum,
+                              uint     *ensembleDen,
+                              double ***ensembleSRGnum,
+                              double  **ensembleMRTnum,
+                              double  **ensembleSRVnum,
+                              double ***ensembleCIFnum,
+                              double ***ensembleCLSnum,
+                              double  **ensembleRGRnum);
+void stackEnsemblePartials(uint mode);
+void stackEnsemblePartial(uint mode, uint t);
+void unstackEnsemblePartial(uint mode, uint t);
+void unstackEnsemblePartials(uint mode);
+void reduceEnsemblePartial(uint mode, uint t);
+void finalizeEnsemblePartials(uint mode, char multImpFlag);
+void refreshEnsemblePointers(uint mode);
+char getDeterministicFlag(uint mode);
+void stackTreeCommits(uint mode);
+void unstackTreeCommits(uint mode);
+void commitTree(uint mode, char multImpFlag, uint b);
+uint commitTreePartials(uint mode, uint b, uint t);
+uint getPerformanceSnapshotClassSize(uint j);
+void stackPerformanceSnapshot(uint mode, uint t);
+void unstackPerformanceSnapshot(uint mode, uint t);
+void takePerformanceSnapshot(uint mode, uint t);
+char getVimpPartialFlag(uint mode);
+uint getVimpPartialSlotSize();
+double getVimpNumeratorSize(uint obsSize);
+char getVimpTreePartialFlag();
+uint getVimpPartialSlot(uint         treeID,
+                        uint         p,
+                        uint      ***vimpEnsembleDen,
+                        double   ****vimpEnsembleMRT,
+                        double  *****vimpEnsembleCLS,
+                        double   ****vimpEnsembleRGR);
+char getVimpMaxVoteFlag();
+void stackVimpEnsemble(uint        obsSize,
+                       uint        slotSize,
+                       uint     ***vimpEnsembleDen,
+                       double  ****vimpEnsembleMRT,
+                       double *****vimpEnsembleCLS,
+                       double  ****vimpEnsembleRGR);
+void unstackVimpEnsemble(uint       obsSize,
+                         uint       slotSize,
+                         uint     **vimpEnsembleDen,
+                         double  ***vimpEnsembleMRT,
+                         double ****vimpEnsembleCLS,
+                         double  ***vimpEnsembleRGR);
+void stackVimpPartials(uint mode);
+void stackVimpPartial(uint mode, uint t);
+void unstackVimpPartial(uint mode, uint t);
+void unstackVimpPartials(uint mode);
+void reduceVimpPartial(uint mode, uint t);
+void finalizeVimpPartials(uint mode);
 char stackAndImputePerfResponse(uint      mode,
                                 char      multipleImputeFlag,
                                 uint      treeID,
@@ -1486,6 +2126,7 @@ Node *antiMembership(Node    *parent,
                      uint     splitParameter,
                      uint     treeID);
 void permute(uint ranGenID, uint p, uint n, uint *indx);
+void permuteCompatible(double (*ranX) (uint), uint parallelID, uint n, uint *indx);
 void getAntiMembership(uint       mode,
                        uint       treeID,
                        Terminal **vimpMembership,
@@ -1507,6 +2148,7 @@ void updateGenericVimpEnsemble (uint       mode,
                                 uint       xVarIdx,
                                 Terminal **noiseMembership,
                                 char       ensembleFlag,
+                                uint      *genEnsembleDen,
                                 double  ***genEnsembleMRT,
                                 double ****genEnsembleCLS,
                                 double  ***genEnsembleRGR);